@@ -0,0 +1,123 @@
+import QtQuick 2.7
+import QtQuick.Layouts 1.3
+import QtQuick.Controls 2.15
+import QtQuick.Controls.Material 2.0
+
+ScrollView {
+    contentWidth: -1
+    focus: true
+    anchors.horizontalCenter: parent.horizontalCenter
+    anchors.fill: parent
+
+    property int days: 90
+
+    function formatDuration(seconds) {
+        var h = Math.floor(seconds / 3600)
+        var m = Math.floor((seconds % 3600) / 60)
+        var s = Math.floor(seconds % 60)
+        return (h > 0 ? h + ":" + (m < 10 ? "0" : "") : "") + m + ":" + (s < 10 ? "0" : "") + s
+    }
+
+    function refresh() {
+        lblTotals.text = activityHistory.count() + qsTr(" activities, ") +
+                activityHistory.distance(days).toFixed(1) + qsTr(" km and TSS ") +
+                activityHistory.tss(days).toFixed(0) + qsTr(" in the last ") + days + qsTr(" days")
+        curveModel.clear()
+        var curve = activityHistory.powerCurve(days)
+        for (var i = 0; i < curve.length; i++)
+            if (curve[i].watts > 0)
+                curveModel.append({"label": formatDuration(curve[i].seconds), "value": curve[i].watts.toFixed(0) + " W"})
+        weekModel.clear()
+        var weeks = activityHistory.weeklyTss(8)
+        for (i = 0; i < weeks.length; i++)
+            weekModel.append({"label": i === 0 ? qsTr("This week") : i + qsTr(" weeks ago"), "value": weeks[i].toFixed(0)})
+        recentModel.clear()
+        var recent = activityHistory.recent(20)
+        for (i = 0; i < recent.length; i++)
+            recentModel.append({"label": Qt.formatDateTime(recent[i].start, "yyyy-MM-dd hh:mm"),
+                                "value": formatDuration(recent[i].seconds) + "  " + recent[i].distance.toFixed(1) +
+                                         " km  " + recent[i].avgWatts.toFixed(0) + " W  TSS " + recent[i].tss.toFixed(0)})
+    }
+
+    Component.onCompleted: refresh()
+
+    Connections {
+        target: activityHistory
+        function onImported(activities) {
+            refresh()
+        }
+    }
+
+    ListModel { id: curveModel }
+    ListModel { id: weekModel }
+    ListModel { id: recentModel }
+
+    Component {
+        id: row
+        RowLayout {
+            width: parent ? parent.width : 0
+            Label {
+                Layout.fillWidth: true
+                text: model.label
+            }
+            Label {
+                text: model.value
+                font.family: "monospace"
+            }
+        }
+    }
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 10
+
+        Label {
+            Layout.fillWidth: true
+            horizontalAlignment: Text.AlignHCenter
+            text: "<b>" + qsTr("Activity History") + "</b>"
+        }
+
+        Label {
+            Layout.fillWidth: true
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WordWrap
+            font.italic: true
+            color: Material.color(Material.Lime)
+            text: qsTr("Summaries of the FIT files saved by the app. The files saved before this version are imported in the background at startup.")
+        }
+
+        Label {
+            id: lblTotals
+            Layout.fillWidth: true
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WordWrap
+        }
+
+        Label {
+            Layout.fillWidth: true
+            text: "<b>" + qsTr("Best power, last ") + days + qsTr(" days") + "</b>"
+        }
+        Repeater {
+            model: curveModel
+            delegate: row
+        }
+
+        Label {
+            Layout.fillWidth: true
+            text: "<b>" + qsTr("Weekly TSS") + "</b>"
+        }
+        Repeater {
+            model: weekModel
+            delegate: row
+        }
+
+        Label {
+            Layout.fillWidth: true
+            text: "<b>" + qsTr("Recent activities") + "</b>"
+        }
+        Repeater {
+            model: recentModel
+            delegate: row
+        }
+    }
+}
@@ -37,16 +37,14 @@ ChartsEndWorkoutForm {
     Component.onCompleted: {
         headerToolbar.visible = true;
 
-        //console.log("ChartsEndWorkoutForm completed " + rootItem.workout_sample_points)
-        for(var i=0;i<rootItem.workout_sample_points;i+=10)
-        {
-            //console.log("ChartsEndWorkoutForm completed " + i + " " + rootItem.workout_watt_points[i])
-            powerSeries.append(i * 1000, rootItem.workout_watt_points[i]);
-            heartSeries.append(i * 1000, rootItem.workout_heart_points[i]);
-            cadenceSeries.append(i * 1000, rootItem.workout_cadence_points[i]);
-            resistanceSeries.append(i * 1000, rootItem.workout_resistance_points[i]);
-            pelotonResistanceSeries.append(i * 1000, rootItem.workout_peloton_resistance_points[i]);
-        }
+        // the session is downsampled in C++ to about one point per horizontal pixel, keeping the peaks
+        var samples = rootItem.workout_sample_points
+        var maxPoints = Math.max(Math.round(powerChart.width), 300)
+        rootItem.workout_chart_series(powerSeries, "watt", 0, samples, maxPoints)
+        rootItem.workout_chart_series(heartSeries, "heart", 0, samples, maxPoints)
+        rootItem.workout_chart_series(cadenceSeries, "cadence", 0, samples, maxPoints)
+        rootItem.workout_chart_series(resistanceSeries, "resistance", 0, samples, maxPoints)
+        rootItem.workout_chart_series(pelotonResistanceSeries, "peloton_resistance", 0, samples, maxPoints)
         rootItem.update_chart_power(powerChart);
         //rootItem.update_axes(valueAxisX, valueAxisY);
         rootItem.update_chart_heart(heartChart);
@@ -0,0 +1,46 @@
+import QtQuick 2.7
+import QtQuick.Layouts 1.3
+import QtQuick.Controls 2.15
+import QtQuick.Controls.Material 2.0
+
+ScrollView {
+    contentWidth: -1
+    focus: true
+    anchors.horizontalCenter: parent.horizontalCenter
+    anchors.fill: parent
+
+    Timer {
+        interval: 1000
+        running: true
+        repeat: true
+        triggeredOnStart: true
+        onTriggered: lblLatency.text = rootItem.latencyReport()
+    }
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 10
+
+        Label {
+            Layout.fillWidth: true
+            horizontalAlignment: Text.AlignHCenter
+            text: "<b>Latency Debug</b>"
+        }
+
+        Label {
+            Layout.fillWidth: true
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WordWrap
+            font.italic: true
+            color: Material.color(Material.Lime)
+            text: qsTr("Time from a packet of the machine to the virtual device or DirCon notification carrying its value, from an app control point write to the write to the machine, and of the writes to the machine. Values are the upper bounds of the histogram buckets; the full histograms are on the /metrics endpoint.")
+        }
+
+        Label {
+            id: lblLatency
+            Layout.fillWidth: true
+            wrapMode: Label.WrapAnywhere
+            font.family: "monospace"
+        }
+    }
+}
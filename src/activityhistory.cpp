@@ -0,0 +1,524 @@
+#include "activityhistory.h"
+#include "appdirs.h"
+#include "qfit.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <math.h>
+
+namespace {
+
+const quint32 fileMagic = 0x515a4148; // QZAH
+
+// a gap longer than this between two records is a pause, left out of the timeline
+const int pauseSeconds = 10;
+
+// the records of an activity on a timeline of one second, pauses removed
+class Summarizer {
+  public:
+    void add(const SessionLine &s) {
+        qint64 ms = s.time.toMSecsSinceEpoch();
+        if (first < 0) {
+            first = ms;
+            start = s.time;
+        }
+        qint64 index = qRound64((ms - first) / 1000.0) - paused;
+        // no distance in the record: from the speed
+        double d = s.distance;
+        if (!std::isfinite(d))
+            d = std::isfinite(s.speed) ? lastDistance + s.speed * qBound<qint64>(0, index - last(), 1) / 3600.0
+                                       : lastDistance;
+        if (!std::isfinite(firstDistance))
+            firstDistance = d;
+        d = qMax(lastDistance, d - firstDistance);
+        lastDistance = d;
+        if (std::isfinite(s.calories))
+            calories = qMax(calories, s.calories);
+
+        if (index <= last())
+            return;
+        qint64 gap = index - last();
+        if (gap > pauseSeconds && !watts.isEmpty()) {
+            paused += gap - 1;
+            gap = 1;
+        }
+        for (qint64 i = 0; i < gap; i++) {
+            watts.append(s.watt);
+            heart.append(s.heart);
+            distance.append(d);
+        }
+    }
+
+    ActivityHistory::Activity finish(const ActivityHistory::Zones &zones) const;
+
+    QDateTime start;
+    double calories = 0;
+
+  private:
+    qint64 last() const { return watts.size() - 1; }
+
+    qint64 first = -1;
+    qint64 paused = 0;
+    double firstDistance = NAN;
+    double lastDistance = 0;
+    QVector<quint16> watts;
+    QVector<quint8> heart;
+    QVector<float> distance;
+};
+
+// the best average of values over every duration, with the prefix sums
+template <typename T> QVector<T> meanMax(const QVector<T> &values) {
+    const QVector<int> &durations = ActivityHistory::curveDurations();
+    QVector<T> curve(durations.size(), 0);
+    QVector<qint64> sums(values.size() + 1, 0);
+    for (int i = 0; i < values.size(); i++)
+        sums[i + 1] = sums.at(i) + values.at(i);
+    for (int k = 0; k < durations.size(); k++) {
+        int d = durations.at(k);
+        if (d > values.size())
+            break;
+        qint64 best = 0;
+        for (int i = d; i < sums.size(); i++)
+            best = qMax(best, sums.at(i) - sums.at(i - d));
+        curve[k] = (T)qRound64((double)best / d);
+    }
+    return curve;
+}
+
+ActivityHistory::Activity Summarizer::finish(const ActivityHistory::Zones &zones) const {
+    ActivityHistory::Activity a;
+    if (watts.isEmpty())
+        return a;
+    const int n = watts.size();
+    a.start = start;
+    a.seconds = n;
+    a.distance = distance.last();
+    a.calories = calories;
+
+    TrainingLoad load(zones);
+    double heartSum = 0;
+    int heartSeconds = 0;
+    for (int i = 0; i < n; i++) {
+        load.addSample(watts.at(i), heart.at(i));
+        a.maxWatts = qMax(a.maxWatts, watts.at(i));
+        if (heart.at(i) > 0) {
+            heartSum += heart.at(i);
+            heartSeconds++;
+            a.maxHeart = qMax(a.maxHeart, heart.at(i));
+        }
+    }
+    a.avgWatts = load.averagePower();
+    a.avgHeart = heartSeconds ? heartSum / heartSeconds : 0;
+    a.normalizedPower = load.normalizedPower();
+    a.tss = load.tss();
+    for (int i = 0; i < TrainingLoad::powerZoneCount; i++)
+        a.powerZones.append(load.powerZoneSeconds(i));
+    for (int i = 0; i < TrainingLoad::heartZoneCount; i++)
+        a.heartZones.append(load.heartZoneSeconds(i));
+
+    a.powerCurve = meanMax(watts);
+    a.heartCurve = meanMax(heart);
+
+    // the shortest window covering every distance
+    const QVector<double> &distances = ActivityHistory::effortDistances();
+    a.bestEfforts.fill(0, distances.size());
+    for (int k = 0; k < distances.size(); k++) {
+        double target = distances.at(k) - 1e-6;
+        if (a.distance < target)
+            break;
+        int best = -1;
+        int j = 0;
+        for (int i = 1; i < n; i++) {
+            if (distance.at(i) - distance.at(0) < target)
+                continue;
+            while (distance.at(i) - distance.at(j + 1) >= target)
+                j++;
+            if (best < 0 || i - j < best)
+                best = i - j;
+        }
+        a.bestEfforts[k] = best;
+    }
+    return a;
+}
+
+// the summary of a FIT file, run by the pool of importFiles()
+class ImportTask : public QRunnable {
+  public:
+    ImportTask(const QString &file, const ActivityHistory::Zones &zones, QMutex *mutex,
+               QList<ActivityHistory::Activity> *results)
+        : file(file), zones(zones), mutex(mutex), results(results) {}
+
+    void run() override {
+        ActivityHistory::Activity a = ActivityHistory::summarize(file, zones);
+        if (!a.start.isValid())
+            return;
+        QMutexLocker locker(mutex);
+        results->append(a);
+    }
+
+  private:
+    QString file;
+    ActivityHistory::Zones zones;
+    QMutex *mutex;
+    QList<ActivityHistory::Activity> *results;
+};
+
+// importFiles() of a folder, in the global pool
+class ImportFolderTask : public QRunnable {
+  public:
+    ImportFolderTask(ActivityHistory *history, const QStringList &files) : history(history), files(files) {}
+
+    void run() override { emit history->imported(history->importFiles(files)); }
+
+  private:
+    ActivityHistory *history;
+    QStringList files;
+};
+
+bool startBefore(const ActivityHistory::Activity &a, const ActivityHistory::Activity &b) { return a.start < b.start; }
+
+QDataStream &operator<<(QDataStream &out, const ActivityHistory::Activity &a) {
+    out << a.file << a.modified << a.start << a.seconds << a.distance << a.calories << a.avgWatts << a.maxWatts
+        << a.avgHeart << a.maxHeart << a.normalizedPower << a.tss << a.powerCurve << a.heartCurve << a.powerZones
+        << a.heartZones << a.bestEfforts;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, ActivityHistory::Activity &a) {
+    in >> a.file >> a.modified >> a.start >> a.seconds >> a.distance >> a.calories >> a.avgWatts >> a.maxWatts >>
+        a.avgHeart >> a.maxHeart >> a.normalizedPower >> a.tss >> a.powerCurve >> a.heartCurve >> a.powerZones >>
+        a.heartZones >> a.bestEfforts;
+    return in;
+}
+
+} // namespace
+
+QVariantMap ActivityHistory::Activity::toMap() const {
+    QVariantMap m;
+    m[QStringLiteral("file")] = file;
+    m[QStringLiteral("start")] = start;
+    m[QStringLiteral("seconds")] = seconds;
+    m[QStringLiteral("distance")] = distance;
+    m[QStringLiteral("calories")] = calories;
+    m[QStringLiteral("avgWatts")] = avgWatts;
+    m[QStringLiteral("maxWatts")] = maxWatts;
+    m[QStringLiteral("avgHeart")] = avgHeart;
+    m[QStringLiteral("maxHeart")] = maxHeart;
+    m[QStringLiteral("normalizedPower")] = normalizedPower;
+    m[QStringLiteral("tss")] = tss;
+    return m;
+}
+
+const QVector<int> &ActivityHistory::curveDurations() {
+    static const QVector<int> durations = {1, 5, 10, 30, 60, 120, 300, 600, 1200, 1800, 3600, 5400, 7200};
+    return durations;
+}
+
+const QVector<double> &ActivityHistory::effortDistances() {
+    static const QVector<double> distances = {1, 5, 10, 20, 40};
+    return distances;
+}
+
+ActivityHistory::Activity ActivityHistory::summarize(const QList<SessionLine> &session, const Zones &zones) {
+    Summarizer s;
+    for (const SessionLine &line : session)
+        s.add(line);
+    return s.finish(zones);
+}
+
+ActivityHistory::Activity ActivityHistory::summarize(const QString &filename, const Zones &zones) {
+    Summarizer s;
+    if (!qfit::open(filename, [&s](const SessionLine &line) { s.add(line); }))
+        return Activity();
+    Activity a = s.finish(zones);
+    QFileInfo info(filename);
+    a.file = info.fileName();
+    a.modified = info.lastModified().toMSecsSinceEpoch();
+    return a;
+}
+
+ActivityHistory::ActivityHistory(QObject *parent) : QObject(parent) {}
+
+ActivityHistory *ActivityHistory::instance() {
+    static ActivityHistory *history = nullptr;
+    if (!history) {
+        history = new ActivityHistory();
+        history->load(AppDirs::writable() + QStringLiteral("activity_history.dat"));
+    }
+    return history;
+}
+
+bool ActivityHistory::load(const QString &filename) {
+    QMutexLocker locker(&mutex);
+    this->filename = filename;
+    m_activities.clear();
+    QFile f(filename);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_5_12);
+    quint32 magic = 0, version = 0;
+    qint32 size = 0;
+    in >> magic >> version >> size;
+    if (magic != fileMagic || version != fileVersion || size < 0) {
+        qDebug() << "ActivityHistory: ignoring" << filename << "version" << version;
+        return false;
+    }
+    m_activities.reserve(size);
+    for (qint32 i = 0; i < size && in.status() == QDataStream::Ok; i++) {
+        Activity a;
+        in >> a;
+        m_activities.append(a);
+    }
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << "ActivityHistory: damaged" << filename;
+        m_activities.clear();
+        return false;
+    }
+    std::stable_sort(m_activities.begin(), m_activities.end(), startBefore);
+    return true;
+}
+
+bool ActivityHistory::save() const {
+    QMutexLocker locker(&mutex);
+    if (filename.isEmpty())
+        return false;
+    QSaveFile f(filename);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << fileMagic << fileVersion << (qint32)m_activities.size();
+    for (const Activity &a : m_activities)
+        out << a;
+    return f.commit();
+}
+
+void ActivityHistory::add(const QString &fitFile, const QList<SessionLine> &session) {
+    Activity a = summarize(session, Zones::fromSettings());
+    if (!a.start.isValid())
+        return;
+    QFileInfo info(fitFile);
+    a.file = info.fileName();
+    a.modified = info.lastModified().toMSecsSinceEpoch();
+    add(a);
+    save();
+}
+
+void ActivityHistory::add(const Activity &activity) {
+    QMutexLocker locker(&mutex);
+    for (int i = 0; i < m_activities.size(); i++) {
+        if (m_activities.at(i).file == activity.file) {
+            m_activities.removeAt(i);
+            break;
+        }
+    }
+    auto at = std::upper_bound(m_activities.begin(), m_activities.end(), activity, startBefore);
+    m_activities.insert(at, activity);
+}
+
+int ActivityHistory::importFiles(const QStringList &files) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QHash<QString, qint64> known;
+    {
+        QMutexLocker locker(&mutex);
+        for (const Activity &a : qAsConst(m_activities))
+            known.insert(a.file, a.modified);
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+    Zones zones = Zones::fromSettings();
+    QMutex resultsMutex;
+    QList<Activity> results;
+    for (const QString &file : files) {
+        QFileInfo info(file);
+        auto k = known.constFind(info.fileName());
+        if (k != known.constEnd() && k.value() == info.lastModified().toMSecsSinceEpoch())
+            continue;
+        pool.start(new ImportTask(file, zones, &resultsMutex, &results));
+    }
+    pool.waitForDone();
+
+    for (const Activity &a : qAsConst(results))
+        add(a);
+    if (!results.isEmpty())
+        save();
+    qDebug() << "ActivityHistory: imported" << results.size() << "of" << files.size() << "files in"
+             << timer.elapsed() << "ms on" << pool.maxThreadCount() << "threads";
+    return results.size();
+}
+
+void ActivityHistory::importFolder(const QString &folder) {
+    QStringList files;
+    const QFileInfoList list = QDir(folder).entryInfoList(QStringList() << QStringLiteral("*.fit"), QDir::Files);
+    for (const QFileInfo &f : list)
+        files.append(f.absoluteFilePath());
+    QThreadPool::globalInstance()->start(new ImportFolderTask(this, files), -1);
+}
+
+int ActivityHistory::count() const {
+    QMutexLocker locker(&mutex);
+    return m_activities.size();
+}
+
+QList<ActivityHistory::Activity> ActivityHistory::activities() const {
+    QMutexLocker locker(&mutex);
+    return m_activities;
+}
+
+QDateTime ActivityHistory::since(int days) const {
+    if (days <= 0)
+        return QDateTime();
+    return (m_now.isValid() ? m_now : QDateTime::currentDateTime()).addDays(-days);
+}
+
+double ActivityHistory::bestPower(int seconds, int days) const {
+    const QVector<int> &durations = curveDurations();
+    int k = std::lower_bound(durations.begin(), durations.end(), seconds) - durations.begin();
+    if (k >= durations.size())
+        return 0;
+    QDateTime from = since(days);
+    QMutexLocker locker(&mutex);
+    quint16 best = 0;
+    for (const Activity &a : m_activities)
+        if ((!from.isValid() || a.start >= from) && k < a.powerCurve.size())
+            best = qMax(best, a.powerCurve.at(k));
+    return best;
+}
+
+double ActivityHistory::bestHeart(int seconds, int days) const {
+    const QVector<int> &durations = curveDurations();
+    int k = std::lower_bound(durations.begin(), durations.end(), seconds) - durations.begin();
+    if (k >= durations.size())
+        return 0;
+    QDateTime from = since(days);
+    QMutexLocker locker(&mutex);
+    quint8 best = 0;
+    for (const Activity &a : m_activities)
+        if ((!from.isValid() || a.start >= from) && k < a.heartCurve.size())
+            best = qMax(best, a.heartCurve.at(k));
+    return best;
+}
+
+double ActivityHistory::bestEffort(double km, int days) const {
+    int k = effortDistances().indexOf(km);
+    if (k < 0)
+        return 0;
+    QDateTime from = since(days);
+    QMutexLocker locker(&mutex);
+    float best = 0;
+    for (const Activity &a : m_activities) {
+        if ((from.isValid() && a.start < from) || k >= a.bestEfforts.size() || a.bestEfforts.at(k) <= 0)
+            continue;
+        if (best == 0 || a.bestEfforts.at(k) < best)
+            best = a.bestEfforts.at(k);
+    }
+    return best;
+}
+
+QVariantList ActivityHistory::weeklyTss(int weeks) const {
+    QDateTime now = m_now.isValid() ? m_now : QDateTime::currentDateTime();
+    QDate monday = now.date().addDays(1 - now.date().dayOfWeek());
+    QVector<double> tss(qMax(0, weeks), 0);
+    QMutexLocker locker(&mutex);
+    for (const Activity &a : m_activities) {
+        qint64 days = a.start.date().daysTo(monday);
+        if (a.start.date() >= monday) {
+            if (!tss.isEmpty())
+                tss[0] += a.tss;
+        } else {
+            int week = (days + 6) / 7;
+            if (week < tss.size())
+                tss[week] += a.tss;
+        }
+    }
+    QVariantList l;
+    for (double t : qAsConst(tss))
+        l.append(t);
+    return l;
+}
+
+double ActivityHistory::tss(int days) const {
+    QDateTime from = since(days);
+    QMutexLocker locker(&mutex);
+    double t = 0;
+    for (const Activity &a : m_activities)
+        if (!from.isValid() || a.start >= from)
+            t += a.tss;
+    return t;
+}
+
+double ActivityHistory::distance(int days) const {
+    QDateTime from = since(days);
+    QMutexLocker locker(&mutex);
+    double d = 0;
+    for (const Activity &a : m_activities)
+        if (!from.isValid() || a.start >= from)
+            d += a.distance;
+    return d;
+}
+
+QVariantList ActivityHistory::powerCurve(int days) const {
+    QVariantList l;
+    const QVector<int> &durations = curveDurations();
+    for (int d : durations) {
+        QVariantMap p;
+        p[QStringLiteral("seconds")] = d;
+        p[QStringLiteral("watts")] = bestPower(d, days);
+        l.append(p);
+    }
+    return l;
+}
+
+QVariantList ActivityHistory::powerZones(int days) const {
+    QDateTime from = since(days);
+    QVector<quint32> zones(TrainingLoad::powerZoneCount, 0);
+    {
+        QMutexLocker locker(&mutex);
+        for (const Activity &a : m_activities)
+            if (!from.isValid() || a.start >= from)
+                for (int i = 0; i < TrainingLoad::powerZoneCount && i < a.powerZones.size(); i++)
+                    zones[i] += a.powerZones.at(i);
+    }
+    QVariantList l;
+    for (quint32 z : qAsConst(zones))
+        l.append(z);
+    return l;
+}
+
+QVariantList ActivityHistory::heartZones(int days) const {
+    QDateTime from = since(days);
+    QVector<quint32> zones(TrainingLoad::heartZoneCount, 0);
+    {
+        QMutexLocker locker(&mutex);
+        for (const Activity &a : m_activities)
+            if (!from.isValid() || a.start >= from)
+                for (int i = 0; i < TrainingLoad::heartZoneCount && i < a.heartZones.size(); i++)
+                    zones[i] += a.heartZones.at(i);
+    }
+    QVariantList l;
+    for (quint32 z : qAsConst(zones))
+        l.append(z);
+    return l;
+}
+
+QVariantList ActivityHistory::recent(int max) const {
+    QMutexLocker locker(&mutex);
+    QVariantList l;
+    for (int i = m_activities.size() - 1; i >= 0 && l.size() < max; i--)
+        l.append(m_activities.at(i).toMap());
+    return l;
+}
@@ -0,0 +1,158 @@
+#ifndef ACTIVITYHISTORY_H
+#define ACTIVITYHISTORY_H
+
+#include <QDateTime>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVector>
+
+#include "sessionline.h"
+#include "trainingload.h"
+
+/**
+ * @brief The history of the activities saved in the writable folder of the app, one summary per FIT file.
+ *
+ * The expensive part of every query, the curves, the zones and the best efforts, is computed once when the
+ * activity is added (at save time, or by importFiles() for the files that are already there) and kept in a
+ * versioned binary file next to the FIT files. The queries then only scan the summaries in memory: a few
+ * microseconds for a thousand activities.
+ */
+class ActivityHistory : public QObject {
+    Q_OBJECT
+
+  public:
+    // the version of the history file: a new one rebuilds the history from the FIT files
+    static const quint32 fileVersion = 1;
+
+    // the zones an activity is summarized with
+    typedef TrainingLoad::Parameters Zones;
+
+    struct Activity {
+        QString file; // the name of the FIT file, without the folder
+        qint64 modified = 0;
+        QDateTime start;
+        quint32 seconds = 0;
+        double distance = 0; // km
+        double calories = 0;
+        double avgWatts = 0;
+        quint16 maxWatts = 0;
+        double avgHeart = 0;
+        quint8 maxHeart = 0;
+        double normalizedPower = 0;
+        double tss = 0;
+        QVector<quint16> powerCurve;  // best average power for every curveDurations()
+        QVector<quint8> heartCurve;   // best average heart rate for every curveDurations()
+        QVector<quint32> powerZones;  // seconds in the 7 power zones of the FTP
+        QVector<quint32> heartZones;  // seconds in the 5 heart rate zones
+        QVector<float> bestEfforts;   // fastest seconds for every effortDistances(), 0 if not that long
+
+        QVariantMap toMap() const;
+    };
+
+    /**
+     * @brief curveDurations The durations in seconds of the power and heart rate curves.
+     */
+    static const QVector<int> &curveDurations();
+
+    /**
+     * @brief effortDistances The distances in km of the best efforts.
+     */
+    static const QVector<double> &effortDistances();
+
+    /**
+     * @brief summarize The summary of a session, one line every second or so.
+     */
+    static Activity summarize(const QList<SessionLine> &session, const Zones &zones);
+
+    /**
+     * @brief summarize The summary of a FIT file, streamed with qfit::open. Returns an activity without a start
+     * if the file can't be read or has no records.
+     */
+    static Activity summarize(const QString &filename, const Zones &zones);
+
+    explicit ActivityHistory(QObject *parent = nullptr);
+
+    /**
+     * @brief instance The history of the writable folder of the app.
+     */
+    static ActivityHistory *instance();
+
+    /**
+     * @brief load Reads the history file, empty if it's missing, damaged or of another version.
+     */
+    bool load(const QString &filename);
+    bool save() const;
+
+    /**
+     * @brief add Adds or replaces the activity of a FIT file just saved with session, and saves the history.
+     */
+    void add(const QString &fitFile, const QList<SessionLine> &session);
+    void add(const Activity &activity);
+
+    /**
+     * @brief importFiles Summarizes the FIT files that aren't in the history yet, or changed since, on all the
+     * cores, and saves the history. Blocks until they are all done: run it from a thread of its own.
+     * @return the number of activities imported
+     */
+    int importFiles(const QStringList &files);
+
+    /**
+     * @brief importFolder importFiles() of the FIT files of folder in the background, emitting imported() at the
+     * end.
+     */
+    void importFolder(const QString &folder);
+
+    Q_INVOKABLE int count() const;
+    QList<Activity> activities() const;
+
+    /**
+     * @brief bestPower The best average power over seconds in the activities of the last days, 0 for all of
+     * them. A duration not in curveDurations() uses the next longer one.
+     */
+    Q_INVOKABLE double bestPower(int seconds, int days = 0) const;
+    Q_INVOKABLE double bestHeart(int seconds, int days = 0) const;
+
+    /**
+     * @brief bestEffort The fastest time in seconds over km (one of effortDistances()) in the last days, 0 if
+     * never done.
+     */
+    Q_INVOKABLE double bestEffort(double km, int days = 0) const;
+
+    /**
+     * @brief weeklyTss The TSS of the last weeks, from this week (starting on Monday) backwards.
+     */
+    Q_INVOKABLE QVariantList weeklyTss(int weeks) const;
+
+    Q_INVOKABLE double tss(int days) const;
+    Q_INVOKABLE double distance(int days) const;
+    Q_INVOKABLE QVariantList powerCurve(int days = 0) const;
+    Q_INVOKABLE QVariantList powerZones(int days = 0) const;
+    Q_INVOKABLE QVariantList heartZones(int days = 0) const;
+
+    /**
+     * @brief recent The summaries of the last activities as maps, the latest first.
+     */
+    Q_INVOKABLE QVariantList recent(int max) const;
+
+    /**
+     * @brief setNow The time the days of the queries are counted from, for the tests. Invalid for the current
+     * time.
+     */
+    void setNow(const QDateTime &now) { m_now = now; }
+
+  signals:
+    void imported(int activities);
+
+  private:
+    QDateTime since(int days) const;
+    QString filename;
+    QDateTime m_now;
+    mutable QMutex mutex;
+    QList<Activity> m_activities; // sorted by start
+};
+
+#endif // ACTIVITYHISTORY_H
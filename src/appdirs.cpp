@@ -0,0 +1,74 @@
+#include "appdirs.h"
+#include "qzsettings.h"
+
+#include <QDir>
+#include <QOperatingSystemVersion>
+#include <QSettings>
+#include <QStandardPaths>
+
+#ifdef Q_OS_ANDROID
+#include <QAndroidJniEnvironment>
+#include <QAndroidJniObject>
+#include <QtAndroid>
+#endif
+
+QString AppDirs::writable() {
+    QString path = QLatin1String("");
+#if defined(Q_OS_ANDROID)
+    QSettings settings;
+    bool android_documents_folder = settings.value(QZSettings::android_documents_folder, QZSettings::default_android_documents_folder).toBool();
+    if (android_documents_folder || QOperatingSystemVersion::current() >= QOperatingSystemVersion(QOperatingSystemVersion::Android, 14)) {
+        path = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/QZ/";
+        QDir().mkdir(path);
+    } else {
+        path = androidData() + "/";
+    }
+#elif defined(Q_OS_MACOS) || defined(Q_OS_OSX)
+    path = QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) + "/";
+#elif defined(Q_OS_IOS)
+    path = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/";
+#elif defined(Q_OS_WINDOWS)
+    path = QDir::currentPath() + "/";
+#endif
+    return path;
+}
+
+QString AppDirs::profiles() {
+    QString path = writable() + "profiles";
+    QDir().mkdir(path);
+    return path;
+}
+
+#if defined(Q_OS_ANDROID)
+QString AppDirs::androidData() {
+    static QString path = "";
+
+    if (path.length()) {
+        return path;
+    }
+
+    QAndroidJniObject filesArr = QtAndroid::androidActivity().callObjectMethod(
+        "getExternalFilesDirs", "(Ljava/lang/String;)[Ljava/io/File;", nullptr);
+    jobjectArray dataArray = filesArr.object<jobjectArray>();
+    QString out;
+    if (dataArray) {
+        QAndroidJniEnvironment env;
+        jsize dataSize = env->GetArrayLength(dataArray);
+        if (dataSize) {
+            QAndroidJniObject mediaPath;
+            QAndroidJniObject file;
+            for (int i = 0; i < dataSize; i++) {
+                file = env->GetObjectArrayElement(dataArray, i);
+                jboolean val = QAndroidJniObject::callStaticMethod<jboolean>(
+                    "android/os/Environment", "isExternalStorageRemovable", "(Ljava/io/File;)Z", file.object());
+                mediaPath = file.callObjectMethod("getAbsolutePath", "()Ljava/lang/String;");
+                out = mediaPath.toString();
+                if (!val)
+                    break;
+            }
+        }
+    }
+    path = out;
+    return out;
+}
+#endif
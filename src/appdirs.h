@@ -0,0 +1,30 @@
+#ifndef APPDIRS_H
+#define APPDIRS_H
+
+#include <QString>
+
+/**
+ * @brief The folders of the app where the files of the user are written (FIT files, logs, profiles...).
+ * They don't depend on the user interface: homeform, the headless mode and the services share them.
+ */
+class AppDirs {
+  public:
+    /**
+     * @brief writable The folder of the files of the user, with the trailing slash.
+     */
+    static QString writable();
+
+    /**
+     * @brief profiles The folder of the settings profiles, created if missing, without the trailing slash.
+     */
+    static QString profiles();
+
+#if defined(Q_OS_ANDROID)
+    /**
+     * @brief androidData The external files folder of the app, on the non removable storage when there is one.
+     */
+    static QString androidData();
+#endif
+};
+
+#endif // APPDIRS_H
@@ -0,0 +1,217 @@
+#ifndef CHARACTERISTICENCODER_H
+#define CHARACTERISTICENCODER_H
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <stdint.h>
+
+/**
+ * @brief Fixed size, stack allocated byte buffer used to build BLE notification payloads.
+ * All multi-byte fields are written little endian, as required by the Bluetooth SIG profiles.
+ */
+template <int N> class CharacteristicBuffer {
+  public:
+    static constexpr int capacity = N;
+
+    void u8(uint8_t v) {
+        Q_ASSERT(len < N);
+        buf[len++] = v;
+    }
+    void u16(uint16_t v) {
+        u8(v & 0xFF);
+        u8((v >> 8) & 0xFF);
+    }
+    void u24(uint32_t v) {
+        u8(v & 0xFF);
+        u8((v >> 8) & 0xFF);
+        u8((v >> 16) & 0xFF);
+    }
+    void u32(uint32_t v) {
+        u16(v & 0xFFFF);
+        u16((v >> 16) & 0xFFFF);
+    }
+
+    void clear() { len = 0; }
+    int size() const { return len; }
+    const uint8_t *data() const { return buf; }
+    const char *constData() const { return reinterpret_cast<const char *>(buf); }
+    void appendTo(QByteArray &out) const { out.append(constData(), len); }
+
+  private:
+    uint8_t buf[N];
+    int len = 0;
+};
+
+/**
+ * @brief Encoders for the notify characteristics exposed by the virtual devices and DirCon.
+ * Each encoder declares its flag layout and its maximum payload size at compile time; the
+ * fields are plain values so the byte layout can be tested without a bluetoothdevice.
+ */
+namespace CharacteristicEncoder {
+
+// 0x2AD2 Indoor Bike Data: inst. speed, inst. cadence, resistance level, inst. power, heart rate
+struct IndoorBikeData {
+    static constexpr uint16_t flags = 0x0264;
+    static constexpr int size = 2 + 2 + 2 + 2 + 2 + 1 + 1; // last byte: Bkool FTMS protocol HRM offset 1280 fix
+    typedef CharacteristicBuffer<size> Buffer;
+
+    struct Fields {
+        double speed = 0;      // km/h
+        double cadence = 0;    // 1/2 rpm, already multiplied by the cadence multiplier
+        double resistance = 0; // resistance level, 0 for machines without resistance
+        double watts = 0;
+        double heart = 0;
+    };
+
+    static void encode(const Fields &f, Buffer &out) {
+        out.u16(flags);
+        out.u16((uint16_t)qRound(f.speed * 100));
+        out.u16((uint16_t)f.cadence);
+        out.u8((uint8_t)(int16_t)f.resistance);
+        out.u8(0);
+        out.u16((uint16_t)(f.watts < 0 ? 0 : f.watts));
+        out.u8((uint8_t)(int16_t)f.heart);
+        out.u8(0);
+    }
+};
+
+// 0x2ACD Treadmill Data: inst. speed, total distance, inclination and ramp angle, heart rate
+struct TreadmillData {
+    static constexpr uint16_t flags = 0x010C;
+    static constexpr int size = 2 + 2 + 3 + 2 + 2 + 1;
+    typedef CharacteristicBuffer<size> Buffer;
+
+    struct Fields {
+        double speed = 0;       // km/h
+        double distance = 0;    // km
+        double inclination = 0; // percent
+        double ramp = 0;        // degrees
+        double heart = 0;
+    };
+
+    static void encode(const Fields &f, Buffer &out) {
+        out.u16(flags);
+        out.u16((uint16_t)qRound(f.speed * 100));
+        out.u24((uint32_t)qRound(f.distance * 1000));
+        out.u16((uint16_t)qRound(f.inclination * 10));
+        out.u16((uint16_t)(int16_t)qRound(f.ramp * 10));
+        out.u8((uint8_t)(int16_t)f.heart);
+    }
+};
+
+// 0x2AD1 Rower Data: stroke rate and count, total distance, inst. pace, inst. power, energy, heart rate
+struct RowerData {
+    static constexpr uint16_t flags = 0x032C;
+    static constexpr int size = 2 + 1 + 2 + 3 + 2 + 2 + 2 + 2 + 1 + 1 + 1;
+    typedef CharacteristicBuffer<size> Buffer;
+
+    struct Fields {
+        double strokeRate = 0; // strokes per minute
+        double strokeCount = 0;
+        double distance = 0; // km
+        int pace = 0;        // seconds per 500m
+        double watts = 0;
+        double calories = 0;
+        double heart = 0;
+    };
+
+    static void encode(const Fields &f, Buffer &out) {
+        out.u16(flags);
+        out.u8((uint8_t)(f.strokeRate * 2));
+        out.u16((uint16_t)f.strokeCount);
+        out.u24((uint32_t)(f.distance * 1000.0));
+        out.u16((uint16_t)f.pace);
+        out.u16((uint16_t)f.watts);
+        out.u16((uint16_t)f.calories); // total energy
+        out.u16((uint16_t)f.calories); // energy per hour
+        out.u8((uint8_t)((uint16_t)f.calories & 0xFF)); // energy per minute
+        out.u8((uint8_t)(int16_t)f.heart);
+        out.u8(0); // Bkool FTMS protocol HRM offset 1280 fix
+    }
+};
+
+// 0x2A63 Cycling Power Measurement: inst. power, wheel and crank revolution data
+struct CyclingPowerMeasurement {
+    static constexpr uint16_t flags = 0x0030;
+    static constexpr int size = 2 + 2 + 4 + 2 + 2 + 2;
+    typedef CharacteristicBuffer<size> Buffer;
+
+    struct Fields {
+        double watts = 0;
+        uint32_t wheelRevolutions = 0;
+        uint16_t lastWheelEventTime = 0; // 1/2048 s
+        uint16_t crankRevolutions = 0;
+        uint16_t lastCrankEventTime = 0; // 1/1024 s
+    };
+
+    static void encode(const Fields &f, Buffer &out) {
+        out.u16(flags);
+        out.u16((uint16_t)(f.watts < 0 ? 0 : f.watts));
+        out.u32(f.wheelRevolutions);
+        out.u16(f.lastWheelEventTime);
+        out.u16(f.crankRevolutions);
+        out.u16(f.lastCrankEventTime);
+    }
+};
+
+// 0x2A5B CSC Measurement: crank revolution data, optionally preceded by wheel revolution data
+struct CscMeasurement {
+    static constexpr uint8_t flagsCrank = 0x02;
+    static constexpr uint8_t flagsWheelAndCrank = 0x03;
+    static constexpr int size = 1 + 4 + 2 + 2 + 2;
+    typedef CharacteristicBuffer<size> Buffer;
+
+    struct Fields {
+        bool wheel = false;
+        uint32_t wheelRevolutions = 0;
+        uint16_t lastWheelEventTime = 0; // 1/1024 s
+        uint16_t crankRevolutions = 0;
+        uint16_t lastCrankEventTime = 0; // 1/1024 s
+    };
+
+    static void encode(const Fields &f, Buffer &out) {
+        out.u8(f.wheel ? flagsWheelAndCrank : flagsCrank);
+        if (f.wheel) {
+            out.u32(f.wheelRevolutions);
+            out.u16(f.lastWheelEventTime);
+        }
+        out.u16(f.crankRevolutions);
+        out.u16(f.lastCrankEventTime);
+    }
+};
+
+// 0x2A53 RSC Measurement: inst. speed, inst. cadence, total distance
+struct RscMeasurement {
+    static constexpr uint8_t flags = 0x02;
+    static constexpr int size = 1 + 2 + 1 + 4;
+    typedef CharacteristicBuffer<size> Buffer;
+
+    struct Fields {
+        double speed = 0; // km/h
+        double cadence = 0;
+        double distance = 0; // km
+    };
+
+    static void encode(const Fields &f, Buffer &out) {
+        out.u8(flags);
+        out.u16((uint16_t)(f.speed / 3.6 * 256));
+        out.u8((uint8_t)(int16_t)f.cadence);
+        out.u32((uint32_t)(f.distance * 10000.0));
+    }
+};
+
+// 0x2A37 Heart Rate Measurement: 8 bit heart rate value
+struct HeartRateMeasurement {
+    static constexpr uint8_t flags = 0x00;
+    static constexpr int size = 1 + 1;
+    typedef CharacteristicBuffer<size> Buffer;
+
+    static void encode(uint8_t heart, Buffer &out) {
+        out.u8(flags);
+        out.u8(heart);
+    }
+};
+
+} // namespace CharacteristicEncoder
+
+#endif // CHARACTERISTICENCODER_H
@@ -1,10 +1,12 @@
 #include "characteristicnotifier2a37.h"
+#include "characteristicencoder.h"
 
 CharacteristicNotifier2A37::CharacteristicNotifier2A37(bluetoothdevice *Bike, QObject *parent)
     : CharacteristicNotifier(0x2a37, parent), Bike(Bike) {}
 
 int CharacteristicNotifier2A37::notify(QByteArray &valueHR) {
-    valueHR.append(char(0));                                  // Flags that specify the format of the value.
-    valueHR.append(char(Bike->metrics_override_heartrate())); // Actual value.
+    CharacteristicEncoder::HeartRateMeasurement::Buffer buffer;
+    CharacteristicEncoder::HeartRateMeasurement::encode(Bike->metrics_override_heartrate(), buffer);
+    buffer.appendTo(valueHR);
     return CN_OK;
 }
@@ -1,4 +1,5 @@
 #include "characteristicnotifier2a63.h"
+#include "characteristicencoder.h"
 
 CharacteristicNotifier2A63::CharacteristicNotifier2A63(bluetoothdevice *Bike, QObject *parent)
     : CharacteristicNotifier(0x2a63, parent), Bike(Bike) {}
@@ -45,26 +46,17 @@ int CharacteristicNotifier2A63::notify(QByteArray &value) {
          
          */
         
-      uint32_t wheelCount = (uint32_t)Bike->currentCrankRevolutions() * 3;
-      uint16_t lastWheelK = Bike->lastCrankEventTime() * 2;
-        
-      value.append((char)0x30); // crank data present and wheel for apple watch
-      value.append((char)0x00);
-      value.append((char)(((uint16_t)normalizeWattage) & 0xFF));                     // watt
-      value.append((char)(((uint16_t)normalizeWattage) >> 8) & 0xFF);                // watt
-        
-        value.append((char)(((uint32_t)wheelCount) & 0xFF));      // revs count
-        value.append((char)(((uint32_t)wheelCount) >> 8) & 0xFF); // revs count
-        value.append((char)(((uint32_t)wheelCount) >> 16) & 0xFF); // revs count
-        value.append((char)(((uint32_t)wheelCount) >> 24) & 0xFF); // revs count
-        value.append((char)(lastWheelK & 0xff));                       // eventtime
-        value.append((char)(lastWheelK >> 8) & 0xFF);                  // eventtime
-        
-      value.append((char)(((uint16_t)Bike->currentCrankRevolutions()) & 0xFF));      // revs count
-      value.append((char)(((uint16_t)Bike->currentCrankRevolutions()) >> 8) & 0xFF); // revs count
-      value.append((char)(Bike->lastCrankEventTime() & 0xff));                       // eventtime
-      value.append((char)(Bike->lastCrankEventTime() >> 8) & 0xFF);                  // eventtime
-      return CN_OK;
+        CharacteristicEncoder::CyclingPowerMeasurement::Fields fields;
+        fields.watts = normalizeWattage;
+        fields.wheelRevolutions = (uint32_t)Bike->currentCrankRevolutions() * 3;
+        fields.lastWheelEventTime = Bike->lastCrankEventTime() * 2;
+        fields.crankRevolutions = (uint16_t)Bike->currentCrankRevolutions();
+        fields.lastCrankEventTime = Bike->lastCrankEventTime();
+
+        CharacteristicEncoder::CyclingPowerMeasurement::Buffer buffer;
+        CharacteristicEncoder::CyclingPowerMeasurement::encode(fields, buffer);
+        buffer.appendTo(value);
+        return CN_OK;
     } else
         return CN_INVALID;
 }
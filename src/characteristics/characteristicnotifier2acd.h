@@ -5,6 +5,9 @@
 
 class CharacteristicNotifier2ACD : public CharacteristicNotifier {
     bluetoothdevice *Bike;
+    bool real_inclination_to_virtual_treamill_bridge;
+    double zwift_inclination_offset;
+    double zwift_inclination_gain;
 
   public:
     explicit CharacteristicNotifier2ACD(bluetoothdevice *Bike, QObject *parent = nullptr);
@@ -1,57 +1,35 @@
 #include "characteristicnotifier2ad2.h"
+#include "characteristicencoder.h"
 #include "devices/elliptical.h"
 #include "devices/rower.h"
 #include "devices/treadmill.h"
 #include <QSettings>
 
 CharacteristicNotifier2AD2::CharacteristicNotifier2AD2(bluetoothdevice *Bike, QObject *parent)
-    : CharacteristicNotifier(0x2ad2, parent), Bike(Bike) {}
+    : CharacteristicNotifier(0x2ad2, parent), Bike(Bike) {
+    QSettings settings;
+    virtual_device_rower =
+        settings.value(QZSettings::virtual_device_rower, QZSettings::default_virtual_device_rower).toBool();
+    bool double_cadence = settings
+                              .value(QZSettings::powr_sensor_running_cadence_double,
+                                     QZSettings::default_powr_sensor_running_cadence_double)
+                              .toBool();
+    cadence_multiplier = double_cadence ? 1.0 : 2.0;
+}
 
 int CharacteristicNotifier2AD2::notify(QByteArray &value) {
     bluetoothdevice::BLUETOOTH_TYPE dt = Bike->deviceType();
-
-    QSettings settings;
-    bool virtual_device_rower =
-        settings.value(QZSettings::virtual_device_rower, QZSettings::default_virtual_device_rower).toBool();
     bool rowerAsABike = !virtual_device_rower && dt == bluetoothdevice::ROWING;
-    bool double_cadence = settings.value(QZSettings::powr_sensor_running_cadence_double, QZSettings::default_powr_sensor_running_cadence_double).toBool();
-    double cadence_multiplier = 2.0;
-    if (double_cadence)
-        cadence_multiplier = 1.0;
-
 
-    double normalizeWattage = Bike->wattsMetric().value();
-    if (normalizeWattage < 0)
-        normalizeWattage = 0;
+    CharacteristicEncoder::IndoorBikeData::Fields fields;
+    fields.speed = Bike->currentSpeed().value();
+    fields.watts = Bike->wattsMetric().value();
+    fields.heart = Bike->currentHeart().value();
 
     if (dt == bluetoothdevice::BIKE || rowerAsABike) {
-        uint16_t normalizeSpeed = (uint16_t)qRound(Bike->currentSpeed().value() * 100);
-        value.append((char)0x64); // speed, inst. cadence, resistance lvl, instant power
-        value.append((char)0x02); // heart rate
-
-        value.append((char)(normalizeSpeed & 0xFF));      // speed
-        value.append((char)(normalizeSpeed >> 8) & 0xFF); // speed
-
-        value.append((char)((uint16_t)(Bike->currentCadence().value() * cadence_multiplier) & 0xFF));        // cadence
-        value.append((char)(((uint16_t)(Bike->currentCadence().value() * cadence_multiplier) >> 8) & 0xFF)); // cadence
-
-        value.append((char)Bike->currentResistance().value()); // resistance
-        value.append((char)(0));                               // resistance
-
-        value.append((char)(((uint16_t)normalizeWattage) & 0xFF));      // watts
-        value.append((char)(((uint16_t)normalizeWattage) >> 8) & 0xFF); // watts
-
-        value.append(char(Bike->currentHeart().value())); // Actual value.
-        value.append((char)0);                            // Bkool FTMS protocol HRM offset 1280 fix
-        return CN_OK;
+        fields.cadence = Bike->currentCadence().value() * cadence_multiplier;
+        fields.resistance = Bike->currentResistance().value();
     } else if (dt == bluetoothdevice::TREADMILL || dt == bluetoothdevice::ELLIPTICAL || dt == bluetoothdevice::ROWING) {
-        uint16_t normalizeSpeed = (uint16_t)qRound(Bike->currentSpeed().value() * 100);
-        value.append((char)0x64); // speed, inst. cadence, resistance lvl, instant power
-        value.append((char)0x02); // heart rate
-
-        value.append((char)(normalizeSpeed & 0xFF));      // speed
-        value.append((char)(normalizeSpeed >> 8) & 0xFF); // speed
-
         uint16_t cadence = 0;
         if (dt == bluetoothdevice::ELLIPTICAL)
             cadence = ((elliptical *)Bike)->currentCadence().value();
@@ -59,19 +37,12 @@ int CharacteristicNotifier2AD2::notify(QByteArray &value) {
             cadence = ((treadmill *)Bike)->currentCadence().value();
         else if (dt == bluetoothdevice::ROWING)
             cadence = ((rower *)Bike)->currentCadence().value();
-
-        value.append((char)((uint16_t)(cadence * cadence_multiplier) & 0xFF));        // cadence
-        value.append((char)(((uint16_t)(cadence * cadence_multiplier) >> 8) & 0xFF)); // cadence
-
-        value.append((char)(0)); // resistance
-        value.append((char)(0)); // resistance
-
-        value.append((char)(((uint16_t)normalizeWattage) & 0xFF));      // watts
-        value.append((char)(((uint16_t)normalizeWattage) >> 8) & 0xFF); // watts
-
-        value.append(char(Bike->currentHeart().value())); // Actual value.
-        value.append((char)0);
-        return CN_OK;
+        fields.cadence = cadence * cadence_multiplier;
     } else
         return CN_INVALID;
+
+    CharacteristicEncoder::IndoorBikeData::Buffer buffer;
+    CharacteristicEncoder::IndoorBikeData::encode(fields, buffer);
+    buffer.appendTo(value);
+    return CN_OK;
 }
@@ -6,6 +6,8 @@
 
 class CharacteristicNotifier2AD2 : public CharacteristicNotifier {
     bluetoothdevice *Bike;
+    bool virtual_device_rower;
+    double cadence_multiplier;
 
   public:
     explicit CharacteristicNotifier2AD2(bluetoothdevice *Bike, QObject *parent = nullptr);
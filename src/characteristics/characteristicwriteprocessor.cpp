@@ -7,7 +7,26 @@ CharacteristicWriteProcessor::CharacteristicWriteProcessor(double bikeResistance
                                                            bluetoothdevice *bike, QObject *parent)
     : QObject(parent), bikeResistanceOffset(bikeResistanceOffset), bikeResistanceGain(bikeResistanceGain), Bike(bike) {}
 
-void CharacteristicWriteProcessor::changePower(uint16_t power) { Bike->changePower(power); }
+void CharacteristicWriteProcessor::changePower(uint16_t power) {
+    // a target power from the app replaces the one of the road
+    if (simErg)
+        simErg->stop();
+    Bike->changePower(power);
+}
+
+bool CharacteristicWriteProcessor::simErgEnabled() const {
+    if (Bike->deviceType() != bluetoothdevice::BIKE)
+        return false;
+    QSettings settings;
+    return settings.value(QZSettings::zwift_sim_erg, QZSettings::default_zwift_sim_erg).toBool() &&
+           !settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool() &&
+           !((bike *)Bike)->inclinationAvailableByHardware();
+}
+
+void CharacteristicWriteProcessor::stopSimulation() {
+    if (simErg)
+        simErg->stop();
+}
 
 void CharacteristicWriteProcessor::changeSlope(int16_t iresistance, uint8_t crr, uint8_t cw) {
     bluetoothdevice::BLUETOOTH_TYPE dt = Bike->deviceType();
@@ -75,12 +94,21 @@ void CharacteristicWriteProcessor::changeSlope(int16_t iresistance, uint8_t crr,
                 Bike->setInclination(grade + CRR_offset + CW_offset);
         }
 
-        emit changeInclination(grade, percentage);
-
-        if (force_resistance && !erg_mode) {
-            // same on the training program
-            Bike->changeResistance((resistance_t)(round(resistance * bikeResistanceGain)) + bikeResistanceOffset + 1 +
-                                   CRR_offset + CW_offset); // resistance start from 1
+        if (simErgEnabled()) {
+            // the power of the road at the current speed instead of a resistance proportional to the grade: the
+            // grade doesn't go to the bike, its drivers would fight the power target with it
+            if (!simErg)
+                simErg = new SimErgEngine(Bike, this);
+            simErg->setRoad(grade, fCRR, fCW);
+        } else {
+            if (simErg)
+                simErg->stop();
+            emit changeInclination(grade, percentage);
+            if (force_resistance && !erg_mode) {
+                // same on the training program
+                Bike->changeResistance((resistance_t)(round(resistance * bikeResistanceGain)) + bikeResistanceOffset +
+                                       1 + CRR_offset + CW_offset); // resistance start from 1
+            }
         }
     } else if (dt == bluetoothdevice::TREADMILL) {
         emit changeInclination(grade, percentage);
@@ -2,6 +2,7 @@
 #define CHARACTERISTICWRITEPROCESSOR_H
 
 #include "devices/bluetoothdevice.h"
+#include "simergengine.h"
 #include <QObject>
 #include <QSettings>
 #include <QtMath>
@@ -21,6 +22,18 @@ class CharacteristicWriteProcessor : public QObject {
     virtual int writeProcess(quint16 uuid, const QByteArray &data, QByteArray &out) = 0;
     virtual void changePower(uint16_t power);
     virtual void changeSlope(int16_t iresistance, uint8_t crr, uint8_t cw);
+
+  public slots:
+    // the app went away: the road it sent is not the road anymore
+    void stopSimulation();
+
+  protected:
+    // the road of the simulation goes to the bike as a target power instead of a grade
+    bool simErgEnabled() const;
+
+    // the road of the simulation as a target power, when zwift_sim_erg is on
+    SimErgEngine *simErg = nullptr;
+
   signals:
     void changeInclination(double grade, double percentage);
     void slopeChanged();
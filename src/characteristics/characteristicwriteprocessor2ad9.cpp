@@ -13,6 +13,17 @@ CharacteristicWriteProcessor2AD9::CharacteristicWriteProcessor2AD9(double bikeRe
 
 int CharacteristicWriteProcessor2AD9::writeProcess(quint16 uuid, const QByteArray &data, QByteArray &reply) {
     if (data.size()) {
+        switch ((quint8)data.at(0)) {
+        case FTMS_SET_TARGET_SPEED:
+        case FTMS_SET_TARGET_INCLINATION:
+        case FTMS_SET_TARGET_RESISTANCE_LEVEL:
+        case FTMS_SET_TARGET_POWER:
+        case FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS:
+            Bike->controlPointWritten();
+            break;
+        default:
+            break;
+        }
         bluetoothdevice::BLUETOOTH_TYPE dt = Bike->deviceType();
         if (dt == bluetoothdevice::BIKE) {
             QSettings settings;
@@ -21,7 +32,9 @@ int CharacteristicWriteProcessor2AD9::writeProcess(quint16 uuid, const QByteArra
                     .toBool();
             bool erg_mode = settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool();
             char cmd = data.at(0);
-            emit ftmsCharacteristicChanged(QLowEnergyCharacteristic(), data);
+            // the road of the simulation doesn't reach an FTMS bike as is while the sim ERG engine drives it
+            if (cmd != FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS || !simErgEnabled())
+                emit ftmsCharacteristicChanged(QLowEnergyCharacteristic(), data);
             if (cmd == FTMS_SET_TARGET_RESISTANCE_LEVEL) {
 
                 // Set Target Resistance
@@ -16,7 +16,10 @@ int CharacteristicWriteProcessorE005::writeProcess(quint16 uuid, const QByteArra
         bluetoothdevice::BLUETOOTH_TYPE dt = Bike->deviceType();
         if (dt == bluetoothdevice::BIKE) {
             char cmd = data.at(0);
-            emit ftmsCharacteristicChanged(QLowEnergyCharacteristic(), data);
+            // the road of the simulation doesn't reach a KICKR as is while the sim ERG engine drives it
+            if ((cmd != wahookickrsnapbike::_setSimMode && cmd != wahookickrsnapbike::_setSimGrade) ||
+                !simErgEnabled())
+                emit ftmsCharacteristicChanged(QLowEnergyCharacteristic(), data);
             if (cmd == wahookickrsnapbike::_setSimMode && data.count() >= 7) {
                 weight = ((double)((uint16_t)data.at(1)) + (((uint16_t)data.at(2)) >> 8)) / 100.0;
                 rrc = ((double)((uint16_t)data.at(3)) + (((uint16_t)data.at(4)) >> 8)) / 1000.0;
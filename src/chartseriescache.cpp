@@ -0,0 +1,126 @@
+#include "chartseriescache.h"
+
+int ChartSeriesCache::bucketSize(int level) {
+    int size = fanout;
+    for (int i = 0; i < level; i++)
+        size *= fanout;
+    return size;
+}
+
+void ChartSeriesCache::append(double value) {
+    int index = m_values.size();
+    float v = (float)value;
+    m_values.append(v);
+    for (int l = 0; l < levelsNum; l++) {
+        QVector<Bucket> &level = m_levels[l];
+        if (index / bucketSize(l) == level.size()) {
+            level.append({v, v, index, index});
+        } else {
+            Bucket &b = level.last();
+            if (v < b.min) {
+                b.min = v;
+                b.minIndex = index;
+            }
+            if (v > b.max) {
+                b.max = v;
+                b.maxIndex = index;
+            }
+        }
+    }
+}
+
+void ChartSeriesCache::clear() {
+    m_values.clear();
+    for (int l = 0; l < levelsNum; l++)
+        m_levels[l].clear();
+}
+
+ChartSeriesCache::Bucket ChartSeriesCache::rawBucket(int from, int to) const {
+    Bucket b = {m_values.at(from), m_values.at(from), from, from};
+    for (int i = from + 1; i < to; i++) {
+        float v = m_values.at(i);
+        if (v < b.min) {
+            b.min = v;
+            b.minIndex = i;
+        }
+        if (v > b.max) {
+            b.max = v;
+            b.maxIndex = i;
+        }
+    }
+    return b;
+}
+
+void ChartSeriesCache::merge(Bucket &into, const Bucket &b) {
+    if (b.min < into.min) {
+        into.min = b.min;
+        into.minIndex = b.minIndex;
+    }
+    if (b.max > into.max) {
+        into.max = b.max;
+        into.maxIndex = b.maxIndex;
+    }
+}
+
+ChartSeriesCache::Bucket ChartSeriesCache::rangeBucket(int from, int to) const {
+    // the largest complete buckets inside the range, its edges from the finer levels and then sample by sample
+    for (int l = levelsNum - 1; l >= 0; l--) {
+        const int size = bucketSize(l);
+        const int first = (from + size - 1) / size;
+        const int last = to / size;
+        if (first >= last)
+            continue;
+        Bucket b = m_levels[l].at(first);
+        for (int i = first + 1; i < last; i++)
+            merge(b, m_levels[l].at(i));
+        // merged in sample order, so a tie keeps the first sample as the buckets do
+        if (from < first * size) {
+            Bucket left = rangeBucket(from, first * size);
+            merge(left, b);
+            b = left;
+        }
+        if (last * size < to)
+            merge(b, rangeBucket(last * size, to));
+        return b;
+    }
+    return rawBucket(from, to);
+}
+
+void ChartSeriesCache::appendBucket(QVector<QPointF> &out, const Bucket &b) {
+    if (b.minIndex == b.maxIndex) {
+        out.append(QPointF(b.minIndex, b.min));
+    } else if (b.minIndex < b.maxIndex) {
+        out.append(QPointF(b.minIndex, b.min));
+        out.append(QPointF(b.maxIndex, b.max));
+    } else {
+        out.append(QPointF(b.maxIndex, b.max));
+        out.append(QPointF(b.minIndex, b.min));
+    }
+}
+
+QVector<QPointF> ChartSeriesCache::points(int from, int to, int maxPoints) const {
+    QVector<QPointF> out;
+    from = qMax(from, 0);
+    to = qMin(to, m_values.size());
+    if (from >= to || maxPoints <= 0)
+        return out;
+
+    if (to - from <= maxPoints) {
+        out.reserve(to - from);
+        for (int i = from; i < to; i++)
+            out.append(QPointF(i, m_values.at(i)));
+        return out;
+    }
+
+    const int parts = qMax(maxPoints / 2, 1);
+    const int length = (to - from + parts - 1) / parts;
+    out.reserve(parts * 2);
+    for (int i = from; i < to; i += length) {
+        Bucket b = rangeBucket(i, qMin(i + length, to));
+        if (maxPoints == 1)
+            out.append(QPointF(b.maxIndex, b.max));
+        else
+            appendBucket(out, b);
+    }
+    return out;
+}
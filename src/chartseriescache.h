@@ -0,0 +1,47 @@
+#ifndef CHARTSERIESCACHE_H
+#define CHARTSERIESCACHE_H
+
+#include <QPointF>
+#include <QVector>
+
+/**
+ * @brief Multi resolution cache of one chart series (one value per session sample).
+ * Every append updates a min/max pyramid (buckets of 4, 16, 64, 256, 1024 and 4096 samples), so any
+ * range of the session can be drawn with a bounded number of points, keeping the peaks,
+ * without walking the whole session.
+ */
+class ChartSeriesCache {
+  public:
+    void append(double value);
+    void clear();
+    int size() const { return m_values.size(); }
+
+    /**
+     * @brief points Gets at most maxPoints points covering the samples [from, to). x is the sample index.
+     * Ranges larger than maxPoints are split in maxPoints / 2 parts of the same length, each reduced to its min
+     * and its max in sample order (only the max with maxPoints 1).
+     */
+    QVector<QPointF> points(int from, int to, int maxPoints) const;
+
+  private:
+    struct Bucket {
+        float min;
+        float max;
+        int minIndex;
+        int maxIndex;
+    };
+
+    static const int fanout = 4;
+    static const int levelsNum = 6;
+
+    static int bucketSize(int level);
+    Bucket rawBucket(int from, int to) const;
+    Bucket rangeBucket(int from, int to) const;
+    static void merge(Bucket &into, const Bucket &b);
+    static void appendBucket(QVector<QPointF> &out, const Bucket &b);
+
+    QVector<float> m_values;
+    QVector<Bucket> m_levels[levelsNum];
+};
+
+#endif // CHARTSERIESCACHE_H
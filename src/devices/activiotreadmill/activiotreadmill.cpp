@@ -29,9 +29,9 @@ activiotreadmill::activiotreadmill(uint32_t pollDeviceTime, bool noConsole, bool
         lastInclination = forceInitInclination;
     }
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &activiotreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &activiotreadmill::update);
     refresh->start(pollDeviceTime);
 }
 
@@ -291,6 +291,7 @@ void activiotreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void activiotreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -302,8 +303,10 @@ void activiotreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
     emit debug(QStringLiteral(" << ") + QString::number(value.length()) + QStringLiteral(" ") + value.toHex(' '));
     emit packetReceived();
 
-    if (newValue.length() < 12)
+    if (newValue.length() < 12) {
+        notificationParseError(characteristic);
         return;
+    }
 
     lastPacket = value;
     // lastState = value.at(0);
@@ -19,12 +19,12 @@ using namespace std::chrono_literals;
 antbike::antbike(bool noWriteResistance, bool noHeartService, bool noVirtualDevice) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->noVirtualDevice = noVirtualDevice;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &antbike::update);
+    connect(refresh, &PollTimer::timeout, this, &antbike::update);
     refresh->start(200ms);
 }
 
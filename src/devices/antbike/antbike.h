@@ -44,7 +44,7 @@ class antbike : public bike {
     resistance_t resistanceFromPowerRequest(uint16_t power) override;
     
   private:
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
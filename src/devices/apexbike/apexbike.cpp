@@ -16,13 +16,13 @@ apexbike::apexbike(bool noWriteResistance, bool noHeartService, int8_t bikeResis
                    double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &apexbike::update);
+    connect(refresh, &PollTimer::timeout, this, &apexbike::update);
     refresh->start(200ms);
 }
 
@@ -129,6 +129,7 @@ void apexbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void apexbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
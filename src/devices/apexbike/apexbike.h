@@ -48,7 +48,7 @@ class apexbike : public bike {
     void sendPoll();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -21,13 +21,13 @@ bhfitnesselliptical::bhfitnesselliptical(bool noWriteResistance, bool noHeartSer
                                          double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &bhfitnesselliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &bhfitnesselliptical::update);
     refresh->start(200ms);
 
     // this bike doesn't send resistance, so I have to use the default value
@@ -133,6 +133,7 @@ void bhfitnesselliptical::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void bhfitnesselliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                 const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -46,7 +46,7 @@ class bhfitnesselliptical : public elliptical {
     uint16_t watts();
     void forceResistance(resistance_t requestResistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
     QLowEnergyService *gattFTMSService = nullptr;
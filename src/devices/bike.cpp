@@ -134,11 +134,13 @@ void bike::setGears(double gears) {
     }
 
     m_gears = gears;
-    if(homeform::singleton()) {
+    // a gym station is not the device of homeform, and runs on another thread
+    if(homeform::singleton() && !isGymStation()) {
         homeform::singleton()->updateGearsValue();
     }
 
-    if (settings.value(QZSettings::gears_restore_value, QZSettings::default_gears_restore_value).toBool())
+    if (!isGymStation() &&
+        settings.value(QZSettings::gears_restore_value, QZSettings::default_gears_restore_value).toBool())
         settings.setValue(QZSettings::gears_current_value, m_gears);
 
     if (lastRawRequestedResistanceValue != -1) {
@@ -183,6 +185,8 @@ void bike::clearStats() {
     RequestedCadence.clear(false);
     RequestedPower.clear(false);
     m_pelotonResistance.clear(false);
+    m_pedalSmoothness.clear(false);
+    m_rightBalance.clear(false);
     Cadence.clear(false);
     Resistance.clear(false);
     WattKg.clear(false);
@@ -205,6 +209,8 @@ void bike::setPaused(bool p) {
     m_watt.setPaused(p);
     WeightLoss.setPaused(p);
     m_pelotonResistance.setPaused(p);
+    m_pedalSmoothness.setPaused(p);
+    m_rightBalance.setPaused(p);
     Cadence.setPaused(p);
     Resistance.setPaused(p);
     RequestedPelotonResistance.setPaused(p);
@@ -236,6 +242,8 @@ void bike::setLap() {
     RequestedCadence.setLap(false);
     RequestedPower.setLap(false);
     m_pelotonResistance.setLap(false);
+    m_pedalSmoothness.setLap(false);
+    m_rightBalance.setLap(false);
     Cadence.setLap(false);
     Resistance.setLap(false);
     for(int i=0; i<maxHeartZone(); i++) {
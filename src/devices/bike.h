@@ -50,6 +50,20 @@ class bike : public bluetoothdevice {
      * @return A metric object.
      */
     metric currentSteeringAngle() { return m_steeringAngle; }
+
+    /**
+     * @brief currentPedalSmoothness Gets a metric object with the pedal smoothness of the last pedal stroke,
+     * as the average force over the peak force in percent. Only bikes with a force sensor (Computrainer SpinScan) set it.
+     * @return A metric object.
+     */
+    metric currentPedalSmoothness() { return m_pedalSmoothness; }
+
+    /**
+     * @brief currentRightBalance Gets a metric object with the share of the last pedal stroke produced by the right leg,
+     * in percent. Only bikes with a force sensor (Computrainer SpinScan) set it.
+     * @return A metric object.
+     */
+    metric currentRightBalance() { return m_rightBalance; }
     virtual bool inclinationAvailableByHardware();
     bool ergModeSupportedAvailableByHardware() { return ergModeSupported; }
 
@@ -107,6 +121,9 @@ class bike : public bluetoothdevice {
 
     metric m_steeringAngle;
 
+    metric m_pedalSmoothness;
+    metric m_rightBalance;
+
     double m_speedLimit = 0;
 
     uint16_t wattFromHR(bool useSpeedAndCadence);
@@ -18,11 +18,11 @@ using namespace std::chrono_literals;
 
 bkoolbike::bkoolbike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &bkoolbike::update);
+    connect(refresh, &PollTimer::timeout, this, &bkoolbike::update);
     refresh->start(200ms);
 }
 
@@ -192,6 +192,7 @@ void bkoolbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void bkoolbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
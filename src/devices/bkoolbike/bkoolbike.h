@@ -48,7 +48,7 @@ class bkoolbike : public bike {
     uint16_t watts() override;
     double bikeResistanceToPeloton(double resistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     const int max_resistance = 100;
 
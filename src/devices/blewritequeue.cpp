@@ -0,0 +1,197 @@
+#include "blewritequeue.h"
+#include "qzmetrics.h"
+#include <QDebug>
+
+BleWriteQueue::BleWriteQueue(QObject *parent) : QObject(parent) {
+    timer.setSingleShot(true);
+    connect(&timer, &QTimer::timeout, this, &BleWriteQueue::timeout);
+}
+
+int BleWriteQueue::depth() const {
+    int n = inFlight ? 1 : 0;
+    for (const Fifo &f : fifos)
+        n += f.requests.size();
+    return n;
+}
+
+void BleWriteQueue::enqueue(const Request &request) {
+    QBluetoothUuid uuid = request.characteristic.uuid();
+    int f = 0;
+    while (f < fifos.size() && fifos.at(f).characteristic != uuid)
+        f++;
+    if (f == fifos.size())
+        fifos.append({uuid, {}});
+    QList<Queued> &requests = fifos[f].requests;
+
+    if (request.coalesceKey) {
+        for (Queued &q : requests) {
+            if (q.request.coalesceKey == request.coalesceKey) {
+                // latest wins, but it keeps the place (and the wait time) of the request it replaces
+                q.request = request;
+                QZMetrics::increment(QZMetrics::BleWritesCoalesced);
+                return;
+            }
+        }
+    }
+
+    Queued q;
+    q.request = request;
+    q.enqueued.start();
+    requests.append(q);
+    QZMetrics::addGauge(QZMetrics::BleWriteQueueDepth, 1);
+
+    if (!inFlight)
+        sendNext();
+}
+
+void BleWriteQueue::clear() {
+    for (const Fifo &f : qAsConst(fifos))
+        QZMetrics::addGauge(QZMetrics::BleWriteQueueDepth, -f.requests.size());
+    fifos.clear();
+    nextFifo = 0;
+    lateAcks.clear();
+    if (inFlight) {
+        timer.stop();
+        disconnect(writtenConnection);
+        disconnect(changedConnection);
+        inFlight = false;
+        QZMetrics::addGauge(QZMetrics::BleWriteQueueDepth, -1);
+    }
+}
+
+void BleWriteQueue::sendNext() {
+    while (!inFlight) {
+        // round robin over the characteristics, FIFO inside each one
+        int f = -1;
+        for (int i = 0; i < fifos.size(); i++) {
+            int candidate = (nextFifo + i) % fifos.size();
+            if (!fifos.at(candidate).requests.isEmpty()) {
+                f = candidate;
+                break;
+            }
+        }
+        if (f < 0)
+            return;
+        nextFifo = (f + 1) % fifos.size();
+
+        Queued q = fifos[f].requests.takeFirst();
+        current = q.request;
+        currentWritten = false;
+        inFlight = true;
+        sentAt.start();
+        timer.start(timeoutMs);
+        if (!send(current)) {
+            // the service went away with the connection
+            qDebug() << QStringLiteral("BleWriteQueue: write to a null service dropped");
+            timer.stop();
+            disconnect(writtenConnection);
+            disconnect(changedConnection);
+            inFlight = false;
+            current = Request();
+            QZMetrics::addGauge(QZMetrics::BleWriteQueueDepth, -1);
+            continue;
+        }
+        QZMetrics::observe(QZMetrics::BleWriteQueueWait, q.enqueued.nsecsElapsed() / 1000000000.0);
+        QZMetrics::increment(QZMetrics::BleWrites);
+        emit requestSent(q.request.data);
+
+        // Qt never emits characteristicWritten for a write without response: it's done once handed to the stack
+        if (inFlight && current.mode == QLowEnergyService::WriteWithoutResponse && current.response == NoResponse)
+            finish(false);
+    }
+}
+
+bool BleWriteQueue::send(const Request &request) {
+    if (!request.service)
+        return false;
+    writtenConnection = connect(request.service, &QLowEnergyService::characteristicWritten, this,
+                                &BleWriteQueue::characteristicWritten);
+    if (request.response != NoResponse)
+        changedConnection = connect(request.service, &QLowEnergyService::characteristicChanged, this,
+                                    &BleWriteQueue::characteristicChanged);
+    request.service->writeCharacteristic(request.characteristic, request.data, request.mode);
+    return true;
+}
+
+void BleWriteQueue::finish(bool timedOut) {
+    timer.stop();
+    disconnect(writtenConnection);
+    disconnect(changedConnection);
+    inFlight = false;
+    QZMetrics::addGauge(QZMetrics::BleWriteQueueDepth, -1);
+    QZMetrics::observe(QZMetrics::BleWriteLatency, sentAt.nsecsElapsed() / 1000000000.0);
+    if (timedOut) {
+        QZMetrics::increment(QZMetrics::BleWriteTimeouts);
+        QBluetoothUuid uuid = current.characteristic.uuid();
+        if (current.mode == QLowEnergyService::WriteWithResponse && !currentWritten) {
+            lateAcks.append({uuid, -1, QElapsedTimer()});
+            lateAcks.last().since.start();
+        }
+        if (current.response == ControlPointResponse && !current.data.isEmpty()) {
+            lateAcks.append({uuid, (quint8)current.data.at(0), QElapsedTimer()});
+            lateAcks.last().since.start();
+        }
+    }
+    QByteArray data = current.data;
+    current = Request();
+    emit requestCompleted(data, timedOut);
+}
+
+void BleWriteQueue::complete(bool timedOut) {
+    if (!inFlight)
+        return;
+    finish(timedOut);
+    sendNext();
+}
+
+bool BleWriteQueue::takeLateAck(const QBluetoothUuid &characteristic, int opcode) {
+    for (int i = lateAcks.size() - 1; i >= 0; i--) {
+        if (lateAcks.at(i).since.elapsed() > timeoutMs)
+            lateAcks.removeAt(i);
+    }
+    for (int i = 0; i < lateAcks.size(); i++) {
+        if (lateAcks.at(i).characteristic == characteristic && lateAcks.at(i).opcode == opcode) {
+            lateAcks.removeAt(i);
+            qDebug() << QStringLiteral("BleWriteQueue: late ack of a timed out write dropped");
+            return true;
+        }
+    }
+    return false;
+}
+
+void BleWriteQueue::written(const QBluetoothUuid &characteristic) {
+    if (takeLateAck(characteristic, -1))
+        return;
+    if (!inFlight || characteristic != current.characteristic.uuid())
+        return;
+    currentWritten = true;
+    if (current.response == NoResponse)
+        complete(false);
+}
+
+void BleWriteQueue::changed(const QBluetoothUuid &characteristic, const QByteArray &value) {
+    if (!inFlight)
+        return;
+    // response code, request opcode, result
+    bool response = value.size() >= 2 && (quint8)value.at(0) == 0x80;
+    if (response && takeLateAck(characteristic, (quint8)value.at(1)))
+        return;
+    if (current.response == AnyNotification) {
+        complete(false);
+    } else if (current.response == ControlPointResponse) {
+        if (response && characteristic == current.characteristic.uuid() && !current.data.isEmpty() &&
+            value.at(1) == current.data.at(0))
+            complete(false);
+    }
+}
+
+void BleWriteQueue::characteristicWritten(const QLowEnergyCharacteristic &characteristic, const QByteArray &value) {
+    Q_UNUSED(value)
+    written(characteristic.uuid());
+}
+
+void BleWriteQueue::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &value) {
+    changed(characteristic.uuid(), value);
+}
+
+void BleWriteQueue::timeout() { complete(true); }
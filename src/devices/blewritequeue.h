@@ -0,0 +1,114 @@
+#ifndef BLEWRITEQUEUE_H
+#define BLEWRITEQUEUE_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QtBluetooth/qlowenergycharacteristic.h>
+#include <QtBluetooth/qlowenergyservice.h>
+
+/**
+ * @brief Asynchronous GATT write queue shared by the drivers, as a replacement of the nested QEventLoop
+ * that every writeCharacteristic spins until the write completes.
+ *
+ * Requests are kept in one FIFO per characteristic and sent one at a time, since the GATT procedures of a
+ * connection are serial anyway. A request completes when the write is confirmed (characteristicWritten), as soon
+ * as it's sent for a write without response (Qt never confirms those), or on the response it waits for, or when
+ * the timeout expires. The confirmation or the response of a request that timed out can still come late: it's
+ * dropped instead of completing the request sent after it, if it comes within another timeout.
+ * Setpoint commands carry a coalesceKey: a queued request with the same key and characteristic is replaced
+ * in place, so only the latest target reaches the device when targets change faster than the device acks.
+ */
+class BleWriteQueue : public QObject {
+
+    Q_OBJECT
+
+  public:
+    enum Response {
+        NoResponse,           // done when written
+        ControlPointResponse, // done on the 0x80 response with the opcode of the request, on its characteristic
+        AnyNotification,      // done on the first notification of the service
+    };
+
+    struct Request {
+        QPointer<QLowEnergyService> service;
+        QLowEnergyCharacteristic characteristic;
+        QByteArray data;
+        QLowEnergyService::WriteMode mode = QLowEnergyService::WriteWithResponse;
+        Response response = NoResponse;
+        quint32 coalesceKey = 0; // 0: never coalesced
+    };
+
+    explicit BleWriteQueue(QObject *parent = nullptr);
+
+    void enqueue(const Request &request);
+    void clear();
+    void setTimeout(int ms) { timeoutMs = ms; }
+
+    /**
+     * @brief depth Requests queued or in flight.
+     */
+    int depth() const;
+    bool idle() const { return !inFlight; }
+
+  signals:
+    /**
+     * @brief requestSent Emitted when a request leaves for the device.
+     */
+    void requestSent(const QByteArray &data);
+    void requestCompleted(const QByteArray &data, bool timedOut);
+
+  protected:
+    /**
+     * @brief send Writes request to its service, false if the service went away.
+     */
+    virtual bool send(const Request &request);
+
+    // the signals of the service of the request in flight
+    void written(const QBluetoothUuid &characteristic);
+    void changed(const QBluetoothUuid &characteristic, const QByteArray &value);
+
+  private slots:
+    void characteristicWritten(const QLowEnergyCharacteristic &characteristic, const QByteArray &value);
+    void characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &value);
+    void timeout();
+
+  private:
+    struct Queued {
+        Request request;
+        QElapsedTimer enqueued;
+    };
+    struct Fifo {
+        QBluetoothUuid characteristic;
+        QList<Queued> requests;
+    };
+
+    // the confirmation (opcode -1) or the response a timed out request never got
+    struct LateAck {
+        QBluetoothUuid characteristic;
+        int opcode;
+        QElapsedTimer since;
+    };
+
+    void sendNext();
+    void finish(bool timedOut);
+    void complete(bool timedOut);
+    bool takeLateAck(const QBluetoothUuid &characteristic, int opcode);
+
+    QList<Fifo> fifos;
+    int nextFifo = 0;
+    bool inFlight = false;
+    Request current;
+    bool currentWritten = false;
+    QList<LateAck> lateAcks;
+    QElapsedTimer sentAt;
+    QMetaObject::Connection writtenConnection;
+    QMetaObject::Connection changedConnection;
+    QTimer timer;
+    int timeoutMs = 300;
+};
+
+#endif // BLEWRITEQUEUE_H
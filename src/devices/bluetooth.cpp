@@ -1,4 +1,5 @@
 #include "bluetooth.h"
+#include "gymmanager.h"
 #include "homeform.h"
 #include <QBluetoothLocalDevice>
 #include <QDateTime>
@@ -398,6 +399,10 @@ bool bluetooth::deviceHasService(const QBluetoothDeviceInfo &device, QBluetoothU
 
 void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
 
+    // the trainers of the gym stations are searched and owned by their stations
+    if (GymManager::isReserved(device))
+        return;
+
     QSettings settings;
     QString heartRateBeltName =
         settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
@@ -2607,7 +2612,8 @@ void bluetooth::connectedAndDiscovered() {
                 // connect(heartRateBelt, SIGNAL(disconnected()), this, SLOT(restart()));
 
                 connect(heartRateBelt, SIGNAL(debug(QString)), this, SLOT(debug(QString)));
-                connect(heartRateBelt, SIGNAL(heartRate(uint8_t)), this->device(), SLOT(heartRate(uint8_t)));
+                connectSensor(heartRateBelt, &heartratebelt::heartRate, SensorFusion::Heart,
+                              SensorFusion::HeartRateBelt);
                 QBluetoothDeviceInfo bt;
                 bt.setDeviceUuid(QBluetoothUuid(
                     settings.value(QZSettings::hrm_lastdevice_address, QZSettings::default_hrm_lastdevice_address)
@@ -2631,7 +2637,8 @@ void bluetooth::connectedAndDiscovered() {
                 // connect(heartRateBelt, SIGNAL(disconnected()), this, SLOT(restart()));
 
                 connect(heartRateBelt, &heartratebelt::debug, this, &bluetooth::debug);
-                connect(heartRateBelt, &heartratebelt::heartRate, this->device(), &bluetoothdevice::heartRate);
+                connectSensor(heartRateBelt, &heartratebelt::heartRate, SensorFusion::Heart,
+                              SensorFusion::HeartRateBelt);
                 heartRateBelt->deviceDiscovered(b);
                 if(homeform::singleton())
                     homeform::singleton()->setToastRequested(b.name() + " (HR sensor) connected!");
@@ -2718,8 +2725,8 @@ void bluetooth::connectedAndDiscovered() {
                     // connect(heartRateBelt, SIGNAL(disconnected()), this, SLOT(restart()));
 
                     connect(cadenceSensor, &cscbike::debug, this, &bluetooth::debug);
-                    connect(cadenceSensor, &bluetoothdevice::cadenceChanged, this->device(),
-                            &bluetoothdevice::cadenceSensor);
+                    connectSensor(cadenceSensor, &bluetoothdevice::cadenceChanged, SensorFusion::Cadence,
+                                  SensorFusion::CadenceSensor);
                     cadenceSensor->deviceDiscovered(b);
                     if(homeform::singleton())
                         homeform::singleton()->setToastRequested(b.name() + " (cadence sensor) connected!");
@@ -2745,21 +2752,22 @@ void bluetooth::connectedAndDiscovered() {
                     // connect(heartRateBelt, SIGNAL(disconnected()), this, SLOT(restart()));
 
                     connect(powerSensor, &stagesbike::debug, this, &bluetooth::debug);
-                    connect(powerSensor, &bluetoothdevice::powerChanged, this->device(), &bluetoothdevice::powerSensor);
+                    connectSensor(powerSensor, &bluetoothdevice::powerChanged, SensorFusion::Power,
+                                  SensorFusion::PowerSensor);
                     powerSensor->deviceDiscovered(b);
                 } else if (device() && device()->deviceType() == bluetoothdevice::TREADMILL) {
                     powerSensorRun = new strydrunpowersensor(false, false, true);
                     // connect(heartRateBelt, SIGNAL(disconnected()), this, SLOT(restart()));
 
-                    connect(powerSensorRun, &strydrunpowersensor::onHeartRate, this->device(),
-                            &bluetoothdevice::heartRate);
+                    connectSensor(powerSensorRun, &strydrunpowersensor::onHeartRate, SensorFusion::Heart,
+                                  SensorFusion::RunPowerSensor);
                     connect(powerSensorRun, &strydrunpowersensor::debug, this, &bluetooth::debug);
-                    connect(powerSensorRun, &bluetoothdevice::powerChanged, this->device(),
-                            &bluetoothdevice::powerSensor);
-                    connect(powerSensorRun, &bluetoothdevice::cadenceChanged, this->device(),
-                            &bluetoothdevice::cadenceSensor);
-                    connect(powerSensorRun, &bluetoothdevice::speedChanged, this->device(),
-                            &bluetoothdevice::speedSensor);
+                    connectSensor(powerSensorRun, &bluetoothdevice::powerChanged, SensorFusion::Power,
+                                  SensorFusion::RunPowerSensor);
+                    connectSensor(powerSensorRun, &bluetoothdevice::cadenceChanged, SensorFusion::Cadence,
+                                  SensorFusion::RunPowerSensor);
+                    connectSensor(powerSensorRun, &bluetoothdevice::speedChanged, SensorFusion::Speed,
+                                  SensorFusion::RunPowerSensor);
                     connect(powerSensorRun, &bluetoothdevice::instantaneousStrideLengthChanged, this->device(),
                             &bluetoothdevice::instantaneousStrideLengthSensor);
                     connect(powerSensorRun, &bluetoothdevice::groundContactChanged, this->device(),
@@ -3018,6 +3026,7 @@ void bluetooth::heartRate(uint8_t heart) { Q_UNUSED(heart) }
 void bluetooth::restart() {
 
     QSettings settings;
+    QZMetrics::increment(QZMetrics::DeviceReconnects);
 
     if (onlyDiscover) {
 
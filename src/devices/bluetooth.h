@@ -128,6 +128,7 @@
 
 #include "devices/echelonstride/echelonstride.h"
 
+#include "sensorfusion.h"
 #include "templateinfosenderbuilder.h"
 #include "technogymbike/technogymbike.h"
 #include "devices/toorxtreadmill/toorxtreadmill.h"
@@ -329,6 +330,18 @@ class bluetooth : public QObject, public SignalHandler {
     bool sramDeviceAvaiable();
     bool fitmetria_fanfit_isconnected(QString name);
 
+    /**
+     * @brief connectSensor Sends the values of signal of an accessory sensor to the sensor fusion of the device,
+     * as the metric of source.
+     */
+    template <typename Sensor, typename Sender, typename Value>
+    void connectSensor(Sensor *sensor, void (Sender::*signal)(Value), SensorFusion::Metric metric,
+                       SensorFusion::Source source) {
+        SensorFusion *fusion = device()->sensorFusion();
+        connect(sensor, signal, fusion,
+                [fusion, metric, source](Value value) { fusion->input(metric, source, value); });
+    }
+
 #ifdef Q_OS_WIN
     QTimer discoveryTimeout;
 #endif
@@ -1,4 +1,5 @@
 #include "devices/bluetoothdevice.h"
+#include "sensorfusion.h"
 
 #include <QFile>
 #include <QSettings>
@@ -11,7 +12,10 @@
 #include "ios/lockscreen.h"
 #endif
 
-bluetoothdevice::bluetoothdevice() {}
+bluetoothdevice::bluetoothdevice() {
+    Cadence.setType(metric::METRIC_CADENCE);
+    Heart.setType(metric::METRIC_HEART);
+}
 
 bluetoothdevice::~bluetoothdevice() {
     if(this->virtualDevice) {
@@ -133,11 +137,51 @@ bool bluetoothdevice::connected() { return false; }
 metric bluetoothdevice::elevationGain() { return elevationAcc; }
 void bluetoothdevice::heartRate(uint8_t heart) { Heart.setValue(heart); }
 void bluetoothdevice::disconnectBluetooth() {
+    if (m_writeQueue) {
+        m_writeQueue->clear();
+    }
     if (m_control) {
         m_control->disconnectFromDevice();
     }
 }
 metric bluetoothdevice::wattsMetric() { return m_watt; }
+
+QZMetrics::IngressScope bluetoothdevice::notificationReceived(const QLowEnergyCharacteristic &characteristic) {
+    QZMetrics::increment(QZMetrics::BleNotificationsReceived, characteristic.uuid().data1);
+    return QZMetrics::IngressScope(QZMetrics::monotonicNs());
+}
+
+void bluetoothdevice::notificationParseError(const QLowEnergyCharacteristic &characteristic) {
+    QZMetrics::increment(QZMetrics::BleParseErrors, characteristic.uuid().data1);
+}
+
+void bluetoothdevice::controlWriteSent() {
+    if (m_controlPointNs) {
+        QZMetrics::observeSince(QZMetrics::ControlPointToDeviceWriteLatency, m_controlPointNs);
+        m_controlPointNs = 0;
+    }
+}
+
+BleWriteQueue *bluetoothdevice::writeQueue() {
+    if (!m_writeQueue) {
+        m_writeQueue = new BleWriteQueue(this);
+        connect(m_writeQueue, &BleWriteQueue::requestSent, this, [this]() { controlWriteSent(); });
+    }
+    return m_writeQueue;
+}
+
+SensorFusion *bluetoothdevice::sensorFusion() {
+    if (!m_sensorFusion) {
+        m_sensorFusion = new SensorFusion(this, 250, this);
+        m_sensorFusion->loadSettings();
+    }
+    return m_sensorFusion;
+}
+
+qint64 bluetoothdevice::ingressNs() {
+    return qMax(qMax(Speed.ingressNs(), m_watt.ingressNs()), qMax(Cadence.ingressNs(), Heart.ingressNs()));
+}
+
 void bluetoothdevice::setDifficult(double d) { m_difficult = d; }
 double bluetoothdevice::difficult() { return m_difficult; }
 void bluetoothdevice::setInclinationDifficult(double d) { m_inclination_difficult = d; }
@@ -4,6 +4,9 @@
 #include "definitions.h"
 #include "metric.h"
 #include "qzsettings.h"
+#include "qzmetrics.h"
+#include "devices/blewritequeue.h"
+#include "devices/pollscheduler.h"
 #include "ergtable.h"
 
 #include <QBluetoothDeviceDiscoveryAgent>
@@ -25,6 +28,8 @@
 
 #include "virtualdevices/virtualdevice.h"
 
+class SensorFusion;
+
 #if defined(Q_OS_IOS)
 #define SAME_BLUETOOTH_DEVICE(d1, d2) (d1.deviceUuid() == d2.deviceUuid())
 #else
@@ -62,6 +67,34 @@ class bluetoothdevice : public QObject {
      */
     virtual metric currentHeart();
 
+    /**
+     * @brief ingressNs Gets the monotonic stamp of the freshest BLE packet behind the values notified to the apps
+     * (speed, power, cadence, heart rate). 0 if none of them came from a notification.
+     */
+    qint64 ingressNs();
+
+    /**
+     * @brief controlPointWritten Stamps a control point write of an app (FTMS 0x2AD9), to measure how long it takes
+     * to reach the device.
+     */
+    void controlPointWritten() { m_controlPointNs = QZMetrics::monotonicNs(); }
+
+    /**
+     * @brief sensorFusion Gets the merger of the accessory sensors of the device, created on first use: the heart
+     * rate belt, the power, cadence and Stryd sensors send their values there instead of to heartRate(),
+     * powerSensor(), cadenceSensor() and speedSensor(). The merged value reaches them as each reading arrives, the
+     * timer of the merger only drops the stale sensors and moves the cadence window.
+     */
+    SensorFusion *sensorFusion();
+    bool hasSensorFusion() const { return m_sensorFusion != nullptr; }
+
+    /**
+     * @brief setGymStation Marks the device as the trainer of a gym station. It runs on a thread of the gym mode
+     * and its station has the DirCon endpoint: it creates no virtual device and leaves homeform alone.
+     */
+    void setGymStation(bool gymStation) { m_gymStation = gymStation; }
+    bool isGymStation() const { return m_gymStation; }
+
     /**
      * @brief currentSpeed Gets a metric object for getting and setting the speed. Units: km/h
      */
@@ -735,6 +768,30 @@ class bluetoothdevice : public QObject {
      */
     void setVirtualDevice(virtualdevice *virtualDevice, VIRTUAL_DEVICE_MODE mode);
 
+    /**
+     * @brief notificationReceived Accounts a notification received from the device in the pipeline metrics.
+     * Drivers call it first thing in their characteristicChanged slot and keep the returned scope until the slot
+     * returns: the metrics set in between take the stamp of the notification.
+     */
+    Q_REQUIRED_RESULT QZMetrics::IngressScope notificationReceived(const QLowEnergyCharacteristic &characteristic);
+
+    /**
+     * @brief notificationParseError Accounts a notification the driver had to discard because it could not decode it.
+     */
+    void notificationParseError(const QLowEnergyCharacteristic &characteristic);
+
+    /**
+     * @brief controlWriteSent Accounts the latency from the last controlPointWritten() to the write that applies it
+     * to the device. Drivers call it when a write leaves for the device.
+     */
+    void controlWriteSent();
+
+    /**
+     * @brief writeQueue Gets the asynchronous write queue of the device, created on first use. Drivers migrating
+     * away from the nested QEventLoop in their writeCharacteristic enqueue their writes here.
+     */
+    BleWriteQueue *writeQueue();
+
     /**
      * @brief writeBuffer contains the last byte array request via bluetooth to the fitness devices
      */
@@ -749,6 +806,15 @@ class bluetoothdevice : public QObject {
     VIRTUAL_DEVICE_MODE virtualDeviceMode = VIRTUAL_DEVICE_MODE::NONE;
     virtualdevice *virtualDevice = nullptr;
 
+    /**
+     * @brief m_controlPointNs Stamp of the last control point write not yet applied to the device, 0 if none.
+     */
+    qint64 m_controlPointNs = 0;
+
+    BleWriteQueue *m_writeQueue = nullptr;
+    SensorFusion *m_sensorFusion = nullptr;
+    bool m_gymStation = false;
+
   protected:
     // useful to understand if a power sensor device for treadmill, it's a real one like the stryd or it's a dumb one like the runpod from Zwift
     bool powerReceivedFromPowerSensor = false;
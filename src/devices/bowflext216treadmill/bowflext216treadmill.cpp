@@ -34,9 +34,9 @@ bowflext216treadmill::bowflext216treadmill(uint32_t pollDeviceTime, bool noConso
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &bowflext216treadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &bowflext216treadmill::update);
     refresh->start(500ms);
 }
 
@@ -173,6 +173,7 @@ void bowflext216treadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void bowflext216treadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                  const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
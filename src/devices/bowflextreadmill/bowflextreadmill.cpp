@@ -34,9 +34,9 @@ bowflextreadmill::bowflextreadmill(uint32_t pollDeviceTime, bool noConsole, bool
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &bowflextreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &bowflextreadmill::update);
     refresh->start(500ms);
 }
 
@@ -169,6 +169,7 @@ void bowflextreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void bowflextreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
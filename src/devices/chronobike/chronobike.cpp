@@ -18,12 +18,12 @@ using namespace std::chrono_literals;
 chronobike::chronobike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     t_timeout = new QTimer(this);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     // initDone = false;
-    connect(refresh, &QTimer::timeout, this, &chronobike::update);
+    connect(refresh, &PollTimer::timeout, this, &chronobike::update);
     connect(t_timeout, &QTimer::timeout, this, &chronobike::connection_timeout);
     refresh->start(200ms);
 }
@@ -126,6 +126,7 @@ void chronobike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void chronobike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -137,8 +138,10 @@ void chronobike::characteristicChanged(const QLowEnergyCharacteristic &character
 
     lastPacket = newValue;
 
-    if (newValue.length() != 19)
+    if (newValue.length() != 19) {
+        notificationParseError(characteristic);
         return;
+    }
 
     if (settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name)
             .toString()
@@ -44,7 +44,7 @@ class chronobike : public bike {
     void startDiscover();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
     QTimer *t_timeout;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
@@ -58,15 +58,9 @@ const static uint8_t rrc_command[56] = {
  * ---------------------------------------------------------------------- */
 Computrainer::Computrainer(QObject *parent, QString devname) : QThread(parent) {
 
-    devicePower = deviceHeartRate = deviceCadence = deviceSpeed = deviceRRC = 0.00;
-    for (int i = 0; i < 24; spinScan[i++] = 0)
-        ;
     mode = DEFAULT_MODE;
     load = DEFAULT_LOAD;
     gradient = DEFAULT_GRADIENT;
-    deviceCalibrated = false;
-    deviceHRConnected = false;
-    deviceCADConnected = false;
     setDevice(devname);
     deviceStatus = 0;
     this->parent = parent;
@@ -118,60 +112,49 @@ void Computrainer::setGradient(double gradient) {
 /* ----------------------------------------------------------------------
  * GET
  * ---------------------------------------------------------------------- */
-bool Computrainer::isHRConnected() {
-    bool tmp;
-    pvars.lock();
-    tmp = deviceHRConnected;
-    pvars.unlock();
-
-    return tmp;
+const ComputrainerTelemetry &Computrainer::telemetry() {
+    // clear the pending flag first: a message published after it re-arms the notification
+    telemetryPending.store(false, std::memory_order_relaxed);
+    telemetryChannel.update();
+    return telemetryChannel.front();
 }
 
-bool Computrainer::isCADConnected() {
-    bool tmp;
-    pvars.lock();
-    tmp = deviceCADConnected;
-    pvars.unlock();
-
-    return tmp;
+int Computrainer::takeButtons() {
+    // work around to ensure controller doesn't miss button press.
+    // The run thread will only set the button bits, they don't get
+    // reset until the ui reads the device state
+    //  Borrowed from: Fortius.cpp
+    return deviceButtons.exchange(0, std::memory_order_relaxed);
 }
 
-bool Computrainer::isCalibrated() {
-    bool tmp;
-    pvars.lock();
-    tmp = deviceCalibrated;
-    pvars.unlock();
+bool Computrainer::isHRConnected() { return telemetry().hrConnected; }
 
-    return tmp;
-}
+bool Computrainer::isCADConnected() { return telemetry().cadConnected; }
+
+bool Computrainer::isCalibrated() { return telemetry().calibrated; }
 
 void Computrainer::getTelemetry(double &power, double &heartrate, double &cadence, double &speed, double &RRC,
                                 bool &calibration, int &buttons, uint8_t *ss, int &status) {
 
+    const ComputrainerTelemetry &t = telemetry();
+    power = t.power;
+    heartrate = t.heartRate;
+    cadence = t.cadence;
+    speed = t.speed;
+    RRC = t.RRC;
+    calibration = t.calibrated;
+    buttons = takeButtons();
+    memcpy((void *)ss, (const void *)t.spinScan, 24);
+
     pvars.lock();
-    power = devicePower;
-    heartrate = deviceHeartRate;
-    cadence = deviceCadence;
-    speed = deviceSpeed;
-    RRC = deviceRRC;
-    calibration = deviceCalibrated;
-    buttons = deviceButtons;
     status = deviceStatus;
-    memcpy((void *)ss, (void *)spinScan, 24);
-
-    // work around to ensure controller doesn't miss button press.
-    // The run thread will only set the button bits, they don't get
-    // reset until the ui reads the device state
-    //  Borrowed from: Fortius.cpp
-    deviceButtons = 0;
     pvars.unlock();
 }
 
 void Computrainer::getSpinScan(double spinData[]) {
-    pvars.lock();
-    for (int i = 0; i < 24; spinData[i] = this->spinScan[i])
-        ;
-    pvars.unlock();
+    const ComputrainerTelemetry &t = telemetry();
+    for (int i = 0; i < 24; i++)
+        spinData[i] = t.spinScan[i];
 }
 
 int Computrainer::getMode() {
@@ -308,8 +291,26 @@ void Computrainer::prepareCommand(int mode, double value) {
 // thanks to Sean Rhea for working this one out!
 int Computrainer::calcCRC(int value) { return (0xff & (107 - (value & 0xff) - (value >> 8))); }
 
+bool ComputrainerTelemetry::pedalStroke(double &smoothness, double &rightBalance) const {
+    double sum = 0, right = 0, peak = 0;
+    for (int i = 0; i < 24; i++) {
+        sum += spinScan[i];
+        if (i >= 12)
+            right += spinScan[i];
+        if (spinScan[i] > peak)
+            peak = spinScan[i];
+    }
+    if (peak <= 0)
+        return false;
+    smoothness = 100.0 * (sum / 24.0) / peak;
+    rightBalance = 100.0 * right / sum;
+    return true;
+}
+
 // funny, just a few lines of code. oh the pain to get this working :-)
-void Computrainer::unpackTelemetry(int &ss1, int &ss2, int &ss3, int &buttons, int &type, int &value8, int &value12) {
+// returns true when strokeSpinScan has been filled with the spinscan of the pedal stroke just completed
+bool Computrainer::unpackTelemetry(int &ss1, int &ss2, int &ss3, int &buttons, int &type, int &value8, int &value12,
+                                   uint8_t *strokeSpinScan) {
     static uint8_t ss[24];
     static int pos = 0;
 
@@ -348,14 +349,16 @@ void Computrainer::unpackTelemetry(int &ss1, int &ss2, int &ss3, int &buttons, i
     // 12 bit value
     value12 = value8 | (b1 & 7) << 9 | (b3 & 2) << 7;
 
+    bool stroke = false;
     if (buttons & 64) {
-        memcpy((uint8_t *)spinScan, (uint8_t *)ss + 3, 21);
-        memcpy((uint8_t *)spinScan + 21, (uint8_t *)ss, 3);
+        memcpy(strokeSpinScan, (uint8_t *)ss + 3, 21);
+        memcpy(strokeSpinScan + 21, (uint8_t *)ss, 3);
         // for (pos=0; pos<24; pos++) fprintf(stderr, "%d, ", ss[pos]);
         // fprintf(stderr, "\n");
+        stroke = pos > 0;
         pos = 0;
     }
-    if (ss1 || ss2 || ss3) {
+    if ((ss1 || ss2 || ss3) && pos <= 21) { // a missed start of stroke marker must not overflow ss
 
         // we drop the msb and do a ones compliment, but
         // that looks eerily like a signed byte.
@@ -366,6 +369,13 @@ void Computrainer::unpackTelemetry(int &ss1, int &ss2, int &ss3, int &buttons, i
         ss[pos++] = 127 ^ (ss2 & 127);
         ss[pos++] = 127 ^ (ss3 & 127);
     }
+    return stroke;
+}
+
+void Computrainer::publishTelemetry(const ComputrainerTelemetry &telemetry) {
+    telemetryChannel.publish(telemetry);
+    if (!telemetryPending.exchange(true, std::memory_order_relaxed))
+        emit telemetryReady();
 }
 
 /* ----------------------------------------------------------------------
@@ -464,18 +474,13 @@ void Computrainer::run() {
 
     // Cached current values
     // when new values are received from the device
-    // if they differ from current values we update
+    // if they differ from current values we publish them
     // otherwise do nothing
     int curmode, curstatus;
     double curload, curgradient;
-    double curPower;      // current output power in Watts
-    double curHeartRate;  // current heartrate in BPM
-    double curCadence;    // current cadence in RPM
-    double curSpeed;      // current speed in KPH
-    double curRRC;        // calibrated Rolling Resistance
-    bool curhrconnected;  // is HR sensor connected?
-    bool curcadconnected; // is CAD sensor connected?
-    int curButtons;       // Button status
+    ComputrainerTelemetry current; // telemetry as last published
+    int curButtons = 0;            // Button status
+    bool changed;
 
     // initialise local cache & main vars
     pvars.lock();
@@ -483,18 +488,9 @@ void Computrainer::run() {
     curmode = this->mode;
     curload = this->load;
     curgradient = this->gradient;
-    curPower = this->devicePower = 0;
-    curHeartRate = this->deviceHeartRate = 0;
-    curCadence = this->deviceCadence = 0;
-    curSpeed = this->deviceSpeed = 0;
-    curButtons = this->deviceButtons = 0;
-    curRRC = this->deviceRRC = 0;
-    this->deviceCalibrated = false;
-    curhrconnected = false;
-    this->deviceHRConnected = false;
-    curcadconnected = false;
-    this->deviceCADConnected = false;
     pvars.unlock();
+    this->deviceButtons = 0;
+    publishTelemetry(current);
 
     // open the device
     int o = openPort();
@@ -525,33 +521,30 @@ void Computrainer::run() {
                 // UPDATE BASIC TELEMETRY (HR, CAD, SPD et al)
                 //----------------------------------------------------------------
 
-                unpackTelemetry(ss1, ss2, ss3, buttons, type, value8, value12);
+                changed = unpackTelemetry(ss1, ss2, ss3, buttons, type, value8, value12, current.spinScan);
+                if (changed) {
+                    current.spinScanStrokes++;
+                }
 
                 switch (type) {
                 case CT_HEARTRATE:
-                    if (value8 != curHeartRate) {
-                        curHeartRate = value8;
-                        pvars.lock();
-                        this->deviceHeartRate = curHeartRate;
-                        pvars.unlock();
+                    if (value8 != current.heartRate) {
+                        current.heartRate = value8;
+                        changed = true;
                     }
                     break;
 
                 case CT_POWER:
-                    if (value12 != curPower) {
-                        curPower = value12;
-                        pvars.lock();
-                        this->devicePower = curPower;
-                        pvars.unlock();
+                    if (value12 != current.power) {
+                        current.power = value12;
+                        changed = true;
                     }
                     break;
 
                 case CT_CADENCE:
-                    if (value8 != curCadence) {
-                        curCadence = value8;
-                        pvars.lock();
-                        this->deviceCadence = curCadence;
-                        pvars.unlock();
+                    if (value8 != current.cadence) {
+                        current.cadence = value8;
+                        changed = true;
                     }
                     break;
 
@@ -561,10 +554,9 @@ void Computrainer::run() {
                     value12 /= 10; // it seems that compcs takes off 10% ????
                     newspeed = value12;
                     newspeed /= 1000;
-                    if (newspeed != curSpeed) {
-                        pvars.lock();
-                        this->deviceSpeed = curSpeed = newspeed;
-                        pvars.unlock();
+                    if (newspeed != current.speed) {
+                        current.speed = newspeed;
+                        changed = true;
                     }
                     break;
 
@@ -573,10 +565,9 @@ void Computrainer::run() {
                     newRRC = value12 & ~2048; // only use 11bits
                     newRRC /= 256;
 
-                    if (newRRC != curRRC) {
-                        pvars.lock();
-                        this->deviceRRC = curRRC = newRRC;
-                        pvars.unlock();
+                    if (newRRC != current.RRC) {
+                        current.RRC = newRRC;
+                        changed = true;
                     }
                     break;
 
@@ -584,11 +575,10 @@ void Computrainer::run() {
                     newcadconnected = value12 & 2048 ? true : false;
                     newhrconnected = value12 & 1024 ? true : false;
 
-                    if (newhrconnected != curhrconnected || newcadconnected != curcadconnected) {
-                        pvars.lock();
-                        this->deviceHRConnected = curhrconnected = newhrconnected;
-                        this->deviceCADConnected = curcadconnected = newcadconnected;
-                        pvars.unlock();
+                    if (newhrconnected != current.hrConnected || newcadconnected != current.cadConnected) {
+                        current.hrConnected = newhrconnected;
+                        current.cadConnected = newcadconnected;
+                        changed = true;
                     }
                     break;
 
@@ -601,16 +591,16 @@ void Computrainer::run() {
                 //----------------------------------------------------------------
                 if (buttons != curButtons) {
                     // let the gui workout what the deal is with silly button values!
-                    pvars.lock();
-                    this->deviceButtons |= buttons; // Borrowed from Fortius.cpp: workaround to ensure controller
-                                                    // doesn't miss button pushes
-                    pvars.unlock();
+                    // Borrowed from Fortius.cpp: workaround to ensure controller doesn't miss button pushes
+                    this->deviceButtons.fetch_or(buttons, std::memory_order_relaxed);
                 }
 
                 //----------------------------------------------------------------
-                // UPDATE SSCAN
+                // PUBLISH TELEMETRY AND SSCAN
                 //----------------------------------------------------------------
-                /* not yet implemented */
+                if (changed) {
+                    publishTelemetry(current);
+                }
 
             } else {
                 // no data
@@ -995,27 +985,29 @@ int Computrainer::rawRead(uint8_t bytes[], int size) {
 
 #else
 
-    int timeout = 0, i = 0;
+    int i = 0;
     uint8_t byte;
 
-    // read one byte at a time sleeping when no data ready
+    // read one byte at a time waiting on the descriptor when no data is ready
     // until we timeout waiting then return error
     for (i = 0; i < size; i++) {
-        timeout = 0;
-        rc = 0;
-        while (rc == 0 && timeout < CT_READTIMEOUT) {
-            rc = read(devicePort, &byte, 1);
-            if (rc == -1)
+        rc = read(devicePort, &byte, 1);
+        while (rc != 1) {
+            if (rc == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
                 return -1; // error!
-            else if (rc == 0) {
-                msleep(50); // sleep for 1/20th of a second
-                timeout += 50;
-            } else {
-                bytes[i] = byte;
-            }
+
+            struct pollfd pfd;
+            pfd.fd = devicePort;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            int ready = poll(&pfd, 1, CT_READTIMEOUT);
+            if (ready == 0)
+                return -1; // we timed out!
+            if (ready == -1 && errno != EINTR)
+                return -1; // error!
+            rc = read(devicePort, &byte, 1);
         }
-        if (timeout >= CT_READTIMEOUT)
-            return -1; // we timed out!
+        bytes[i] = byte;
     }
 
     qDebug() << i << QString::fromLocal8Bit((const char *)bytes, i);
@@ -35,12 +35,14 @@
 #include <QMutex>
 #include <QString>
 #include <QThread>
+#include <atomic>
 
 #ifdef WIN32
 #include <windows.h>
 
 #include <winbase.h>
 #else
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <termios.h> // unix!!
 #include <unistd.h>  // unix!!
@@ -104,7 +106,28 @@
 #define DEFAULT_LOAD 100.00
 #define DEFAULT_GRADIENT 2.00
 
+#include "snapshotchannel.h"
+
+/* inbound telemetry, published by the run() thread after every decoded message */
+struct ComputrainerTelemetry {
+    double power = 0;             // current output power in Watts
+    double heartRate = 0;         // current heartrate in BPM
+    double cadence = 0;           // current cadence in RPM
+    double speed = 0;             // current speed in KPH
+    double RRC = 0;               // calibrated Rolling Resistance
+    bool calibrated = false;      // is it calibrated?
+    bool hrConnected = false;     // HR jack is connected
+    bool cadConnected = false;    // Cadence jack is connected
+    uint8_t spinScan[24] = {0};   // SS values only in SS_MODE, 12 for the left leg then 12 for the right one
+    uint32_t spinScanStrokes = 0; // incremented every time spinScan holds a new pedal stroke
+
+    // pedal smoothness (average over peak force) and right leg share of the force of the stroke in spinScan,
+    // both in percent. false if the stroke has no force at all
+    bool pedalStroke(double &smoothness, double &rightBalance) const;
+};
+
 class Computrainer : public QThread {
+    Q_OBJECT
 
   public:
     Computrainer(QObject *parent = 0, QString deviceFilename = 0); // pass device
@@ -129,8 +152,10 @@ class Computrainer : public QThread {
                  double gradient = DEFAULT_GRADIENT);
 
     // GET TELEMETRY AND STATUS
-    // direct access to class variables is not allowed because we need to use wait conditions
-    // to sync data read/writes between the run() thread and the main gui thread
+    // the run() thread publishes the telemetry through a lock free snapshot channel with a single
+    // consumer: these getters must all be called from the same (gui) thread
+    const ComputrainerTelemetry &telemetry(); // latest telemetry, after telemetryReady() has been emitted
+    int takeButtons();                        // buttons pressed since the last call
     bool isCalibrated();
     bool isHRConnected();
     bool isCADConnected();
@@ -141,6 +166,11 @@ class Computrainer : public QThread {
     double getGradient();
     double getLoad();
 
+  signals:
+    // emitted by the run() thread when new telemetry is available: at most one emission is pending
+    // until the consumer calls telemetry()
+    void telemetryReady();
+
   private:
     void run() override; // called by start to kick off the CT comtrol thread
 
@@ -159,23 +189,18 @@ class Computrainer : public QThread {
 
     // Protocol decoding
     int readMessage();
-    void unpackTelemetry(int &b1, int &b2, int &b3, int &buttons, int &type, int &value8, int &value12);
+    bool unpackTelemetry(int &b1, int &b2, int &b3, int &buttons, int &type, int &value8, int &value12,
+                         uint8_t *strokeSpinScan);
+    void publishTelemetry(const ComputrainerTelemetry &telemetry);
 
     // Mutex for controlling accessing private data
     QMutex pvars;
 
-    // INBOUND TELEMETRY - all volatile since it is updated by the run() thread
-    volatile double devicePower;      // current output power in Watts
-    volatile double deviceHeartRate;  // current heartrate in BPM
-    volatile double deviceCadence;    // current cadence in RPM
-    volatile double deviceSpeed;      // current speed in KPH
-    volatile double deviceRRC;        // calibrated Rolling Resistance
-    volatile bool deviceCalibrated;   // is it calibrated?
-    volatile uint8_t spinScan[24];    // SS values only in SS_MODE
-    volatile int deviceButtons;       // Button status
-    volatile bool deviceHRConnected;  // HR jack is connected
-    volatile bool deviceCADConnected; // Cadence jack is connected
-    volatile int deviceStatus;        // Device status running, paused, disconnected
+    // INBOUND TELEMETRY
+    SnapshotChannel<ComputrainerTelemetry> telemetryChannel;
+    std::atomic<bool> telemetryPending{false};
+    std::atomic<int> deviceButtons{0}; // Button status, accumulated until read
+    volatile int deviceStatus;         // Device status running, paused, disconnected
 
     // OUTBOUND COMMANDS - all volatile since it is updated by the GUI thread
     volatile int mode;
@@ -19,19 +19,22 @@ computrainerbike::computrainerbike(bool noWriteResistance, bool noHeartService,
     m_watt.setType(metric::METRIC_WATT);
     target_watts.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &computrainerbike::update);
+    connect(refresh, &PollTimer::timeout, this, &computrainerbike::update);
+    // telemetry is pushed by onTelemetry(), the timer integrates distance and calories and sends the commands
     refresh->start(50ms);
 
     QString computrainerSerialPort =
         settings.value(QZSettings::computrainer_serialport, QZSettings::default_computrainer_serialport).toString();
 
     myComputrainer = new Computrainer(this, computrainerSerialPort);
+    connect(myComputrainer, &Computrainer::telemetryReady, this, &computrainerbike::onTelemetry,
+            Qt::QueuedConnection);
     myComputrainer->start();
 
     ergModeSupported = true; // IMPORTANT, only for this bike
@@ -230,30 +233,19 @@ void computrainerbike::update() {
         bool disable_hr_frommachinery =
             settings.value(QZSettings::heart_ignore_builtin, QZSettings::default_heart_ignore_builtin).toBool();
 
-        int Buttons, Status;
-        bool calibration;
-        double Power, HeartRate, cadence, speed, RRC, Load, Gradient;
-        uint8_t ss[24];
-        // get latest telemetry
-        myComputrainer->getTelemetry(Power, HeartRate, cadence, speed, RRC, calibration, Buttons, ss, Status);
+        heartFromMachinery = !disable_hr_frommachinery;
 
-        Speed = speed;
-        emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+        // speed, cadence, power and heart come from onTelemetry()
         Distance += ((Speed.value() / 3600000.0) *
                      ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
         emit debug("Current Distance: " + QString::number(Distance.value()));
-        Cadence = cadence;
-        emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
         if (Cadence.value() > 0) {
             CrankRevs++;
             LastCrankEventTime += (uint16_t)(1024.0 / (((double)(Cadence.value())) / 60.0));
         }
 
-        m_watt = Power;
-        emit debug(QStringLiteral("Current Watt: ") + QString::number(watts()));
-
-        Inclination = Gradient;
-        emit debug(QStringLiteral("Current Inclination: ") + QString::number(Gradient));
+        Inclination = myComputrainer->getGradient();
+        emit debug(QStringLiteral("Current Inclination: ") + QString::number(Inclination.value()));
 
         if (watts())
             KCal += ((((0.048 * ((double)watts()) + 1.19) *
@@ -268,11 +260,6 @@ void computrainerbike::update() {
                                                                   m_pelotonResistance = (100 / 32) * Resistance.value();
                                                                   emit resistanceRead(Resistance.value());    */
 
-        if (!disable_hr_frommachinery) {
-            Heart = HeartRate;
-            emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
-        }
-
         lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
 
 #ifdef Q_OS_ANDROID
@@ -331,6 +318,34 @@ void computrainerbike::update() {
     }
 }
 
+void computrainerbike::onTelemetry() {
+    const ComputrainerTelemetry &t = myComputrainer->telemetry();
+
+    Speed = t.speed;
+    emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+    Cadence = t.cadence;
+    emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
+    m_watt = t.power;
+    emit debug(QStringLiteral("Current Watt: ") + QString::number(watts()));
+
+    if (heartFromMachinery) {
+        Heart = t.heartRate;
+        emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
+    }
+
+    // SpinScan: 24 force samples of the last pedal stroke, 12 for the left leg then 12 for the right one
+    if (t.spinScanStrokes != lastSpinScanStrokes) {
+        lastSpinScanStrokes = t.spinScanStrokes;
+        double smoothness, rightBalance;
+        if (t.pedalStroke(smoothness, rightBalance)) {
+            m_pedalSmoothness = smoothness;
+            m_rightBalance = rightBalance;
+            emit debug(QStringLiteral("Current Pedal Smoothness: ") + QString::number(m_pedalSmoothness.value()) +
+                       QStringLiteral(" Right Balance: ") + QString::number(m_rightBalance.value()));
+        }
+    }
+}
+
 bool computrainerbike::inclinationAvailableByHardware() {
     QSettings settings;
     bool proform_studio = settings.value(QZSettings::proform_studio, QZSettings::default_proform_studio).toBool();
@@ -53,7 +53,7 @@ class computrainerbike : public bike {
     void forceResistance(double requestResistance);
     void innerWriteResistance();
 
-    QTimer *refresh;
+    PollTimer *refresh;
     virtualbike *virtualBike = nullptr;
     uint8_t counterPoll = 0;
     int8_t bikeResistanceOffset = 4;
@@ -70,6 +70,8 @@ class computrainerbike : public bike {
 
     bool noWriteResistance = false;
     bool noHeartService = false;
+    bool heartFromMachinery = true;
+    uint32_t lastSpinScanStrokes = 0;
 
     Computrainer *myComputrainer = nullptr;
 
@@ -87,6 +89,7 @@ class computrainerbike : public bike {
   private slots:
 
     void update();
+    void onTelemetry();
 };
 
 #endif // COMPUTRAINERBIKE_H
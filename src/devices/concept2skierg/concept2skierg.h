@@ -46,7 +46,7 @@ class concept2skierg : public rower {
     uint16_t watts() override;
     void forceResistance(resistance_t requestResistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
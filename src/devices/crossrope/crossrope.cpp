@@ -28,9 +28,9 @@ crossrope::crossrope(uint32_t pollDeviceTime, bool noConsole, bool noHeartServic
     this->noConsole = noConsole;
     this->noHeartService = noHeartService;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &crossrope::update);
+    connect(refresh, &PollTimer::timeout, this, &crossrope::update);
     refresh->start(500ms);
 }
 
@@ -117,6 +117,7 @@ void crossrope::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void crossrope::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
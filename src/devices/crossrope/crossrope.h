@@ -51,7 +51,7 @@ class crossrope : public jumprope {
     QDateTime lastTimeCharacteristicChanged;
     bool firstCharacteristicChanged = true;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
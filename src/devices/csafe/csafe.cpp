@@ -1,6 +1,117 @@
 #include "csafe.h" // Include the header file containing csafe_dic definitions
 #include <QList>
 #include <QMap>
+#include <algorithm>
+
+namespace {
+
+// Layout of the data of a command response: the byte width of every field, negative widths are ascii
+struct ResponseSpec {
+    quint16 id; // wrapper command id in the high byte for the PM3 specific commands
+    const char *name;
+    int count;
+    qint8 fields[CsafeResponse::maxFields];
+};
+
+// sorted by id for the binary search in responseSpec()
+constexpr ResponseSpec responseTable[] = {
+    {0x01, "CSAFE_AUTOUPLOAD_CMD", 0, {}},
+    {0x10, "CSAFE_IDDIGITS_CMD", 0, {}},
+    {0x11, "CSAFE_SETTIME_CMD", 0, {}},
+    {0x12, "CSAFE_SETDATE_CMD", 0, {}},
+    {0x13, "CSAFE_SETTIMEOUT_CMD", 0, {}},
+    {0x1A, "CSAFE_SETUSERCFG1_CMD", 0, {}},
+    {0x20, "CSAFE_SETTWORK_CMD", 0, {}},
+    {0x21, "CSAFE_SETHORIZONTAL_CMD", 0, {}},
+    {0x23, "CSAFE_SETCALORIES_CMD", 0, {}},
+    {0x24, "CSAFE_SETPROGRAM_CMD", 0, {}},
+    {0x2B, "CSAFE_SETUSERINFO_CMD", 0, {}},
+    {0x2D, "CSAFE_SETLEVEL_CMD", 0, {}},
+    {0x34, "CSAFE_SETPOWER_CMD", 0, {}},
+    {0x70, "CSAFE_GETCAPS_CMD", 1, {11}},
+    {0x80, "CSAFE_GETSTATUS_CMD", 0, {}},
+    {0x81, "CSAFE_RESET_CMD", 0, {}},
+    {0x82, "CSAFE_GOIDLE_CMD", 0, {}},
+    {0x83, "CSAFE_GOHAVEID_CMD", 0, {}},
+    {0x85, "CSAFE_GOINUSE_CMD", 0, {}},
+    {0x86, "CSAFE_GOFINISHED_CMD", 0, {}},
+    {0x87, "CSAFE_GOREADY_CMD", 0, {}},
+    {0x88, "CSAFE_BADID_CMD", 0, {}},
+    {0x91, "CSAFE_GETVERSION_CMD", 5, {1, 1, 1, 2, 2}},
+    {0x92, "CSAFE_GETID_CMD", 1, {-5}},
+    {0x93, "CSAFE_GETUNITS_CMD", 1, {1}},
+    {0x94, "CSAFE_GETSERIAL_CMD", 1, {-9}},
+    {0x9B, "CSAFE_GETODOMETER_CMD", 2, {4, 1}},
+    {0x9C, "CSAFE_GETERRORCODE_CMD", 1, {3}},
+    {0xA0, "CSAFE_GETTWORK_CMD", 3, {1, 1, 1}},
+    {0xA1, "CSAFE_GETHORIZONTAL_CMD", 2, {2, 1}},
+    {0xA3, "CSAFE_GETCALORIES_CMD", 1, {2}},
+    {0xA4, "CSAFE_GETPROGRAM_CMD", 2, {1, 1}},
+    {0xA5, "CSAFE_GETSPEED_CMD", 2, {2, 1}},
+    {0xA6, "CSAFE_GETPACE_CMD", 2, {2, 1}},
+    {0xA7, "CSAFE_GETCADENCE_CMD", 2, {2, 1}},
+    {0xAB, "CSAFE_GETUSERINFO_CMD", 4, {2, 1, 1, 1}},
+    {0xB0, "CSAFE_GETHRCUR_CMD", 1, {1}},
+    {0xB4, "CSAFE_GETPOWER_CMD", 2, {2, 1}},
+    {0xD0, "CSAFE_LF_GET_DETAIL", 1, {28}},
+    {0x1A05, "CSAFE_PM_SET_SPLITDURATION", 0, {}},
+    {0x1A27, "CSAFE_PM_SET_SCREENERRORMODE", 0, {}},
+    {0x1A6B, "CSAFE_PM_GET_FORCEPLOTDATA", 17, {1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}},
+    {0x1A6C, "CSAFE_PM_GET_HEARTBEATDATA", 17, {1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}},
+    {0x1A89, "CSAFE_PM_GET_WORKOUTTYPE", 1, {1}},
+    {0x1A8D, "CSAFE_PM_GET_WORKOUTSTATE", 1, {1}},
+    {0x1A8E, "CSAFE_PM_GET_INTERVALTYPE", 1, {1}},
+    {0x1A9F, "CSAFE_PM_GET_WORKOUTINTERVALCOUNT", 1, {1}},
+    {0x1AA0, "CSAFE_PM_GET_WORKTIME", 2, {4, 1}},
+    {0x1AA3, "CSAFE_PM_GET_WORKDISTANCE", 2, {4, 1}},
+    {0x1ABF, "CSAFE_PM_GET_STROKESTATE", 1, {1}},
+    {0x1AC1, "CSAFE_PM_GET_DRAGFACTOR", 1, {1}},
+    {0x1AC9, "CSAFE_PM_GET_ERRORVALUE", 1, {2}},
+    {0x1ACF, "CSAFE_PM_GET_RESTTIME", 1, {2}},
+};
+
+constexpr int responseTableSize = sizeof(responseTable) / sizeof(responseTable[0]);
+
+constexpr bool responseTableSorted(int i = 1) {
+    return i >= responseTableSize || (responseTable[i - 1].id < responseTable[i].id && responseTableSorted(i + 1));
+}
+
+static_assert(responseTableSorted(), "the CSAFE response table must be sorted by id");
+
+const ResponseSpec *responseSpec(int id) {
+    const ResponseSpec *end = responseTable + responseTableSize;
+    const ResponseSpec *spec =
+        std::lower_bound(responseTable, end, id, [](const ResponseSpec &s, int id) { return s.id < id; });
+    return spec != end && spec->id == id ? spec : nullptr;
+}
+
+int responseLength(int id) {
+    const ResponseSpec *spec = responseSpec(id);
+    int sum = 0;
+    for (int i = 0; spec && i < spec->count; i++)
+        sum += qAbs(spec->fields[i]);
+    return sum;
+}
+
+} // namespace
+
+QVariantMap CsafeFrame::toVariantMap() const {
+    QVariantMap map;
+    if (!valid)
+        return map;
+    map[QStringLiteral("CSAFE_GETSTATUS_CMD")] = QVariantList() << status;
+    for (const CsafeResponse &r : responses) {
+        if (!r.name || r.id == csafe::CSAFE_GETSTATUS_CMD)
+            continue;
+        QVariantList values;
+        if (!r.text.isNull())
+            values << r.text;
+        for (int i = 0; i < r.count; i++)
+            values << r.values[i];
+        map[QString::fromLatin1(r.name)] = values;
+    }
+    return map;
+}
 
 csafe::csafe() {
 
@@ -84,73 +195,6 @@ csafe::csafe() {
     cmds["CSAFE_GETUSERINFO_CMD"] = populateCmd(0xAB, QList<int>());
     cmds["CSAFE_GETHRCUR_CMD"] = populateCmd(0xb0, QList<int>());
     cmds["CSAFE_GETPOWER_CMD"] = populateCmd(0xb4, QList<int>());
-
-    // Response Data to Short Commands
-    resp[0x80] = qMakePair(QString("CSAFE_GETSTATUS_CMD"), QList<int>() << 0);
-    resp[0x81] = qMakePair(QString("CSAFE_RESET_CMD"), QList<int>() << 0);
-    resp[0x82] = qMakePair(QString("CSAFE_GOIDLE_CMD"), QList<int>() << 0);
-    resp[0x83] = qMakePair(QString("CSAFE_GOHAVEID_CMD"), QList<int>() << 0);
-    resp[0x85] = qMakePair(QString("CSAFE_GOINUSE_CMD"), QList<int>() << 0);
-    resp[0x86] = qMakePair(QString("CSAFE_GOFINISHED_CMD"), QList<int>() << 0);
-    resp[0x87] = qMakePair(QString("CSAFE_GOREADY_CMD"), QList<int>() << 0);
-    resp[0x88] = qMakePair(QString("CSAFE_BADID_CMD"), QList<int>() << 0);
-    resp[0x91] = qMakePair(QString("CSAFE_GETVERSION_CMD"), QList<int>() << 1 << 1 << 1 << 2 << 2);
-    resp[0x92] = qMakePair(QString("CSAFE_GETID_CMD"), QList<int>() << -5);
-    resp[0x93] = qMakePair(QString("CSAFE_GETUNITS_CMD"), QList<int>() << 1);
-    resp[0x94] = qMakePair(QString("CSAFE_GETSERIAL_CMD"), QList<int>() << -9);
-    resp[0x9B] = qMakePair(QString("CSAFE_GETODOMETER_CMD"), QList<int>() << 4 << 1);
-    resp[0x9C] = qMakePair(QString("CSAFE_GETERRORCODE_CMD"), QList<int>() << 3);
-    resp[0xA0] = qMakePair(QString("CSAFE_GETTWORK_CMD"), QList<int>() << 1 << 1 << 1);
-    resp[0xA1] = qMakePair(QString("CSAFE_GETHORIZONTAL_CMD"), QList<int>() << 2 << 1);
-    resp[0xA3] = qMakePair(QString("CSAFE_GETCALORIES_CMD"), QList<int>() << 2);
-    resp[0xA4] = qMakePair(QString("CSAFE_GETPROGRAM_CMD"), QList<int>() << 1 << 1);
-    resp[0xA5] = qMakePair(QString("CSAFE_GETSPEED_CMD"), QList<int>() << 2 << 1);
-    resp[0xA6] = qMakePair(QString("CSAFE_GETPACE_CMD"), QList<int>() << 2 << 1);
-    resp[0xA7] = qMakePair(QString("CSAFE_GETCADENCE_CMD"), QList<int>() << 2 << 1);
-    resp[0xAB] = qMakePair(QString("CSAFE_GETUSERINFO_CMD"), QList<int>() << 2 << 1 << 1 << 1);
-    resp[0xB0] = qMakePair(QString("CSAFE_GETHRCUR_CMD"), QList<int>() << 1);
-    resp[0xB4] = qMakePair(QString("CSAFE_GETPOWER_CMD"), QList<int>() << 2 << 1);
-
-    // Response Data to Long Commands
-    resp[0x01] = qMakePair(QString("CSAFE_AUTOUPLOAD_CMD"), QList<int>() << 0);
-    resp[0x10] = qMakePair(QString("CSAFE_IDDIGITS_CMD"), QList<int>() << 0);
-    resp[0x11] = qMakePair(QString("CSAFE_SETTIME_CMD"), QList<int>() << 0);
-    resp[0x12] = qMakePair(QString("CSAFE_SETDATE_CMD"), QList<int>() << 0);
-    resp[0x13] = qMakePair(QString("CSAFE_SETTIMEOUT_CMD"), QList<int>() << 0);
-    resp[0x1A] = qMakePair(QString("CSAFE_SETUSERCFG1_CMD"), QList<int>() << 0);
-    resp[0x20] = qMakePair(QString("CSAFE_SETTWORK_CMD"), QList<int>() << 0);
-    resp[0x21] = qMakePair(QString("CSAFE_SETHORIZONTAL_CMD"), QList<int>() << 0);
-    resp[0x23] = qMakePair(QString("CSAFE_SETCALORIES_CMD"), QList<int>() << 0);
-    resp[0x24] = qMakePair(QString("CSAFE_SETPROGRAM_CMD"), QList<int>() << 0);
-    resp[0x2B] = qMakePair(QString("CSAFE_SETUSERINFO_CMD"), QList<int>() << 0);
-    resp[0x2D] = qMakePair(QString("CSAFE_SETLEVEL_CMD"), QList<int>() << 0);
-    resp[0x34] = qMakePair(QString("CSAFE_SETPOWER_CMD"), QList<int>() << 0);
-    resp[0x70] = qMakePair(QString("CSAFE_GETCAPS_CMD"), QList<int>() << 11);
-
-    // Response Data to PM3 Specific Short Commands
-    resp[0x1A89] = qMakePair(QString("CSAFE_PM_GET_WORKOUTTYPE"), QList<int>() << 1);
-    resp[0x1AC1] = qMakePair(QString("CSAFE_PM_GET_DRAGFACTOR"), QList<int>() << 1);
-    resp[0x1ABF] = qMakePair(QString("CSAFE_PM_GET_STROKESTATE"), QList<int>() << 1);
-    resp[0x1AA0] = qMakePair(QString("CSAFE_PM_GET_WORKTIME"), QList<int>() << 4 << 1);
-    resp[0x1AA3] = qMakePair(QString("CSAFE_PM_GET_WORKDISTANCE"), QList<int>() << 4 << 1);
-    resp[0x1AC9] = qMakePair(QString("CSAFE_PM_GET_ERRORVALUE"), QList<int>() << 2);
-    resp[0x1A8D] = qMakePair(QString("CSAFE_PM_GET_WORKOUTSTATE"), QList<int>() << 1);
-    resp[0x1A9F] = qMakePair(QString("CSAFE_PM_GET_WORKOUTINTERVALCOUNT"), QList<int>() << 1);
-    resp[0x1A8E] = qMakePair(QString("CSAFE_PM_GET_INTERVALTYPE"), QList<int>() << 1);
-    resp[0x1ACF] = qMakePair(QString("CSAFE_PM_GET_RESTTIME"), QList<int>() << 2);
-
-    // Response Data to PM3 Specific Long Commands
-    resp[0x1A05] = qMakePair(QString("CSAFE_PM_SET_SPLITDURATION"), QList<int>() << 0);
-    resp[0x1A6B] =
-        qMakePair(QString("CSAFE_PM_GET_FORCEPLOTDATA"),
-                  QList<int>() << 1 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2);
-    resp[0x1A27] = qMakePair(QString("CSAFE_PM_SET_SCREENERRORMODE"), QList<int>() << 0);
-    resp[0x1A6C] =
-        qMakePair(QString("CSAFE_PM_GET_HEARTBEATDATA"),
-                  QList<int>() << 1 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2);
-
-    // LIFE FITNESS specific response
-    resp[0xD0] = qMakePair(QString("CSAFE_LF_GET_DETAIL"), QList<int>() << 0x1c);
 }
 
 QList<QList<int>> csafe::populateCmd(int First, QList<int> Second, int Third) {
@@ -202,7 +246,7 @@ QVector<quint8> csafe::int2bytes(int numbytes, int integer) {
 }
 
 int csafe::bytes2int(const QVector<quint8> &raw_bytes) {
-    int num_bytes = raw_bytes.size();
+    int num_bytes = qMin(raw_bytes.size(), (int)sizeof(int)); // wider fields do not fit, keep the low bytes
     int integer = 0;
 
     for (int k = 0; k < num_bytes; ++k) {
@@ -276,11 +320,7 @@ QByteArray csafe::write(const QStringList &arguments, bool surround_msg) {
         }
 
         int cmdid = cmdprop[0].at(0) | (wrapper << 8); // max message length
-        int sum = 0;
-        for (int aa = 0; aa < resp[cmdid].second.size(); aa++) {
-            sum += resp[cmdid].second.at(aa);
-        }
-        maxresponse += qAbs(sum) * 2 + 1; // double return to account for stuffing
+        maxresponse += responseLength(cmdid) * 2 + 1;  // double return to account for stuffing
 
         message.append(command); // add completed command to final message
 
@@ -375,11 +415,20 @@ QVector<quint8> csafe::check_message(QVector<quint8> message) {
 }
 
 QVariantMap csafe::read(const QVector<quint8> &transmission) {
+    QByteArray raw;
+    raw.reserve(transmission.size());
+    for (quint8 b : transmission)
+        raw.append((char)b);
+    return readFrame(raw).toVariantMap();
+}
+
+CsafeFrame csafe::readFrame(const QByteArray &transmission) {
+    CsafeFrame frame;
     QVector<quint8> message;
     bool stopfound = false;
     int j = 0;
     while (j < transmission.size()) {
-        int startflag = transmission[j];
+        int startflag = (quint8)transmission[j];
         if (startflag == Extended_Frame_Start_Flag) {
             j = j + 3;
             break;
@@ -393,90 +442,79 @@ QVariantMap csafe::read(const QVector<quint8> &transmission) {
 
     if (j >= transmission.size()) {
         qWarning("No Start Flag found.");
-        return QVariantMap();
+        return frame;
     }
 
+    message.reserve(transmission.size() - j);
     while (j < transmission.size()) {
-        if (transmission[j] == Stop_Frame_Flag) {
+        if ((quint8)transmission[j] == Stop_Frame_Flag) {
             stopfound = true;
             break;
         }
-        message.append(transmission[j]);
+        message.append((quint8)transmission[j]);
         ++j;
     }
 
     if (!stopfound) {
         qWarning("No Stop Flag found.");
-        return QVariantMap();
+        return frame;
     }
     message = check_message(message);
-    int status = message.takeFirst();
-
-    QVariantMap response;
-    response["CSAFE_GETSTATUS_CMD"] = QVariantList() << status;
+    if (message.isEmpty()) {
+        return frame;
+    }
+    frame.valid = true;
+    frame.status = message[0];
 
-    int k = 0;
+    int k = 1;
     int wrapend = -1;
     int wrapper = 0x0;
 
-    while (k < message.size()) // loop through complete frames
+    while (k + 1 < message.size()) // loop through complete frames
     {
-        QVariantList result;
-
         int msgcmd = message[k];
         if (k <= wrapend) {
             msgcmd = wrapper | msgcmd;
         }
-        auto &msgprop = resp[msgcmd];
         ++k;
 
         int bytecount = message[k];
         ++k;
 
-        if (msgprop.first == "CSAFE_SETUSERCFG1_CMD") // if wrapper command
+        if (msgcmd == 0x1A) // CSAFE_SETUSERCFG1_CMD wraps the PM3 specific commands that follow
         {
-            wrapper = message[k - 2] << 8;
+            wrapper = msgcmd << 8;
             wrapend = k + bytecount - 1;
-            if (bytecount != 0) {
-                msgcmd = wrapper | message[k];
-                const auto &wrapper_msgprop = resp[msgcmd];
-                msgprop.second = wrapper_msgprop.second;
-                ++k;
-                bytecount = message[k];
-                ++k;
-            }
-        }
-
-        if (msgprop.first == "CSAFE_GETCAPS_CMD") // special case for capability code
-        {
-            // msgprop.second = QList<int>(bytecount, 1);
-        }
-
-        if (msgprop.first == "CSAFE_GETID_CMD") // special case for get id
-        {
-            // msgprop.second = QList<int>(1, -bytecount);
+            continue;
         }
 
-        if (abs(std::accumulate(msgprop.second.begin(), msgprop.second.end(), 0)) != 0 &&
-            bytecount != abs(std::accumulate(msgprop.second.begin(), msgprop.second.end(), 0))) {
-            qWarning("Warning: bytecount is an unexpected length");
-        }
+        const ResponseSpec *spec = responseSpec(msgcmd);
+        CsafeResponse response;
+        response.id = msgcmd;
+        if (spec) {
+            response.name = spec->name;
+            if (responseLength(msgcmd) != 0 && bytecount != responseLength(msgcmd)) {
+                qWarning("Warning: bytecount is an unexpected length");
+            }
 
-        for (int numbytes : msgprop.second) // extract values
-        {
-            QVector<quint8> raw_bytes = message.mid(k, abs(numbytes));
-            QVariant value;
-            if (numbytes >= 0) {
-                value = bytes2int(raw_bytes);
-            } else {
-                value = bytes2ascii(raw_bytes);
+            int field = k;
+            for (int i = 0; i < spec->count && field < message.size(); i++) // extract values
+            {
+                int numbytes = qAbs(spec->fields[i]);
+                QVector<quint8> raw_bytes = message.mid(field, numbytes);
+                if (spec->fields[i] >= 0) {
+                    response.values[response.count++] = bytes2int(raw_bytes);
+                } else {
+                    response.text = bytes2ascii(raw_bytes);
+                }
+                field += numbytes;
             }
-            result.append(value);
-            k += abs(numbytes);
+        } else {
+            qWarning("CSAFE response not implemented: 0x%x", msgcmd);
         }
-
-        response[msgprop.first] = result;
+        frame.responses.append(response);
+        k += bytecount;
     }
 
-    return response;
+    return frame;
 }
@@ -12,6 +12,42 @@
 
 #include <QBuffer>
 #include <QMap>
+#include <QMetaType>
+#include <QVector>
+
+/**
+ * @brief One command response of a CSAFE frame, decoded with the layout of the response table
+ */
+struct CsafeResponse {
+    static const int maxFields = 17;
+
+    quint16 id = 0;             // command id, wrapper command id in the high byte for the wrapped commands
+    const char *name = nullptr; // CSAFE_..._CMD name, nullptr for commands missing from the response table
+    int count = 0;              // number of decoded fields
+    int values[maxFields] = {0};
+    QString text; // ascii field (negative width in the response table)
+
+    int value(int field, int defaultValue = 0) const { return field < count ? values[field] : defaultValue; }
+};
+
+/**
+ * @brief A decoded CSAFE frame: the status byte and the responses in the order of the frame
+ */
+struct CsafeFrame {
+    bool valid = false;
+    int status = 0;
+    QVector<CsafeResponse> responses;
+
+    const CsafeResponse *find(quint16 id) const {
+        for (const CsafeResponse &r : responses)
+            if (r.id == id)
+                return &r;
+        return nullptr;
+    }
+    QVariantMap toVariantMap() const;
+};
+
+Q_DECLARE_METATYPE(CsafeFrame)
 
 class csafe {
   private:
@@ -27,16 +63,40 @@ class csafe {
 
     // cmds['COMMAND_NAME'] = [0xCmd_Id, [Bytes, ...]]
     QMap<QString, QList<QList<int>>> cmds;
-    QMap<int, QPair<QString, QList<int>>> resp;
 
     QList<QList<int>> populateCmd(int First, QList<int> Second, int Third);
     QList<QList<int>> populateCmd(int First, QList<int> Second);
 
   public:
+    // ids of the responses decoded by readFrame, see the response table in csafe.cpp
+    enum ResponseId : quint16 {
+        CSAFE_GETSTATUS_CMD = 0x80,
+        CSAFE_GETVERSION_CMD = 0x91,
+        CSAFE_GETID_CMD = 0x92,
+        CSAFE_GETUNITS_CMD = 0x93,
+        CSAFE_GETSERIAL_CMD = 0x94,
+        CSAFE_GETODOMETER_CMD = 0x9B,
+        CSAFE_GETERRORCODE_CMD = 0x9C,
+        CSAFE_GETTWORK_CMD = 0xA0,
+        CSAFE_GETHORIZONTAL_CMD = 0xA1,
+        CSAFE_GETCALORIES_CMD = 0xA3,
+        CSAFE_GETPROGRAM_CMD = 0xA4,
+        CSAFE_GETSPEED_CMD = 0xA5,
+        CSAFE_GETPACE_CMD = 0xA6,
+        CSAFE_GETCADENCE_CMD = 0xA7,
+        CSAFE_GETUSERINFO_CMD = 0xAB,
+        CSAFE_GETHRCUR_CMD = 0xB0,
+        CSAFE_GETPOWER_CMD = 0xB4,
+        CSAFE_LF_GET_DETAIL = 0xD0,
+        CSAFE_PM_GET_WORKTIME = 0x1AA0,
+        CSAFE_PM_GET_WORKDISTANCE = 0x1AA3,
+    };
+
     csafe();
     QByteArray write(const QStringList &arguments , bool surround_msg = false); //surround_msg is for wrapping the communication in CSAFE non-standard way for some devices like PM3
     QVector<quint8> check_message(QVector<quint8> message);
     QVariantMap read(const QVector<quint8> &transmission);
+    CsafeFrame readFrame(const QByteArray &transmission);
 };
 
 #endif // CSAFE_H
@@ -1,8 +1,10 @@
 #include "csaferunner.h"
+#include <climits>
 
-CsafeRunnerThread::CsafeRunnerThread() {}
+CsafeRunnerThread::CsafeRunnerThread() { qRegisterMetaType<CsafeFrame>(); }
 
 CsafeRunnerThread::CsafeRunnerThread(QString deviceFileName, int sleepTime) {
+    qRegisterMetaType<CsafeFrame>();
     setDevice(deviceFileName);
     setSleepTime(sleepTime);
 }
@@ -23,10 +25,11 @@ void CsafeRunnerThread::sendCommand(const QStringList &commands) {
     mutex.lock();
     if (commandQueue.size() < MAX_QUEUE_SIZE) {
         commandQueue.enqueue(commands);
-        mutex.unlock();
+        commandQueued.wakeOne();
     } else {
         qDebug() << "CSAFE port commands QUEUE FULL. Dropping commands" << commands;
     }
+    mutex.unlock();
 }
 
 void CsafeRunnerThread::run() {
@@ -40,7 +43,7 @@ void CsafeRunnerThread::run() {
     csafe *csafeInstance = new csafe();
     int connectioncounter = 20; // counts timeouts. If 10 timeouts in a row, then the port is closed and reopened
     int refresh_nr = -1;
-    QStringList refreshCommand = {};
+    QByteArray rx(MAX_FRAME_SIZE, 0);
 
     while (1) {
 
@@ -60,37 +63,23 @@ void CsafeRunnerThread::run() {
             }
         }
 
-        int elapsed = 0;
-        while (elapsed < sleepTime || sleepTime == -1) {
-            QThread::msleep(50);
-            elapsed += 50;
-            // TODO: does not seem to work with netsocket as intended. (no data available)
-            // Needs further testing, maybe because the port is already closed and needs to remain open.
-            // No issue for current implementations as they do not use unsolicited slave data / cmdAutoUpload .
-            if (serial->dataAvailable() > 0 || !commandQueue.isEmpty()) {
-                qDebug() << "CSAFE port data available. " << serial->dataAvailable() << " bytes"
-                         << "commands in queue: " << commandQueue.size();
-                break;
-            }
-        }
-
         QByteArray ret;
         mutex.lock();
+        // sleep until a command is queued or the refresh is due. Unsolicited slave data arriving meanwhile is
+        // read at the next wake up: no current implementation uses cmdAutoUpload.
+        if (commandQueue.isEmpty() && serial->dataAvailable() <= 0) {
+            commandQueued.wait(&mutex, sleepTime == -1 ? ULONG_MAX : (unsigned long)sleepTime);
+        }
         if (!commandQueue.isEmpty()) {
             ret = csafeInstance->write(commandQueue.dequeue());
             qDebug() << "CSAFE port commands processed from queue. Remaining commands in queue: "
                      << commandQueue.size();
-        } else {
-            if (!(elapsed < sleepTime) || !refreshCommands.isEmpty()) {
-                if (refreshCommands.length() > 0) {
-                    refresh_nr++;
-                    if (refresh_nr >= refreshCommands.length()) {
-                        refresh_nr = 0;
-                    }
-                    QStringList refreshCommand = refreshCommands[refresh_nr];
-                    ret = csafeInstance->write(refreshCommand);
-                }
+        } else if (serial->dataAvailable() <= 0 && !refreshCommands.isEmpty()) {
+            refresh_nr++;
+            if (refresh_nr >= refreshCommands.length()) {
+                refresh_nr = 0;
             }
+            ret = csafeInstance->write(refreshCommands[refresh_nr]);
         }
         mutex.unlock();
 
@@ -102,14 +91,15 @@ void CsafeRunnerThread::run() {
                 connectioncounter++;
                 continue;
             }
-        } else {
+        } else if (serial->dataAvailable() > 0) {
             qDebug() << "CSAFE Slave unsolicited data present.";
+        } else {
+            continue; // refresh due but nothing to refresh
         }
 
-        static uint8_t rx[120];
-        rc = serial->rawRead(rx, 120, true);
+        rc = serial->rawRead((uint8_t *)rx.data(), rx.size(), true);
         if (rc > 0) {
-            qDebug() << "CSAFE << " << QByteArray::fromRawData((const char *)rx, rc).toHex(' ') << " (" << rc << ")";
+            qDebug() << "CSAFE << " << QByteArray::fromRawData(rx.constData(), rc).toHex(' ') << " (" << rc << ")";
             connectioncounter = 0;
         } else {
             qDebug() << "Error reading serial port " << deviceName << " rc=" << rc;
@@ -117,12 +107,7 @@ void CsafeRunnerThread::run() {
             continue;
         }
 
-        QVector<quint8> v;
-        for (int i = 0; i < rc; i++)
-            v.append(rx[i]);
-        QVariantMap frame = csafeInstance->read(v);
-        emit onCsafeFrame(frame);
-        memset(rx, 0x00, sizeof(rx));
+        emit onCsafeFrame(csafeInstance->readFrame(QByteArray::fromRawData(rx.constData(), rc)));
     }
     serial->closePort();
 }
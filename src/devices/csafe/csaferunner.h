@@ -8,12 +8,15 @@
 #include <QThread>
 #include <QVariantMap>
 #include <QVector>
+#include <QWaitCondition>
 
 #define MAX_QUEUE_SIZE 100
+#define MAX_FRAME_SIZE 120
 /**
  * @brief The CsafeRunnerThread class is a thread that runs the CSAFE protocol interaction.
  * It periodically sends the refresh commands processes the responses.
- * It also allows sending additional commands to the device.
+ * It also allows sending additional commands to the device: the thread sleeps on a wait condition
+ * between the refreshes, so a queued command is sent right away.
  */
 class CsafeRunnerThread : public QThread {
     Q_OBJECT
@@ -31,7 +34,7 @@ class CsafeRunnerThread : public QThread {
     void sendCommand(const QStringList &commands);
 
   signals:
-    void onCsafeFrame(const QVariantMap &frame);
+    void onCsafeFrame(const CsafeFrame &frame);
     void portAvailable(bool available);
 
   private:
@@ -41,4 +44,5 @@ class CsafeRunnerThread : public QThread {
     QList<QStringList> refreshCommands;
     QQueue<QStringList> commandQueue;
     QMutex mutex;
+    QWaitCondition commandQueued;
 };
@@ -58,6 +58,17 @@ int NetSerial::dataAvailable() {
     return socket->bytesAvailable();
 }
 
+int NetSerial::waitForData(int timeout) {
+    if (!isOpen()) {
+        return -1;
+    }
+    // waitForReadyRead only reports data arriving after the call, so check what is already buffered first
+    if (socket->bytesAvailable() > 0 || socket->waitForReadyRead(timeout)) {
+        return static_cast<int>(socket->bytesAvailable());
+    }
+    return isOpen() ? 0 : -1;
+}
+
 int NetSerial::rawWrite(uint8_t *bytes, int size) {
     if (!isOpen()) {
         qDebug() << "Socket not connected.";
@@ -85,23 +96,28 @@ int NetSerial::rawRead(uint8_t bytes[], int size, bool line) {
         return -1;
     }
 
-    QByteArray buffer;
-    while (buffer.size() < size) {
-        if (!socket->waitForReadyRead(_timeout)) {
+    QElapsedTimer elapsed;
+    elapsed.start();
+    int received = 0;
+    while (received < size) {
+        int remaining = _timeout - static_cast<int>(elapsed.elapsed());
+        if (remaining <= 0 || waitForData(remaining) <= 0) {
             qDebug() << "Read operation timed out.";
-            return buffer.size() > 0 ? buffer.size() : -1;
+            return received > 0 ? received : -1;
         }
 
-        buffer.append(socket->read(size - buffer.size()));
-        if (line && buffer.contains(static_cast<char>(endChar))) {
-            int index = buffer.indexOf(static_cast<char>(endChar)) + 1;
-            memcpy(bytes, buffer.data(), index);
-            return index;
+        // in line mode stop at the end char, whatever follows stays in the socket buffer for the next read
+        while (received < size && socket->bytesAvailable() > 0) {
+            char c;
+            socket->getChar(&c);
+            bytes[received++] = static_cast<uint8_t>(c);
+            if (line && static_cast<uint8_t>(c) == endChar) {
+                return received;
+            }
         }
     }
 
-    memcpy(bytes, buffer.data(), buffer.size());
-    return buffer.size();
+    return received;
 }
 
 bool NetSerial::parseDeviceFilename(const QString &filename) {
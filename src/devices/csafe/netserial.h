@@ -26,6 +26,7 @@
 #include <QHostAddress>
 #include <QTcpSocket>
 #include <QDebug>
+#include <QElapsedTimer>
 
 /**
  * @brief This is a simple implementation of serial port emulation over TCP
@@ -40,6 +41,7 @@ class NetSerial : public SerialHandler {
     int openPort() override;
     int closePort() override;
     int dataAvailable() override;
+    int waitForData(int timeout) override;
     int rawWrite(uint8_t *bytes, int size) override;
     int rawRead(uint8_t bytes[], int size, bool line = false) override;
 
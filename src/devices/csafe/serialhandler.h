@@ -43,6 +43,8 @@ class SerialHandler {
     virtual int rawWrite(uint8_t *bytes, int size) = 0;
     virtual int rawRead(uint8_t bytes[], int size, bool line = false) = 0;
     virtual int dataAvailable() = 0;
+    // Blocks until data can be read or timeout ms elapsed: returns the bytes available, 0 on timeout, -1 on error
+    virtual int waitForData(int timeout) = 0;
     virtual bool isOpen() const = 0;
 
     // Common configuration methods
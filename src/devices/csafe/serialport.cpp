@@ -21,7 +21,9 @@ void Serialport::setDevice(const QString &devname) {
 void Serialport::setEndChar(uint8_t endChar) { this->endChar = endChar; }
 
 bool Serialport::isOpen() const {
-#ifdef WIN32
+#if defined(Q_OS_ANDROID)
+    return usbSerialOpen;
+#elif defined(WIN32)
     return (devicePort != INVALID_HANDLE_VALUE); // Checks if the Windows handle is valid
 #else
     return (devicePort != -1); // Checks if the file descriptor is valid on Linux/macOS
@@ -29,18 +31,28 @@ bool Serialport::isOpen() const {
 }
 
 int Serialport::closePort() {
-#ifdef WIN32
-    return (int)!CloseHandle(devicePort);
+    if (!isOpen()) {
+        return 0;
+    }
+#if defined(Q_OS_ANDROID)
+    usbSerialOpen = false;
+    int rc = 0;
+#elif defined(WIN32)
+    int rc = (int)!CloseHandle(devicePort);
+    devicePort = INVALID_HANDLE_VALUE;
 #else
     tcflush(devicePort, TCIOFLUSH); // Clear out the buffer
-    return close(devicePort);
+    int rc = close(devicePort);
+    devicePort = -1;
 #endif
+    return rc;
 }
 
 int Serialport::openPort() {
 #ifdef Q_OS_ANDROID
     QAndroidJniObject::callStaticMethod<void>("org/cagnulen/qdomyoszwift/Usbserial", "open",
                                               "(Landroid/content/Context;)V", QtAndroid::androidContext().object());
+    usbSerialOpen = true;
 #elif !defined(WIN32)
 
     // LINUX AND MAC USES TERMIO / IOCTL / STDIO
@@ -219,7 +231,7 @@ int Serialport::dataAvailable() {
 
 #ifdef Q_OS_ANDROID
     jint len = QAndroidJniObject::callStaticMethod<jint>("org/cagnulen/qdomyoszwift/Usbserial", "readLen", "()I");
-    static_cast<size_t>(len);
+    return static_cast<int>(len);
 
 #elif defined(WIN32)
     COMSTAT cs;
@@ -237,6 +249,41 @@ int Serialport::dataAvailable() {
 #endif
 }
 
+int Serialport::waitForData(int timeout) {
+    if (!isOpen()) {
+        return -1;
+    }
+
+#if defined(Q_OS_ANDROID) || defined(WIN32)
+    // neither the usb serial bridge nor the comm api used here can signal readiness, check the queue instead
+    QElapsedTimer elapsed;
+    elapsed.start();
+    int available = dataAvailable();
+    while (available == 0 && elapsed.elapsed() < timeout) {
+        QThread::msleep(10);
+        available = dataAvailable();
+    }
+    return available;
+#else
+    struct pollfd pfd;
+    pfd.fd = devicePort;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int rc;
+    do {
+        rc = poll(&pfd, 1, timeout);
+    } while (rc == -1 && errno == EINTR);
+    if (rc <= 0) {
+        return rc;
+    }
+    if (!(pfd.revents & POLLIN)) {
+        return -1; // POLLERR, POLLHUP or POLLNVAL: the port is gone
+    }
+    int available = dataAvailable();
+    return available > 0 ? available : 1;
+#endif
+}
+
 int Serialport::rawWrite(uint8_t *bytes, int size) {
     qDebug() << "Writing data:" << QByteArray((const char *)bytes, size).toHex();
     int rc = 0;
@@ -347,30 +394,26 @@ int Serialport::rawRead(uint8_t bytes[], int size, bool line) {
 
 #else
 
-    int timeout = 0, i = 0;
+    int i = 0;
     uint8_t byte;
-
-    // read one byte at a time sleeping when no data ready
-    // until we timeout waiting then return error
-    for (i = 0; i < size; i++) {
-        timeout = 0;
-        rc = 0;
-        while (rc == 0 && timeout < _timeout) {
-            rc = read(devicePort, &byte, 1);
-            if (rc == -1)
-                return -1;
-            else if (rc == 0) {
-                QThread::msleep(50); // sleep for 1/20th of a second
-                // std::this_thread::sleep_for(std::chrono::milliseconds(50));
-                timeout += 50;
-            } else {
-                bytes[i] = byte;
-                if (line && endChar == byte) {
-                    return i + 1;
-                }
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    // read one byte at a time, so nothing past the end char is consumed, and block in poll() when no data is
+    // ready until we timeout waiting then return error
+    while (i < size) {
+        rc = read(devicePort, &byte, 1);
+        if (rc == 1) {
+            bytes[i++] = byte;
+            if (line && endChar == byte) {
+                return i;
             }
+            continue;
         }
-        if (timeout >= _timeout)
+        if (rc == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            return -1;
+        int remaining = _timeout - (int)elapsed.elapsed();
+        if (remaining <= 0 || waitForData(remaining) <= 0)
             return i > 0 ? i : -1;
     }
 
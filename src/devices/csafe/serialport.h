@@ -27,6 +27,7 @@
 #include <QAndroidJniObject>
 #endif
 
+#include <QElapsedTimer>
 #include <QString>
 #include <QThread>
 #include <QFile>
@@ -37,6 +38,7 @@
 #include <windows.h>
 #include <winbase.h>
 #else
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <termios.h>
 #include <unistd.h>
@@ -66,6 +68,7 @@ class Serialport : public SerialHandler {
     // Port control
     int openPort() override;
     int dataAvailable() override;
+    int waitForData(int timeout) override;
     int closePort() override;
 
     // Data transfer
@@ -82,16 +85,17 @@ class Serialport : public SerialHandler {
 
     // device port
 #ifdef WIN32
-    HANDLE devicePort;  // file descriptor for reading from com3
+    HANDLE devicePort = INVALID_HANDLE_VALUE; // file descriptor for reading from com3
     DCB deviceSettings; // serial port settings baud rate et al
 #else
-    int devicePort;                // unix!!
+    int devicePort = -1;           // unix!!
     struct termios deviceSettings; // unix!!
 #endif
 
 #ifdef Q_OS_ANDROID
     QList<jbyte> bufRX;
     bool cleanFrame = false;
+    bool usbSerialOpen = false; // the usb serial bridge has no file descriptor
 #endif
 };
 
@@ -6,11 +6,11 @@ csafeelliptical::csafeelliptical(bool noWriteResistance, bool noHeartService, bo
                                  int8_t bikeResistanceOffset, double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->noVirtualDevice = noVirtualDevice;
-    connect(refresh, &QTimer::timeout, this, &csafeelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &csafeelliptical::update);
     refresh->start(200ms);
     QString deviceFilename =
         settings.value(QZSettings::csafe_elliptical_port, QZSettings::default_csafe_elliptical_port).toString();
@@ -48,15 +48,18 @@ void csafeelliptical::setupWorkout() {
     emit sendCsafeCommand(QStringList() << "CSAFE_GOINUSE_CMD");
 }
 
-void csafeelliptical::onCsafeFrame(const QVariantMap &csafeFrame) {
-    // qDebug() << "Current CSAFE frame received:" << csafeFrame;
+void csafeelliptical::onCsafeFrame(const CsafeFrame &csafeFrame) {
+    // qDebug() << "Current CSAFE frame received:" << csafeFrame.toVariantMap();
 
-    if (csafeFrame["CSAFE_GETCADENCE_CMD"].isValid()) {
-        onCadence(csafeFrame["CSAFE_GETCADENCE_CMD"].value<QVariantList>()[0].toDouble());
+    if (!csafeFrame.valid) {
+        return;
     }
-    if (csafeFrame["CSAFE_GETSPEED_CMD"].isValid()) {
-        double speed = csafeFrame["CSAFE_GETSPEED_CMD"].value<QVariantList>()[0].toDouble();
-        int unit = csafeFrame["CSAFE_GETSPEED_CMD"].value<QVariantList>()[1].toInt();
+    if (const CsafeResponse *r = csafeFrame.find(csafe::CSAFE_GETCADENCE_CMD)) {
+        onCadence(r->value(0));
+    }
+    if (const CsafeResponse *r = csafeFrame.find(csafe::CSAFE_GETSPEED_CMD)) {
+        double speed = r->value(0);
+        int unit = r->value(1);
         qDebug() << "Speed value:" << speed << "unit:" << CSafeUtility::getUnitName(unit) << "(" << unit << ")";
 
         if (unit == 82) { // revs/minute
@@ -65,37 +68,35 @@ void csafeelliptical::onCsafeFrame(const QVariantMap &csafeFrame) {
             onSpeed(CSafeUtility::convertToStandard(unit, speed));
         }
     }
-    if (csafeFrame["CSAFE_GETPOWER_CMD"].isValid()) {
-        onPower(csafeFrame["CSAFE_GETPOWER_CMD"].value<QVariantList>()[0].toDouble());
+    if (const CsafeResponse *r = csafeFrame.find(csafe::CSAFE_GETPOWER_CMD)) {
+        onPower(r->value(0));
     }
-    if (csafeFrame["CSAFE_GETHRCUR_CMD"].isValid()) {
-        onHeart(csafeFrame["CSAFE_GETHRCUR_CMD"].value<QVariantList>()[0].toDouble());
+    if (const CsafeResponse *r = csafeFrame.find(csafe::CSAFE_GETHRCUR_CMD)) {
+        onHeart(r->value(0));
     }
-    if (csafeFrame["CSAFE_GETCALORIES_CMD"].isValid()) {
-        onCalories(csafeFrame["CSAFE_GETCALORIES_CMD"].value<QVariantList>()[0].toDouble());
+    if (const CsafeResponse *r = csafeFrame.find(csafe::CSAFE_GETCALORIES_CMD)) {
+        onCalories(r->value(0));
     }
-    if (csafeFrame["CSAFE_GETHORIZONTAL_CMD"].isValid()) {
-        double distance = csafeFrame["CSAFE_GETHORIZONTAL_CMD"].value<QVariantList>()[0].toDouble();
-        int unit = csafeFrame["CSAFE_GETHORIZONTAL_CMD"].value<QVariantList>()[1].toInt();
+    if (const CsafeResponse *r = csafeFrame.find(csafe::CSAFE_GETHORIZONTAL_CMD)) {
+        double distance = r->value(0);
+        int unit = r->value(1);
         qDebug() << "Distance value:" << distance << "unit:" << CSafeUtility::getUnitName(unit) << "(" << unit << ")"
                  << CSafeUtility::convertToStandard(unit, distance);
         onDistance(CSafeUtility::convertToStandard(unit, distance));
     }
-    if (csafeFrame["CSAFE_GETPROGRAM_CMD"].isValid()) {
-        int resistance = csafeFrame["CSAFE_GETPROGRAM_CMD"].value<QVariantList>()[1].toUInt();
+    if (const CsafeResponse *r = csafeFrame.find(csafe::CSAFE_GETPROGRAM_CMD)) {
+        int resistance = r->value(1);
         Resistance = resistance;
-        qDebug() << "Program:" << csafeFrame["CSAFE_GETPROGRAM_CMD"].value<QVariantList>()[0].toUInt()
-                 << "Current level received:" << resistance;
+        qDebug() << "Program:" << r->value(0) << "Current level received:" << resistance;
     }
-    if (csafeFrame["CSAFE_GETSTATUS_CMD"].isValid()) {
-        uint16_t statusvalue = csafeFrame["CSAFE_GETSTATUS_CMD"].value<QVariantList>()[0].toUInt();
-        qDebug() << "Status value:" << statusvalue << " lastStatus:" << lastStatus
-                 << " Machine state from status:" << (statusvalue & 0x0f);
-        if (statusvalue != lastStatus) {
-            lastStatus = statusvalue;
-            char statusChar = static_cast<char>(statusvalue & 0x0f);
-            onStatus(statusChar);
-        }
+
+    uint16_t statusvalue = csafeFrame.status;
+    qDebug() << "Status value:" << statusvalue << " lastStatus:" << lastStatus
+             << " Machine state from status:" << (statusvalue & 0x0f);
+    if (statusvalue != lastStatus) {
+        lastStatus = statusvalue;
+        char statusChar = static_cast<char>(statusvalue & 0x0f);
+        onStatus(statusChar);
     }
 }
 
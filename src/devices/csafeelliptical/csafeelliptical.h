@@ -83,7 +83,7 @@ class csafeelliptical : public elliptical {
     bool connected() override;
 
   private:
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
@@ -133,7 +133,7 @@ class csafeelliptical : public elliptical {
     void onStatus(char status);
     void onSpeed(double speed);
     void portAvailable(bool available);
-    void onCsafeFrame(const QVariantMap &frame);
+    void onCsafeFrame(const CsafeFrame &frame);
 
   public slots:
     void deviceDiscovered(const QBluetoothDeviceInfo &device);
@@ -5,12 +5,12 @@ using namespace std::chrono_literals;
 csaferower::csaferower(bool noWriteResistance, bool noHeartService, bool noVirtualDevice) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->noVirtualDevice = noVirtualDevice;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &csaferower::update);
+    connect(refresh, &PollTimer::timeout, this, &csaferower::update);
     refresh->start(200ms);
     csaferowerThread *t = new csaferowerThread();
     connect(t, &csaferowerThread::onPower, this, &csaferower::onPower);
@@ -123,7 +123,7 @@ class csaferower : public rower {
     bool connected() override;
 
   private:
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
@@ -19,12 +19,12 @@ using namespace std::chrono_literals;
 cscbike::cscbike(bool noWriteResistance, bool noHeartService, bool noVirtualDevice) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->noVirtualDevice = noVirtualDevice;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &cscbike::update);
+    connect(refresh, &PollTimer::timeout, this, &cscbike::update);
     refresh->start(200ms);
 }
 /*
@@ -141,6 +141,7 @@ void cscbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void cscbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     qDebug() << "characteristicChanged << " << characteristic.uuid() << newValue.toHex(' ') << newValue.length();
     Q_UNUSED(characteristic);
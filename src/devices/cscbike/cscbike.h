@@ -44,7 +44,7 @@ class cscbike : public bike {
     void startDiscover();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyService* cadenceService = nullptr;
@@ -18,11 +18,11 @@ using namespace std::chrono_literals;
 
 cycleopsphantombike::cycleopsphantombike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &cycleopsphantombike::update);
+    connect(refresh, &PollTimer::timeout, this, &cycleopsphantombike::update);
     refresh->start(200ms);
 }
 
@@ -185,6 +185,7 @@ void cycleopsphantombike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void cycleopsphantombike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
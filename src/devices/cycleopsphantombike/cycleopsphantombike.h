@@ -69,7 +69,7 @@ class cycleopsphantombike : public bike {
     double bikeResistanceToPeloton(double resistance);
     void setUserConfiguration(double wheelDiameter, double gearRatio);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     const int max_resistance = 100;
 
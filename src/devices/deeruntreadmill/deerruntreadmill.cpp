@@ -29,9 +29,9 @@ deerruntreadmill::deerruntreadmill(uint32_t pollDeviceTime, bool noConsole, bool
         lastInclination = forceInitInclination;
     }
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &deerruntreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &deerruntreadmill::update);
     refresh->start(pollDeviceTime);
 }
 
@@ -254,6 +254,7 @@ void deerruntreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void deerruntreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -265,8 +266,10 @@ void deerruntreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
     emit debug(QStringLiteral(" << ") + QString::number(value.length()) + QStringLiteral(" ") + value.toHex(' '));
     emit packetReceived();
 
-    if (newValue.length() < 51)
+    if (newValue.length() < 51) {
+        notificationParseError(characteristic);
         return;
+    }
 
     lastPacket = value;
     // lastState = value.at(0);
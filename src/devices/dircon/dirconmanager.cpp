@@ -75,7 +75,7 @@ using namespace std::chrono_literals;
 
 #define DM_MACHINE_ENUM_OP(DESC, NAME, TYPE, P1, P2, P3) DM_MACHINE_##DESC,
 
-enum { DM_MACHINE_OP(DM_MACHINE_ENUM_OP, 0, 0, 0) };
+enum { DM_MACHINE_OP(DM_MACHINE_ENUM_OP, 0, 0, 0) DM_MACHINE_NUM };
 
 #define DM_SERV_ENUMU_OP(DESC, UUID, MACHINE, P1, P2, P3) DM_SERV_U_##DESC = UUID,
 
@@ -107,17 +107,21 @@ enum { DM_SERV_OP(DM_SERV_ENUMI_OP, 0, 0, 0) DM_SERV_I_NUM };
         }                                                                                                              \
         if (P2.size()) {                                                                                               \
             QString dircon_id = QString("%1").arg(settings.value(QZSettings::dircon_id,                                \
-            QZSettings::default_dircon_id).toInt(), 4, 10, QChar('0'));                                                \
+            QZSettings::default_dircon_id).toInt() + station, 4, 10, QChar('0'));                                      \
+            QString name = QString(QStringLiteral(NAME));                                                              \
+            /* a name without the id would be the same for every gym station */                                        \
+            if (station && !name.contains(QStringLiteral("$uuid_hex$")))                                               \
+                name += QStringLiteral(" $uuid_hex$");                                                                 \
             DirconProcessor *processor = new DirconProcessor(                                                          \
-                P2,                                                                                                    \
-                QString(QStringLiteral(NAME))                                                                          \
-                    .replace(QStringLiteral("$uuid_hex$"), dircon_id),                                                 \
-                server_base_port + DM_MACHINE_##DESC, QString(QStringLiteral("%1")).arg(DM_MACHINE_##DESC), mac,       \
+                P2, name.replace(QStringLiteral("$uuid_hex$"), dircon_id),                                             \
+                server_base_port + station * DM_MACHINE_NUM + DM_MACHINE_##DESC,                                       \
+                QString(QStringLiteral("%1")).arg(station * DM_MACHINE_NUM + DM_MACHINE_##DESC), mac,                  \
                 this);                                                                                                 \
             QString servdesc;                                                                                          \
             foreach (DirconProcessorService *s, P2) { servdesc += *s + QStringLiteral(","); }                          \
             qDebug() << "Initializing dircon for" << QString(QStringLiteral(NAME)) << "with serv" << servdesc;         \
             processors.append(processor);                                                                              \
+            connect(processor, &DirconProcessor::clientDisconnected, this, &DirconManager::clientDisconnected);        \
             if (!processor->init()) {                                                                                  \
                 qDebug() << "Error initializing" << QString(QStringLiteral(NAME));                                     \
             }                                                                                                          \
@@ -145,8 +149,8 @@ QString DirconManager::getMacAddress() {
 #define DM_CHAR_NOTIF_BUILD_OP(UUID, P1, P2, P3) notif##UUID = new CharacteristicNotifier##UUID(P1, this);
 
 DirconManager::DirconManager(bluetoothdevice *Bike, int8_t bikeResistanceOffset, double bikeResistanceGain,
-                             QObject *parent)
-    : QObject(parent) {
+                             QObject *parent, int station)
+    : QObject(parent), device(Bike) {
     QSettings settings;
     DirconProcessorService *service;
     QList<DirconProcessorService *> services, proc_services;
@@ -181,8 +185,20 @@ DirconManager::DirconManager(bluetoothdevice *Bike, int8_t bikeResistanceOffset,
     int rv##UUID = notif##UUID->notify(all##UUID);
 
 #define DM_CHAR_NOTIF_NOTIF2_OP(UUID, P1, P2, P3)                                                                      \
-    if (rv##UUID == CN_OK)                                                                                             \
-        P1->sendCharacteristicNotification(0x##UUID, all##UUID);
+    if (rv##UUID == CN_OK) {                                                                                           \
+        P1->sendCharacteristicNotification(0x##UUID, all##UUID);                                                       \
+        QZMetrics::increment(QZMetrics::DirconNotifications, 0x##UUID);                                                \
+        QZMetrics::observeOnce(QZMetrics::NotificationToDirconLatency, device->ingressNs(), lastIngressNs); \
+    }
+
+void DirconManager::clientDisconnected() {
+    // the road of a simulation goes with the app that sent it
+    for (DirconProcessor *processor : qAsConst(processors))
+        if (processor->hasClients())
+            return;
+    writeP2AD9->stopSimulation();
+    writePE005->stopSimulation();
+}
 
 void DirconManager::bikeProvider() {
     DM_CHAR_NOTIF_OP(DM_CHAR_NOTIF_NOTIF1_OP, 0, 0, 0)
@@ -31,13 +31,19 @@ class DirconManager : public QObject {
     CharacteristicWriteProcessorE005 *writePE005 = 0;
     DM_CHAR_NOTIF_OP(DM_CHAR_NOTIF_DEFINE_OP, 0, 0, 0)
     QList<DirconProcessor *> processors;
+    bluetoothdevice *device = nullptr;
+    qint64 lastIngressNs = 0; // newest stamp of the device observed in the latency histogram
     static QString getMacAddress();
 
   public:
+    /**
+     * @param station 0 for the device of the app, a gym station from 1: every station has its own ports and names
+     */
     explicit DirconManager(bluetoothdevice *t, int8_t bikeResistanceOffset = 4, double bikeResistanceGain = 1.0,
-                           QObject *parent = nullptr);
+                           QObject *parent = nullptr, int station = 0);
   private slots:
     void bikeProvider();
+    void clientDisconnected();
   signals:
     void changeInclination(double grade, double percentage);
     void ftmsCharacteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue);
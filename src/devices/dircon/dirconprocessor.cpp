@@ -93,6 +93,7 @@ void DirconProcessor::tcpDisconnected() {
              << " uuid = " << serverName;
     clientsMap.remove(socket);
     socket->deleteLater();
+    emit clientDisconnected();
 }
 
 DirconPacket DirconProcessor::processPacket(DirconProcessorClient *client, const DirconPacket &pkt) {
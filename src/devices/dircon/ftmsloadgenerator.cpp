@@ -0,0 +1,373 @@
+#include "devices/dircon/ftmsloadgenerator.h"
+#include "devices/ftmsbike/ftmsbike.h"
+#include <QDebug>
+#include <QEventLoop>
+#include <QStringList>
+#include <algorithm>
+
+DirconLoadTransport::DirconLoadTransport(const QString &host, quint16 port, QObject *parent)
+    : FtmsLoadTransport(parent), host(host), port(port), socket(this) {
+    connect(&socket, &QTcpSocket::connected, this, &DirconLoadTransport::connected);
+    connect(&socket, &QTcpSocket::readyRead, this, &DirconLoadTransport::dataAvailable);
+    connect(&socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this,
+            &DirconLoadTransport::socketError);
+}
+
+void DirconLoadTransport::open() {
+    buffer.clear();
+    services.clear();
+    toEnable.clear();
+    chars.clear();
+    isReady = false;
+    socket.connectToHost(host, port);
+}
+
+void DirconLoadTransport::close() {
+    isReady = false;
+    socket.abort();
+}
+
+void DirconLoadTransport::send(DirconPacket &pkt) {
+    pkt.isRequest = true;
+    // never the sequence number of the last request: the server would take the packet for an answer
+    seq = (seq + 1) & 0xFF;
+    socket.write(pkt.encode(seq));
+}
+
+int DirconLoadTransport::write(quint16 uuid, const QByteArray &data) {
+    if (!isReady || data.isEmpty())
+        return -1;
+    DirconPacket pkt;
+    pkt.Identifier = DPKT_MSGID_WRITE_CHARACTERISTIC;
+    pkt.uuid = uuid;
+    pkt.additional_data = data;
+    send(pkt);
+    return seq;
+}
+
+void DirconLoadTransport::connected() {
+    DirconPacket pkt;
+    pkt.Identifier = DPKT_MSGID_DISCOVER_SERVICES;
+    send(pkt);
+}
+
+void DirconLoadTransport::discoverNext() {
+    DirconPacket pkt;
+    if (!services.isEmpty()) {
+        pkt.Identifier = DPKT_MSGID_DISCOVER_CHARACTERISTICS;
+        pkt.uuid = services.takeFirst();
+    } else if (!toEnable.isEmpty()) {
+        pkt.Identifier = DPKT_MSGID_ENABLE_CHARACTERISTIC_NOTIFICATIONS;
+        pkt.uuid = toEnable.takeFirst();
+        pkt.additional_data.append((char)1);
+    } else {
+        qDebug() << "dircon load client" << host << port << "ready with" << chars.size() << "characteristics";
+        isReady = true;
+        emit ready();
+        return;
+    }
+    send(pkt);
+}
+
+void DirconLoadTransport::handle(const DirconPacket &pkt) {
+    bool success = pkt.ResponseCode == DPKT_RESPCODE_SUCCESS_REQUEST;
+    switch (pkt.Identifier) {
+    case DPKT_MSGID_DISCOVER_SERVICES:
+        if (!success || pkt.uuids.isEmpty()) {
+            emit failed(QStringLiteral("no services on %1:%2").arg(host).arg(port));
+            return;
+        }
+        services = pkt.uuids;
+        discoverNext();
+        break;
+    case DPKT_MSGID_DISCOVER_CHARACTERISTICS:
+        if (success) {
+            for (int i = 0; i < pkt.uuids.size() && i < pkt.additional_data.size(); i++) {
+                quint16 uuid = pkt.uuids.at(i);
+                quint8 type = pkt.additional_data.at(i);
+                // the same characteristic can be in more services, a notification is enabled only once
+                if ((type & DPKT_CHAR_PROP_FLAG_NOTIFY) && !chars.contains(uuid))
+                    toEnable.append(uuid);
+                chars[uuid] |= type;
+            }
+        }
+        discoverNext();
+        break;
+    case DPKT_MSGID_ENABLE_CHARACTERISTIC_NOTIFICATIONS:
+        if (!isReady)
+            discoverNext();
+        break;
+    case DPKT_MSGID_WRITE_CHARACTERISTIC:
+        emit response(pkt.SequenceNumber, success, pkt.additional_data);
+        break;
+    case DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION:
+        emit notification(pkt.uuid, pkt.additional_data);
+        break;
+    default:
+        break;
+    }
+}
+
+void DirconLoadTransport::dataAvailable() {
+    buffer.append(socket.readAll());
+    while (1) {
+        DirconPacket pkt;
+        int rv = pkt.parse(buffer, seq);
+        if (rv > 0) {
+            buffer = buffer.mid(rv);
+            handle(pkt);
+        } else if (rv < DPKT_PARSE_ERROR) {
+            qDebug() << "dircon load client: unexpected packet" << buffer.left(DPKT_PARSE_ERROR - rv).toHex(' ');
+            buffer = buffer.mid(DPKT_PARSE_ERROR - rv);
+        } else
+            break;
+    }
+}
+
+void DirconLoadTransport::socketError() {
+    isReady = false;
+    emit failed(QStringLiteral("%1:%2 %3").arg(host).arg(port).arg(socket.errorString()));
+}
+
+DirectLoadTransport::DirectLoadTransport(CharacteristicWriteProcessor *writeProcessor,
+                                         const QList<CharacteristicNotifier *> &notifiers, int periodMs,
+                                         QObject *parent)
+    : FtmsLoadTransport(parent), writeProcessor(writeProcessor), notifiers(notifiers), timer(this) {
+    timer.setInterval(periodMs);
+    connect(&timer, &QTimer::timeout, this, &DirectLoadTransport::notifyAll);
+}
+
+void DirectLoadTransport::open() {
+    timer.start();
+    QTimer::singleShot(0, this, [this]() { emit ready(); });
+}
+
+void DirectLoadTransport::close() { timer.stop(); }
+
+int DirectLoadTransport::write(quint16 uuid, const QByteArray &data) {
+    if (!writeProcessor)
+        return -1;
+    int id = nextId++;
+    QByteArray reply;
+    bool success = writeProcessor->writeProcess(uuid, data, reply) != CP_INVALID;
+    // answered from the event loop, like a radio or a socket would
+    QTimer::singleShot(0, this, [this, id, success, reply]() { emit response(id, success, reply); });
+    return id;
+}
+
+void DirectLoadTransport::notifyAll() {
+    foreach (CharacteristicNotifier *notifier, notifiers) {
+        QByteArray value;
+        if (notifier->notify(value) == CN_OK)
+            emit notification(notifier->uuid(), value);
+    }
+}
+
+QString FtmsLoadGenerator::Report::toString() const {
+    QStringList lines;
+    lines << QStringLiteral("clients %1 (%2 failed), %3 s").arg(clients).arg(failedClients).arg(seconds, 0, 'f', 1);
+    lines << QStringLiteral("writes %1 (%2/s), answered %3, errors %4, dropped %5, reordered %6, unexpected %7, "
+                            "skipped %8")
+                 .arg(writes)
+                 .arg(writeRate(), 0, 'f', 1)
+                 .arg(responses)
+                 .arg(errors)
+                 .arg(dropped)
+                 .arg(reordered)
+                 .arg(unexpected)
+                 .arg(skipped);
+    lines << QStringLiteral("latency ms avg %1 p50 %2 p95 %3 p99 %4 max %5")
+                 .arg(latencyAvgMs, 0, 'f', 2)
+                 .arg(latencyP50Ms, 0, 'f', 2)
+                 .arg(latencyP95Ms, 0, 'f', 2)
+                 .arg(latencyP99Ms, 0, 'f', 2)
+                 .arg(latencyMaxMs, 0, 'f', 2);
+    lines << QStringLiteral("notifications %1 (%2/s)").arg(notifications).arg(notificationRate(), 0, 'f', 1);
+    QList<quint16> uuids = notificationsByUuid.keys();
+    std::sort(uuids.begin(), uuids.end());
+    foreach (quint16 uuid, uuids) {
+        lines << QStringLiteral("  %1 %2/s")
+                     .arg(uuid, 4, 16, QLatin1Char('0'))
+                     .arg(seconds > 0 ? notificationsByUuid.value(uuid) / seconds : 0, 0, 'f', 1);
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+FtmsLoadGenerator::FtmsLoadGenerator(const Config &config, QObject *parent)
+    : QObject(parent), config(config), seed(config.seed), timer(this) {
+    // fine enough for a few hundred writes a second, the rate is kept on the elapsed time
+    timer.setInterval(5);
+    connect(&timer, &QTimer::timeout, this, &FtmsLoadGenerator::tick);
+}
+
+void FtmsLoadGenerator::addClient(FtmsLoadTransport *transport) {
+    Client *client = new Client;
+    client->transport = transport;
+    transport->setParent(this);
+    clients.append(client);
+    connect(transport, &FtmsLoadTransport::ready, this, [this, client]() {
+        client->ready = true;
+        client->readyNs = clock.nsecsElapsed();
+    });
+    connect(transport, &FtmsLoadTransport::failed, this, [client](const QString &error) {
+        qDebug() << "ftms load client failed:" << error;
+        client->ready = false;
+        client->failed = true;
+    });
+    connect(transport, &FtmsLoadTransport::response, this,
+            [this, client](int id, bool success, const QByteArray &data) { onResponse(client, id, success, data); });
+    connect(transport, &FtmsLoadTransport::notification, this, [this](quint16 uuid, const QByteArray &) {
+        if (stoppedNs >= 0)
+            return;
+        totals.notifications++;
+        totals.notificationsByUuid[uuid]++;
+    });
+}
+
+void FtmsLoadGenerator::start() {
+    clock.start();
+    stoppedNs = -1;
+    foreach (Client *client, clients)
+        client->transport->open();
+    timer.start();
+}
+
+void FtmsLoadGenerator::stop() {
+    if (stoppedNs >= 0)
+        return;
+    timer.stop();
+    stoppedNs = clock.nsecsElapsed();
+    foreach (Client *client, clients) {
+        expire(client, stoppedNs);
+        totals.dropped += client->pending.size();
+        client->pending.clear();
+        client->ready = false;
+        client->transport->close();
+    }
+    emit finished();
+}
+
+FtmsLoadGenerator::Report FtmsLoadGenerator::run(int ms) {
+    start();
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+    stop();
+    return report();
+}
+
+void FtmsLoadGenerator::expire(Client *client, qint64 now) {
+    qint64 timeoutNs = (qint64)config.timeoutMs * 1000000;
+    while (!client->pending.isEmpty() && now - client->pending.first().sentNs > timeoutNs) {
+        client->pending.removeFirst();
+        totals.dropped++;
+    }
+}
+
+void FtmsLoadGenerator::tick() {
+    qint64 now = clock.nsecsElapsed();
+    foreach (Client *client, clients) {
+        expire(client, now);
+        if (!client->ready)
+            continue;
+        // the writes due since the client is ready: a late tick catches up, the rate stays the same
+        quint64 due = (quint64)((now - client->readyNs) / 1e9 * config.rate);
+        while (client->sent < due) {
+            client->sent++;
+            if (client->pending.size() >= client->transport->maxPending()) {
+                totals.skipped++;
+                continue;
+            }
+            QByteArray command = randomCommand(seed, config.treadmill);
+            int id = client->transport->write(0x2AD9, command);
+            if (id < 0) {
+                totals.errors++;
+                continue;
+            }
+            totals.writes++;
+            client->pending.append({id, (quint8)command.at(0), clock.nsecsElapsed()});
+        }
+    }
+}
+
+void FtmsLoadGenerator::onResponse(Client *client, int id, bool success, const QByteArray &data) {
+    if (stoppedNs >= 0)
+        return;
+    int i = 0;
+    while (i < client->pending.size() && client->pending.at(i).id != id)
+        i++;
+    if (i == client->pending.size()) {
+        totals.unexpected++;
+        return;
+    }
+    // every write before this one should have been answered already
+    if (i > 0)
+        totals.reordered++;
+    Pending p = client->pending.takeAt(i);
+    totals.responses++;
+    latencies.append((clock.nsecsElapsed() - p.sentNs) / 1e6);
+    if (!success || data.size() < 3 || (quint8)data.at(0) != FTMS_RESPONSE_CODE || (quint8)data.at(1) != p.opcode ||
+        (quint8)data.at(2) != FTMS_SUCCESS)
+        totals.errors++;
+}
+
+FtmsLoadGenerator::Report FtmsLoadGenerator::report() const {
+    Report r = totals;
+    r.seconds = (stoppedNs >= 0 ? stoppedNs : clock.nsecsElapsed()) / 1e9;
+    r.clients = clients.size();
+    foreach (Client *client, clients)
+        if (client->failed)
+            r.failedClients++;
+    if (!latencies.isEmpty()) {
+        QVector<double> sorted = latencies;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0;
+        foreach (double l, sorted)
+            sum += l;
+        int n = sorted.size();
+        r.latencyAvgMs = sum / n;
+        r.latencyP50Ms = sorted.at(qMin(n - 1, n * 50 / 100));
+        r.latencyP95Ms = sorted.at(qMin(n - 1, n * 95 / 100));
+        r.latencyP99Ms = sorted.at(qMin(n - 1, n * 99 / 100));
+        r.latencyMaxMs = sorted.last();
+    }
+    return r;
+}
+
+QByteArray FtmsLoadGenerator::randomCommand(quint32 &seed, bool treadmill) {
+    auto next = [&seed](int max) {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 16) % max);
+    };
+    QByteArray command;
+    int kind = next(10);
+    if (kind == 0) {
+        command.append((char)FTMS_REQUEST_CONTROL);
+    } else if (treadmill) {
+        qint16 value;
+        if (kind < 5) {
+            command.append((char)FTMS_SET_TARGET_SPEED);
+            value = 300 + next(1300); // 0.01 km/h
+        } else {
+            command.append((char)FTMS_SET_TARGET_INCLINATION);
+            value = next(181) - 30; // 0.1 %
+        }
+        command.append((char)(value & 0xFF)).append((char)(value >> 8));
+    } else if (kind < 4) {
+        qint16 watts = 50 + next(401);
+        command.append((char)FTMS_SET_TARGET_POWER);
+        command.append((char)(watts & 0xFF)).append((char)(watts >> 8));
+    } else if (kind < 8) {
+        qint16 grade = next(2501) - 1000; // 0.01 %
+        command.append((char)FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS);
+        command.append(2, 0); // wind speed
+        command.append((char)(grade & 0xFF)).append((char)(grade >> 8));
+        command.append((char)40); // crr 0.004
+        command.append((char)51); // cw 0.51
+    } else {
+        // the processor reads the level as a signed byte, 0.1 a step
+        command.append((char)FTMS_SET_TARGET_RESISTANCE_LEVEL);
+        command.append((char)(10 * (1 + next(12))));
+    }
+    return command;
+}
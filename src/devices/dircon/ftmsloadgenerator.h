@@ -0,0 +1,223 @@
+#ifndef FTMSLOADGENERATOR_H
+#define FTMSLOADGENERATOR_H
+
+#include "characteristics/characteristicnotifier.h"
+#include "characteristics/characteristicwriteprocessor.h"
+#include "devices/dircon/dirconpacket.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * @brief The way a load generator client talks to a virtual device: writes to a characteristic, answers to the
+ * writes and notifications. Every write gets an id, and its answer comes back with the same id.
+ */
+class FtmsLoadTransport : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit FtmsLoadTransport(QObject *parent = nullptr) : QObject(parent) {}
+
+    /**
+     * @brief open Connects and subscribes to the notifications: ready() when done.
+     */
+    virtual void open() = 0;
+    virtual void close() = 0;
+
+    /**
+     * @brief write Writes data to the characteristic uuid.
+     * @return the id of the write, -1 if it couldn't be sent
+     */
+    virtual int write(quint16 uuid, const QByteArray &data) = 0;
+
+    /**
+     * @brief maxPending The writes that can wait for an answer at the same time without their ids being ambiguous.
+     */
+    virtual int maxPending() const { return 128; }
+
+  signals:
+    void ready();
+    void failed(const QString &error);
+    void response(int id, bool success, const QByteArray &data);
+    void notification(quint16 uuid, const QByteArray &data);
+};
+
+/**
+ * @brief A DirCon client over TCP: discovers the services and their characteristics, enables the notifications
+ * of all of them and pipelines the writes, matching the answers by the sequence number of the packets.
+ */
+class DirconLoadTransport : public FtmsLoadTransport {
+    Q_OBJECT
+
+  public:
+    explicit DirconLoadTransport(const QString &host, quint16 port, QObject *parent = nullptr);
+    void open() override;
+    void close() override;
+    int write(quint16 uuid, const QByteArray &data) override;
+
+    // the sequence number is a byte, and the server takes a repeated one for an answer
+    int maxPending() const override { return 64; }
+
+    /**
+     * @brief characteristics The characteristics found on the server, with their DPKT_CHAR_PROP_FLAG_* flags.
+     */
+    const QHash<quint16, quint8> &characteristics() const { return chars; }
+
+  private slots:
+    void connected();
+    void dataAvailable();
+    void socketError();
+
+  private:
+    void send(DirconPacket &pkt);
+    void discoverNext();
+    void handle(const DirconPacket &pkt);
+    QString host;
+    quint16 port;
+    QTcpSocket socket;
+    QByteArray buffer;
+    quint8 seq = 0;
+    bool isReady = false;
+    QList<quint16> services;
+    QList<quint16> toEnable;
+    QHash<quint16, quint8> chars;
+};
+
+/**
+ * @brief A transport straight to the write processor and the notifiers of a virtual device, the same ones the
+ * bluetooth GATT server and DirCon use, without a radio or a socket in between. The notifiers are polled every
+ * period like the timers of the virtual devices do.
+ */
+class DirectLoadTransport : public FtmsLoadTransport {
+    Q_OBJECT
+
+  public:
+    DirectLoadTransport(CharacteristicWriteProcessor *writeProcessor, const QList<CharacteristicNotifier *> &notifiers,
+                        int periodMs = 1000, QObject *parent = nullptr);
+    void open() override;
+    void close() override;
+    int write(quint16 uuid, const QByteArray &data) override;
+
+  private slots:
+    void notifyAll();
+
+  private:
+    CharacteristicWriteProcessor *writeProcessor;
+    QList<CharacteristicNotifier *> notifiers;
+    QTimer timer;
+    int nextId = 0;
+};
+
+/**
+ * @brief Stress test of the FTMS control point of the virtual devices: several clients at the same time, each
+ * writing random commands to 0x2AD9 at a steady rate (request control, target power, simulation parameters and
+ * resistance for a bike, speed and inclination for a treadmill) while receiving the notifications.
+ *
+ * The report has the notifications per second of every characteristic, the latency of the answers to the writes,
+ * the writes never answered in time (dropped), the ones answered before an older one (reordered) and the ones
+ * answered with an error.
+ */
+class FtmsLoadGenerator : public QObject {
+    Q_OBJECT
+
+  public:
+    struct Config {
+        double rate = 20;    // writes per second of every client
+        int timeoutMs = 2000; // a write not answered by then is dropped
+        quint32 seed = 1;
+        bool treadmill = false;
+    };
+
+    struct Report {
+        double seconds = 0;
+        int clients = 0;
+        int failedClients = 0;
+        quint64 writes = 0;
+        quint64 responses = 0;
+        quint64 errors = 0;     // answered, but not with success
+        quint64 dropped = 0;    // not answered within the timeout
+        quint64 reordered = 0;  // answered before a write sent earlier
+        quint64 unexpected = 0; // an answer to no pending write, or a late one
+        quint64 skipped = 0;    // not sent, too many writes were pending
+        quint64 notifications = 0;
+        QHash<quint16, quint64> notificationsByUuid;
+        double latencyAvgMs = 0;
+        double latencyP50Ms = 0;
+        double latencyP95Ms = 0;
+        double latencyP99Ms = 0;
+        double latencyMaxMs = 0;
+
+        double notificationRate() const { return seconds > 0 ? notifications / seconds : 0; }
+        double writeRate() const { return seconds > 0 ? writes / seconds : 0; }
+        QString toString() const;
+    };
+
+    explicit FtmsLoadGenerator(const Config &config, QObject *parent = nullptr);
+
+    /**
+     * @brief addClient Adds a client on transport, taking its ownership. Before start().
+     */
+    void addClient(FtmsLoadTransport *transport);
+
+    /**
+     * @brief start Opens all the clients: every client writes as soon as it's ready.
+     */
+    void start();
+
+    /**
+     * @brief stop Stops writing, counting the writes still pending as dropped, and closes the clients.
+     */
+    void stop();
+
+    /**
+     * @brief run start(), the event loop for ms, then stop().
+     */
+    Report run(int ms);
+
+    Report report() const;
+
+    /**
+     * @brief randomCommand A random FTMS control point command, valid for a bike or a treadmill.
+     */
+    static QByteArray randomCommand(quint32 &seed, bool treadmill);
+
+  signals:
+    void finished();
+
+  private slots:
+    void tick();
+
+  private:
+    struct Pending {
+        int id;
+        quint8 opcode;
+        qint64 sentNs;
+    };
+
+    struct Client {
+        FtmsLoadTransport *transport = nullptr;
+        bool ready = false;
+        bool failed = false;
+        quint64 sent = 0;
+        qint64 readyNs = 0;
+        QList<Pending> pending; // in the order they were sent
+    };
+
+    void onResponse(Client *client, int id, bool success, const QByteArray &data);
+    void expire(Client *client, qint64 now);
+    Config config;
+    quint32 seed;
+    QList<Client *> clients;
+    QTimer timer;
+    QElapsedTimer clock;
+    qint64 stoppedNs = -1;
+    QVector<double> latencies; // ms
+    Report totals;
+};
+
+#endif // FTMSLOADGENERATOR_H
@@ -17,7 +17,7 @@ domyosbike::domyosbike(bool noWriteResistance, bool noHeartService, bool testRes
                        double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
 
     this->testResistance = testResistance;
     this->noWriteResistance = noWriteResistance;
@@ -26,7 +26,7 @@ domyosbike::domyosbike(bool noWriteResistance, bool noHeartService, bool testRes
     this->bikeResistanceOffset = bikeResistanceOffset;
 
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &domyosbike::update);
+    connect(refresh, &PollTimer::timeout, this, &domyosbike::update);
     refresh->start(300ms);
 }
 
@@ -283,6 +283,7 @@ void domyosbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void domyosbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -60,7 +60,7 @@ class domyosbike : public bike {
     uint16_t watts() override;
 
     const resistance_t max_resistance = 15;
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t firstVirtual = 0;
     uint8_t firstStateChanged = 0;
 
@@ -18,7 +18,7 @@ domyoselliptical::domyoselliptical(bool noWriteResistance, bool noHeartService,
                                    int8_t bikeResistanceOffset, double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
 
     this->testResistance = testResistance;
     this->noWriteResistance = noWriteResistance;
@@ -27,7 +27,7 @@ domyoselliptical::domyoselliptical(bool noWriteResistance, bool noHeartService,
     this->bikeResistanceOffset = bikeResistanceOffset;
 
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &domyoselliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &domyoselliptical::update);
     refresh->start(300ms);
 }
 
@@ -265,6 +265,7 @@ void domyoselliptical::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void domyoselliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -275,6 +276,7 @@ void domyoselliptical::characteristicChanged(const QLowEnergyCharacteristic &cha
 
     lastPacket = newValue;
     if (newValue.length() != 26) {
+        notificationParseError(characteristic);
         return;
     }
 
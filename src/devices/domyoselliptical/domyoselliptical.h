@@ -52,7 +52,7 @@ class domyoselliptical : public elliptical {
     void startDiscover();
     uint16_t watts();
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t firstVirtual = 0;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
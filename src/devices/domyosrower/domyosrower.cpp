@@ -20,7 +20,7 @@ domyosrower::domyosrower(bool noWriteResistance, bool noHeartService, bool testR
                          double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
 
     this->testResistance = testResistance;
     this->noWriteResistance = noWriteResistance;
@@ -29,7 +29,7 @@ domyosrower::domyosrower(bool noWriteResistance, bool noHeartService, bool testR
     this->bikeResistanceOffset = bikeResistanceOffset;
 
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &domyosrower::update);
+    connect(refresh, &PollTimer::timeout, this, &domyosrower::update);
     refresh->start(300ms);
 }
 
@@ -298,6 +298,7 @@ void domyosrower::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void domyosrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -310,6 +311,7 @@ void domyosrower::characteristicChanged(const QLowEnergyCharacteristic &characte
     lastPacket = newValue;
     if(!ftmsRower) {
         if (newValue.length() != 26) {
+            notificationParseError(characteristic);
             return;
         }
 
@@ -55,7 +55,7 @@ class domyosrower : public rower {
     void startDiscover();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t firstVirtual = 0;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
@@ -69,9 +69,9 @@ domyostreadmill::domyostreadmill(uint32_t pollDeviceTime, bool noConsole, bool n
         lastInclination = forceInitInclination;
     }
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &domyostreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &domyostreadmill::update);
     refresh->start(pollDeviceTime);
 }
 
@@ -401,6 +401,7 @@ void domyostreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void domyostreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                             const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
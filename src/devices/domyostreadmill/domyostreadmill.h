@@ -66,7 +66,7 @@ class domyostreadmill : public treadmill {
     bool firstCharacteristicChanged = true;
     QDateTime lastInclinationChanged = QDateTime::currentDateTime();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
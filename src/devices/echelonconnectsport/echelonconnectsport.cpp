@@ -25,13 +25,13 @@ echelonconnectsport::echelonconnectsport(bool noWriteResistance, bool noHeartSer
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &echelonconnectsport::update);
+    connect(refresh, &PollTimer::timeout, this, &echelonconnectsport::update);
     refresh->start(200ms);
 }
 
@@ -201,6 +201,7 @@ double echelonconnectsport::bikeResistanceToPeloton(double resistance) {
 
 void echelonconnectsport::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                 const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -243,6 +244,7 @@ void echelonconnectsport::characteristicChanged(const QLowEnergyCharacteristic &
     }
 
     if (newValue.length() != 13) {
+        notificationParseError(characteristic);
         return;
     }
 
@@ -58,7 +58,7 @@ class echelonconnectsport : public bike {
     void sendPoll();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -26,13 +26,13 @@ echelonrower::echelonrower(bool noWriteResistance, bool noHeartService, int8_t b
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
     speedRaw.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &echelonrower::update);
+    connect(refresh, &PollTimer::timeout, this, &echelonrower::update);
     refresh->start(200ms);
 }
 
@@ -194,6 +194,7 @@ double echelonrower::bikeResistanceToPeloton(double resistance) {
 }
 
 void echelonrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newvalue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -55,7 +55,7 @@ class echelonrower : public rower {
     void sendPoll();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -28,9 +28,9 @@ echelonstride::echelonstride(uint32_t pollDeviceTime, bool noConsole, bool noHea
         lastInclination = forceInitInclination;
     }
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &echelonstride::update);
+    connect(refresh, &PollTimer::timeout, this, &echelonstride::update);
     refresh->start(pollDeviceTime);
 }
 
@@ -247,6 +247,7 @@ void echelonstride::serviceDiscovered(const QBluetoothUuid &gatt) {
 double echelonstride::minStepInclination() { return 1.0; }
 
 void echelonstride::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
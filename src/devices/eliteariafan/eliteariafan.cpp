@@ -22,8 +22,8 @@ eliteariafan::eliteariafan(bluetoothdevice *parentDevice) {
     this->parentDevice = parentDevice;
 
 #ifndef Q_OS_IOS
-    refresh = new QTimer(this);
-    connect(refresh, &QTimer::timeout, this, &eliteariafan::update);
+    refresh = new PollTimer(this, PollTimer::Notified);
+    connect(refresh, &PollTimer::timeout, this, &eliteariafan::update);
     refresh->start(1000ms);
 #endif
 }
@@ -56,6 +56,7 @@ void eliteariafan::disconnectBluetooth() {
 
 void eliteariafan::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     Q_UNUSED(characteristic);
     emit packetReceived();
 
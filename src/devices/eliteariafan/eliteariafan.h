@@ -55,7 +55,7 @@ class eliteariafan : public bluetoothdevice {
     bool initDone = false;
     bool initRequest = false;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
 #ifdef Q_OS_IOS
     lockscreen* iOS_EliteAriaFan = nullptr;
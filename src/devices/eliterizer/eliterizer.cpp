@@ -18,11 +18,11 @@ using namespace std::chrono_literals;
 eliterizer::eliterizer(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &eliterizer::update);
+    connect(refresh, &PollTimer::timeout, this, &eliterizer::update);
     refresh->start(200ms);
 }
 
@@ -101,6 +101,7 @@ void eliterizer::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void eliterizer::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
 
     emit debug(QStringLiteral(" << ") + characteristic.uuid().toString() + QStringLiteral(" ") + newValue.toHex(' '));
 
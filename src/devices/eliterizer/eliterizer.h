@@ -48,7 +48,7 @@ class eliterizer : public bike {
     void startDiscover();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -17,11 +17,11 @@ using namespace std::chrono_literals;
 elitesterzosmart::elitesterzosmart(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &elitesterzosmart::update);
+    connect(refresh, &PollTimer::timeout, this, &elitesterzosmart::update);
     refresh->start(200ms);
 }
 
@@ -86,6 +86,7 @@ void elitesterzosmart::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void elitesterzosmart::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
 
     Q_UNUSED(characteristic);
 
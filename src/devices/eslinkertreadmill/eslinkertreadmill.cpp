@@ -82,9 +82,9 @@ eslinkertreadmill::eslinkertreadmill(uint32_t pollDeviceTime, bool noConsole, bo
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &eslinkertreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &eslinkertreadmill::update);
     refresh->start(500ms);
 }
 
@@ -336,6 +336,7 @@ void eslinkertreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void eslinkertreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                               const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
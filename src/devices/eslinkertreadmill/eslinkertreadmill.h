@@ -75,7 +75,7 @@ class eslinkertreadmill : public treadmill {
     } TYPE;
     volatile TYPE treadmill_type = RHYTHM_FUN;
 
-    QTimer *refresh;
+    PollTimer *refresh;
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
     QLowEnergyCharacteristic gattNotifyCharacteristic;
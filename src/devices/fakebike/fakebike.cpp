@@ -19,12 +19,12 @@ using namespace std::chrono_literals;
 fakebike::fakebike(bool noWriteResistance, bool noHeartService, bool noVirtualDevice) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->noVirtualDevice = noVirtualDevice;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &fakebike::update);
+    connect(refresh, &PollTimer::timeout, this, &fakebike::update);
     refresh->start(200ms);
 }
 
@@ -140,7 +140,6 @@ void fakebike::update() {
     }
 
     if (Heart.value()) {
-        static double lastKcal = 0;
         if (KCal.value() < 0) // if the user pressed stop, the KCAL resets the accumulator
             lastKcal = abs(KCal.value());
         KCal = metric::calculateKCalfromHR(Heart.average(), elapsed.value()) + lastKcal;
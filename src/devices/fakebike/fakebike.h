@@ -46,7 +46,7 @@ class fakebike : public bike {
     double minGears() override;
     
   private:
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
@@ -63,6 +63,8 @@ class fakebike : public bike {
 
     uint16_t oldLastCrankEventTime = 0;
     uint16_t oldCrankRevs = 0;    
+    // kcal before the last stop, per bike: a gym runs many of them
+    double lastKcal = 0;
 
 #ifdef Q_OS_IOS
     lockscreen *h = 0;
@@ -39,7 +39,7 @@ class fakeelliptical : public elliptical {
     bool connected() override;
 
   private:
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
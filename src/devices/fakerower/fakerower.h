@@ -39,7 +39,7 @@ class fakerower : public rower {
     bool connected() override;
 
   private:
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
@@ -43,7 +43,7 @@ class faketreadmill : public treadmill {
     double minStepInclination() override { return 0.1; }
 
   private:
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
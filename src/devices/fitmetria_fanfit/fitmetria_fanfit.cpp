@@ -36,6 +36,7 @@ void fitmetria_fanfit::disconnectBluetooth() {
 
 void fitmetria_fanfit::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     emit packetReceived();
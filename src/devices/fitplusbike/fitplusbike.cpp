@@ -32,13 +32,13 @@ fitplusbike::fitplusbike(bool noWriteResistance, bool noHeartService, int8_t bik
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &fitplusbike::update);
+    connect(refresh, &PollTimer::timeout, this, &fitplusbike::update);
     refresh->start(200ms);
 }
 
@@ -402,6 +402,7 @@ void fitplusbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void fitplusbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -661,6 +662,7 @@ void fitplusbike::characteristicChanged(const QLowEnergyCharacteristic &characte
     } else {
 
         if (newValue.length() != 14) {
+            notificationParseError(characteristic);
             return;
         }
 
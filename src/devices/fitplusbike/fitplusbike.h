@@ -52,7 +52,7 @@ class fitplusbike : public bike {
     uint16_t watts() override;
     uint16_t wattsFromResistance(double resistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyService *gattCommunicationChannelServiceFTMS = nullptr;
@@ -34,12 +34,12 @@ fitshowtreadmill::fitshowtreadmill(uint32_t pollDeviceTime, bool noConsole, bool
     h = new lockscreen();
 #endif
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
     QSettings settings;
     anyrun = settings.value(QZSettings::fitshow_anyrun, QZSettings::default_fitshow_anyrun).toBool();
     truetimer = settings.value(QZSettings::fitshow_truetimer, QZSettings::default_fitshow_truetimer).toBool();
-    connect(refresh, &QTimer::timeout, this, &fitshowtreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &fitshowtreadmill::update);
     refresh->start(pollDeviceTime);
 }
 
@@ -317,6 +317,7 @@ void fitshowtreadmill::sendSportData() {
 
 void fitshowtreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
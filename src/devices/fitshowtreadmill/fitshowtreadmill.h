@@ -138,7 +138,7 @@ class fitshowtreadmill : public treadmill {
     QStringList debugMsgs;
     QByteArray bufferWrite;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyService *gattCommunicationRSCService = nullptr;
@@ -17,11 +17,11 @@ using namespace std::chrono_literals;
 flywheelbike::flywheelbike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &flywheelbike::update);
+    connect(refresh, &PollTimer::timeout, this, &flywheelbike::update);
     refresh->start(200ms);
 }
 
@@ -240,6 +240,7 @@ void flywheelbike::updateStats() {
 }
 
 void flywheelbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     static uint8_t zero_fix_filter = 0;
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
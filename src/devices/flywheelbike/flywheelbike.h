@@ -138,7 +138,7 @@ class flywheelbike : public bike {
     uint16_t watts() override;
     void updateStats();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -35,9 +35,9 @@ focustreadmill::focustreadmill(uint32_t pollDeviceTime, bool noConsole, bool noH
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &focustreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &focustreadmill::update);
     refresh->start(500ms);
 }
 
@@ -190,6 +190,7 @@ void focustreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void focustreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                             const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
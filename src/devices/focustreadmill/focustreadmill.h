@@ -59,7 +59,7 @@ class focustreadmill : public treadmill {
     bool firstCharacteristicChanged = true;
     bool searchStopped = false;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
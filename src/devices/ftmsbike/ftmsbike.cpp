@@ -28,22 +28,36 @@ ftmsbike::ftmsbike(bool noWriteResistance, bool noHeartService, int8_t bikeResis
     QSettings settings;
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &ftmsbike::update);
+    connect(refresh, &PollTimer::timeout, this, &ftmsbike::update);
     refresh->start(settings.value(QZSettings::poll_device_time, QZSettings::default_poll_device_time).toInt());
     wheelCircumference::GearTable g;
     g.printTable();
 }
 
+// setpoint commands: when the machine is slower than the app, only the latest queued target is worth sending
+static quint32 ftmsCoalesceKey(const uint8_t *data, uint8_t data_len) {
+    if (!data_len)
+        return 0;
+    switch (data[0]) {
+    case FTMS_SET_TARGET_SPEED:
+    case FTMS_SET_TARGET_INCLINATION:
+    case FTMS_SET_TARGET_RESISTANCE_LEVEL:
+    case FTMS_SET_TARGET_POWER:
+    case FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS:
+        return data[0];
+    default:
+        return 0;
+    }
+}
+
 void ftmsbike::writeCharacteristicZwiftPlay(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log,
                                    bool wait_for_response) {
-    QEventLoop loop;
-    QTimer timeout;
     QSettings settings;
     bool gears_zwift_ratio = settings.value(QZSettings::gears_zwift_ratio, QZSettings::default_gears_zwift_ratio).toBool();
 
@@ -52,37 +66,24 @@ void ftmsbike::writeCharacteristicZwiftPlay(uint8_t *data, uint8_t data_len, con
         return;
     }
 
-    if (wait_for_response) {
-        connect(zwiftPlayService, &QLowEnergyService::characteristicChanged, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    } else {
-        connect(zwiftPlayService, &QLowEnergyService::characteristicWritten, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    }
-
-    if (writeBuffer) {
-        delete writeBuffer;
-    }
-    writeBuffer = new QByteArray((const char *)data, data_len);
-
+    BleWriteQueue::Request request;
+    request.service = zwiftPlayService;
+    request.characteristic = zwiftPlayWriteChar;
+    request.data = QByteArray((const char *)data, data_len);
     if (zwiftPlayWriteChar.properties() & QLowEnergyCharacteristic::WriteNoResponse) {
-        zwiftPlayService->writeCharacteristic(zwiftPlayWriteChar, *writeBuffer,
-                                             QLowEnergyService::WriteWithoutResponse);
-    } else {
-        zwiftPlayService->writeCharacteristic(zwiftPlayWriteChar, *writeBuffer);
+        request.mode = QLowEnergyService::WriteWithoutResponse;
     }
+    // the handshake of the Zwift Play answers on another characteristic
+    request.response = wait_for_response ? BleWriteQueue::AnyNotification : BleWriteQueue::NoResponse;
+    writeQueue()->enqueue(request);
 
     if (!disable_log) {
-        emit debug(QStringLiteral(" >> ") + writeBuffer->toHex(' ') + QStringLiteral(" // ") + info);
+        emit debug(QStringLiteral(" >> ") + request.data.toHex(' ') + QStringLiteral(" // ") + info);
     }
-
-    loop.exec();
 }
 
 bool ftmsbike::writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log,
                                    bool wait_for_response) {
-    QEventLoop loop;
-    QTimer timeout;
     QSettings settings;
     bool gears_zwift_ratio = settings.value(QZSettings::gears_zwift_ratio, QZSettings::default_gears_zwift_ratio).toBool();
 
@@ -96,32 +97,21 @@ bool ftmsbike::writeCharacteristic(uint8_t *data, uint8_t data_len, const QStrin
         return false;
     }
 
-    if (wait_for_response) {
-        connect(gattFTMSService, &QLowEnergyService::characteristicChanged, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    } else {
-        connect(gattFTMSService, &QLowEnergyService::characteristicWritten, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    }
-
-    if (writeBuffer) {
-        delete writeBuffer;
-    }
-    writeBuffer = new QByteArray((const char *)data, data_len);
-
+    BleWriteQueue::Request request;
+    request.service = gattFTMSService;
+    request.characteristic = gattWriteCharControlPointId;
+    request.data = QByteArray((const char *)data, data_len);
     if (gattWriteCharControlPointId.properties() & QLowEnergyCharacteristic::WriteNoResponse && !DOMYOS) {
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer,
-                                             QLowEnergyService::WriteWithoutResponse);
-    } else {
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
+        request.mode = QLowEnergyService::WriteWithoutResponse;
     }
+    request.response = wait_for_response ? BleWriteQueue::ControlPointResponse : BleWriteQueue::NoResponse;
+    request.coalesceKey = ftmsCoalesceKey(data, data_len);
+    writeQueue()->enqueue(request);
 
     if (!disable_log) {
-        emit debug(QStringLiteral(" >> ") + writeBuffer->toHex(' ') + QStringLiteral(" // ") + info);
+        emit debug(QStringLiteral(" >> ") + request.data.toHex(' ') + QStringLiteral(" // ") + info);
     }
 
-    loop.exec();
-
     return true;
 }
 
@@ -411,6 +401,7 @@ void ftmsbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -437,7 +428,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         if(newValue.length() > 0) {
             uint8_t b = (uint8_t)newValue.at(0);
             if(b != battery_level)
-                if(homeform::singleton())
+                if(homeform::singleton() && !isGymStation())
                     homeform::singleton()->setToastRequested(bluetoothDevice.name() + QStringLiteral(" Battery Level ") + QString::number(b) + " %");
             battery_level = b;
         }
@@ -993,7 +984,7 @@ void ftmsbike::stateChanged(QLowEnergyService::ServiceState state) {
 
     if(gattFTMSService == nullptr && DOMYOS) {
         settings.setValue(QZSettings::domyosbike_notfmts, true);
-        if(homeform::singleton())
+        if(homeform::singleton() && !isGymStation())
             homeform::singleton()->setToastRequested("Domyos bike presents itself like a FTMS but it's not. Restart QZ to apply the fix, thanks.");
     }
 
@@ -1003,7 +994,7 @@ void ftmsbike::stateChanged(QLowEnergyService::ServiceState state) {
     }
 
     // ******************************************* virtual bike init *************************************
-    if (!firstStateChanged && !this->hasVirtualDevice()
+    if (!firstStateChanged && !this->hasVirtualDevice() && !this->isGymStation()
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
         && !h
@@ -91,7 +91,7 @@ class ftmsbike : public bike {
     void forcePower(int16_t requestPower);
     uint16_t wattsFromResistance(double resistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
@@ -21,11 +21,11 @@ using namespace std::chrono_literals;
 ftmsrower::ftmsrower(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &ftmsrower::update);
+    connect(refresh, &PollTimer::timeout, this, &ftmsrower::update);
     refresh->start(200ms);
 }
 
@@ -144,6 +144,7 @@ void ftmsrower::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void ftmsrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
 
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
@@ -47,7 +47,7 @@ class ftmsrower : public rower {
     uint16_t watts() override;
     void forceResistance(resistance_t requestResistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
@@ -48,7 +48,7 @@ class horizongr7bike : public bike {
     uint16_t watts() override;
     void forceResistance(resistance_t requestResistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
@@ -29,11 +29,11 @@ horizontreadmill::horizontreadmill(bool noWriteResistance, bool noHeartService)
 
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &horizontreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &horizontreadmill::update);
     refresh->start(200ms);
 }
 
@@ -1414,6 +1414,7 @@ void horizontreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     double heart = 0; // NOTE : Should be initialized with a value to shut clang-analyzer's
                       // UndefinedBinaryOperatorResult
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
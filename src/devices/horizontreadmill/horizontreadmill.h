@@ -54,7 +54,7 @@ class horizontreadmill : public treadmill {
     void startDiscover();
     void btinit();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
@@ -13,9 +13,9 @@ using namespace std::chrono_literals;
 iconceptbike::iconceptbike() {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &iconceptbike::update);
+    connect(refresh, &PollTimer::timeout, this, &iconceptbike::update);
     refresh->start(1s);
 }
 
@@ -50,7 +50,7 @@ class iconceptbike : public bike {
     QBluetoothServiceInfo serialPortService;
     QBluetoothSocket *socket = nullptr;
 
-    QTimer *refresh;
+    PollTimer *refresh;
     bool initDone = false;
     uint8_t firstStateChanged = 0;
     bool i_Nexor = false;
@@ -17,9 +17,9 @@ iconceptelliptical::iconceptelliptical(bool noWriteResistance, bool noHeartServi
     this->bikeResistanceOffset = bikeResistanceOffset;
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &iconceptelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &iconceptelliptical::update);
     refresh->start(1s);
 }
 
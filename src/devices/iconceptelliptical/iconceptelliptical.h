@@ -59,7 +59,7 @@ class iconceptelliptical : public elliptical {
     QBluetoothServiceInfo serialPortService;
     QBluetoothSocket *socket = nullptr;
 
-    QTimer *refresh;
+    PollTimer *refresh;
     bool initDone = false;
     uint8_t firstStateChanged = 0;
 
@@ -0,0 +1,373 @@
+#include "ifitadbsession.h"
+
+#include <QDebug>
+#include <string.h>
+
+namespace {
+
+const char changedPrefix[] = "Changed ";
+const char heartRatePrefix[] = "HeartRateDataUpdate";
+const char commandMarker[] = "__qz_adb_done__";
+
+// the exit code reported for a command dropped from the queue
+const int droppedExitCode = -2;
+
+// indexed by IfitLogcatScanner::Field, the keys following "Changed "
+const char *const changedKeys[] = {"KPH", "Grade", "Watts", "RPM", "Resistance", "CurrentGear"};
+
+int indexOf(const char *s, int n, const char *needle, int m) {
+    const char *end = s + n - m;
+    for (const char *p = s; p <= end; p++) {
+        p = (const char *)memchr(p, needle[0], end - p + 1);
+        if (!p)
+            return -1;
+        if (!memcmp(p, needle, m))
+            return p - s;
+    }
+    return -1;
+}
+
+bool startsWith(const char *s, int n, const char *prefix) {
+    int m = (int)strlen(prefix);
+    return n >= m && !memcmp(s, prefix, m);
+}
+
+void killProcess(QProcess *&process, QObject *owner) {
+    if (!process)
+        return;
+    process->disconnect(owner);
+    process->kill();
+    process->waitForFinished(1000);
+    process->deleteLater();
+    process = nullptr;
+}
+
+} // namespace
+
+bool IfitLogcatScanner::scanLine(const char *line, int length, Field &field, double &value) {
+    while (length > 0 && (line[length - 1] == '\r' || line[length - 1] == ' '))
+        length--;
+
+    int changed = indexOf(line, length, changedPrefix, sizeof(changedPrefix) - 1);
+    if (changed >= 0) {
+        const char *key = line + changed + sizeof(changedPrefix) - 1;
+        int keyLength = length - (key - line);
+        for (int f = KPH; f <= CurrentGear; f++) {
+            if (!startsWith(key, keyLength, changedKeys[f]))
+                continue;
+            // the value is the last word of the line
+            int start = length;
+            while (start > 0 && line[start - 1] != ' ')
+                start--;
+            bool ok = false;
+            value = QByteArray::fromRawData(line + start, length - start).toDouble(&ok);
+            field = (Field)f;
+            return ok;
+        }
+        return false;
+    }
+
+    if (indexOf(line, length, heartRatePrefix, sizeof(heartRatePrefix) - 1) >= 0) {
+        // the heart rate is the 15th word, words are separated by one or more spaces
+        int word = 0;
+        int i = 0;
+        while (i < length) {
+            while (i < length && line[i] == ' ')
+                i++;
+            int start = i;
+            while (i < length && line[i] != ' ')
+                i++;
+            if (i > start && word++ == 14) {
+                bool ok = false;
+                value = QByteArray::fromRawData(line + start, i - start).toInt(&ok);
+                field = HeartRate;
+                return ok;
+            }
+        }
+    }
+    return false;
+}
+
+void IfitLogcatScanner::scan(const char *line, int length) {
+    Field field;
+    double v;
+    if (scanLine(line, length, field, v)) {
+        values[field] = v;
+        foundMask |= 1u << field;
+    }
+}
+
+void IfitLogcatScanner::feed(const char *data, int size) {
+    const char *p = data;
+    const char *end = data + size;
+
+    while (p < end) {
+        const char *nl = (const char *)memchr(p, '\n', end - p);
+        int length = (nl ? nl : end) - p;
+        if (discarding) {
+            // the rest of a line already dropped
+            discarding = !nl;
+        } else if (partial.size() + length > maxLineLength) {
+            partial.clear();
+            discarding = !nl;
+        } else if (!nl) {
+            partial.append(p, length);
+        } else if (partial.isEmpty()) {
+            scan(p, length);
+        } else {
+            partial.append(p, length);
+            scan(partial.constData(), partial.size());
+            partial.clear();
+        }
+        if (!nl)
+            break;
+        p = nl + 1;
+    }
+}
+
+IfitAdbSession::IfitAdbSession(const QString &address, QObject *parent, const QString &adbProgram)
+    : QObject(parent), address(address), adbProgram(adbProgram) {
+    commandTimer.setSingleShot(true);
+    connect(&commandTimer, &QTimer::timeout, this, &IfitAdbSession::commandTimeout);
+}
+
+IfitAdbSession::~IfitAdbSession() { stop(); }
+
+QString IfitAdbSession::defaultAdbProgram() {
+#ifdef Q_OS_WINDOWS
+    return QStringLiteral("adb/adb.exe");
+#else
+    return QStringLiteral("adb");
+#endif
+}
+
+QStringList IfitAdbSession::arguments(const QString &command) const {
+    QStringList args;
+    // adb names the network devices ip:port, 5555 unless told otherwise
+    if (!address.isEmpty())
+        args << QStringLiteral("-s") << (address.contains(':') ? address : address + QStringLiteral(":5555"));
+    args << command;
+    return args;
+}
+
+void IfitAdbSession::start() {
+    if (!stopping)
+        return;
+    stopping = false;
+
+    if (address.isEmpty()) {
+        startShell();
+        startLogcat();
+        return;
+    }
+
+    // the device is reached over the network: connect once, then every process targets it with -s
+    auto connectProcess = new QProcess(this);
+    connect(connectProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            [this, connectProcess](int exitCode, QProcess::ExitStatus) {
+                emit debug(QStringLiteral("adb << connect ") + QString::number(exitCode) + QStringLiteral(" ") +
+                           QString::fromLocal8Bit(connectProcess->readAll()).trimmed());
+                connectProcess->deleteLater();
+                if (stopping)
+                    return;
+                startShell();
+                startLogcat();
+            });
+    connectProcess->setProcessChannelMode(QProcess::MergedChannels);
+    emit debug(QStringLiteral("adb >> connect ") + address);
+    connectProcess->start(adbProgram, QStringList() << QStringLiteral("connect") << address);
+}
+
+void IfitAdbSession::stop() {
+    stopping = true;
+    commandTimer.stop();
+    killProcess(shell, this);
+    killProcess(logcat, this);
+    inFlight = false;
+}
+
+int IfitAdbSession::runCommand(const QString &command, const QString &kind) {
+    Command c;
+    c.id = nextId++;
+    c.text = command.toLocal8Bit();
+    c.kind = kind;
+
+    if (!kind.isEmpty()) {
+        // only the last position of a slider matters: it's sent when the previous one would have been
+        for (Command &queued : queue) {
+            if (queued.kind != kind)
+                continue;
+            int replaced = queued.id;
+            queued = c;
+            emit debug(QStringLiteral("adb command ") + QString::number(replaced) + QStringLiteral(" replaced by ") +
+                       QString::number(c.id));
+            emit commandFinished(replaced, droppedExitCode, QByteArray());
+            return c.id;
+        }
+    }
+
+    if (queue.size() >= maxQueuedCommands && !queue.isEmpty()) {
+        Command dropped = queue.takeFirst();
+        emit debug(QStringLiteral("adb queue full, command dropped ") + QString::fromLocal8Bit(dropped.text));
+        emit commandFinished(dropped.id, droppedExitCode, QByteArray());
+    }
+    queue.append(c);
+    sendNext();
+    return c.id;
+}
+
+void IfitAdbSession::startShell() {
+    shellBuffer.clear();
+    shell = new QProcess(this);
+    connect(shell, &QProcess::readyReadStandardOutput, this, &IfitAdbSession::shellReadyRead);
+    connect(shell, &QProcess::readyReadStandardError, this,
+            [this]() { emit debug(QStringLiteral("adb shell ERROR << ") + shell->readAllStandardError()); });
+    connect(shell, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            &IfitAdbSession::shellFinished);
+    connect(shell, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart)
+            shellFinished();
+    });
+    emit debug(QStringLiteral("adb >> shell"));
+    shell->start(adbProgram, arguments(QStringLiteral("shell")));
+    sendNext();
+}
+
+void IfitAdbSession::startLogcat() {
+    logcat = new QProcess(this);
+    connect(logcat, &QProcess::readyReadStandardOutput, this, &IfitAdbSession::logcatReadyRead);
+    connect(logcat, &QProcess::readyReadStandardError, this,
+            [this]() { emit debug(QStringLiteral("adbLogCat ERROR << ") + logcat->readAllStandardError()); });
+    connect(logcat, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            &IfitAdbSession::logcatFinished);
+    connect(logcat, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart)
+            logcatFinished();
+    });
+    emit debug(QStringLiteral("adbLogCat >> logcat"));
+    logcat->start(adbProgram, arguments(QStringLiteral("logcat")));
+}
+
+void IfitAdbSession::sendNext() {
+    if (inFlight || queue.isEmpty() || !shell)
+        return;
+
+    current = queue.takeFirst();
+    inFlight = true;
+    commandOutput.clear();
+    emit debug(QStringLiteral("adb >> ") + QString::fromLocal8Bit(current.text));
+
+    // the marker is printed whatever the command does, with its exit code
+    QByteArray line = current.text;
+    line += "; echo ";
+    line += commandMarker;
+    line += QByteArray::number(current.id);
+    line += " $?\n";
+    shell->write(line);
+
+    commandElapsed.start();
+    commandTimer.start(commandTimeoutMs);
+}
+
+void IfitAdbSession::shellReadyRead() {
+    shellBuffer += shell->readAllStandardOutput();
+
+    int from = 0;
+    int nl;
+    while ((nl = shellBuffer.indexOf('\n', from)) >= 0) {
+        const char *line = shellBuffer.constData() + from;
+        int length = nl - from;
+        if (length > 0 && line[length - 1] == '\r')
+            length--;
+        from = nl + 1;
+
+        if (!inFlight)
+            continue;
+        if (!startsWith(line, length, commandMarker)) {
+            commandOutput.append(line, length);
+            commandOutput.append('\n');
+            continue;
+        }
+
+        // "<marker><id> <exit code>"
+        const char *idText = line + sizeof(commandMarker) - 1;
+        int idLength = length - (sizeof(commandMarker) - 1);
+        int space = indexOf(idText, idLength, " ", 1);
+        if (space < 0 || QByteArray::fromRawData(idText, space).toInt() != current.id)
+            continue;
+        int exitCode = QByteArray::fromRawData(idText + space + 1, idLength - space - 1).toInt();
+
+        commandTimer.stop();
+        inFlight = false;
+        emit debug(QStringLiteral("adb << ") + QString::number(current.id) + QStringLiteral(" exit ") +
+                   QString::number(exitCode) + QStringLiteral(" in ") + QString::number(commandElapsed.elapsed()) +
+                   QStringLiteral("ms"));
+        emit commandFinished(current.id, exitCode, commandOutput);
+        commandOutput.clear();
+        sendNext();
+    }
+    shellBuffer.remove(0, from);
+}
+
+void IfitAdbSession::logcatReadyRead() {
+    scanner.feed(logcat->readAllStandardOutput());
+    if (!scanner.foundAny())
+        return;
+
+    bool speedOrGrade = false;
+    if (scanner.found(IfitLogcatScanner::KPH)) {
+        speed = scanner.value(IfitLogcatScanner::KPH);
+        speedOrGrade = true;
+    }
+    if (scanner.found(IfitLogcatScanner::Grade)) {
+        inclination = scanner.value(IfitLogcatScanner::Grade);
+        speedOrGrade = true;
+    }
+    if (speedOrGrade)
+        emit onSpeedInclination(speed, inclination);
+    if (scanner.found(IfitLogcatScanner::Watts))
+        emit onWatt(scanner.value(IfitLogcatScanner::Watts));
+    if (scanner.found(IfitLogcatScanner::RPM))
+        emit onCadence(scanner.value(IfitLogcatScanner::RPM));
+    if (scanner.found(IfitLogcatScanner::HeartRate))
+        emit onHRM((int)scanner.value(IfitLogcatScanner::HeartRate));
+    scanner.clearFound();
+}
+
+void IfitAdbSession::shellFinished() {
+    emit debug(QStringLiteral("adb shell exited"));
+    commandTimer.stop();
+    shell->deleteLater();
+    shell = nullptr;
+    // the command in flight may be what ended the shell: report it as failed instead of sending it again
+    if (inFlight) {
+        inFlight = false;
+        emit commandFinished(current.id, -1, commandOutput);
+    }
+    if (!stopping)
+        QTimer::singleShot(restartDelayMs, this, [this]() {
+            if (!stopping && !shell)
+                startShell();
+        });
+}
+
+void IfitAdbSession::logcatFinished() {
+    emit debug(QStringLiteral("adbLogCat exited"));
+    logcat->deleteLater();
+    logcat = nullptr;
+    if (!stopping)
+        QTimer::singleShot(restartDelayMs, this, [this]() {
+            if (!stopping && !logcat)
+                startLogcat();
+        });
+}
+
+void IfitAdbSession::commandTimeout() {
+    qDebug() << "adb command timeout" << current.text;
+    emit debug(QStringLiteral("adb command timeout ") + QString::fromLocal8Bit(current.text));
+    // the shell is stuck: drop the command, restart the shell and go on with the queue
+    inFlight = false;
+    emit commandFinished(current.id, -1, commandOutput);
+    if (shell)
+        shell->kill();
+}
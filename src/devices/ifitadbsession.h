@@ -0,0 +1,155 @@
+#ifndef IFITADBSESSION_H
+#define IFITADBSESSION_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QTimer>
+
+/**
+ * @brief Incremental scanner of the iFit logcat output.
+ * Complete lines are matched in place in the chunk read from adb, only an unfinished last line is copied
+ * until the rest of it arrives: no QString and no QStringList per line.
+ */
+class IfitLogcatScanner {
+  public:
+    enum Field {
+        KPH,         // "Changed KPH <value>"
+        Grade,       // "Changed Grade <value>"
+        Watts,       // "Changed Watts <value>"
+        RPM,         // "Changed RPM <value>"
+        Resistance,  // "Changed Resistance <value>"
+        CurrentGear, // "Changed CurrentGear <value>"
+        HeartRate,   // "HeartRateDataUpdate": 15th word of the line
+        FIELD_NUM
+    };
+
+    // a logcat line longer than this is garbage: it's dropped up to its end instead of growing the buffer forever
+    static const int maxLineLength = 64 * 1024;
+
+    /**
+     * @brief scanLine Matches one line, without its line terminator, against the known prefixes.
+     * @return true if the line carries one of the fields, with its value
+     */
+    static bool scanLine(const char *line, int length, Field &field, double &value);
+
+    /**
+     * @brief feed Scans a chunk of the logcat stream. The values found are kept until clearFound().
+     */
+    void feed(const char *data, int size);
+    void feed(const QByteArray &chunk) { feed(chunk.constData(), chunk.size()); }
+
+    bool found(Field field) const { return foundMask & (1u << field); }
+    bool foundAny() const { return foundMask != 0; }
+    double value(Field field) const { return values[field]; }
+    void clearFound() { foundMask = 0; }
+
+  private:
+    void scan(const char *line, int length);
+
+    QByteArray partial;
+    bool discarding = false; // dropping a line too long until its end
+    double values[FIELD_NUM] = {0};
+    quint32 foundMask = 0;
+};
+
+/**
+ * @brief Long lived adb channel to an iFit console, shared by the iFit ADB drivers.
+ * One "adb shell" process receives the commands through its standard input, one at a time: each command is
+ * followed by an echo of a marker, so the end of the marker line completes the command without spawning a
+ * process per command. One "adb logcat" process is scanned by IfitLogcatScanner.
+ * Both processes are restarted when they exit.
+ */
+class IfitAdbSession : public QObject {
+
+    Q_OBJECT
+
+  public:
+    explicit IfitAdbSession(const QString &address, QObject *parent = nullptr,
+                            const QString &adbProgram = defaultAdbProgram());
+    ~IfitAdbSession();
+
+    static QString defaultAdbProgram();
+
+    void start();
+    void stop();
+
+    /**
+     * @brief runCommand Queues a shell command, for example "input swipe 75 800 75 700 200".
+     * @param kind commands of the same kind, like the swipes of one slider, are coalesced: a new one takes the place
+     * of the one still queued, which is dropped. Empty for a command that must run anyway.
+     * @return the id reported by commandFinished
+     */
+    int runCommand(const QString &command, const QString &kind = QString());
+
+    /**
+     * @brief pendingCommands Commands queued or in flight.
+     */
+    int pendingCommands() const { return queue.size() + (inFlight ? 1 : 0); }
+    void setCommandTimeout(int ms) { commandTimeoutMs = ms; }
+    void setRestartDelay(int ms) { restartDelayMs = ms; }
+
+    /**
+     * @brief setMaxQueuedCommands Bounds the commands waiting behind the one in flight: when the queue is full
+     * the oldest one is dropped.
+     */
+    void setMaxQueuedCommands(int commands) { maxQueuedCommands = commands; }
+
+  signals:
+    /**
+     * @brief commandFinished The exit code of a command, -1 if it ended the shell or timed out, -2 if it was
+     * dropped before being sent.
+     */
+    void commandFinished(int id, int exitCode, const QByteArray &output);
+    void onSpeedInclination(double speed, double inclination);
+    void onWatt(double watt);
+    void onHRM(int hrm);
+    void onCadence(double cadence);
+    void debug(QString message);
+
+  private slots:
+    void shellReadyRead();
+    void logcatReadyRead();
+    void shellFinished();
+    void logcatFinished();
+    void commandTimeout();
+
+  private:
+    struct Command {
+        int id;
+        QByteArray text;
+        QString kind;
+    };
+
+    void startShell();
+    void startLogcat();
+    void sendNext();
+    QStringList arguments(const QString &command) const;
+
+    QString address;
+    QString adbProgram;
+    QProcess *shell = nullptr;
+    QProcess *logcat = nullptr;
+    bool stopping = true;
+    int restartDelayMs = 1000;
+
+    QList<Command> queue;
+    int maxQueuedCommands = 64;
+    Command current;
+    bool inFlight = false;
+    int nextId = 1;
+    int commandTimeoutMs = 5000;
+    QTimer commandTimer;
+    QElapsedTimer commandElapsed;
+    QByteArray shellBuffer;
+    QByteArray commandOutput;
+
+    IfitLogcatScanner scanner;
+    double speed = 0;
+    double inclination = 0;
+};
+
+#endif // IFITADBSESSION_H
@@ -19,12 +19,12 @@ using namespace std::chrono_literals;
 inspirebike::inspirebike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     t_timeout = new QTimer(this);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     // initDone = false;
-    connect(refresh, &QTimer::timeout, this, &inspirebike::update);
+    connect(refresh, &PollTimer::timeout, this, &inspirebike::update);
     connect(t_timeout, &QTimer::timeout, this, &inspirebike::connection_timeout);
     refresh->start(200ms);
 }
@@ -127,6 +127,7 @@ void inspirebike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void inspirebike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -139,6 +140,7 @@ void inspirebike::characteristicChanged(const QLowEnergyCharacteristic &characte
     lastPacket = newValue;
 
     if (newValue.length() != 8) {
+        notificationParseError(characteristic);
         return;
     }
 
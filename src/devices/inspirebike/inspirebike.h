@@ -48,7 +48,7 @@ class inspirebike : public bike {
     void startDiscover();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
     QTimer *t_timeout;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
@@ -25,13 +25,13 @@ keepbike::keepbike(bool noWriteResistance, bool noHeartService, int8_t bikeResis
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &keepbike::update);
+    connect(refresh, &PollTimer::timeout, this, &keepbike::update);
     refresh->start(300ms);
 }
 
@@ -186,6 +186,7 @@ double keepbike::bikeResistanceToPeloton(double resistance) {
 }
 
 void keepbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -198,6 +199,7 @@ void keepbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
     lastPacket = newValue;
 
     if (newValue.length() != 20) {
+        notificationParseError(characteristic);
         return;
     }
 
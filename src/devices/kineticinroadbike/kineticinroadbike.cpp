@@ -25,13 +25,13 @@ kineticinroadbike::kineticinroadbike(bool noWriteResistance, bool noHeartService
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &kineticinroadbike::update);
+    connect(refresh, &PollTimer::timeout, this, &kineticinroadbike::update);
     refresh->start(200ms);
 }
 
@@ -185,6 +185,7 @@ double kineticinroadbike::bikeResistanceToPeloton(double resistance) {
 
 void kineticinroadbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                               const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     Q_UNUSED(characteristic);
     QSettings settings;
     QString heartRateBeltName =
@@ -58,7 +58,7 @@ class kineticinroadbike : public bike {
     void forceResistance(resistance_t requestResistance);
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -29,9 +29,9 @@ kingsmithr1protreadmill::kingsmithr1protreadmill(uint32_t pollDeviceTime, bool n
         lastInclination = forceInitInclination;
     }
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &kingsmithr1protreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &kingsmithr1protreadmill::update);
     refresh->start(pollDeviceTime);
 }
 
@@ -241,6 +241,7 @@ void kingsmithr1protreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void kingsmithr1protreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                     const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -74,7 +74,7 @@ class kingsmithr1protreadmill : public treadmill {
     bool firstCharacteristicChanged = true;
     metric cadenceRaw;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -34,9 +34,9 @@ kingsmithr2treadmill::kingsmithr2treadmill(uint32_t pollDeviceTime, bool noConso
         lastRunState = UNKNOWN_RUN_STATE;
     }
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &kingsmithr2treadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &kingsmithr2treadmill::update);
     refresh->start(pollDeviceTime);
 }
 
@@ -258,6 +258,7 @@ void kingsmithr2treadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void kingsmithr2treadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                  const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -87,7 +87,7 @@ class kingsmithr2treadmill : public treadmill {
     KINGSMITH_R2_CONTROL_MODE lastControlMode = UNKNOWN_CONTROL_MODE;
     KINGSMITH_R2_RUN_STATE lastRunState = UNKNOWN_RUN_STATE;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -30,11 +30,11 @@ lifefitnesstreadmill::lifefitnesstreadmill(bool noWriteResistance, bool noHeartS
 
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &lifefitnesstreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &lifefitnesstreadmill::update);
     refresh->start(200ms);
 }
 
@@ -264,6 +264,7 @@ void lifefitnesstreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void lifefitnesstreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                  const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     double heart = 0; // NOTE : Should be initialized with a value to shut clang-analyzer's
                       // UndefinedBinaryOperatorResult
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
@@ -56,7 +56,7 @@ class lifefitnesstreadmill : public treadmill {
     void startDiscover();
     void btinit();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
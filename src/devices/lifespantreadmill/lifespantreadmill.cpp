@@ -24,8 +24,8 @@ lifespantreadmill::lifespantreadmill(uint32_t pollDeviceTime, bool noConsole, bo
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
-    connect(refresh, &QTimer::timeout, this, &lifespantreadmill::update);
+    refresh = new PollTimer(this, PollTimer::Polled);
+    connect(refresh, &PollTimer::timeout, this, &lifespantreadmill::update);
     refresh->start(500ms);
 }
 
@@ -209,6 +209,7 @@ void lifespantreadmill::update() {
 
 void lifespantreadmill::characteristicChanged(const QLowEnergyCharacteristic& characteristic,
                                            const QByteArray& newValue) {
+    auto ingress = notificationReceived(characteristic);
     QSettings settings;
     QByteArray value = newValue;
     qDebug() << " << " << value.length() << value.toHex(' ') << (int)currentCommand;
@@ -23,13 +23,13 @@ mcfbike::mcfbike(bool noWriteResistance, bool noHeartService, int8_t bikeResista
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &mcfbike::update);
+    connect(refresh, &PollTimer::timeout, this, &mcfbike::update);
     refresh->start(300ms);
 }
 
@@ -177,6 +177,7 @@ double mcfbike::bikeResistanceToPeloton(double resistance) {
 }
 
 void mcfbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -188,8 +189,10 @@ void mcfbike::characteristicChanged(const QLowEnergyCharacteristic &characterist
 
     lastPacket = newValue;
 
-    if (newValue.length() != 20)
+    if (newValue.length() != 20) {
+        notificationParseError(characteristic);
         return;
+    }
 
     switch ((uint8_t)newValue.at(1)) {
     case 0xe5:
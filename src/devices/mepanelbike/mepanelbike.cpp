@@ -23,13 +23,13 @@ mepanelbike::mepanelbike(bool noWriteResistance, bool noHeartService, int8_t bik
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &mepanelbike::update);
+    connect(refresh, &PollTimer::timeout, this, &mepanelbike::update);
     refresh->start(200ms);
 }
 
@@ -130,6 +130,7 @@ void mepanelbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void mepanelbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -143,8 +144,10 @@ void mepanelbike::characteristicChanged(const QLowEnergyCharacteristic &characte
 
     lastPacket = newValue;
 
-    if (newValue.length() < 3)
+    if (newValue.length() < 3) {
+        notificationParseError(characteristic);
         return;
+    }
 
     QString str;
 
@@ -49,7 +49,7 @@ class mepanelbike : public bike {
     uint16_t watts() override;
     uint8_t getCheckNum(uint8_t i, uint8_t i2);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -18,7 +18,7 @@ nautilusbike::nautilusbike(bool noWriteResistance, bool noHeartService, bool tes
                            int8_t bikeResistanceOffset, double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
 
     this->testResistance = testResistance;
     this->noWriteResistance = noWriteResistance;
@@ -27,7 +27,7 @@ nautilusbike::nautilusbike(bool noWriteResistance, bool noHeartService, bool tes
     this->bikeResistanceOffset = bikeResistanceOffset;
 
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &nautilusbike::update);
+    connect(refresh, &PollTimer::timeout, this, &nautilusbike::update);
     refresh->start(300ms);
 }
 
@@ -132,6 +132,7 @@ void nautilusbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void nautilusbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
 
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
@@ -165,6 +166,7 @@ void nautilusbike::characteristicChanged(const QLowEnergyCharacteristic &charact
     }
 
     if (newValue.length() != 14) {
+        notificationParseError(characteristic);
         return;
     }
 
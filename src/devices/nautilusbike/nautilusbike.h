@@ -50,7 +50,7 @@ class nautilusbike : public bike {
     void startDiscover();
     uint16_t wattsFromResistance(double resistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t firstVirtual = 0;
     uint8_t counterPoll = 0;
 
@@ -19,7 +19,7 @@ nautiluselliptical::nautiluselliptical(bool noWriteResistance, bool noHeartServi
                                        int8_t bikeResistanceOffset, double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
 
     this->testResistance = testResistance;
     this->noWriteResistance = noWriteResistance;
@@ -28,7 +28,7 @@ nautiluselliptical::nautiluselliptical(bool noWriteResistance, bool noHeartServi
     this->bikeResistanceOffset = bikeResistanceOffset;
 
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &nautiluselliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &nautiluselliptical::update);
     refresh->start(300ms);
 }
 
@@ -220,6 +220,7 @@ void nautiluselliptical::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void nautiluselliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
 
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
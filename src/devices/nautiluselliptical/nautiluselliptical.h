@@ -46,7 +46,7 @@ class nautiluselliptical : public elliptical {
                              bool wait_for_response = false);
     void startDiscover();
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t firstVirtual = 0;
     uint8_t counterPoll = 0;
 
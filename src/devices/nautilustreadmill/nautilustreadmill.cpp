@@ -32,9 +32,9 @@ nautilustreadmill::nautilustreadmill(uint32_t pollDeviceTime, bool noConsole, bo
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &nautilustreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &nautilustreadmill::update);
     refresh->start(500ms);
 }
 
@@ -171,6 +171,7 @@ void nautilustreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void nautilustreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                               const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -21,13 +21,13 @@ nordictrackelliptical::nordictrackelliptical(bool noWriteResistance, bool noHear
                                              double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &nordictrackelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &nordictrackelliptical::update);
     refresh->start(200ms);
 }
 
@@ -936,6 +936,7 @@ double nordictrackelliptical::GetResistanceFromPacket(QByteArray packet) {
 
 void nordictrackelliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                   const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
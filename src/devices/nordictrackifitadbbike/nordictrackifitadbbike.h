@@ -19,6 +19,7 @@
 #include <QThread>
 #include <QUdpSocket>
 
+#include "devices/ifitadbsession.h"
 #include "devices/bike.h"
 #include "virtualdevices/virtualbike.h"
 
@@ -26,37 +27,6 @@
 #include "ios/lockscreen.h"
 #endif
 
-class nordictrackifitadbbikeLogcatAdbThread : public QThread {
-    Q_OBJECT
-
-  public:
-    explicit nordictrackifitadbbikeLogcatAdbThread(QString s);    
-    bool runCommand(QString command);
-
-    void run() override;
-
-  signals:
-    void onSpeedInclination(double speed, double inclination);
-    void debug(QString message);
-    void onWatt(double watt);
-    void onHRM(int hrm);
-
-  private:
-    QString adbCommandPending = "";
-    QString runAdbCommand(QString command);
-    double speed = 0;
-    double inclination = 0;
-    double watt = 0;
-    int hrm = 0;
-    QString name;
-    struct adbfile {
-        QDateTime date;
-        QString name;
-    };
-
-    void runAdbTailCommand(QString command);
-};
-
 class nordictrackifitadbbike : public bike {
     Q_OBJECT
   public:
@@ -76,7 +46,7 @@ class nordictrackifitadbbike : public bike {
     uint16_t wattsFromResistance(double inclination, double cadence);
     double bikeResistanceToPeloton(resistance_t resistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
@@ -95,7 +65,7 @@ class nordictrackifitadbbike : public bike {
     QUdpSocket *socket = nullptr;
     QHostAddress lastSender;
 
-    nordictrackifitadbbikeLogcatAdbThread *logcatAdbThread = nullptr;
+    IfitAdbSession *adbSession = nullptr;
 
     QString lastCommand;
 
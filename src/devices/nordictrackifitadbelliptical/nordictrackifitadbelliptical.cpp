@@ -14,100 +14,6 @@
 
 using namespace std::chrono_literals;
 
-nordictrackifitadbellipticalLogcatAdbThread::nordictrackifitadbellipticalLogcatAdbThread(QString s) { Q_UNUSED(s) }
-
-void nordictrackifitadbellipticalLogcatAdbThread::run() {
-    QSettings settings;
-    QString ip = settings.value(QZSettings::tdf_10_ip, QZSettings::default_tdf_10_ip).toString();
-    runAdbCommand("connect " + ip);
-
-    while (1) {
-        runAdbTailCommand("logcat");
-        if(adbCommandPending.length() != 0) {
-            runAdbCommand(adbCommandPending);
-            adbCommandPending = "";
-        }
-        msleep(100);
-    }
-}
-
-QString nordictrackifitadbellipticalLogcatAdbThread::runAdbCommand(QString command) {
-#ifdef Q_OS_WINDOWS
-    QProcess process;
-    emit debug("adb >> " + command);
-    process.start("adb/adb.exe", QStringList(command.split(' ')));
-    process.waitForFinished(-1); // will wait forever until finished
-
-    QString out = process.readAllStandardOutput();
-    QString err = process.readAllStandardError();
-
-    emit debug("adb << OUT " + out);
-    emit debug("adb << ERR" + err);
-#else
-    QString out;
-#endif
-    return out;
-}
-
-bool nordictrackifitadbellipticalLogcatAdbThread::runCommand(QString command) {
-    if(adbCommandPending.length() == 0) {
-        adbCommandPending = command;
-        return true;
-    }
-    return false;
-}
-
-void nordictrackifitadbellipticalLogcatAdbThread::runAdbTailCommand(QString command) {
-#ifdef Q_OS_WINDOWS
-    auto process = new QProcess;
-    QObject::connect(process, &QProcess::readyReadStandardOutput, [process, this]() {
-        QString output = process->readAllStandardOutput();
-        // qDebug() << "adbLogCat STDOUT << " << output;
-        QStringList lines = output.split('\n', Qt::SplitBehaviorFlags::SkipEmptyParts);
-        bool wattFound = false;
-        bool hrmFound = false;
-        foreach (QString line, lines) {
-            if (line.contains("Changed KPH")) {
-                emit debug(line);
-                speed = line.split(' ').last().toDouble();
-            } else if (line.contains("Changed Grade")) {
-                emit debug(line);
-                inclination = line.split(' ').last().toDouble();
-            } else if (line.contains("Changed Watts")) {
-                emit debug(line);
-                watt = line.split(' ').last().toDouble();
-                wattFound = true;
-            } else if (line.contains("HeartRateDataUpdate")) {
-                emit debug(line);
-                QStringList splitted = line.split(' ', Qt::SkipEmptyParts);
-                if (splitted.length() > 14) {
-                    hrm = splitted[14].toInt();
-                    hrmFound = true;
-                }
-            }
-        }
-        emit onSpeedInclination(speed, inclination);
-        if (wattFound)
-            emit onWatt(watt);
-        if (hrmFound)
-            emit onHRM(hrm);
-#ifdef Q_OS_WINDOWS        
-        if(adbCommandPending.length() != 0) {
-            runAdbCommand(adbCommandPending);
-            adbCommandPending = "";
-        }
-#endif                                
-    });
-    QObject::connect(process, &QProcess::readyReadStandardError, [process, this]() {
-        auto output = process->readAllStandardError();
-        emit debug("adbLogCat ERROR << " + output);
-    });
-    emit debug("adbLogCat >> " + command);
-    process->start("adb/adb.exe", QStringList(command.split(' ')));
-    process->waitForFinished(-1);
-#endif
-}
-
 nordictrackifitadbelliptical::nordictrackifitadbelliptical(bool noWriteResistance, bool noHeartService,
                                                int8_t bikeResistanceOffset, double bikeResistanceGain) {
     QSettings settings;
@@ -116,11 +22,11 @@ nordictrackifitadbelliptical::nordictrackifitadbelliptical(bool noWriteResistanc
             .toBool();
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &nordictrackifitadbelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &nordictrackifitadbelliptical::update);
     ip = settings.value(QZSettings::tdf_10_ip, QZSettings::default_tdf_10_ip).toString();
     refresh->start(200ms);
 
@@ -168,14 +74,10 @@ nordictrackifitadbelliptical::nordictrackifitadbelliptical(bool noWriteResistanc
                                                   "(Ljava/lang/String;Landroid/content/Context;)V",
                                                   IP.object<jstring>(), QtAndroid::androidContext().object());
 #elif defined Q_OS_WIN
-        logcatAdbThread = new nordictrackifitadbellipticalLogcatAdbThread("logcatAdbThread");
-        /*connect(logcatAdbThread, &nordictrackifitadbellipticalLogcatAdbThread::onSpeedInclination, this,
-                &nordictrackifitadbelliptical::onSpeedInclination);
-        connect(logcatAdbThread, &nordictrackifitadbellipticalLogcatAdbThread::onWatt, this,
-                &nordictrackifitadbelliptical::onWatt);*/
-        connect(logcatAdbThread, &nordictrackifitadbellipticalLogcatAdbThread::onHRM, this, &nordictrackifitadbelliptical::onHRM);
-        connect(logcatAdbThread, &nordictrackifitadbellipticalLogcatAdbThread::debug, this, &nordictrackifitadbelliptical::debug);
-        logcatAdbThread->start();
+        adbSession = new IfitAdbSession(ip, this);
+        connect(adbSession, &IfitAdbSession::onHRM, this, &nordictrackifitadbelliptical::onHRM);
+        connect(adbSession, &IfitAdbSession::debug, this, &nordictrackifitadbelliptical::debug);
+        adbSession->start();
 #elif defined Q_OS_IOS
 #ifndef IO_UNDER_QT
         h->adb_connect(ip.toStdString().c_str());
@@ -322,8 +224,8 @@ void nordictrackifitadbelliptical::processPendingDatagrams() {
                                                                   "sendCommand", "(Ljava/lang/String;)V",
                                                                   command.object<jstring>());
 #elif defined(Q_OS_WIN)
-                        if (logcatAdbThread)
-                            logcatAdbThread->runCommand("shell " + lastCommand);
+                        if (adbSession)
+                            adbSession->runCommand(lastCommand, QStringLiteral("resistance"));
 #elif defined Q_OS_IOS
 #ifndef IO_UNDER_QT
                         h->adb_sendcommand(lastCommand.toStdString().c_str());
@@ -377,8 +279,8 @@ void nordictrackifitadbelliptical::processPendingDatagrams() {
                                                                   "sendCommand", "(Ljava/lang/String;)V",
                                                                   command.object<jstring>());
 #elif defined(Q_OS_WIN)
-                        if (logcatAdbThread)
-                            logcatAdbThread->runCommand("shell " + lastCommand);
+                        if (adbSession)
+                            adbSession->runCommand(lastCommand, QStringLiteral("inclination"));
 #elif defined Q_OS_IOS
 #ifndef IO_UNDER_QT
                         h->adb_sendcommand(lastCommand.toStdString().c_str());
@@ -401,8 +303,8 @@ void nordictrackifitadbelliptical::processPendingDatagrams() {
                                                                     "sendCommand", "(Ljava/lang/String;)V",
                                                                     command.object<jstring>());
     #elif defined(Q_OS_WIN)
-                            if (logcatAdbThread)
-                                logcatAdbThread->runCommand("shell " + lastCommand);
+                            if (adbSession)
+                                adbSession->runCommand(lastCommand, QStringLiteral("inclination"));
     #elif defined Q_OS_IOS
     #ifndef IO_UNDER_QT
                             h->adb_sendcommand(lastCommand.toStdString().c_str());
@@ -19,6 +19,7 @@
 #include <QThread>
 #include <QUdpSocket>
 
+#include "devices/ifitadbsession.h"
 #include "devices/elliptical.h"
 #include "virtualdevices/virtualbike.h"
 
@@ -26,37 +27,6 @@
 #include "ios/lockscreen.h"
 #endif
 
-class nordictrackifitadbellipticalLogcatAdbThread : public QThread {
-    Q_OBJECT
-
-  public:
-    explicit nordictrackifitadbellipticalLogcatAdbThread(QString s);
-    bool runCommand(QString command);
-
-    void run() override;
-
-  signals:
-    void onSpeedInclination(double speed, double inclination);
-    void debug(QString message);
-    void onWatt(double watt);
-    void onHRM(int hrm);
-
-  private:
-    QString adbCommandPending = "";
-    QString runAdbCommand(QString command);
-    double speed = 0;
-    double inclination = 0;
-    double watt = 0;
-    int hrm = 0;
-    QString name;
-    struct adbfile {
-        QDateTime date;
-        QString name;
-    };
-
-    void runAdbTailCommand(QString command);
-};
-
 class nordictrackifitadbelliptical : public elliptical {
     Q_OBJECT
   public:
@@ -72,7 +42,7 @@ class nordictrackifitadbelliptical : public elliptical {
     double getDouble(QString v);
     uint16_t wattsFromResistance(double inclination, double cadence);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
@@ -91,7 +61,7 @@ class nordictrackifitadbelliptical : public elliptical {
     QUdpSocket *socket = nullptr;
     QHostAddress lastSender;
 
-    nordictrackifitadbellipticalLogcatAdbThread *logcatAdbThread = nullptr;
+    IfitAdbSession *adbSession = nullptr;
 
     QString lastCommand;
 
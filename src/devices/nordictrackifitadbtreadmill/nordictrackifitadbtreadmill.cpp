@@ -16,98 +16,6 @@
 
 using namespace std::chrono_literals;
 
-nordictrackifitadbtreadmillLogcatAdbThread::nordictrackifitadbtreadmillLogcatAdbThread(QString s) { Q_UNUSED(s) }
-
-void nordictrackifitadbtreadmillLogcatAdbThread::run() {
-    QSettings settings;
-    QString ip = settings.value(QZSettings::nordictrack_2950_ip, QZSettings::default_nordictrack_2950_ip).toString();
-    runAdbCommand("connect " + ip);
-
-    while (!stop) 
-    {
-        runAdbTailCommand("logcat");
-#ifndef Q_OS_WINDOWS        
-        if(adbCommandPending.length() != 0) {
-            runAdbCommand(adbCommandPending);
-            adbCommandPending = "";
-        }
-        msleep(100);        
-#endif        
-    }
-
-}
-
-QString nordictrackifitadbtreadmillLogcatAdbThread::runAdbCommand(QString command) {
-#ifdef Q_OS_WINDOWS
-    QProcess process;
-    emit debug("adb >> " + command);
-    process.start("adb/adb.exe", QStringList(command.split(' ')));
-    process.waitForFinished(-1); // will wait forever until finished
-
-    QString out = process.readAllStandardOutput();
-    QString err = process.readAllStandardError();
-
-    emit debug("adb << OUT " + out);
-    emit debug("adb << ERR" + err);
-#else
-    QString out;
-#endif
-    return out;
-}
-
-bool nordictrackifitadbtreadmillLogcatAdbThread::runCommand(QString command) {
-    if(adbCommandPending.length() == 0) {
-        adbCommandPending = command;
-        return true;
-    }
-    return false;
-}
-
-void nordictrackifitadbtreadmillLogcatAdbThread::runAdbTailCommand(QString command) {
-#ifdef Q_OS_WINDOWS
-    auto process = new QProcess;
-    QObject::connect(process, &QProcess::readyReadStandardOutput, [process, this]() {
-        if(stop) {
-            process->close();
-            return;
-        }
-        QString output = process->readAllStandardOutput();
-        qDebug() << "adbLogCat STDOUT << " << output;
-        QStringList lines = output.split('\n', Qt::SplitBehaviorFlags::SkipEmptyParts);
-        bool wattFound = false;
-        foreach (QString line, lines) {
-            if (line.contains("Changed KPH")) {
-                emit debug(line);
-                speed = line.split(' ').last().toDouble();
-            } else if (line.contains("Changed Grade")) {
-                emit debug(line);
-                inclination = line.split(' ').last().toDouble();
-            } else if (line.contains("Changed Watts")) {
-                emit debug(line);
-                watt = line.split(' ').last().toDouble();
-                wattFound = true;
-            }
-        }
-        emit onSpeedInclination(speed, inclination);
-        if (wattFound)
-            emit onWatt(watt);
-#ifdef Q_OS_WINDOWS        
-        if(adbCommandPending.length() != 0) {
-            runAdbCommand(adbCommandPending);
-            adbCommandPending = "";
-        }
-#endif                    
-    });
-    QObject::connect(process, &QProcess::readyReadStandardError, [process, this]() {
-        auto output = process->readAllStandardError();
-        emit debug("adbLogCat ERROR << " + output);
-    });
-    emit debug("adbLogCat >> " + command);
-    process->start("adb/adb.exe", QStringList(command.split(' ')));
-    process->waitForFinished(-1);
-#endif
-}
-
 double nordictrackifitadbtreadmill::getDouble(QString v) {
     QChar d = QLocale().decimalPoint();
     if (d == ',') {
@@ -123,12 +31,12 @@ nordictrackifitadbtreadmill::nordictrackifitadbtreadmill(bool noWriteResistance,
             .toBool();
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &nordictrackifitadbtreadmill::update);
-    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &nordictrackifitadbtreadmill::stopLogcatAdbThread);
+    connect(refresh, &PollTimer::timeout, this, &nordictrackifitadbtreadmill::update);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &nordictrackifitadbtreadmill::stopAdbSession);
     QString ip = settings.value(QZSettings::nordictrack_2950_ip, QZSettings::default_nordictrack_2950_ip).toString();
 
     refresh->start(200ms);
@@ -142,14 +50,12 @@ nordictrackifitadbtreadmill::nordictrackifitadbtreadmill(bool noWriteResistance,
 #ifdef Q_OS_WIN32
     if (nordictrack_ifit_adb_remote)
     {
-        logcatAdbThread = new nordictrackifitadbtreadmillLogcatAdbThread("logcatAdbThread");
-        connect(logcatAdbThread, &nordictrackifitadbtreadmillLogcatAdbThread::onSpeedInclination, this,
+        adbSession = new IfitAdbSession(ip, this);
+        connect(adbSession, &IfitAdbSession::onSpeedInclination, this,
                 &nordictrackifitadbtreadmill::onSpeedInclination);
-        connect(logcatAdbThread, &nordictrackifitadbtreadmillLogcatAdbThread::onWatt, this,
-                &nordictrackifitadbtreadmill::onWatt);
-        connect(logcatAdbThread, &nordictrackifitadbtreadmillLogcatAdbThread::debug, this,
-                &nordictrackifitadbtreadmill::debug);
-        logcatAdbThread->start();
+        connect(adbSession, &IfitAdbSession::onWatt, this, &nordictrackifitadbtreadmill::onWatt);
+        connect(adbSession, &IfitAdbSession::debug, this, &nordictrackifitadbtreadmill::debug);
+        adbSession->start();
     }
 #endif
 
@@ -320,8 +226,8 @@ void nordictrackifitadbtreadmill::processPendingDatagrams() {
                 QAndroidJniObject::callStaticMethod<void>("org/cagnulen/qdomyoszwift/QZAdbRemote", "sendCommand",
                                                           "(Ljava/lang/String;)V", command.object<jstring>());
 #elif defined(Q_OS_WIN)
-                        if (logcatAdbThread)
-                            logcatAdbThread->runCommand("shell " + lastCommand);                                                          
+                if (adbSession)
+                    adbSession->runCommand(lastCommand, QStringLiteral("speed"));
 #elif defined Q_OS_IOS
 #ifndef IO_UNDER_QT
                 h->adb_sendcommand(lastCommand.toStdString().c_str());
@@ -366,8 +272,8 @@ void nordictrackifitadbtreadmill::processPendingDatagrams() {
                 QAndroidJniObject::callStaticMethod<void>("org/cagnulen/qdomyoszwift/QZAdbRemote", "sendCommand",
                                                         "(Ljava/lang/String;)V", command.object<jstring>());
 #elif defined(Q_OS_WIN)
-                        if (logcatAdbThread)
-                            logcatAdbThread->runCommand("shell " + lastCommand);                                                        
+                if (adbSession)
+                    adbSession->runCommand(lastCommand, QStringLiteral("inclination"));
 #elif defined Q_OS_IOS
 #ifndef IO_UNDER_QT
                 h->adb_sendcommand(lastCommand.toStdString().c_str());
@@ -534,26 +440,19 @@ void nordictrackifitadbtreadmill::changeInclinationRequested(double grade, doubl
 
 bool nordictrackifitadbtreadmill::connected() { return true; }
 
-void nordictrackifitadbtreadmill::stopLogcatAdbThread() {
-    qDebug() << "stopLogcatAdbThread()";
-    
+void nordictrackifitadbtreadmill::stopAdbSession() {
+    qDebug() << "stopAdbSession()";
+
 #ifdef Q_OS_WIN32
-    initiateThreadStop();
-    logcatAdbThread->quit();
-    logcatAdbThread->terminate();
-    
+    if (!adbSession)
+        return;
+    adbSession->stop();
+
+    // the adb server outlives its clients
     QProcess process;
     QString command = "/c wmic process where name='adb.exe' delete";
     process.start("cmd.exe", QStringList(command.split(' ')));
     process.waitForFinished(-1); // will wait forever until finished
-    
-    logcatAdbThread->wait();
-#endif
-}
-
-void nordictrackifitadbtreadmill::initiateThreadStop() {
-#ifdef Q_OS_WIN32
-    logcatAdbThread->stop = true;
 #endif
 }
 
@@ -19,42 +19,13 @@
 #include <QThread>
 #include <QUdpSocket>
 
+#include "devices/ifitadbsession.h"
 #include "treadmill.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
 #endif
 
-class nordictrackifitadbtreadmillLogcatAdbThread : public QThread {
-    Q_OBJECT
-
-  public:
-    explicit nordictrackifitadbtreadmillLogcatAdbThread(QString s);
-    bool runCommand(QString command);
-
-    void run() override;
-    bool stop = false;    
-
-  signals:
-    void onSpeedInclination(double speed, double inclination);
-    void debug(QString message);
-    void onWatt(double watt);
-
-  private:
-    QString adbCommandPending = "";
-    double speed = 0;
-    double inclination = 0;
-    double watt = 0;
-    QString name;
-    struct adbfile {
-        QDateTime date;
-        QString name;
-    };
-
-    QString runAdbCommand(QString command);
-    void runAdbTailCommand(QString command);
-};
-
 class nordictrackifitadbtreadmill : public treadmill {
     Q_OBJECT
   public:
@@ -67,9 +38,8 @@ class nordictrackifitadbtreadmill : public treadmill {
     void forceIncline(double incline);
     void forceSpeed(double speed);
     double getDouble(QString v);
-    void initiateThreadStop();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
@@ -87,9 +57,7 @@ class nordictrackifitadbtreadmill : public treadmill {
     QUdpSocket *socket = nullptr;
     QHostAddress lastSender;
 
-#ifdef Q_OS_WIN32
-    nordictrackifitadbtreadmillLogcatAdbThread *logcatAdbThread = nullptr;
-#endif
+    IfitAdbSession *adbSession = nullptr;
 
     int x14i_inclination_lookuptable(double reqInclination);
 
@@ -114,7 +82,7 @@ class nordictrackifitadbtreadmill : public treadmill {
     void update();
     
   public slots:
-    void stopLogcatAdbThread();
+    void stopAdbSession();
 };
 
 #endif // NORDICTRACKIFITADBTREADMILL_H
@@ -20,11 +20,11 @@ using namespace std::chrono_literals;
 npecablebike::npecablebike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &npecablebike::update);
+    connect(refresh, &PollTimer::timeout, this, &npecablebike::update);
     refresh->start(200ms);
 }
 /*
@@ -111,6 +111,7 @@ void npecablebike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void npecablebike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
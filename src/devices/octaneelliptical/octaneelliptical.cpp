@@ -188,9 +188,9 @@ octaneelliptical::octaneelliptical(uint32_t pollDeviceTime, bool noConsole, bool
     this->noConsole = noConsole;
     this->noHeartService = noHeartService;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &octaneelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &octaneelliptical::update);
     refresh->start(500ms);
 }
 
@@ -329,6 +329,7 @@ void octaneelliptical::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void octaneelliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -66,7 +66,7 @@ class octaneelliptical : public elliptical {
     QDateTime lastTimeDistance = QDateTime::currentDateTime();
     metric speed;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -190,9 +190,9 @@ octanetreadmill::octanetreadmill(uint32_t pollDeviceTime, bool noConsole, bool n
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &octanetreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &octanetreadmill::update);
     refresh->start(500ms);
 }
 
@@ -335,6 +335,7 @@ void octanetreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void octanetreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                             const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -63,7 +63,7 @@ class octanetreadmill : public treadmill {
     QByteArray actualPace2Sign;
     QByteArray cadenceSign;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -25,13 +25,13 @@ pafersbike::pafersbike(bool noWriteResistance, bool noHeartService, int8_t bikeR
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &pafersbike::update);
+    connect(refresh, &PollTimer::timeout, this, &pafersbike::update);
     refresh->start(400ms);
 }
 
@@ -192,6 +192,7 @@ double pafersbike::GetWattFromPacket(const QByteArray &packet) {
 }
 
 void pafersbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -204,6 +205,7 @@ void pafersbike::characteristicChanged(const QLowEnergyCharacteristic &character
     lastPacket = newValue;
 
     if (newValue.length() != 10) {
+        notificationParseError(characteristic);
         return;
     }
 
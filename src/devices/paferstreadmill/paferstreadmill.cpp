@@ -35,9 +35,9 @@ paferstreadmill::paferstreadmill(uint32_t pollDeviceTime, bool noConsole, bool n
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &paferstreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &paferstreadmill::update);
     refresh->start(500ms);
 }
 
@@ -185,6 +185,7 @@ void paferstreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void paferstreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                             const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -18,11 +18,11 @@ pelotonbike::pelotonbike(bool noWriteResistance, bool noHeartService) {
     QSettings settings;
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &pelotonbike::update);
+    connect(refresh, &PollTimer::timeout, this, &pelotonbike::update);
     refresh->start(200ms);    
 
     pelotonOCRsocket = new QUdpSocket(this);
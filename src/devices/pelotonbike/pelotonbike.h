@@ -37,7 +37,7 @@ class pelotonbike : public bike {
     uint16_t watts() override;
     double getDouble(QString v);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t sec1Update = 0;
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
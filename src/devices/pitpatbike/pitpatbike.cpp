@@ -25,13 +25,13 @@ pitpatbike::pitpatbike(bool noWriteResistance, bool noHeartService, int8_t bikeR
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &pitpatbike::update);
+    connect(refresh, &PollTimer::timeout, this, &pitpatbike::update);
     refresh->start(200ms);
 }
 
@@ -172,6 +172,7 @@ double pitpatbike::bikeResistanceToPeloton(double resistance) {
 
 void pitpatbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                 const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -183,6 +184,7 @@ void pitpatbike::characteristicChanged(const QLowEnergyCharacteristic &character
     lastPacket = newValue;
 
     if (newValue.length() != 30) {
+        notificationParseError(characteristic);
         return;
     }
 
@@ -0,0 +1,210 @@
+#include "pollscheduler.h"
+#include "devices/bluetoothdevice.h"
+#include "qzmetrics.h"
+
+#include <QPair>
+#include <QThreadStorage>
+
+namespace {
+
+// the longest period of a backed off timer without keep-alive
+const int maxIdlePeriodMs = 2000;
+
+QThreadStorage<PollScheduler *> schedulers;
+
+} // namespace
+
+PollTimer::PollTimer(QObject *parent) : QObject(parent), scheduler(PollScheduler::instance()) {
+    scheduler->all.append(this);
+}
+
+PollTimer::PollTimer(QObject *parent, Feed feed) : PollTimer(parent) {
+    if (feed == Notified)
+        setNotificationDriven(true, notifiedKeepAliveMs);
+}
+
+PollTimer::~PollTimer() {
+    stop();
+    if (scheduler)
+        scheduler->all.removeOne(this);
+}
+
+void PollTimer::start(int msec) {
+    if (!scheduler)
+        return;
+    if (active)
+        scheduler->remove(this);
+    periodMs = qMax(msec, 0);
+    periodTicks = qMax(1, (periodMs + PollScheduler::tickMs - 1) / PollScheduler::tickMs);
+    currentTicks = periodTicks;
+    stillSinceMs = -1;
+    active = true;
+    generation++;
+    scheduler->add(this);
+}
+
+void PollTimer::stop() {
+    if (!active)
+        return;
+    active = false;
+    generation++;
+    if (scheduler)
+        scheduler->remove(this);
+}
+
+void PollTimer::setNotificationDriven(bool notificationDriven, int keepAliveMs, int stillAfterMs) {
+    this->notificationDriven = notificationDriven;
+    this->keepAliveMs = keepAliveMs;
+    this->stillAfterMs = stillAfterMs;
+}
+
+int PollTimer::currentInterval() const { return currentTicks * PollScheduler::tickMs; }
+
+int PollTimer::nextPeriodTicks(qint64 nowMs) {
+    if (!notificationDriven)
+        return periodTicks;
+
+    bluetoothdevice *device = qobject_cast<bluetoothdevice *>(parent());
+    bool still = device && (device->isPaused() || (device->currentSpeed().value() == 0 &&
+                                                   device->currentCadence().value() == 0 &&
+                                                   device->wattsMetric().value() == 0));
+    if (!still) {
+        stillSinceMs = -1;
+        return periodTicks;
+    }
+    if (stillSinceMs < 0)
+        stillSinceMs = nowMs;
+    if (nowMs - stillSinceMs < stillAfterMs)
+        return periodTicks;
+
+    int maxTicks = qMax(periodTicks, (keepAliveMs > 0 ? keepAliveMs : maxIdlePeriodMs) / PollScheduler::tickMs);
+    return qMin(currentTicks * 2, maxTicks);
+}
+
+PollScheduler::PollScheduler(QObject *parent) : QObject(parent) {
+    wheel.resize(wheelSlots);
+    clock.start();
+    timer.setSingleShot(true);
+    timer.setTimerType(Qt::PreciseTimer);
+    connect(&timer, &QTimer::timeout, this, &PollScheduler::tick);
+}
+
+PollScheduler::~PollScheduler() {
+    for (PollTimer *t : qAsConst(all)) {
+        t->active = false;
+        t->scheduler = nullptr;
+    }
+}
+
+PollScheduler *PollScheduler::instance() {
+    if (!schedulers.hasLocalData())
+        schedulers.setLocalData(new PollScheduler());
+    return schedulers.localData();
+}
+
+void PollScheduler::add(PollTimer *t) {
+    // aligned to the period: the timers with the same period share the wakeups
+    t->dueTick = (nowTick() / t->currentTicks + 1) * t->currentTicks;
+    schedule(t);
+    arm();
+}
+
+void PollScheduler::schedule(PollTimer *t) { wheel[t->dueTick % wheelSlots].append(t); }
+
+void PollScheduler::remove(PollTimer *t) {
+    wheel[t->dueTick % wheelSlots].removeOne(t);
+    arm();
+}
+
+void PollScheduler::arm() {
+    qint64 now = nowTick();
+    qint64 next = -1;
+    for (int d = 0; d < wheelSlots && next < 0; d++) {
+        for (PollTimer *t : qAsConst(wheel[(now + d) % wheelSlots])) {
+            if (t->dueTick <= now + d) {
+                next = now + d;
+                break;
+            }
+        }
+    }
+    // everything is more than a turn of the wheel away
+    if (next < 0) {
+        for (const QList<PollTimer *> &slot : qAsConst(wheel))
+            for (PollTimer *t : slot)
+                if (next < 0 || t->dueTick < next)
+                    next = t->dueTick;
+    }
+    if (next < 0) {
+        timer.stop();
+        return;
+    }
+    timer.start((int)qMax<qint64>(0, next * tickMs - clock.elapsed()));
+}
+
+void PollScheduler::tick() {
+    wakeupCount++;
+    QZMetrics::increment(QZMetrics::PollWakeups);
+
+    qint64 now = nowTick();
+    QList<QPair<QPointer<PollTimer>, quint64>> due;
+    for (qint64 k = qMax(qMin(lastTick + 1, now), now - wheelSlots + 1); k <= now; k++) {
+        QList<PollTimer *> &slot = wheel[k % wheelSlots];
+        for (int i = 0; i < slot.size();) {
+            if (slot.at(i)->dueTick <= now) {
+                PollTimer *t = slot.takeAt(i);
+                due.append(qMakePair(QPointer<PollTimer>(t), t->generation));
+            } else {
+                i++;
+            }
+        }
+    }
+    lastTick = now;
+
+    for (const auto &entry : qAsConst(due)) {
+        PollTimer *t = entry.first;
+        // stopped, restarted or deleted by the timeout of another timer
+        if (!t || t->generation != entry.second)
+            continue;
+        qint64 started = QZMetrics::monotonicNs();
+        emit t->timeout();
+        qint64 elapsed = QZMetrics::monotonicNs() - started;
+        QZMetrics::observe(QZMetrics::DevicePollDuration, elapsed / 1e9);
+
+        t = entry.first;
+        if (!t)
+            continue;
+        t->tickCount++;
+        t->totalNs += elapsed;
+        t->maxNs = qMax(t->maxNs, elapsed);
+        if (t->generation != entry.second)
+            continue;
+
+        int period = t->nextPeriodTicks(clock.elapsed());
+        qint64 next = t->dueTick + period;
+        qint64 current = nowTick();
+        // missed ticks are skipped, like QTimer does
+        if (next <= current)
+            next = (current / period + 1) * period;
+        t->currentTicks = period;
+        t->dueTick = next;
+        schedule(t);
+    }
+    arm();
+}
+
+QString PollScheduler::report() const {
+    QString report;
+    for (PollTimer *t : qAsConst(all)) {
+        const char *owner = t->parent() ? t->parent()->metaObject()->className() : "PollTimer";
+        report += QStringLiteral("%1: every %2ms (now %3ms) ticks=%4 avg=%5us max=%6us%7\n")
+                      .arg(QString::fromLatin1(owner))
+                      .arg(t->periodMs)
+                      .arg(t->active ? t->currentInterval() : 0)
+                      .arg(t->tickCount)
+                      .arg(t->tickCount ? t->totalNs / (qint64)t->tickCount / 1000 : 0)
+                      .arg(t->maxNs / 1000)
+                      .arg(t->active ? QString() : QStringLiteral(" stopped"));
+    }
+    report += QStringLiteral("poll scheduler: %1 timers, %2 wakeups\n").arg(all.size()).arg(wakeupCount);
+    return report;
+}
@@ -0,0 +1,142 @@
+#ifndef POLLSCHEDULER_H
+#define POLLSCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <chrono>
+
+class PollScheduler;
+
+/**
+ * @brief The refresh timer of a driver: the subset of QTimer the drivers use (start, stop, interval, timeout),
+ * driven by the PollScheduler of its thread instead of a timer of its own.
+ *
+ * The period is rounded up to the 50 ms tick of the scheduler. Every driver says how its data arrives with the
+ * Feed it creates the timer with. A Polled driver writes to the device on its timeouts, so it keeps the period.
+ * A Notified driver only reads the notifications in its timeouts: once its device has been paused or still for a
+ * while, the poll slows down up to notifiedKeepAliveMs, and goes back to the period as soon as the device moves.
+ * interval() is always the nominal period.
+ */
+class PollTimer : public QObject {
+    Q_OBJECT
+
+  public:
+    enum Feed {
+        Polled,  // the timeouts poll the device or keep its console alive
+        Notified // the device notifies its data, the timeouts only send the pending requests
+    };
+
+    // the longest a still Notified device goes without a timeout
+    static const int notifiedKeepAliveMs = 1000;
+
+    explicit PollTimer(QObject *parent = nullptr);
+    PollTimer(QObject *parent, Feed feed);
+    ~PollTimer();
+
+    void start(int msec);
+    void start(std::chrono::milliseconds msec) { start((int)msec.count()); }
+    void start() { start(periodMs); }
+    void stop();
+    bool isActive() const { return active; }
+    int interval() const { return periodMs; }
+
+    /**
+     * @param keepAliveMs the longest the device can go without a poll, 0 if it doesn't need any
+     * @param stillAfterMs how long the device has to be still before the poll slows down
+     */
+    void setNotificationDriven(bool notificationDriven, int keepAliveMs = 0, int stillAfterMs = 10000);
+
+    /**
+     * @brief currentInterval The period the timer is polling at now, longer than interval() while backing off.
+     */
+    int currentInterval() const;
+
+    quint64 ticks() const { return tickCount; }
+    qint64 maxTickNs() const { return maxNs; }
+    qint64 totalTickNs() const { return totalNs; }
+
+  signals:
+    void timeout();
+
+  private:
+    friend class PollScheduler;
+
+    // called by the scheduler after a timeout: the period of the next one, in ticks
+    int nextPeriodTicks(qint64 nowMs);
+
+    PollScheduler *scheduler = nullptr;
+    bool active = false;
+    bool notificationDriven = false;
+    int periodMs = 0;
+    int keepAliveMs = 0;
+    int stillAfterMs = 10000;
+    int periodTicks = 1;
+    int currentTicks = 1;
+    qint64 dueTick = 0;
+    quint64 generation = 0; // changes at every start and stop, so that a timeout doesn't reschedule a restarted timer
+    qint64 stillSinceMs = -1;
+
+    quint64 tickCount = 0;
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+};
+
+/**
+ * @brief One timer per thread for all the PollTimers of the drivers living in it, as a hashed timing wheel of
+ * 50 ms slots.
+ *
+ * Timers start aligned to a multiple of their period, so the timers with the same period (or multiples of it)
+ * fire in the same wakeup, and the scheduler sleeps until the next non empty slot instead of ticking every 50 ms.
+ * The time spent in every timeout is kept per timer for report() and in the qz_device_poll_seconds histogram.
+ */
+class PollScheduler : public QObject {
+    Q_OBJECT
+
+  public:
+    static const int tickMs = 50;
+    static const int wheelSlots = 64;
+
+    /**
+     * @brief instance The scheduler of the calling thread, created the first time.
+     */
+    static PollScheduler *instance();
+    ~PollScheduler();
+
+    /**
+     * @brief wakeups The times the scheduler woke up to fire timers.
+     */
+    quint64 wakeups() const { return wakeupCount; }
+    int timers() const { return all.size(); }
+
+    /**
+     * @brief report One line per timer with its period and the cost of its ticks, for the logs and the debug page.
+     */
+    QString report() const;
+
+  private slots:
+    void tick();
+
+  private:
+    explicit PollScheduler(QObject *parent = nullptr);
+    friend class PollTimer;
+
+    qint64 nowTick() const { return clock.elapsed() / tickMs; }
+    void add(PollTimer *timer);
+    void schedule(PollTimer *timer);
+    void remove(PollTimer *timer);
+    void arm();
+
+    QTimer timer;
+    QElapsedTimer clock;
+    qint64 lastTick = 0;
+    quint64 wakeupCount = 0;
+    QVector<QList<PollTimer *>> wheel;
+    QList<PollTimer *> all;
+};
+
+#endif // POLLSCHEDULER_H
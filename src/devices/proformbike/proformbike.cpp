@@ -19,13 +19,13 @@ proformbike::proformbike(bool noWriteResistance, bool noHeartService, int8_t bik
                          double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &proformbike::update);
+    connect(refresh, &PollTimer::timeout, this, &proformbike::update);
     refresh->start(200ms);
 }
 
@@ -1063,6 +1063,7 @@ void proformbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void proformbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -57,7 +57,7 @@ class proformbike : public bike {
     void forceIncline(double incline);
     void innerWriteResistance();
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t counterPoll = 0;
     int8_t bikeResistanceOffset = 4;
     double bikeResistanceGain = 1.0;
@@ -18,11 +18,11 @@ using namespace std::chrono_literals;
 proformelliptical::proformelliptical(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &proformelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &proformelliptical::update);
     refresh->start(200ms);
 }
 
@@ -199,6 +199,7 @@ double proformelliptical::GetResistanceFromPacket(QByteArray packet) {
 
 void proformelliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                               const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -51,7 +51,7 @@ class proformelliptical : public elliptical {
     void forceSpeed(double speed);
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t counterPoll = 0;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
@@ -21,13 +21,13 @@ proformellipticaltrainer::proformellipticaltrainer(bool noWriteResistance, bool
                                                    int8_t bikeResistanceOffset, double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &proformellipticaltrainer::update);
+    connect(refresh, &PollTimer::timeout, this, &proformellipticaltrainer::update);
     refresh->start(200ms);
 }
 
@@ -344,6 +344,7 @@ double proformellipticaltrainer::GetResistanceFromPacket(QByteArray packet) {
 
 void proformellipticaltrainer::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                      const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
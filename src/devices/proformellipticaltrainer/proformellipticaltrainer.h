@@ -53,7 +53,7 @@ class proformellipticaltrainer : public elliptical {
     void forceIncline(double incline);
     void forceSpeed(double speed);
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t counterPoll = 0;
     int8_t bikeResistanceOffset = 4;
     double bikeResistanceGain = 1.0;
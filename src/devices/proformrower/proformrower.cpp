@@ -19,11 +19,11 @@ using namespace std::chrono_literals;
 proformrower::proformrower(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &proformrower::update);
+    connect(refresh, &PollTimer::timeout, this, &proformrower::update);
     refresh->start(200ms);
 }
 
@@ -478,6 +478,7 @@ double proformrower::GetResistanceFromPacket(QByteArray packet) {
 }
 
 void proformrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -51,7 +51,7 @@ class proformrower : public rower {
     void sendPoll();
     void forceResistance(resistance_t requestResistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t counterPoll = 0;
     uint16_t watts() override;
 
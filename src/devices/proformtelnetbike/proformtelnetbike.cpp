@@ -20,13 +20,13 @@ proformtelnetbike::proformtelnetbike(bool noWriteResistance, bool noHeartService
     m_watt.setType(metric::METRIC_WATT);
     target_watts.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &proformtelnetbike::update);
+    connect(refresh, &PollTimer::timeout, this, &proformtelnetbike::update);
     refresh->start(200ms);
 
     bool ok = connect(&telnet, &QTelnet::newData, this, &proformtelnetbike::characteristicChanged);
@@ -70,7 +70,7 @@ class proformtelnetbike : public bike {
     uint16_t watts() override;
     void sendFrame(QByteArray frame);
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t counterPoll = 0;
     int8_t bikeResistanceOffset = 4;
     double bikeResistanceGain = 1.0;
@@ -19,11 +19,11 @@ using namespace std::chrono_literals;
 proformtreadmill::proformtreadmill(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &proformtreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &proformtreadmill::update);
     refresh->start(200ms);
 }
 
@@ -2805,6 +2805,7 @@ void proformtreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void proformtreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
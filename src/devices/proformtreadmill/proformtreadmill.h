@@ -49,7 +49,7 @@ class proformtreadmill : public treadmill {
     void forceIncline(double incline);
     void forceSpeed(double speed);
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t counterPoll = 0;
 
     QLowEnergyService *gattCommunicationChannelService = nullptr;
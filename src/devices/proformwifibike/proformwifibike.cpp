@@ -20,13 +20,13 @@ proformwifibike::proformwifibike(bool noWriteResistance, bool noHeartService, in
     m_watt.setType(metric::METRIC_WATT);
     target_watts.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &proformwifibike::update);
+    connect(refresh, &PollTimer::timeout, this, &proformwifibike::update);
     refresh->start(50ms);
 
     bool ok = connect(&websocket, &QWebSocket::binaryMessageReceived, this, &proformwifibike::binaryMessageReceived);
@@ -427,35 +427,30 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
     lastPacket = newValue;
 
     lastPacket = lastPacket.replace("à", "a");
-    QByteArray payload = lastPacket.toLocal8Bit(); // JSON
-    QJsonParseError parseError;
-    QJsonDocument metrics = QJsonDocument::fromJson(payload, &parseError);
+    telemetry.parse(lastPacket);
 
-    QJsonObject json = metrics.object();
-    QJsonValue values = json.value("values");
-
-    if (!values[QStringLiteral("Master State")].isUndefined()) {
+    if (telemetry.has(ProformWifiTelemetry::MasterState)) {
         tdf2 = true;
         qDebug() << QStringLiteral("TDF2 mod enabled!");
     }
 
     if (!settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool()) {
-        if (!values[QStringLiteral("Current KPH")].isUndefined()) {
-            double kph = values[QStringLiteral("Current KPH")].toString().toDouble();
+        if (telemetry.has(ProformWifiTelemetry::CurrentKph)) {
+            double kph = telemetry.value(ProformWifiTelemetry::CurrentKph);
             Speed = kph;
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
-        } else if (!values[QStringLiteral("KPH")].isUndefined()) {
-            double kph = values[QStringLiteral("KPH")].toString().toDouble();
+        } else if (telemetry.has(ProformWifiTelemetry::Kph)) {
+            double kph = telemetry.value(ProformWifiTelemetry::Kph);
             Speed = kph;
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         }
 
-        if (!values[QStringLiteral("Kilometers")].isUndefined()) {
-            double odometer = values[QStringLiteral("Kilometers")].toString().toDouble();
+        if (telemetry.has(ProformWifiTelemetry::Kilometers)) {
+            double odometer = telemetry.value(ProformWifiTelemetry::Kilometers);
             Distance = odometer;
             emit debug("Current Distance: " + QString::number(odometer));
-        } else if (!values[QStringLiteral("Chilometri")].isUndefined()) {
-            double odometer = values[QStringLiteral("Chilometri")].toString().toDouble();
+        } else if (telemetry.has(ProformWifiTelemetry::Chilometri)) {
+            double odometer = telemetry.value(ProformWifiTelemetry::Chilometri);
             Distance = odometer;
             emit debug("Current Distance: " + QString::number(odometer));
         }
@@ -469,8 +464,8 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
     }
 
-    if (!values[QStringLiteral("RPM")].isUndefined()) {
-        double rpm = values[QStringLiteral("RPM")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::Rpm)) {
+        double rpm = telemetry.value(ProformWifiTelemetry::Rpm);
         Cadence = rpm;
         emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
 
@@ -482,15 +477,15 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
 
     // some buggy TDF1 bikes send spurious wattage at the end with cadence = 0
     if (Cadence.value() > 0) {
-        if (!values[QStringLiteral("Current Watts")].isUndefined()) {
-            double watt = values[QStringLiteral("Current Watts")].toString().toDouble();
+        if (telemetry.has(ProformWifiTelemetry::CurrentWatts)) {
+            double watt = telemetry.value(ProformWifiTelemetry::CurrentWatts);
             if (settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name)
                     .toString()
                     .startsWith(QStringLiteral("Disabled")))
                 m_watt = watt;
             emit debug(QStringLiteral("Current Watt: ") + QString::number(watts()));
-        } else if (!values[QStringLiteral("Watt attuali")].isUndefined()) {
-            double watt = values[QStringLiteral("Watt attuali")].toString().toDouble();
+        } else if (telemetry.has(ProformWifiTelemetry::WattAttuali)) {
+            double watt = telemetry.value(ProformWifiTelemetry::WattAttuali);
             m_watt = watt;
             emit debug(QStringLiteral("Current Watt: ") + QString::number(watts()));
         }
@@ -500,9 +495,9 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
         emit debug(QStringLiteral("Current Watt: ") + QString::number(watts()));
     }
 
-    if (!values[QStringLiteral("Actual Incline")].isUndefined()) {
+    if (telemetry.has(ProformWifiTelemetry::ActualIncline)) {
         bool erg_mode = settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool();
-        double incline = values[QStringLiteral("Actual Incline")].toString().toDouble();
+        double incline = telemetry.value(ProformWifiTelemetry::ActualIncline);
         // if the bike has the inclination, QZ is using it to change the resistance when it's not in ERG mode.
         // so I would like to keep the real inclination value instead of showing to the user the modified inclination + gears.
         // this is very helpful when you're following a GPX for example
@@ -510,9 +505,9 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
             incline = incline - gears();
         Inclination = incline;
         emit debug(QStringLiteral("Current Inclination: ") + QString::number(incline));
-    } else if (!values[QStringLiteral("Incline")].isUndefined()) {
+    } else if (telemetry.has(ProformWifiTelemetry::Incline)) {
         bool erg_mode = settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool();
-        double incline = values[QStringLiteral("Incline")].toString().toDouble();
+        double incline = telemetry.value(ProformWifiTelemetry::Incline);
         // if the bike has the inclination, QZ is using it to change the resistance when it's not in ERG mode.
         // so I would like to keep the real inclination value instead of showing to the user the modified inclination + gears.
         // this is very helpful when you're following a GPX for example
@@ -522,42 +517,39 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
         emit debug(QStringLiteral("Current Inclination: ") + QString::number(incline));
     }
 
-    if (!values[QStringLiteral("Target Watts")].isUndefined()) {
-        double watt = values[QStringLiteral("Target Watts")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::TargetWatts)) {
+        double watt = telemetry.value(ProformWifiTelemetry::TargetWatts);
         target_watts = watt;
         emit debug(QStringLiteral("Target Watts: ") + QString::number(watts()));
     }
 
-    if (!values[QStringLiteral("Resistance")].isUndefined()) {
-        Resistance = values[QStringLiteral("Resistance")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::Resistance)) {
+        Resistance = telemetry.value(ProformWifiTelemetry::Resistance);
         emit debug(QStringLiteral("Resistance: ") + QString::number(Resistance.value()));
     }
 
-    if (!values[QStringLiteral("Maximum Incline")].isUndefined()) {
-        max_incline_supported = values[QStringLiteral("Maximum Incline")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::MaximumIncline)) {
+        max_incline_supported = telemetry.value(ProformWifiTelemetry::MaximumIncline);
         emit debug(QStringLiteral("Maximum Incline Supported: ") + QString::number(max_incline_supported));
     }
 
     if (settings.value(QZSettings::gears_from_bike, QZSettings::default_gears_from_bike).toBool()) {
-        if (!values[QStringLiteral("key")].isUndefined()) {
-            QJsonObject key = values[QStringLiteral("key")].toObject();
-            QJsonValue code = key.value("code");
-            QJsonValue name = key.value("name");
-            QJsonValue held = key.value("held");
-            if(held.toString().contains(QStringLiteral("-1"))) {
+        if (telemetry.has(ProformWifiTelemetry::Key)) {
+            const QString &name = telemetry.keyName();
+            if(telemetry.keyHeld().contains(QStringLiteral("-1"))) {
                 bool erg_mode = settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool();
                 if(!erg_mode) {
                     double value = 0;
-                    if (name.toString().contains(QStringLiteral("LEFT EXTERNAL GEAR DOWN"))) {
+                    if (name.contains(QStringLiteral("LEFT EXTERNAL GEAR DOWN"))) {
                         qDebug() << "LEFT EXTERNAL GEAR DOWN";
                         value = -0.5;
-                    } else if (name.toString().contains(QStringLiteral("LEFT EXTERNAL GEAR UP"))) {
+                    } else if (name.contains(QStringLiteral("LEFT EXTERNAL GEAR UP"))) {
                         qDebug() << "LEFT EXTERNAL GEAR UP";
                         value = 0.5;
-                    } else if (name.toString().contains(QStringLiteral("RIGHT EXTERNAL GEAR UP"))) {
+                    } else if (name.contains(QStringLiteral("RIGHT EXTERNAL GEAR UP"))) {
                         qDebug() << "RIGHT EXTERNAL GEAR UP";
                         value = -5.0;
-                    } else if (name.toString().contains(QStringLiteral("RIGHT EXTERNAL GEAR DOWN"))) {
+                    } else if (name.contains(QStringLiteral("RIGHT EXTERNAL GEAR DOWN"))) {
                         qDebug() << "RIGHT EXTERNAL GEAR DOWN";
                         value = 5.0;
                     }
@@ -567,16 +559,16 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
                     }
                 } else {
                     double value = 0;
-                    if (name.toString().contains(QStringLiteral("LEFT EXTERNAL GEAR DOWN"))) {
+                    if (name.contains(QStringLiteral("LEFT EXTERNAL GEAR DOWN"))) {
                         qDebug() << "LEFT EXTERNAL GEAR DOWN";
                         value = -10.0;
-                    } else if (name.toString().contains(QStringLiteral("LEFT EXTERNAL GEAR UP"))) {
+                    } else if (name.contains(QStringLiteral("LEFT EXTERNAL GEAR UP"))) {
                         qDebug() << "LEFT EXTERNAL GEAR UP";
                         value = 10.0;
-                    } else if (name.toString().contains(QStringLiteral("RIGHT EXTERNAL GEAR UP"))) {
+                    } else if (name.contains(QStringLiteral("RIGHT EXTERNAL GEAR UP"))) {
                         qDebug() << "RIGHT EXTERNAL GEAR UP";
                         value = -50.0;
-                    } else if (name.toString().contains(QStringLiteral("RIGHT EXTERNAL GEAR DOWN"))) {
+                    } else if (name.contains(QStringLiteral("RIGHT EXTERNAL GEAR DOWN"))) {
                         qDebug() << "RIGHT EXTERNAL GEAR DOWN";
                         value = 50.0;
                     }
@@ -601,8 +593,8 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
                                                                   m_pelotonResistance = (100 / 32) * Resistance.value();
                                                                   emit resistanceRead(Resistance.value());    */
 
-    if (!disable_hr_frommachinery && !values[QStringLiteral("Chest Pulse")].isUndefined()) {
-        Heart = values[QStringLiteral("Chest Pulse")].toString().toDouble();
+    if (!disable_hr_frommachinery && telemetry.has(ProformWifiTelemetry::ChestPulse)) {
+        Heart = telemetry.value(ProformWifiTelemetry::ChestPulse);
         // index += 1; // NOTE: clang-analyzer-deadcode.DeadStores
         emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
     }
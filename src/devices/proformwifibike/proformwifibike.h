@@ -34,6 +34,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "devices/proformwifitelemetry.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -70,13 +71,14 @@ class proformwifibike : public bike {
     void setTargetWatts(double watts);
     void setWorkoutType(QString type);
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t counterPoll = 0;
     int8_t bikeResistanceOffset = 4;
     double bikeResistanceGain = 1.0;
 
     uint8_t sec1Update = 0;
     QString lastPacket;
+    ProformWifiTelemetry telemetry;
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
     uint8_t firstStateChanged = 0;
     metric target_watts;
@@ -0,0 +1,404 @@
+#include "proformwifitelemetry.h"
+
+namespace {
+
+// the names of the fields in "values", in the order of ProformWifiTelemetry::Field
+const char *const fieldNames[ProformWifiTelemetry::FieldCount] = {
+    "Master State",    "Current KPH",     "KPH",          "Maximum KPH",  "Kilometers",     "Chilometri",
+    "RPM",             "Current Watts",   "Watt attuali", "Target Watts", "Actual Incline", "Incline",
+    "Maximum Incline", "Minimum Incline", "Resistance",   "Chest Pulse",  "key"};
+
+// nesting skipped inside a value we don't need before giving up on the frame
+const int maxDepth = 64;
+
+struct Cursor {
+    const ushort *p;
+    const ushort *end;
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+            p++;
+    }
+
+    // skips the spaces and the expected character
+    bool expect(ushort c) {
+        skipSpace();
+        if (p == end || *p != c)
+            return false;
+        p++;
+        return true;
+    }
+
+    bool peek(ushort c) {
+        skipSpace();
+        return p < end && *p == c;
+    }
+};
+
+struct Token {
+    const ushort *begin = nullptr;
+    int length = 0;
+    bool escaped = false;
+};
+
+bool isDigit(ushort c) { return c >= '0' && c <= '9'; }
+
+int hexDigit(ushort c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// a string at the cursor, the content between the quotes is left escaped in the token
+bool scanString(Cursor &c, Token &token) {
+    if (!c.expect('"'))
+        return false;
+    token.begin = c.p;
+    token.escaped = false;
+    while (c.p < c.end && *c.p != '"') {
+        if (*c.p == '\\') {
+            token.escaped = true;
+            if (++c.p == c.end)
+                return false;
+            switch (*c.p) {
+            case '"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+                break;
+            case 'u':
+                if (c.end - c.p < 5)
+                    return false;
+                for (int i = 1; i <= 4; i++)
+                    if (hexDigit(c.p[i]) < 0)
+                        return false;
+                c.p += 4;
+                break;
+            default:
+                return false;
+            }
+        }
+        c.p++;
+    }
+    if (c.p == c.end)
+        return false;
+    token.length = int(c.p - token.begin);
+    c.p++;
+    return true;
+}
+
+QString unescape(const Token &token) {
+    QString s;
+    s.reserve(token.length);
+    const ushort *p = token.begin;
+    const ushort *end = token.begin + token.length;
+    while (p < end) {
+        ushort ch = *p++;
+        if (ch == '\\') {
+            ch = *p++;
+            switch (ch) {
+            case 'b':
+                ch = '\b';
+                break;
+            case 'f':
+                ch = '\f';
+                break;
+            case 'n':
+                ch = '\n';
+                break;
+            case 'r':
+                ch = '\r';
+                break;
+            case 't':
+                ch = '\t';
+                break;
+            case 'u':
+                // a surrogate pair is two escapes, each one appended as it is
+                ch = ushort((hexDigit(p[0]) << 12) | (hexDigit(p[1]) << 8) | (hexDigit(p[2]) << 4) | hexDigit(p[3]));
+                p += 4;
+                break;
+            default: // " \ / stand for themselves
+                break;
+            }
+        }
+        s.append(QChar(ch));
+    }
+    return s;
+}
+
+QString toString(const Token &token) {
+    if (token.escaped)
+        return unescape(token);
+    return QString(reinterpret_cast<const QChar *>(token.begin), token.length);
+}
+
+// a number at the cursor: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+bool skipNumber(Cursor &c) {
+    const ushort *p = c.p;
+    if (p < c.end && *p == '-')
+        p++;
+    if (p == c.end || !isDigit(*p))
+        return false;
+    if (*p == '0')
+        p++;
+    else
+        while (p < c.end && isDigit(*p))
+            p++;
+    if (p < c.end && *p == '.') {
+        if (++p == c.end || !isDigit(*p))
+            return false;
+        while (p < c.end && isDigit(*p))
+            p++;
+    }
+    if (p < c.end && (*p == 'e' || *p == 'E')) {
+        if (++p < c.end && (*p == '+' || *p == '-'))
+            p++;
+        if (p == c.end || !isDigit(*p))
+            return false;
+        while (p < c.end && isDigit(*p))
+            p++;
+    }
+    c.p = p;
+    return true;
+}
+
+bool skipValue(Cursor &c, int depth) {
+    c.skipSpace();
+    if (c.p == c.end || depth > maxDepth)
+        return false;
+
+    ushort ch = *c.p;
+    if (ch == '"') {
+        Token token;
+        return scanString(c, token);
+    }
+    if (ch == '{' || ch == '[') {
+        ushort close = ch == '{' ? '}' : ']';
+        c.p++;
+        if (c.peek(close)) {
+            c.p++;
+            return true;
+        }
+        do {
+            if (close == '}') {
+                Token key;
+                if (!scanString(c, key) || !c.expect(':'))
+                    return false;
+            }
+            if (!skipValue(c, depth + 1))
+                return false;
+        } while (c.expect(','));
+        return c.expect(close);
+    }
+    if (ch == 't' || ch == 'f' || ch == 'n') {
+        const char *literal = ch == 't' ? "true" : ch == 'f' ? "false" : "null";
+        for (; *literal; literal++, c.p++)
+            if (c.p == c.end || *c.p != ushort(*literal))
+                return false;
+        return true;
+    }
+    return skipNumber(c);
+}
+
+bool equals(const ushort *s, int length, const char *latin1) {
+    int i = 0;
+    for (; i < length && latin1[i]; i++)
+        if (s[i] != ushort(latin1[i]))
+            return false;
+    return i == length && !latin1[i];
+}
+
+int fieldOf(const Token &token) {
+    if (token.escaped) {
+        QString name = unescape(token);
+        Token plain;
+        plain.begin = name.utf16();
+        plain.length = name.length();
+        return fieldOf(plain);
+    }
+    for (int i = 0; i < ProformWifiTelemetry::FieldCount; i++)
+        if (equals(token.begin, token.length, fieldNames[i]))
+            return i;
+    return -1;
+}
+
+// QString::toDouble() of the token: plain decimals, all the machines send, are converted here exactly as it
+// would, the rest is left to it
+double toNumber(const Token &token) {
+    if (!token.escaped) {
+        const ushort *p = token.begin;
+        const ushort *end = p + token.length;
+        bool negative = p < end && *p == '-';
+        if (negative || (p < end && *p == '+'))
+            p++;
+        double mantissa = 0;
+        int digits = 0;
+        int decimals = 0;
+        bool point = false;
+        bool fast = p < end && isDigit(*p);
+        for (; fast && p < end; p++) {
+            if (isDigit(*p)) {
+                // up to 15 digits the mantissa is an exact integer and one division by an exact power of 10
+                // rounds it correctly
+                mantissa = mantissa * 10 + (*p - '0');
+                digits++;
+                if (point)
+                    decimals++;
+                fast = digits <= 15;
+            } else if (*p == '.' && !point && p + 1 < end) {
+                point = true;
+            } else {
+                fast = false;
+            }
+        }
+        if (fast) {
+            static const double powers[] = {1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+                                            1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+            double v = mantissa / powers[decimals];
+            return negative ? -v : v;
+        }
+        return QString::fromRawData(reinterpret_cast<const QChar *>(token.begin), token.length).toDouble();
+    }
+    return unescape(token).toDouble();
+}
+
+} // namespace
+
+bool ProformWifiTelemetry::parse(const QString &frame) {
+    present = 0;
+    code.clear();
+    name.clear();
+    held.clear();
+
+    Cursor c;
+    c.p = frame.utf16();
+    c.end = c.p + frame.length();
+    bool valid = c.expect('{');
+
+    if (valid && c.peek('}')) {
+        c.p++;
+    } else if (valid) {
+        do {
+            Token key;
+            valid = scanString(c, key) && c.expect(':');
+            bool isValues = valid && !key.escaped && equals(key.begin, key.length, "values");
+            if (isValues && c.peek('{')) {
+                valid = scanValues(c.p, c.end);
+            } else if (valid) {
+                // a later "values" replaces the earlier one, even when it's not an object
+                if (isValues)
+                    present = 0;
+                valid = skipValue(c, 1);
+            }
+        } while (valid && c.expect(','));
+        valid = valid && c.expect('}');
+    }
+
+    c.skipSpace();
+    if (!valid || c.p != c.end) {
+        present = 0;
+        code.clear();
+        name.clear();
+        held.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ProformWifiTelemetry::scanValues(const ushort *&p, const ushort *end) {
+    Cursor c;
+    c.p = p;
+    c.end = end;
+    // a later "values" replaces the earlier one
+    present = 0;
+    if (!c.expect('{'))
+        return false;
+
+    bool valid = true;
+    if (c.peek('}')) {
+        c.p++;
+    } else {
+        do {
+            Token key;
+            valid = scanString(c, key) && c.expect(':');
+            if (!valid)
+                break;
+            int field = fieldOf(key);
+            if (field < 0) {
+                valid = skipValue(c, 2);
+                continue;
+            }
+
+            present |= 1u << field;
+            values[field] = 0;
+            if (field == Key) {
+                code.clear();
+                name.clear();
+                held.clear();
+                if (c.peek('{'))
+                    valid = scanKey(c.p, c.end);
+                else
+                    valid = skipValue(c, 2);
+            } else if (c.peek('"')) {
+                Token value;
+                valid = scanString(c, value);
+                if (valid)
+                    values[field] = toNumber(value);
+            } else {
+                valid = skipValue(c, 2);
+            }
+        } while (valid && c.expect(','));
+        valid = valid && c.expect('}');
+    }
+    p = c.p;
+    return valid;
+}
+
+bool ProformWifiTelemetry::scanKey(const ushort *&p, const ushort *end) {
+    Cursor c;
+    c.p = p;
+    c.end = end;
+    if (!c.expect('{'))
+        return false;
+
+    bool valid = true;
+    if (c.peek('}')) {
+        c.p++;
+    } else {
+        do {
+            Token key;
+            valid = scanString(c, key) && c.expect(':');
+            if (!valid)
+                break;
+            QString *target = nullptr;
+            if (equals(key.begin, key.length, "code"))
+                target = &code;
+            else if (equals(key.begin, key.length, "name"))
+                target = &name;
+            else if (equals(key.begin, key.length, "held"))
+                target = &held;
+
+            if (target && c.peek('"')) {
+                Token value;
+                valid = scanString(c, value);
+                if (valid)
+                    *target = toString(value);
+            } else {
+                if (target)
+                    target->clear();
+                valid = skipValue(c, 3);
+            }
+        } while (valid && c.expect(','));
+        valid = valid && c.expect('}');
+    }
+    p = c.p;
+    return valid;
+}
@@ -0,0 +1,65 @@
+#ifndef PROFORMWIFITELEMETRY_H
+#define PROFORMWIFITELEMETRY_H
+
+#include <QString>
+
+/**
+ * @brief The telemetry of a websocket frame of the ProForm Wi-Fi bikes and treadmills, like
+ * {"type":"stats","values":{"Current KPH":"21.3","RPM":"82",...}}.
+ * parse() scans the frame once, without building a QJsonDocument, and keeps only the known keys of "values"
+ * as numbers. The frame is validated as a whole like QJsonDocument::fromJson does: a malformed or truncated
+ * frame leaves nothing.
+ */
+class ProformWifiTelemetry {
+  public:
+    enum Field {
+        MasterState,
+        CurrentKph,
+        Kph,
+        MaximumKph,
+        Kilometers,
+        Chilometri,
+        Rpm,
+        CurrentWatts,
+        WattAttuali,
+        TargetWatts,
+        ActualIncline,
+        Incline,
+        MaximumIncline,
+        MinimumIncline,
+        Resistance,
+        ChestPulse,
+        Key, // an object: keyCode(), keyName() and keyHeld()
+        FieldCount
+    };
+
+    /**
+     * @brief parse Scans a frame, replacing what the previous one left.
+     * @return false if the frame is not a JSON object, nothing is then present
+     */
+    bool parse(const QString &frame);
+
+    bool has(Field field) const { return present & (1u << field); }
+
+    /**
+     * @brief value The value of a field as QJsonValue::toString().toDouble() gives it: 0 when it's not a
+     * string holding a number.
+     */
+    double value(Field field) const { return values[field]; }
+
+    const QString &keyCode() const { return code; }
+    const QString &keyName() const { return name; }
+    const QString &keyHeld() const { return held; }
+
+  private:
+    bool scanValues(const ushort *&p, const ushort *end);
+    bool scanKey(const ushort *&p, const ushort *end);
+
+    quint32 present = 0;
+    double values[FieldCount] = {0};
+    QString code;
+    QString name;
+    QString held;
+};
+
+#endif // PROFORMWIFITELEMETRY_H
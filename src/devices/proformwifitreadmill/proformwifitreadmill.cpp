@@ -18,13 +18,13 @@ proformwifitreadmill::proformwifitreadmill(bool noWriteResistance, bool noHeartS
     QSettings settings;
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &proformwifitreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &proformwifitreadmill::update);
     refresh->start(200ms);
 
     bool ok =
@@ -169,23 +169,18 @@ void proformwifitreadmill::characteristicChanged(const QString &newValue) {
     lastPacket = newValue;
 
     lastPacket = lastPacket.replace("à", "a");
-    QByteArray payload = lastPacket.toLocal8Bit(); // JSON
-    QJsonParseError parseError;
-    QJsonDocument metrics = QJsonDocument::fromJson(payload, &parseError);
+    telemetry.parse(lastPacket);
 
-    QJsonObject json = metrics.object();
-    QJsonValue values = json.value("values");
-
-    if (!values[QStringLiteral("Current KPH")].isUndefined()) {
-        double kph = values[QStringLiteral("Current KPH")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::CurrentKph)) {
+        double kph = telemetry.value(ProformWifiTelemetry::CurrentKph);
         if(kph <= maximum_kph) {
             Speed = kph;
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         } else {
             qDebug() << "filtering speed due to firmware bug";
         }
-    } else if (!values[QStringLiteral("KPH")].isUndefined()) {
-        double kph = values[QStringLiteral("KPH")].toString().toDouble();
+    } else if (telemetry.has(ProformWifiTelemetry::Kph)) {
+        double kph = telemetry.value(ProformWifiTelemetry::Kph);
         if(kph <= maximum_kph) {
             Speed = kph;
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
@@ -194,18 +189,18 @@ void proformwifitreadmill::characteristicChanged(const QString &newValue) {
         }
     }
 
-    if (!values[QStringLiteral("Kilometers")].isUndefined()) {
-        double odometer = values[QStringLiteral("Kilometers")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::Kilometers)) {
+        double odometer = telemetry.value(ProformWifiTelemetry::Kilometers);
         Distance = odometer;
         emit debug("Current Distance: " + QString::number(odometer));
-    } else if (!values[QStringLiteral("Chilometri")].isUndefined()) {
-        double odometer = values[QStringLiteral("Chilometri")].toString().toDouble();
+    } else if (telemetry.has(ProformWifiTelemetry::Chilometri)) {
+        double odometer = telemetry.value(ProformWifiTelemetry::Chilometri);
         Distance = odometer;
         emit debug("Current Distance: " + QString::number(odometer));
     }
 
-    if (!values[QStringLiteral("RPM")].isUndefined()) {
-        double rpm = values[QStringLiteral("RPM")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::Rpm)) {
+        double rpm = telemetry.value(ProformWifiTelemetry::Rpm);
         Cadence = rpm;
         emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
 
@@ -213,40 +208,40 @@ void proformwifitreadmill::characteristicChanged(const QString &newValue) {
         }
     }
 
-    if (!values[QStringLiteral("Current Watts")].isUndefined()) {
-        double watt = values[QStringLiteral("Current Watts")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::CurrentWatts)) {
+        double watt = telemetry.value(ProformWifiTelemetry::CurrentWatts);
         m_watts = watt;
         emit debug(QStringLiteral("Current Watt: ") + QString::number(watts()));
-    } else if (!values[QStringLiteral("Watt attuali")].isUndefined()) {
-        double watt = values[QStringLiteral("Watt attuali")].toString().toDouble();
+    } else if (telemetry.has(ProformWifiTelemetry::WattAttuali)) {
+        double watt = telemetry.value(ProformWifiTelemetry::WattAttuali);
         m_watts = watt;
         emit debug(QStringLiteral("Current Watt: ") + QString::number(watts()));
     }
 
-    if (!values[QStringLiteral("Actual Incline")].isUndefined()) {
-        double incline = values[QStringLiteral("Actual Incline")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::ActualIncline)) {
+        double incline = telemetry.value(ProformWifiTelemetry::ActualIncline);
         Inclination = incline;
         emit debug(QStringLiteral("Current Inclination: ") + QString::number(incline));
     }
 
-    if (!values[QStringLiteral("Incline")].isUndefined()) {
-        double incline = values[QStringLiteral("Incline")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::Incline)) {
+        double incline = telemetry.value(ProformWifiTelemetry::Incline);
         Inclination = incline;
         emit debug(QStringLiteral("Current Inclination: ") + QString::number(incline));
     }
 
-    if (!values[QStringLiteral("Maximum Incline")].isUndefined()) {
-        max_incline_supported = values[QStringLiteral("Maximum Incline")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::MaximumIncline)) {
+        max_incline_supported = telemetry.value(ProformWifiTelemetry::MaximumIncline);
         emit debug(QStringLiteral("Maximum Incline Supported: ") + QString::number(max_incline_supported));
     }
 
-    if (!values[QStringLiteral("Minimum Incline")].isUndefined()) {
-        min_incline_supported = values[QStringLiteral("Minimum Incline")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::MinimumIncline)) {
+        min_incline_supported = telemetry.value(ProformWifiTelemetry::MinimumIncline);
         emit debug(QStringLiteral("Minimum Incline Supported: ") + QString::number(min_incline_supported));
     }    
 
-    if (!values[QStringLiteral("Maximum KPH")].isUndefined()) {
-        maximum_kph = values[QStringLiteral("Maximum KPH")].toString().toDouble();
+    if (telemetry.has(ProformWifiTelemetry::MaximumKph)) {
+        maximum_kph = telemetry.value(ProformWifiTelemetry::MaximumKph);
         emit debug(QStringLiteral("Maximum KPH: ") + QString::number(maximum_kph));
     }
 
@@ -265,8 +260,8 @@ void proformwifitreadmill::characteristicChanged(const QString &newValue) {
                                                                   m_pelotonResistance = (100 / 32) * Resistance.value();
                                                                   emit resistanceRead(Resistance.value());    */
 
-    if (!disable_hr_frommachinery && !values[QStringLiteral("Chest Pulse")].isUndefined()) {
-        Heart = values[QStringLiteral("Chest Pulse")].toString().toDouble();
+    if (!disable_hr_frommachinery && telemetry.has(ProformWifiTelemetry::ChestPulse)) {
+        Heart = telemetry.value(ProformWifiTelemetry::ChestPulse);
         // index += 1; // NOTE: clang-analyzer-deadcode.DeadStores
         emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
     }
@@ -34,6 +34,7 @@
 #include <QString>
 
 #include "treadmill.h"
+#include "devices/proformwifitelemetry.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -61,7 +62,7 @@ class proformwifitreadmill : public treadmill {
     void sendPoll();
     uint16_t watts();
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t counterPoll = 0;
     int8_t bikeResistanceOffset = 4;
     double bikeResistanceGain = 1.0;
@@ -71,6 +72,7 @@ class proformwifitreadmill : public treadmill {
 
     uint8_t sec1Update = 0;
     QString lastPacket;
+    ProformWifiTelemetry telemetry;
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
     uint8_t firstStateChanged = 0;
     uint16_t m_watts = 0;
@@ -52,7 +52,7 @@ class renphobike : public bike {
     void forceResistance(resistance_t requestResistance);
     void forcePower(int16_t requestPower);
 
-    QTimer *refresh;    
+    PollTimer *refresh;    
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
     QLowEnergyService *gattFTMSService = nullptr;
@@ -22,13 +22,13 @@ schwinn170bike::schwinn170bike(bool noWriteResistance, bool noHeartService, int8
                                double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &schwinn170bike::update);
+    connect(refresh, &PollTimer::timeout, this, &schwinn170bike::update);
     refresh->start(200ms);
 }
 
@@ -115,6 +115,7 @@ void schwinn170bike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void schwinn170bike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     double heart = 0.0;
 
@@ -162,8 +163,10 @@ void schwinn170bike::characteristicChanged(const QLowEnergyCharacteristic &chara
         return;
     }
     
-    if (newValue.length() != 14)
+    if (newValue.length() != 14) {
+        notificationParseError(characteristic);
         return;
+    }
 
     lastPacket = newValue;
 
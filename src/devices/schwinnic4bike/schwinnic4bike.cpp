@@ -22,11 +22,11 @@ using namespace std::chrono_literals;
 schwinnic4bike::schwinnic4bike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &schwinnic4bike::update);
+    connect(refresh, &PollTimer::timeout, this, &schwinnic4bike::update);
     refresh->start(200ms);
 }
 /*
@@ -116,6 +116,7 @@ void schwinnic4bike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void schwinnic4bike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     double heart = 0.0;
 
@@ -50,7 +50,7 @@ class schwinnic4bike : public bike {
     void startDiscover();
     uint16_t watts() override;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService *gattCommunicationChannelService;
     QLowEnergyCharacteristic gattNotify1Characteristic;
@@ -21,11 +21,11 @@ using namespace std::chrono_literals;
 shuaa5treadmill::shuaa5treadmill(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &shuaa5treadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &shuaa5treadmill::update);
     refresh->start(200ms);
 }
 
@@ -173,6 +173,7 @@ void shuaa5treadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void shuaa5treadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                             const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     double heart = 0; // NOTE : Should be initialized with a value to shut clang-analyzer's
                       // UndefinedBinaryOperatorResult
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
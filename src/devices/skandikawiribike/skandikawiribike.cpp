@@ -17,7 +17,7 @@ skandikawiribike::skandikawiribike(bool noWriteResistance, bool noHeartService,
                                    double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
 
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
@@ -25,7 +25,7 @@ skandikawiribike::skandikawiribike(bool noWriteResistance, bool noHeartService,
     this->bikeResistanceOffset = bikeResistanceOffset;
 
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &skandikawiribike::update);
+    connect(refresh, &PollTimer::timeout, this, &skandikawiribike::update);
     refresh->start(300ms);
 }
 
@@ -183,6 +183,7 @@ char *skandikawiribike::itoa(int num, char *buffer, int base) {
 
 void skandikawiribike::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
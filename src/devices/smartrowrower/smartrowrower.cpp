@@ -25,13 +25,13 @@ smartrowrower::smartrowrower(bool noWriteResistance, bool noHeartService, int8_t
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &smartrowrower::update);
+    connect(refresh, &PollTimer::timeout, this, &smartrowrower::update);
     refresh->start(200ms);
 }
 
@@ -184,6 +184,7 @@ double smartrowrower::bikeResistanceToPeloton(double resistance) {
 }
 
 void smartrowrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -195,8 +196,10 @@ void smartrowrower::characteristicChanged(const QLowEnergyCharacteristic &charac
 
     lastPacket = newValue;
 
-    if (newValue.length() != 17)
+    if (newValue.length() != 17) {
+        notificationParseError(characteristic);
         return;
+    }
 
     double distance = GetDistanceFromPacket(newValue);
     QTime localTime;
@@ -24,7 +24,7 @@ smartspin2k::smartspin2k(bool noWriteResistance, bool noHeartService, resistance
     Speed.setType(metric::METRIC_SPEED);
     this->max_resistance = max_resistance;
     this->parentDevice = parentDevice;
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
 
@@ -35,7 +35,7 @@ smartspin2k::smartspin2k(bool noWriteResistance, bool noHeartService, resistance
     if (!r)
         qDebug() << "SS2K UDP Socket Failed!";
     connect(udpSocket, &QUdpSocket::readyRead, this, &smartspin2k::readPendingDatagrams);
-    connect(refresh, &QTimer::timeout, this, &smartspin2k::update);
+    connect(refresh, &PollTimer::timeout, this, &smartspin2k::update);
     refresh->start(200ms);
 }
 
@@ -323,6 +323,7 @@ void smartspin2k::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void smartspin2k::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
 
     Q_UNUSED(characteristic);
 
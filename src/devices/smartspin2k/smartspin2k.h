@@ -54,7 +54,7 @@ class smartspin2k : public bike {
     void setShiftStep(uint16_t);
     void lowInit(resistance_t resistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QUdpSocket *udpSocket = new QUdpSocket();
 
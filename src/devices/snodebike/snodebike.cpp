@@ -22,11 +22,11 @@ using namespace std::chrono_literals;
 snodebike::snodebike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &snodebike::update);
+    connect(refresh, &PollTimer::timeout, this, &snodebike::update);
     refresh->start(200ms);
 }
 /*
@@ -113,6 +113,7 @@ void snodebike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void snodebike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     double heart = 0.0;
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
@@ -24,13 +24,13 @@ solebike::solebike(bool noWriteResistance, bool noHeartService, int8_t bikeResis
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &solebike::update);
+    connect(refresh, &PollTimer::timeout, this, &solebike::update);
     refresh->start(300ms);
 }
 
@@ -220,6 +220,7 @@ double solebike::bikeResistanceToPeloton(double resistance) {
 }
 
 void solebike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -246,6 +247,7 @@ void solebike::characteristicChanged(const QLowEnergyCharacteristic &characteris
     }
 
     if (newValue.length() < 20) {
+        notificationParseError(characteristic);
         return;
     }
 
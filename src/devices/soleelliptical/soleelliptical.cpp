@@ -19,7 +19,7 @@ soleelliptical::soleelliptical(bool noWriteResistance, bool noHeartService, bool
                                int8_t bikeResistanceOffset, double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
 
     this->testResistance = testResistance;
     this->noWriteResistance = noWriteResistance;
@@ -28,7 +28,7 @@ soleelliptical::soleelliptical(bool noWriteResistance, bool noHeartService, bool
     this->bikeResistanceOffset = bikeResistanceOffset;
 
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &soleelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &soleelliptical::update);
     refresh->start(300ms);
 }
 
@@ -299,6 +299,7 @@ void soleelliptical::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void soleelliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
 
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
@@ -331,6 +332,7 @@ void soleelliptical::characteristicChanged(const QLowEnergyCharacteristic &chara
     }
 
     if (newValue.length() < 20) {
+        notificationParseError(characteristic);
         return;
     }
 
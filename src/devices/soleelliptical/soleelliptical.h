@@ -50,7 +50,7 @@ class soleelliptical : public elliptical {
     void startDiscover();
     uint16_t watts();
 
-    QTimer *refresh;
+    PollTimer *refresh;
     uint8_t firstVirtual = 0;
     uint8_t counterPoll = 0;
 
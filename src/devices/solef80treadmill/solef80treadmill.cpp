@@ -33,11 +33,11 @@ solef80treadmill::solef80treadmill(bool noWriteResistance, bool noHeartService)
 
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &solef80treadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &solef80treadmill::update);
     refresh->start(300ms);
 }
 
@@ -486,6 +486,7 @@ void solef80treadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void solef80treadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     double heart = 0; // NOTE : Should be initialized with a value to shut clang-analyzer's
                       // UndefinedBinaryOperatorResult
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
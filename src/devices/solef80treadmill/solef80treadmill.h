@@ -50,7 +50,7 @@ class solef80treadmill : public treadmill {
     void startDiscover();
     void btinit();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
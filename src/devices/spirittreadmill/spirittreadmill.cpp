@@ -18,9 +18,9 @@ using namespace std::chrono_literals;
 spirittreadmill::spirittreadmill() {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &spirittreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &spirittreadmill::update);
     refresh->start(200ms);
 }
 
@@ -237,6 +237,7 @@ void spirittreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void spirittreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                             const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -248,6 +249,7 @@ void spirittreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
 
     lastPacket = newValue;
     if (newValue.length() != 18) {
+        notificationParseError(characteristic);
         return;
     }
 
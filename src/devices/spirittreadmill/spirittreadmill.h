@@ -48,7 +48,7 @@ class spirittreadmill : public treadmill {
                              bool wait_for_response);
     void startDiscover();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t firstVirtualTreadmill = 0;
     bool firstCharChanged = true;
@@ -17,11 +17,11 @@ using namespace std::chrono_literals;
 sportsplusbike::sportsplusbike(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &sportsplusbike::update);
+    connect(refresh, &PollTimer::timeout, this, &sportsplusbike::update);
     refresh->start(200ms);
 }
 
@@ -120,6 +120,7 @@ void sportsplusbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -133,6 +134,7 @@ void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &chara
 
     lastPacket = newValue;
     if (newValue.length() != 12) {
+        notificationParseError(characteristic);
         return;
     }
 
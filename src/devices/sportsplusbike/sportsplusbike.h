@@ -50,7 +50,7 @@ class sportsplusbike : public bike {
     uint16_t watts() override;
     double GetWattFromPacket(const QByteArray &packet);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
 
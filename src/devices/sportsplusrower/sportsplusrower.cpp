@@ -17,11 +17,11 @@ using namespace std::chrono_literals;
 sportsplusrower::sportsplusrower(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &sportsplusrower::update);
+    connect(refresh, &PollTimer::timeout, this, &sportsplusrower::update);
     refresh->start(200ms);
 }
 
@@ -116,6 +116,7 @@ void sportsplusrower::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void sportsplusrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -128,6 +129,7 @@ void sportsplusrower::characteristicChanged(const QLowEnergyCharacteristic &char
 
     lastPacket = newValue;
     if (newValue.length() != 12) {
+        notificationParseError(characteristic);
         return;
     }
 
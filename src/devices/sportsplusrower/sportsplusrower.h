@@ -48,7 +48,7 @@ class sportsplusrower : public rower {
     uint16_t watts() override;
     double GetWattFromPacket(const QByteArray &packet);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
 
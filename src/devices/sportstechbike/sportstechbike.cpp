@@ -18,13 +18,13 @@ sportstechbike::sportstechbike(bool noWriteResistance, bool noHeartService, int8
                                double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &sportstechbike::update);
+    connect(refresh, &PollTimer::timeout, this, &sportstechbike::update);
     refresh->start(200ms);
 }
 
@@ -119,6 +119,7 @@ void sportstechbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void sportstechbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -131,6 +132,7 @@ void sportstechbike::characteristicChanged(const QLowEnergyCharacteristic &chara
 
     lastPacket = newValue;
     if (newValue.length() != 20) {
+        notificationParseError(characteristic);
         return;
     }
 
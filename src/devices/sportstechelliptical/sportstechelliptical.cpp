@@ -18,13 +18,13 @@ sportstechelliptical::sportstechelliptical(bool noWriteResistance, bool noHeartS
                                double ellipticalResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->ellipticalResistanceGain = ellipticalResistanceGain;
     this->ellipticalResistanceOffset = ellipticalResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &sportstechelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &sportstechelliptical::update);
     refresh->start(200ms);
 }
 
@@ -119,6 +119,7 @@ void sportstechelliptical::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void sportstechelliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -131,6 +132,7 @@ void sportstechelliptical::characteristicChanged(const QLowEnergyCharacteristic
 
     lastPacket = newValue;
     if (newValue.length() != 20) {
+        notificationParseError(characteristic);
         return;
     }
 
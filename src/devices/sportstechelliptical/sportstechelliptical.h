@@ -53,7 +53,7 @@ class sportstechelliptical : public elliptical {
     double GetWattFromPacket(const QByteArray &packet);
     double GetCadenceFromPacket(const QByteArray &packet);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     bool noWriteResistance = false;
     bool noHeartService = false;
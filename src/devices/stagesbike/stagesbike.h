@@ -56,7 +56,7 @@ class stagesbike : public bike {
     QByteArray setBrakeLevel(double level);
     QByteArray setSimulationMode(double grade, double crr, double wrc, double windSpeedKPH, double draftingFactor);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
 
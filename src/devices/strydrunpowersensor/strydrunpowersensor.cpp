@@ -28,12 +28,12 @@ strydrunpowersensor::strydrunpowersensor(bool noWriteResistance, bool noHeartSer
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->noVirtualDevice = noVirtualDevice;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &strydrunpowersensor::update);
+    connect(refresh, &PollTimer::timeout, this, &strydrunpowersensor::update);
     refresh->start(200ms);
 }
 /*
@@ -103,6 +103,7 @@ void strydrunpowersensor::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void strydrunpowersensor::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                 const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     qDebug() << "<<" << characteristic.uuid() << newValue.toHex(' ') << newValue.length();
     Q_UNUSED(characteristic);
     QDateTime now = QDateTime::currentDateTime();
@@ -45,7 +45,7 @@ class strydrunpowersensor : public treadmill {
     void startDiscover();
     uint16_t watts();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     // QLowEnergyCharacteristic gattNotify1Characteristic;
@@ -18,11 +18,11 @@ using namespace std::chrono_literals;
 
 tacxneo2::tacxneo2(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &tacxneo2::update);
+    connect(refresh, &PollTimer::timeout, this, &tacxneo2::update);
     refresh->start(200ms);
 }
 
@@ -181,6 +181,7 @@ void tacxneo2::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void tacxneo2::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
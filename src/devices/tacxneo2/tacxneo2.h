@@ -49,7 +49,7 @@ class tacxneo2 : public bike {
     double bikeResistanceToPeloton(double resistance);
     void setUserConfiguration(double wheelDiameter, double gearRatio);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     const int max_resistance = 100;
 
@@ -22,11 +22,11 @@ using namespace std::chrono_literals;
 technogymmyruntreadmill::technogymmyruntreadmill(bool noWriteResistance, bool noHeartService) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &technogymmyruntreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &technogymmyruntreadmill::update);
     refresh->start(200ms);
 }
 
@@ -257,6 +257,7 @@ void technogymmyruntreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void technogymmyruntreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                     const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     double heart = 0; // NOTE : Should be initialized with a value to shut clang-analyzer's
                       // UndefinedBinaryOperatorResult
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
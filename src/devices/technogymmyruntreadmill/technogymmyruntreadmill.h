@@ -52,7 +52,7 @@ class technogymmyruntreadmill : public treadmill {
     void startDiscover();
     void btinit();
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
@@ -11,9 +11,9 @@ using namespace std::chrono_literals;
 technogymmyruntreadmillrfcomm::technogymmyruntreadmillrfcomm() {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &technogymmyruntreadmillrfcomm::update);
+    connect(refresh, &PollTimer::timeout, this, &technogymmyruntreadmillrfcomm::update);
     refresh->start(1s);
 }
 
@@ -55,7 +55,7 @@ class technogymmyruntreadmillrfcomm : public treadmill {
     QBluetoothSocket *socket = nullptr;
 
 
-    QTimer *refresh;
+    PollTimer *refresh;
     bool initDone = false;
     volatile bool found = false;
 
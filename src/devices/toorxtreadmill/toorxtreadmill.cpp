@@ -11,9 +11,9 @@ using namespace std::chrono_literals;
 toorxtreadmill::toorxtreadmill() {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &toorxtreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &toorxtreadmill::update);
     refresh->start(1s);
 }
 
@@ -49,7 +49,7 @@ class toorxtreadmill : public treadmill {
     QBluetoothServiceInfo serialPortService;
     QBluetoothSocket *socket = nullptr;
 
-    QTimer *refresh;
+    PollTimer *refresh;
     bool initDone = false;
 
     bool MASTERT409 = false;
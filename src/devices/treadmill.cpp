@@ -5,6 +5,8 @@
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
 #endif
+#include "inclinationoverride.h"
+#include "speedpowermodel.h"
 #include <QSettings>
 
 treadmill::treadmill() {}
@@ -253,180 +255,13 @@ void treadmill::verticalOscillationSensor(double verticalOscillation) {
 }
 
 double treadmill::treadmillInclinationOverrideReverse(double Inclination) {
-    for (int i = 0; i <= 15 * 2; i++) {
-        if (treadmillInclinationOverride(((double)(i)) / 2.0) <= Inclination &&
-            treadmillInclinationOverride(((double)(i + 1)) / 2.0) > Inclination) {
-            qDebug() << QStringLiteral("treadmillInclinationOverrideReverse")
-                     << treadmillInclinationOverride(((double)(i)) / 2.0)
-                     << treadmillInclinationOverride(((double)(i + 1)) / 2.0) << Inclination << i;
-            return ((double)i) / 2.0;
-        }
-    }
-
-    // if the inclination is negative, since the table consider only positive values, I return the actual value
-    if(Inclination < 0)
-        return Inclination;
-    else if (Inclination < treadmillInclinationOverride(0))
-        return treadmillInclinationOverride(0);
-    else
-        return treadmillInclinationOverride(15);
+    double r = InclinationOverride::fromSettings().reverse(Inclination);
+    qDebug() << QStringLiteral("treadmillInclinationOverrideReverse") << Inclination << r;
+    return r;
 }
 
 double treadmill::treadmillInclinationOverride(double Inclination) {
-    QSettings settings;
-
-    double treadmill_inclination_ovveride_gain = settings
-                                                     .value(QZSettings::treadmill_inclination_ovveride_gain,
-                                                            QZSettings::default_treadmill_inclination_ovveride_gain)
-                                                     .toDouble();
-    double treadmill_inclination_ovveride_offset = settings
-                                                       .value(QZSettings::treadmill_inclination_ovveride_offset,
-                                                              QZSettings::default_treadmill_inclination_ovveride_offset)
-                                                       .toDouble();
-
-    Inclination = Inclination * treadmill_inclination_ovveride_gain;
-    Inclination = Inclination + treadmill_inclination_ovveride_offset;
-
-    int inc = Inclination * 10;
-    qDebug() << "treadmillInclinationOverride" << Inclination << inc;
-    switch (inc) {
-    case 0:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_0, QZSettings::default_treadmill_inclination_override_0)
-            .toDouble();
-    case 5:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_05, QZSettings::default_treadmill_inclination_override_05)
-            .toDouble();
-    case 10:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_10, QZSettings::default_treadmill_inclination_override_10)
-            .toDouble();
-    case 15:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_15, QZSettings::default_treadmill_inclination_override_15)
-            .toDouble();
-    case 20:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_20, QZSettings::default_treadmill_inclination_override_20)
-            .toDouble();
-    case 25:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_25, QZSettings::default_treadmill_inclination_override_25)
-            .toDouble();
-    case 30:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_30, QZSettings::default_treadmill_inclination_override_30)
-            .toDouble();
-    case 35:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_35, QZSettings::default_treadmill_inclination_override_35)
-            .toDouble();
-    case 40:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_40, QZSettings::default_treadmill_inclination_override_40)
-            .toDouble();
-    case 45:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_45, QZSettings::default_treadmill_inclination_override_45)
-            .toDouble();
-    case 50:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_50, QZSettings::default_treadmill_inclination_override_50)
-            .toDouble();
-    case 55:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_55, QZSettings::default_treadmill_inclination_override_55)
-            .toDouble();
-    case 60:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_60, QZSettings::default_treadmill_inclination_override_60)
-            .toDouble();
-    case 65:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_65, QZSettings::default_treadmill_inclination_override_65)
-            .toDouble();
-    case 70:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_70, QZSettings::default_treadmill_inclination_override_70)
-            .toDouble();
-    case 75:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_75, QZSettings::default_treadmill_inclination_override_75)
-            .toDouble();
-    case 80:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_80, QZSettings::default_treadmill_inclination_override_80)
-            .toDouble();
-    case 85:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_85, QZSettings::default_treadmill_inclination_override_85)
-            .toDouble();
-    case 90:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_90, QZSettings::default_treadmill_inclination_override_90)
-            .toDouble();
-    case 95:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_95, QZSettings::default_treadmill_inclination_override_95)
-            .toDouble();
-    case 100:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_100,
-                   QZSettings::default_treadmill_inclination_override_100)
-            .toDouble();
-    case 105:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_105,
-                   QZSettings::default_treadmill_inclination_override_105)
-            .toDouble();
-    case 110:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_110,
-                   QZSettings::default_treadmill_inclination_override_110)
-            .toDouble();
-    case 115:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_115,
-                   QZSettings::default_treadmill_inclination_override_115)
-            .toDouble();
-    case 120:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_120,
-                   QZSettings::default_treadmill_inclination_override_120)
-            .toDouble();
-    case 125:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_125,
-                   QZSettings::default_treadmill_inclination_override_125)
-            .toDouble();
-    case 130:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_130,
-                   QZSettings::default_treadmill_inclination_override_130)
-            .toDouble();
-    case 135:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_135,
-                   QZSettings::default_treadmill_inclination_override_135)
-            .toDouble();
-    case 140:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_140,
-                   QZSettings::default_treadmill_inclination_override_140)
-            .toDouble();
-    case 145:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_145,
-                   QZSettings::default_treadmill_inclination_override_145)
-            .toDouble();
-    case 150:
-        return settings
-            .value(QZSettings::treadmill_inclination_override_150,
-                   QZSettings::default_treadmill_inclination_override_150)
-            .toDouble();
-    }
-    return Inclination;
+    return InclinationOverride::fromSettings().apply(Inclination);
 }
 
 void treadmill::evaluateStepCount() {
@@ -470,17 +305,14 @@ bool treadmill::simulateInclinationWithSpeed() {
             .value(QZSettings::treadmill_simulate_inclination_with_speed,
                    QZSettings::default_treadmill_simulate_inclination_with_speed)
             .toBool();
-    double w = settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
     if (treadmill_simulate_inclination_with_speed) {
         if (requestInclination != -100) {
             qDebug() << QStringLiteral("treadmill_simulate_inclination_with_speed enabled!") << requestInclination
                      << requestSpeed << m_lastRawSpeedRequested;
             if (requestSpeed != -1) {
-                requestSpeed =
-                    wattsCalc(w, requestSpeed, requestInclination) * requestSpeed / wattsCalc(w, requestSpeed, 0);
+                requestSpeed = SpeedPowerModel::runningFlatSpeed(requestSpeed, requestInclination);
             } else if (m_lastRawSpeedRequested != -1) {
-                requestSpeed = wattsCalc(w, m_lastRawSpeedRequested, requestInclination) * m_lastRawSpeedRequested /
-                               wattsCalc(w, m_lastRawSpeedRequested, 0);
+                requestSpeed = SpeedPowerModel::runningFlatSpeed(m_lastRawSpeedRequested, requestInclination);
             }
         }
         requestInclination = -100;
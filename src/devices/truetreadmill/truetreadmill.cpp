@@ -28,9 +28,9 @@ truetreadmill::truetreadmill(uint32_t pollDeviceTime, bool noConsole, bool noHea
         lastInclination = forceInitInclination;
     }
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &truetreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &truetreadmill::update);
     refresh->start(pollDeviceTime);
 }
 
@@ -139,6 +139,7 @@ void truetreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void truetreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
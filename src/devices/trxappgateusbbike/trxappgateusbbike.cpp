@@ -20,13 +20,13 @@ trxappgateusbbike::trxappgateusbbike(bool noWriteResistance, bool noHeartService
                                      double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &trxappgateusbbike::update);
+    connect(refresh, &PollTimer::timeout, this, &trxappgateusbbike::update);
     refresh->start(200ms);
 }
 
@@ -207,6 +207,7 @@ void trxappgateusbbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void trxappgateusbbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                               const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     double heart = 0;
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
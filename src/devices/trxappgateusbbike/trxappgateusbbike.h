@@ -59,7 +59,7 @@ class trxappgateusbbike : public bike {
     double GetCadenceFromPacket(const QByteArray &packet);
     uint16_t wattsFromResistance(double resistance);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
 #ifdef Q_OS_IOS
     lockscreen *h = 0;
@@ -19,13 +19,13 @@ trxappgateusbelliptical::trxappgateusbelliptical(bool noWriteResistance, bool no
                                                  double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &trxappgateusbelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &trxappgateusbelliptical::update);
     refresh->start(200ms);
 }
 
@@ -159,6 +159,7 @@ double trxappgateusbelliptical::GetWattFromPacket(const QByteArray &packet) {
 
 void trxappgateusbelliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                               const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -51,7 +51,7 @@ class trxappgateusbelliptical : public elliptical {
     double GetCadenceFromPacket(const QByteArray &packet);
     double GetWattFromPacket(const QByteArray &packet);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService* gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharacteristic;
@@ -19,13 +19,13 @@ trxappgateusbrower::trxappgateusbrower(bool noWriteResistance, bool noHeartServi
                                                  double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &trxappgateusbrower::update);
+    connect(refresh, &PollTimer::timeout, this, &trxappgateusbrower::update);
     refresh->start(200ms);
 }
 
@@ -147,6 +147,7 @@ double trxappgateusbrower::GetWattFromPacket(const QByteArray &packet) {
 
 void trxappgateusbrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                               const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -50,7 +50,7 @@ class trxappgateusbrower : public rower {
     double GetCadenceFromPacket(const QByteArray &packet);
     double GetWattFromPacket(const QByteArray &packet);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QLowEnergyService* gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharacteristic;
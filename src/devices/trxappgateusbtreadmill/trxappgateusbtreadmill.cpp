@@ -17,9 +17,9 @@ using namespace std::chrono_literals;
 trxappgateusbtreadmill::trxappgateusbtreadmill() {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &trxappgateusbtreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &trxappgateusbtreadmill::update);
     refresh->start(200ms);
 }
 
@@ -214,6 +214,7 @@ void trxappgateusbtreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void trxappgateusbtreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                    const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -52,7 +52,7 @@ class trxappgateusbtreadmill : public treadmill {
     void startDiscover();
     double DistanceCalculated = 0;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     uint8_t firstVirtualTreadmill = 0;
     bool firstCharChanged = true;
@@ -24,13 +24,13 @@ ultrasportbike::ultrasportbike(bool noWriteResistance, bool noHeartService, int8
 #endif
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &ultrasportbike::update);
+    connect(refresh, &PollTimer::timeout, this, &ultrasportbike::update);
     refresh->start(300ms);
 }
 
@@ -159,6 +159,7 @@ double ultrasportbike::bikeResistanceToPeloton(double resistance) {
 }
 
 void ultrasportbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -171,6 +172,7 @@ void ultrasportbike::characteristicChanged(const QLowEnergyCharacteristic &chara
     lastPacket = newValue;
 
     if (newValue.length() != 18) {
+        notificationParseError(characteristic);
         return;
     }
 
@@ -20,8 +20,8 @@ wahookickrheadwind::wahookickrheadwind(bluetoothdevice *parentDevice) {
 #endif
     this->parentDevice = parentDevice;
 
-    refresh = new QTimer(this);
-    connect(refresh, &QTimer::timeout, this, &wahookickrheadwind::update);
+    refresh = new PollTimer(this, PollTimer::Notified);
+    connect(refresh, &PollTimer::timeout, this, &wahookickrheadwind::update);
     refresh->start(1000ms);
 }
 
@@ -77,6 +77,7 @@ void wahookickrheadwind::disconnectBluetooth() {
 
 void wahookickrheadwind::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     Q_UNUSED(characteristic);
     emit packetReceived();
 
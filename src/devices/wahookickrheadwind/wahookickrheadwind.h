@@ -51,7 +51,7 @@ class wahookickrheadwind : public bluetoothdevice {
     bool initDone = false;
     bool initRequest = false;
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
   signals:
     void disconnected();
@@ -23,13 +23,13 @@ wahookickrsnapbike::wahookickrsnapbike(bool noWriteResistance, bool noHeartServi
 
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &wahookickrsnapbike::update);
+    connect(refresh, &PollTimer::timeout, this, &wahookickrsnapbike::update);
     QSettings settings;
     refresh->start(settings.value(QZSettings::poll_device_time, QZSettings::default_poll_device_time).toInt());
     wheelCircumference::GearTable g;
@@ -356,6 +356,7 @@ uint16_t wahookickrsnapbike::wattsFromResistance(double resistance) {
 
 void wahookickrsnapbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                                const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -661,7 +662,7 @@ void wahookickrsnapbike::stateChanged(QLowEnergyService::ServiceState state) {
     }
 
     // ******************************************* virtual bike init *************************************
-    if (!firstStateChanged && !this->hasVirtualDevice()
+    if (!firstStateChanged && !this->hasVirtualDevice() && !this->isGymStation()
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
         && !h
@@ -753,7 +754,7 @@ void wahookickrsnapbike::serviceScanDone(void) {
 
     qDebug() << "zwift service found " << zwift_found << "wahoo service found" << wahoo_found;
 
-    if(zwift_found && !wahoo_found) {
+    if(zwift_found && !wahoo_found && !isGymStation()) {
         QSettings settings;
         settings.setValue(QZSettings::ftms_bike, bluetoothDevice.name());
         settings.sync();
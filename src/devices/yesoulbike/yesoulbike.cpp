@@ -18,13 +18,13 @@ yesoulbike::yesoulbike(bool noWriteResistance, bool noHeartService, int8_t bikeR
                        double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Notified);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &yesoulbike::update);
+    connect(refresh, &PollTimer::timeout, this, &yesoulbike::update);
     refresh->start(200ms);
 }
 
@@ -110,6 +110,7 @@ void yesoulbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void yesoulbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -122,6 +123,7 @@ void yesoulbike::characteristicChanged(const QLowEnergyCharacteristic &character
     lastPacket = newValue;
 
     if (newValue.length() != 12) {
+        notificationParseError(characteristic);
         return;
     }
 
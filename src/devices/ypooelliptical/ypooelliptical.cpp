@@ -20,13 +20,13 @@ ypooelliptical::ypooelliptical(bool noWriteResistance, bool noHeartService, int8
                                double bikeResistanceGain) {
     m_watt.setType(metric::METRIC_WATT);
     Speed.setType(metric::METRIC_SPEED);
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     this->noWriteResistance = noWriteResistance;
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &ypooelliptical::update);
+    connect(refresh, &PollTimer::timeout, this, &ypooelliptical::update);
     refresh->start(200ms);
 
     // this bike doesn't send resistance, so I have to use the default value
@@ -202,6 +202,7 @@ void ypooelliptical::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void ypooelliptical::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newvalue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     QSettings settings;
     QString heartRateBeltName =
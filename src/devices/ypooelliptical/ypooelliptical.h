@@ -51,7 +51,7 @@ class ypooelliptical : public elliptical {
     void forceResistance(resistance_t requestResistance);
     void forceInclination(double inclination);
 
-    QTimer *refresh;
+    PollTimer *refresh;
 
     QList<QLowEnergyService *> gattCommunicationChannelService;
     QLowEnergyCharacteristic gattWriteCharControlPointId;
@@ -24,9 +24,9 @@ ziprotreadmill::ziprotreadmill(uint32_t pollDeviceTime, bool noConsole, bool noH
     if (forceInitInclination > 0)
         lastInclination = forceInitInclination;
 
-    refresh = new QTimer(this);
+    refresh = new PollTimer(this, PollTimer::Polled);
     initDone = false;
-    connect(refresh, &QTimer::timeout, this, &ziprotreadmill::update);
+    connect(refresh, &PollTimer::timeout, this, &ziprotreadmill::update);
     refresh->start(500ms);
 }
 
@@ -173,6 +173,7 @@ void ziprotreadmill::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void ziprotreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    auto ingress = notificationReceived(characteristic);
     QDateTime now = QDateTime::currentDateTime();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
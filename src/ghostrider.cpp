@@ -0,0 +1,166 @@
+#include "ghostrider.h"
+#include "devices/bluetoothdevice.h"
+#include "qfit.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <algorithm>
+#include <math.h>
+
+namespace {
+
+// a gap slower than this is a pause
+const double pauseSpeed = 1; // km/h
+
+// a record of a FIT activity is about 30 bytes
+const int bytesPerRecord = 30;
+
+} // namespace
+
+GhostRider::GhostRider(QObject *parent) : QObject(parent) {}
+
+GhostRider *GhostRider::instance() {
+    static GhostRider *ghost = new GhostRider();
+    return ghost;
+}
+
+void GhostRider::clear() {
+    m_seconds.clear();
+    m_distance.clear();
+    m_watts.clear();
+    m_name.clear();
+    m_lastRaw = -1;
+    m_pausedSeconds = 0;
+}
+
+void GhostRider::append(double seconds, double distance, double watts) {
+    // repeated or out of order
+    if (m_lastRaw >= 0 && seconds <= m_lastRaw)
+        return;
+    double last = m_distance.isEmpty() ? 0 : m_distance.last();
+    if (!std::isfinite(distance) || distance < last)
+        distance = last;
+    double elapsed = m_lastRaw >= 0 ? seconds - m_lastRaw : 0;
+    if (elapsed > pauseSeconds && (distance - last) * 3600.0 / elapsed < pauseSpeed)
+        m_pausedSeconds += elapsed - 1;
+    m_lastRaw = seconds;
+
+    float t = seconds - m_pausedSeconds;
+    if (!m_seconds.isEmpty() && t <= m_seconds.last())
+        return;
+    m_seconds.append(t);
+    m_distance.append(distance);
+    m_watts.append((quint16)qBound(0.0, watts, 65534.0));
+}
+
+bool GhostRider::load(const QString &filename) {
+    QElapsedTimer timer;
+    timer.start();
+    clear();
+    m_seconds.reserve(QFileInfo(filename).size() / bytesPerRecord);
+    m_distance.reserve(m_seconds.capacity());
+    m_watts.reserve(m_seconds.capacity());
+
+    qint64 first = -1;
+    double lastSeconds = 0;
+    double distance = 0;
+    bool ok = qfit::open(filename, [&](const SessionLine &s) {
+        qint64 ms = s.time.toMSecsSinceEpoch();
+        if (first < 0)
+            first = ms;
+        double seconds = (ms - first) / 1000.0;
+        // no distance in the record: from the speed, for a second only after a pause
+        double d = s.distance;
+        if (!std::isfinite(d)) {
+            double elapsed = seconds - lastSeconds > pauseSeconds ? 1 : qMax(0.0, seconds - lastSeconds);
+            d = std::isfinite(s.speed) ? distance + s.speed * elapsed / 3600.0 : distance;
+        }
+        distance = qMax(distance, d);
+        lastSeconds = seconds;
+        // 0xFFFF is a record without power
+        append(seconds, distance, s.watt == 0xFFFF ? 0 : s.watt);
+    });
+    if (m_seconds.isEmpty()) {
+        qDebug() << "GhostRider: no records in" << filename;
+        clear();
+        return false;
+    }
+    if (!ok)
+        qDebug() << "GhostRider: truncated file, keeping the records read";
+
+    m_seconds.squeeze();
+    m_distance.squeeze();
+    m_watts.squeeze();
+    m_name = QFileInfo(filename).completeBaseName();
+    qDebug() << "GhostRider: loaded" << m_name << size() << "records," << length() << "km in" << duration()
+             << "s, in" << timer.elapsed() << "ms";
+    emit loaded();
+    return true;
+}
+
+double GhostRider::distanceAt(double seconds) const {
+    if (!isLoaded())
+        return 0;
+    auto it = std::upper_bound(m_seconds.constBegin(), m_seconds.constEnd(), (float)seconds);
+    if (it == m_seconds.constBegin())
+        return m_distance.first();
+    if (it == m_seconds.constEnd())
+        return m_distance.last();
+    int i = it - m_seconds.constBegin();
+    double f = (seconds - m_seconds.at(i - 1)) / (m_seconds.at(i) - m_seconds.at(i - 1));
+    return m_distance.at(i - 1) + (m_distance.at(i) - m_distance.at(i - 1)) * f;
+}
+
+double GhostRider::secondsAt(double distance) const {
+    if (!isLoaded() || distance > m_distance.last())
+        return -1;
+    auto it = std::lower_bound(m_distance.constBegin(), m_distance.constEnd(), (float)distance);
+    int i = it - m_distance.constBegin();
+    if (i == 0)
+        return m_seconds.first();
+    // the distance is strictly greater at i than at i - 1
+    double f = (distance - m_distance.at(i - 1)) / (m_distance.at(i) - m_distance.at(i - 1));
+    return m_seconds.at(i - 1) + (m_seconds.at(i) - m_seconds.at(i - 1)) * qBound(0.0, f, 1.0);
+}
+
+double GhostRider::wattsAt(double seconds) const {
+    if (!isLoaded())
+        return 0;
+    auto it = std::upper_bound(m_seconds.constBegin(), m_seconds.constEnd(), (float)seconds);
+    if (it == m_seconds.constBegin())
+        return m_watts.first();
+    return m_watts.at(it - m_seconds.constBegin() - 1);
+}
+
+GhostRider::Gap GhostRider::gap(double seconds, double distance, double watts) const {
+    Gap g;
+    if (!isLoaded())
+        return g;
+    g.valid = true;
+    g.meters = (distance - distanceAt(seconds)) * 1000.0;
+    double ghostSeconds = secondsAt(distance);
+    g.seconds = ghostSeconds < 0 ? NAN : ghostSeconds - seconds;
+    g.watts = watts - wattsAt(seconds);
+    return g;
+}
+
+GhostRider::Gap GhostRider::gap(bluetoothdevice *device) const {
+    if (!device)
+        return Gap();
+    return gap(QTime(0, 0, 0).msecsTo(device->elapsedTime()) / 1000.0, device->odometer(),
+               device->wattsMetric().value());
+}
+
+QString GhostRider::formatGap(double seconds) {
+    if (!std::isfinite(seconds))
+        return QStringLiteral("N/A");
+    int s = qRound(fabs(seconds));
+    QString sign = seconds < 0 && s > 0 ? QStringLiteral("-") : QStringLiteral("+");
+    if (s >= 3600)
+        return sign + QStringLiteral("%1:%2:%3")
+                          .arg(s / 3600)
+                          .arg((s / 60) % 60, 2, 10, QLatin1Char('0'))
+                          .arg(s % 60, 2, 10, QLatin1Char('0'));
+    return sign + QStringLiteral("%1:%2").arg(s / 60).arg(s % 60, 2, 10, QLatin1Char('0'));
+}
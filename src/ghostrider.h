@@ -0,0 +1,98 @@
+#ifndef GHOSTRIDER_H
+#define GHOSTRIDER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+class bluetoothdevice;
+
+/**
+ * @brief A previous activity to race against, loaded from a FIT file.
+ *
+ * The records are streamed out of the file into three parallel arrays (elapsed seconds, distance and power, 10
+ * bytes a record), with the pauses removed and the distance made non decreasing. Both the time and the distance
+ * are then sorted, so every lookup of the race is a binary search: O(log n) at every tick whatever the length of
+ * the activity.
+ */
+class GhostRider : public QObject {
+    Q_OBJECT
+
+  public:
+    struct Gap {
+        bool valid = false;
+        double seconds = 0; // ahead of the ghost in time at the same distance, NAN past the end of the ghost
+        double meters = 0;  // ahead of the ghost in distance at the same time
+        double watts = 0;   // more power than the ghost at the same time
+    };
+
+    // a record with no progress after this long is a pause: it's removed from the timeline
+    static const int pauseSeconds = 10;
+
+    explicit GhostRider(QObject *parent = nullptr);
+
+    /**
+     * @brief instance The ghost of the app, shared by the tiles, the templates and MQTT.
+     */
+    static GhostRider *instance();
+
+    /**
+     * @brief load Replaces the ghost with the activity of a FIT file. Returns false, leaving no ghost, if the file
+     * can't be read or has no records.
+     */
+    bool load(const QString &filename);
+    void clear();
+
+    /**
+     * @brief append Adds a record at elapsed seconds: distance in km, power in watts.
+     */
+    void append(double seconds, double distance, double watts);
+
+    bool isLoaded() const { return !m_seconds.isEmpty(); }
+    QString name() const { return m_name; }
+    int size() const { return m_seconds.size(); }
+    double duration() const { return isLoaded() ? m_seconds.last() : 0; }
+    double length() const { return isLoaded() ? m_distance.last() : 0; }
+
+    /**
+     * @brief distanceAt The distance of the ghost in km after seconds, its total past the end.
+     */
+    double distanceAt(double seconds) const;
+
+    /**
+     * @brief secondsAt When the ghost reached distance, km, or -1 if it never did.
+     */
+    double secondsAt(double distance) const;
+
+    /**
+     * @brief wattsAt The power of the ghost after seconds.
+     */
+    double wattsAt(double seconds) const;
+
+    Gap gap(double seconds, double distance, double watts) const;
+
+    /**
+     * @brief gap The race of device against the ghost, by its elapsed time, distance and power.
+     */
+    Gap gap(bluetoothdevice *device) const;
+
+    /**
+     * @brief formatGap A time gap as +m:ss or -m:ss.
+     */
+    static QString formatGap(double seconds);
+
+  signals:
+    void loaded();
+
+  private:
+    QVector<float> m_seconds;
+    QVector<float> m_distance;
+    QVector<quint16> m_watts;
+    QString m_name;
+
+    // the state of the records being appended
+    double m_lastRaw = -1;
+    double m_pausedSeconds = 0;
+};
+
+#endif // GHOSTRIDER_H
@@ -0,0 +1,312 @@
+#include "gymmanager.h"
+#include "appdirs.h"
+#include "devices/bike.h"
+#include "devices/dircon/dirconmanager.h"
+#include "devices/fakebike/fakebike.h"
+#include "devices/ftmsbike/ftmsbike.h"
+#include "devices/wahookickrsnapbike/wahookickrsnapbike.h"
+#include "mqttpublisher.h"
+#include "qfit.h"
+#include "qzsettings.h"
+#include "trainprogram.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSettings>
+#include <QThread>
+#include <QTimer>
+#include <math.h>
+
+namespace {
+
+// between two searches of the trainers not found yet
+const int rescanMs = 5000;
+
+} // namespace
+
+QSet<QString> GymManager::reserved;
+
+GymStation::GymStation(const Config &config, int index, int8_t bikeResistanceOffset, double bikeResistanceGain)
+    : m_config(config), index(index), bikeResistanceOffset(bikeResistanceOffset),
+      bikeResistanceGain(bikeResistanceGain) {}
+
+void GymStation::start() {
+    if (m_device)
+        return;
+
+    if (GymManager::isBluetoothType(m_config.type)) {
+        qDebug() << "gym station" << m_config.name << "waiting for" << m_config.type << m_config.address << "in"
+                 << QThread::currentThread();
+        return;
+    }
+
+    m_device = GymManager::createDevice(m_config.type, bikeResistanceOffset, bikeResistanceGain);
+    if (!m_device) {
+        qDebug() << "gym station" << m_config.name << "unsupported device type" << m_config.type;
+        return;
+    }
+    qDebug() << "gym station" << m_config.name << "started in" << QThread::currentThread();
+    setupDevice();
+}
+
+void GymStation::assign(const QBluetoothDeviceInfo &info) {
+    if (m_device)
+        return;
+
+    m_device = GymManager::createDevice(m_config.type, bikeResistanceOffset, bikeResistanceGain);
+    if (!m_device)
+        return;
+    qDebug() << "gym station" << m_config.name << "connecting to" << info.name() << m_config.address << "in"
+             << QThread::currentThread();
+    setupDevice();
+    if (ftmsbike *ftms = qobject_cast<ftmsbike *>(m_device))
+        ftms->deviceDiscovered(info);
+    else if (wahookickrsnapbike *kickr = qobject_cast<wahookickrsnapbike *>(m_device))
+        kickr->deviceDiscovered(info);
+}
+
+void GymStation::setupDevice() {
+    m_device->setParent(this);
+    m_device->setGymStation(true);
+
+    QSettings settings;
+    if (settings.value(QZSettings::dircon_yes, QZSettings::default_dircon_yes).toBool()) {
+        // station 0 is the device of the bluetooth manager, if any
+        dircon = new DirconManager(m_device, bikeResistanceOffset, bikeResistanceGain, this, index + 1);
+        connect(dircon, &DirconManager::changeInclination, m_device, &bluetoothdevice::changeInclination);
+        // as the virtual bike does for the app's own FTMS bike
+        if (qobject_cast<ftmsbike *>(m_device))
+            connect(dircon, SIGNAL(ftmsCharacteristicChanged(QLowEnergyCharacteristic, QByteArray)), m_device,
+                    SLOT(ftmsCharacteristicChanged(QLowEnergyCharacteristic, QByteArray)));
+    }
+
+    QString mqtt_host = settings.value(QZSettings::mqtt_host, QZSettings::default_mqtt_host).toString();
+    if (!mqtt_host.isEmpty()) {
+        mqtt = new MQTTPublisher(
+            mqtt_host, settings.value(QZSettings::mqtt_port, QZSettings::default_mqtt_port).toInt(),
+            settings.value(QZSettings::mqtt_username, QZSettings::default_mqtt_username).toString(),
+            settings.value(QZSettings::mqtt_password, QZSettings::default_mqtt_password).toString(), nullptr,
+            m_config.name, this);
+        mqtt->setDevice(m_device);
+    }
+
+    if (!m_config.program.isEmpty()) {
+        program = trainprogram::load(m_config.program, nullptr, QFileInfo(m_config.program).suffix());
+        if (program) {
+            program->setParent(this);
+            program->setDevice(m_device);
+            connect(program, &trainprogram::changePower, m_device, &bluetoothdevice::changePower);
+            connect(program, &trainprogram::changeResistance, m_device, &bluetoothdevice::changeResistance);
+            connect(program, &trainprogram::changeInclination, m_device, &bluetoothdevice::changeInclination);
+            if (m_device->deviceType() == bluetoothdevice::BIKE) {
+                bike *b = (bike *)m_device;
+                connect(program, &trainprogram::changeCadence, b, &bike::changeCadence);
+                connect(program, &trainprogram::changeRequestedPelotonResistance, b,
+                        &bike::changeRequestedPelotonResistance);
+            }
+            program->restart();
+        } else {
+            qDebug() << "gym station" << m_config.name << "can't load" << m_config.program;
+        }
+    }
+
+    recorder = new QTimer(this);
+    connect(recorder, &QTimer::timeout, this, &GymStation::record);
+    recorder->start(1000);
+}
+
+void GymStation::record() {
+    double speed = m_device->currentSpeed().value();
+    if (speed > 0 && !isinf(speed))
+        m_device->addCurrentDistance1s(speed / 3600.0);
+
+    bool bikeDevice = m_device->deviceType() == bluetoothdevice::BIKE;
+    QTime elapsed = m_device->elapsedTime();
+    SessionLine s(speed, m_device->currentInclination().value(), m_device->currentDistance1s().value(),
+                  m_device->wattsMetric().value(), m_device->currentResistance().value(),
+                  bikeDevice ? ((bike *)m_device)->pelotonResistance().value() : 0,
+                  (uint8_t)m_device->currentHeart().value(), 0 /* pace, only bikes so far */,
+                  m_device->currentCadence().value(), m_device->calories().value(),
+                  m_device->elevationGain().value(),
+                  elapsed.second() + (elapsed.minute() * 60) + (elapsed.hour() * 3600), false, 0, 0, 0, 0,
+                  m_device->currentCordinate(), 0, 0, 0, 0);
+    if (bikeDevice) {
+        s.pedalSmoothness = ((bike *)m_device)->currentPedalSmoothness().value();
+        s.rightBalance = ((bike *)m_device)->currentRightBalance().value();
+    }
+    session.append(s);
+}
+
+void GymStation::stop() {
+    if (recorder)
+        recorder->stop();
+    if (!m_device || session.isEmpty())
+        return;
+
+    QString path = AppDirs::writable() + QStringLiteral("gym/");
+    QDir().mkpath(path);
+    QString filename = path + m_config.name + QStringLiteral("-") +
+                       QDateTime::currentDateTime().toString(QStringLiteral("yyyy-MM-dd hh-mm-ss")) +
+                       QStringLiteral(".fit");
+    qfit::save(filename, session, m_device->deviceType(), QFIT_PROCESS_NONE, FIT_SPORT_INVALID, m_config.name,
+               m_config.name);
+    qDebug() << "gym station" << m_config.name << "saved" << session.size() << "samples to" << filename;
+    session.clear();
+}
+
+GymManager::GymManager(const QList<GymStation::Config> &stations, int8_t bikeResistanceOffset,
+                       double bikeResistanceGain, int threads, QObject *parent)
+    : QObject(parent) {
+    if (stations.isEmpty())
+        return;
+
+    if (threads <= 0)
+        threads = QThread::idealThreadCount();
+    if (threads > stations.size())
+        threads = stations.size();
+    if (threads < 1)
+        threads = 1;
+
+    for (int i = 0; i < threads; i++) {
+        QThread *thread = new QThread(this);
+        thread->setObjectName(QStringLiteral("gym-%1").arg(i));
+        thread->start();
+        pool.append(thread);
+    }
+
+    for (int i = 0; i < stations.size(); i++) {
+        GymStation *station = new GymStation(stations.at(i), i, bikeResistanceOffset, bikeResistanceGain);
+        QThread *thread = pool.at(i % pool.size());
+        station->moveToThread(thread);
+        connect(thread, &QThread::finished, station, &QObject::deleteLater);
+        m_stations.append(station);
+        QMetaObject::invokeMethod(station, "start", Qt::QueuedConnection);
+
+        QString address = normalizedAddress(stations.at(i).address);
+        if (isBluetoothType(stations.at(i).type) && !address.isEmpty()) {
+            waiting.insert(address, station);
+            reserved.insert(address);
+        }
+    }
+    qDebug() << "gym mode:" << m_stations.size() << "stations on" << pool.size() << "threads";
+
+    if (!waiting.isEmpty()) {
+        discoveryAgent = new QBluetoothDeviceDiscoveryAgent(this);
+        connect(discoveryAgent, &QBluetoothDeviceDiscoveryAgent::deviceDiscovered, this,
+                &GymManager::deviceDiscovered);
+        connect(discoveryAgent, &QBluetoothDeviceDiscoveryAgent::deviceUpdated, this,
+                [this](const QBluetoothDeviceInfo &device, QBluetoothDeviceInfo::Fields) {
+                    deviceDiscovered(device);
+                });
+        // a search ends after a while, or fails without an adapter: again later, until every station has its trainer
+        connect(discoveryAgent, &QBluetoothDeviceDiscoveryAgent::finished, &rescan, QOverload<>::of(&QTimer::start));
+        connect(discoveryAgent, &QBluetoothDeviceDiscoveryAgent::canceled, &rescan, QOverload<>::of(&QTimer::start));
+        connect(discoveryAgent,
+                QOverload<QBluetoothDeviceDiscoveryAgent::Error>::of(&QBluetoothDeviceDiscoveryAgent::error), &rescan,
+                QOverload<>::of(&QTimer::start));
+        rescan.setSingleShot(true);
+        rescan.setInterval(rescanMs);
+        connect(&rescan, &QTimer::timeout, this, &GymManager::startDiscovery);
+        startDiscovery();
+    }
+}
+
+void GymManager::startDiscovery() {
+    if (waiting.isEmpty() || discoveryAgent->isActive())
+        return;
+    qDebug() << "gym mode: searching" << waiting.keys();
+    discoveryAgent->start(QBluetoothDeviceDiscoveryAgent::LowEnergyMethod);
+}
+
+void GymManager::deviceDiscovered(const QBluetoothDeviceInfo &device) {
+    GymStation *station = waiting.take(deviceId(device));
+    if (!station)
+        return;
+    qDebug() << "gym mode: found" << device.name() << "for" << station->config().name;
+    QMetaObject::invokeMethod(
+        station, [station, device]() { station->assign(device); }, Qt::QueuedConnection);
+    if (waiting.isEmpty()) {
+        rescan.stop();
+        discoveryAgent->stop();
+    }
+}
+
+GymManager::~GymManager() {
+    for (GymStation *station : qAsConst(m_stations))
+        reserved.remove(normalizedAddress(station->config().address));
+    for (GymStation *station : qAsConst(m_stations))
+        QMetaObject::invokeMethod(station, "stop", Qt::BlockingQueuedConnection);
+    for (QThread *thread : qAsConst(pool)) {
+        thread->quit();
+        thread->wait();
+    }
+}
+
+QList<GymStation::Config> GymManager::parseStations(const QString &spec) {
+    QList<GymStation::Config> stations;
+    const QStringList entries = spec.split(QLatin1Char(';'), Qt::SkipEmptyParts);
+    for (const QString &entry : entries) {
+        int equal = entry.indexOf(QLatin1Char('='));
+        GymStation::Config config;
+        config.name = entry.left(equal).trimmed();
+        QString rest = equal >= 0 ? entry.mid(equal + 1) : QString();
+        int comma = rest.indexOf(QLatin1Char(','));
+        QString trainer = rest.left(comma);
+        int at = trainer.indexOf(QLatin1Char('@'));
+        config.type = trainer.left(at).trimmed().toLower();
+        if (at >= 0)
+            config.address = normalizedAddress(trainer.mid(at + 1));
+        if (comma >= 0)
+            config.program = rest.mid(comma + 1).trimmed();
+
+        bool duplicated = false;
+        for (const GymStation::Config &c : qAsConst(stations))
+            duplicated |= c.name == config.name || (!config.address.isEmpty() && c.address == config.address);
+        bool supported = config.type == QStringLiteral("fakebike") || isBluetoothType(config.type);
+        // the name is a level of the MQTT topics of the station
+        if (equal <= 0 || config.name.isEmpty() || !supported || duplicated ||
+            (isBluetoothType(config.type) && config.address.isEmpty()) || config.name.contains(QLatin1Char('/')) ||
+            config.name.contains(QLatin1Char('+')) || config.name.contains(QLatin1Char('#'))) {
+            qDebug() << "gym station skipped:" << entry;
+            continue;
+        }
+        stations.append(config);
+    }
+    return stations;
+}
+
+bluetoothdevice *GymManager::createDevice(const QString &type, int8_t bikeResistanceOffset,
+                                          double bikeResistanceGain) {
+    if (type == QStringLiteral("fakebike"))
+        return new fakebike(false, false, true);
+    if (type == QStringLiteral("ftms"))
+        return new ftmsbike(false, true, bikeResistanceOffset, bikeResistanceGain);
+    if (type == QStringLiteral("kickr"))
+        return new wahookickrsnapbike(false, true, bikeResistanceOffset, bikeResistanceGain);
+    return nullptr;
+}
+
+bool GymManager::isBluetoothType(const QString &type) {
+    return type == QStringLiteral("ftms") || type == QStringLiteral("kickr");
+}
+
+bool GymManager::isReserved(const QBluetoothDeviceInfo &device) {
+    return !reserved.isEmpty() && reserved.contains(deviceId(device));
+}
+
+QString GymManager::deviceId(const QBluetoothDeviceInfo &device) {
+#if defined(Q_OS_IOS)
+    return normalizedAddress(device.deviceUuid().toString());
+#else
+    return normalizedAddress(device.address().toString());
+#endif
+}
+
+QString GymManager::normalizedAddress(const QString &address) {
+    QString a = address.trimmed().toUpper();
+    a.remove(QLatin1Char('{'));
+    a.remove(QLatin1Char('}'));
+    return a;
+}
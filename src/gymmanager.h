@@ -0,0 +1,140 @@
+#ifndef GYMMANAGER_H
+#define GYMMANAGER_H
+
+#include <QBluetoothDeviceDiscoveryAgent>
+#include <QBluetoothDeviceInfo>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+#include "sessionline.h"
+
+class bluetoothdevice;
+class DirconManager;
+class MQTTPublisher;
+class QThread;
+class trainprogram;
+
+/**
+ * @brief One trainer of the gym mode, with its own DirCon endpoint, MQTT topics, session and workout.
+ * It's moved to a thread of the GymManager pool before start(): everything it creates lives there. A real trainer
+ * is created when the GymManager finds its address, and the station owns it from then on: the drivers connect back
+ * to it by themselves when the link drops.
+ */
+class GymStation : public QObject {
+    Q_OBJECT
+
+  public:
+    struct Config {
+        QString name;
+        QString type;
+        QString program; // workout file, optional
+        QString address; // of the trainer, its UUID on iOS, empty for a fakebike
+    };
+
+    GymStation(const Config &config, int index, int8_t bikeResistanceOffset, double bikeResistanceGain);
+
+    const Config &config() const { return m_config; }
+
+    /**
+     * @brief device The trainer of the station, nullptr before start() or if its type is not supported.
+     * It's driven from the thread of the station.
+     */
+    bluetoothdevice *device() const { return m_device; }
+
+  public slots:
+    void start();
+
+    /**
+     * @brief assign Creates the trainer of the station and connects to it. Called on the thread of the station.
+     */
+    void assign(const QBluetoothDeviceInfo &info);
+
+    /**
+     * @brief stop Stops recording and writes the session of the station to a FIT file.
+     */
+    void stop();
+
+  private slots:
+    void record();
+
+  private:
+    void setupDevice();
+
+    Config m_config;
+    int index;
+    int8_t bikeResistanceOffset;
+    double bikeResistanceGain;
+    bluetoothdevice *m_device = nullptr;
+    DirconManager *dircon = nullptr;
+    MQTTPublisher *mqtt = nullptr;
+    trainprogram *program = nullptr;
+    QTimer *recorder = nullptr;
+    QList<SessionLine> session;
+};
+
+/**
+ * @brief The gym mode: one process bridging several trainers at the same time, independently of the device of
+ * the bluetooth manager. The stations share a pool of threads for their device I/O. The trainers of the stations
+ * are searched by their own discovery, which runs until every station has its trainer, and the bluetooth manager
+ * leaves them out of its search.
+ */
+class GymManager : public QObject {
+    Q_OBJECT
+
+  public:
+    /**
+     * @param threads size of the pool, 0 for one thread per core up to one per station
+     */
+    GymManager(const QList<GymStation::Config> &stations, int8_t bikeResistanceOffset, double bikeResistanceGain,
+               int threads = 0, QObject *parent = nullptr);
+    ~GymManager() override;
+
+    /**
+     * @brief parseStations Reads the gym_stations setting: name=type[@address][,workout file] separated by ';'.
+     * Entries without a name or a type, of a type not supported, with a name or an address already used, with a
+     * name not fit for an MQTT topic, or of a real trainer without its address are skipped.
+     */
+    static QList<GymStation::Config> parseStations(const QString &spec);
+
+    /**
+     * @brief createDevice A trainer of a type a station can have, not connected yet: fakebike, ftms (any FTMS
+     * bike) or kickr (a Wahoo KICKR). nullptr if the type is not supported.
+     */
+    static bluetoothdevice *createDevice(const QString &type, int8_t bikeResistanceOffset = 4,
+                                         double bikeResistanceGain = 1.0);
+
+    /**
+     * @brief isBluetoothType If a station of the type is a real trainer, found by its address.
+     */
+    static bool isBluetoothType(const QString &type);
+
+    /**
+     * @brief isReserved If the device is the trainer of a gym station, and not for the bluetooth manager.
+     * The stations are reserved on the main thread, where the bluetooth manager runs.
+     */
+    static bool isReserved(const QBluetoothDeviceInfo &device);
+
+    const QList<GymStation *> &stations() const { return m_stations; }
+    int threadCount() const { return pool.size(); }
+
+  private slots:
+    void startDiscovery();
+    void deviceDiscovered(const QBluetoothDeviceInfo &device);
+
+  private:
+    static QString deviceId(const QBluetoothDeviceInfo &device);
+    static QString normalizedAddress(const QString &address);
+
+    QList<QThread *> pool;
+    QList<GymStation *> m_stations;
+    QBluetoothDeviceDiscoveryAgent *discoveryAgent = nullptr;
+    QTimer rescan;
+    QHash<QString, GymStation *> waiting; // by address, the stations without their trainer yet
+    static QSet<QString> reserved;
+};
+
+#endif // GYMMANAGER_H
@@ -9,7 +9,12 @@
 #include <QAndroidJniObject>
 #endif
 #include "material.h"
+#include "activityhistory.h"
+#include "appdirs.h"
+#include "ghostrider.h"
+#include "inclinationoverride.h"
 #include "qfit.h"
+#include "sensorfusion.h"
 #include "simplecrypt.h"
 #include "templateinfosenderbuilder.h"
 #include "zwiftworkout.h"
@@ -37,6 +42,7 @@
 #include <QSettings>
 #include <QStandardPaths>
 #include <QTime>
+#include <QtMath>
 #include <QUrlQuery>
 #include <chrono>
 
@@ -80,33 +86,67 @@ DataObject::DataObject(const QString &name, const QString &icon, const QString &
     emit largeButtonColorChanged(this->largeButtonColor());
 }
 
+DataObject::~DataObject() { dirtyTiles.removeOne(this); }
+
+bool DataObject::batching = false;
+bool DataObject::flushPending = false;
+QList<DataObject *> DataObject::dirtyTiles;
+
 void DataObject::setName(const QString &v) {
     m_name = v;
     emit nameChanged(m_name);
 }
 void DataObject::setValue(const QString &v) {
+    m_numericDecimals = -1;
+    if (m_value == v)
+        return;
+    m_value = v;
+    markDirty(DirtyValue);
+}
+void DataObject::setValue(double value, int decimals) {
+    if (!m_shown)
+        return;
+    // compare the digits that would be displayed, so an unchanged tile costs no QString at all
+    qint64 scaled = qRound64(value * qPow(10, decimals));
+    if (decimals == m_numericDecimals && scaled == m_numericValue)
+        return;
+    m_numericValue = scaled;
+    m_numericDecimals = decimals;
+    QString v = QString::number(value, 'f', decimals);
+    if (m_value == v)
+        return;
     m_value = v;
-    emit valueChanged(m_value);
+    markDirty(DirtyValue);
 }
 void DataObject::setSecondLine(const QString &value) {
+    if (m_secondLine == value)
+        return;
     m_secondLine = value;
-    emit secondLineChanged(m_secondLine);
+    markDirty(DirtySecondLine);
 }
 void DataObject::setValueFontSize(int value) {
+    if (m_valueFontSize == value)
+        return;
     m_valueFontSize = value;
-    emit valueFontSizeChanged(m_valueFontSize);
+    markDirty(DirtyValueFontSize);
 }
 void DataObject::setValueFontColor(const QString &value) {
+    if (m_valueFontColor == value)
+        return;
     m_valueFontColor = value;
-    emit valueFontColorChanged(m_valueFontColor);
+    markDirty(DirtyValueFontColor);
 }
 void DataObject::setLargeButtonColor(const QString &color) {
+    if (m_largeButtonColor == color)
+        return;
     m_largeButtonColor = color;
-    emit largeButtonColorChanged(m_largeButtonColor);
+    markDirty(DirtyLargeButtonColor);
 }
 void DataObject::setLabelFontSize(int value) {
+    if (m_labelFontSize == value)
+        return;
     m_labelFontSize = value;
-    emit labelFontSizeChanged(m_labelFontSize);
+    markDirty(DirtyLabelFontSize);
 }
 void DataObject::setGridId(int id) {
     m_gridId = id;
@@ -116,6 +156,59 @@ void DataObject::setVisible(bool visible) {
     m_visible = visible;
     emit visibleChanged(m_visible);
 }
+void DataObject::setShown(bool shown) {
+    if (shown && !m_shown) {
+        // numbers skipped while hidden must be formatted at the next update
+        m_numericDecimals = -1;
+    }
+    m_shown = shown;
+}
+
+void DataObject::markDirty(int flags) {
+    if (!m_shown) {
+        // not in the model: nothing is bound to the signals, setShown() and the next update catch up
+        return;
+    }
+    if (!m_dirty)
+        dirtyTiles.append(this);
+    m_dirty |= flags;
+    if (!batching && !flushPending) {
+        flushPending = true;
+        QTimer::singleShot(0, &DataObject::flushTiles);
+    }
+}
+
+void DataObject::flush() {
+    int dirty = m_dirty;
+    m_dirty = 0;
+    if (dirty & DirtyValue)
+        emit valueChanged(m_value);
+    if (dirty & DirtySecondLine)
+        emit secondLineChanged(m_secondLine);
+    if (dirty & DirtyValueFontSize)
+        emit valueFontSizeChanged(m_valueFontSize);
+    if (dirty & DirtyValueFontColor)
+        emit valueFontColorChanged(m_valueFontColor);
+    if (dirty & DirtyLabelFontSize)
+        emit labelFontSizeChanged(m_labelFontSize);
+    if (dirty & DirtyLargeButtonColor)
+        emit largeButtonColorChanged(m_largeButtonColor);
+}
+
+void DataObject::beginUpdate() { batching = true; }
+
+void DataObject::endUpdate() {
+    batching = false;
+    flushTiles();
+}
+
+void DataObject::flushTiles() {
+    flushPending = false;
+    QList<DataObject *> tiles;
+    tiles.swap(dirtyTiles);
+    for (DataObject *tile : qAsConst(tiles))
+        tile->flush();
+}
 
 homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
     m_singleton = this;
@@ -270,6 +363,27 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
                                 QStringLiteral("0"), false, QStringLiteral("rss"), 48, labelFontSize);                                
     steeringAngle = new DataObject(QStringLiteral("Steering"), QStringLiteral("icons/icons/cadence.png"),
                                    QStringLiteral("0"), false, QStringLiteral("steeringangle"), 48, labelFontSize);
+    pedalStroke = new DataObject(QStringLiteral("Pedal Smoothness (%)"), QStringLiteral("icons/icons/cadence.png"),
+                                 QStringLiteral("0"), false, QStringLiteral("pedal_stroke"), 48, labelFontSize);
+    ghostTime = new DataObject(QStringLiteral("Ghost Gap"), QStringLiteral("icons/icons/clock.png"),
+                               QStringLiteral("N/A"), false, QStringLiteral("ghost_time"), valueTimeFontSize,
+                               labelFontSize);
+    ghostDistance = new DataObject(QStringLiteral("Ghost Gap (") + meters + QStringLiteral(")"),
+                                   QStringLiteral("icons/icons/odometer.png"), QStringLiteral("N/A"), false,
+                                   QStringLiteral("ghost_distance"), 48, labelFontSize);
+    ghostPower = new DataObject(QStringLiteral("Ghost Watt"), QStringLiteral("icons/icons/watt.png"),
+                                QStringLiteral("N/A"), false, QStringLiteral("ghost_power"), 48, labelFontSize);
+    normalizedPower = new DataObject(QStringLiteral("Normalized Power"), QStringLiteral("icons/icons/watt.png"),
+                                     QStringLiteral("0"), false, QStringLiteral("normalized_power"), 48,
+                                     labelFontSize);
+    tss = new DataObject(QStringLiteral("TSS"), QStringLiteral("icons/icons/watt.png"), QStringLiteral("0"), false,
+                         QStringLiteral("tss"), 48, labelFontSize);
+    wPrimeBalance = new DataObject(QStringLiteral("W' Balance (kJ)"), QStringLiteral("icons/icons/watt.png"),
+                                   QStringLiteral("0"), false, QStringLiteral("wbal"), 48, labelFontSize);
+    powerZoneTime = new DataObject(QStringLiteral("Time in Zone"), QStringLiteral("icons/icons/clock.png"),
+                                   QStringLiteral("0:00"), false, QStringLiteral("power_zone_time"),
+                                   valueTimeFontSize, labelFontSize);
+    trainingLoad.reset(TrainingLoad::Parameters::fromSettings());
     peloton_offset =
         new DataObject(QStringLiteral("Peloton Offset"), QStringLiteral("icons/icons/clock.png"), QStringLiteral("0"),
                        true, QStringLiteral("peloton_offset"), valueElapsedFontSize, labelFontSize);
@@ -474,6 +588,9 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
 
     this->bluetoothManager = bl;
     this->engine = engine;
+    // the samples are taken by update(), with the tiles
+    sessionRecorder = new SessionRecorder(bl, QString(), this);
+    sessionRecorder->setAutoRecord(false);
     connect(bluetoothManager, &bluetooth::bluetoothDeviceConnected, this, &homeform::bluetoothDeviceConnected);
     connect(bluetoothManager, &bluetooth::bluetoothDeviceDisconnected, this, &homeform::bluetoothDeviceDisconnected);
     connect(bluetoothManager, &bluetooth::deviceFound, this, &homeform::deviceFound);
@@ -536,6 +653,9 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
     QObject *home = rootObject->findChild<QObject *>(QStringLiteral("home"));
     QObject *stack = rootObject;
     engine->rootContext()->setContextProperty("pathController", &pathController);
+    // the FIT files saved before the history, or by another install sharing the folder
+    engine->rootContext()->setContextProperty(QStringLiteral("activityHistory"), ActivityHistory::instance());
+    ActivityHistory::instance()->importFolder(getWritableAppDir());
     QObject::connect(home, SIGNAL(start_clicked()), this, SLOT(Start()));
     QObject::connect(home, SIGNAL(stop_clicked()), this, SLOT(Stop()));
     QObject::connect(stack, SIGNAL(trainprogram_open_clicked(QUrl)), this, SLOT(trainprogram_open_clicked(QUrl)));
@@ -546,6 +666,7 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
     QObject::connect(stack, SIGNAL(gpxpreview_open_clicked(QUrl)), this, SLOT(gpxpreview_open_clicked(QUrl)));
     QObject::connect(stack, SIGNAL(trainprogram_zwo_loaded(QString)), this, SLOT(trainprogram_zwo_loaded(QString)));
     QObject::connect(stack, SIGNAL(gpx_open_clicked(QUrl)), this, SLOT(gpx_open_clicked(QUrl)));
+    QObject::connect(stack, SIGNAL(ghost_open_clicked(QUrl)), this, SLOT(ghost_open_clicked(QUrl)));
     QObject::connect(stack, SIGNAL(gpx_save_clicked()), this, SLOT(gpx_save_clicked()));
     QObject::connect(stack, SIGNAL(fit_save_clicked()), this, SLOT(fit_save_clicked()));
     QObject::connect(stack, SIGNAL(strava_connect_clicked()), this, SLOT(strava_connect_clicked()));
@@ -1030,26 +1151,7 @@ void homeform::pelotonWorkoutChanged(const QString &name, const QString &instruc
 
 }
 
-QString homeform::getWritableAppDir() {
-    QString path = QLatin1String("");
-#if defined(Q_OS_ANDROID)
-    QSettings settings;
-    bool android_documents_folder = settings.value(QZSettings::android_documents_folder, QZSettings::default_android_documents_folder).toBool();
-    if (android_documents_folder || QOperatingSystemVersion::current() >= QOperatingSystemVersion(QOperatingSystemVersion::Android, 14)) {
-        path = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/QZ/";
-        QDir().mkdir(path);
-    } else {
-        path = getAndroidDataAppDir() + "/";
-    }
-#elif defined(Q_OS_MACOS) || defined(Q_OS_OSX)
-    path = QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) + "/";
-#elif defined(Q_OS_IOS)
-    path = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/";
-#elif defined(Q_OS_WINDOWS)
-    path = QDir::currentPath() + "/";
-#endif
-    return path;
-}
+QString homeform::getWritableAppDir() { return AppDirs::writable(); }
 
 void homeform::backup() {
 
@@ -1062,7 +1164,7 @@ void homeform::backup() {
 
         QString filename = path + QString::number(index) + backupFitFileName;
         QFile::remove(filename);
-        qfit::save(filename, Session, dev->deviceType(),
+        qfit::save(filename, sessionRecorder->session(), dev->deviceType(),
                    qobject_cast<m3ibike *>(dev) ? QFIT_PROCESS_DISTANCENOISE : QFIT_PROCESS_NONE,
                    stravaPelotonWorkoutType, dev->bluetoothDevice.name());
 
@@ -1124,110 +1226,19 @@ void homeform::aboutToQuit() {
 
 void homeform::trainProgramSignals() {
     if (bluetoothManager->device()) {
-        disconnect(trainProgram, &trainprogram::start, bluetoothManager->device(), &bluetoothdevice::start);
-        disconnect(trainProgram, &trainprogram::stop, bluetoothManager->device(), &bluetoothdevice::stop);
         disconnect(trainProgram, &trainprogram::stop, this, &homeform::StopFromTrainProgram);
         disconnect(trainProgram, &trainprogram::lap, this, &homeform::Lap);
-        disconnect(trainProgram, &trainprogram::changeSpeed, ((treadmill *)bluetoothManager->device()),
-                   &treadmill::changeSpeed);
-        disconnect(trainProgram, &trainprogram::changeInclination, ((treadmill *)bluetoothManager->device()),
-                   &treadmill::changeInclination);
-        disconnect(trainProgram, &trainprogram::changeNextInclination300Meters, bluetoothManager->device(),
-                   &bluetoothdevice::changeNextInclination300Meters);
-        disconnect(trainProgram, &trainprogram::changeInclination, ((bike *)bluetoothManager->device()),
-                   &bike::changeInclination);
-        disconnect(trainProgram, &trainprogram::changeFanSpeed, ((treadmill *)bluetoothManager->device()),
-                   &treadmill::changeFanSpeed);
-        disconnect(trainProgram, &trainprogram::changeSpeedAndInclination, ((treadmill *)bluetoothManager->device()),
-                   &treadmill::changeSpeedAndInclination);
-        disconnect(trainProgram, &trainprogram::changeResistance, ((bike *)bluetoothManager->device()),
-                   &bike::changeResistance);
-        disconnect(trainProgram, &trainprogram::changeRequestedPelotonResistance, ((bike *)bluetoothManager->device()),
-                   &bike::changeRequestedPelotonResistance);
-        disconnect(trainProgram, &trainprogram::changeCadence, ((bike *)bluetoothManager->device()),
-                   &bike::changeCadence);
-        disconnect(trainProgram, &trainprogram::changePower, ((treadmill *)bluetoothManager->device()), &treadmill::changePower);
-        disconnect(trainProgram, &trainprogram::changePower, ((bike *)bluetoothManager->device()), &bike::changePower);
-        disconnect(trainProgram, &trainprogram::changePower, ((rower *)bluetoothManager->device()),
-                   &rower::changePower);
-        disconnect(trainProgram, &trainprogram::changeSpeed, ((rower *)bluetoothManager->device()),
-                   &rower::changeSpeed);
-        disconnect(trainProgram, &trainprogram::changeCadence, ((elliptical *)bluetoothManager->device()),
-                   &elliptical::changeCadence);
-        disconnect(trainProgram, &trainprogram::changePower, ((elliptical *)bluetoothManager->device()),
-                   &elliptical::changePower);
-        disconnect(trainProgram, &trainprogram::changeInclination, ((elliptical *)bluetoothManager->device()),
-                   &elliptical::changeInclination);
-        disconnect(trainProgram, &trainprogram::changeResistance, ((elliptical *)bluetoothManager->device()),
-                   &elliptical::changeResistance);
-        disconnect(trainProgram, &trainprogram::changeRequestedPelotonResistance,
-                   ((elliptical *)bluetoothManager->device()), &elliptical::changeRequestedPelotonResistance);
-        disconnect(((treadmill *)bluetoothManager->device()), &treadmill::tapeStarted, trainProgram,
-                   &trainprogram::onTapeStarted);
-        disconnect(((bike *)bluetoothManager->device()), &bike::bikeStarted, trainProgram,
-                   &trainprogram::onTapeStarted);
-        disconnect(trainProgram, &trainprogram::changeGeoPosition, bluetoothManager->device(),
-                   &bluetoothdevice::changeGeoPosition);
         disconnect(this, &homeform::workoutEventStateChanged, bluetoothManager->device(),
                    &bluetoothdevice::workoutEventStateChanged);
         disconnect(trainProgram, &trainprogram::changeTimestamp, this, &homeform::changeTimestamp);
         disconnect(trainProgram, &trainprogram::toastRequest, this, &homeform::onToastRequested);
         disconnect(trainProgram, &trainprogram::zwiftLoginState, this, &homeform::zwiftLoginState);
 
-        connect(trainProgram, &trainprogram::start, bluetoothManager->device(), &bluetoothdevice::start);
-        connect(trainProgram, &trainprogram::stop, bluetoothManager->device(), &bluetoothdevice::stop);
+        // the device follows the program as in the headless mode
+        sessionRecorder->setProgram(trainProgram);
         connect(trainProgram, &trainprogram::stop, this, &homeform::StopFromTrainProgram);
         connect(trainProgram, &trainprogram::lap, this, &homeform::Lap);
         connect(trainProgram, &trainprogram::toastRequest, this, &homeform::onToastRequested);
-        if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
-            connect(trainProgram, &trainprogram::changeSpeed, ((treadmill *)bluetoothManager->device()),
-                    &treadmill::changeSpeed);
-            connect(trainProgram, &trainprogram::changeFanSpeed, ((treadmill *)bluetoothManager->device()),
-                    &treadmill::changeFanSpeed);
-            connect(trainProgram, &trainprogram::changeInclination, ((treadmill *)bluetoothManager->device()),
-                    &treadmill::changeInclination);
-            connect(trainProgram, &trainprogram::changeSpeedAndInclination, ((treadmill *)bluetoothManager->device()),
-                    &treadmill::changeSpeedAndInclination);
-            connect(((treadmill *)bluetoothManager->device()), &treadmill::tapeStarted, trainProgram,
-                    &trainprogram::onTapeStarted);
-            connect(trainProgram, &trainprogram::changePower, ((treadmill *)bluetoothManager->device()), &treadmill::changePower);
-        } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE) {
-            connect(trainProgram, &trainprogram::changeCadence, ((bike *)bluetoothManager->device()),
-                    &bike::changeCadence);
-            connect(trainProgram, &trainprogram::changePower, ((bike *)bluetoothManager->device()), &bike::changePower);
-            connect(trainProgram, &trainprogram::changeInclination, ((bike *)bluetoothManager->device()),
-                    &bike::changeInclination);
-            connect(trainProgram, &trainprogram::changeResistance, ((bike *)bluetoothManager->device()),
-                    &bike::changeResistance);
-            connect(trainProgram, &trainprogram::changeRequestedPelotonResistance, ((bike *)bluetoothManager->device()),
-                    &bike::changeRequestedPelotonResistance);
-            connect(((bike *)bluetoothManager->device()), &bike::bikeStarted, trainProgram,
-                    &trainprogram::onTapeStarted);
-        } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL) {
-            connect(trainProgram, &trainprogram::changeCadence, ((elliptical *)bluetoothManager->device()),
-                    &elliptical::changeCadence);
-            connect(trainProgram, &trainprogram::changePower, ((elliptical *)bluetoothManager->device()),
-                    &elliptical::changePower);
-            connect(trainProgram, &trainprogram::changeInclination, ((elliptical *)bluetoothManager->device()),
-                    &elliptical::changeInclination);
-            connect(trainProgram, &trainprogram::changeResistance, ((elliptical *)bluetoothManager->device()),
-                    &elliptical::changeResistance);
-            connect(trainProgram, &trainprogram::changeRequestedPelotonResistance,
-                    ((elliptical *)bluetoothManager->device()), &elliptical::changeRequestedPelotonResistance);
-        } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
-            connect(trainProgram, &trainprogram::changePower, ((rower *)bluetoothManager->device()),
-                    &rower::changePower);
-            connect(trainProgram, &trainprogram::changeResistance, ((rower *)bluetoothManager->device()),
-                    &rower::changeResistance);
-            connect(trainProgram, &trainprogram::changeCadence, ((rower *)bluetoothManager->device()),
-                    &rower::changeCadence);
-            connect(trainProgram, &trainprogram::changeSpeed, ((rower *)bluetoothManager->device()),
-                    &rower::changeSpeed);
-        }
-        connect(trainProgram, &trainprogram::changeNextInclination300Meters, bluetoothManager->device(),
-                &bluetoothdevice::changeNextInclination300Meters);
-        connect(trainProgram, &trainprogram::changeGeoPosition, bluetoothManager->device(),
-                &bluetoothdevice::changeGeoPosition);
         connect(trainProgram, &trainprogram::changeTimestamp, this, &homeform::changeTimestamp);
         connect(this, &homeform::workoutEventStateChanged, bluetoothManager->device(),
                 &bluetoothdevice::workoutEventStateChanged);
@@ -1292,6 +1303,8 @@ void homeform::sortTiles() {
     if (!bluetoothManager || !bluetoothManager->device())
         return;
 
+    for (QObject *d : qAsConst(dataList))
+        ((DataObject *)d)->setShown(false);
     dataList.clear();
 
     if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
@@ -1443,6 +1456,41 @@ void homeform::sortTiles() {
                 mets->setGridId(i);
                 dataList.append(mets);
             }
+            if (settings.value(QZSettings::tile_ghost_time_enabled, QZSettings::default_tile_ghost_time_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_time_order, QZSettings::default_tile_ghost_time_order).toInt() == i) {
+                ghostTime->setGridId(i);
+                dataList.append(ghostTime);
+            }
+            if (settings.value(QZSettings::tile_ghost_distance_enabled, QZSettings::default_tile_ghost_distance_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_distance_order, QZSettings::default_tile_ghost_distance_order).toInt() == i) {
+                ghostDistance->setGridId(i);
+                dataList.append(ghostDistance);
+            }
+            if (settings.value(QZSettings::tile_ghost_power_enabled, QZSettings::default_tile_ghost_power_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_power_order, QZSettings::default_tile_ghost_power_order).toInt() == i) {
+                ghostPower->setGridId(i);
+                dataList.append(ghostPower);
+            }
+            if (settings.value(QZSettings::tile_normalized_power_enabled, QZSettings::default_tile_normalized_power_enabled).toBool() &&
+                settings.value(QZSettings::tile_normalized_power_order, QZSettings::default_tile_normalized_power_order).toInt() == i) {
+                normalizedPower->setGridId(i);
+                dataList.append(normalizedPower);
+            }
+            if (settings.value(QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled).toBool() &&
+                settings.value(QZSettings::tile_tss_order, QZSettings::default_tile_tss_order).toInt() == i) {
+                tss->setGridId(i);
+                dataList.append(tss);
+            }
+            if (settings.value(QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled).toBool() &&
+                settings.value(QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order).toInt() == i) {
+                wPrimeBalance->setGridId(i);
+                dataList.append(wPrimeBalance);
+            }
+            if (settings.value(QZSettings::tile_power_zone_time_enabled, QZSettings::default_tile_power_zone_time_enabled).toBool() &&
+                settings.value(QZSettings::tile_power_zone_time_order, QZSettings::default_tile_power_zone_time_order).toInt() == i) {
+                powerZoneTime->setGridId(i);
+                dataList.append(powerZoneTime);
+            }
             if (settings.value(QZSettings::tile_targetmets_enabled, false).toBool() &&
                 settings.value(QZSettings::tile_targetmets_order, 29).toInt() == i) {
 
@@ -1800,6 +1848,41 @@ void homeform::sortTiles() {
                 mets->setGridId(i);
                 dataList.append(mets);
             }
+            if (settings.value(QZSettings::tile_ghost_time_enabled, QZSettings::default_tile_ghost_time_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_time_order, QZSettings::default_tile_ghost_time_order).toInt() == i) {
+                ghostTime->setGridId(i);
+                dataList.append(ghostTime);
+            }
+            if (settings.value(QZSettings::tile_ghost_distance_enabled, QZSettings::default_tile_ghost_distance_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_distance_order, QZSettings::default_tile_ghost_distance_order).toInt() == i) {
+                ghostDistance->setGridId(i);
+                dataList.append(ghostDistance);
+            }
+            if (settings.value(QZSettings::tile_ghost_power_enabled, QZSettings::default_tile_ghost_power_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_power_order, QZSettings::default_tile_ghost_power_order).toInt() == i) {
+                ghostPower->setGridId(i);
+                dataList.append(ghostPower);
+            }
+            if (settings.value(QZSettings::tile_normalized_power_enabled, QZSettings::default_tile_normalized_power_enabled).toBool() &&
+                settings.value(QZSettings::tile_normalized_power_order, QZSettings::default_tile_normalized_power_order).toInt() == i) {
+                normalizedPower->setGridId(i);
+                dataList.append(normalizedPower);
+            }
+            if (settings.value(QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled).toBool() &&
+                settings.value(QZSettings::tile_tss_order, QZSettings::default_tile_tss_order).toInt() == i) {
+                tss->setGridId(i);
+                dataList.append(tss);
+            }
+            if (settings.value(QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled).toBool() &&
+                settings.value(QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order).toInt() == i) {
+                wPrimeBalance->setGridId(i);
+                dataList.append(wPrimeBalance);
+            }
+            if (settings.value(QZSettings::tile_power_zone_time_enabled, QZSettings::default_tile_power_zone_time_enabled).toBool() &&
+                settings.value(QZSettings::tile_power_zone_time_order, QZSettings::default_tile_power_zone_time_order).toInt() == i) {
+                powerZoneTime->setGridId(i);
+                dataList.append(powerZoneTime);
+            }
             if (settings.value(QZSettings::tile_targetmets_enabled, false).toBool() &&
                 settings.value(QZSettings::tile_targetmets_order, 29).toInt() == i) {
                 targetMets->setGridId(i);
@@ -1997,6 +2080,12 @@ void homeform::sortTiles() {
                 preset_powerzone_7->setGridId(i);
                 dataList.append(preset_powerzone_7);
             }            
+
+            if (settings.value(QZSettings::tile_pedal_stroke_enabled, QZSettings::default_tile_pedal_stroke_enabled).toBool() &&
+                settings.value(QZSettings::tile_pedal_stroke_order, QZSettings::default_tile_pedal_stroke_order).toInt() == i) {
+                pedalStroke->setGridId(i);
+                dataList.append(pedalStroke);
+            }
         }
     } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
         for (int i = 0; i < 100; i++) {
@@ -2195,6 +2284,41 @@ void homeform::sortTiles() {
                 mets->setGridId(i);
                 dataList.append(mets);
             }
+            if (settings.value(QZSettings::tile_ghost_time_enabled, QZSettings::default_tile_ghost_time_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_time_order, QZSettings::default_tile_ghost_time_order).toInt() == i) {
+                ghostTime->setGridId(i);
+                dataList.append(ghostTime);
+            }
+            if (settings.value(QZSettings::tile_ghost_distance_enabled, QZSettings::default_tile_ghost_distance_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_distance_order, QZSettings::default_tile_ghost_distance_order).toInt() == i) {
+                ghostDistance->setGridId(i);
+                dataList.append(ghostDistance);
+            }
+            if (settings.value(QZSettings::tile_ghost_power_enabled, QZSettings::default_tile_ghost_power_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_power_order, QZSettings::default_tile_ghost_power_order).toInt() == i) {
+                ghostPower->setGridId(i);
+                dataList.append(ghostPower);
+            }
+            if (settings.value(QZSettings::tile_normalized_power_enabled, QZSettings::default_tile_normalized_power_enabled).toBool() &&
+                settings.value(QZSettings::tile_normalized_power_order, QZSettings::default_tile_normalized_power_order).toInt() == i) {
+                normalizedPower->setGridId(i);
+                dataList.append(normalizedPower);
+            }
+            if (settings.value(QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled).toBool() &&
+                settings.value(QZSettings::tile_tss_order, QZSettings::default_tile_tss_order).toInt() == i) {
+                tss->setGridId(i);
+                dataList.append(tss);
+            }
+            if (settings.value(QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled).toBool() &&
+                settings.value(QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order).toInt() == i) {
+                wPrimeBalance->setGridId(i);
+                dataList.append(wPrimeBalance);
+            }
+            if (settings.value(QZSettings::tile_power_zone_time_enabled, QZSettings::default_tile_power_zone_time_enabled).toBool() &&
+                settings.value(QZSettings::tile_power_zone_time_order, QZSettings::default_tile_power_zone_time_order).toInt() == i) {
+                powerZoneTime->setGridId(i);
+                dataList.append(powerZoneTime);
+            }
             if (settings.value(QZSettings::tile_targetmets_enabled, false).toBool() &&
                 settings.value(QZSettings::tile_targetmets_order, 29).toInt() == i) {
                 targetMets->setGridId(i);
@@ -2752,6 +2876,41 @@ void homeform::sortTiles() {
                 mets->setGridId(i);
                 dataList.append(mets);
             }
+            if (settings.value(QZSettings::tile_ghost_time_enabled, QZSettings::default_tile_ghost_time_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_time_order, QZSettings::default_tile_ghost_time_order).toInt() == i) {
+                ghostTime->setGridId(i);
+                dataList.append(ghostTime);
+            }
+            if (settings.value(QZSettings::tile_ghost_distance_enabled, QZSettings::default_tile_ghost_distance_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_distance_order, QZSettings::default_tile_ghost_distance_order).toInt() == i) {
+                ghostDistance->setGridId(i);
+                dataList.append(ghostDistance);
+            }
+            if (settings.value(QZSettings::tile_ghost_power_enabled, QZSettings::default_tile_ghost_power_enabled).toBool() &&
+                settings.value(QZSettings::tile_ghost_power_order, QZSettings::default_tile_ghost_power_order).toInt() == i) {
+                ghostPower->setGridId(i);
+                dataList.append(ghostPower);
+            }
+            if (settings.value(QZSettings::tile_normalized_power_enabled, QZSettings::default_tile_normalized_power_enabled).toBool() &&
+                settings.value(QZSettings::tile_normalized_power_order, QZSettings::default_tile_normalized_power_order).toInt() == i) {
+                normalizedPower->setGridId(i);
+                dataList.append(normalizedPower);
+            }
+            if (settings.value(QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled).toBool() &&
+                settings.value(QZSettings::tile_tss_order, QZSettings::default_tile_tss_order).toInt() == i) {
+                tss->setGridId(i);
+                dataList.append(tss);
+            }
+            if (settings.value(QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled).toBool() &&
+                settings.value(QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order).toInt() == i) {
+                wPrimeBalance->setGridId(i);
+                dataList.append(wPrimeBalance);
+            }
+            if (settings.value(QZSettings::tile_power_zone_time_enabled, QZSettings::default_tile_power_zone_time_enabled).toBool() &&
+                settings.value(QZSettings::tile_power_zone_time_order, QZSettings::default_tile_power_zone_time_order).toInt() == i) {
+                powerZoneTime->setGridId(i);
+                dataList.append(powerZoneTime);
+            }
             if (settings.value(QZSettings::tile_targetmets_enabled, false).toBool() &&
                 settings.value(QZSettings::tile_targetmets_order, 29).toInt() == i) {
                 targetMets->setGridId(i);
@@ -2897,9 +3056,25 @@ void homeform::sortTiles() {
         }
     }
 
+    for (QObject *d : qAsConst(dataList))
+        ((DataObject *)d)->setShown(true);
     engine->rootContext()->setContextProperty(QStringLiteral("appModel"), QVariant::fromValue(dataList));
 }
 
+ChartSeriesCache *homeform::chartSeriesCache(const QString &metric) {
+    if (metric == QStringLiteral("watt"))
+        return &wattChartSeries;
+    if (metric == QStringLiteral("heart"))
+        return &heartChartSeries;
+    if (metric == QStringLiteral("cadence"))
+        return &cadenceChartSeries;
+    if (metric == QStringLiteral("resistance"))
+        return &resistanceChartSeries;
+    if (metric == QStringLiteral("peloton_resistance"))
+        return &pelotonResistanceChartSeries;
+    return nullptr;
+}
+
 DataObject *homeform::tileFromName(QString name) {
     foreach (QObject *d, dataList) {
         if (!((DataObject *)d)->name().compare(name)) {
@@ -3576,7 +3751,9 @@ void homeform::bluetoothDeviceConnected(bluetoothdevice *b) {
     this->userTemplateManager->start(b);
 #ifndef Q_OS_IOS
     // heart rate received from apple watch while QZ is running on a different device via TCP socket (iphone_socket)
-    connect(this, SIGNAL(heartRate(uint8_t)), b, SLOT(heartRate(uint8_t)));
+    SensorFusion *fusion = b->sensorFusion();
+    connect(this, &homeform::heartRate, fusion,
+            [fusion](uint8_t heart) { fusion->input(SensorFusion::Heart, SensorFusion::Watch, heart); });
 #endif
 }
 
@@ -3863,7 +4040,13 @@ void homeform::Start_inner(bool send_event_to_device) {
 
                 bluetoothManager->device()->clearStats();
             }
-            Session.clear();
+            sessionRecorder->clear();
+            trainingLoad.reset(TrainingLoad::Parameters::fromSettings());
+            wattChartSeries.clear();
+            heartChartSeries.clear();
+            cadenceChartSeries.clear();
+            resistanceChartSeries.clear();
+            pelotonResistanceChartSeries.clear();
             chartImagesFilenames.clear();
 
 #ifdef Q_OS_IOS
@@ -4097,6 +4280,14 @@ void homeform::update() {
     double currentHRZone = 1;
     double ftpZone = 1;
 
+    updateTimerProbe.tick(QZMetrics::HomeformUpdateJitter);
+    DataObject::beginUpdate();
+    if (++latencyReportTicks >= 60) {
+        latencyReportTicks = 0;
+        qDebug() << qPrintable(QStringLiteral("latency report\n") + QZMetrics::latencyReport() +
+                               PollScheduler::instance()->report());
+    }
+
     qDebug() << "homeform::update fired!";
 
     if (settings.status() != QSettings::NoError) {
@@ -4122,10 +4313,6 @@ void homeform::update() {
         double pace = 0;
         double peloton_resistance = 0;
         uint8_t cadence = 0;
-        uint32_t totalStrokes = 0;
-        double avgStrokesRate = 0;
-        double maxStrokesRate = 0;
-        double avgStrokesLength = 0;
         double strideLength = 0;
         double groundContact = 0;
         double verticalOscillation = 0;
@@ -4156,22 +4343,23 @@ void homeform::update() {
 
         emit signalChanged(signal());
         emit currentSpeedChanged(bluetoothManager->device()->currentSpeed().value());
-        speed->setValue(QString::number(bluetoothManager->device()->currentSpeed().value() * unit_conversion, 'f', 1));
-        speed->setSecondLine(
-            QStringLiteral("AVG: ") +
-            QString::number((bluetoothManager->device())->currentSpeed().average() * unit_conversion, 'f', 1) +
-            QStringLiteral(" MAX: ") +
-            QString::number((bluetoothManager->device())->currentSpeed().max() * unit_conversion, 'f', 1));
-        heart->setValue(QString::number(bluetoothManager->device()->currentHeart().value(), 'f', 0));
-
-        calories->setValue(QString::number(bluetoothManager->device()->calories().value(), 'f', 0));
+        speed->setValue(bluetoothManager->device()->currentSpeed().value() * unit_conversion, 1);
+        if (speed->shown())
+            speed->setSecondLine(
+                QStringLiteral("AVG: ") +
+                QString::number((bluetoothManager->device())->currentSpeed().average() * unit_conversion, 'f', 1) +
+                QStringLiteral(" MAX: ") +
+                QString::number((bluetoothManager->device())->currentSpeed().max() * unit_conversion, 'f', 1));
+        heart->setValue(bluetoothManager->device()->currentHeart().value(), 0);
+
+        calories->setValue(bluetoothManager->device()->calories().value(), 0);
         calories->setSecondLine(QString::number(bluetoothManager->device()->calories().rate1s() * 60.0, 'f', 1) +
                                 " /min");
         if (!settings.value(QZSettings::fitmetria_fanfit_enable, QZSettings::default_fitmetria_fanfit_enable).toBool())
             fan->setValue(QString::number(bluetoothManager->device()->fanSpeed()));
         else
             fan->setValue(QString::number(qRound(((double)bluetoothManager->device()->fanSpeed()) / 10.0) * 10.0));
-        jouls->setValue(QString::number(bluetoothManager->device()->jouls().value() / 1000.0, 'f', 1));
+        jouls->setValue(bluetoothManager->device()->jouls().value() / 1000.0, 1);
         jouls->setSecondLine(QString::number(bluetoothManager->device()->jouls().rate1s() / 1000.0 * 60.0, 'f', 1) +
                              " /min");
         elapsed->setValue(bluetoothManager->device()->elapsedTime().toString(QStringLiteral("h:mm:ss")));
@@ -4201,7 +4389,7 @@ void homeform::update() {
                 trainProgram->currentRowRemainingTime().toString(QStringLiteral("h:mm:ss")));
             remaningTimeTrainingProgramCurrentRow->setSecondLine(
                 trainProgram->currentRowElapsedTime().toString(QStringLiteral("h:mm:ss")));
-            targetMets->setValue(QString::number(trainProgram->currentTargetMets(), 'f', 1));
+            targetMets->setValue(trainProgram->currentTargetMets(), 1);
             trainrow next = trainProgram->getRowFromCurrent(1);
             trainrow next_1 = trainProgram->getRowFromCurrent(2);
             if (next.duration.second() != 0 || next.duration.minute() != 0 || next.duration.hour() != 0 || next.distance != -1) {
@@ -4295,17 +4483,44 @@ void homeform::update() {
                 nextRows->setValue(QStringLiteral("N/A"));
             }
         }
-        mets->setValue(QString::number(bluetoothManager->device()->currentMETS().value(), 'f', 1));
-        mets->setSecondLine(
-            QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->currentMETS().average(), 'f', 1) +
-            QStringLiteral("MAX: ") + QString::number(bluetoothManager->device()->currentMETS().max(), 'f', 1));
+        GhostRider::Gap ghostGap = GhostRider::instance()->gap(bluetoothManager->device());
+        if (ghostGap.valid) {
+            ghostTime->setValue(GhostRider::formatGap(ghostGap.seconds));
+            ghostTime->setSecondLine(GhostRider::instance()->name());
+            ghostDistance->setValue(ghostGap.meters * meter_feet_conversion, 0);
+            ghostPower->setValue(ghostGap.watts, 0);
+        }
+        normalizedPower->setValue(trainingLoad.normalizedPower(), 0);
+        normalizedPower->setSecondLine(QStringLiteral("IF: ") +
+                                       QString::number(trainingLoad.intensityFactor(), 'f', 2));
+        tss->setValue(trainingLoad.tss(), 1);
+        tss->setSecondLine(QStringLiteral("TSS/h: ") +
+                           QString::number(trainingLoad.seconds() ? trainingLoad.tss() * 3600.0 /
+                                                                        trainingLoad.seconds()
+                                                                  : 0,
+                                           'f', 0));
+        wPrimeBalance->setValue(trainingLoad.wPrimeBalance() / 1000.0, 1);
+        wPrimeBalance->setSecondLine(QStringLiteral("MIN: ") +
+                                     QString::number(trainingLoad.wPrimeBalanceMin() / 1000.0, 'f', 1));
+        wPrimeBalance->setValueFontColor(trainingLoad.wPrimeBalance() < trainingLoad.parameters().wPrime * 0.25
+                                             ? QStringLiteral("red")
+                                             : QStringLiteral("white"));
+        powerZoneTime->setValue(QTime(0, 0, 0).addSecs(trainingLoad.currentPowerZoneSeconds()).toString(
+            trainingLoad.currentPowerZoneSeconds() >= 3600 ? QStringLiteral("h:mm:ss") : QStringLiteral("m:ss")));
+        powerZoneTime->setSecondLine(QStringLiteral("Z") + QString::number(trainingLoad.currentPowerZone() + 1));
+        mets->setValue(bluetoothManager->device()->currentMETS().value(), 1);
+        if (mets->shown())
+            mets->setSecondLine(
+                QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->currentMETS().average(), 'f', 1) +
+                QStringLiteral("MAX: ") + QString::number(bluetoothManager->device()->currentMETS().max(), 'f', 1));
         lapElapsed->setValue(bluetoothManager->device()->lapElapsedTime().toString(QStringLiteral("h:mm:ss")));
-        avgWatt->setValue(QString::number(bluetoothManager->device()->wattsMetric().average(), 'f', 0));
-        avgWattLap->setValue(QString::number(bluetoothManager->device()->wattsMetric().lapAverage(), 'f', 0));
-        wattKg->setValue(QString::number(bluetoothManager->device()->wattKg().value(), 'f', 1));
-        wattKg->setSecondLine(
-            QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->wattKg().average(), 'f', 1) +
-            QStringLiteral("MAX: ") + QString::number(bluetoothManager->device()->wattKg().max(), 'f', 1));
+        avgWatt->setValue(bluetoothManager->device()->wattsMetric().average(), 0);
+        avgWattLap->setValue(bluetoothManager->device()->wattsMetric().lapAverage(), 0);
+        wattKg->setValue(bluetoothManager->device()->wattKg().value(), 1);
+        if (wattKg->shown())
+            wattKg->setSecondLine(
+                QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->wattKg().average(), 'f', 1) +
+                QStringLiteral("MAX: ") + QString::number(bluetoothManager->device()->wattKg().max(), 'f', 1));
         QLocale locale = QLocale::system();
 
         // Format the time based on the locale
@@ -4323,18 +4538,18 @@ void homeform::update() {
         }
         datetime->setValue(formattedTime);
         watts = bluetoothManager->device()->wattsMetricforUI();
-        watt->setValue(QString::number(watts, 'f', 0));
-        weightLoss->setValue(QString::number(miles ? bluetoothManager->device()->weightLoss() * 35.274
-                                                   : bluetoothManager->device()->weightLoss(),
-                                             'f', 2));
+        watt->setValue(watts, 0);
+        weightLoss->setValue(
+            miles ? bluetoothManager->device()->weightLoss() * 35.274 : bluetoothManager->device()->weightLoss(), 2);
 
         cadence = bluetoothManager->device()->currentCadence().value();
         this->cadence->setValue(QString::number(cadence));
-        this->cadence->setSecondLine(
-            QStringLiteral("AVG: ") +
-            QString::number(((bike *)bluetoothManager->device())->currentCadence().average(), 'f', 0) +
-            QStringLiteral(" MAX: ") +
-            QString::number(((bike *)bluetoothManager->device())->currentCadence().max(), 'f', 0));
+        if (this->cadence->shown())
+            this->cadence->setSecondLine(
+                QStringLiteral("AVG: ") +
+                QString::number(((bike *)bluetoothManager->device())->currentCadence().average(), 'f', 0) +
+                QStringLiteral(" MAX: ") +
+                QString::number(((bike *)bluetoothManager->device())->currentCadence().max(), 'f', 0));
 
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
@@ -4373,7 +4588,7 @@ void homeform::update() {
 
         if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
             double _rss = ((treadmill *)bluetoothManager->device())->runningStressScore();
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            odometer->setValue(bluetoothManager->device()->odometer() * unit_conversion, 2);
             if (bluetoothManager->device()->currentSpeed().value()) {
                 pace = 10000 / (((treadmill *)bluetoothManager->device())->currentPace().second() +
                                 (((treadmill *)bluetoothManager->device())->currentPace().minute() * 60));
@@ -4395,53 +4610,57 @@ void homeform::update() {
                     ((treadmill *)bluetoothManager->device())->currentPace().toString(QStringLiteral("m:ss")));
             else
                 this->pace->setValue("N/A");
-            this->pace->setSecondLine(
-                QStringLiteral("AVG: ") +
-                ((treadmill *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
-                QStringLiteral(" MAX: ") +
-                ((treadmill *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
-            this->target_power->setValue(
-                QString::number(((treadmill *)bluetoothManager->device())->lastRequestedPower().value(), 'f', 0));
-            this->inclination->setValue(QString::number(inclination, 'f', 1));
-            this->inclination->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
-            elevation->setValue(QString::number(((treadmill *)bluetoothManager->device())->elevationGain().value() *
-                                                    meter_feet_conversion,
-                                                'f', (miles ? 0 : 1)));
+            if (this->pace->shown())
+                this->pace->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    ((treadmill *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
+                    QStringLiteral(" MAX: ") +
+                    ((treadmill *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
+            this->target_power->setValue(((treadmill *)bluetoothManager->device())->lastRequestedPower().value(), 0);
+            this->inclination->setValue(inclination, 1);
+            if (this->inclination->shown())
+                this->inclination->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((treadmill *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((treadmill *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
+            elevation->setValue(((treadmill *)bluetoothManager->device())->elevationGain().value() *
+                                    meter_feet_conversion,
+                                miles ? 0 : 1);
             elevation->setSecondLine(
                 QString::number(((treadmill *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
                                     meter_feet_conversion,
                                 'f', (miles ? 0 : 1)) +
                 " /min");
 
-            this->stepCount->setValue(QString::number(
-                ((treadmill *)bluetoothManager->device())->currentStepCount().value(), 'f', 0));
-            this->rss->setValue(QString::number(_rss, 'f', 0));
+            this->stepCount->setValue(
+                ((treadmill *)bluetoothManager->device())->currentStepCount().value(), 0);
+            this->rss->setValue(_rss, 0);
 
-            this->instantaneousStrideLengthCM->setValue(QString::number(strideLength, 'f', 0));
-            this->instantaneousStrideLengthCM->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentStrideLength().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentStrideLength().max(), 'f', 0));
+            this->instantaneousStrideLengthCM->setValue(strideLength, 0);
+            if (this->instantaneousStrideLengthCM->shown())
+                this->instantaneousStrideLengthCM->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((treadmill *)bluetoothManager->device())->currentStrideLength().average(), 'f', 0) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((treadmill *)bluetoothManager->device())->currentStrideLength().max(), 'f', 0));
 
-            this->groundContactMS->setValue(QString::number(groundContact, 'f', 0));
-            this->groundContactMS->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentGroundContact().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentGroundContact().max(), 'f', 0));
+            this->groundContactMS->setValue(groundContact, 0);
+            if (this->groundContactMS->shown())
+                this->groundContactMS->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((treadmill *)bluetoothManager->device())->currentGroundContact().average(), 'f', 0) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((treadmill *)bluetoothManager->device())->currentGroundContact().max(), 'f', 0));
 
-            this->verticalOscillationMM->setValue(QString::number(verticalOscillation, 'f', 0));
-            this->verticalOscillationMM->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentVerticalOscillation().average(), 'f',
-                                0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentVerticalOscillation().max(), 'f', 0));
+            this->verticalOscillationMM->setValue(verticalOscillation, 0);
+            if (this->verticalOscillationMM->shown())
+                this->verticalOscillationMM->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((treadmill *)bluetoothManager->device())->currentVerticalOscillation().average(), 'f',
+                                    0) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((treadmill *)bluetoothManager->device())->currentVerticalOscillation().max(), 'f', 0));
 
             // if there is no training program, the color is based on presets
             if (!trainProgram || trainProgram->currentRow().speed == -1 || trainProgram->currentRow().upper_speed == -1) {
@@ -4532,13 +4751,13 @@ void homeform::update() {
                 this->target_pace->setValue(
                     ((treadmill *)bluetoothManager->device())->lastRequestedPace().toString(QStringLiteral("m:ss")));
             }
-            this->target_speed->setValue(QString::number(
-                ((treadmill *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 'f', 1));
+            this->target_speed->setValue(
+                ((treadmill *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 1);
             this->target_speed->setSecondLine(QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) +
                                               QStringLiteral("% @0%=") +
                                               QString::number(bluetoothManager->device()->difficult(), 'f', 0));
             this->target_incline->setValue(
-                QString::number(((treadmill *)bluetoothManager->device())->lastRequestedInclination().value(), 'f', 1));
+                ((treadmill *)bluetoothManager->device())->lastRequestedInclination().value(), 1);
             this->target_incline->setSecondLine(
                 QString::number(bluetoothManager->device()->inclinationDifficult() * 100.0, 'f', 0) +
                 QStringLiteral("% @0%=") + QString::number(bluetoothManager->device()->inclinationDifficult(), 'f', 0));
@@ -4562,45 +4781,45 @@ void homeform::update() {
 
             if (!pelotoncadence) {
                 inclination = ((bike *)bluetoothManager->device())->currentInclination().value();
-                this->inclination->setValue(QString::number(inclination, 'f', 1));
-                this->inclination->setSecondLine(
-                    QStringLiteral("AVG: ") +
-                    QString::number(((bike *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
-                    QStringLiteral(" MAX: ") +
-                    QString::number(((bike *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
+                this->inclination->setValue(inclination, 1);
+                if (this->inclination->shown())
+                    this->inclination->setSecondLine(
+                        QStringLiteral("AVG: ") +
+                        QString::number(((bike *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
+                        QStringLiteral(" MAX: ") +
+                        QString::number(((bike *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
             }
             if (bluetoothManager->externalInclination())
-                extIncline->setValue(
-                    QString::number(bluetoothManager->externalInclination()->currentInclination().value(), 'f', 1));
+                extIncline->setValue(bluetoothManager->externalInclination()->currentInclination().value(), 1);
             double elite_rizer_gain =
                 settings.value(QZSettings::elite_rizer_gain, QZSettings::default_elite_rizer_gain).toDouble();
             ergMode->setLargeButtonColor(settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool() ? "#008000" :"#8B0000");
             extIncline->setSecondLine(QStringLiteral("Gain: ") + QString::number(elite_rizer_gain, 'f', 1));
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            odometer->setValue(bluetoothManager->device()->odometer() * unit_conversion, 2);
             resistance = ((bike *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((bike *)bluetoothManager->device())->pelotonResistance().value();
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
+            this->peloton_resistance->setValue(peloton_resistance, 0);
             this->target_resistance->setValue(
-                QString::number(((bike *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((bike *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
-            this->target_cadence->setValue(
-                QString::number(((bike *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
-            this->target_power->setValue(
-                QString::number(((bike *)bluetoothManager->device())->lastRequestedPower().value(), 'f', 0));
-            this->resistance->setValue(QString::number(resistance, 'f', 0));
+                ((bike *)bluetoothManager->device())->lastRequestedResistance().value(), 0);
+            this->target_peloton_resistance->setValue(
+                ((bike *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 0);
+            this->target_cadence->setValue(((bike *)bluetoothManager->device())->lastRequestedCadence().value(), 0);
+            this->target_power->setValue(((bike *)bluetoothManager->device())->lastRequestedPower().value(), 0);
+            this->resistance->setValue(resistance, 0);
             updateGearsValue();
 
-            this->resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((bike *)bluetoothManager->device())->currentResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((bike *)bluetoothManager->device())->currentResistance().max(), 'f', 0));
-            this->peloton_resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((bike *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((bike *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
+            if (this->resistance->shown())
+                this->resistance->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((bike *)bluetoothManager->device())->currentResistance().average(), 'f', 0) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((bike *)bluetoothManager->device())->currentResistance().max(), 'f', 0));
+            if (this->peloton_resistance->shown())
+                this->peloton_resistance->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((bike *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((bike *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
             this->target_resistance->setSecondLine(
                 QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) + QStringLiteral("% @0%=") +
                 QString::number(
@@ -4612,15 +4831,20 @@ void homeform::update() {
                     'f', 0));
 
             elevation->setValue(
-                QString::number(((bike *)bluetoothManager->device())->elevationGain().value() * meter_feet_conversion,
-                                'f', (miles ? 0 : 1)));
+                ((bike *)bluetoothManager->device())->elevationGain().value() * meter_feet_conversion, miles ? 0 : 1);
             elevation->setSecondLine(QString::number(((bike *)bluetoothManager->device())->elevationGain().rate1s() *
                                                          60.0 * meter_feet_conversion,
                                                      'f', (miles ? 0 : 1)) +
                                      " /min");
 
-            this->steeringAngle->setValue(
-                QString::number(((bike *)bluetoothManager->device())->currentSteeringAngle().value(), 'f', 1));
+            this->steeringAngle->setValue(((bike *)bluetoothManager->device())->currentSteeringAngle().value(), 1);
+            if (((bike *)bluetoothManager->device())->currentPedalSmoothness().value() > 0) {
+                double rightBalance = ((bike *)bluetoothManager->device())->currentRightBalance().value();
+                pedalStroke->setValue(((bike *)bluetoothManager->device())->currentPedalSmoothness().value(), 0);
+                pedalStroke->setSecondLine(QStringLiteral("L ") + QString::number(100.0 - rightBalance, 'f', 0) +
+                                           QStringLiteral("% R ") + QString::number(rightBalance, 'f', 0) +
+                                           QStringLiteral("%"));
+            }
 
             if ((!trainProgram || (trainProgram && !trainProgram->isStarted())) &&
                 !((bike *)bluetoothManager->device())->ergModeSupportedAvailableByHardware() &&
@@ -4647,11 +4871,12 @@ void homeform::update() {
                 ((rower *)bluetoothManager->device())->lastPace500m().toString(QStringLiteral("m:ss")));
 
             this->pace->setValue(((rower *)bluetoothManager->device())->currentPace().toString(QStringLiteral("m:ss")));
-            this->pace->setSecondLine(
-                QStringLiteral("AVG: ") +
-                ((rower *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
-                QStringLiteral(" MAX: ") +
-                ((rower *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
+            if (this->pace->shown())
+                this->pace->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    ((rower *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
+                    QStringLiteral(" MAX: ") +
+                    ((rower *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
             this->target_pace->setValue(
                 ((rower *)bluetoothManager->device())->lastRequestedPace().toString(QStringLiteral("m:ss")));
             if (trainProgram) {
@@ -4703,42 +4928,36 @@ void homeform::update() {
                     break;
                 }
             }
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * 1000.0, 'f', 0));
+            odometer->setValue(bluetoothManager->device()->odometer() * 1000.0, 0);
             resistance = ((rower *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((rower *)bluetoothManager->device())->pelotonResistance().value();
-            totalStrokes = ((rower *)bluetoothManager->device())->currentStrokesCount().value();
-            avgStrokesRate = ((rower *)bluetoothManager->device())->currentCadence().average();
-            maxStrokesRate = ((rower *)bluetoothManager->device())->currentCadence().max();
-            avgStrokesLength = ((rower *)bluetoothManager->device())->currentStrokesLength().average();
-            this->strokesCount->setValue(
-                QString::number(((rower *)bluetoothManager->device())->currentStrokesCount().value(), 'f', 0));
-            this->strokesLength->setValue(
-                QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().value(), 'f', 1));
-
-            this->target_speed->setValue(QString::number(
-                ((rower *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 'f', 1));
-
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
-            this->target_resistance->setValue(
-                QString::number(((rower *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((rower *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
-            this->target_cadence->setValue(
-                QString::number(((rower *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
-            this->target_power->setValue(
-                QString::number(((rower *)bluetoothManager->device())->lastRequestedPower().value(), 'f', 0));
-            this->resistance->setValue(QString::number(resistance, 'f', 0));
+            this->strokesCount->setValue(((rower *)bluetoothManager->device())->currentStrokesCount().value(), 0);
+            this->strokesLength->setValue(((rower *)bluetoothManager->device())->currentStrokesLength().value(), 1);
 
-            this->resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((rower *)bluetoothManager->device())->currentResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((rower *)bluetoothManager->device())->currentResistance().max(), 'f', 0));
-            this->peloton_resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((rower *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((rower *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
+            this->target_speed->setValue(
+                ((rower *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 1);
+
+            this->peloton_resistance->setValue(peloton_resistance, 0);
+            this->target_resistance->setValue(
+                ((rower *)bluetoothManager->device())->lastRequestedResistance().value(), 0);
+            this->target_peloton_resistance->setValue(
+                ((rower *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 0);
+            this->target_cadence->setValue(((rower *)bluetoothManager->device())->lastRequestedCadence().value(), 0);
+            this->target_power->setValue(((rower *)bluetoothManager->device())->lastRequestedPower().value(), 0);
+            this->resistance->setValue(resistance, 0);
+
+            if (this->resistance->shown())
+                this->resistance->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((rower *)bluetoothManager->device())->currentResistance().average(), 'f', 0) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((rower *)bluetoothManager->device())->currentResistance().max(), 'f', 0));
+            if (this->peloton_resistance->shown())
+                this->peloton_resistance->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((rower *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((rower *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
             this->target_resistance->setSecondLine(
                 QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) + QStringLiteral("% @0%=") +
                 QString::number(
@@ -4748,11 +4967,12 @@ void homeform::update() {
                         settings.value(QZSettings::bike_resistance_offset, QZSettings::default_bike_resistance_offset)
                             .toDouble(),
                     'f', 0));
-            this->strokesLength->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().average(), 'f', 1) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().max(), 'f', 1));
+            if (this->strokesLength->shown())
+                this->strokesLength->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().average(), 'f', 1) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().max(), 'f', 1));
 
             // if there is no training program, the color is based on presets
             if (!trainProgram || trainProgram->currentRow().speed == -1) {
@@ -4781,7 +5001,7 @@ void homeform::update() {
             }
 
         } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::JUMPROPE) {
-                odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+                odometer->setValue(bluetoothManager->device()->odometer() * unit_conversion, 2);
                 if (bluetoothManager->device()->currentSpeed().value()) {
                     pace = 10000 / (((treadmill *)bluetoothManager->device())->currentPace().second() +
                                     (((treadmill *)bluetoothManager->device())->currentPace().minute() * 60));
@@ -4799,14 +5019,15 @@ void homeform::update() {
                         ((jumprope *)bluetoothManager->device())->currentPace().toString(QStringLiteral("m:ss")));
                 else
                     this->pace->setValue("N/A");
-                this->pace->setSecondLine(
-                    QStringLiteral("AVG: ") +
-                    ((jumprope *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
-                    QStringLiteral(" MAX: ") +
-                    ((jumprope *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
-                this->inclination->setValue(QString::number(inclination, 'f', 0));
+                if (this->pace->shown())
+                    this->pace->setSecondLine(
+                        QStringLiteral("AVG: ") +
+                        ((jumprope *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
+                        QStringLiteral(" MAX: ") +
+                        ((jumprope *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
+                this->inclination->setValue(inclination, 0);
                 this->inclination->setSecondLine("");
-                this->stepCount->setValue(QString::number(stepCount, 'f', 0));
+                this->stepCount->setValue(stepCount, 0);
 
                 // Sequence of jumps resetted and number of jumps > 0, so i have to start a new lap
                 if(inclination == 0 && ((jumprope *)bluetoothManager->device())->JumpsCount.lapValue() > 0)
@@ -4819,25 +5040,27 @@ void homeform::update() {
                     ((elliptical *)bluetoothManager->device())->currentPace().toString(QStringLiteral("m:ss")));
             else
                 this->pace->setValue("N/A");
-            this->pace->setSecondLine(
-                QStringLiteral("AVG: ") +
-                ((elliptical *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
-                QStringLiteral(" MAX: ") +
-                ((elliptical *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            if (this->pace->shown())
+                this->pace->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    ((elliptical *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
+                    QStringLiteral(" MAX: ") +
+                    ((elliptical *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
+            odometer->setValue(bluetoothManager->device()->odometer() * unit_conversion, 2);
             resistance = ((elliptical *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((elliptical *)bluetoothManager->device())->pelotonResistance().value();
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
+            this->peloton_resistance->setValue(peloton_resistance, 0);
             this->target_resistance->setValue(
-                QString::number(((elliptical *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((elliptical *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
+                ((elliptical *)bluetoothManager->device())->lastRequestedResistance().value(), 0);
+            this->target_peloton_resistance->setValue(
+                ((elliptical *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 0);
             this->resistance->setValue(QString::number(resistance));
-            this->peloton_resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((elliptical *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((elliptical *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
+            if (this->peloton_resistance->shown())
+                this->peloton_resistance->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((elliptical *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((elliptical *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
             this->target_resistance->setSecondLine(
                 QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) + QStringLiteral("% @0%=") +
                 QString::number(
@@ -4848,30 +5071,32 @@ void homeform::update() {
                             .toDouble(),
                     'f', 0));
             inclination = ((elliptical *)bluetoothManager->device())->currentInclination().value();
-            this->inclination->setValue(QString::number(inclination, 'f', 1));
-            this->inclination->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((elliptical *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((elliptical *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
-            elevation->setValue(QString::number(((elliptical *)bluetoothManager->device())->elevationGain().value() *
-                                                    meter_feet_conversion,
-                                                'f', (miles ? 0 : 1)));
+            this->inclination->setValue(inclination, 1);
+            if (this->inclination->shown())
+                this->inclination->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    QString::number(((elliptical *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
+                    QStringLiteral(" MAX: ") +
+                    QString::number(((elliptical *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
+            elevation->setValue(((elliptical *)bluetoothManager->device())->elevationGain().value() *
+                                    meter_feet_conversion,
+                                miles ? 0 : 1);
             elevation->setSecondLine(
                 QString::number(((elliptical *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
                                     meter_feet_conversion,
                                 'f', (miles ? 0 : 1)) +
                 " /min");
             this->gears->setValue(QString::number(((elliptical *)bluetoothManager->device())->gears()));
-            this->target_speed->setValue(QString::number(
-                ((elliptical *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 'f', 1));
+            this->target_speed->setValue(
+                ((elliptical *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 1);
 
             this->target_cadence->setValue(
-                QString::number(((elliptical *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
+                ((elliptical *)bluetoothManager->device())->lastRequestedCadence().value(), 0);
         }
-        watt->setSecondLine(
-            QStringLiteral("AVG: ") + QString::number((bluetoothManager->device())->wattsMetric().average(), 'f', 0) +
-            QStringLiteral(" MAX: ") + QString::number((bluetoothManager->device())->wattsMetric().max(), 'f', 0));
+        if (watt->shown())
+            watt->setSecondLine(
+                QStringLiteral("AVG: ") + QString::number((bluetoothManager->device())->wattsMetric().average(), 'f', 0) +
+                QStringLiteral(" MAX: ") + QString::number((bluetoothManager->device())->wattsMetric().max(), 'f', 0));
 
         if (trainProgram) {
             int8_t lower_requested_peloton_resistance = trainProgram->currentRow().lower_requested_peloton_resistance;
@@ -4889,9 +5114,10 @@ void homeform::update() {
                         ->pelotonToEllipticalResistance(lower_requested_peloton_resistance);
 
             if (lower_requested_peloton_resistance != -1) {
-                this->target_peloton_resistance->setSecondLine(
-                    QStringLiteral("MIN: ") + QString::number(lower_requested_peloton_resistance, 'f', 0) +
-                    QStringLiteral(" MAX: ") + QString::number(upper_requested_peloton_resistance, 'f', 0));
+                if (this->target_peloton_resistance->shown())
+                    this->target_peloton_resistance->setSecondLine(
+                        QStringLiteral("MIN: ") + QString::number(lower_requested_peloton_resistance, 'f', 0) +
+                        QStringLiteral(" MAX: ") + QString::number(upper_requested_peloton_resistance, 'f', 0));
             } else {
                 this->target_peloton_resistance->setSecondLine(QLatin1String(""));
             }
@@ -4917,8 +5143,9 @@ void homeform::update() {
             int16_t lower_cadence = trainProgram->currentRow().lower_cadence;
             int16_t upper_cadence = trainProgram->currentRow().upper_cadence;
             if (lower_cadence != -1) {
-                this->target_cadence->setSecondLine(QStringLiteral("MIN: ") + QString::number(lower_cadence, 'f', 0) +
-                                                    QStringLiteral(" MAX: ") + QString::number(upper_cadence, 'f', 0));
+                if (this->target_cadence->shown())
+                    this->target_cadence->setSecondLine(QStringLiteral("MIN: ") + QString::number(lower_cadence, 'f', 0) +
+                                                        QStringLiteral(" MAX: ") + QString::number(upper_cadence, 'f', 0));
             } else {
                 this->target_cadence->setSecondLine(QLatin1String(""));
             }
@@ -5228,10 +5455,11 @@ void homeform::update() {
         }
         bluetoothManager->device()->setHeartZone(currentHRZone);
         Z = QStringLiteral("Z") + QString::number(currentHRZone, 'f', 1);
-        heart->setSecondLine(Z + QStringLiteral(" AVG: ") +
-                             QString::number((bluetoothManager->device())->currentHeart().average(), 'f', 0) +
-                             QStringLiteral(" MAX: ") +
-                             QString::number((bluetoothManager->device())->currentHeart().max(), 'f', 0));
+        if (heart->shown())
+            heart->setSecondLine(Z + QStringLiteral(" AVG: ") +
+                                 QString::number((bluetoothManager->device())->currentHeart().average(), 'f', 0) +
+                                 QStringLiteral(" MAX: ") +
+                                 QString::number((bluetoothManager->device())->currentHeart().max(), 'f', 0));
 
         /*
                 if(trainProgram)
@@ -5972,24 +6200,16 @@ void homeform::update() {
                 }
             }
 
-            if(bluetoothManager->device()->currentSpeed().value() > 0 && !isinf(bluetoothManager->device()->currentSpeed().value()))
-                bluetoothManager->device()->addCurrentDistance1s((bluetoothManager->device()->currentSpeed().value() / 3600.0));
-            
-            qDebug() << "Current Distance 1s:" << bluetoothManager->device()->currentDistance1s().value() << bluetoothManager->device()->currentSpeed().value() << watts;
+            SessionLine s = sessionRecorder->record(lapTrigger);
 
-            SessionLine s(
-                bluetoothManager->device()->currentSpeed().value(), inclination, bluetoothManager->device()->currentDistance1s().value(),
-                watts, resistance, peloton_resistance, (uint8_t)bluetoothManager->device()->currentHeart().value(),
-                pace, cadence, bluetoothManager->device()->calories().value(),
-                bluetoothManager->device()->elevationGain().value(),
-                bluetoothManager->device()->elapsedTime().second() +
-                    (bluetoothManager->device()->elapsedTime().minute() * 60) +
-                    (bluetoothManager->device()->elapsedTime().hour() * 3600),
-
-                lapTrigger, totalStrokes, avgStrokesRate, maxStrokesRate, avgStrokesLength,
-                bluetoothManager->device()->currentCordinate(), strideLength, groundContact, verticalOscillation, stepCount);
+            qDebug() << "Current Distance 1s:" << bluetoothManager->device()->currentDistance1s().value() << bluetoothManager->device()->currentSpeed().value() << watts;
 
-            Session.append(s);
+            trainingLoad.addSample(s.watt, s.heart);
+            wattChartSeries.append(s.watt);
+            heartChartSeries.append(s.heart);
+            cadenceChartSeries.append(s.cadence);
+            resistanceChartSeries.append(s.resistance);
+            pelotonResistanceChartSeries.append(s.peloton_resistance);
 
             if (lapTrigger) {
                 lapTrigger = false;
@@ -6013,6 +6233,7 @@ void homeform::update() {
         emit workoutStartDateChanged(workoutStartDate());
     }
 
+    DataObject::endUpdate();
     emit changeOfdevice();
     emit changeOflap();
 }
@@ -6204,26 +6425,19 @@ void homeform::gpx_save_clicked() {
     if (bluetoothManager->device()) {
         gpx::save(path + QDateTime::currentDateTime().toString().replace(QStringLiteral(":"), QStringLiteral("_")) +
                       QStringLiteral(".gpx"),
-                  Session, bluetoothManager->device()->deviceType());
+                  sessionRecorder->session(), bluetoothManager->device()->deviceType());
     }
 }
 
 void homeform::fit_save_clicked() {
 
-    QString path = getWritableAppDir();
     bluetoothdevice *dev = bluetoothManager->device();
     if (dev) {
-        QString filename = path +
-                           QDateTime::currentDateTime().toString().replace(QStringLiteral(":"), QStringLiteral("_")) +
-                           QStringLiteral(".fit");
-
         QString workoutName = "";
         if (!stravaPelotonActivityName.isEmpty() && !stravaPelotonInstructorName.isEmpty())
             workoutName = stravaPelotonActivityName + " - " + stravaPelotonInstructorName;
 
-        qfit::save(filename, Session, dev->deviceType(),
-                   qobject_cast<m3ibike *>(dev) ? QFIT_PROCESS_DISTANCENOISE : QFIT_PROCESS_NONE,
-                   stravaPelotonWorkoutType, workoutName, dev->bluetoothDevice.name());
+        QString filename = sessionRecorder->save(stravaPelotonWorkoutType, workoutName);
         lastFitFileSaved = filename;
 
         QSettings settings;
@@ -6251,6 +6465,19 @@ void homeform::strava_upload_file_prepare() {
     f.close();
 }
 
+void homeform::ghost_open_clicked(const QUrl &fileName) {
+    qDebug() << QStringLiteral("ghost_open_clicked") << fileName;
+
+    QString file = QQmlFile::urlToLocalFileOrQrc(fileName);
+    if (file.isEmpty())
+        return;
+    if (!GhostRider::instance()->load(file)) {
+        setToastRequested(QStringLiteral("Unable to load the ghost from ") + QFileInfo(file).fileName());
+        return;
+    }
+    setToastRequested(QStringLiteral("Racing against ") + GhostRider::instance()->name());
+}
+
 void homeform::gpx_open_clicked(const QUrl &fileName) {
     qDebug() << QStringLiteral("gpx_open_clicked") << fileName;
 
@@ -6910,8 +7137,8 @@ void homeform::sendMail() {
     message.setSender(new EmailAddress(QStringLiteral("no-reply@qzapp.it"), QStringLiteral("QZ")));
     message.addRecipient(new EmailAddress(settings.value(QZSettings::user_email, QLatin1String("")).toString(),
                                           settings.value(QZSettings::user_email, QLatin1String("")).toString()));
-    if (!Session.isEmpty()) {
-        QString title = Session.constFirst().time.toString();
+    if (!sessionRecorder->session().isEmpty()) {
+        QString title = sessionRecorder->session().constFirst().time.toString();
         if (!stravaPelotonActivityName.isEmpty()) {
             title +=
                 QStringLiteral(" ") + stravaPelotonActivityName + QStringLiteral(" - ") + stravaPelotonInstructorName;
@@ -6979,26 +7206,26 @@ void homeform::sendMail() {
         QStringLiteral("Moving Time: ") + bluetoothManager->device()->movingTime().toString() + QStringLiteral("\n");
     textMessage += QStringLiteral("Weight Loss (") + weightLossUnit + "): " + QString::number(WeightLoss, 'f', 2) +
                    QStringLiteral("\n");
-    textMessage += QStringLiteral("Estimated VO2Max: ") + QString::number(metric::calculateVO2Max(&Session), 'f', 0) +
+    textMessage += QStringLiteral("Estimated VO2Max: ") + QString::number(metric::calculateVO2Max(&sessionRecorder->session()), 'f', 0) +
                    QStringLiteral("\n");
     if(bluetoothManager->device()->deviceType() == bluetoothdevice::BLUETOOTH_TYPE::TREADMILL) {
         textMessage += QStringLiteral("Running Stress Score: ") + QString::number(((treadmill*)bluetoothManager->device())->runningStressScore(), 'f', 0) +
                        QStringLiteral("\n");
     }
-    double peak = metric::powerPeak(&Session, 5);
+    double peak = metric::powerPeak(&sessionRecorder->session(), 5);
     double weightKg = settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
     textMessage += QStringLiteral("5 Seconds Power: ") + QString::number(peak, 'f', 0) +
                    QStringLiteral("W ") + QString::number(peak/weightKg, 'f', 1) + QStringLiteral("W/Kg\n");
-    peak = metric::powerPeak(&Session, 60);
+    peak = metric::powerPeak(&sessionRecorder->session(), 60);
     textMessage += QStringLiteral("1 Minute Power: ") + QString::number(peak, 'f', 0) +
                    QStringLiteral("W ") + QString::number(peak/weightKg, 'f', 1) + QStringLiteral("W/Kg\n");
-    peak = metric::powerPeak(&Session, 5 * 60);
+    peak = metric::powerPeak(&sessionRecorder->session(), 5 * 60);
     textMessage += QStringLiteral("5 Minutes Power: ") + QString::number(peak, 'f', 0) +
                    QStringLiteral("W ") + QString::number(peak/weightKg, 'f', 1) + QStringLiteral("W/Kg\n");    
 
     // FTP
     double ftpSetting = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
-    peak = (metric::powerPeak(&Session, 20 * 60) * 0.95) * 0.95;
+    peak = (metric::powerPeak(&sessionRecorder->session(), 20 * 60) * 0.95) * 0.95;
     textMessage += QStringLiteral("Estimated FTP: ") + QString::number(peak, 'f', 0) +
                    QStringLiteral("W ");
     if(peak > ftpSetting) {
@@ -7224,37 +7451,7 @@ QString homeform::getBluetoothName()
     return QString();
 }
 
-QString homeform::getAndroidDataAppDir() {
-    static QString path = "";
-
-    if (path.length()) {
-        return path;
-    }
-
-    QAndroidJniObject filesArr = QtAndroid::androidActivity().callObjectMethod(
-        "getExternalFilesDirs", "(Ljava/lang/String;)[Ljava/io/File;", nullptr);
-    jobjectArray dataArray = filesArr.object<jobjectArray>();
-    QString out;
-    if (dataArray) {
-        QAndroidJniEnvironment env;
-        jsize dataSize = env->GetArrayLength(dataArray);
-        if (dataSize) {
-            QAndroidJniObject mediaPath;
-            QAndroidJniObject file;
-            for (int i = 0; i < dataSize; i++) {
-                file = env->GetObjectArrayElement(dataArray, i);
-                jboolean val = QAndroidJniObject::callStaticMethod<jboolean>(
-                    "android/os/Environment", "isExternalStorageRemovable", "(Ljava/io/File;)Z", file.object());
-                mediaPath = file.callObjectMethod("getAbsolutePath", "()Ljava/lang/String;");
-                out = mediaPath.toString();
-                if (!val)
-                    break;
-            }
-        }
-    }
-    path = out;
-    return out;
-}
+QString homeform::getAndroidDataAppDir() { return AppDirs::androidData(); }
 #endif
 
 quint64 homeform::cryptoKeySettingsProfiles() {
@@ -7320,11 +7517,7 @@ void homeform::loadSettings(const QUrl &filename) {
 void homeform::deleteSettings(const QUrl &filename) { QFile(filename.toLocalFile()).remove(); }
 void homeform::restoreSettings() { QZSettings::restoreAll(); }
 
-QString homeform::getProfileDir() {
-    QString path = getWritableAppDir() + "profiles";
-    QDir().mkdir(path);
-    return path;
-}
+QString homeform::getProfileDir() { return AppDirs::profiles(); }
 
 void homeform::saveProfile(QString profilename) {
     qDebug() << "homeform::saveProfile";
@@ -7354,19 +7547,7 @@ void homeform::restart() {
 #endif
 }
 
-double homeform::heartRateMax() {
-    QSettings settings;
-    double maxHeartRate = 220.0 - settings.value(QZSettings::age, QZSettings::default_age).toDouble();
-
-    if (settings.value(QZSettings::heart_max_override_enable, QZSettings::default_heart_max_override_enable).toBool())
-        maxHeartRate =
-            settings.value(QZSettings::heart_max_override_value, QZSettings::default_heart_max_override_value)
-                .toDouble();
-    if (maxHeartRate == 0) {
-        maxHeartRate = 190.0;
-    }
-    return maxHeartRate;
-}
+double homeform::heartRateMax() { return metric::heartRateMax(); }
 
 void homeform::clearFiles() {
     QString path = homeform::getWritableAppDir();
@@ -7499,3 +7680,17 @@ void homeform::videoSeekPosition(int ms) {
     auto videoPlaybackHalfPlayer = qvariant_cast<QMediaPlayer *>(videoPlaybackHalf->property("mediaObject"));
     videoPlaybackHalfPlayer->setPosition(ms);
 }
+
+QVariantMap homeform::inclinationOverridePreview(double inclination, double gain, double offset,
+                                                 const QVariantList &table) {
+    InclinationOverride::Parameters parameters;
+    parameters.gain = gain;
+    parameters.offset = offset;
+    for (int i = 0; i < InclinationOverride::points && i < table.size(); i++)
+        parameters.table[i] = table.at(i).toDouble();
+    InclinationOverride curve(parameters);
+    QVariantMap preview;
+    preview[QStringLiteral("shown")] = curve.apply(inclination);
+    preview[QStringLiteral("requested")] = curve.reverse(inclination);
+    return preview;
+}
@@ -3,6 +3,7 @@
 
 #include "PathController.h"
 #include "bluetooth.h"
+#include "chartseriescache.h"
 #include "fit_profile.hpp"
 #include "gpx.h"
 #include "peloton.h"
@@ -11,11 +12,14 @@
 #include "qmdnsengine/resolver.h"
 #include "screencapture.h"
 #include "sessionline.h"
+#include "sessionrecorder.h"
 #include "smtpclient/src/SmtpMime"
+#include "trainingload.h"
 #include "trainprogram.h"
 #include <QChart>
 #include <QColor>
 #include <QGraphicsScene>
+#include <QXYSeries>
 #include <QMediaPlayer>
 #include <QNetworkReply>
 #include <QOAuth2AuthorizationCodeFlow>
@@ -68,8 +72,15 @@ class DataObject : public QObject {
                const QString &secondLine = QLatin1String(""), const int gridId = 0, const bool largeButton = false,
                const QString largeButtonLabel = QLatin1String(""),
                const QString largeButtonColor = QZSettings::default_tile_preset_resistance_1_color);
+    ~DataObject() override;
     void setName(const QString &value);
     void setValue(const QString &value);
+
+    /**
+     * @brief setValue Shows a number with the given decimals. The number is formatted only when the tile is
+     * shown and the displayed digits changed since the last call.
+     */
+    void setValue(double value, int decimals);
     void setSecondLine(const QString &value);
     void setValueFontSize(int value);
     void setValueFontColor(const QString &value);
@@ -77,6 +88,21 @@ class DataObject : public QObject {
     void setVisible(bool visible);
     void setGridId(int id);
     void setLargeButtonColor(const QString &color);
+
+    /**
+     * @brief setShown Marks the tile as part of the model shown by the QML; hidden tiles are not formatted.
+     */
+    void setShown(bool shown);
+    bool shown() { return m_shown; }
+
+    /**
+     * @brief beginUpdate Defers the change notifications of all the tiles until endUpdate(), so a
+     * homeform::update tick reaches the QML scene graph as a single batch. Outside of an update the tiles changed
+     * in the same pass of the event loop are flushed together once it's done.
+     */
+    static void beginUpdate();
+    static void endUpdate();
+
     QString name() { return m_name; }
     QString icon() { return m_icon; }
     QString value() { return m_value; }
@@ -109,6 +135,29 @@ class DataObject : public QObject {
     QString m_largeButtonLabel = QLatin1String("");
     QString m_largeButtonColor = QZSettings::default_tile_preset_resistance_1_color;
 
+  private:
+    enum {
+        DirtyValue = 0x01,
+        DirtySecondLine = 0x02,
+        DirtyValueFontSize = 0x04,
+        DirtyValueFontColor = 0x08,
+        DirtyLabelFontSize = 0x10,
+        DirtyLargeButtonColor = 0x20,
+    };
+
+    void markDirty(int flags);
+    void flush();
+    static void flushTiles();
+
+    bool m_shown = false;
+    int m_dirty = 0;
+    qint64 m_numericValue = 0;
+    int m_numericDecimals = -1; // -1: m_value was not set from a number
+
+    static bool batching;
+    static bool flushPending;
+    static QList<DataObject *> dirtyTiles;
+
   signals:
     void valueChanged(QString value);
     void secondLineChanged(QString value);
@@ -349,6 +398,10 @@ class homeform : public QObject {
         }
     }
 
+    // the preview of the inclination override settings page, with the values of the page
+    Q_INVOKABLE QVariantMap inclinationOverridePreview(double inclination, double gain, double offset,
+                                                       const QVariantList &table);
+
     Q_INVOKABLE bool firstRun() {
         QSettings settings;
         QString proformtdf4ip = settings.value(QZSettings::proformtdf4ip, QZSettings::default_proformtdf4ip).toString();
@@ -412,8 +465,8 @@ class homeform : public QObject {
     QString stopIcon();
     QString stopColor();
     QString workoutStartDate() {
-        if (!Session.isEmpty()) {
-            return Session.constFirst().time.toString();
+        if (!sessionRecorder->session().isEmpty()) {
+            return sessionRecorder->session().constFirst().time.toString();
         } else {
             return QLatin1String("");
         }
@@ -501,7 +554,7 @@ class homeform : public QObject {
         m_stravaUploadRequested = value;
     }
     void setGeneralPopupVisible(bool value);
-    int workout_sample_points() { return Session.count(); }
+    int workout_sample_points() { return sessionRecorder->session().count(); }
     int preview_workout_points();
 
 #if defined(Q_OS_ANDROID)
@@ -526,50 +579,75 @@ class homeform : public QObject {
     Q_INVOKABLE void sendMail();
 
     Q_INVOKABLE void sortTiles();
+    Q_INVOKABLE QString latencyReport() { return QZMetrics::latencyReport() + PollScheduler::instance()->report(); }
     Q_INVOKABLE void moveTile(QString name, int newIndex, int oldIndex);
     DataObject *tileFromName(QString name);
 
     QList<double> workout_watt_points() {
         QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
+        l.reserve(sessionRecorder->session().size() + 1);
+        for (const SessionLine &s : qAsConst(sessionRecorder->session())) {
             l.append(s.watt);
         }
         return l;
     }
     QList<double> workout_heart_points() {
         QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
+        l.reserve(sessionRecorder->session().size() + 1);
+        for (const SessionLine &s : qAsConst(sessionRecorder->session())) {
             l.append(s.heart);
         }
         return l;
     }
     QList<double> workout_cadence_points() {
         QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
+        l.reserve(sessionRecorder->session().size() + 1);
+        for (const SessionLine &s : qAsConst(sessionRecorder->session())) {
             l.append(s.cadence);
         }
         return l;
     }
     QList<double> workout_resistance_points() {
         QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
+        l.reserve(sessionRecorder->session().size() + 1);
+        for (const SessionLine &s : qAsConst(sessionRecorder->session())) {
             l.append(s.resistance);
         }
         return l;
     }
     QList<double> workout_peloton_resistance_points() {
         QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
+        l.reserve(sessionRecorder->session().size() + 1);
+        for (const SessionLine &s : qAsConst(sessionRecorder->session())) {
             l.append(s.peloton_resistance);
         }
         return l;
     }
 
+    /**
+     * @brief workout_chart_points At most maxPoints points of the session samples [from, to) of a metric, for the
+     * live charts of the web templates. x is the sample index.
+     */
+    QVector<QPointF> workout_chart_points(const QString &metric, int from, int to, int maxPoints) {
+        ChartSeriesCache *cache = chartSeriesCache(metric);
+        return cache ? cache->points(from, to, maxPoints) : QVector<QPointF>();
+    }
+
+    /**
+     * @brief workout_chart_series Fills a QML LineSeries with at most maxPoints points of the session samples
+     * [from, to) of a metric ("watt", "heart", "cadence", "resistance" or "peloton_resistance"). x is in ms.
+     */
+    Q_INVOKABLE void workout_chart_series(QtCharts::QAbstractSeries *series, const QString &metric, int from, int to,
+                                          int maxPoints) {
+        auto *xySeries = qobject_cast<QtCharts::QXYSeries *>(series);
+        if (!xySeries)
+            return;
+        QVector<QPointF> points = workout_chart_points(metric, from, to, maxPoints);
+        for (QPointF &p : points)
+            p.setX(p.x() * 1000.0);
+        xySeries->replace(points);
+    }
+
     QList<double> preview_workout_watt() {
         QList<double> l;
         if (!previewTrainProgram)
@@ -685,13 +763,24 @@ class homeform : public QObject {
     DataObject *preset_powerzone_5;
     DataObject *preset_powerzone_6;
     DataObject *preset_powerzone_7;    
+    DataObject *pedalStroke;
+    DataObject *ghostTime;
+    DataObject *ghostDistance;
+    DataObject *ghostPower;
+    DataObject *normalizedPower;
+    DataObject *tss;
+    DataObject *wPrimeBalance;
+    DataObject *powerZoneTime;
+
+    // the training load of the session, one sample with every line of it
+    TrainingLoad trainingLoad;
 
   private:
     static homeform *m_singleton;
     TemplateInfoSenderBuilder *userTemplateManager = nullptr;
     TemplateInfoSenderBuilder *innerTemplateManager = nullptr;
     QList<QObject *> dataList;
-    QList<SessionLine> Session;
+    SessionRecorder *sessionRecorder = nullptr;
     QQmlApplicationEngine *engine;
     trainprogram *trainProgram = nullptr;
     trainprogram *previewTrainProgram = nullptr;
@@ -752,6 +841,15 @@ class homeform : public QObject {
     QTimer *timer;
     QTimer *backupTimer;
 
+    ChartSeriesCache wattChartSeries;
+    ChartSeriesCache heartChartSeries;
+    ChartSeriesCache cadenceChartSeries;
+    ChartSeriesCache resistanceChartSeries;
+    ChartSeriesCache pelotonResistanceChartSeries;
+    ChartSeriesCache *chartSeriesCache(const QString &metric);
+    QZMetrics::TimerProbe updateTimerProbe = QZMetrics::TimerProbe(1000);
+    int latencyReportTicks = 0;
+
     QString strava_code;
     QOAuth2AuthorizationCodeFlow *strava_connect();
     void strava_refreshtoken();
@@ -770,7 +868,7 @@ class homeform : public QObject {
     int16_t fanOverride = 0;
 
     void update();
-    double heartRateMax();
+    static double heartRateMax();
     void backup();
     bool getDevice();
     bool getLap();
@@ -842,6 +940,7 @@ class homeform : public QObject {
     void gpxpreview_open_clicked(const QUrl &fileName);
     void trainprogram_zwo_loaded(const QString &comp);
     void gpx_open_clicked(const QUrl &fileName);
+    void ghost_open_clicked(const QUrl &fileName);
     void gpx_save_clicked();
     void fit_save_clicked();
     void strava_connect_clicked();
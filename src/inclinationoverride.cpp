@@ -0,0 +1,142 @@
+#include "inclinationoverride.h"
+#include "qzsettings.h"
+#include "settingscache.h"
+
+#include <QDebug>
+#include <QSettings>
+#include <algorithm>
+
+namespace {
+
+// the settings of the points of the table, every 0.5%
+const QString *const tableKeys[InclinationOverride::points] = {
+    &QZSettings::treadmill_inclination_override_0,
+    &QZSettings::treadmill_inclination_override_05,
+    &QZSettings::treadmill_inclination_override_10,
+    &QZSettings::treadmill_inclination_override_15,
+    &QZSettings::treadmill_inclination_override_20,
+    &QZSettings::treadmill_inclination_override_25,
+    &QZSettings::treadmill_inclination_override_30,
+    &QZSettings::treadmill_inclination_override_35,
+    &QZSettings::treadmill_inclination_override_40,
+    &QZSettings::treadmill_inclination_override_45,
+    &QZSettings::treadmill_inclination_override_50,
+    &QZSettings::treadmill_inclination_override_55,
+    &QZSettings::treadmill_inclination_override_60,
+    &QZSettings::treadmill_inclination_override_65,
+    &QZSettings::treadmill_inclination_override_70,
+    &QZSettings::treadmill_inclination_override_75,
+    &QZSettings::treadmill_inclination_override_80,
+    &QZSettings::treadmill_inclination_override_85,
+    &QZSettings::treadmill_inclination_override_90,
+    &QZSettings::treadmill_inclination_override_95,
+    &QZSettings::treadmill_inclination_override_100,
+    &QZSettings::treadmill_inclination_override_105,
+    &QZSettings::treadmill_inclination_override_110,
+    &QZSettings::treadmill_inclination_override_115,
+    &QZSettings::treadmill_inclination_override_120,
+    &QZSettings::treadmill_inclination_override_125,
+    &QZSettings::treadmill_inclination_override_130,
+    &QZSettings::treadmill_inclination_override_135,
+    &QZSettings::treadmill_inclination_override_140,
+    &QZSettings::treadmill_inclination_override_145,
+    &QZSettings::treadmill_inclination_override_150,
+};
+
+const double tableDefaults[InclinationOverride::points] = {
+    QZSettings::default_treadmill_inclination_override_0, QZSettings::default_treadmill_inclination_override_05,
+    QZSettings::default_treadmill_inclination_override_10, QZSettings::default_treadmill_inclination_override_15,
+    QZSettings::default_treadmill_inclination_override_20, QZSettings::default_treadmill_inclination_override_25,
+    QZSettings::default_treadmill_inclination_override_30, QZSettings::default_treadmill_inclination_override_35,
+    QZSettings::default_treadmill_inclination_override_40, QZSettings::default_treadmill_inclination_override_45,
+    QZSettings::default_treadmill_inclination_override_50, QZSettings::default_treadmill_inclination_override_55,
+    QZSettings::default_treadmill_inclination_override_60, QZSettings::default_treadmill_inclination_override_65,
+    QZSettings::default_treadmill_inclination_override_70, QZSettings::default_treadmill_inclination_override_75,
+    QZSettings::default_treadmill_inclination_override_80, QZSettings::default_treadmill_inclination_override_85,
+    QZSettings::default_treadmill_inclination_override_90, QZSettings::default_treadmill_inclination_override_95,
+    QZSettings::default_treadmill_inclination_override_100, QZSettings::default_treadmill_inclination_override_105,
+    QZSettings::default_treadmill_inclination_override_110, QZSettings::default_treadmill_inclination_override_115,
+    QZSettings::default_treadmill_inclination_override_120, QZSettings::default_treadmill_inclination_override_125,
+    QZSettings::default_treadmill_inclination_override_130, QZSettings::default_treadmill_inclination_override_135,
+    QZSettings::default_treadmill_inclination_override_140, QZSettings::default_treadmill_inclination_override_145,
+    QZSettings::default_treadmill_inclination_override_150,
+};
+
+} // namespace
+
+InclinationOverride::Parameters::Parameters() {
+    for (int i = 0; i < points; i++)
+        table[i] = tableDefaults[i];
+}
+
+bool InclinationOverride::Parameters::operator==(const Parameters &other) const {
+    return gain == other.gain && offset == other.offset && std::equal(table, table + points, other.table);
+}
+
+InclinationOverride::InclinationOverride() : InclinationOverride(Parameters()) {}
+
+InclinationOverride::InclinationOverride(const Parameters &parameters) : p(parameters) {
+    // a point lower than the one before would make the inverse ambiguous: it's raised to the one before
+    curve[0] = p.table[0];
+    for (int i = 1; i < points; i++) {
+        curve[i] = p.table[i] < curve[i - 1] ? curve[i - 1] : p.table[i];
+        if (curve[i] != p.table[i])
+            qDebug() << "InclinationOverride: the override of" << i * step << "% is lower than the one before"
+                     << p.table[i] << "<" << curve[i - 1];
+    }
+}
+
+const InclinationOverride &InclinationOverride::fromSettings() {
+    static thread_local SettingsCache<InclinationOverride> cache;
+    return cache.get([](InclinationOverride &model) {
+        Parameters parameters = parametersFromSettings();
+        if (parameters != model.parameters()) {
+            model = InclinationOverride(parameters);
+            qDebug() << "InclinationOverride: gain" << parameters.gain << "offset" << parameters.offset;
+        }
+    });
+}
+
+InclinationOverride::Parameters InclinationOverride::parametersFromSettings() {
+    QSettings settings;
+    Parameters r;
+    r.gain = settings
+                 .value(QZSettings::treadmill_inclination_ovveride_gain,
+                        QZSettings::default_treadmill_inclination_ovveride_gain)
+                 .toDouble();
+    r.offset = settings
+                   .value(QZSettings::treadmill_inclination_ovveride_offset,
+                          QZSettings::default_treadmill_inclination_ovveride_offset)
+                   .toDouble();
+    for (int i = 0; i < points; i++)
+        r.table[i] = settings.value(*tableKeys[i], tableDefaults[i]).toDouble();
+    return r;
+}
+
+double InclinationOverride::apply(double inclination) const {
+    double u = inclination * p.gain + p.offset;
+    // the table considers only 0% to 15%
+    if (u < 0 || u > maxInclination)
+        return u;
+    int index = qMin((int)(u / step), points - 2);
+    double fraction = u / step - index;
+    return curve[index] + (curve[index + 1] - curve[index]) * fraction;
+}
+
+double InclinationOverride::reverse(double inclination) const {
+    double u;
+    if (inclination < curve[0]) {
+        u = inclination < 0 ? inclination : 0;
+    } else if (inclination > curve[points - 1] && inclination > maxInclination) {
+        u = inclination;
+    } else if (inclination >= curve[points - 1]) {
+        u = maxInclination;
+    } else {
+        // the segment ending at the first point above: on a flat segment its last point, as apply() reaches it too
+        int index = std::upper_bound(curve, curve + points, inclination) - curve - 1;
+        u = (index + (inclination - curve[index]) / (curve[index + 1] - curve[index])) * step;
+    }
+    if (p.gain == 0)
+        return u;
+    return (u - p.offset) / p.gain;
+}
@@ -0,0 +1,55 @@
+#ifndef INCLINATIONOVERRIDE_H
+#define INCLINATIONOVERRIDE_H
+
+/**
+ * @brief The treadmill inclination override curve: the inclination read from the treadmill, after the override
+ * gain and offset, mapped through the 0% to 15% table of the settings. The table is compiled once into a
+ * non-decreasing array indexed by the half percent, with a linear interpolation between the points and an exact
+ * inverse for the inclinations requested to the treadmill.
+ */
+class InclinationOverride {
+  public:
+    static const int points = 31;                // 0% to 15% every 0.5%
+    static constexpr double step = 0.5;          // between two points of the table
+    static constexpr double maxInclination = 15; // the last point of the table
+
+    struct Parameters {
+        Parameters();
+        bool operator==(const Parameters &other) const;
+        bool operator!=(const Parameters &other) const { return !(*this == other); }
+
+        double gain = 1;
+        double offset = 0;
+        double table[points]; // the inclination shown for 0%, 0.5%, ... 15%
+    };
+
+    InclinationOverride();
+    explicit InclinationOverride(const Parameters &parameters);
+
+    /**
+     * @brief fromSettings The curve of the current settings, kept in a SettingsCache and compiled again only when
+     * they changed.
+     */
+    static const InclinationOverride &fromSettings();
+    static Parameters parametersFromSettings();
+
+    const Parameters &parameters() const { return p; }
+
+    /**
+     * @brief apply The inclination to show for an inclination read from the treadmill. Outside of the table,
+     * below 0% or above 15% after the gain and the offset, the inclination is left as it is.
+     */
+    double apply(double inclination) const;
+
+    /**
+     * @brief reverse The inclination to request to the treadmill to have inclination shown: apply(reverse(x)) is x
+     * for every x apply() can return. The values apply() can't return go to the closest end of the table.
+     */
+    double reverse(double inclination) const;
+
+  private:
+    Parameters p;
+    double curve[points]; // the table made non-decreasing
+};
+
+#endif // INCLINATIONOVERRIDE_H
@@ -0,0 +1,328 @@
+#include "influxexporter.h"
+#include "appdirs.h"
+#include "devices/bluetooth.h"
+#include "qzmetrics.h"
+#include "qzsettings.h"
+#include "sessionrecorder.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSettings>
+#include <math.h>
+
+namespace {
+
+// the longest the exporter waits after failed sends before trying again, in ms
+const int maxBackoffMs = 60000;
+
+quint32 crc32(const QByteArray &data) {
+    static quint32 table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (quint32 i = 0; i < 256; i++) {
+            quint32 c = i;
+            for (int k = 0; k < 8; k++)
+                c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        tableReady = true;
+    }
+    quint32 crc = 0xFFFFFFFF;
+    for (char b : data)
+        crc = table[(crc ^ (quint8)b) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFF;
+}
+
+void appendLE32(QByteArray &out, quint32 v) {
+    for (int i = 0; i < 4; i++)
+        out.append((char)((v >> (8 * i)) & 0xFF));
+}
+
+// measurement names escape commas and spaces, tag keys and values equal signs too
+QByteArray escape(const QString &s, bool tag) {
+    QByteArray out;
+    for (char c : s.toUtf8()) {
+        if (c == ',' || c == ' ' || (tag && c == '='))
+            out.append('\\');
+        out.append(c);
+    }
+    return out;
+}
+
+void appendField(QByteArray &out, const char *name, double value) {
+    if (!std::isfinite(value))
+        return;
+    out.append(out.endsWith(' ') ? "" : ",").append(name).append('=').append(QByteArray::number(value, 'g', 12));
+}
+
+void appendField(QByteArray &out, const char *name, qint64 value) {
+    out.append(out.endsWith(' ') ? "" : ",").append(name).append('=').append(QByteArray::number(value)).append('i');
+}
+
+QString typeName(bluetoothdevice::BLUETOOTH_TYPE type) {
+    switch (type) {
+    case bluetoothdevice::TREADMILL:
+        return QStringLiteral("treadmill");
+    case bluetoothdevice::BIKE:
+        return QStringLiteral("bike");
+    case bluetoothdevice::ROWING:
+        return QStringLiteral("rower");
+    case bluetoothdevice::ELLIPTICAL:
+        return QStringLiteral("elliptical");
+    case bluetoothdevice::JUMPROPE:
+        return QStringLiteral("jumprope");
+    default:
+        return QString();
+    }
+}
+
+} // namespace
+
+InfluxSpool::InfluxSpool(const QString &path, qint64 maxBytes) : dir(path), maxBytes(maxBytes) {
+    if (path.isEmpty())
+        return;
+    dir.mkpath(QStringLiteral("."));
+    // the names are zero padded counters: sorted by name is oldest first
+    files = dir.entryList({QStringLiteral("*.lp")}, QDir::Files, QDir::Name);
+    for (const QString &file : qAsConst(files))
+        total += QFileInfo(dir.filePath(file)).size();
+    if (!files.isEmpty())
+        next = files.last().chopped(3).toULongLong() + 1;
+}
+
+int InfluxSpool::push(const QByteArray &batch) {
+    int dropped = 0;
+    if (dir.path().isEmpty() || batch.size() > maxBytes)
+        return batch.count('\n');
+    while (!files.isEmpty() && total + batch.size() > maxBytes) {
+        dropped += head().count('\n');
+        pop();
+    }
+
+    QString file = QStringLiteral("%1.lp").arg(next++, 16, 10, QLatin1Char('0'));
+    QFile f(dir.filePath(file));
+    if (!f.open(QIODevice::WriteOnly) || f.write(batch) != batch.size()) {
+        qDebug() << QStringLiteral("InfluxSpool can't write") << f.fileName() << f.errorString();
+        f.remove();
+        return dropped + batch.count('\n');
+    }
+    files.append(file);
+    total += batch.size();
+    return dropped;
+}
+
+QByteArray InfluxSpool::head() const {
+    if (files.isEmpty())
+        return QByteArray();
+    QFile f(dir.filePath(files.first()));
+    if (!f.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return f.readAll();
+}
+
+void InfluxSpool::pop() {
+    if (files.isEmpty())
+        return;
+    QFile f(dir.filePath(files.takeFirst()));
+    total -= f.size();
+    f.remove();
+}
+
+InfluxExporter::Config InfluxExporter::fromSettings() {
+    QSettings settings;
+    Config config;
+    config.url = settings.value(QZSettings::influxdb_url, QZSettings::default_influxdb_url).toString();
+    config.token = settings.value(QZSettings::influxdb_token, QZSettings::default_influxdb_token).toString();
+    config.measurement =
+        settings.value(QZSettings::influxdb_measurement, QZSettings::default_influxdb_measurement).toString();
+    config.batchPoints =
+        settings.value(QZSettings::influxdb_batch_points, QZSettings::default_influxdb_batch_points).toInt();
+    config.batchMs = settings.value(QZSettings::influxdb_batch_ms, QZSettings::default_influxdb_batch_ms).toInt();
+    config.gzip = settings.value(QZSettings::influxdb_gzip, QZSettings::default_influxdb_gzip).toBool();
+    config.spoolPath = AppDirs::writable() + QStringLiteral("influx/");
+    config.spoolBytes =
+        settings.value(QZSettings::influxdb_spool_kb, QZSettings::default_influxdb_spool_kb).toLongLong() * 1024;
+    return config;
+}
+
+InfluxExporter::InfluxExporter(const Config &config, bluetooth *manager, QObject *parent)
+    : QObject(parent), config(config), url(config.url), manager(manager),
+      m_spool(config.spoolPath, config.spoolBytes) {
+    if (this->config.batchPoints < 1)
+        this->config.batchPoints = 1;
+    network = new QNetworkAccessManager(this);
+
+    batchTimer.setSingleShot(true);
+    connect(&batchTimer, &QTimer::timeout, this, &InfluxExporter::flush);
+    retryTimer.setSingleShot(true);
+    connect(&retryTimer, &QTimer::timeout, this, &InfluxExporter::sendNext);
+    if (manager) {
+        connect(&sampler, &QTimer::timeout, this, &InfluxExporter::sample);
+        sampler.start(1000);
+    }
+
+    QZMetrics::setGauge(QZMetrics::InfluxSpoolBytes, m_spool.bytes());
+    qDebug() << QStringLiteral("InfluxExporter writing to") << url.toString(QUrl::RemoveQuery)
+             << QStringLiteral("spooled batches") << m_spool.batches();
+    // what was left by the last run
+    sendNext();
+}
+
+InfluxExporter::~InfluxExporter() {
+    // nothing is sent anymore: what's pending waits for the next run
+    if (reply) {
+        reply->disconnect(this);
+        reply->abort();
+        if (!inFlightFromSpool)
+            spoolBatch(inFlight);
+    }
+    if (!batch.isEmpty())
+        spoolBatch(batch);
+}
+
+QByteArray InfluxExporter::line(const SessionLine &s, const QString &measurement, const QString &device,
+                                const QString &type) {
+    QByteArray out = escape(measurement, false);
+    if (!device.isEmpty())
+        out.append(",device=").append(escape(device, true));
+    if (!type.isEmpty())
+        out.append(",type=").append(escape(type, true));
+    out.append(' ');
+
+    appendField(out, "speed", s.speed);
+    appendField(out, "inclination", (qint64)s.inclination);
+    appendField(out, "distance", s.distance);
+    appendField(out, "watts", (qint64)s.watt);
+    appendField(out, "resistance", (qint64)s.resistance);
+    appendField(out, "peloton_resistance", (qint64)s.peloton_resistance);
+    appendField(out, "heart", (qint64)s.heart);
+    appendField(out, "cadence", (qint64)s.cadence);
+    appendField(out, "pace", s.pace);
+    appendField(out, "calories", s.calories);
+    appendField(out, "elevation_gain", s.elevationGain);
+    appendField(out, "elapsed", (qint64)s.elapsedTime);
+    if (s.totalStrokes)
+        appendField(out, "strokes", (qint64)s.totalStrokes);
+    if (s.stepCount > 0)
+        appendField(out, "steps", s.stepCount);
+    if (s.coordinate.isValid()) {
+        appendField(out, "latitude", s.coordinate.latitude());
+        appendField(out, "longitude", s.coordinate.longitude());
+    }
+
+    out.append(' ').append(QByteArray::number(s.time.toMSecsSinceEpoch() * 1000000)).append('\n');
+    return out;
+}
+
+QByteArray InfluxExporter::gzip(const QByteArray &data) {
+    // qCompress gives a 4 bytes size, the 2 bytes zlib header, the deflate stream and the 4 bytes adler32
+    QByteArray zlib = qCompress(data, 6);
+    static const char header[] = {'\x1f', '\x8b', '\x08', 0, 0, 0, 0, 0, 0, '\xff'};
+    QByteArray out(header, sizeof(header));
+    out.append(zlib.constData() + 6, zlib.size() - 10);
+    appendLE32(out, crc32(data));
+    appendLE32(out, (quint32)data.size());
+    return out;
+}
+
+void InfluxExporter::sample() {
+    bluetoothdevice *device = manager->device();
+    if (!device)
+        return;
+    write(line(SessionRecorder::sample(device), config.measurement, device->bluetoothDevice.name(),
+               typeName(device->deviceType())));
+}
+
+void InfluxExporter::write(const QByteArray &point) {
+    batch.append(point);
+    if (++batchPoints >= config.batchPoints)
+        flush();
+    else if (!batchTimer.isActive())
+        batchTimer.start(config.batchMs);
+}
+
+void InfluxExporter::flush() {
+    batchTimer.stop();
+    if (batch.isEmpty())
+        return;
+    QByteArray b = batch;
+    batch.clear();
+    batchPoints = 0;
+    // the spooled batches go first, a new one waits behind them
+    if (!reply && m_spool.isEmpty() && !retryTimer.isActive())
+        send(b, false);
+    else
+        spoolBatch(b);
+}
+
+void InfluxExporter::spoolBatch(const QByteArray &b) {
+    int dropped = m_spool.push(b);
+    if (dropped) {
+        qDebug() << QStringLiteral("InfluxExporter spool full, points dropped:") << dropped;
+        QZMetrics::increment(QZMetrics::InfluxPointsDropped, 0, dropped);
+    }
+    QZMetrics::setGauge(QZMetrics::InfluxSpoolBytes, m_spool.bytes());
+}
+
+void InfluxExporter::send(const QByteArray &b, bool fromSpool) {
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("text/plain; charset=utf-8"));
+    if (!config.token.isEmpty())
+        request.setRawHeader("Authorization", "Token " + config.token.toUtf8());
+    if (config.gzip)
+        request.setRawHeader("Content-Encoding", "gzip");
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    request.setTransferTimeout(10000);
+#endif
+
+    inFlight = b;
+    inFlightFromSpool = fromSpool;
+    reply = network->post(request, config.gzip ? gzip(b) : b);
+    connect(reply, &QNetworkReply::finished, this, &InfluxExporter::replyFinished);
+}
+
+void InfluxExporter::sendNext() {
+    if (!reply && !retryTimer.isActive() && !m_spool.isEmpty())
+        send(m_spool.head(), true);
+}
+
+void InfluxExporter::replyFinished() {
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    QString error = reply->errorString();
+    reply->deleteLater();
+    reply = nullptr;
+    int points = inFlight.count('\n');
+
+    // 400, 413 and 422: the server will never take this batch
+    bool rejected = status == 400 || status == 413 || status == 422;
+    if ((status >= 200 && status < 300) || rejected) {
+        if (rejected) {
+            qDebug() << QStringLiteral("InfluxExporter batch rejected:") << status << error;
+            QZMetrics::increment(QZMetrics::InfluxPointsDropped, 0, points);
+        } else {
+            QZMetrics::increment(QZMetrics::InfluxPointsSent, 0, points);
+        }
+        if (inFlightFromSpool) {
+            m_spool.pop();
+            QZMetrics::setGauge(QZMetrics::InfluxSpoolBytes, m_spool.bytes());
+        }
+        inFlight.clear();
+        errors = 0;
+        sendNext();
+        return;
+    }
+
+    // no network, server down or overloaded: the batch is sent again later
+    if (!inFlightFromSpool)
+        spoolBatch(inFlight);
+    inFlight.clear();
+    int backoff = qMin(maxBackoffMs, 1000 << qMin(errors, 6));
+    errors++;
+    qDebug() << QStringLiteral("InfluxExporter send failed:") << status << error << QStringLiteral("next try in")
+             << backoff << QStringLiteral("ms");
+    retryTimer.start(backoff);
+}
@@ -0,0 +1,132 @@
+#ifndef INFLUXEXPORTER_H
+#define INFLUXEXPORTER_H
+
+#include <QByteArray>
+#include <QDir>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QUrl>
+
+#include "sessionline.h"
+
+class bluetooth;
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * @brief Batches of InfluxDB points waiting on disk to be sent, one file per batch, oldest first.
+ * When a new batch doesn't fit in maxBytes the oldest batches are deleted. It survives a restart of the app.
+ */
+class InfluxSpool {
+  public:
+    InfluxSpool(const QString &path, qint64 maxBytes);
+
+    bool isEmpty() const { return files.isEmpty(); }
+    int batches() const { return files.size(); }
+    qint64 bytes() const { return total; }
+
+    /**
+     * @brief push Adds a batch after the others.
+     * @return the points deleted to stay in maxBytes, the batch itself when it's larger than maxBytes
+     */
+    int push(const QByteArray &batch);
+
+    /**
+     * @brief head The oldest batch, empty if there is none.
+     */
+    QByteArray head() const;
+    void pop();
+
+  private:
+    QDir dir;
+    qint64 maxBytes;
+    qint64 total = 0;
+    quint64 next = 0;
+    QStringList files;
+};
+
+/**
+ * @brief Writes the workout to an InfluxDB server (v1 or v2 /write endpoint) in the line protocol: a point every
+ * second from SessionRecorder::sample(), sent in batches of batchPoints points or every batchMs, gzipped.
+ * Batches that can't be sent (no network, server down or overloaded) wait in an InfluxSpool and are sent again,
+ * oldest first, once the server answers; a batch is sent at least once unless the spool overflows or the server
+ * rejects it as malformed. Only created when the influxdb_url setting is set.
+ */
+class InfluxExporter : public QObject {
+    Q_OBJECT
+
+  public:
+    struct Config {
+        QString url; // the full write URL, e.g. http://host:8086/api/v2/write?org=me&bucket=qz
+        QString token;
+        QString measurement = QStringLiteral("workout");
+        int batchPoints = 10;
+        int batchMs = 5000;
+        bool gzip = true;
+        QString spoolPath;
+        qint64 spoolBytes = 10 * 1024 * 1024;
+    };
+
+    /**
+     * @brief fromSettings The influxdb_* settings, the spool in the influx folder of the app.
+     */
+    static Config fromSettings();
+
+    /**
+     * @param manager the points are sampled from its device every second, none are sampled without it
+     */
+    explicit InfluxExporter(const Config &config, bluetooth *manager = nullptr, QObject *parent = nullptr);
+    ~InfluxExporter();
+
+    /**
+     * @brief line The point of a sample in the line protocol, with the device name and type as tags and the time
+     * of the sample in ns. Not finite values are left out.
+     */
+    static QByteArray line(const SessionLine &s, const QString &measurement, const QString &device,
+                           const QString &type);
+
+    /**
+     * @brief gzip The data in the gzip format (RFC 1952) of a Content-Encoding: gzip body.
+     */
+    static QByteArray gzip(const QByteArray &data);
+
+    /**
+     * @brief write Adds a line protocol point, ending with a new line, to the current batch.
+     */
+    void write(const QByteArray &point);
+
+    /**
+     * @brief flush Sends the current batch now, or spools it if the server can't take it.
+     */
+    void flush();
+
+    const InfluxSpool &spool() const { return m_spool; }
+
+  private slots:
+    void sample();
+    void replyFinished();
+    void sendNext();
+
+  private:
+    void send(const QByteArray &batch, bool fromSpool);
+    void spoolBatch(const QByteArray &batch);
+
+    Config config;
+    QUrl url;
+    bluetooth *manager;
+    QNetworkAccessManager *network;
+    QNetworkReply *reply = nullptr;
+    QByteArray inFlight;
+    bool inFlightFromSpool = false;
+    QByteArray batch;
+    int batchPoints = 0;
+    QTimer batchTimer;
+    QTimer retryTimer;
+    QTimer sampler;
+    int errors = 0; // consecutive failed sends, each one doubles the wait before the next one
+    InfluxSpool m_spool;
+};
+
+#endif // INFLUXEXPORTER_H
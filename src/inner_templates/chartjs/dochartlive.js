@@ -36,6 +36,7 @@ var powerChart = null;
 var watts_max = 0;
 
 var firstElapsedTargetPower = 0;
+var compactingPower = false;
 
 function process_trainprogram(arr) {
     let powerWorkout = false;
@@ -409,10 +410,51 @@ function process_workout(arr) {
     powerChart.data.datasets[0].data.push({x: (arr.elapsed_s + (arr.elapsed_m * 60) + (arr.elapsed_h * 3600)) - firstElapsedTargetPower, y: arr.watts});
     if(watts_max < arr.watts)
         watts_max = arr.watts;
+    compact_power();
     powerChart.update();
     refresh();
 }
 
+// the samples of the session are one per second, so the elapsed seconds are the sample index of the app cache:
+// once the live series has two points per pixel, it's replaced by the peaks kept by the app
+function compact_power() {
+    let maxPoints = Math.max(Math.round(powerChart.width), 300);
+    if (compactingPower || powerChart.data.datasets[0].data.length <= maxPoints * 2)
+        return;
+    compactingPower = true;
+    let offset = firstElapsedTargetPower;
+    let el = new MainWSQueueElement({
+        msg: 'getchartseries',
+        content: {
+            metric: 'watt',
+            from: offset,
+            maxPoints: maxPoints
+        }
+    }, function(msg) {
+        if (msg.msg === 'R_getchartseries' && msg.content.metric === 'watt') {
+            return msg.content.points;
+        }
+        return null;
+    }, 5000, 1);
+    el.enqueue().then(function(points) {
+        compactingPower = false;
+        if (offset !== firstElapsedTargetPower || !points.length)
+            return;
+        let data = points.map(function(p) { return {x: p.x - offset, y: p.y}; });
+        let last = data[data.length - 1].x;
+        // the samples arrived while waiting for the answer
+        for (let p of powerChart.data.datasets[0].data) {
+            if (p.x > last)
+                data.push(p);
+        }
+        powerChart.data.datasets[0].data = data;
+        powerChart.update();
+    }).catch(function(err) {
+        compactingPower = false;
+        console.error('Error is ' + err);
+    });
+}
+
 function dochart_init() {
     onSettingsOK = true;
     keys_arr = ['ftp', 'miles_unit', 'age', 'heart_rate_zone1', 'heart_rate_zone2', 'heart_rate_zone3', 'heart_rate_zone4', 'heart_max_override_enable', 'heart_max_override_value']
@@ -33,6 +33,7 @@ var maxHeartRate = 190;
 var heartZones = [];
 var miles = 1;
 var heartChart = null;
+var compactingHeart = false;
 
 function process_trainprogram_heart(arr) {
     let powerWorkout = false;
@@ -372,10 +373,48 @@ function process_workout_heart(arr) {
     heartChart.data.datasets[0].data.push({x: elapsed, y: arr.heart});
     if(elapsed > heartChart.options.scales.x.max)
         heartChart.options.scales.x.max = elapsed;
+    compact_heart();
     heartChart.update();
     refresh_heart();
 }
 
+// as compact_power(): the live series is replaced by the peaks kept by the app once it has two points per pixel
+function compact_heart() {
+    let maxPoints = Math.max(Math.round(heartChart.width), 300);
+    if (compactingHeart || heartChart.data.datasets[0].data.length <= maxPoints * 2)
+        return;
+    compactingHeart = true;
+    let el = new MainWSQueueElement({
+        msg: 'getchartseries',
+        content: {
+            metric: 'heart',
+            from: 0,
+            maxPoints: maxPoints
+        }
+    }, function(msg) {
+        if (msg.msg === 'R_getchartseries' && msg.content.metric === 'heart') {
+            return msg.content.points;
+        }
+        return null;
+    }, 5000, 1);
+    el.enqueue().then(function(points) {
+        compactingHeart = false;
+        if (!points.length)
+            return;
+        let last = points[points.length - 1].x;
+        // the samples arrived while waiting for the answer
+        for (let p of heartChart.data.datasets[0].data) {
+            if (p.x > last)
+                points.push(p);
+        }
+        heartChart.data.datasets[0].data = points;
+        heartChart.update();
+    }).catch(function(err) {
+        compactingHeart = false;
+        console.error('Error is ' + err);
+    });
+}
+
 function dochartheart_init() {
     onSettingsOK = true;
     keys_arr = ['ftp', 'miles_unit', 'age', 'heart_rate_zone1', 'heart_rate_zone2', 'heart_rate_zone3', 'heart_rate_zone4', 'heart_max_override_enable', 'heart_max_override_value']
@@ -5,11 +5,15 @@
 #ifdef Q_OS_LINUX
 #ifndef Q_OS_ANDROID
 #include <unistd.h> // getuid
+#include <csignal>
+#include <sys/socket.h>
+#include <QSocketNotifier>
 #include "EventHandler.h"
 #endif
 #endif
 #include <QQmlContext>
 
+#include "appdirs.h"
 #include "bluetooth.h"
 #include "devices/domyostreadmill/domyostreadmill.h"
 #include "homeform.h"
@@ -26,7 +30,11 @@
 #include <QtWebView/QtWebView>
 #endif
 
+#include "influxexporter.h"
 #include "mqttpublisher.h"
+#ifdef Q_HTTPSERVER
+#include "metricsserver.h"
+#endif
 
 #ifdef Q_OS_ANDROID
 #include "keepawakehelper.h"
@@ -42,6 +50,10 @@
 #endif
 
 #include "osc.h"
+#include "devices/dircon/ftmsloadgenerator.h"
+#include "gymmanager.h"
+#include "qzmetrics.h"
+#include "sessionrecorder.h"
 
 #include "handleurl.h"
 
@@ -92,6 +104,11 @@ QString logfilename = QStringLiteral("debug-") +
                           .replace(QStringLiteral("."), QStringLiteral("_")) +
                       QStringLiteral(".log");
 QUrl profileToLoad;
+QString ftmsLoadTarget;
+int ftmsLoadClients = 4;
+double ftmsLoadRate = 20;
+int ftmsLoadSeconds = 30;
+bool ftmsLoadTreadmill = false;
 static const QtMessageHandler QT_DEFAULT_MESSAGE_HANDLER = qInstallMessageHandler(0);
 
 QCoreApplication *createApplication(int &argc, char *argv[]) {
@@ -207,12 +224,27 @@ QCoreApplication *createApplication(int &argc, char *argv[]) {
         if (!qstrcmp(argv[i], "-fit-file-saved-on-quit")) {
             fit_file_saved_on_quit = true;
         }
+        if (!qstrcmp(argv[i], "-ftms-load")) {
+            ftmsLoadTarget = argv[++i];
+            nogui = true;
+        }
+        if (!qstrcmp(argv[i], "-ftms-load-clients")) {
+            ftmsLoadClients = atoi(argv[++i]);
+        }
+        if (!qstrcmp(argv[i], "-ftms-load-rate")) {
+            ftmsLoadRate = atof(argv[++i]);
+        }
+        if (!qstrcmp(argv[i], "-ftms-load-seconds")) {
+            ftmsLoadSeconds = atoi(argv[++i]);
+        }
+        if (!qstrcmp(argv[i], "-ftms-load-treadmill"))
+            ftmsLoadTreadmill = true;
         if (!qstrcmp(argv[i], "-profile")) {
             QString profileName = argv[++i];
-            if (QFile::exists(homeform::getProfileDir() + "/" + profileName + ".qzs")) {
-                profileToLoad = QUrl::fromLocalFile(homeform::getProfileDir() + "/" + profileName + ".qzs");
+            if (QFile::exists(AppDirs::profiles() + "/" + profileName + ".qzs")) {
+                profileToLoad = QUrl::fromLocalFile(AppDirs::profiles() + "/" + profileName + ".qzs");
             } else {
-                qDebug() << homeform::getProfileDir() + "/" + profileName << "not found!";
+                qDebug() << AppDirs::profiles() + "/" + profileName << "not found!";
             }
         }
     }
@@ -296,7 +328,7 @@ void myMessageOutput(QtMsgType type, const QMessageLogContext &context, const QS
 
     if (logs == true || logdebug == true) {
 
-        QString path = homeform::getWritableAppDir();
+        QString path = AppDirs::writable();
 
         // Linux log files are generated on binary location
 
@@ -309,7 +341,43 @@ void myMessageOutput(QtMsgType type, const QMessageLogContext &context, const QS
     (*QT_DEFAULT_MESSAGE_HANDLER)(type, context, msg);
 }
 
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+static int quitSignalSockets[2];
+
+static void quitSignalHandler(int) {
+    char c = 1;
+    ssize_t written = ::write(quitSignalSockets[0], &c, sizeof(c));
+    Q_UNUSED(written)
+}
+
+// SIGINT and SIGTERM leave the event loop like a normal quit, so that the headless mode saves the session. The
+// handler only writes to a socket, the quit happens in the event loop
+static void quitOnSignals() {
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, quitSignalSockets))
+        return;
+    QSocketNotifier *notifier = new QSocketNotifier(quitSignalSockets[1], QSocketNotifier::Read, qApp);
+    QObject::connect(notifier, &QSocketNotifier::activated, qApp, [notifier]() {
+        notifier->setEnabled(false);
+        char c;
+        ssize_t got = ::read(quitSignalSockets[1], &c, sizeof(c));
+        Q_UNUSED(got)
+        qDebug() << "quit signal received";
+        QCoreApplication::quit();
+    });
+
+    struct sigaction action;
+    action.sa_handler = quitSignalHandler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+}
+#endif
+
 int main(int argc, char *argv[]) {
+    // the clock of the cold start metric
+    QZMetrics::monotonicNs();
+
 #ifdef Q_OS_WIN32
     qputenv("QT_MULTIMEDIA_PREFERRED_PLUGINS", "windowsmediafoundation");
 #endif
@@ -329,6 +397,22 @@ int main(int argc, char *argv[]) {
     QtWebView::initialize();
 #endif
 
+    // stress test of a DirCon server, of this app or of another one: only the report, no devices
+    if (!ftmsLoadTarget.isEmpty()) {
+        FtmsLoadGenerator::Config config;
+        config.rate = ftmsLoadRate;
+        config.treadmill = ftmsLoadTreadmill;
+        FtmsLoadGenerator generator(config);
+        QString host = ftmsLoadTarget.section(QLatin1Char(':'), 0, 0);
+        quint16 port = ftmsLoadTarget.section(QLatin1Char(':'), 1, 1).toUShort();
+        for (int i = 0; i < ftmsLoadClients; i++)
+            generator.addClient(
+                new DirconLoadTransport(host, port ? port : QZSettings::default_dircon_server_base_port));
+        FtmsLoadGenerator::Report report = generator.run(ftmsLoadSeconds * 1000);
+        printf("%s\n", report.toString().toLocal8Bit().constData());
+        return report.dropped || report.reordered || report.errors || report.failedClients ? 1 : 0;
+    }
+
 #ifdef Q_OS_LINUX
 #ifndef Q_OS_ANDROID
     if (getuid() && !testPeloton && !testHomeFitnessBudy && !testPowerZonePack) {
@@ -354,7 +438,7 @@ int main(int argc, char *argv[]) {
     lockscreen::nslog(QString("quick_action profile " + profileName).toLatin1());
 #endif
 #else
-    QAndroidJniObject javaPath = QAndroidJniObject::fromString(homeform::getWritableAppDir());
+    QAndroidJniObject javaPath = QAndroidJniObject::fromString(AppDirs::writable());
     QAndroidJniObject r = QAndroidJniObject::callStaticObjectMethod("org/cagnulen/qdomyoszwift/Shortcuts", "getProfileExtras",
                                                 "(Landroid/content/Context;)Ljava/lang/String;", QtAndroid::androidContext().object());
     profileName = r.toString();
@@ -364,10 +448,10 @@ int main(int argc, char *argv[]) {
     profileName = pp.baseName();
     
     if(profileName.count()) {
-        if (QFile::exists(homeform::getProfileDir() + "/" + profileName + ".qzs")) {
-            profileToLoad = QUrl::fromLocalFile(homeform::getProfileDir() + "/" + profileName + ".qzs");
+        if (QFile::exists(AppDirs::profiles() + "/" + profileName + ".qzs")) {
+            profileToLoad = QUrl::fromLocalFile(AppDirs::profiles() + "/" + profileName + ".qzs");
         } else {
-            qDebug() << homeform::getProfileDir() + "/" + profileName << "not found!";
+            qDebug() << AppDirs::profiles() + "/" + profileName << "not found!";
         }
     }
 #endif
@@ -453,7 +537,7 @@ int main(int argc, char *argv[]) {
         QDateTime d = QDateTime::currentDateTime();
         l.append(SessionLine(i%20,i%10,i,i%300,i%10,i%180,i%6,i%120,i,i, d));
     }
-    QString path = homeform::getWritableAppDir();
+    QString path = AppDirs::writable();
     qfit::save(path + QDateTime::currentDateTime().toString().replace(":", "_") + ".fit", l, bluetoothdevice::BIKE);
     return 0;
 #endif
@@ -608,6 +692,26 @@ int main(int argc, char *argv[]) {
         MQTTPublisher* mqtt = new MQTTPublisher(mqtt_host, mqtt_port, mqtt_username, mqtt_password, &bl);
     }
 
+    if (!settings.value(QZSettings::influxdb_url, QZSettings::default_influxdb_url).toString().isEmpty()) {
+        InfluxExporter *influx = new InfluxExporter(InfluxExporter::fromSettings(), &bl, &bl);
+        Q_UNUSED(influx);
+    }
+
+#ifdef Q_HTTPSERVER
+    if (settings.value(QZSettings::metrics_endpoint, QZSettings::default_metrics_endpoint).toBool()) {
+        MetricsServer *metricsServer = new MetricsServer(
+            settings.value(QZSettings::metrics_port, QZSettings::default_metrics_port).toUInt(), &bl);
+        Q_UNUSED(metricsServer);
+    }
+#endif
+
+    // gym mode: more trainers bridged by this process, next to the one of the bluetooth manager
+    QScopedPointer<GymManager> gym;
+    QString gym_stations = settings.value(QZSettings::gym_stations, QZSettings::default_gym_stations).toString();
+    if (!gym_stations.isEmpty()) {
+        gym.reset(new GymManager(GymManager::parseStations(gym_stations), bikeResistanceOffset, bikeResistanceGain));
+    }
+
     QString OSC_ip = settings.value(QZSettings::OSC_ip, QZSettings::default_OSC_ip).toString();
     if(OSC_ip.length() > 0) {
         OSC* osc = new OSC(&bl);
@@ -687,7 +791,15 @@ int main(int argc, char *argv[]) {
         }
         W->show();
     } else {
-        // start non-GUI version...
+        // start non-GUI version: the session is recorded and saved without homeform
+        SessionRecorder *recorder = new SessionRecorder(&bl, trainProgram, app.data());
+        QObject::connect(app.data(), &QCoreApplication::aboutToQuit, recorder, [recorder]() {
+            if (!recorder->session().isEmpty())
+                recorder->save();
+        });
+#ifdef Q_OS_LINUX
+        quitOnSignals();
+#endif
     }
 
 #ifdef Q_OS_LINUX
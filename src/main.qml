@@ -19,6 +19,7 @@ ApplicationWindow {
     title: qsTr("qDomyos-Zwift")
 
     signal gpx_open_clicked(url name)
+    signal ghost_open_clicked(url name)
     signal gpxpreview_open_clicked(url name)
     signal profile_open_clicked(url name)
     signal trainprogram_open_clicked(url name)
@@ -686,6 +687,15 @@ ApplicationWindow {
                         drawer.close()
                     }
                 }
+                ItemDelegate {
+                    id: ghost_open
+                    text: qsTr("👻 Race a Ghost (FIT)")
+                    width: parent.width
+                    onClicked: {
+                        fileDialogGhost.visible = true
+                        drawer.close()
+                    }
+                }
                 ItemDelegate {
                     id: trainprogram_open
                     text: qsTr("📈 Open Train Program")
@@ -758,6 +768,22 @@ ApplicationWindow {
                         drawer.close()
                     }
                 }
+                ItemDelegate {
+                    text: qsTr("Activity History")
+                    width: parent.width
+                    onClicked: {
+                        stackView.push("ActivityHistory.qml")
+                        drawer.close()
+                    }
+                }
+                ItemDelegate {
+                    text: qsTr("Latency Debug")
+                    width: parent.width
+                    onClicked: {
+                        stackView.push("LatencyDebug.qml")
+                        drawer.close()
+                    }
+                }
                 ItemDelegate {
                     text: qsTr("Credits")
                     width: parent.width
@@ -799,6 +825,22 @@ ApplicationWindow {
                     }
                 }
 
+                    FileDialog {
+                        id: fileDialogGhost
+                         title: "Please choose a FIT activity"
+                         folder: "file://" + rootItem.getWritableAppDir()
+                         nameFilters: ["FIT files (*.fit *.FIT)"]
+                         onAccepted: {
+                             console.log("You chose: " + fileDialogGhost.fileUrl)
+                              ghost_open_clicked(fileDialogGhost.fileUrl)
+                              fileDialogGhost.close()
+                            }
+                         onRejected: {
+                             console.log("Canceled")
+                              fileDialogGhost.close()
+                            }
+                        }
+
                     FileDialog {
                         id: fileDialogGPX
                          title: "Please choose a file"
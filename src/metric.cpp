@@ -1,6 +1,8 @@
 #include "metric.h"
 #include "qdebugfixup.h"
+#include "qzmetrics.h"
 #include "qzsettings.h"
+#include "speedpowermodel.h"
 #include <QSettings>
 
 #ifdef TEST
@@ -41,6 +43,34 @@ void metric::setValue(double v, bool applyGainAndOffset) {
     }
 
     QDateTime now = QDateTime::currentDateTime();
+
+    if (applyGainAndOffset && m_type != METRIC_OTHER && m_type != METRIC_ELAPSED) {
+        QString spec;
+        if (m_type == METRIC_WATT)
+            spec = settings.value(QZSettings::filter_chain_power, QZSettings::default_filter_chain_power).toString();
+        else if (m_type == METRIC_SPEED)
+            spec = settings.value(QZSettings::filter_chain_speed, QZSettings::default_filter_chain_speed).toString();
+        else if (m_type == METRIC_CADENCE)
+            spec =
+                settings.value(QZSettings::filter_chain_cadence, QZSettings::default_filter_chain_cadence).toString();
+        else if (m_type == METRIC_HEART)
+            spec = settings.value(QZSettings::filter_chain_heart, QZSettings::default_filter_chain_heart).toString();
+
+        if (spec != m_filterSpec) {
+            m_filterSpec = spec;
+            if (!m_filter.parse(spec))
+                qDebug() << QStringLiteral("invalid filter chain") << spec;
+        }
+
+        if (!m_filter.isEmpty()) {
+            // a stop is never smoothed away, and the next ride starts from a clean filter
+            if (v == 0 || v == INFINITY)
+                m_filter.reset();
+            else
+                v = m_filter.apply(v, qAbs(now.msecsTo(m_lastChanged)) / 1000.0);
+        }
+    }
+
     if (v != m_value && v != INFINITY) {
         m_valueChanged = now;
         if (m_last5.count() > 1) {
@@ -55,6 +85,7 @@ void metric::setValue(double v, bool applyGainAndOffset) {
 
     // it has to be here, even if the value is the same, due to https://github.com/cagnulein/qdomyos-zwift/issues/1325
     m_lastChanged = now;
+    m_ingressNs = QZMetrics::ingress();
 
     m_value = v;
 
@@ -213,57 +244,18 @@ void metric::clearLap(bool accumulator) {
 void metric::setLap(bool accumulator) { clearLap(accumulator); }
 
 double metric::calculateMaxSpeedFromPower(double power, double inclination) {
-    QSettings settings;
-    double rolling_resistance =
-        settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toFloat();
-    double twt = 9.8 * (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                        settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
-    double aero = 0.22691607640851885;
-    double hw = 0; // wind speed
-    double tr = twt * ((inclination / 100.0) + rolling_resistance);
-    double tran = 0.95;
-    double p = power;
-    double vel = 20;        // Initial guess
-    const uint8_t MAX = 10; // maximum iterations
-    double TOL = 0.05;      // tolerance
-    for (int i = 1; i < MAX; i++) {
-        double tv = vel + hw;
-        double aeroEff = (tv > 0.0) ? aero : -aero;           // wind in face, must reverse effect
-        double f = vel * (aeroEff * tv * tv + tr) - tran * p; // the function
-        double fp = aeroEff * (3.0 * vel + hw) * tv + tr;     // the derivative
-        double vNew = vel - f / fp;
-        if (qAbs(vNew - vel) < TOL) {
-            if (vNew < 0)
-                return 0;
-            else if (vNew > 19) // 19 m/s == 70 km/h
-                return 70;
-            return vNew * 3.6;
-        } // success
-        vel = vNew;
-    }
-    return 0.0; // failed to converge
+    return SpeedPowerModel::fromSettings().maxSpeed(power, inclination);
 }
 
 double metric::calculatePowerFromSpeed(double speed, double inclination) {
-    QSettings settings;
-    double rolling_resistance =
-        settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toFloat();
-    double v = speed / 3.6; // converted to m/s;
-    double tv = v + 0;
-    double tran = 0.95;
-    const double aero = 0.22691607640851885;
-    double A2Eff = (tv > 0.0) ? aero : -aero; // wind in face, must reverse effect
-    double twt = 9.8 * (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                        settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
-    double tr = twt * ((inclination / 100.0) + rolling_resistance);
-    return (v * tr + v * tv * tv * A2Eff) / tran;
+    return SpeedPowerModel::fromSettings().powerForSpeed(speed, inclination);
 }
 
 double metric::calculateSpeedFromPower(double power, double inclination, double speed, double deltaTimeSeconds,
                                        double speedLimit) {
-    QSettings settings;
-    double speed_gain = settings.value(QZSettings::speed_gain, QZSettings::default_speed_gain).toDouble();
-    double speed_offset = settings.value(QZSettings::speed_offset, QZSettings::default_speed_offset).toDouble();
+    const SpeedPowerModel &model = SpeedPowerModel::fromSettings();
+    double speed_gain = model.parameters().speedGain;
+    double speed_offset = model.parameters().speedOffset;
     if (inclination < -5)
         inclination = -5;
     if (speed_offset != QZSettings::default_speed_offset)
@@ -271,24 +263,7 @@ double metric::calculateSpeedFromPower(double power, double inclination, double
     if (speed_gain != QZSettings::default_speed_gain)
         speed /= speed_gain;
 
-    double fullWeight = (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                         settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
-    double maxSpeed = calculateMaxSpeedFromPower(power, inclination);
-    double maxPowerFromSpeed = calculatePowerFromSpeed(speed, inclination);
-    double acceleration = (power - maxPowerFromSpeed) / fullWeight;
-    double newSpeed = speed + (acceleration * 3.6 * deltaTimeSeconds);
-    if (speedLimit > 0 && newSpeed > speedLimit)
-        newSpeed = speedLimit;
-    if (speedLimit > 0 && maxSpeed > speedLimit)
-        maxSpeed = speedLimit;
-    if (newSpeed < 0)
-        newSpeed = 0;
-    if (maxSpeed > newSpeed)
-        return newSpeed;
-    else if (maxSpeed < speed)
-        return newSpeed;
-    else
-        return maxSpeed;
+    return model.nextSpeed(power, inclination, speed, deltaTimeSeconds, speedLimit);
 }
 
 double metric::calculateWeightLoss(double kcal) {
@@ -404,3 +379,17 @@ Women:
         return (T * ((0.6309 * H) + (0.1988 * W) + (0.2017 * A) - 55.0969) / 4.184);
     }
 }
+
+double metric::heartRateMax() {
+    QSettings settings;
+    double maxHeartRate = 220.0 - settings.value(QZSettings::age, QZSettings::default_age).toDouble();
+
+    if (settings.value(QZSettings::heart_max_override_enable, QZSettings::default_heart_max_override_enable).toBool())
+        maxHeartRate =
+            settings.value(QZSettings::heart_max_override_value, QZSettings::default_heart_max_override_value)
+                .toDouble();
+    if (maxHeartRate == 0) {
+        maxHeartRate = 190.0;
+    }
+    return maxHeartRate;
+}
@@ -3,6 +3,7 @@
 
 #include "qdebugfixup.h"
 #include "sessionline.h"
+#include "signalfilter.h"
 #include <QDateTime>
 #include <math.h>
 
@@ -15,6 +16,8 @@ class metric {
         METRIC_WATT = 1,
         METRIC_SPEED = 2,
         METRIC_ELAPSED = 3,
+        METRIC_CADENCE = 4,
+        METRIC_HEART = 5,
     } _metric_type;
 
     metric();
@@ -24,6 +27,9 @@ class metric {
     double valueRaw();
     QDateTime lastChanged() { return m_lastChanged; }
     QDateTime valueChanged() { return m_valueChanged; }
+
+    // monotonic stamp (QZMetrics::monotonicNs) of the BLE packet that produced the last value, 0 if unknown
+    qint64 ingressNs() { return m_ingressNs; }
     double average();
     double average5s();
     double average20s();
@@ -54,6 +60,11 @@ class metric {
     static double calculateKCalfromHR(double HR_AVG, double elapsed);
 
     static double powerPeak(QList<SessionLine> *session, int seconds);
+
+    /**
+     * @brief heartRateMax The max heart rate of the user: the override of the settings, or 220 - age.
+     */
+    static double heartRateMax();
     
   private:
     double m_value = 0;
@@ -74,9 +85,14 @@ class metric {
     QDateTime m_lastChanged = QDateTime::currentDateTime();
     QDateTime m_valueChanged = QDateTime::currentDateTime();
     double m_rateAtSec = 0;
+    qint64 m_ingressNs = 0;
 
     _metric_type m_type = METRIC_OTHER;
 
+    // filter_chain_* setting of this metric type, parsed again only when the setting changes
+    SignalFilterChain m_filter;
+    QString m_filterSpec;
+
     bool paused = false;
 };
 
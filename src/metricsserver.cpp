@@ -0,0 +1,21 @@
+#include "metricsserver.h"
+#include "qzmetrics.h"
+#include <QDebug>
+
+MetricsServer::MetricsServer(quint16 port, QObject *parent) : QObject(parent) {
+    httpServer = new QHttpServer(this);
+    httpServer->route(QStringLiteral("/metrics"), [](const QHttpServerRequest &request) {
+        Q_UNUSED(request);
+        return QHttpServerResponse("application/openmetrics-text; version=1.0.0; charset=utf-8", QZMetrics::scrape());
+    });
+
+    tcpServer = new QTcpServer(this);
+    if (tcpServer->listen(QHostAddress::Any, port)) {
+        httpServer->bind(tcpServer);
+        qDebug() << QStringLiteral("MetricsServer listening on port") << tcpServer->serverPort();
+    } else {
+        qDebug() << QStringLiteral("MetricsServer can't listen on port") << port << tcpServer->errorString();
+    }
+}
+
+bool MetricsServer::isRunning() const { return tcpServer && tcpServer->isListening(); }
@@ -0,0 +1,23 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <QHttpServer>
+#include <QObject>
+#include <QTcpServer>
+
+/**
+ * @brief Serves QZMetrics::scrape() on http://<host>:<metrics_port>/metrics.
+ * Only created when the metrics_endpoint setting is enabled.
+ */
+class MetricsServer : public QObject {
+    Q_OBJECT
+  public:
+    explicit MetricsServer(quint16 port, QObject *parent = nullptr);
+    bool isRunning() const;
+
+  private:
+    QHttpServer *httpServer = nullptr;
+    QTcpServer *tcpServer = nullptr;
+};
+
+#endif // METRICSSERVER_H
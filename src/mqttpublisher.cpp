@@ -1,19 +1,22 @@
 #include "mqttpublisher.h"
 #include "qzsettings.h"
 #include "homeform.h"
+#include "ghostrider.h"
 #include <QDebug>
+#include <cmath>
 
-MQTTPublisher::MQTTPublisher(const QString& host, quint16 port, QString username, QString password, bluetooth* manager, QObject *parent)
+MQTTPublisher::MQTTPublisher(const QString& host, quint16 port, QString username, QString password, bluetooth* manager, QString station, QObject *parent)
     : QObject(parent)
     , m_host(host)
     , m_port(port)
     , m_device(nullptr)
 {
-    m_client = new QMqttClient();
-    m_timer = new QTimer();
+    m_client = new QMqttClient(this);
+    m_timer = new QTimer(this);
     m_manager = manager;
     m_username = username;
     m_password = password;
+    m_station = station;
     m_userNickname = getUserNickname();
 
     // Setup timer for periodic publishing
@@ -66,11 +69,13 @@ QString MQTTPublisher::getUserNickname() const {
 }
 
 QString MQTTPublisher::getStatusTopic() const {
+    if (m_station.length())
+        return QString("QZ/%1/%2/").arg(m_userNickname, m_station);
     return QString("QZ/%1/").arg(m_userNickname);
 }
 
 QString MQTTPublisher::getBaseTopic() const {
-    return QString("QZ/%1/workout/").arg(m_userNickname);
+    return getStatusTopic() + QStringLiteral("workout/");
 }
 
 void MQTTPublisher::setupMQTTClient() {
@@ -277,6 +282,17 @@ void MQTTPublisher::publishWorkoutData() {
         publishToTopic("location/altitude", coord.altitude());
     }
 
+    // Ghost race
+    GhostRider::Gap ghostGap = GhostRider::instance()->gap(m_device);
+    if (ghostGap.valid) {
+        publishToTopic("ghost/name", GhostRider::instance()->name());
+        // unknown past the end of the ghost
+        if (!std::isnan(ghostGap.seconds))
+            publishToTopic("ghost/time_gap", ghostGap.seconds);
+        publishToTopic("ghost/distance_gap", ghostGap.meters);
+        publishToTopic("ghost/power_delta", ghostGap.watts);
+    }
+
     // Device Specific Metrics
     switch (m_device->deviceType()) {
         case bluetoothdevice::BIKE: {
@@ -20,7 +20,8 @@ class MQTTPublisher : public QObject {
     Q_OBJECT
 
 public:
-    explicit MQTTPublisher(const QString& host = "localhost", quint16 port = 1883, QString username = "", QString password = "", bluetooth* manager = nullptr, QObject *parent = nullptr);
+    // station: the gym station this publisher is for, its topics are under QZ/<deviceid>/<station>/
+    explicit MQTTPublisher(const QString& host = "localhost", quint16 port = 1883, QString username = "", QString password = "", bluetooth* manager = nullptr, QString station = "", QObject *parent = nullptr);
     ~MQTTPublisher();
 
     void start();
@@ -65,6 +66,7 @@ private:
     QString m_username;
     QString m_password;
     QString m_userNickname;
+    QString m_station;
     bluetoothdevice* m_device;
     bluetooth* m_manager;
 };
@@ -6,8 +6,8 @@ QT+= charts core-private
 qtHaveModule(httpserver) {
     QT += httpserver
     DEFINES += Q_HTTPSERVER
-    SOURCES += webserverinfosender.cpp
-    HEADERS += webserverinfosender.h
+    SOURCES += webserverinfosender.cpp metricsserver.cpp
+    HEADERS += webserverinfosender.h metricsserver.h
 
     # android and iOS are using ChartJS
     unix:android: {
@@ -108,6 +108,20 @@ SOURCES += \
     $$PWD/mqtt/qmqtttopicname.cpp \
     $$PWD/mqtt/qmqtttype.cpp \
     $$PWD/osc.cpp \
+    $$PWD/qzmetrics.cpp \
+    $$PWD/chartseriescache.cpp \
+    $$PWD/signalfilter.cpp \
+    $$PWD/speedpowermodel.cpp \
+    $$PWD/inclinationoverride.cpp \
+    $$PWD/gymmanager.cpp \
+    $$PWD/appdirs.cpp \
+    $$PWD/sessionrecorder.cpp \
+    $$PWD/influxexporter.cpp \
+    $$PWD/simergengine.cpp \
+    $$PWD/ghostrider.cpp \
+    $$PWD/activityhistory.cpp \
+    $$PWD/trainingload.cpp \
+    $$PWD/sensorfusion.cpp \
 QTelnet.cpp \
 devices/bkoolbike/bkoolbike.cpp \
 devices/csafe/csafe.cpp \
@@ -160,6 +174,7 @@ devices/proformellipticaltrainer/proformellipticaltrainer.cpp \
 devices/proformrower/proformrower.cpp \
 devices/proformwifibike/proformwifibike.cpp \
 devices/proformwifitreadmill/proformwifitreadmill.cpp \
+devices/proformwifitelemetry.cpp \
 qmdnsengine/src/src/abstractserver.cpp \
 qmdnsengine/src/src/bitmap.cpp \
 qmdnsengine/src/src/browser.cpp \
@@ -178,6 +193,9 @@ qmdnsengine/src/src/service.cpp \
 devices/activiotreadmill/activiotreadmill.cpp \
 devices/bhfitnesselliptical/bhfitnesselliptical.cpp \
 devices/bike.cpp \
+devices/blewritequeue.cpp \
+devices/pollscheduler.cpp \
+devices/ifitadbsession.cpp \
 devices/bluetooth.cpp \
 devices/bluetoothdevice.cpp \
 characteristics/characteristicnotifier2a37.cpp \
@@ -192,6 +210,7 @@ devices/cscbike/cscbike.cpp \
 devices/dircon/dirconmanager.cpp \
 devices/dircon/dirconpacket.cpp \
 devices/dircon/dirconprocessor.cpp \
+devices/dircon/ftmsloadgenerator.cpp \
 devices/domyoselliptical/domyoselliptical.cpp \
 devices/domyosrower/domyosrower.cpp \
 devices/domyostreadmill/domyostreadmill.cpp \
@@ -334,6 +353,22 @@ INCLUDEPATH += fit-sdk/ devices/
 
 HEADERS += \
     $$PWD/EventHandler.h \
+    $$PWD/qzmetrics.h \
+    $$PWD/chartseriescache.h \
+    $$PWD/snapshotchannel.h \
+    $$PWD/signalfilter.h \
+    $$PWD/speedpowermodel.h \
+    $$PWD/inclinationoverride.h \
+    $$PWD/settingscache.h \
+    $$PWD/gymmanager.h \
+    $$PWD/appdirs.h \
+    $$PWD/sessionrecorder.h \
+    $$PWD/influxexporter.h \
+    $$PWD/simergengine.h \
+    $$PWD/ghostrider.h \
+    $$PWD/activityhistory.h \
+    $$PWD/trainingload.h \
+    $$PWD/sensorfusion.h \
     $$PWD/devices/antbike/antbike.h \
     $$PWD/devices/crossrope/crossrope.h \
     $$PWD/devices/cycleopsphantombike/cycleopsphantombike.h \
@@ -441,6 +476,7 @@ devices/proformellipticaltrainer/proformellipticaltrainer.h \
 devices/proformrower/proformrower.h \
 devices/proformwifibike/proformwifibike.h \
 devices/proformwifitreadmill/proformwifitreadmill.h \
+devices/proformwifitelemetry.h \
 qmdnsengine/src/include/qmdnsengine/abstractserver.h \
 qmdnsengine/src/include/qmdnsengine/bitmap.h \
 qmdnsengine/src/include/qmdnsengine/browser.h \
@@ -471,8 +507,12 @@ qmdnsengine/src/src/service_p.h \
 devices/activiotreadmill/activiotreadmill.h \
 devices/bhfitnesselliptical/bhfitnesselliptical.h \
 devices/bike.h \
+devices/blewritequeue.h \
+devices/pollscheduler.h \
+devices/ifitadbsession.h \
 devices/bluetooth.h \
 devices/bluetoothdevice.h \
+characteristics/characteristicencoder.h \
 characteristics/characteristicnotifier.h \
 characteristics/characteristicnotifier2a37.h \
 characteristics/characteristicnotifier2a63.h \
@@ -487,6 +527,7 @@ devices/cscbike/cscbike.h \
 devices/dircon/dirconmanager.h \
 devices/dircon/dirconpacket.h \
 devices/dircon/dirconprocessor.h \
+devices/dircon/ftmsloadgenerator.h \
 devices/domyoselliptical/domyoselliptical.h \
 devices/domyosrower/domyosrower.h \
 devices/domyostreadmill/domyostreadmill.h \
@@ -6,6 +6,7 @@
 #include <QDir>
 
 #include "QSettings"
+#include "trainingload.h"
 
 #include "fit_date_time.hpp"
 #include "fit_encode.hpp"
@@ -13,6 +14,7 @@
 #include "fit_decode.hpp"
 #include "fit_developer_field_description.hpp"
 #include "fit_mesg_broadcaster.hpp"
+#include "fit_runtime_exception.hpp"
 
 #ifdef _WIN32
 #include <io.h>
@@ -99,7 +101,11 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
             break;
         }
     }
+    TrainingLoad load(TrainingLoad::Parameters::fromSettings());
+    bool heartData = false;
     for (int i = firstRealIndex; i < session.length(); i++) {
+        load.addSample(session.at(i).watt, session.at(i).heart);
+        heartData |= session.at(i).heart > 0;
         if (gps_data) {
             if (session.at(i).coordinate.isValid()) {
                 if (min_alt > session.at(i).coordinate.altitude())
@@ -135,6 +141,18 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
     sessionMesg.SetTotalMovingTime(session.last().elapsedTime);
     sessionMesg.SetMinAltitude(min_alt);
     sessionMesg.SetMaxAltitude(max_alt);
+    if (load.averagePower() > 0) {
+        sessionMesg.SetNormalizedPower(qRound(load.normalizedPower()));
+        sessionMesg.SetIntensityFactor(load.intensityFactor());
+        sessionMesg.SetTrainingStressScore(load.tss());
+        sessionMesg.SetThresholdPower(qRound(load.parameters().ftp));
+        for (int i = 0; i < TrainingLoad::powerZoneCount; i++)
+            sessionMesg.SetTimeInPowerZone(i, load.powerZoneSeconds(i));
+    }
+    if (heartData) {
+        for (int i = 0; i < TrainingLoad::heartZoneCount; i++)
+            sessionMesg.SetTimeInHrZone(i, load.heartZoneSeconds(i));
+    }
     sessionMesg.SetEvent(FIT_EVENT_SESSION);
     sessionMesg.SetEventType(FIT_EVENT_TYPE_STOP);
     sessionMesg.SetFirstLapIndex(0);
@@ -333,6 +351,11 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
             newRecord.SetVerticalOscillation(sl.verticalOscillationMM);
             newRecord.SetStanceTime(sl.groundContactMS);
         }
+        if (sl.pedalSmoothness > 0) {
+            newRecord.SetCombinedPedalSmoothness(sl.pedalSmoothness);
+            newRecord.SetLeftRightBalance(FIT_LEFT_RIGHT_BALANCE_RIGHT |
+                                          ((FIT_LEFT_RIGHT_BALANCE)qRound(sl.rightBalance) & FIT_LEFT_RIGHT_BALANCE_MASK));
+        }
 
         // if a gps track contains a point without the gps information, it has to be discarded, otherwise the database
         // structure is corrupted and 2 tracks are saved in the FIT file causing mapping issue.
@@ -408,6 +431,7 @@ class Listener : public fit::FileIdMesgListener,
                  public fit::RecordMesgListener {
   public:
     QList<SessionLine> *sessionOpening = nullptr;
+    const std::function<void(const SessionLine &)> *recordStream = nullptr;
 
     static void PrintValues(const fit::FieldBase &field) {
         for (FIT_UINT8 j = 0; j < (FIT_UINT8)field.GetNumValues(); j++) {
@@ -601,7 +625,7 @@ class Listener : public fit::FileIdMesgListener,
     }
 
     void OnMesg(fit::RecordMesg &record) override {
-        if (sessionOpening != nullptr) {
+        if (sessionOpening != nullptr || recordStream != nullptr) {
             SessionLine s;
             s.heart = record.GetHeartRate();
             s.cadence = record.GetCadence();
@@ -613,6 +637,10 @@ class Listener : public fit::FileIdMesgListener,
             s.instantaneousStrideLengthCM = record.GetStepLength() / 10;
             s.verticalOscillationMM = record.GetVerticalOscillation();
             s.groundContactMS = record.GetStanceTime();
+            if (record.IsCombinedPedalSmoothnessValid())
+                s.pedalSmoothness = record.GetCombinedPedalSmoothness();
+            if (record.IsLeftRightBalanceValid() && (record.GetLeftRightBalance() & FIT_LEFT_RIGHT_BALANCE_RIGHT))
+                s.rightBalance = record.GetLeftRightBalance() & FIT_LEFT_RIGHT_BALANCE_MASK;
             s.coordinate.setAltitude(record.GetAltitude());
             s.coordinate.setLatitude((record.GetPositionLat() * 180) / pow(2, 31));
             s.coordinate.setLongitude((record.GetPositionLong() * 180) / pow(2, 31));
@@ -620,7 +648,10 @@ class Listener : public fit::FileIdMesgListener,
                 s.elevationGain = record.GetAltitude();
             }
             s.time = QDateTime::fromSecsSinceEpoch(record.GetTimestamp());
-            sessionOpening->append(s);
+            if (sessionOpening != nullptr)
+                sessionOpening->append(s);
+            if (recordStream != nullptr)
+                (*recordStream)(s);
         }
     }
 
@@ -662,3 +693,34 @@ void qfit::open(const QString &filename, QList<SessionLine> *output) {
 
     file.close();
 }
+
+bool qfit::open(const QString &filename, const std::function<void(const SessionLine &)> &record) {
+    std::fstream file;
+#ifdef _WIN32
+    file.open(QString(filename).toLocal8Bit().constData(), std::ios::in | std::ios::binary);
+#else
+    file.open(filename.toStdString(), std::ios::in | std::ios::binary);
+#endif
+
+    if (!file.is_open()) {
+        qDebug() << "qfit: can't open" << filename << errno;
+        return false;
+    }
+
+    fit::Decode decode;
+    fit::MesgBroadcaster mesgBroadcaster;
+    Listener listener;
+    listener.recordStream = &record;
+    // only the records: the generic listener walks every field of every message
+    mesgBroadcaster.AddListener((fit::RecordMesgListener &)listener);
+    bool ok = true;
+    try {
+        decode.Read(&file, &mesgBroadcaster, &mesgBroadcaster, &listener);
+    } catch (const fit::RuntimeException &e) {
+        qDebug() << "qfit: error decoding" << filename << e.what();
+        ok = false;
+    }
+
+    file.close();
+    return ok;
+}
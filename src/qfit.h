@@ -8,6 +8,7 @@
 #include <QGeoCoordinate>
 #include <QObject>
 #include <QTime>
+#include <functional>
 
 #define QFIT_PROCESS_NONE 0
 #define QFIT_PROCESS_DISTANCENOISE 1
@@ -19,6 +20,11 @@ class qfit : public QObject {
     static void save(const QString &filename, QList<SessionLine> session, bluetoothdevice::BLUETOOTH_TYPE type,
                      uint32_t processFlag = QFIT_PROCESS_NONE, FIT_SPORT overrideSport = FIT_SPORT_INVALID, QString workoutName = "", QString bluetooth_device_name = "");
     static void open(const QString &filename, QList<SessionLine>* output);
+    /**
+     * @brief open Decodes only the records of a FIT file, handing them one at a time to record instead of
+     * keeping them. Returns false if the file can't be opened or isn't a valid FIT file.
+     */
+    static bool open(const QString &filename, const std::function<void(const SessionLine &)> &record);
     
   signals:
 };
@@ -0,0 +1,283 @@
+#include "qzmetrics.h"
+#include <QDebug>
+#include <QFile>
+#include <QString>
+#include <qmath.h>
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct MetricInfo {
+    const char *name;
+    const char *help;
+    bool labelled;
+};
+
+// same order as QZMetrics::Counter
+const MetricInfo counterInfo[QZMetrics::COUNTER_NUM] = {
+    {"qz_ble_notifications_received", "BLE notifications received from the machine and the sensors", true},
+    {"qz_ble_parse_errors", "BLE notifications discarded because they could not be decoded", true},
+    {"qz_ble_writes", "Writes sent to the machine", false},
+    {"qz_ble_write_timeouts", "Writes whose response did not arrive in time", false},
+    {"qz_ble_writes_coalesced", "Queued setpoint writes replaced by a newer one before being sent", false},
+    {"qz_device_reconnects", "Reconnections of the main bluetooth device", false},
+    {"qz_virtual_device_reconnects", "Reconnections of the virtual bluetooth device", false},
+    {"qz_virtual_device_notifications", "Notifications sent by the virtual bluetooth device", true},
+    {"qz_dircon_notifications", "Notifications sent to the DirCon clients", true},
+    {"qz_template_update_errors", "Template script evaluations that failed", false},
+    {"qz_influx_points_sent", "Points accepted by the InfluxDB server", false},
+    {"qz_influx_points_dropped", "Points dropped by the InfluxDB exporter: spool full or rejected by the server",
+     false},
+    {"qz_poll_wakeups", "Wakeups of the poll schedulers of the drivers", false},
+};
+
+// same order as QZMetrics::Gauge
+const MetricInfo gaugeInfo[QZMetrics::GAUGE_NUM] = {
+    {"qz_ble_write_queue_depth", "Writes to the machine waiting for completion", false},
+    {"qz_template_senders", "Loaded template senders", false},
+    {"qz_websocket_clients", "WebSocket clients connected to the template web server", false},
+    {"qz_session_samples", "Samples recorded in the current session", false},
+    {"qz_session_memory_bytes", "Memory used by the samples of the current session", false},
+    {"qz_cold_start_milliseconds", "Time from the start of the app to the first advertising of the virtual device",
+     false},
+    {"qz_resident_memory_bytes", "Resident memory of the process", false},
+    {"qz_influx_spool_bytes", "Points of the InfluxDB exporter waiting on disk to be sent", false},
+};
+
+// same order as QZMetrics::Histogram
+const MetricInfo histogramInfo[QZMetrics::HISTOGRAM_NUM] = {
+    {"qz_ble_write_latency_seconds", "Time from a write to the machine to its completion", false},
+    {"qz_homeform_update_jitter_seconds", "Deviation of homeform::update from its 1 s period", false},
+    {"qz_trainprogram_scheduler_jitter_seconds", "Deviation of trainprogram::scheduler from its 1 s period", false},
+    {"qz_notification_to_virtual_device_latency_seconds",
+     "Time from a BLE notification of the machine to the virtual device notification carrying its value", false},
+    {"qz_notification_to_dircon_latency_seconds",
+     "Time from a BLE notification of the machine to the DirCon notification carrying its value", false},
+    {"qz_control_point_to_device_write_latency_seconds",
+     "Time from an FTMS control point write of the app to the resulting write to the machine", false},
+    {"qz_ble_write_queue_wait_seconds", "Time a write to the machine waited in the write queue", false},
+    {"qz_template_update_seconds", "Time spent running the script of a template at an update", false},
+    {"qz_device_poll_seconds", "Time spent in a refresh of a driver", false},
+};
+
+const double bucketBounds[QZMetrics::bucketsNum] = {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+                                                    0.1,   0.25,   0.5,   1.0,  2.5,   5.0};
+
+thread_local qint64 currentIngressNs = 0;
+
+} // namespace
+
+QZMetrics::Slot QZMetrics::threadSlots[QZMetrics::maxSlots];
+std::atomic<int> QZMetrics::slotsUsed{0};
+std::atomic<quint32> QZMetrics::labels[QZMetrics::maxLabels];
+std::atomic<qint64> QZMetrics::gauges[QZMetrics::GAUGE_NUM];
+
+QZMetrics::Slot *QZMetrics::slot() {
+    // threads beyond maxSlots share the last slot: still correct, just no longer contention free
+    static thread_local Slot *mine = &threadSlots[qMin(slotsUsed.fetch_add(1, std::memory_order_relaxed), maxSlots - 1)];
+    return mine;
+}
+
+int QZMetrics::labelIndex(quint32 label) {
+    // index 0 holds the unlabelled value and every label that did not fit in the table
+    if (!label)
+        return 0;
+    for (int i = 1; i < maxLabels; i++) {
+        quint32 current = labels[i].load(std::memory_order_acquire);
+        if (current == label)
+            return i;
+        if (!current) {
+            quint32 expected = 0;
+            if (labels[i].compare_exchange_strong(expected, label, std::memory_order_acq_rel) || expected == label)
+                return i;
+        }
+    }
+    return 0;
+}
+
+void QZMetrics::increment(Counter counter, quint32 label, quint64 value) {
+    slot()->counters[counter][labelIndex(label)].fetch_add(value, std::memory_order_relaxed);
+}
+
+void QZMetrics::observe(Histogram histogram, double seconds) {
+    if (seconds < 0)
+        seconds = -seconds;
+    int bucket = 0;
+    while (bucket < bucketsNum && seconds > bucketBounds[bucket])
+        bucket++;
+    Slot *s = slot();
+    s->buckets[histogram][bucket].fetch_add(1, std::memory_order_relaxed);
+    s->sumMicros[histogram].fetch_add((quint64)(seconds * 1000000.0), std::memory_order_relaxed);
+}
+
+void QZMetrics::setGauge(Gauge gauge, qint64 value) { gauges[gauge].store(value, std::memory_order_relaxed); }
+
+void QZMetrics::addGauge(Gauge gauge, qint64 delta) { gauges[gauge].fetch_add(delta, std::memory_order_relaxed); }
+
+quint64 QZMetrics::counterValue(Counter counter, quint32 label) {
+    int index = labelIndex(label);
+    int used = qMin(slotsUsed.load(std::memory_order_relaxed), (int)maxSlots);
+    quint64 total = 0;
+    for (int s = 0; s < used; s++)
+        total += threadSlots[s].counters[counter][index].load(std::memory_order_relaxed);
+    return total;
+}
+
+qint64 QZMetrics::gaugeValue(Gauge gauge) { return gauges[gauge].load(std::memory_order_relaxed); }
+
+quint64 QZMetrics::histogramCount(Histogram histogram) {
+    int used = qMin(slotsUsed.load(std::memory_order_relaxed), (int)maxSlots);
+    quint64 total = 0;
+    for (int s = 0; s < used; s++)
+        for (int b = 0; b <= bucketsNum; b++)
+            total += threadSlots[s].buckets[histogram][b].load(std::memory_order_relaxed);
+    return total;
+}
+
+double QZMetrics::histogramQuantile(Histogram histogram, double q) {
+    int used = qMin(slotsUsed.load(std::memory_order_relaxed), (int)maxSlots);
+    quint64 counts[bucketsNum + 1] = {0};
+    quint64 total = 0;
+    for (int b = 0; b <= bucketsNum; b++) {
+        for (int s = 0; s < used; s++)
+            counts[b] += threadSlots[s].buckets[histogram][b].load(std::memory_order_relaxed);
+        total += counts[b];
+    }
+    if (!total)
+        return 0;
+    quint64 cumulative = 0;
+    for (int b = 0; b < bucketsNum; b++) {
+        cumulative += counts[b];
+        if (cumulative >= q * total)
+            return bucketBounds[b];
+    }
+    // beyond the last bound: report the last bound, the exposition has the exact +Inf count
+    return bucketBounds[bucketsNum - 1];
+}
+
+qint64 QZMetrics::monotonicNs() {
+    static const QElapsedTimer clock = [] {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return clock.nsecsElapsed() + 1;
+}
+
+void QZMetrics::setIngress(qint64 ns) { currentIngressNs = ns; }
+
+qint64 QZMetrics::ingress() { return currentIngressNs; }
+
+void QZMetrics::observeSince(Histogram histogram, qint64 stampNs) {
+    if (stampNs > 0)
+        observe(histogram, (monotonicNs() - stampNs) / 1000000000.0);
+}
+
+void QZMetrics::observeOnce(Histogram histogram, qint64 stampNs, qint64 &lastStampNs) {
+    if (stampNs <= lastStampNs)
+        return;
+    lastStampNs = stampNs;
+    observeSince(histogram, stampNs);
+}
+
+void QZMetrics::virtualDeviceAdvertising() {
+    qint64 expected = 0;
+    qint64 ms = monotonicNs() / 1000000 + 1;
+    if (gauges[ColdStartMs].compare_exchange_strong(expected, ms, std::memory_order_relaxed)) {
+        setGauge(ResidentMemoryBytes, residentMemoryBytes());
+        qDebug() << "cold start: virtual device advertising after" << ms << "ms, resident memory"
+                 << gaugeValue(ResidentMemoryBytes) / 1024 << "KiB";
+    }
+}
+
+qint64 QZMetrics::residentMemoryBytes() {
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+    // second field of statm: resident pages
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return 0;
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return 0;
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+QString QZMetrics::latencyReport() {
+    const Histogram paths[] = {NotificationToVirtualDeviceLatency, NotificationToDirconLatency,
+                               ControlPointToDeviceWriteLatency, BleWriteQueueWait, BleWriteLatency};
+    QString report;
+    for (Histogram h : paths) {
+        report += QStringLiteral("%1: n=%2 p50<=%3ms p95<=%4ms p99<=%5ms\n")
+                      .arg(QString::fromLatin1(histogramInfo[h].name))
+                      .arg(histogramCount(h))
+                      .arg(histogramQuantile(h, 0.50) * 1000.0)
+                      .arg(histogramQuantile(h, 0.95) * 1000.0)
+                      .arg(histogramQuantile(h, 0.99) * 1000.0);
+    }
+    return report;
+}
+
+QByteArray QZMetrics::scrape() {
+    QByteArray out;
+    out.reserve(8192);
+    int used = qMin(slotsUsed.load(std::memory_order_relaxed), (int)maxSlots);
+
+    for (int c = 0; c < COUNTER_NUM; c++) {
+        const MetricInfo &info = counterInfo[c];
+        out += QByteArray("# TYPE ") + info.name + " counter\n";
+        out += QByteArray("# HELP ") + info.name + " " + info.help + "\n";
+        for (int l = 0; l < (info.labelled ? (int)maxLabels : 1); l++) {
+            quint64 total = 0;
+            for (int s = 0; s < used; s++)
+                total += threadSlots[s].counters[c][l].load(std::memory_order_relaxed);
+            if (!info.labelled) {
+                out += QByteArray(info.name) + "_total " + QByteArray::number(total) + "\n";
+            } else if (total) {
+                quint32 label = l ? labels[l].load(std::memory_order_acquire) : 0;
+                QByteArray labelText = l ? QByteArray::number(label, 16) : QByteArray("other");
+                out += QByteArray(info.name) + "_total{characteristic=\"" + labelText + "\"} " +
+                       QByteArray::number(total) + "\n";
+            }
+        }
+    }
+
+    for (int g = 0; g < GAUGE_NUM; g++) {
+        const MetricInfo &info = gaugeInfo[g];
+        out += QByteArray("# TYPE ") + info.name + " gauge\n";
+        out += QByteArray("# HELP ") + info.name + " " + info.help + "\n";
+        out += QByteArray(info.name) + " " + QByteArray::number(gauges[g].load(std::memory_order_relaxed)) + "\n";
+    }
+
+    for (int h = 0; h < HISTOGRAM_NUM; h++) {
+        const MetricInfo &info = histogramInfo[h];
+        out += QByteArray("# TYPE ") + info.name + " histogram\n";
+        out += QByteArray("# HELP ") + info.name + " " + info.help + "\n";
+        quint64 cumulative = 0;
+        quint64 sumMicros = 0;
+        for (int s = 0; s < used; s++)
+            sumMicros += threadSlots[s].sumMicros[h].load(std::memory_order_relaxed);
+        for (int b = 0; b <= bucketsNum; b++) {
+            for (int s = 0; s < used; s++)
+                cumulative += threadSlots[s].buckets[h][b].load(std::memory_order_relaxed);
+            QByteArray le = b < bucketsNum ? QByteArray::number(bucketBounds[b]) : QByteArray("+Inf");
+            out += QByteArray(info.name) + "_bucket{le=\"" + le + "\"} " + QByteArray::number(cumulative) + "\n";
+        }
+        out += QByteArray(info.name) + "_sum " + QByteArray::number(sumMicros / 1000000.0, 'f', 6) + "\n";
+        out += QByteArray(info.name) + "_count " + QByteArray::number(cumulative) + "\n";
+    }
+
+    out += "# EOF\n";
+    return out;
+}
+
+void QZMetrics::TimerProbe::tick(Histogram histogram) {
+    if (last.isValid())
+        QZMetrics::observe(histogram, (last.restart() - intervalMs) / 1000.0);
+    else
+        last.start();
+}
@@ -0,0 +1,179 @@
+#ifndef QZMETRICS_H
+#define QZMETRICS_H
+
+#include <QByteArray>
+#include <QString>
+#include <QElapsedTimer>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief Process wide counters, gauges and histograms describing the internal pipeline
+ * (BLE ingress, writes, virtual devices, timers, templates), rendered in the OpenMetrics
+ * text format by scrape().
+ *
+ * Counters and histograms are kept in per-thread slots: every thread increments its own
+ * relaxed atomics, so the hot paths never contend with each other or with a scrape, and
+ * scrape() sums the slots. Gauges are single atomics because they are set, not accumulated.
+ */
+class QZMetrics {
+  public:
+    enum Counter {
+        BleNotificationsReceived = 0,
+        BleParseErrors,
+        BleWrites,
+        BleWriteTimeouts,
+        BleWritesCoalesced,
+        DeviceReconnects,
+        VirtualDeviceReconnects,
+        VirtualDeviceNotifications,
+        DirconNotifications,
+        TemplateUpdateErrors,
+        InfluxPointsSent,
+        InfluxPointsDropped,
+        PollWakeups,
+        COUNTER_NUM
+    };
+
+    enum Gauge {
+        BleWriteQueueDepth = 0,
+        TemplateSenders,
+        WebSocketClients,
+        SessionSamples,
+        SessionMemoryBytes,
+        ColdStartMs,
+        ResidentMemoryBytes,
+        InfluxSpoolBytes,
+        GAUGE_NUM
+    };
+
+    enum Histogram {
+        BleWriteLatency = 0,
+        HomeformUpdateJitter,
+        TrainProgramSchedulerJitter,
+        NotificationToVirtualDeviceLatency,
+        NotificationToDirconLatency,
+        ControlPointToDeviceWriteLatency,
+        BleWriteQueueWait,
+        TemplateUpdateDuration,
+        DevicePollDuration,
+        HISTOGRAM_NUM
+    };
+
+    /**
+     * @brief Measures how late a periodic timer fires compared to its nominal interval.
+     */
+    class TimerProbe {
+      public:
+        explicit TimerProbe(int intervalMs) : intervalMs(intervalMs) {}
+        void tick(Histogram histogram);
+
+      private:
+        QElapsedTimer last;
+        int intervalMs;
+    };
+
+    /**
+     * @brief increment Adds value to a counter. label is a 32-bit characteristic identifier
+     * (QBluetoothUuid::data1) for the per-characteristic counters, 0 otherwise.
+     */
+    static void increment(Counter counter, quint32 label = 0, quint64 value = 1);
+    static void observe(Histogram histogram, double seconds);
+    static void setGauge(Gauge gauge, qint64 value);
+    static void addGauge(Gauge gauge, qint64 delta);
+
+    static quint64 counterValue(Counter counter, quint32 label = 0);
+    static qint64 gaugeValue(Gauge gauge);
+    static quint64 histogramCount(Histogram histogram);
+
+    /**
+     * @brief histogramQuantile Upper bound, in seconds, of the bucket holding the q quantile (0..1).
+     */
+    static double histogramQuantile(Histogram histogram, double q);
+
+    /**
+     * @brief monotonicNs Monotonic clock in nanoseconds used to stamp packets, never 0 so that 0 can mean "no stamp".
+     */
+    static qint64 monotonicNs();
+
+    /**
+     * @brief setIngress Stamps the packet the calling thread is processing: every metric set while
+     * handling it remembers the stamp, so the latency can be measured where the value leaves the app.
+     */
+    static void setIngress(qint64 ns);
+    static qint64 ingress();
+
+    /**
+     * @brief The IngressScope class stamps the packet handled in its scope and puts the previous stamp back at the
+     * end of it, so the values set later by timers or by the UI on the same thread don't take a stale stamp.
+     */
+    class IngressScope {
+      public:
+        explicit IngressScope(qint64 ns) : previous(ingress()) { setIngress(ns); }
+        IngressScope(IngressScope &&other) : previous(other.previous), active(other.active) { other.active = false; }
+        ~IngressScope() {
+            if (active)
+                setIngress(previous);
+        }
+
+      private:
+        IngressScope(const IngressScope &) = delete;
+        IngressScope &operator=(const IngressScope &) = delete;
+
+        qint64 previous;
+        bool active = true;
+    };
+
+    /**
+     * @brief observeSince Observes the time elapsed since a monotonicNs() stamp; 0 stamps are ignored.
+     */
+    static void observeSince(Histogram histogram, qint64 stampNs);
+
+    /**
+     * @brief observeOnce Observes a stamp only the first time it goes out: lastStampNs is the newest stamp the caller
+     * observed, the ticks sending the values of the same packet again are not measured again.
+     */
+    static void observeOnce(Histogram histogram, qint64 stampNs, qint64 &lastStampNs);
+
+    /**
+     * @brief virtualDeviceAdvertising Called when a virtual device starts advertising: the first call sets
+     * ColdStartMs, the time since the app called monotonicNs() first, at the start of main().
+     */
+    static void virtualDeviceAdvertising();
+
+    /**
+     * @brief residentMemoryBytes Resident memory of the process, 0 where it can't be read.
+     */
+    static qint64 residentMemoryBytes();
+
+    /**
+     * @brief latencyReport One line per latency path with count and quantiles, for the logs and the debug page.
+     */
+    static QString latencyReport();
+
+    /**
+     * @brief scrape Renders every metric in the OpenMetrics text exposition format.
+     */
+    static QByteArray scrape();
+
+    static const int maxLabels = 32;
+    static const int maxSlots = 16;
+    static const int bucketsNum = 12;
+
+  private:
+    struct Slot {
+        std::atomic<quint64> counters[COUNTER_NUM][maxLabels];
+        std::atomic<quint64> buckets[HISTOGRAM_NUM][bucketsNum + 1];
+        std::atomic<quint64> sumMicros[HISTOGRAM_NUM];
+    };
+
+    static Slot *slot();
+    static int labelIndex(quint32 label);
+
+    static Slot threadSlots[maxSlots];
+    static std::atomic<int> slotsUsed;
+    static std::atomic<quint32> labels[maxLabels];
+    static std::atomic<qint64> gauges[GAUGE_NUM];
+};
+
+#endif // QZMETRICS_H
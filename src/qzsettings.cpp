@@ -875,7 +875,113 @@ const QString QZSettings::proform_bike_PFEVEX71316_0 = QStringLiteral("proform_b
 
 const QString QZSettings::real_inclination_to_virtual_treamill_bridge = QStringLiteral("real_inclination_to_virtual_treamill_bridge");
 
-const uint32_t allSettingsCount = 725;
+const QString QZSettings::metrics_endpoint = QStringLiteral("metrics_endpoint");
+
+const QString QZSettings::metrics_port = QStringLiteral("metrics_port");
+
+const QString QZSettings::tile_pedal_stroke_enabled = QStringLiteral("tile_pedal_stroke_enabled");
+
+const QString QZSettings::tile_pedal_stroke_order = QStringLiteral("tile_pedal_stroke_order");
+
+const QString QZSettings::filter_chain_speed = QStringLiteral("filter_chain_speed");
+const QString QZSettings::default_filter_chain_speed = QStringLiteral("");
+
+const QString QZSettings::filter_chain_power = QStringLiteral("filter_chain_power");
+const QString QZSettings::default_filter_chain_power = QStringLiteral("");
+
+const QString QZSettings::filter_chain_cadence = QStringLiteral("filter_chain_cadence");
+const QString QZSettings::default_filter_chain_cadence = QStringLiteral("");
+
+const QString QZSettings::filter_chain_heart = QStringLiteral("filter_chain_heart");
+const QString QZSettings::default_filter_chain_heart = QStringLiteral("");
+
+const QString QZSettings::virtual_speed_wind = QStringLiteral("virtual_speed_wind");
+
+const QString QZSettings::virtual_speed_drafting = QStringLiteral("virtual_speed_drafting");
+
+const QString QZSettings::gym_stations = QStringLiteral("gym_stations");
+const QString QZSettings::default_gym_stations = QStringLiteral("");
+
+const QString QZSettings::influxdb_url = QStringLiteral("influxdb_url");
+const QString QZSettings::default_influxdb_url = QStringLiteral("");
+
+const QString QZSettings::influxdb_token = QStringLiteral("influxdb_token");
+const QString QZSettings::default_influxdb_token = QStringLiteral("");
+
+const QString QZSettings::influxdb_measurement = QStringLiteral("influxdb_measurement");
+const QString QZSettings::default_influxdb_measurement = QStringLiteral("workout");
+
+const QString QZSettings::influxdb_batch_points = QStringLiteral("influxdb_batch_points");
+
+const QString QZSettings::influxdb_batch_ms = QStringLiteral("influxdb_batch_ms");
+
+const QString QZSettings::influxdb_gzip = QStringLiteral("influxdb_gzip");
+
+const QString QZSettings::influxdb_spool_kb = QStringLiteral("influxdb_spool_kb");
+
+const QString QZSettings::zwift_sim_erg = QStringLiteral("zwift_sim_erg");
+
+const QString QZSettings::zwift_sim_erg_smoothing = QStringLiteral("zwift_sim_erg_smoothing");
+
+const QString QZSettings::tile_ghost_time_enabled = QStringLiteral("tile_ghost_time_enabled");
+
+const QString QZSettings::tile_ghost_time_order = QStringLiteral("tile_ghost_time_order");
+
+const QString QZSettings::tile_ghost_distance_enabled = QStringLiteral("tile_ghost_distance_enabled");
+
+const QString QZSettings::tile_ghost_distance_order = QStringLiteral("tile_ghost_distance_order");
+
+const QString QZSettings::tile_ghost_power_enabled = QStringLiteral("tile_ghost_power_enabled");
+
+const QString QZSettings::tile_ghost_power_order = QStringLiteral("tile_ghost_power_order");
+
+const QString QZSettings::critical_power = QStringLiteral("critical_power");
+
+const QString QZSettings::w_prime = QStringLiteral("w_prime");
+
+const QString QZSettings::tile_normalized_power_enabled = QStringLiteral("tile_normalized_power_enabled");
+
+const QString QZSettings::tile_normalized_power_order = QStringLiteral("tile_normalized_power_order");
+
+const QString QZSettings::tile_tss_enabled = QStringLiteral("tile_tss_enabled");
+
+const QString QZSettings::tile_tss_order = QStringLiteral("tile_tss_order");
+
+const QString QZSettings::tile_wbal_enabled = QStringLiteral("tile_wbal_enabled");
+
+const QString QZSettings::tile_wbal_order = QStringLiteral("tile_wbal_order");
+
+const QString QZSettings::tile_power_zone_time_enabled = QStringLiteral("tile_power_zone_time_enabled");
+
+const QString QZSettings::tile_power_zone_time_order = QStringLiteral("tile_power_zone_time_order");
+
+const QString QZSettings::sensor_fusion_heart_rule = QStringLiteral("sensor_fusion_heart_rule");
+
+const QString QZSettings::sensor_fusion_power_rule = QStringLiteral("sensor_fusion_power_rule");
+
+const QString QZSettings::sensor_fusion_cadence_rule = QStringLiteral("sensor_fusion_cadence_rule");
+
+const QString QZSettings::sensor_fusion_speed_rule = QStringLiteral("sensor_fusion_speed_rule");
+
+const QString QZSettings::sensor_fusion_heart_priority = QStringLiteral("sensor_fusion_heart_priority");
+const QString QZSettings::default_sensor_fusion_heart_priority = QStringLiteral("hrm,watch,stryd");
+
+const QString QZSettings::sensor_fusion_power_priority = QStringLiteral("sensor_fusion_power_priority");
+const QString QZSettings::default_sensor_fusion_power_priority = QStringLiteral("power,stryd");
+
+const QString QZSettings::sensor_fusion_cadence_priority = QStringLiteral("sensor_fusion_cadence_priority");
+const QString QZSettings::default_sensor_fusion_cadence_priority = QStringLiteral("csc,stryd");
+
+const QString QZSettings::sensor_fusion_speed_priority = QStringLiteral("sensor_fusion_speed_priority");
+const QString QZSettings::default_sensor_fusion_speed_priority = QStringLiteral("stryd");
+
+const QString QZSettings::sensor_fusion_stale_ms = QStringLiteral("sensor_fusion_stale_ms");
+
+const QString QZSettings::sensor_fusion_cadence_window_ms = QStringLiteral("sensor_fusion_cadence_window_ms");
+
+const QString QZSettings::template_interval_suffix = QStringLiteral("_interval");
+
+const uint32_t allSettingsCount = 771;
 
 QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::cryptoKeySettingsProfiles, QZSettings::default_cryptoKeySettingsProfiles},
@@ -1615,6 +1721,52 @@ QVariant allSettings[allSettingsCount][2] = {
 
     {QZSettings::proform_bike_PFEVEX71316_0, QZSettings::default_proform_bike_PFEVEX71316_0},
     {QZSettings::real_inclination_to_virtual_treamill_bridge, QZSettings::default_real_inclination_to_virtual_treamill_bridge},
+    {QZSettings::metrics_endpoint, QZSettings::default_metrics_endpoint},
+    {QZSettings::metrics_port, QZSettings::default_metrics_port},
+    {QZSettings::tile_pedal_stroke_enabled, QZSettings::default_tile_pedal_stroke_enabled},
+    {QZSettings::tile_pedal_stroke_order, QZSettings::default_tile_pedal_stroke_order},
+    {QZSettings::filter_chain_speed, QZSettings::default_filter_chain_speed},
+    {QZSettings::filter_chain_power, QZSettings::default_filter_chain_power},
+    {QZSettings::filter_chain_cadence, QZSettings::default_filter_chain_cadence},
+    {QZSettings::filter_chain_heart, QZSettings::default_filter_chain_heart},
+    {QZSettings::virtual_speed_wind, QZSettings::default_virtual_speed_wind},
+    {QZSettings::virtual_speed_drafting, QZSettings::default_virtual_speed_drafting},
+    {QZSettings::gym_stations, QZSettings::default_gym_stations},
+    {QZSettings::influxdb_url, QZSettings::default_influxdb_url},
+    {QZSettings::influxdb_token, QZSettings::default_influxdb_token},
+    {QZSettings::influxdb_measurement, QZSettings::default_influxdb_measurement},
+    {QZSettings::influxdb_batch_points, QZSettings::default_influxdb_batch_points},
+    {QZSettings::influxdb_batch_ms, QZSettings::default_influxdb_batch_ms},
+    {QZSettings::influxdb_gzip, QZSettings::default_influxdb_gzip},
+    {QZSettings::influxdb_spool_kb, QZSettings::default_influxdb_spool_kb},
+    {QZSettings::zwift_sim_erg, QZSettings::default_zwift_sim_erg},
+    {QZSettings::zwift_sim_erg_smoothing, QZSettings::default_zwift_sim_erg_smoothing},
+    {QZSettings::tile_ghost_time_enabled, QZSettings::default_tile_ghost_time_enabled},
+    {QZSettings::tile_ghost_time_order, QZSettings::default_tile_ghost_time_order},
+    {QZSettings::tile_ghost_distance_enabled, QZSettings::default_tile_ghost_distance_enabled},
+    {QZSettings::tile_ghost_distance_order, QZSettings::default_tile_ghost_distance_order},
+    {QZSettings::tile_ghost_power_enabled, QZSettings::default_tile_ghost_power_enabled},
+    {QZSettings::tile_ghost_power_order, QZSettings::default_tile_ghost_power_order},
+    {QZSettings::critical_power, QZSettings::default_critical_power},
+    {QZSettings::w_prime, QZSettings::default_w_prime},
+    {QZSettings::tile_normalized_power_enabled, QZSettings::default_tile_normalized_power_enabled},
+    {QZSettings::tile_normalized_power_order, QZSettings::default_tile_normalized_power_order},
+    {QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled},
+    {QZSettings::tile_tss_order, QZSettings::default_tile_tss_order},
+    {QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled},
+    {QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order},
+    {QZSettings::tile_power_zone_time_enabled, QZSettings::default_tile_power_zone_time_enabled},
+    {QZSettings::tile_power_zone_time_order, QZSettings::default_tile_power_zone_time_order},
+    {QZSettings::sensor_fusion_heart_rule, QZSettings::default_sensor_fusion_heart_rule},
+    {QZSettings::sensor_fusion_power_rule, QZSettings::default_sensor_fusion_power_rule},
+    {QZSettings::sensor_fusion_cadence_rule, QZSettings::default_sensor_fusion_cadence_rule},
+    {QZSettings::sensor_fusion_speed_rule, QZSettings::default_sensor_fusion_speed_rule},
+    {QZSettings::sensor_fusion_heart_priority, QZSettings::default_sensor_fusion_heart_priority},
+    {QZSettings::sensor_fusion_power_priority, QZSettings::default_sensor_fusion_power_priority},
+    {QZSettings::sensor_fusion_cadence_priority, QZSettings::default_sensor_fusion_cadence_priority},
+    {QZSettings::sensor_fusion_speed_priority, QZSettings::default_sensor_fusion_speed_priority},
+    {QZSettings::sensor_fusion_stale_ms, QZSettings::default_sensor_fusion_stale_ms},
+    {QZSettings::sensor_fusion_cadence_window_ms, QZSettings::default_sensor_fusion_cadence_window_ms},
 };
 
 void QZSettings::qDebugAllSettings(bool showDefaults) {
@@ -2375,6 +2375,163 @@ class QZSettings {
     static const QString real_inclination_to_virtual_treamill_bridge;
     static constexpr bool default_real_inclination_to_virtual_treamill_bridge = false;
 
+    static const QString metrics_endpoint;
+    static constexpr bool default_metrics_endpoint = false;
+
+    static const QString metrics_port;
+    static constexpr int default_metrics_port = 9180;
+
+    static const QString tile_pedal_stroke_enabled;
+    static constexpr bool default_tile_pedal_stroke_enabled = false;
+
+    static const QString tile_pedal_stroke_order;
+    static constexpr int default_tile_pedal_stroke_order = 62;
+
+    /**
+     * @brief Signal filter chains applied to the raw values, e.g. "outlier:4;median:3;kalman:1,0.01,0.75".
+     * Empty means no filter. See SignalFilterChain.
+     */
+    static const QString filter_chain_speed;
+    static const QString default_filter_chain_speed;
+
+    static const QString filter_chain_power;
+    static const QString default_filter_chain_power;
+
+    static const QString filter_chain_cadence;
+    static const QString default_filter_chain_cadence;
+
+    static const QString filter_chain_heart;
+    static const QString default_filter_chain_heart;
+
+    /**
+     * @brief Head wind, in km/h (negative for tail wind), of the speed computed from the power.
+     */
+    static const QString virtual_speed_wind;
+    static constexpr double default_virtual_speed_wind = 0.0;
+
+    /**
+     * @brief Aerodynamic drag saved by drafting, in percent, of the speed computed from the power.
+     */
+    static const QString virtual_speed_drafting;
+    static constexpr double default_virtual_speed_drafting = 0.0;
+
+    /**
+     * @brief Stations of the gym mode, as name=type[@address][,workout file] separated by ';'. Empty disables it.
+     */
+    static const QString gym_stations;
+    static const QString default_gym_stations;
+
+    static const QString influxdb_url;
+    static const QString default_influxdb_url;
+
+    static const QString influxdb_token;
+    static const QString default_influxdb_token;
+
+    static const QString influxdb_measurement;
+    static const QString default_influxdb_measurement;
+
+    static const QString influxdb_batch_points;
+    static constexpr int default_influxdb_batch_points = 10;
+
+    static const QString influxdb_batch_ms;
+    static constexpr int default_influxdb_batch_ms = 5000;
+
+    static const QString influxdb_gzip;
+    static constexpr bool default_influxdb_gzip = true;
+
+    static const QString influxdb_spool_kb;
+    static constexpr int default_influxdb_spool_kb = 10240;
+
+    static const QString zwift_sim_erg;
+    static constexpr bool default_zwift_sim_erg = false;
+
+    static const QString zwift_sim_erg_smoothing;
+    static constexpr double default_zwift_sim_erg_smoothing = 2.0;
+
+    static const QString tile_ghost_time_enabled;
+    static constexpr bool default_tile_ghost_time_enabled = false;
+
+    static const QString tile_ghost_time_order;
+    static constexpr int default_tile_ghost_time_order = 63;
+
+    static const QString tile_ghost_distance_enabled;
+    static constexpr bool default_tile_ghost_distance_enabled = false;
+
+    static const QString tile_ghost_distance_order;
+    static constexpr int default_tile_ghost_distance_order = 64;
+
+    static const QString tile_ghost_power_enabled;
+    static constexpr bool default_tile_ghost_power_enabled = false;
+
+    static const QString tile_ghost_power_order;
+    static constexpr int default_tile_ghost_power_order = 65;
+
+    static const QString critical_power;
+    static constexpr int default_critical_power = 0;
+
+    static const QString w_prime;
+    static constexpr int default_w_prime = 20000;
+
+    static const QString tile_normalized_power_enabled;
+    static constexpr bool default_tile_normalized_power_enabled = false;
+
+    static const QString tile_normalized_power_order;
+    static constexpr int default_tile_normalized_power_order = 66;
+
+    static const QString tile_tss_enabled;
+    static constexpr bool default_tile_tss_enabled = false;
+
+    static const QString tile_tss_order;
+    static constexpr int default_tile_tss_order = 67;
+
+    static const QString tile_wbal_enabled;
+    static constexpr bool default_tile_wbal_enabled = false;
+
+    static const QString tile_wbal_order;
+    static constexpr int default_tile_wbal_order = 68;
+
+    static const QString tile_power_zone_time_enabled;
+    static constexpr bool default_tile_power_zone_time_enabled = false;
+
+    static const QString tile_power_zone_time_order;
+    static constexpr int default_tile_power_zone_time_order = 69;
+
+    static const QString sensor_fusion_heart_rule;
+    static constexpr int default_sensor_fusion_heart_rule = 0;
+
+    static const QString sensor_fusion_power_rule;
+    static constexpr int default_sensor_fusion_power_rule = 0;
+
+    static const QString sensor_fusion_cadence_rule;
+    static constexpr int default_sensor_fusion_cadence_rule = 0;
+
+    static const QString sensor_fusion_speed_rule;
+    static constexpr int default_sensor_fusion_speed_rule = 0;
+
+    static const QString sensor_fusion_heart_priority;
+    static const QString default_sensor_fusion_heart_priority;
+
+    static const QString sensor_fusion_power_priority;
+    static const QString default_sensor_fusion_power_priority;
+
+    static const QString sensor_fusion_cadence_priority;
+    static const QString default_sensor_fusion_cadence_priority;
+
+    static const QString sensor_fusion_speed_priority;
+    static const QString default_sensor_fusion_speed_priority;
+
+    static const QString sensor_fusion_stale_ms;
+    static constexpr int default_sensor_fusion_stale_ms = 3000;
+
+    static const QString sensor_fusion_cadence_window_ms;
+    static constexpr int default_sensor_fusion_cadence_window_ms = 2000;
+
+    /**
+     * @brief Suffix of the update interval of a template, in ms: the key is template_<id>_interval.
+     */
+    static const QString template_interval_suffix;
+    static constexpr int default_template_interval = 1000;
+
     /**
      * @brief Write the QSettings values using the constants from this namespace.
      * @param showDefaults Optionally indicates if the default should be shown with the key.
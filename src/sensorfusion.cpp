@@ -0,0 +1,309 @@
+#include "sensorfusion.h"
+#include "devices/bluetoothdevice.h"
+#include "qzsettings.h"
+
+#include <QDebug>
+#include <QSettings>
+#include <QVariantMap>
+#include <math.h>
+
+SensorFusion::SensorFusion(bluetoothdevice *device, int tickMs, QObject *parent)
+    : QObject(parent), device(device), timer(this), tickMs(tickMs) {
+    clock.start();
+    for (int m = 0; m < MetricCount; m++) {
+        active[m] = false;
+        values[m] = 0;
+        selected[m] = -1;
+    }
+    timer.setSingleShot(true);
+    connect(&timer, &QTimer::timeout, this, [this]() { tick(); });
+}
+
+QString SensorFusion::metricName(Metric metric) {
+    switch (metric) {
+    case Heart:
+        return QStringLiteral("heart");
+    case Power:
+        return QStringLiteral("power");
+    case Cadence:
+        return QStringLiteral("cadence");
+    case Speed:
+        return QStringLiteral("speed");
+    default:
+        return QString();
+    }
+}
+
+QString SensorFusion::sourceName(Source source) {
+    switch (source) {
+    case HeartRateBelt:
+        return QStringLiteral("hrm");
+    case Watch:
+        return QStringLiteral("watch");
+    case PowerSensor:
+        return QStringLiteral("power");
+    case CadenceSensor:
+        return QStringLiteral("csc");
+    case RunPowerSensor:
+        return QStringLiteral("stryd");
+    default:
+        return QString();
+    }
+}
+
+SensorFusion::MetricConfig SensorFusion::configFromSettings(Metric metric) {
+    QSettings settings;
+    MetricConfig config;
+    QString priority;
+    int rule = Priority;
+    switch (metric) {
+    case Heart:
+        rule = settings.value(QZSettings::sensor_fusion_heart_rule, QZSettings::default_sensor_fusion_heart_rule)
+                   .toInt();
+        priority = settings
+                       .value(QZSettings::sensor_fusion_heart_priority,
+                              QZSettings::default_sensor_fusion_heart_priority)
+                       .toString();
+        break;
+    case Power:
+        rule = settings.value(QZSettings::sensor_fusion_power_rule, QZSettings::default_sensor_fusion_power_rule)
+                   .toInt();
+        priority = settings
+                       .value(QZSettings::sensor_fusion_power_priority,
+                              QZSettings::default_sensor_fusion_power_priority)
+                       .toString();
+        break;
+    case Cadence:
+        rule = settings.value(QZSettings::sensor_fusion_cadence_rule, QZSettings::default_sensor_fusion_cadence_rule)
+                   .toInt();
+        priority = settings
+                       .value(QZSettings::sensor_fusion_cadence_priority,
+                              QZSettings::default_sensor_fusion_cadence_priority)
+                       .toString();
+        config.windowMs = settings
+                              .value(QZSettings::sensor_fusion_cadence_window_ms,
+                                     QZSettings::default_sensor_fusion_cadence_window_ms)
+                              .toInt();
+        break;
+    case Speed:
+        rule = settings.value(QZSettings::sensor_fusion_speed_rule, QZSettings::default_sensor_fusion_speed_rule)
+                   .toInt();
+        priority = settings
+                       .value(QZSettings::sensor_fusion_speed_priority,
+                              QZSettings::default_sensor_fusion_speed_priority)
+                       .toString();
+        break;
+    default:
+        break;
+    }
+    if (rule >= Priority && rule <= Fallback)
+        config.rule = (Rule)rule;
+    foreach (const QString &name, priority.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        for (int s = 0; s < SourceCount; s++)
+            if (!name.trimmed().compare(sourceName((Source)s), Qt::CaseInsensitive) &&
+                !config.priority.contains((Source)s))
+                config.priority.append((Source)s);
+    }
+    config.staleMs =
+        settings.value(QZSettings::sensor_fusion_stale_ms, QZSettings::default_sensor_fusion_stale_ms).toInt();
+    return config;
+}
+
+void SensorFusion::loadSettings() {
+    for (int m = 0; m < MetricCount; m++)
+        configs[m] = configFromSettings((Metric)m);
+}
+
+void SensorFusion::setConfig(Metric metric, const MetricConfig &config) { configs[metric] = config; }
+
+void SensorFusion::input(Metric metric, Source source, double value, qint64 ms) {
+    if (metric < 0 || metric >= MetricCount || source < 0 || source >= SourceCount)
+        return;
+    if (!std::isfinite(value) || value < 0 || (metric == Heart && value == 0))
+        return;
+    Channel &c = channels[metric][source];
+    c.history[c.head] = {now(ms), value};
+    c.head = (c.head + 1) % historySize;
+    c.count = qMin(c.count + 1, historySize);
+    c.samples++;
+    merge(metric, c.last().ms, source);
+    schedule(c.last().ms);
+}
+
+bool SensorFusion::isStale(const Channel &c, const MetricConfig &config, qint64 ms) const {
+    return !c.count || ms - c.last().ms > config.staleMs;
+}
+
+double SensorFusion::channelValue(const Channel &c, const MetricConfig &config, qint64 ms) const {
+    if (config.windowMs <= 0)
+        return c.last().value;
+    // every sample holds until the next one: the mean over the window is weighted by how long each one held
+    qint64 from = ms - config.windowMs;
+    double sum = 0;
+    qint64 span = 0;
+    for (int i = 0; i < c.count; i++) {
+        qint64 start = qMax(c.at(i).ms, from);
+        qint64 end = i + 1 < c.count ? c.at(i + 1).ms : ms;
+        if (end <= start)
+            continue;
+        sum += c.at(i).value * (end - start);
+        span += end - start;
+    }
+    return span > 0 ? sum / span : c.last().value;
+}
+
+QList<SensorFusion::Source> SensorFusion::order(Metric metric) const {
+    QList<Source> sources = configs[metric].priority;
+    for (int s = 0; s < SourceCount; s++)
+        if (!sources.contains((Source)s))
+            sources.append((Source)s);
+    return sources;
+}
+
+void SensorFusion::tick(qint64 ms) {
+    ms = now(ms);
+    for (int m = 0; m < MetricCount; m++)
+        merge((Metric)m, ms, -1);
+    schedule(ms);
+}
+
+void SensorFusion::merge(Metric m, qint64 ms, int source) {
+    const MetricConfig &config = configs[m];
+    QList<Source> fresh;
+    foreach (Source s, order(m)) {
+        Channel &c = channels[m][s];
+        bool stale = isStale(c, config, ms);
+        if (stale && !c.stale) {
+            c.dropouts++;
+            qDebug() << "sensor fusion:" << sourceName(s) << metricName(m) << "stale since" << ms - c.last().ms
+                     << "ms";
+            emit sourceStale(m, s);
+        }
+        c.stale = stale;
+        if (!stale)
+            fresh.append(s);
+    }
+
+    if (fresh.isEmpty()) {
+        // the last value would be held forever otherwise, a sensor gone is a 0
+        if (active[m])
+            apply(m, 0);
+        active[m] = false;
+        values[m] = 0;
+        selected[m] = -1;
+        return;
+    }
+
+    int previous = active[m] ? selected[m] : -2;
+    double value;
+    if (config.rule == Average) {
+        double sum = 0;
+        foreach (Source s, fresh)
+            sum += channelValue(channels[m][s], config, ms);
+        value = sum / fresh.size();
+        selected[m] = fresh.size() == 1 ? fresh.first() : -1;
+    } else {
+        if (config.rule == Priority || selected[m] < 0 || !fresh.contains((Source)selected[m]))
+            selected[m] = fresh.first();
+        value = channelValue(channels[m][selected[m]], config, ms);
+    }
+    // a sample of the value goes to the device as the sensor did before the fusion, a tick only when it changed
+    bool changed = previous != selected[m] || value != values[m];
+    bool sampled = source >= 0 && (source == selected[m] || selected[m] < 0);
+    active[m] = true;
+    values[m] = value;
+    if (changed || sampled)
+        apply(m, value);
+}
+
+void SensorFusion::schedule(qint64 ms) {
+    if (tickMs <= 0)
+        return;
+    qint64 next = -1;
+    for (int m = 0; m < MetricCount; m++) {
+        const MetricConfig &config = configs[m];
+        for (int s = 0; s < SourceCount; s++) {
+            const Channel &c = channels[m][s];
+            if (c.stale)
+                continue;
+            qint64 due = c.last().ms + config.staleMs + 1;
+            if (config.windowMs > 0)
+                due = qMin(due, ms + tickMs);
+            next = next < 0 ? due : qMin(next, due);
+        }
+    }
+    if (next < 0) {
+        timer.stop();
+        return;
+    }
+    if (timer.isActive() && nextTickMs <= next)
+        return;
+    nextTickMs = next;
+    timer.start((int)qMax<qint64>(0, next - ms));
+}
+
+void SensorFusion::apply(Metric metric, double value) {
+    emit fused(metric, value);
+    if (!device)
+        return;
+    switch (metric) {
+    case Heart:
+        device->heartRate((uint8_t)qBound(0, qRound(value), 255));
+        break;
+    case Power:
+        device->powerSensor((uint16_t)qBound(0, qRound(value), 65535));
+        break;
+    case Cadence:
+        device->cadenceSensor((uint8_t)qBound(0, qRound(value), 255));
+        break;
+    case Speed:
+        device->speedSensor(value);
+        break;
+    default:
+        break;
+    }
+}
+
+QList<SensorFusion::Health> SensorFusion::health(qint64 ms) const {
+    ms = now(ms);
+    QList<Health> list;
+    for (int m = 0; m < MetricCount; m++) {
+        for (int s = 0; s < SourceCount; s++) {
+            const Channel &c = channels[m][s];
+            if (!c.samples)
+                continue;
+            Health h;
+            h.metric = (Metric)m;
+            h.source = (Source)s;
+            h.samples = c.samples;
+            h.value = c.last().value;
+            h.ageMs = ms - c.last().ms;
+            qint64 span = c.last().ms - c.at(0).ms;
+            h.rate = c.count > 1 && span > 0 ? (c.count - 1) * 1000.0 / span : 0;
+            h.dropouts = c.dropouts;
+            h.stale = isStale(c, configs[m], ms);
+            h.selected =
+                active[m] && !h.stale && (selected[m] == s || (selected[m] < 0 && configs[m].rule == Average));
+            list.append(h);
+        }
+    }
+    return list;
+}
+
+QVariantList SensorFusion::healthList() const {
+    QVariantList list;
+    foreach (const Health &h, health()) {
+        QVariantMap map;
+        map[QStringLiteral("metric")] = metricName(h.metric);
+        map[QStringLiteral("source")] = sourceName(h.source);
+        map[QStringLiteral("samples")] = h.samples;
+        map[QStringLiteral("value")] = h.value;
+        map[QStringLiteral("age_ms")] = h.ageMs;
+        map[QStringLiteral("rate")] = h.rate;
+        map[QStringLiteral("dropouts")] = h.dropouts;
+        map[QStringLiteral("stale")] = h.stale;
+        map[QStringLiteral("selected")] = h.selected;
+        list.append(map);
+    }
+    return list;
+}
@@ -0,0 +1,143 @@
+#ifndef SENSORFUSION_H
+#define SENSORFUSION_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVariantList>
+
+class bluetoothdevice;
+
+/**
+ * @brief The values of the accessory sensors (heart rate belt, watch, power sensor, cadence sensor, Stryd) merged
+ * into one value per metric and applied to the device, instead of the last sample received winning.
+ *
+ * Every sample is stamped when it arrives and kept in a short history of its source, and its metric is merged
+ * right away: the sources that aren't stale, with the rule of the metric: the first of the priority list, the
+ * average, or the current source until it goes stale (fallback, no switching back and forth). A window makes the
+ * value of a source the time weighted mean of its last samples, for the cadence of the crank events of a CSC sensor.
+ * The timer only runs when a source is due to go stale, and every tickMs while a windowed metric has a value. When
+ * all the sources of a metric go stale the device gets a 0 once, then the metric is left to the device.
+ */
+class SensorFusion : public QObject {
+    Q_OBJECT
+
+  public:
+    enum Metric { Heart, Power, Cadence, Speed, MetricCount };
+    enum Source { HeartRateBelt, Watch, PowerSensor, CadenceSensor, RunPowerSensor, SourceCount };
+    enum Rule { Priority, Average, Fallback };
+
+    static const int historySize = 32; // samples kept for every source of every metric
+
+    struct MetricConfig {
+        Rule rule = Priority;
+        QList<Source> priority; // the sources not listed come after, in the order of Source
+        int staleMs = 3000;
+        int windowMs = 0; // 0 for the last sample of every source
+    };
+
+    struct Health {
+        Metric metric = Heart;
+        Source source = HeartRateBelt;
+        quint64 samples = 0;
+        double value = 0;      // the last sample
+        qint64 ageMs = 0;      // since the last sample
+        double rate = 0;       // samples a second, over the history
+        quint32 dropouts = 0;  // how many times it went stale
+        bool stale = true;
+        bool selected = false; // part of the value of the metric
+    };
+
+    /**
+     * @param device the device the merged values are applied to, nullptr to only compute them
+     * @param tickMs the period of tick() while a windowed metric has a value, 0 to call it by hand
+     */
+    explicit SensorFusion(bluetoothdevice *device = nullptr, int tickMs = 250, QObject *parent = nullptr);
+
+    static QString metricName(Metric metric);
+    static QString sourceName(Source source);
+
+    /**
+     * @brief configFromSettings The rule, the priority list, the stale timeout and the window of a metric.
+     */
+    static MetricConfig configFromSettings(Metric metric);
+    void loadSettings();
+    void setConfig(Metric metric, const MetricConfig &config);
+    MetricConfig config(Metric metric) const { return configs[metric]; }
+
+    /**
+     * @brief input A sample of source at ms (monotonic, -1 for now), merged and applied to the device at once. A
+     * heart rate of 0 is a belt without contact and is skipped.
+     */
+    void input(Metric metric, Source source, double value, qint64 ms = -1);
+
+    /**
+     * @brief tick Merges every metric at ms (-1 for now): the stale sources are dropped and the windows move on.
+     * Only the values that changed are applied to the device.
+     */
+    void tick(qint64 ms = -1);
+
+    bool hasValue(Metric metric) const { return active[metric]; }
+    double value(Metric metric) const { return values[metric]; }
+
+    /**
+     * @brief selectedSource The source the value of metric comes from, -1 if none or an average.
+     */
+    int selectedSource(Metric metric) const { return selected[metric]; }
+
+    /**
+     * @brief health The state of every source that sent something, at ms (-1 for now).
+     */
+    QList<Health> health(qint64 ms = -1) const;
+
+    /**
+     * @brief healthList health() as maps, for QML and the templates.
+     */
+    QVariantList healthList() const;
+
+  signals:
+    void fused(int metric, double value);
+    void sourceStale(int metric, int source);
+
+  private:
+    struct Sample {
+        qint64 ms;
+        double value;
+    };
+
+    struct Channel {
+        Sample history[historySize];
+        int head = 0; // the next slot
+        int count = 0;
+        quint64 samples = 0;
+        quint32 dropouts = 0;
+        bool stale = true;
+        const Sample &last() const { return history[(head + historySize - 1) % historySize]; }
+        const Sample &at(int i) const { return history[(head + historySize - count + i) % historySize]; }
+    };
+
+    qint64 now(qint64 ms) const { return ms < 0 ? clock.elapsed() : ms; }
+    bool isStale(const Channel &c, const MetricConfig &config, qint64 ms) const;
+    double channelValue(const Channel &c, const MetricConfig &config, qint64 ms) const;
+    QList<Source> order(Metric metric) const;
+    // source is the one that just sent a sample, -1 for a tick
+    void merge(Metric metric, qint64 ms, int source);
+    // arms the timer for the next source going stale or the next move of a window
+    void schedule(qint64 ms);
+    void apply(Metric metric, double value);
+
+    bluetoothdevice *device;
+    QElapsedTimer clock;
+    QTimer timer;
+    int tickMs;
+    qint64 nextTickMs = 0;
+    MetricConfig configs[MetricCount];
+    Channel channels[MetricCount][SourceCount];
+    bool active[MetricCount];
+    double values[MetricCount];
+    int selected[MetricCount];
+};
+
+#endif // SENSORFUSION_H
@@ -33,6 +33,8 @@ class SessionLine {
     double groundContactMS;
     double verticalOscillationMM;
     double stepCount;
+    double pedalSmoothness = 0; // percent, 0 when the bike has no force sensor
+    double rightBalance = 0;    // percent of the pedal stroke produced by the right leg
 
     SessionLine();
     SessionLine(double speed, int8_t inclination, double distance, uint16_t watt, resistance_t resistance,
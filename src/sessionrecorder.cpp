@@ -0,0 +1,270 @@
+#include "sessionrecorder.h"
+#include "activityhistory.h"
+#include "appdirs.h"
+#include "devices/bike.h"
+#include "devices/bluetooth.h"
+#include "devices/elliptical.h"
+#include "devices/jumprope.h"
+#include "devices/m3ibike/m3ibike.h"
+#include "devices/rower.h"
+#include "devices/treadmill.h"
+#include "qfit.h"
+#include "qzmetrics.h"
+#include "qzsettings.h"
+#include "trainprogram.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+#include <QSettings>
+#include <QTimer>
+#include <math.h>
+
+SessionRecorder::SessionRecorder(bluetooth *manager, const QString &trainProgram, QObject *parent)
+    : QObject(parent), manager(manager), trainProgramFile(trainProgram) {
+    connect(manager, &bluetooth::deviceConnected, this, &SessionRecorder::deviceConnected);
+    if (manager->device())
+        deviceConnected();
+}
+
+void SessionRecorder::deviceConnected() {
+    bluetoothdevice *device = manager->device();
+    if (!device)
+        return;
+
+    if (autoRecord) {
+        if (!recorder) {
+            recorder = new QTimer(this);
+            connect(recorder, &QTimer::timeout, this, &SessionRecorder::tick);
+        }
+        recorder->start(1000);
+    }
+    if (!trainProgramFile.isEmpty() && !m_program)
+        loadTrainProgram();
+    else if (m_program && programDevice != device)
+        setProgram(m_program);
+}
+
+void SessionRecorder::setAutoRecord(bool autoRecord) {
+    this->autoRecord = autoRecord;
+    if (!autoRecord && recorder)
+        recorder->stop();
+    else if (autoRecord)
+        deviceConnected();
+}
+
+void SessionRecorder::loadTrainProgram() {
+    trainprogram *program =
+        trainprogram::load(trainProgramFile, manager, QFileInfo(trainProgramFile).suffix().toUpper());
+    if (!program) {
+        qDebug() << "SessionRecorder: can't load" << trainProgramFile;
+        trainProgramFile.clear();
+        return;
+    }
+    program->setParent(this);
+    setProgram(program);
+    program->restart();
+}
+
+void SessionRecorder::setProgram(trainprogram *program) {
+    // a deleted program or device has no connection left
+    if (m_program) {
+        disconnect(m_program, nullptr, this, nullptr);
+        if (programDevice) {
+            disconnect(m_program, nullptr, programDevice, nullptr);
+            disconnect(programDevice, nullptr, m_program, nullptr);
+        }
+    }
+    bluetoothdevice *device = manager->device();
+    m_program = program;
+    programDevice = device;
+    if (!program || !device)
+        return;
+
+    connect(program, &trainprogram::start, device, &bluetoothdevice::start);
+    connect(program, &trainprogram::stop, device, &bluetoothdevice::stop);
+    connect(program, &trainprogram::lap, this, &SessionRecorder::lap);
+    connect(program, &trainprogram::start, this, &SessionRecorder::start);
+    connect(program, &trainprogram::stop, this, &SessionRecorder::stop);
+    if (device->deviceType() == bluetoothdevice::TREADMILL) {
+        treadmill *t = (treadmill *)device;
+        connect(program, &trainprogram::changeSpeed, t, &treadmill::changeSpeed);
+        connect(program, &trainprogram::changeFanSpeed, t, &treadmill::changeFanSpeed);
+        connect(program, &trainprogram::changeInclination, t, &treadmill::changeInclination);
+        connect(program, &trainprogram::changeSpeedAndInclination, t, &treadmill::changeSpeedAndInclination);
+        connect(program, &trainprogram::changePower, t, &treadmill::changePower);
+        connect(t, &treadmill::tapeStarted, program, &trainprogram::onTapeStarted);
+    } else if (device->deviceType() == bluetoothdevice::BIKE) {
+        bike *b = (bike *)device;
+        connect(program, &trainprogram::changeCadence, b, &bike::changeCadence);
+        connect(program, &trainprogram::changePower, b, &bike::changePower);
+        connect(program, &trainprogram::changeInclination, b, &bike::changeInclination);
+        connect(program, &trainprogram::changeResistance, b, &bike::changeResistance);
+        connect(program, &trainprogram::changeRequestedPelotonResistance, b, &bike::changeRequestedPelotonResistance);
+        connect(b, &bike::bikeStarted, program, &trainprogram::onTapeStarted);
+    } else if (device->deviceType() == bluetoothdevice::ELLIPTICAL) {
+        elliptical *e = (elliptical *)device;
+        connect(program, &trainprogram::changeCadence, e, &elliptical::changeCadence);
+        connect(program, &trainprogram::changePower, e, &elliptical::changePower);
+        connect(program, &trainprogram::changeInclination, e, &elliptical::changeInclination);
+        connect(program, &trainprogram::changeResistance, e, &elliptical::changeResistance);
+        connect(program, &trainprogram::changeRequestedPelotonResistance, e,
+                &elliptical::changeRequestedPelotonResistance);
+    } else if (device->deviceType() == bluetoothdevice::ROWING) {
+        rower *r = (rower *)device;
+        connect(program, &trainprogram::changePower, r, &rower::changePower);
+        connect(program, &trainprogram::changeResistance, r, &rower::changeResistance);
+        connect(program, &trainprogram::changeCadence, r, &rower::changeCadence);
+        connect(program, &trainprogram::changeSpeed, r, &rower::changeSpeed);
+    }
+    connect(program, &trainprogram::changeNextInclination300Meters, device,
+            &bluetoothdevice::changeNextInclination300Meters);
+    connect(program, &trainprogram::changeGeoPosition, device, &bluetoothdevice::changeGeoPosition);
+
+    qDebug() << "SessionRecorder: train program associated to the device";
+}
+
+void SessionRecorder::tick() {
+    bluetoothdevice *device = manager->device();
+    // as homeform, nothing is recorded while the session is paused or stopped
+    if (!device || stopped || device->isPaused() || !device->connected())
+        return;
+
+    record(lapTrigger);
+    lapTrigger = false;
+}
+
+SessionLine SessionRecorder::record(bool lap) {
+    bluetoothdevice *device = manager->device();
+    if (!device)
+        return SessionLine();
+
+    double speed = device->currentSpeed().value();
+    if (speed > 0 && !isinf(speed))
+        device->addCurrentDistance1s(speed / 3600.0);
+
+    SessionLine s = sample(device, lap);
+    m_session.append(s);
+    publishMetrics(m_session);
+    return s;
+}
+
+void SessionRecorder::clear() {
+    m_session.clear();
+    publishMetrics(m_session);
+}
+
+SessionLine SessionRecorder::sample(bluetoothdevice *device, bool lap) {
+    double inclination = 0;
+    double resistance = 0;
+    double pace = 0;
+    double peloton_resistance = 0;
+    uint32_t totalStrokes = 0;
+    double avgStrokesRate = 0;
+    double maxStrokesRate = 0;
+    double avgStrokesLength = 0;
+    double strideLength = 0;
+    double groundContact = 0;
+    double verticalOscillation = 0;
+    double stepCount = 0;
+
+    // pace in the FIT unit, from the m:ss per km of the device
+    auto fitPace = [device]() {
+        if (!device->currentSpeed().value())
+            return 0.0;
+        double p = 10000 / (device->currentPace().second() + (device->currentPace().minute() * 60));
+        return p < 0 ? 0.0 : p;
+    };
+
+    switch (device->deviceType()) {
+    case bluetoothdevice::TREADMILL: {
+        treadmill *t = (treadmill *)device;
+        QSettings settings;
+        pace = fitPace();
+        strideLength = t->currentStrideLength().value();
+        if (settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool())
+            strideLength *= 0.393701;
+        groundContact = t->currentGroundContact().value();
+        verticalOscillation = t->currentVerticalOscillation().value();
+        stepCount = t->currentStepCount().value();
+        inclination = t->currentInclination().value();
+        break;
+    }
+    case bluetoothdevice::BIKE: {
+        bike *b = (bike *)device;
+        QSettings settings;
+        // the inclination of a bike with a peloton cadence sensor is not recorded
+        if (!settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool())
+            inclination = b->currentInclination().value();
+        resistance = b->currentResistance().value();
+        peloton_resistance = b->pelotonResistance().value();
+        break;
+    }
+    case bluetoothdevice::ROWING: {
+        rower *r = (rower *)device;
+        pace = fitPace();
+        resistance = r->currentResistance().value();
+        peloton_resistance = r->pelotonResistance().value();
+        totalStrokes = r->currentStrokesCount().value();
+        avgStrokesRate = r->currentCadence().average();
+        maxStrokesRate = r->currentCadence().max();
+        avgStrokesLength = r->currentStrokesLength().average();
+        break;
+    }
+    case bluetoothdevice::JUMPROPE: {
+        jumprope *j = (jumprope *)device;
+        pace = fitPace();
+        stepCount = j->JumpsCount.value();
+        inclination = j->JumpsSequence.value();
+        break;
+    }
+    case bluetoothdevice::ELLIPTICAL: {
+        elliptical *e = (elliptical *)device;
+        resistance = e->currentResistance().value();
+        peloton_resistance = e->pelotonResistance().value();
+        inclination = e->currentInclination().value();
+        break;
+    }
+    default:
+        break;
+    }
+
+    SessionLine s(device->currentSpeed().value(), inclination, device->currentDistance1s().value(), device->wattsMetricforUI(),
+                  resistance, peloton_resistance, (uint8_t)device->currentHeart().value(), pace,
+                  device->currentCadence().value(), device->calories().value(), device->elevationGain().value(),
+                  device->elapsedTime().second() + (device->elapsedTime().minute() * 60) +
+                      (device->elapsedTime().hour() * 3600),
+                  lap, totalStrokes, avgStrokesRate, maxStrokesRate, avgStrokesLength, device->currentCordinate(),
+                  strideLength, groundContact, verticalOscillation, stepCount);
+    if (device->deviceType() == bluetoothdevice::BIKE) {
+        s.pedalSmoothness = ((bike *)device)->currentPedalSmoothness().value();
+        s.rightBalance = ((bike *)device)->currentRightBalance().value();
+    }
+    return s;
+}
+
+QString SessionRecorder::fitFileName() {
+    return AppDirs::writable() +
+           QDateTime::currentDateTime().toString().replace(QStringLiteral(":"), QStringLiteral("_")) +
+           QStringLiteral(".fit");
+}
+
+void SessionRecorder::publishMetrics(const QList<SessionLine> &session) {
+    QZMetrics::setGauge(QZMetrics::SessionSamples, session.size());
+    QZMetrics::setGauge(QZMetrics::SessionMemoryBytes, session.size() * (qint64)sizeof(SessionLine));
+    QZMetrics::setGauge(QZMetrics::ResidentMemoryBytes, QZMetrics::residentMemoryBytes());
+}
+
+QString SessionRecorder::save(FIT_SPORT sport, const QString &workoutName) {
+    bluetoothdevice *device = manager->device();
+    if (!device)
+        return QString();
+
+    QString filename = fitFileName();
+    qfit::save(filename, m_session, device->deviceType(),
+               qobject_cast<m3ibike *>(device) ? QFIT_PROCESS_DISTANCENOISE : QFIT_PROCESS_NONE, sport, workoutName,
+               device->bluetoothDevice.name());
+    qDebug() << "SessionRecorder: saved" << m_session.size() << "samples to" << filename;
+    ActivityHistory::instance()->add(filename, m_session);
+    return filename;
+}
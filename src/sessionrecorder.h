@@ -0,0 +1,116 @@
+#ifndef SESSIONRECORDER_H
+#define SESSIONRECORDER_H
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include "fit_profile.hpp"
+#include "sessionline.h"
+
+class bluetooth;
+class bluetoothdevice;
+class QTimer;
+class trainprogram;
+
+/**
+ * @brief The session of the device of the bluetooth manager without any user interface: a sample every second
+ * while the device is connected and neither paused nor stopped, the FIT file and optionally a train program
+ * driving the device. It's what the headless mode (-no-gui) runs. homeform owns one too: it takes the samples from
+ * its own update with record() and hands its train programs to setProgram().
+ * Nothing is started before the device connects, the train program is loaded only then.
+ */
+class SessionRecorder : public QObject {
+    Q_OBJECT
+
+  public:
+    /**
+     * @param trainProgram the workout file (xml, zwo...) to run once the device connects, empty for none
+     */
+    explicit SessionRecorder(bluetooth *manager, const QString &trainProgram = QString(), QObject *parent = nullptr);
+
+    const QList<SessionLine> &session() const { return m_session; }
+    QList<SessionLine> &session() { return m_session; }
+    trainprogram *program() const { return m_program; }
+
+    /**
+     * @brief setAutoRecord With false there is no sample every second: the owner records with record().
+     */
+    void setAutoRecord(bool autoRecord);
+
+    /**
+     * @brief setProgram Makes the device of the bluetooth manager follow a train program: its start, stop and
+     * targets. The wiring of the previous program is removed. The program is not owned.
+     */
+    void setProgram(trainprogram *program);
+
+    /**
+     * @brief record Adds the distance of the last second to the device and appends its current values to the
+     * session.
+     * @return the new line of the session
+     */
+    SessionLine record(bool lap = false);
+
+    /**
+     * @brief clear Empties the session, for a new one.
+     */
+    void clear();
+
+    /**
+     * @brief sample The current values of a device as a line of the session, in metric units.
+     */
+    static SessionLine sample(bluetoothdevice *device, bool lap = false);
+
+    /**
+     * @brief fitFileName A new FIT file name in the writable folder of the app, from the current time.
+     */
+    static QString fitFileName();
+
+    /**
+     * @brief publishMetrics Updates the session and memory gauges of QZMetrics.
+     */
+    static void publishMetrics(const QList<SessionLine> &session);
+
+  public slots:
+    void lap() { lapTrigger = true; }
+
+    /**
+     * @brief start Records again after stop().
+     */
+    void start() { stopped = false; }
+
+    /**
+     * @brief stop Stops the recording, as the stop of homeform. A pause is the pause of the device.
+     */
+    void stop(bool pause) {
+        if (!pause)
+            stopped = true;
+    }
+
+    /**
+     * @brief save Writes the session to a new FIT file and adds it to the activity history.
+     * @param sport the sport of the FIT file, FIT_SPORT_INVALID for the one of the device
+     * @return the file name, empty without a device
+     */
+    QString save(FIT_SPORT sport = FIT_SPORT_INVALID, const QString &workoutName = QString());
+
+  private slots:
+    void deviceConnected();
+    void tick();
+
+  private:
+    void loadTrainProgram();
+
+    bluetooth *manager;
+    QString trainProgramFile;
+    QPointer<trainprogram> m_program;
+    QPointer<bluetoothdevice> programDevice;
+    QTimer *recorder = nullptr;
+    bool autoRecord = true;
+    QList<SessionLine> m_session;
+    bool lapTrigger = false;
+    bool stopped = false;
+};
+
+#endif // SESSIONRECORDER_H
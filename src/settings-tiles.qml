@@ -238,6 +238,22 @@ ScrollView {
         property real tile_preset_powerzone_7_value: 7.0
         property string tile_preset_powerzone_7_label: "Zone 7"
         property string tile_preset_powerzone_7_color: "red"        
+        property bool tile_pedal_stroke_enabled: false
+        property int  tile_pedal_stroke_order: 62
+        property bool tile_ghost_time_enabled: false
+        property int  tile_ghost_time_order: 63
+        property bool tile_ghost_distance_enabled: false
+        property int  tile_ghost_distance_order: 64
+        property bool tile_ghost_power_enabled: false
+        property int  tile_ghost_power_order: 65
+        property bool tile_normalized_power_enabled: false
+        property int  tile_normalized_power_order: 66
+        property bool tile_tss_enabled: false
+        property int  tile_tss_order: 67
+        property bool tile_wbal_enabled: false
+        property int  tile_wbal_order: 68
+        property bool tile_power_zone_time_enabled: false
+        property int  tile_power_zone_time_order: 69
     }
 
 
@@ -2417,6 +2433,238 @@ ScrollView {
             }
         }        
 
+        AccordionCheckElement {
+            title: qsTr("Pedal Stroke")
+            linkedBoolSetting: "tile_pedal_stroke_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: pedalStrokeOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_pedal_stroke_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = pedalStrokeOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_pedal_stroke_order = pedalStrokeOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Ghost Time Gap")
+            linkedBoolSetting: "tile_ghost_time_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: ghostTimeOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_ghost_time_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = ghostTimeOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_ghost_time_order = ghostTimeOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Ghost Distance Gap")
+            linkedBoolSetting: "tile_ghost_distance_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: ghostDistanceOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_ghost_distance_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = ghostDistanceOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_ghost_distance_order = ghostDistanceOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Ghost Watt Delta")
+            linkedBoolSetting: "tile_ghost_power_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: ghostPowerOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_ghost_power_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = ghostPowerOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_ghost_power_order = ghostPowerOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Normalized Power")
+            linkedBoolSetting: "tile_normalized_power_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: normalizedPowerOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_normalized_power_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = normalizedPowerOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_normalized_power_order = normalizedPowerOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("TSS")
+            linkedBoolSetting: "tile_tss_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: tssOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_tss_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = tssOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_tss_order = tssOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("W' Balance")
+            linkedBoolSetting: "tile_wbal_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: wbalOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_wbal_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = wbalOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_wbal_order = wbalOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Time in Power Zone")
+            linkedBoolSetting: "tile_power_zone_time_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: powerZoneTimeOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_power_zone_time_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = powerZoneTimeOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_power_zone_time_order = powerZoneTimeOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
         AccordionCheckElement {
             id: presetResistance1EnabledAccordion
             title: qsTr("Preset Resistance 1")
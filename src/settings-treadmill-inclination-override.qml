@@ -51,6 +51,42 @@ ScrollView {
         property double treadmill_inclination_ovveride_offset: 0.0
     }
 
+    function overrideTable() {
+        return [
+            settings.treadmill_inclination_override_0,
+            settings.treadmill_inclination_override_05,
+            settings.treadmill_inclination_override_10,
+            settings.treadmill_inclination_override_15,
+            settings.treadmill_inclination_override_20,
+            settings.treadmill_inclination_override_25,
+            settings.treadmill_inclination_override_30,
+            settings.treadmill_inclination_override_35,
+            settings.treadmill_inclination_override_40,
+            settings.treadmill_inclination_override_45,
+            settings.treadmill_inclination_override_50,
+            settings.treadmill_inclination_override_55,
+            settings.treadmill_inclination_override_60,
+            settings.treadmill_inclination_override_65,
+            settings.treadmill_inclination_override_70,
+            settings.treadmill_inclination_override_75,
+            settings.treadmill_inclination_override_80,
+            settings.treadmill_inclination_override_85,
+            settings.treadmill_inclination_override_90,
+            settings.treadmill_inclination_override_95,
+            settings.treadmill_inclination_override_100,
+            settings.treadmill_inclination_override_105,
+            settings.treadmill_inclination_override_110,
+            settings.treadmill_inclination_override_115,
+            settings.treadmill_inclination_override_120,
+            settings.treadmill_inclination_override_125,
+            settings.treadmill_inclination_override_130,
+            settings.treadmill_inclination_override_135,
+            settings.treadmill_inclination_override_140,
+            settings.treadmill_inclination_override_145,
+            settings.treadmill_inclination_override_150
+        ];
+    }
+
 
     ColumnLayout {
         id: column1
@@ -113,6 +149,42 @@ ScrollView {
             }
         }
 
+        RowLayout {
+            spacing: 10
+            Label {
+                text: qsTr("Preview Inclination:")
+                Layout.fillWidth: true
+            }
+            TextField {
+                id: treadmillOverridePreviewTextField
+                text: "5"
+                horizontalAlignment: Text.AlignRight
+                Layout.fillHeight: false
+                Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+                onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+            }
+        }
+
+        Label {
+            property var preview: rootItem.inclinationOverridePreview(Number(treadmillOverridePreviewTextField.text),
+                                                                      settings.treadmill_inclination_ovveride_gain,
+                                                                      settings.treadmill_inclination_ovveride_offset,
+                                                                      overrideTable())
+            text: qsTr("Read from the treadmill: ") + treadmillOverridePreviewTextField.text + qsTr("% is shown as ") +
+                  preview.shown.toFixed(2) + qsTr("%. Requested: ") + treadmillOverridePreviewTextField.text +
+                  qsTr("% is sent to the treadmill as ") + preview.requested.toFixed(2) + qsTr("%. Between two points of the table the override is interpolated, and a point lower than the one before is raised to it.")
+            font.bold: true
+            font.italic: true
+            font.pixelSize: Qt.application.font.pixelSize - 2
+            textFormat: Text.PlainText
+            wrapMode: Text.WordWrap
+            verticalAlignment: Text.AlignVCenter
+            Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+            Layout.fillWidth: true
+            color: Material.color(Material.Lime)
+        }
+
         RowLayout {
             spacing: 10
             Label {
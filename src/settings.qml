@@ -1103,6 +1103,52 @@ import QtQuick.Dialogs 1.0
 
             property bool proform_bike_PFEVEX71316_0: false
             property bool real_inclination_to_virtual_treamill_bridge: false
+            property bool metrics_endpoint: false
+            property int metrics_port: 9180
+            property bool tile_pedal_stroke_enabled: false
+            property int tile_pedal_stroke_order: 62
+            property string filter_chain_speed: ""
+            property string filter_chain_power: ""
+            property string filter_chain_cadence: ""
+            property string filter_chain_heart: ""
+            property real virtual_speed_wind: 0
+            property real virtual_speed_drafting: 0
+            property string gym_stations: ""
+            property string influxdb_url: ""
+            property string influxdb_token: ""
+            property string influxdb_measurement: "workout"
+            property int influxdb_batch_points: 10
+            property int influxdb_batch_ms: 5000
+            property bool influxdb_gzip: true
+            property int influxdb_spool_kb: 10240
+            property bool zwift_sim_erg: false
+            property real zwift_sim_erg_smoothing: 2.0
+            property bool tile_ghost_time_enabled: false
+            property int tile_ghost_time_order: 63
+            property bool tile_ghost_distance_enabled: false
+            property int tile_ghost_distance_order: 64
+            property bool tile_ghost_power_enabled: false
+            property int tile_ghost_power_order: 65
+            property int critical_power: 0
+            property int w_prime: 20000
+            property bool tile_normalized_power_enabled: false
+            property int tile_normalized_power_order: 66
+            property bool tile_tss_enabled: false
+            property int tile_tss_order: 67
+            property bool tile_wbal_enabled: false
+            property int tile_wbal_order: 68
+            property bool tile_power_zone_time_enabled: false
+            property int tile_power_zone_time_order: 69
+            property int sensor_fusion_heart_rule: 0
+            property int sensor_fusion_power_rule: 0
+            property int sensor_fusion_cadence_rule: 0
+            property int sensor_fusion_speed_rule: 0
+            property string sensor_fusion_heart_priority: "hrm,watch,stryd"
+            property string sensor_fusion_power_priority: "power,stryd"
+            property string sensor_fusion_cadence_priority: "csc,stryd"
+            property string sensor_fusion_speed_priority: "stryd"
+            property int sensor_fusion_stale_ms: 3000
+            property int sensor_fusion_cadence_window_ms: 2000
         }
 
         function paddingZeros(text, limit) {
@@ -1338,6 +1384,65 @@ import QtQuick.Dialogs 1.0
                         color: Material.color(Material.Lime)
                     }
 
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            text: qsTr("Critical Power (W):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: criticalPowerTextField
+                            text: settings.critical_power
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.critical_power = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.critical_power = criticalPowerTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            text: qsTr("W' (J):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: wPrimeTextField
+                            text: settings.w_prime
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.w_prime = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.w_prime = wPrimeTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    Label {
+                        text: qsTr("Your Critical Power and the work you can do above it (W'), for the W' balance tile: how much of that work is left, spent above the Critical Power and recovered below it. Leave the Critical Power to 0 to use the FTP.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: Qt.application.font.pixelSize - 2
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
                     RowLayout {
                         spacing: 10
                         Label {
@@ -2208,6 +2313,69 @@ import QtQuick.Dialogs 1.0
                         color: Material.color(Material.Lime)
                     }
 
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelVirtualSpeedWind
+                            text: qsTr("Head Wind (km/h)")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: virtualSpeedWindTextField
+                            text: settings.virtual_speed_wind
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            //inputMethodHints: Qt.ImhFormattedNumbersOnly
+                            onAccepted: settings.virtual_speed_wind = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okVirtualSpeedWindButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.virtual_speed_wind = virtualSpeedWindTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelVirtualSpeedDrafting
+                            text: qsTr("Drafting (%)")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: virtualSpeedDraftingTextField
+                            text: settings.virtual_speed_drafting
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            //inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.virtual_speed_drafting = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okVirtualSpeedDraftingButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.virtual_speed_drafting = virtualSpeedDraftingTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    Label {
+                        text: qsTr("Head wind and drafting used when QZ calculates the speed from your power. A negative head wind is a tail wind. Drafting is the share of the air resistance you save riding behind other riders, 30% is a typical value in a group, up to 90%.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: Qt.application.font.pixelSize - 2
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
                     RowLayout {
                         spacing: 10
                         Label {
@@ -2282,6 +2450,72 @@ import QtQuick.Dialogs 1.0
                         Layout.alignment: Qt.AlignLeft | Qt.AlignTop
                         Layout.fillWidth: true
                         color: Material.color(Material.Lime)
+                    }
+
+                    IndicatorOnlySwitch {
+                        id: zwiftSimErgDelegate
+                        text: qsTr("Zwift Simulation as Target Power")
+                        spacing: 0
+                        bottomPadding: 0
+                        topPadding: 0
+                        rightPadding: 0
+                        leftPadding: 0
+                        clip: false
+                        checked: settings.zwift_sim_erg
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        onClicked: settings.zwift_sim_erg = checked
+                    }
+
+                    Label {
+                        text: qsTr("In Simulation Mode, QZ computes the power needed to ride at your current speed on the road of Zwift (slope, rolling resistance, wind and your weight) 4 times a second and sends it to your bike as a target power, or as the resistance that gives that power at your cadence if your bike has no ERG mode. Use it for bikes without a native slope mode instead of the Zwift Resistance Offset and Gain. Default is off.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: Qt.application.font.pixelSize - 2
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelZwiftSimErgSmoothing
+                            text: qsTr("Simulation Smoothing (s):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: zwiftSimErgSmoothingTextField
+                            text: settings.zwift_sim_erg_smoothing
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhFormattedNumbersOnly
+                            onAccepted: settings.zwift_sim_erg_smoothing = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okZwiftSimErgSmoothingButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.zwift_sim_erg_smoothing = zwiftSimErgSmoothingTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    Label {
+                        text: qsTr("How fast the target power follows the road and your speed: a longer time is smoother, a shorter one more responsive. Default is 2.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: Qt.application.font.pixelSize - 2
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
                     }                    
 
                     RowLayout {
@@ -8458,6 +8692,119 @@ import QtQuick.Dialogs 1.0
                         color: Material.color(Material.Lime)
                     }                   
 
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelFilterChainSpeed
+                            text: qsTr("Speed Filter:")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: filterChainSpeedTextField
+                            text: settings.filter_chain_speed
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhNoPredictiveText
+                            onAccepted: settings.filter_chain_speed = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okFilterChainSpeedButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.filter_chain_speed = filterChainSpeedTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelFilterChainPower
+                            text: qsTr("Power Filter:")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: filterChainPowerTextField
+                            text: settings.filter_chain_power
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhNoPredictiveText
+                            onAccepted: settings.filter_chain_power = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okFilterChainPowerButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.filter_chain_power = filterChainPowerTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelFilterChainCadence
+                            text: qsTr("Cadence Filter:")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: filterChainCadenceTextField
+                            text: settings.filter_chain_cadence
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhNoPredictiveText
+                            onAccepted: settings.filter_chain_cadence = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okFilterChainCadenceButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.filter_chain_cadence = filterChainCadenceTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelFilterChainHeart
+                            text: qsTr("Heart Filter:")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: filterChainHeartTextField
+                            text: settings.filter_chain_heart
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhNoPredictiveText
+                            onAccepted: settings.filter_chain_heart = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okFilterChainHeartButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.filter_chain_heart = filterChainHeartTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    Label {
+                        text: qsTr("Filters applied to the values read from your equipment, after gain and offset. Separate the stages with ; and the parameters with , for example outlier:4;median:3;kalman:1,0.01,0.75. Stages: kalman:measure error,estimate error,process noise - ema:alpha (0 to 1, smaller is smoother) - median:samples (2 to 9) - slew:max change per second - outlier:deviations,samples (drops isolated spikes, follows a real change after the given samples). Leave empty for no filter, an invalid value disables the filter.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: Qt.application.font.pixelSize - 2
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
                     Label {
                         id: stravaLabel
                         text: qsTr("Strava")
@@ -9444,38 +9791,233 @@ import QtQuick.Dialogs 1.0
                     }
 
                     AccordionElement {
-                        id: eliteAccesoriesAccordion
-                        title: qsTr("Elite™ Products")
+                        id: sensorFusionOptionsAccordion
+                        title: qsTr("Sensor Fusion Options")
                         indicatRectColor: Material.color(Material.Grey)
                         textColor: Material.color(Material.Yellow)
                         color: Material.backgroundColor
                         accordionContent: ColumnLayout {
                             spacing: 0
-                            AccordionElement {
-                                id: eliteRizerOptionsAccordion
-                                title: qsTr("Elite Rizer Options")
-                                indicatRectColor: Material.color(Material.Grey)
-                                textColor: Material.color(Material.Blue)
-                                color: Material.backgroundColor
-                                accordionContent: ColumnLayout {
-                                    spacing: 0
-                                    Label {
-                                        id: labelEliteRizerName
-                                        text: qsTr("Elite Rizer:")
-                                        Layout.fillWidth: true
-                                    }
-                                    RowLayout {
-                                        spacing: 10
-                                        ComboBox {
-                                            id: eliteRizerNameTextField
-                                            model: rootItem.bluetoothDevices
-                                            displayText: settings.elite_rizer_name
-                                            Layout.fillHeight: false
-                                            Layout.fillWidth: true
-                                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
-                                            onActivated: {
-                                                console.log("combomodel activated" + eliteRizerNameTextField.currentIndex)
-                                                displayText = eliteRizerNameTextField.currentValue
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Heart Rate:")
+                                    Layout.fillWidth: true
+                                }
+                                ComboBox {
+                                    id: sensorFusionHeartRuleComboBox
+                                    model: [ "Priority", "Average", "Fallback" ]
+                                    currentIndex: settings.sensor_fusion_heart_rule
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                }
+                                TextField {
+                                    id: sensorFusionHeartPriorityTextField
+                                    text: settings.sensor_fusion_heart_priority
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.sensor_fusion_heart_rule = sensorFusionHeartRuleComboBox.currentIndex; settings.sensor_fusion_heart_priority = sensorFusionHeartPriorityTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Power:")
+                                    Layout.fillWidth: true
+                                }
+                                ComboBox {
+                                    id: sensorFusionPowerRuleComboBox
+                                    model: [ "Priority", "Average", "Fallback" ]
+                                    currentIndex: settings.sensor_fusion_power_rule
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                }
+                                TextField {
+                                    id: sensorFusionPowerPriorityTextField
+                                    text: settings.sensor_fusion_power_priority
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.sensor_fusion_power_rule = sensorFusionPowerRuleComboBox.currentIndex; settings.sensor_fusion_power_priority = sensorFusionPowerPriorityTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Cadence:")
+                                    Layout.fillWidth: true
+                                }
+                                ComboBox {
+                                    id: sensorFusionCadenceRuleComboBox
+                                    model: [ "Priority", "Average", "Fallback" ]
+                                    currentIndex: settings.sensor_fusion_cadence_rule
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                }
+                                TextField {
+                                    id: sensorFusionCadencePriorityTextField
+                                    text: settings.sensor_fusion_cadence_priority
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.sensor_fusion_cadence_rule = sensorFusionCadenceRuleComboBox.currentIndex; settings.sensor_fusion_cadence_priority = sensorFusionCadencePriorityTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Speed:")
+                                    Layout.fillWidth: true
+                                }
+                                ComboBox {
+                                    id: sensorFusionSpeedRuleComboBox
+                                    model: [ "Priority", "Average", "Fallback" ]
+                                    currentIndex: settings.sensor_fusion_speed_rule
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                }
+                                TextField {
+                                    id: sensorFusionSpeedPriorityTextField
+                                    text: settings.sensor_fusion_speed_priority
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.sensor_fusion_speed_rule = sensorFusionSpeedRuleComboBox.currentIndex; settings.sensor_fusion_speed_priority = sensorFusionSpeedPriorityTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            Label {
+                                text: qsTr("How the values of more sensors for the same metric are merged. Priority: the first sensor of the list that is sending. Average: the mean of the sensors that are sending. Fallback: the sensor in use until it stops, then the next one of the list. Sensors: hrm (heart rate belt), watch, power (power sensor), csc (cadence sensor), stryd.")
+                                font.bold: true
+                                font.italic: true
+                                font.pixelSize: Qt.application.font.pixelSize - 2
+                                textFormat: Text.PlainText
+                                wrapMode: Text.WordWrap
+                                verticalAlignment: Text.AlignVCenter
+                                Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                                Layout.fillWidth: true
+                                color: Material.color(Material.Lime)
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Sensor Timeout (ms):")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: sensorFusionStaleTextField
+                                    text: settings.sensor_fusion_stale_ms
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    inputMethodHints: Qt.ImhDigitsOnly
+                                    onAccepted: settings.sensor_fusion_stale_ms = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.sensor_fusion_stale_ms = sensorFusionStaleTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Cadence Smoothing (ms):")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: sensorFusionCadenceWindowTextField
+                                    text: settings.sensor_fusion_cadence_window_ms
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    inputMethodHints: Qt.ImhDigitsOnly
+                                    onAccepted: settings.sensor_fusion_cadence_window_ms = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.sensor_fusion_cadence_window_ms = sensorFusionCadenceWindowTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            Label {
+                                text: qsTr("A sensor silent for longer than the timeout is left out, and the metric goes to 0 when all its sensors are. The cadence of every sensor is averaged over the smoothing time, 0 to use the last value. Default: 3000 and 2000.")
+                                font.bold: true
+                                font.italic: true
+                                font.pixelSize: Qt.application.font.pixelSize - 2
+                                textFormat: Text.PlainText
+                                wrapMode: Text.WordWrap
+                                verticalAlignment: Text.AlignVCenter
+                                Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                                Layout.fillWidth: true
+                                color: Material.color(Material.Lime)
+                            }
+                        }
+                    }
+
+                    AccordionElement {
+                        id: eliteAccesoriesAccordion
+                        title: qsTr("Elite™ Products")
+                        indicatRectColor: Material.color(Material.Grey)
+                        textColor: Material.color(Material.Yellow)
+                        color: Material.backgroundColor
+                        accordionContent: ColumnLayout {
+                            spacing: 0
+                            AccordionElement {
+                                id: eliteRizerOptionsAccordion
+                                title: qsTr("Elite Rizer Options")
+                                indicatRectColor: Material.color(Material.Grey)
+                                textColor: Material.color(Material.Blue)
+                                color: Material.backgroundColor
+                                accordionContent: ColumnLayout {
+                                    spacing: 0
+                                    Label {
+                                        id: labelEliteRizerName
+                                        text: qsTr("Elite Rizer:")
+                                        Layout.fillWidth: true
+                                    }
+                                    RowLayout {
+                                        spacing: 10
+                                        ComboBox {
+                                            id: eliteRizerNameTextField
+                                            model: rootItem.bluetoothDevices
+                                            displayText: settings.elite_rizer_name
+                                            Layout.fillHeight: false
+                                            Layout.fillWidth: true
+                                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                            onActivated: {
+                                                console.log("combomodel activated" + eliteRizerNameTextField.currentIndex)
+                                                displayText = eliteRizerNameTextField.currentValue
                                             }
 
                                         }
@@ -10894,6 +11436,42 @@ import QtQuick.Dialogs 1.0
                                             onClicked: { settings.dircon_server_base_port = dirconServerPortTextField.text; toast.show("Setting saved!"); }
                                         }
                                     }
+
+                                    RowLayout {
+                                        spacing: 10
+                                        Label {
+                                            id: labelGymStations
+                                            text: qsTr("Gym stations:")
+                                            Layout.fillWidth: true
+                                        }
+                                        TextField {
+                                            id: gymStationsTextField
+                                            text: settings.gym_stations
+                                            horizontalAlignment: Text.AlignRight
+                                            Layout.fillHeight: false
+                                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                            onAccepted: settings.gym_stations = text
+                                        }
+                                        Button {
+                                            id: okGymStations
+                                            text: "OK"
+                                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                            onClicked: { settings.gym_stations = gymStationsTextField.text; toast.show("Setting saved!"); window.settings_restart_to_apply = true; }
+                                        }
+                                    }
+
+                                    Label {
+                                        text: qsTr("Gym mode: bridges several trainers from this device, each one with its own DirCon ports and name (from the port above, 4 ports per station), MQTT topics under QZ/<device id>/<station>/ and session file. Write the stations as name=type@address or name=type@address,workout file separated by ;, for example bike1=ftms@AA:BB:CC:DD:EE:01;bike2=kickr@AA:BB:CC:DD:EE:02,/sdcard/ftp.zwo. The types are ftms (any FTMS bike), kickr (Wahoo KICKR) and fakebike (a simulated bike, without address). On iOS the address is the UUID of the trainer. The trainers of the stations are left out of the device search of the app. Leave it empty to disable it.")
+                                        font.bold: true
+                                        font.italic: true
+                                        font.pixelSize: Qt.application.font.pixelSize - 2
+                                        textFormat: Text.PlainText
+                                        wrapMode: Text.WordWrap
+                                        verticalAlignment: Text.AlignVCenter
+                                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                                        Layout.fillWidth: true
+                                        color: Material.color(Material.Lime)
+                                    }
                                 }
                             }
                         }
@@ -11090,6 +11668,241 @@ import QtQuick.Dialogs 1.0
                         }
                     }               
 
+                    AccordionElement {
+                        id: influxdbAccordion
+                        title: qsTr("InfluxDB Settings")
+                        indicatRectColor: Material.color(Material.Grey)
+                        textColor: Material.color(Material.Yellow)
+                        color: Material.backgroundColor
+                        accordionContent: ColumnLayout {
+                            spacing: 0
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Write URL:")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: influxdbUrlTextField
+                                    text: settings.influxdb_url
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onAccepted: settings.influxdb_url = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.influxdb_url = influxdbUrlTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Token:")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: influxdbTokenTextField
+                                    text: settings.influxdb_token
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    echoMode: TextInput.Password
+                                    onAccepted: settings.influxdb_token = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.influxdb_token = influxdbTokenTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Measurement:")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: influxdbMeasurementTextField
+                                    text: settings.influxdb_measurement
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onAccepted: settings.influxdb_measurement = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.influxdb_measurement = influxdbMeasurementTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Points per batch:")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: influxdbBatchPointsTextField
+                                    text: settings.influxdb_batch_points
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    inputMethodHints: Qt.ImhDigitsOnly
+                                    onAccepted: settings.influxdb_batch_points = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.influxdb_batch_points = influxdbBatchPointsTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Batch interval (ms):")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: influxdbBatchMsTextField
+                                    text: settings.influxdb_batch_ms
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    inputMethodHints: Qt.ImhDigitsOnly
+                                    onAccepted: settings.influxdb_batch_ms = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.influxdb_batch_ms = influxdbBatchMsTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Offline buffer (KB):")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: influxdbSpoolTextField
+                                    text: settings.influxdb_spool_kb
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    inputMethodHints: Qt.ImhDigitsOnly
+                                    onAccepted: settings.influxdb_spool_kb = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.influxdb_spool_kb = influxdbSpoolTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            IndicatorOnlySwitch {
+                                text: qsTr("Compress with gzip")
+                                spacing: 0
+                                bottomPadding: 0
+                                topPadding: 0
+                                rightPadding: 0
+                                leftPadding: 0
+                                clip: false
+                                checked: settings.influxdb_gzip
+                                Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                                Layout.fillWidth: true
+                                onClicked: { settings.influxdb_gzip = checked; window.settings_restart_to_apply = true; }
+                            }
+
+                            Label {
+                                text: qsTr("Writes the workout every second to an InfluxDB server, in batches. The write URL is the full /write endpoint, for example http://192.168.1.2:8086/api/v2/write?org=home&bucket=qz for InfluxDB 2 or http://192.168.1.2:8086/write?db=qz for InfluxDB 1. The token is sent as Authorization: Token, leave it empty when the server doesn't need it. While the server can't be reached the batches are kept on this device, up to the offline buffer, and sent when it's back. Leave the URL empty to disable it.")
+                                font.bold: true
+                                font.italic: true
+                                font.pixelSize: Qt.application.font.pixelSize - 2
+                                textFormat: Text.PlainText
+                                wrapMode: Text.WordWrap
+                                verticalAlignment: Text.AlignVCenter
+                                Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                                Layout.fillWidth: true
+                                color: Material.color(Material.Lime)
+                            }
+                        }
+                    }
+
+                    AccordionElement {
+                        id: metricsAccordion
+                        title: qsTr("Metrics Endpoint")
+                        indicatRectColor: Material.color(Material.Grey)
+                        textColor: Material.color(Material.Yellow)
+                        color: Material.backgroundColor
+                        accordionContent: ColumnLayout {
+                            spacing: 0
+
+                            IndicatorOnlySwitch {
+                                text: qsTr("Enable /metrics endpoint")
+                                spacing: 0
+                                bottomPadding: 0
+                                topPadding: 0
+                                rightPadding: 0
+                                leftPadding: 0
+                                clip: false
+                                checked: settings.metrics_endpoint
+                                Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                                Layout.fillWidth: true
+                                onClicked: { settings.metrics_endpoint = checked; window.settings_restart_to_apply = true; }
+                            }
+
+                            RowLayout {
+                                spacing: 10
+                                Label {
+                                    text: qsTr("Metrics Port:")
+                                    Layout.fillWidth: true
+                                }
+                                TextField {
+                                    id: metricsPortTextField
+                                    text: settings.metrics_port
+                                    horizontalAlignment: Text.AlignRight
+                                    Layout.fillHeight: false
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    inputMethodHints: Qt.ImhDigitsOnly
+                                    onAccepted: settings.metrics_port = text
+                                    onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                                }
+                                Button {
+                                    text: "OK"
+                                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                                    onClicked: { settings.metrics_port = metricsPortTextField.text; window.settings_restart_to_apply = true; toast.show("Setting saved!"); }
+                                }
+                            }
+
+                            Label {
+                                text: qsTr("Exposes internal counters (BLE notifications, writes, reconnects, timer jitter, virtual device and template activity) in the OpenMetrics format at http://<ip>:<port>/metrics, ready to be scraped by Prometheus. Default: disabled, port 9180.")
+                                font.bold: true
+                                font.italic: true
+                                font.pixelSize: Qt.application.font.pixelSize - 2
+                                textFormat: Text.PlainText
+                                wrapMode: Text.WordWrap
+                                verticalAlignment: Text.AlignVCenter
+                                Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                                Layout.fillWidth: true
+                                color: Material.color(Material.Lime)
+                            }
+                        }
+                    }
+
                     AccordionElement {
                         id: oscAccordion
                         title: qsTr("OSC Settings")
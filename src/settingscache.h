@@ -0,0 +1,31 @@
+#ifndef SETTINGSCACHE_H
+#define SETTINGSCACHE_H
+
+#include <QElapsedTimer>
+
+/**
+ * @brief A value built from the settings for a hot path (every packet, every tick), kept instead of opening a
+ * QSettings each time. get() reads the settings again at most every refreshMs, so a change is picked up within a
+ * second. Meant as a static thread_local, since QSettings is not shared between threads.
+ */
+template <typename T> class SettingsCache {
+  public:
+    static const int refreshMs = 1000;
+
+    /**
+     * @param refresh called as refresh(value) when the value is older than refreshMs, to read the settings again
+     */
+    template <typename Refresh> const T &get(Refresh refresh) {
+        if (!age.isValid() || age.elapsed() >= refreshMs) {
+            refresh(value);
+            age.start();
+        }
+        return value;
+    }
+
+  private:
+    T value;
+    QElapsedTimer age;
+};
+
+#endif // SETTINGSCACHE_H
@@ -0,0 +1,178 @@
+#include "signalfilter.h"
+
+#include <QStringList>
+#include <math.h>
+
+namespace {
+
+// smoothing of the running mean and deviation the outlier stage compares the samples against
+const double outlierAlpha = 0.2;
+// samples always accepted by the outlier stage before its statistics mean anything
+const int outlierWarmup = 8;
+
+} // namespace
+
+double SignalFilter::apply(double sample, double deltaSeconds) {
+    if (!primed) {
+        primed = true;
+        last = sample;
+        spread = type == Kalman ? param[1] : 0;
+        if (type == Median) {
+            history[0] = sample;
+            historyCount = 1;
+            historyNext = 1 % (int)param[0];
+        } else if (type == Outlier) {
+            history[0] = 0;
+            historyCount = 1;
+        }
+        // the Kalman stage starts from the first sample as KalmanFilter does from its initial value
+        if (type != Kalman)
+            return sample;
+    }
+
+    switch (type) {
+    case Kalman: {
+        // param: measure error, estimate error, process noise
+        spread += param[2];
+        double gain = spread / (spread + param[0]);
+        last += gain * (sample - last);
+        spread *= (1 - gain);
+        return last;
+    }
+    case Ema:
+        last += param[0] * (sample - last);
+        return last;
+    case Median: {
+        int n = (int)param[0];
+        history[historyNext] = sample;
+        historyNext = (historyNext + 1) % n;
+        if (historyCount < n)
+            historyCount++;
+        double sorted[maxMedian];
+        for (int i = 0; i < historyCount; i++) {
+            double v = history[i];
+            int j = i;
+            for (; j > 0 && sorted[j - 1] > v; j--)
+                sorted[j] = sorted[j - 1];
+            sorted[j] = v;
+        }
+        if (historyCount % 2)
+            return sorted[historyCount / 2];
+        return (sorted[historyCount / 2 - 1] + sorted[historyCount / 2]) / 2.0;
+    }
+    case Slew: {
+        double step = param[0] * (deltaSeconds > 0 ? deltaSeconds : 0);
+        if (sample > last + step)
+            last += step;
+        else if (sample < last - step)
+            last -= step;
+        else
+            last = sample;
+        return last;
+    }
+    case Outlier: {
+        // last is the running mean, history[0] the rejections in a row, historyCount the samples seen
+        double distance = fabs(sample - last);
+        if (historyCount >= outlierWarmup && spread > 0 && distance > param[0] * spread &&
+            history[0] < param[1]) {
+            history[0]++;
+            return last;
+        }
+        if (history[0] >= param[1]) {
+            // the level really changed: follow it at once
+            last = sample;
+            spread = distance / param[0];
+        } else {
+            last += outlierAlpha * (sample - last);
+            spread += outlierAlpha * (distance - spread);
+        }
+        history[0] = 0;
+        if (historyCount < outlierWarmup)
+            historyCount++;
+        return sample;
+    }
+    case None:
+        break;
+    }
+    return sample;
+}
+
+void SignalFilter::reset() {
+    primed = false;
+    last = 0;
+    spread = 0;
+    historyCount = 0;
+    historyNext = 0;
+}
+
+bool SignalFilterChain::parse(const QString &spec) {
+    count = 0;
+    const QStringList items = spec.split(';', Qt::SkipEmptyParts);
+    if (items.size() > maxStages)
+        return false;
+
+    for (const QString &item : items) {
+        QString name = item.section(':', 0, 0).trimmed().toLower();
+        QStringList args = item.section(':', 1).split(',', Qt::SkipEmptyParts);
+        double values[3];
+        int valuesCount = 0;
+        for (const QString &a : args) {
+            bool ok = false;
+            double v = a.trimmed().toDouble(&ok);
+            if (!ok || valuesCount == 3) {
+                count = 0;
+                return false;
+            }
+            values[valuesCount++] = v;
+        }
+
+        SignalFilter f;
+        if (name == QStringLiteral("kalman")) {
+            f.type = SignalFilter::Kalman;
+            const double defaults[3] = {1, 0.01, 0.75};
+            for (int i = 0; i < 3; i++)
+                f.param[i] = i < valuesCount ? values[i] : defaults[i];
+            if (f.param[0] <= 0 || f.param[1] < 0 || f.param[2] < 0)
+                f.type = SignalFilter::None;
+        } else if (name == QStringLiteral("ema")) {
+            f.type = SignalFilter::Ema;
+            f.param[0] = valuesCount ? values[0] : 0.3;
+            if (f.param[0] <= 0 || f.param[0] > 1)
+                f.type = SignalFilter::None;
+        } else if (name == QStringLiteral("median")) {
+            f.type = SignalFilter::Median;
+            f.param[0] = valuesCount ? values[0] : 3;
+            if (f.param[0] < 2 || f.param[0] > SignalFilter::maxMedian || f.param[0] != floor(f.param[0]))
+                f.type = SignalFilter::None;
+        } else if (name == QStringLiteral("slew")) {
+            f.type = SignalFilter::Slew;
+            f.param[0] = valuesCount ? values[0] : 0;
+            if (f.param[0] <= 0)
+                f.type = SignalFilter::None;
+        } else if (name == QStringLiteral("outlier")) {
+            f.type = SignalFilter::Outlier;
+            f.param[0] = valuesCount ? values[0] : 4;
+            f.param[1] = valuesCount > 1 ? values[1] : 3;
+            if (f.param[0] <= 0 || f.param[1] < 1)
+                f.type = SignalFilter::None;
+        }
+
+        if (f.type == SignalFilter::None) {
+            count = 0;
+            return false;
+        }
+        stages[count++] = f;
+    }
+    return true;
+}
+
+double SignalFilterChain::apply(double sample, double deltaSeconds) {
+    for (int i = 0; i < count; i++)
+        sample = stages[i].apply(sample, deltaSeconds);
+    return sample;
+}
+
+void SignalFilterChain::reset() {
+    for (int i = 0; i < count; i++)
+        stages[i].reset();
+}
@@ -0,0 +1,67 @@
+#ifndef SIGNALFILTER_H
+#define SIGNALFILTER_H
+
+#include <QString>
+#include <type_traits>
+
+/**
+ * @brief One stage of a SignalFilterChain. Every stage is O(1) per sample and keeps its state inline.
+ */
+class SignalFilter {
+  public:
+    enum Type {
+        None,
+        Kalman,  // kalman:measureError,estimateError,processNoise - same model as KalmanFilter
+        Ema,     // ema:alpha - exponential moving average, alpha in (0, 1]
+        Median,  // median:n - median of the last n samples, n up to maxMedian
+        Slew,    // slew:rate - the output moves by at most rate units per second
+        Outlier, // outlier:k,n - drops samples farther than k mean absolute deviations, unless n in a row
+    };
+
+    static const int maxMedian = 9;
+
+    Type type = None;
+    double param[3] = {0, 0, 0};
+
+    double apply(double sample, double deltaSeconds);
+    void reset();
+
+  private:
+    bool primed = false;
+    double last = 0;
+    // Kalman: estimate error - Outlier: mean absolute deviation
+    double spread = 0;
+    // Median: ring of the last samples - Outlier: consecutive rejections in history[0]
+    double history[maxMedian] = {0};
+    int historyCount = 0;
+    int historyNext = 0;
+};
+
+/**
+ * @brief A chain of up to maxStages SignalFilter, applied in order. It holds no pointer, so it's copied
+ * with the metric that owns it and never allocates.
+ * The chain is described by a string like "outlier:4;median:3;kalman:1,0.01,0.75".
+ */
+class SignalFilterChain {
+  public:
+    static const int maxStages = 4;
+
+    /**
+     * @brief parse Replaces the stages with the ones described by spec.
+     * @return false if spec is not valid, the chain is then left empty
+     */
+    bool parse(const QString &spec);
+
+    double apply(double sample, double deltaSeconds);
+    void reset();
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+
+  private:
+    SignalFilter stages[maxStages];
+    int count = 0;
+};
+
+static_assert(std::is_trivially_copyable<SignalFilterChain>::value, "a filter chain must be copied without allocating");
+
+#endif // SIGNALFILTER_H
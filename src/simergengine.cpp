@@ -0,0 +1,81 @@
+#include "simergengine.h"
+#include "devices/bluetoothdevice.h"
+#include "qzsettings.h"
+
+#include <QDebug>
+#include <QSettings>
+#include <math.h>
+
+namespace {
+
+// requests closer than this to the last one are not sent
+const double minPowerStep = 3;
+const double minPowerStepRatio = 0.02;
+const double maxPower = 2000;
+
+} // namespace
+
+SimErgEngine::SimErgEngine(bluetoothdevice *device, QObject *parent) : QObject(parent), device(device) {
+    connect(&timer, &QTimer::timeout, this, [this]() {
+        if (roadClock.elapsed() > roadTimeoutMs) {
+            qDebug() << QStringLiteral("sim erg engine: no road for") << roadClock.elapsed() << QStringLiteral("ms");
+            stop();
+            return;
+        }
+        step(controlPeriodMs / 1000.0);
+    });
+}
+
+void SimErgEngine::setRoad(double grade, double crr, double cw) {
+    QSettings settings;
+    smoothingSeconds =
+        settings.value(QZSettings::zwift_sim_erg_smoothing, QZSettings::default_zwift_sim_erg_smoothing).toDouble();
+    this->grade = grade;
+    this->crr = crr;
+    this->cw = cw;
+    roadClock.start();
+    if (!timer.isActive()) {
+        qDebug() << QStringLiteral("sim erg engine started");
+        timer.start(controlPeriodMs);
+        step(0);
+    }
+}
+
+void SimErgEngine::stop() {
+    if (!timer.isActive())
+        return;
+    qDebug() << QStringLiteral("sim erg engine stopped");
+    timer.stop();
+    filtered = -1;
+    requested = -1;
+}
+
+double SimErgEngine::roadPower(const SpeedPowerModel::Parameters &base, double speed, double grade, double crr,
+                               double cw) {
+    SpeedPowerModel::Parameters p = base;
+    if (crr > 0)
+        p.crr = crr;
+    if (cw > 0)
+        p.aero = cw / 2.0;
+    return SpeedPowerModel(p).powerForSpeed(speed, grade);
+}
+
+double SimErgEngine::step(double deltaTimeSeconds) {
+    double speed = device->currentSpeed().value();
+    target = qBound(0.0, roadPower(SpeedPowerModel::fromSettings().parameters(), speed, grade, crr, cw), maxPower);
+
+    // first order low-pass: the speed of most bikes is noisy and the power goes with its cube
+    if (filtered < 0 || smoothingSeconds <= 0)
+        filtered = target;
+    else
+        filtered += (target - filtered) * deltaTimeSeconds / (smoothingSeconds + deltaTimeSeconds);
+
+    if (requested < 0 || fabs(filtered - requested) >= qMax(minPowerStep, requested * minPowerStepRatio)) {
+        requested = filtered;
+        requestCount++;
+        qDebug() << QStringLiteral("sim erg engine speed") << speed << QStringLiteral("grade") << grade
+                 << QStringLiteral("target") << target << QStringLiteral("requested") << requested;
+        device->changePower(qRound(requested));
+    }
+    return requested;
+}
@@ -0,0 +1,80 @@
+#ifndef SIMERGENGINE_H
+#define SIMERGENGINE_H
+
+#include "speedpowermodel.h"
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+class bluetoothdevice;
+
+/**
+ * @brief Turns the road of a simulation (grade, Crr, Cw) into a target power for a bike without a slope mode.
+ *
+ * Every controlPeriodMs the power needed to hold the current speed of the bike on that road, with the mass and
+ * the wind of the settings, is low-pass filtered and sent to the bike with changePower(): as a target power to an
+ * ERG bike, as the resistance of resistanceFromPowerRequest() (the learned resistance model, for the drivers that
+ * have one) otherwise. A new request is only sent when it differs enough from the last one, so the bike doesn't
+ * hunt around the target. The loop stops by itself when the app sends no road for roadTimeoutMs.
+ */
+class SimErgEngine : public QObject {
+    Q_OBJECT
+
+  public:
+    static const int controlPeriodMs = 250;
+    static const int defaultRoadTimeoutMs = 10000;
+
+    explicit SimErgEngine(bluetoothdevice *device, QObject *parent = nullptr);
+
+    /**
+     * @brief setRoad The road from now on, and starts the control loop if stopped.
+     * @param grade in percent
+     * @param crr rolling resistance coefficient, 0 to use the one of the settings
+     * @param cw wind resistance coefficient as sent by FTMS (air density * CdA) in kg/m, 0 to use the one of the
+     * settings
+     */
+    void setRoad(double grade, double crr, double cw);
+    void stop();
+    bool isActive() const { return timer.isActive(); }
+
+    /**
+     * @brief setRoadTimeout Stops the control loop when no road came for ms: the app stopped the simulation or went
+     * away without a target power.
+     */
+    void setRoadTimeout(int ms) { roadTimeoutMs = ms; }
+
+    /**
+     * @brief step One control step, deltaTimeSeconds after the previous one. Returns the power requested to the
+     * bike.
+     */
+    double step(double deltaTimeSeconds);
+
+    /**
+     * @brief targetPower The power of the road at the last step, before the smoothing.
+     */
+    double targetPower() const { return target; }
+    double requestedPower() const { return requested; }
+    int requests() const { return requestCount; }
+
+    /**
+     * @brief roadPower Power in watts to hold speed, km/h, on the road, with the other parameters from base.
+     */
+    static double roadPower(const SpeedPowerModel::Parameters &base, double speed, double grade, double crr,
+                            double cw);
+
+  private:
+    bluetoothdevice *device;
+    QTimer timer;
+    QElapsedTimer roadClock; // since the last setRoad
+    int roadTimeoutMs = defaultRoadTimeoutMs;
+    double grade = 0;
+    double crr = 0;
+    double cw = 0;
+    double smoothingSeconds = 2;
+    double target = 0;
+    double filtered = -1;
+    double requested = -1;
+    int requestCount = 0;
+};
+
+#endif // SIMERGENGINE_H
@@ -0,0 +1,59 @@
+#ifndef SNAPSHOTCHANNEL_H
+#define SNAPSHOTCHANNEL_H
+
+#include <atomic>
+
+/**
+ * @brief Hands the latest value of T from one producer thread to one consumer thread without locks (triple buffer).
+ * The producer never waits and the consumer always reads a complete value: values published between two reads of
+ * the consumer are dropped, only the last one is kept.
+ */
+template <typename T> class SnapshotChannel {
+  public:
+    /**
+     * @brief Producer side: the buffer to fill before calling publish(). It keeps whatever it held when it was
+     * handed back by the consumer, so the producer has to write the whole value.
+     */
+    T &back() { return buffers[backIndex]; }
+
+    /**
+     * @brief Producer side: makes the content of back() the latest value.
+     */
+    void publish() {
+        int previous = middle.exchange(backIndex | freshBit, std::memory_order_acq_rel);
+        backIndex = previous & indexMask;
+    }
+
+    void publish(const T &value) {
+        back() = value;
+        publish();
+    }
+
+    /**
+     * @brief Consumer side: moves the latest published value to front().
+     * @return true if a value was published since the previous call.
+     */
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & freshBit))
+            return false;
+        int previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & indexMask;
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: the value taken by the last update().
+     */
+    const T &front() const { return buffers[frontIndex]; }
+
+  private:
+    static const int indexMask = 3;
+    static const int freshBit = 4;
+
+    T buffers[3] = {};
+    int backIndex = 0;  // owned by the producer
+    int frontIndex = 1; // owned by the consumer
+    std::atomic<int> middle{2};
+};
+
+#endif // SNAPSHOTCHANNEL_H
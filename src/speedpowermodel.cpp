@@ -0,0 +1,165 @@
+#include "speedpowermodel.h"
+#include "qzsettings.h"
+#include "settingscache.h"
+
+#include <QSettings>
+#include <math.h>
+
+namespace {
+
+const double gravity = 9.8;
+// below this speed the force of the pedals is taken at this speed, F = P / v has no limit standing still
+const double minDriveSpeed = 1.0;
+// the integrator never takes a step longer than this, in seconds
+const double maxStep = 0.1;
+const int maxSteps = 100;
+
+// real roots of x^3 + b x^2 + c x + d, the largest in roots[0]
+int realRoots(double b, double c, double d, double roots[3]) {
+    // x = t - b / 3 gives t^3 + pt + q
+    double p = c - b * b / 3.0;
+    double q = 2.0 * b * b * b / 27.0 - b * c / 3.0 + d;
+    double shift = -b / 3.0;
+    double delta = q * q / 4.0 + p * p * p / 27.0;
+    if (delta > 0) {
+        double s = sqrt(delta);
+        roots[0] = cbrt(-q / 2.0 + s) + cbrt(-q / 2.0 - s) + shift;
+        return 1;
+    }
+    if (p == 0) {
+        roots[0] = cbrt(-q) + shift;
+        return 1;
+    }
+    // three real roots: r cos((acos(a) - 2 pi k) / 3), the largest has k = 0
+    double r = 2.0 * sqrt(-p / 3.0);
+    double a = 3.0 * q / (p * r);
+    if (a > 1)
+        a = 1;
+    else if (a < -1)
+        a = -1;
+    double theta = acos(a) / 3.0;
+    for (int k = 0; k < 3; k++)
+        roots[k] = r * cos(theta - 2.0 * M_PI * k / 3.0) + shift;
+    return 3;
+}
+
+} // namespace
+
+SpeedPowerModel::SpeedPowerModel() : SpeedPowerModel(Parameters()) {}
+
+SpeedPowerModel::SpeedPowerModel(const Parameters &parameters) : p(parameters) {
+    if (p.drafting < 0)
+        p.drafting = 0;
+    else if (p.drafting > 0.9)
+        p.drafting = 0.9;
+    if (p.mass <= 0)
+        p.mass = Parameters().mass;
+    aeroEff = p.aero * (1.0 - p.drafting);
+}
+
+SpeedPowerModel::Parameters SpeedPowerModel::parametersFromSettings() {
+    QSettings settings;
+    Parameters r;
+    r.mass = settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
+             settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat();
+    r.crr = settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toFloat();
+    r.windSpeed =
+        settings.value(QZSettings::virtual_speed_wind, QZSettings::default_virtual_speed_wind).toDouble() / 3.6;
+    r.drafting =
+        settings.value(QZSettings::virtual_speed_drafting, QZSettings::default_virtual_speed_drafting).toDouble() /
+        100.0;
+    r.speedGain = settings.value(QZSettings::speed_gain, QZSettings::default_speed_gain).toDouble();
+    r.speedOffset = settings.value(QZSettings::speed_offset, QZSettings::default_speed_offset).toDouble();
+    return r;
+}
+
+const SpeedPowerModel &SpeedPowerModel::fromSettings() {
+    static thread_local SettingsCache<SpeedPowerModel> cache;
+    return cache.get([](SpeedPowerModel &model) { model = SpeedPowerModel(parametersFromSettings()); });
+}
+
+double SpeedPowerModel::maxSpeed(double power, double inclination) const {
+    double tr = p.mass * gravity * ((inclination / 100.0) + p.crr);
+    double hw = p.windSpeed;
+    double drive = p.efficiency * power;
+    double v;
+
+    if (aeroEff <= 0) {
+        v = tr > 0 ? drive / tr : 0;
+    } else {
+        // v * (aero * (v + hw)^2 + tr) = efficiency * power, with the air pushing against the rider
+        double roots[3];
+        int n = realRoots(2.0 * hw, hw * hw + tr / aeroEff, -drive / aeroEff, roots);
+        v = roots[0];
+        if (v + hw < 0) {
+            // a tail wind faster than the rider pushes instead: the root is where the air still pushes
+            n = realRoots(2.0 * hw, hw * hw - tr / aeroEff, drive / aeroEff, roots);
+            v = 0;
+            for (int i = 0; i < n; i++)
+                if (roots[i] + hw <= 0 && roots[i] > v)
+                    v = roots[i];
+        }
+    }
+
+    if (!(v > 0))
+        return 0;
+    else if (v > 19) // 19 m/s == 70 km/h
+        return 70;
+    return v * 3.6;
+}
+
+double SpeedPowerModel::powerForSpeed(double speed, double inclination) const {
+    double v = speed / 3.6; // converted to m/s;
+    double tv = v + p.windSpeed;
+    double A2Eff = (tv > 0.0) ? aeroEff : -aeroEff; // wind in face, must reverse effect
+    double tr = p.mass * gravity * ((inclination / 100.0) + p.crr);
+    return (v * tr + v * tv * tv * A2Eff) / p.efficiency;
+}
+
+double SpeedPowerModel::force(double power, double resistance, double v) const {
+    double tv = v + p.windSpeed;
+    double drive = p.efficiency * power / (v > minDriveSpeed ? v : minDriveSpeed);
+    return drive - aeroEff * tv * fabs(tv) - resistance;
+}
+
+double SpeedPowerModel::nextSpeed(double power, double inclination, double speed, double deltaTimeSeconds,
+                                  double speedLimit) const {
+    double maxSpeed = this->maxSpeed(power, inclination);
+    double tr = p.mass * gravity * ((inclination / 100.0) + p.crr);
+
+    // midpoint steps of m dv/dt = F(v)
+    double v = speed / 3.6;
+    int steps = deltaTimeSeconds > 0 ? (int)ceil(deltaTimeSeconds / maxStep) : 0;
+    if (steps > maxSteps)
+        steps = maxSteps;
+    double h = steps ? deltaTimeSeconds / steps : 0;
+    for (int i = 0; i < steps; i++) {
+        double k1 = force(power, tr, v) / p.mass;
+        double mid = v + k1 * h / 2.0;
+        if (mid < 0)
+            mid = 0;
+        double k2 = force(power, tr, mid) / p.mass;
+        v += k2 * h;
+        if (v < 0)
+            v = 0;
+    }
+    double newSpeed = v * 3.6;
+
+    if (speedLimit > 0 && newSpeed > speedLimit)
+        newSpeed = speedLimit;
+    if (speedLimit > 0 && maxSpeed > speedLimit)
+        maxSpeed = speedLimit;
+    if (maxSpeed > newSpeed)
+        return newSpeed;
+    else if (maxSpeed < speed)
+        return newSpeed;
+    else
+        return maxSpeed;
+}
+
+double SpeedPowerModel::runningFlatSpeed(double speed, double inclination) {
+    // wattsCalc: 75 * (210 * speed / 60) * weight / 1000 on the flat, plus 9.8 * weight * inclination / 100
+    const double flatWattsPerKgKmh = 75.0 * 210.0 / 60.0 / 1000.0;
+    double s = speed + (gravity * inclination / 100.0) / flatWattsPerKgKmh;
+    return s > 0 ? s : 0;
+}
@@ -0,0 +1,64 @@
+#ifndef SPEEDPOWERMODEL_H
+#define SPEEDPOWERMODEL_H
+
+/**
+ * @brief Physics of a rider on a road, used to compute a virtual speed from the power of a bike.
+ * fromSettings() keeps the model of the settings instead of reading QSettings three times for every packet.
+ */
+class SpeedPowerModel {
+  public:
+    struct Parameters {
+        double mass = 75;                     // rider and bike, kg
+        double crr = 0.005;                   // rolling resistance coefficient
+        double aero = 0.22691607640851885;    // 0.5 * air density * CdA, kg/m
+        double efficiency = 0.95;             // drivetrain
+        double windSpeed = 0;                 // head wind in m/s, negative for tail wind
+        double drafting = 0;                  // share of the aerodynamic drag saved, 0 to 0.9
+        double speedGain = 1;                 // speed_gain, removed from the speed read back
+        double speedOffset = 0;               // speed_offset, removed from the speed read back
+    };
+
+    SpeedPowerModel();
+    explicit SpeedPowerModel(const Parameters &parameters);
+
+    /**
+     * @brief fromSettings The model of the current settings, kept in a SettingsCache.
+     */
+    static const SpeedPowerModel &fromSettings();
+    static Parameters parametersFromSettings();
+
+    const Parameters &parameters() const { return p; }
+
+    /**
+     * @brief maxSpeed Steady state speed in km/h for a power and a grade in percent: the largest real root of
+     * the power balance, a cubic in the speed solved in closed form. Capped at 70 km/h.
+     */
+    double maxSpeed(double power, double inclination) const;
+
+    /**
+     * @brief powerForSpeed Power in watts needed to hold a speed in km/h on a grade in percent.
+     */
+    double powerForSpeed(double speed, double inclination) const;
+
+    /**
+     * @brief nextSpeed Integrates the motion of the rider for deltaTimeSeconds from speed, km/h, and returns
+     * the new speed without overshooting maxSpeed. speedLimit caps the result when it's greater than 0.
+     */
+    double nextSpeed(double power, double inclination, double speed, double deltaTimeSeconds,
+                     double speedLimit) const;
+
+    /**
+     * @brief runningFlatSpeed Treadmill speed that needs on a flat belt the same running power, as computed by
+     * treadmill::wattsCalc, as speed on inclination: the weight cancels out, leaving a linear function.
+     */
+    static double runningFlatSpeed(double speed, double inclination);
+
+  private:
+    // net force pushing the rider forward at v m/s
+    double force(double power, double resistance, double v) const;
+
+    Parameters p;
+    double aeroEff;
+};
+
+#endif // SPEEDPOWERMODEL_H
@@ -1,5 +1,6 @@
 #include "templateinfosender.h"
 #include "qdebugfixup.h"
+#include "qzmetrics.h"
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -14,26 +15,143 @@ TemplateInfoSender::TemplateInfoSender(const QString &id, QObject *parent) : QOb
 
 TemplateInfoSender::~TemplateInfoSender() { stop(); }
 
+namespace {
+
+// the longest a template waits after script errors before being tried again, in ms
+const qint64 maxBackoffMs = 60000;
+
+// keywords starting a statement that is not an expression
+const char *const statementKeywords[] = {"let", "var", "const", "if", "for", "while", "do", "function",
+                                         "class", "return", "switch", "try", "throw", "break", "continue"};
+
+} // namespace
+
 bool TemplateInfoSender::init(const QString &script) {
     jscript = script;
+    function = QJSValue();
+    verified = false;
+    errors = 0;
+    nextUpdateMs = 0;
+    intervalMs = settings
+                     .value(QStringLiteral("template_") + templateId + QZSettings::template_interval_suffix,
+                            QZSettings::default_template_interval)
+                     .toInt();
+    if (intervalMs < 100)
+        intervalMs = 100;
+    clock.start();
     stop();
     return init();
 }
 
+QString TemplateInfoSender::functionBody(const QString &script) {
+    int end = script.length();
+    while (end > 0 && (script.at(end - 1).isSpace() || script.at(end - 1) == QLatin1Char(';')))
+        end--;
+
+    // start of the last top level statement: after a ; or a block closed at depth 0
+    int depth = 0;
+    int lastStart = 0;
+    for (int i = 0; i < end; i++) {
+        QChar c = script.at(i);
+        QChar next = i + 1 < end ? script.at(i + 1) : QChar();
+        if (c == QLatin1Char('"') || c == QLatin1Char('\'') || c == QLatin1Char('`')) {
+            for (i++; i < end && script.at(i) != c; i++)
+                if (script.at(i) == QLatin1Char('\\'))
+                    i++;
+        } else if (c == QLatin1Char('/') && next == QLatin1Char('/')) {
+            while (i < end && script.at(i) != QLatin1Char('\n'))
+                i++;
+        } else if (c == QLatin1Char('/') && next == QLatin1Char('*')) {
+            int close = script.indexOf(QStringLiteral("*/"), i + 2);
+            i = close < 0 ? end : close + 1;
+        } else if (c == QLatin1Char('(') || c == QLatin1Char('[') || c == QLatin1Char('{')) {
+            depth++;
+        } else if (c == QLatin1Char(')') || c == QLatin1Char(']') || c == QLatin1Char('}')) {
+            depth--;
+            if (depth == 0 && c == QLatin1Char('}'))
+                lastStart = i + 1;
+        } else if (c == QLatin1Char(';') && depth == 0) {
+            lastStart = i + 1;
+        }
+    }
+    if (depth != 0 || lastStart >= end)
+        return QString();
+
+    QString last = script.mid(lastStart, end - lastStart).trimmed();
+    if (last.isEmpty() || last.startsWith(QLatin1String("//")) || last.startsWith(QLatin1String("/*")))
+        return QString();
+    for (const char *keyword : statementKeywords) {
+        QLatin1String k(keyword);
+        if (last.startsWith(k) && (last.length() == k.size() || !last.at(k.size()).isLetterOrNumber()))
+            return QString();
+    }
+    // the parentheses keep a line break after return from ending the statement
+    return script.left(lastStart) + QStringLiteral("\nreturn (\n") + last + QStringLiteral("\n);");
+}
+
+void TemplateInfoSender::compile(QJSEngine *eng) {
+    function = QJSValue();
+    verified = false;
+    QString body = functionBody(jscript);
+    if (body.isEmpty()) {
+        qDebug() << QStringLiteral("Template") << templateId << QStringLiteral("evaluated at every update");
+        return;
+    }
+    QJSValue f = eng->evaluate(QStringLiteral("(function() {\n") + body + QStringLiteral("\n})"));
+    if (f.isCallable())
+        function = f;
+    else
+        qDebug() << QStringLiteral("Template") << templateId << QStringLiteral("can't be compiled:") << f.toString();
+}
+
+bool TemplateInfoSender::due() const { return !clock.isValid() || clock.elapsed() >= nextUpdateMs; }
+
+QJSValue TemplateInfoSender::evaluate(QJSEngine *eng) {
+    if (function.isCallable()) {
+        // the script runs once per update: the first call is checked on its own result, not against a second run
+        QJSValue jsv = function.callWithInstance(eng->globalObject());
+        if (!verified) {
+            verified = true;
+            if (jsv.isError()) {
+                qDebug() << QStringLiteral("Template") << templateId
+                         << QStringLiteral("compiled fails, evaluated from the next update");
+                function = QJSValue();
+            }
+        }
+        return jsv;
+    }
+    return eng->evaluate(jscript);
+}
+
+void TemplateInfoSender::scriptError(const QJSValue &jsv) {
+#if (QT_VERSION < QT_VERSION_CHECK(5, 12, 0))
+    int errorType = 255;
+#else
+    int errorType = jsv.errorType();
+#endif
+    errors++;
+    qint64 backoff = (qint64)intervalMs << qMin(errors, 16);
+    if (backoff > maxBackoffMs)
+        backoff = maxBackoffMs;
+    nextUpdateMs = clock.elapsed() + backoff;
+    qDebug() << QStringLiteral("Scripts contains an error:") << jscript << QStringLiteral("error") << errorType
+             << jsv.toString() << QStringLiteral("next try in") << backoff << QStringLiteral("ms");
+    QZMetrics::increment(QZMetrics::TemplateUpdateErrors);
+}
+
 bool TemplateInfoSender::update(QJSEngine *eng) {
     if (!jscript.isEmpty()) {
-        QJSValue jsv = eng->evaluate(jscript);
+        qint64 started = QZMetrics::monotonicNs();
+        QJSValue jsv = evaluate(eng);
+        QZMetrics::observeSince(QZMetrics::TemplateUpdateDuration, started);
         if (!jsv.isError()) {
+            errors = 0;
+            nextUpdateMs = clock.elapsed() + intervalMs;
             QString evalres = jsv.toString();
             qDebug() << QStringLiteral("eval res ") << evalres;
             return send(evalres);
         } else {
-#if (QT_VERSION < QT_VERSION_CHECK(5, 12, 0))
-            int errorType = 255;
-#else
-            int errorType = jsv.errorType();
-#endif
-            qDebug() << QStringLiteral("Scripts contains an error:") << jscript << QStringLiteral("error") << errorType;
+            scriptError(jsv);
             return false;
         }
     } else {
@@ -1,10 +1,14 @@
 #ifndef TEMPLATEINFOSENDER_H
 #define TEMPLATEINFOSENDER_H
+#include <QElapsedTimer>
 #include <QJSEngine>
+#include <QJSValue>
 #include <QObject>
 #include <QSettings>
 #include <QTimer>
 
+#include "qzsettings.h"
+
 class TemplateInfoSender : public QObject {
     Q_OBJECT
   public:
@@ -14,9 +18,30 @@ class TemplateInfoSender : public QObject {
     virtual bool send(const QString &data) = 0;
     bool init(const QString &script);
     void stop();
+
+    /**
+     * @brief compile Turns the script into a function of the engine, called by update() instead of evaluating
+     * the source every time. A script whose value can't be returned by a function keeps being evaluated, and so
+     * does one whose function fails at its first call.
+     */
+    void compile(QJSEngine *eng);
+
+    /**
+     * @brief due Whether the template has to be updated now: its template_<id>_interval setting (ms, 1000 by
+     * default) has elapsed and it's not backing off after a script error.
+     */
+    bool due() const;
+    int interval() const { return intervalMs; }
+
     bool update(QJSEngine *eng);
     QString js() const;
     QString getId() const;
+
+    /**
+     * @brief functionBody The script as the body of a function returning the value of its last statement,
+     * empty if the last statement is not an expression.
+     */
+    static QString functionBody(const QString &script);
   signals:
     void onDataReceived(QByteArray data);
 
@@ -30,7 +55,16 @@ class TemplateInfoSender : public QObject {
     void reinit();
 
   private:
+    QJSValue evaluate(QJSEngine *eng);
+    void scriptError(const QJSValue &jsv);
+
     QTimer retryTimer;
+    QJSValue function;
+    bool verified = false; // the first call of the function has been checked
+    int intervalMs = QZSettings::default_template_interval;
+    int errors = 0;       // consecutive script errors, each one doubles the wait before the next update
+    qint64 nextUpdateMs = 0;
+    QElapsedTimer clock;
 };
 
 #endif // TEMPLATEINFOSENDER_H
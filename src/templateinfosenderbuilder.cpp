@@ -12,7 +12,11 @@
 #ifdef Q_HTTPSERVER
 #include "webserverinfosender.h"
 #endif
+#include "activityhistory.h"
+#include "appdirs.h"
+#include "ghostrider.h"
 #include "homeform.h"
+#include "sensorfusion.h"
 #include "tcpclientinfosender.h"
 #include "trainprogram.h"
 #include <chrono>
@@ -64,13 +68,19 @@ TemplateInfoSenderBuilder::TemplateInfoSenderBuilder(QObject *parent) : QObject(
 TemplateInfoSenderBuilder::~TemplateInfoSenderBuilder() { stop(); }
 
 void TemplateInfoSenderBuilder::onUpdateTimeout() {
+    QList<TemplateInfoSender *> due;
+    for (TemplateInfoSender *sender : qAsConst(templateInfoMap))
+        if (sender->due())
+            due.append(sender);
+    if (due.isEmpty())
+        return;
+
     buildContext();
-    QHash<QString, TemplateInfoSender *>::Iterator it;
     bool rv;
-    for (it = templateInfoMap.begin(); it != templateInfoMap.end(); it++) {
-        rv = it.value()->update(engine);
+    for (TemplateInfoSender *sender : qAsConst(due)) {
+        rv = sender->update(engine);
         if (!rv) {
-            qDebug() << QStringLiteral("Error updating") << it.key() << QStringLiteral("template");
+            qDebug() << QStringLiteral("Error updating") << sender->getId() << QStringLiteral("template");
         }
     }
 }
@@ -157,7 +167,9 @@ void TemplateInfoSenderBuilder::load(const QString &idInfo, const QStringList &f
     stop();
     masterId = idInfo;
     foldersToLook = folders;
+    qDeleteAll(templateInfoMap);
     templateInfoMap.clear();
+    QZMetrics::setGauge(QZMetrics::TemplateSenders, 0);
     templateFilesList.clear();
     QStringList globalIdList, globalFolderList;
     int startIdIndex = 0;
@@ -221,7 +233,9 @@ TemplateInfoSender *TemplateInfoSenderBuilder::newTemplate(const QString &id, co
         qDebug() << QStringLiteral("Template Registered") << id << QStringLiteral(" type") << tp
                  << QStringLiteral(" Template") << dataTempl;
         templateInfoMap.insert(id, tempInfo);
+        QZMetrics::setGauge(QZMetrics::TemplateSenders, templateInfoMap.size());
         tempInfo->init(dataTempl);
+        tempInfo->compile(engine);
         connect(tempInfo, &TemplateInfoSender::onDataReceived, this, &TemplateInfoSenderBuilder::onDataReceived);
     }
     return tempInfo;
@@ -242,7 +256,11 @@ void TemplateInfoSenderBuilder::start(bluetoothdevice *dev) {
     buildContext(true);
     device = dev;
     activityDescription = QLatin1String("");
-    updateTimer.start(1s);
+    // ticks as often as the fastest template, each one is updated at its own interval
+    int interval = 1000;
+    for (TemplateInfoSender *sender : qAsConst(templateInfoMap))
+        interval = qMin(interval, sender->interval());
+    updateTimer.start(interval);
 }
 
 QStringList TemplateInfoSenderBuilder::templateIdList() const { return templateFilesList.keys(); }
@@ -446,7 +464,7 @@ void TemplateInfoSenderBuilder::onLoadTrainingPrograms(const QJsonValue &msgCont
     QJsonObject outObj;
     QString fileXml;
     if ((fileXml = msgContent.toString()).isEmpty()) {
-        QDirIterator it(homeform::getWritableAppDir() + QStringLiteral("training"));
+        QDirIterator it(AppDirs::writable() + QStringLiteral("training"));
         QString fileName, filePath;
         QFileInfo fileInfo;
         while (it.hasNext()) {
@@ -458,7 +476,7 @@ void TemplateInfoSenderBuilder::onLoadTrainingPrograms(const QJsonValue &msgCont
             }
         }
     } else {
-        QList<trainrow> lst = trainprogram::loadXML(homeform::getWritableAppDir() + QStringLiteral("training/") +
+        QList<trainrow> lst = trainprogram::loadXML(AppDirs::writable() + QStringLiteral("training/") +
                                                         fileXml + QStringLiteral(".xml"), (device ? device->deviceType() : bluetoothdevice::BIKE ));
         for (auto &row : lst) {
             QJsonObject item;
@@ -524,6 +542,32 @@ void TemplateInfoSenderBuilder::onGetSessionArray(TemplateInfoSender *tempSender
     tempSender->send(out.toJson());
 }
 
+void TemplateInfoSenderBuilder::onGetChartSeries(const QJsonValue &msgContent, TemplateInfoSender *tempSender) {
+    QJsonObject content = msgContent.toObject();
+    QString metric = content[QStringLiteral("metric")].toString();
+    // a live chart needs about one point per pixel
+    int maxPoints = qBound(1, content[QStringLiteral("maxPoints")].toInt(300), 5000);
+    QJsonArray points;
+    if (homeform::singleton()) {
+        const QVector<QPointF> series = homeform::singleton()->workout_chart_points(
+            metric, content[QStringLiteral("from")].toInt(), std::numeric_limits<int>::max(), maxPoints);
+        for (const QPointF &p : series) {
+            QJsonObject point;
+            point[QStringLiteral("x")] = p.x();
+            point[QStringLiteral("y")] = p.y();
+            points.append(point);
+        }
+    }
+    QJsonObject out;
+    out[QStringLiteral("metric")] = metric;
+    out[QStringLiteral("points")] = points;
+    QJsonObject main;
+    main[QStringLiteral("content")] = out;
+    main[QStringLiteral("msg")] = QStringLiteral("R_getchartseries");
+    QJsonDocument doc(main);
+    tempSender->send(doc.toJson());
+}
+
 void TemplateInfoSenderBuilder::onGetGPXBase64(TemplateInfoSender *tempSender) {
     if (!device)
         return;
@@ -649,7 +693,7 @@ void TemplateInfoSenderBuilder::onSaveTrainingProgram(const QJsonValue &msgConte
         }
     }
     QJsonObject main, outObj;
-    QString trainingDir(homeform::getWritableAppDir() + QStringLiteral("training/"));
+    QString trainingDir(AppDirs::writable() + QStringLiteral("training/"));
     QDir dir(trainingDir);
     if (!dir.exists()) {
         dir.mkpath(QStringLiteral("."));
@@ -756,7 +800,7 @@ void TemplateInfoSenderBuilder::onSaveChart(const QJsonValue &msgContent, Templa
         (image = content.value(QStringLiteral("image")).toString()).isEmpty()) {
         return;
     }
-    QString path = homeform::getWritableAppDir();
+    QString path = AppDirs::writable();
     QJsonObject main, outObj;
     QString filenameScreenshot =
         path + QDateTime::currentDateTime().toString().replace(QStringLiteral(":"), QStringLiteral("_")) +
@@ -879,6 +923,9 @@ void TemplateInfoSenderBuilder::onDataReceived(const QByteArray &data) {
                 } else if (msg == QStringLiteral("getsessionarray")) {
                     onGetSessionArray(sender);
                     return;
+                } else if (msg == QStringLiteral("getchartseries")) {
+                    onGetChartSeries(jsonObject[QStringLiteral("content")], sender);
+                    return;
                 }
                 if (msg == QStringLiteral("start")) {
                     onStart(sender);
@@ -1027,6 +1074,35 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
         obj.setProperty(QStringLiteral("longitude"), device->currentCordinate().longitude());
         obj.setProperty(QStringLiteral("altitude"), device->currentCordinate().altitude());
         obj.setProperty(QStringLiteral("peloton_offset"), pelotonOffset());
+        GhostRider::Gap ghostGap = GhostRider::instance()->gap(device);
+        obj.setProperty(QStringLiteral("ghost_loaded"), ghostGap.valid);
+        obj.setProperty(QStringLiteral("ghost_name"), GhostRider::instance()->name());
+        obj.setProperty(QStringLiteral("ghost_time_gap"), ghostGap.valid ? ghostGap.seconds : QJSValue());
+        obj.setProperty(QStringLiteral("ghost_distance_gap"), ghostGap.valid ? ghostGap.meters : QJSValue());
+        obj.setProperty(QStringLiteral("ghost_power_delta"), ghostGap.valid ? ghostGap.watts : QJSValue());
+        ActivityHistory *history = ActivityHistory::instance();
+        obj.setProperty(QStringLiteral("history_activities"), history->count());
+        obj.setProperty(QStringLiteral("history_best_power_5m_90d"), history->bestPower(300, 90));
+        obj.setProperty(QStringLiteral("history_best_power_20m_90d"), history->bestPower(1200, 90));
+        obj.setProperty(QStringLiteral("history_tss_7d"), history->tss(7));
+        obj.setProperty(QStringLiteral("history_tss_week"), history->weeklyTss(1).value(0).toDouble());
+        const TrainingLoad &load = homeform::singleton()->trainingLoad;
+        obj.setProperty(QStringLiteral("normalized_power"), load.normalizedPower());
+        obj.setProperty(QStringLiteral("intensity_factor"), load.intensityFactor());
+        obj.setProperty(QStringLiteral("tss"), load.tss());
+        obj.setProperty(QStringLiteral("wbal"), load.wPrimeBalance());
+        obj.setProperty(QStringLiteral("wbal_min"), load.wPrimeBalanceMin());
+        QJSValue powerZones = engine->newArray(TrainingLoad::powerZoneCount);
+        for (int i = 0; i < TrainingLoad::powerZoneCount; i++)
+            powerZones.setProperty(i, load.powerZoneSeconds(i));
+        obj.setProperty(QStringLiteral("time_in_power_zone"), powerZones);
+        QJSValue heartZones = engine->newArray(TrainingLoad::heartZoneCount);
+        for (int i = 0; i < TrainingLoad::heartZoneCount; i++)
+            heartZones.setProperty(i, load.heartZoneSeconds(i));
+        obj.setProperty(QStringLiteral("time_in_heart_zone"), heartZones);
+        obj.setProperty(QStringLiteral("sensors"), device->hasSensorFusion()
+                                                       ? engine->toScriptValue(device->sensorFusion()->healthList())
+                                                       : engine->newArray(0));
         obj.setProperty(QStringLiteral("peloton_ask_start"), pelotonAskStart());
         obj.setProperty(QStringLiteral("autoresistance"), homeform::singleton()->autoResistance());
         obj.setProperty(QStringLiteral("nextrow"), homeform::singleton()->nextRows->value());
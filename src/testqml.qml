@@ -28,6 +28,7 @@ ApplicationWindow {
     signal largeButton_clicked(string name)
 
     signal gpx_open_clicked(url name)
+    signal ghost_open_clicked(url name)
     signal gpxpreview_open_clicked(url name)
     signal profile_open_clicked(url name)
     signal trainprogram_open_clicked(url name)
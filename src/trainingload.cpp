@@ -0,0 +1,113 @@
+#include "trainingload.h"
+#include "metric.h"
+#include "qzsettings.h"
+
+#include <QSettings>
+#include <math.h>
+
+namespace {
+
+// the upper bounds of the first 6 power zones, percent of the FTP
+const double powerZoneBounds[] = {56, 76, 91, 106, 121, 151};
+
+} // namespace
+
+TrainingLoad::Parameters TrainingLoad::Parameters::fromSettings() {
+    QSettings settings;
+    Parameters p;
+    p.ftp = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+    p.criticalPower = settings.value(QZSettings::critical_power, QZSettings::default_critical_power).toDouble();
+    p.wPrime = settings.value(QZSettings::w_prime, QZSettings::default_w_prime).toDouble();
+    p.maxHeart = metric::heartRateMax();
+    p.heartZones[0] = settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble();
+    p.heartZones[1] = settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble();
+    p.heartZones[2] = settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble();
+    p.heartZones[3] = settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble();
+    return p;
+}
+
+int TrainingLoad::Parameters::powerZone(double watts) const {
+    double perc = ftp > 0 ? watts / ftp * 100.0 : 0;
+    for (int i = 0; i < powerZoneCount - 1; i++)
+        if (perc < powerZoneBounds[i])
+            return i;
+    return powerZoneCount - 1;
+}
+
+int TrainingLoad::Parameters::heartZone(double heart) const {
+    double perc = maxHeart > 0 ? heart / maxHeart * 100.0 : 0;
+    for (int i = 0; i < heartZoneCount - 1; i++)
+        if (perc < heartZones[i])
+            return i;
+    return heartZoneCount - 1;
+}
+
+TrainingLoad::TrainingLoad(const Parameters &parameters) { reset(parameters); }
+
+void TrainingLoad::reset(const Parameters &parameters) {
+    p = parameters;
+    for (int i = 0; i < window; i++)
+        ring[i] = 0;
+    ringPos = 0;
+    ringSum = 0;
+    samples = 0;
+    wattSum = 0;
+    fourthSum = 0;
+    wbal = wbalMin = p.wPrime;
+    for (int i = 0; i < powerZoneCount; i++)
+        powerZones[i] = 0;
+    for (int i = 0; i < heartZoneCount; i++)
+        heartZones[i] = 0;
+    lastPowerZone = 0;
+    lastPowerZoneSeconds = 0;
+}
+
+void TrainingLoad::addSample(double watts, double heart) {
+    if (!std::isfinite(watts) || watts < 0)
+        watts = 0;
+
+    ringSum += watts - ring[ringPos];
+    ring[ringPos] = watts;
+    ringPos = (ringPos + 1) % window;
+    // once a turn, so that the rounding errors of the running sum don't pile up over hours
+    if (ringPos == 0) {
+        ringSum = 0;
+        for (int i = 0; i < window; i++)
+            ringSum += ring[i];
+    }
+    samples++;
+    wattSum += watts;
+    if (samples >= window)
+        fourthSum += pow(qMax(0.0, ringSum) / window, 4);
+
+    double cp = p.cp();
+    if (watts < cp) {
+        if (p.wPrime > 0)
+            wbal += (cp - watts) * (p.wPrime - wbal) / p.wPrime;
+    } else {
+        wbal -= watts - cp;
+    }
+    wbalMin = qMin(wbalMin, wbal);
+
+    int zone = p.powerZone(watts);
+    powerZones[zone]++;
+    lastPowerZoneSeconds = zone == lastPowerZone && samples > 1 ? lastPowerZoneSeconds + 1 : 1;
+    lastPowerZone = zone;
+    if (heart > 0 && std::isfinite(heart))
+        heartZones[p.heartZone(heart)]++;
+}
+
+double TrainingLoad::normalizedPower() const {
+    if (samples < window)
+        return averagePower();
+    return pow(fourthSum / (samples - window + 1), 0.25);
+}
+
+double TrainingLoad::intensityFactor() const { return p.ftp > 0 ? normalizedPower() / p.ftp : 0; }
+
+double TrainingLoad::tss() const {
+    if (p.ftp <= 0)
+        return 0;
+    double np = normalizedPower();
+    return samples * np * intensityFactor() / (p.ftp * 3600.0) * 100.0;
+}
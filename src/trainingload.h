@@ -0,0 +1,100 @@
+#ifndef TRAININGLOAD_H
+#define TRAININGLOAD_H
+
+#include <QtGlobal>
+
+/**
+ * @brief The training load of a session, updated at every sample of one second: Normalized Power, Intensity
+ * Factor, TSS, W' balance and the time in the power and heart rate zones.
+ *
+ * Normalized Power is the fourth power mean of the 30 seconds rolling average of the power, kept with a ring of
+ * the last 30 samples and a running sum. W' balance follows the differential model of Skiba: spent above the
+ * critical power, recovered below it in proportion to what is missing. Every sample is O(1), whatever the length
+ * of the session.
+ */
+class TrainingLoad {
+  public:
+    static const int window = 30; // seconds of the rolling average of Normalized Power
+    static const int powerZoneCount = 7;
+    static const int heartZoneCount = 5;
+
+    struct Parameters {
+        double ftp = 200;
+        double criticalPower = 0; // watts, 0 to use the FTP
+        double wPrime = 20000;    // joules
+        double maxHeart = 190;
+        double heartZones[4] = {70, 80, 90, 100}; // upper bounds of the first 4 zones, percent of maxHeart
+
+        /**
+         * @brief fromSettings The FTP, critical power, W', max heart rate and heart rate zones of the settings.
+         */
+        static Parameters fromSettings();
+
+        double cp() const { return criticalPower > 0 ? criticalPower : ftp; }
+
+        /**
+         * @brief powerZone The Coggan zone of watts, 0 to 6.
+         */
+        int powerZone(double watts) const;
+
+        /**
+         * @brief heartZone The zone of a heart rate, 0 to 4.
+         */
+        int heartZone(double heart) const;
+    };
+
+    explicit TrainingLoad(const Parameters &parameters = Parameters());
+
+    /**
+     * @brief reset Starts a new session with parameters.
+     */
+    void reset(const Parameters &parameters);
+    const Parameters &parameters() const { return p; }
+
+    /**
+     * @brief addSample One second of the session. A heart rate of 0 is no heart rate sensor.
+     */
+    void addSample(double watts, double heart);
+
+    int seconds() const { return samples; }
+    double averagePower() const { return samples ? wattSum / samples : 0; }
+
+    /**
+     * @brief normalizedPower The average power before the first 30 seconds.
+     */
+    double normalizedPower() const;
+    double intensityFactor() const;
+    double tss() const;
+
+    /**
+     * @brief wPrimeBalance The W' left, in joules.
+     */
+    double wPrimeBalance() const { return wbal; }
+    double wPrimeBalanceMin() const { return wbalMin; }
+
+    quint32 powerZoneSeconds(int zone) const { return powerZones[zone]; }
+    quint32 heartZoneSeconds(int zone) const { return heartZones[zone]; }
+    int currentPowerZone() const { return lastPowerZone; }
+
+    /**
+     * @brief currentPowerZoneSeconds For how long the power has been in the zone it's in now.
+     */
+    quint32 currentPowerZoneSeconds() const { return lastPowerZoneSeconds; }
+
+  private:
+    Parameters p;
+    double ring[window];
+    int ringPos = 0;
+    double ringSum = 0;
+    int samples = 0;
+    double wattSum = 0;
+    double fourthSum = 0;
+    double wbal = 0;
+    double wbalMin = 0;
+    quint32 powerZones[powerZoneCount];
+    quint32 heartZones[heartZoneCount];
+    int lastPowerZone = 0;
+    quint32 lastPowerZoneSeconds = 0;
+};
+
+#endif // TRAININGLOAD_H
@@ -334,10 +334,10 @@ double trainprogram::TimeRateFromGPX(double gpxsecs, double videosecs, double cu
 
     // set the maximum Speed that the player can reached based on the Video speed.
     // if Rate get too high the Video jumps
-    if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE) {
+    if (device()->deviceType() == bluetoothdevice::BIKE) {
         double avgSpeedForLimit = avgSpeedFromGpxStep(currentStep + 1, 5);
         if (avgSpeedForLimit > 0.0) {
-            bike *dev = (bike *)bluetoothManager->device();
+            bike *dev = (bike *)device();
             // bepo70: Replay allows Factor 2 max, so set the speed Limit to 2 * Video recording Factor speed to
             //         avoid any jumps in Video
             dev->setSpeedLimit(avgSpeedForLimit * (double)recordingFactor * 2.0 / 3.0);
@@ -586,6 +586,7 @@ void trainprogram::scheduler() {
 
     QMutexLocker(&this->schedulerMutex);
     QSettings settings;
+    schedulerTimerProbe.tick(QZMetrics::TrainProgramSchedulerJitter);
     // outside the if case about a valid train program because the information for the floating window url should be
     // sent anyway
     if (settings.value(QZSettings::peloton_companion_workout_ocr, QZSettings::default_companion_peloton_workout_ocr)
@@ -599,12 +600,12 @@ void trainprogram::scheduler() {
         }
     }
 
-    if (rows.count() == 0 || started == false || enabled == false || bluetoothManager->device() == nullptr ||
-        (bluetoothManager->device()->currentSpeed().value() <= 0 &&
+    if (rows.count() == 0 || started == false || enabled == false || device() == nullptr ||
+        (device()->currentSpeed().value() <= 0 &&
          !settings.value(QZSettings::continuous_moving, QZSettings::default_continuous_moving).toBool()) ||
-        bluetoothManager->device()->isPaused()) {
+        device()->isPaused()) {
         
-        if(bluetoothManager->device() && (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL || bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL) &&
+        if(device() && (device()->deviceType() == bluetoothdevice::TREADMILL || device()->deviceType() == bluetoothdevice::ELLIPTICAL) &&
            settings.value(QZSettings::zwift_username, QZSettings::default_zwift_username).toString().length() > 0 && zwift_auth_token &&
            zwift_auth_token->access_token.length() > 0) {
             if(!zwift_world) {
@@ -698,18 +699,18 @@ void trainprogram::scheduler() {
                                 bool zwift_api_autoinclination = settings.value(QZSettings::zwift_api_autoinclination, QZSettings::default_zwift_api_autoinclination).toBool();
                                 qDebug() << "zwift api incline" << incline << grade << delta << deltaA << zwift_api_autoinclination;
                                 if(zwift_api_autoinclination) {
-                                    if(bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL || 
-                                        (bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL && ((elliptical*)bluetoothManager->device())->inclinationAvailableByHardware())) {
-                                        bluetoothManager->device()->changeInclination(grade, grade);
+                                    if(device()->deviceType() == bluetoothdevice::TREADMILL || 
+                                        (device()->deviceType() == bluetoothdevice::ELLIPTICAL && ((elliptical*)device())->inclinationAvailableByHardware())) {
+                                        device()->changeInclination(grade, grade);
                                     }
-                                    if (bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL &&
-                                            (!((elliptical*)bluetoothManager->device())->inclinationAvailableByHardware() ||
-                                             ((elliptical*)bluetoothManager->device())->inclinationSeparatedFromResistance())) {
+                                    if (device()->deviceType() == bluetoothdevice::ELLIPTICAL &&
+                                            (!((elliptical*)device())->inclinationAvailableByHardware() ||
+                                             ((elliptical*)device())->inclinationSeparatedFromResistance())) {
                                         QSettings settings;
                                         double bikeResistanceOffset = settings.value(QZSettings::bike_resistance_offset, bikeResistanceOffset).toInt();
                                         double bikeResistanceGain = settings.value(QZSettings::bike_resistance_gain_f, bikeResistanceGain).toDouble();
 
-                                        bluetoothManager->device()->changeResistance((resistance_t)(round(grade * bikeResistanceGain)) + bikeResistanceOffset + 1); // resistance start from 1
+                                        device()->changeResistance((resistance_t)(round(grade * bikeResistanceGain)) + bikeResistanceOffset + 1); // resistance start from 1
                                     }
                                 }
                             }
@@ -725,9 +726,9 @@ void trainprogram::scheduler() {
         // Zwift OCR
         if ((settings.value(QZSettings::zwift_ocr, QZSettings::default_zwift_ocr).toBool() ||
              settings.value(QZSettings::zwift_ocr_climb_portal, QZSettings::default_zwift_ocr_climb_portal).toBool()) &&
-            bluetoothManager && bluetoothManager->device() &&
-            (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL ||
-             bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL)) {
+            device() &&
+            (device()->deviceType() == bluetoothdevice::TREADMILL ||
+             device()->deviceType() == bluetoothdevice::ELLIPTICAL)) {
 
 #ifdef Q_OS_ANDROID
             {
@@ -767,7 +768,7 @@ void trainprogram::scheduler() {
                                     ss[0] = ss[0].replace("l", "1");
                                     ss[0] = ss[0].replace(" ", "");
                                     if (ss[0].toInt() < 15 && ss[0].toInt() > -15) {
-                                        bluetoothManager->device()->changeInclination(ss[0].toInt(), ss[0].toInt());
+                                        device()->changeInclination(ss[0].toInt(), ss[0].toInt());
                                     } else {
                                         qDebug() << "filtering" << ss[0].toInt();
                                     }
@@ -783,7 +784,7 @@ void trainprogram::scheduler() {
 #elif defined(Q_OS_WINDOWS)
             static windows_zwift_incline_paddleocr_thread *windows_zwift_ocr_thread = nullptr;
             if (!windows_zwift_ocr_thread) {
-                windows_zwift_ocr_thread = new windows_zwift_incline_paddleocr_thread(bluetoothManager->device());
+                windows_zwift_ocr_thread = new windows_zwift_incline_paddleocr_thread(device());
                 connect(windows_zwift_ocr_thread, &windows_zwift_incline_paddleocr_thread::debug, bluetoothManager,
                         &bluetooth::debug);
                 connect(windows_zwift_ocr_thread, &windows_zwift_incline_paddleocr_thread::onInclination, this,
@@ -792,14 +793,14 @@ void trainprogram::scheduler() {
             }
 #endif
         } else if (settings.value(QZSettings::zwift_workout_ocr, QZSettings::default_zwift_workout_ocr).toBool() &&
-                   bluetoothManager && bluetoothManager->device() &&
-                   (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL ||
-                    bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL)) {
+                   device() &&
+                   (device()->deviceType() == bluetoothdevice::TREADMILL ||
+                    device()->deviceType() == bluetoothdevice::ELLIPTICAL)) {
 #ifdef Q_OS_WINDOWS
             static windows_zwift_workout_paddleocr_thread *windows_zwift_workout_ocr_thread = nullptr;
             if (!windows_zwift_workout_ocr_thread) {
                 windows_zwift_workout_ocr_thread =
-                    new windows_zwift_workout_paddleocr_thread(bluetoothManager->device());
+                    new windows_zwift_workout_paddleocr_thread(device());
                 connect(windows_zwift_workout_ocr_thread, &windows_zwift_workout_paddleocr_thread::debug,
                         bluetoothManager, &bluetooth::debug);
                 connect(windows_zwift_workout_ocr_thread, &windows_zwift_workout_paddleocr_thread::onInclination, this,
@@ -833,7 +834,7 @@ void trainprogram::scheduler() {
 
     ticks++;
 
-    double odometerFromTheDevice = bluetoothManager->device()->odometer();
+    double odometerFromTheDevice = device()->odometer();
 
     if(ticks < 0) {
         qDebug() << "waiting for the start...";
@@ -845,7 +846,7 @@ void trainprogram::scheduler() {
         rows[currentStep].started = QDateTime::currentDateTime();
         currentStepDistance = 0;
         lastOdometer = odometerFromTheDevice;
-        if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
+        if (device()->deviceType() == bluetoothdevice::TREADMILL) {
             if (rows.at(0).forcespeed && rows.at(0).speed) {
                 qDebug() << QStringLiteral("trainprogram change speed") + QString::number(rows.at(0).speed);
                 emit changeSpeed(rows.at(0).speed);
@@ -865,7 +866,7 @@ void trainprogram::scheduler() {
                 qDebug() << QStringLiteral("trainprogram change power") + QString::number(rows.at(0).power);
                 emit changePower(rows.at(0).power);
             }
-        } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
+        } else if (device()->deviceType() == bluetoothdevice::ROWING) {
             if (rows.at(0).forcespeed && rows.at(0).speed) {
                 qDebug() << QStringLiteral("trainprogram change speed") + QString::number(rows.at(0).speed);
                 emit changeSpeed(rows.at(0).speed);
@@ -904,8 +905,8 @@ void trainprogram::scheduler() {
                 emit changeRequestedPelotonResistance(rows.at(0).requested_peloton_resistance);
             }
 
-            if (rows.at(0).inclination != -200 && (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE || 
-            (bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL && !((elliptical*)bluetoothManager->device())->inclinationAvailableByHardware()))) {
+            if (rows.at(0).inclination != -200 && (device()->deviceType() == bluetoothdevice::BIKE || 
+            (device()->deviceType() == bluetoothdevice::ELLIPTICAL && !((elliptical*)device())->inclinationAvailableByHardware()))) {
                 // this should be converted in a signal as all the other signals...
                 double bikeResistanceOffset =
                     settings.value(QZSettings::bike_resistance_offset, QZSettings::default_bike_resistance_offset)
@@ -915,10 +916,10 @@ void trainprogram::scheduler() {
                         .toDouble();
 
                 double inc = rows.at(0).inclination;
-                bluetoothManager->device()->changeResistance((resistance_t)(round(inc * bikeResistanceGain)) +
+                device()->changeResistance((resistance_t)(round(inc * bikeResistanceGain)) +
                                                              bikeResistanceOffset + 1); // resistance start from 1)
-                if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE && !((bike *)bluetoothManager->device())->inclinationAvailableByHardware())
-                    bluetoothManager->device()->setInclination(inc);
+                if (device()->deviceType() == bluetoothdevice::BIKE && !((bike *)device())->inclinationAvailableByHardware())
+                    device()->setInclination(inc);
                 qDebug() << QStringLiteral("trainprogram change inclination") + QString::number(inc);
                 emit changeInclination(inc, inc);
                 emit changeNextInclination300Meters(inclinationNext300Meters());
@@ -1005,7 +1006,7 @@ void trainprogram::scheduler() {
                 rows[currentStep].started = QDateTime::currentDateTime();
 
                 currentStepDistance = 0;
-                if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
+                if (device()->deviceType() == bluetoothdevice::TREADMILL) {
                     if (rows.at(currentStep).forcespeed && rows.at(currentStep).speed) {
                         qDebug() << QStringLiteral("trainprogram change speed ") +
                                         QString::number(rows.at(currentStep).speed);
@@ -1033,7 +1034,7 @@ void trainprogram::scheduler() {
                                         QString::number(rows.at(currentStep).power);
                         emit changePower(rows.at(currentStep).power);
                     }
-                } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
+                } else if (device()->deviceType() == bluetoothdevice::ROWING) {
                     if (rows.at(currentStep).forcespeed && rows.at(currentStep).speed) {
                         qDebug() << QStringLiteral("trainprogram change speed ") +
                                         QString::number(rows.at(currentStep).speed);
@@ -1086,8 +1087,8 @@ void trainprogram::scheduler() {
                     }
 
                     if (rows.at(currentStep).inclination != -200 &&
-                        (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE || 
-                        (bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL && !((elliptical*)bluetoothManager->device())->inclinationAvailableByHardware()))) {
+                        (device()->deviceType() == bluetoothdevice::BIKE || 
+                        (device()->deviceType() == bluetoothdevice::ELLIPTICAL && !((elliptical*)device())->inclinationAvailableByHardware()))) {
                         // this should be converted in a signal as all the other signals...
                         double bikeResistanceOffset =
                             settings
@@ -1099,11 +1100,11 @@ void trainprogram::scheduler() {
                                 .toDouble();
 
                         double inc = rows.at(currentStep).inclination;
-                        bluetoothManager->device()->changeResistance((resistance_t)(round(inc * bikeResistanceGain)) +
+                        device()->changeResistance((resistance_t)(round(inc * bikeResistanceGain)) +
                                                                      bikeResistanceOffset +
                                                                      1); // resistance start from 1)
-                        if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE && !((bike *)bluetoothManager->device())->inclinationAvailableByHardware())
-                            bluetoothManager->device()->setInclination(inc);
+                        if (device()->deviceType() == bluetoothdevice::BIKE && !((bike *)device())->inclinationAvailableByHardware())
+                            device()->setInclination(inc);
                         qDebug() << QStringLiteral("trainprogram change inclination") + QString::number(inc);
                         emit changeInclination(inc, inc);
                         emit changeNextInclination300Meters(inclinationNext300Meters());
@@ -1158,7 +1159,7 @@ void trainprogram::scheduler() {
                 (!isnan(rows.at(currentStep).latitude) && !isnan(rows.at(currentStep).longitude))) {
                 double inc = avgInclinationNext100Meters(currentStep);
                 // if Bike used and it is a gpx with Video use the new weightedInclination
-                if ((videoAvailable) && (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE)) {
+                if ((videoAvailable) && (device()->deviceType() == bluetoothdevice::BIKE)) {
                     inc = weightedInclination(currentStep);
                 }
                 double bikeResistanceOffset =
@@ -1168,15 +1169,15 @@ void trainprogram::scheduler() {
                     settings.value(QZSettings::bike_resistance_gain_f, QZSettings::default_bike_resistance_gain_f)
                         .toDouble();
 
-                if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE) {
-                    bluetoothManager->device()->changeResistance((resistance_t)(round(inc * bikeResistanceGain)) +
+                if (device()->deviceType() == bluetoothdevice::BIKE) {
+                    device()->changeResistance((resistance_t)(round(inc * bikeResistanceGain)) +
                                                                  bikeResistanceOffset + 1); // resistance start from 1)
-                    if (!((bike *)bluetoothManager->device())->inclinationAvailableByHardware())
-                        bluetoothManager->device()->setInclination(inc);
+                    if (!((bike *)device())->inclinationAvailableByHardware())
+                        device()->setInclination(inc);
                 }
                 qDebug() << QStringLiteral("trainprogram change inclination due to gps") + QString::number(inc);
                 emit changeInclination(inc, inc);
-                if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL)
+                if (device()->deviceType() == bluetoothdevice::TREADMILL)
                     emit changeNextInclination300Meters(avgInclinationNext300Meters());
                 else
                     emit changeNextInclination300Meters(inclinationNext300Meters());
@@ -1219,7 +1220,7 @@ void trainprogram::end() {
            // circuit?
     if (!isnan(rows.first().latitude) && !isnan(rows.first().longitude) &&
         QGeoCoordinate(rows.first().latitude, rows.first().longitude)
-                .distanceTo(bluetoothManager->device()->currentCordinate()) < 50) {
+                .distanceTo(device()->currentCordinate()) < 50) {
         emit lap();
         restart();
     } else {
@@ -1261,12 +1262,18 @@ void trainprogram::decreaseElapsedTime(int32_t i) {
     ticks -= i;
 }
 
+bluetoothdevice *trainprogram::device() {
+    if (stationDevice)
+        return stationDevice;
+    return bluetoothManager ? bluetoothManager->device() : nullptr;
+}
+
 void trainprogram::onTapeStarted() { started = true; }
 
 void trainprogram::restart() {
 
-    if (bluetoothManager && bluetoothManager->device())
-        lastOdometer = bluetoothManager->device()->odometer();
+    if (device())
+        lastOdometer = device()->odometer();
     ticks = 0;
     offset = 0;
     currentStep = 0;
@@ -1718,8 +1725,8 @@ QTime trainprogram::currentRowRemainingTime() {
         return QTime(0, 0, 0);
 
     if (currentStep < rows.length() && rows.at(currentStep).distance > 0 && bluetoothManager &&
-        bluetoothManager->device()) {
-        double speed = bluetoothManager->device()->currentSpeed().value();
+        device()) {
+        double speed = device()->currentSpeed().value();
         double distance = rows.at(currentStep).distance;
         distance -= currentStepDistance;
         int seconds = (distance / speed) * 3600.0;
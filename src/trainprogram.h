@@ -113,6 +113,12 @@ class trainprogram : public QObject {
     bool videoAvailable = false;
     void setVideoAvailable(bool v) {videoAvailable = v;}
 
+    /**
+     * @brief setDevice The program drives this device instead of the one of the bluetooth manager, as a station of
+     * the gym mode does.
+     */
+    void setDevice(bluetoothdevice *device) { stationDevice = device; }
+
     void restart();
     bool isStarted() { return started; }
     void scheduler(int tick);
@@ -155,6 +161,8 @@ private slots:
     uint32_t calculateTimeForRowMergingRamps(int32_t row);
     double calculateDistanceForRow(int32_t row);
     bluetooth *bluetoothManager;
+    bluetoothdevice *stationDevice = nullptr;
+    bluetoothdevice *device();
     bool started = false;
     int32_t ticks = 0;
     uint16_t currentStep = 0;
@@ -162,6 +170,7 @@ private slots:
     double lastOdometer = 0;
     double currentStepDistance = 0;
     QTimer timer;
+    QZMetrics::TimerProbe schedulerTimerProbe = QZMetrics::TimerProbe(1000);
     double lastGpxRateSetAt = 0.0;
     double lastGpxRateSet = 0.0;
     double lastGpxSpeedSet = 0.0;
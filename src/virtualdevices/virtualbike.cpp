@@ -505,6 +505,7 @@ virtualbike::virtualbike(bluetoothdevice *t, bool noWriteResistance, bool noHear
         leController->startAdvertising(pars, advertisingData, advertisingData);
 
         //! [Start Advertising]
+        QZMetrics::virtualDeviceAdvertising();
     }
 
     //! [Provide Heartbeat]
@@ -516,6 +517,8 @@ virtualbike::virtualbike(bluetoothdevice *t, bool noWriteResistance, bool noHear
 
     //! [Provide Heartbeat]
     QObject::connect(leController, &QLowEnergyController::disconnected, this, &virtualbike::reconnect);
+    QObject::connect(leController, &QLowEnergyController::disconnected, writeP2AD9,
+                     &CharacteristicWriteProcessor::stopSimulation);
     QObject::connect(
         leController,
         static_cast<void (QLowEnergyController::*)(QLowEnergyController::Error)>(&QLowEnergyController::error), this,
@@ -1278,6 +1281,7 @@ void virtualbike::writeCharacteristic(QLowEnergyService *service, const QLowEner
         qDebug() << QStringLiteral("virtualbike::writeCharacteristic ") + service->serviceName() + QStringLiteral(" ") +
                         characteristic.name() + QStringLiteral(" ") + value.toHex(' ');
         service->writeCharacteristic(characteristic, value); // Potentially causes notification.
+        QZMetrics::increment(QZMetrics::VirtualDeviceNotifications, characteristic.uuid().data1);
     } catch (...) {
         qDebug() << QStringLiteral("virtual bike error!");
     }
@@ -1293,6 +1297,8 @@ void virtualbike::reconnect() {
         return;
     }
 
+    QZMetrics::increment(QZMetrics::VirtualDeviceReconnects);
+
     bool zwift_play_emulator = settings.value(QZSettings::zwift_play_emulator, QZSettings::default_zwift_play_emulator).toBool();
     bool watt_bike_emulator = settings.value(QZSettings::watt_bike_emulator, QZSettings::default_watt_bike_emulator).toBool();
     bool cadence = settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
@@ -1466,6 +1472,7 @@ void virtualbike::bikeProvider() {
                         return;
                     }
                     writeCharacteristic(serviceFIT, characteristic, value);
+                    QZMetrics::observeOnce(QZMetrics::NotificationToVirtualDeviceLatency, Bike->ingressNs(), lastIngressNs);
 
                     if(zwift_play_emulator) {
                         QLowEnergyCharacteristic characteristic1 =
@@ -1508,6 +1515,7 @@ void virtualbike::bikeProvider() {
                         return;
                     }
                     writeCharacteristic(service, characteristic, value);
+                    QZMetrics::observeOnce(QZMetrics::NotificationToVirtualDeviceLatency, Bike->ingressNs(), lastIngressNs);
                 }
             } else {
                 value.clear();
@@ -1528,6 +1536,7 @@ void virtualbike::bikeProvider() {
                         return;
                     }
                     writeCharacteristic(service, characteristic, value);
+                    QZMetrics::observeOnce(QZMetrics::NotificationToVirtualDeviceLatency, Bike->ingressNs(), lastIngressNs);
                 }
             }
         }
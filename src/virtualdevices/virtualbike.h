@@ -72,6 +72,7 @@ class virtualbike : public virtualdevice {
 
     qint64 lastFTMSFrameReceived = 0;
     qint64 lastDirconFTMSFrameReceived = 0;
+    qint64 lastIngressNs = 0; // newest stamp of the bike observed in the latency histogram
 
     bool noHeartService = false;
     int8_t bikeResistanceOffset = 4;
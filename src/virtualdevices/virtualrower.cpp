@@ -1,4 +1,5 @@
 #include "virtualdevices/virtualrower.h"
+#include "characteristics/characteristicencoder.h"
 #include "qsettings.h"
 #include "rower.h"
 
@@ -185,6 +186,7 @@ virtualrower::virtualrower(bluetoothdevice *t, bool noWriteResistance, bool noHe
 #endif
 
         //! [Start Advertising]
+        QZMetrics::virtualDeviceAdvertising();
     }
 
     //! [Provide Heartbeat]
@@ -290,6 +292,7 @@ void virtualrower::writeCharacteristic(QLowEnergyService *service, const QLowEne
         qDebug() << QStringLiteral("virtualrower::writeCharacteristic ") + service->serviceName() +
                         QStringLiteral(" ") + characteristic.name() + QStringLiteral(" ") + value.toHex(' ');
         service->writeCharacteristic(characteristic, value); // Potentially causes notification.
+        QZMetrics::increment(QZMetrics::VirtualDeviceNotifications, characteristic.uuid().data1);
     } catch (...) {
         qDebug() << QStringLiteral("virtual rower error!");
     }
@@ -305,6 +308,8 @@ void virtualrower::reconnect() {
         return;
     }
 
+    QZMetrics::increment(QZMetrics::VirtualDeviceReconnects);
+
     bool heart_only =
         settings.value(QZSettings::virtual_device_onlyheart, QZSettings::default_virtual_device_onlyheart).toBool();
 
@@ -403,32 +408,18 @@ void virtualrower::rowerProvider() {
 
     if (!heart_only) {
 
-        value.append((char)0x2C);
-        value.append((char)0x03);
-
-        value.append((char)((uint8_t)(Rower->currentCadence().value() * 2) & 0xFF)); // Stroke Rate
-
-        value.append((char)((uint16_t)(((rower *)Rower)->currentStrokesCount().value()) & 0xFF));        // Stroke Count
-        value.append((char)(((uint16_t)(((rower *)Rower)->currentStrokesCount().value()) >> 8) & 0xFF)); // Stroke Count
-
-        value.append((char)(((uint16_t)(((rower *)Rower)->odometer() * 1000.0)) & 0xFF));       // Distance
-        value.append((char)(((uint16_t)(((rower *)Rower)->odometer() * 1000.0) >> 8) & 0xFF));  // Distance
-        value.append((char)(((uint16_t)(((rower *)Rower)->odometer() * 1000.0) >> 16) & 0xFF)); // Distance
-
-        value.append((char)(((uint16_t)QTime(0, 0, 0).secsTo(((rower *)Rower)->currentPace())) & 0xFF));      // pace
-        value.append((char)(((uint16_t)QTime(0, 0, 0).secsTo(((rower *)Rower)->currentPace())) >> 8) & 0xFF); // pace
-
-        value.append((char)(((uint16_t)Rower->wattsMetric().value()) & 0xFF));      // watts
-        value.append((char)(((uint16_t)Rower->wattsMetric().value()) >> 8) & 0xFF); // watts
-
-        value.append((char)((uint16_t)(Rower->calories().value()) & 0xFF));        // calories
-        value.append((char)(((uint16_t)(Rower->calories().value()) >> 8) & 0xFF)); // calories
-        value.append((char)((uint16_t)(Rower->calories().value()) & 0xFF));        // calories
-        value.append((char)(((uint16_t)(Rower->calories().value()) >> 8) & 0xFF)); // calories
-        value.append((char)((uint16_t)(Rower->calories().value()) & 0xFF));        // calories
+        CharacteristicEncoder::RowerData::Fields fields;
+        fields.strokeRate = Rower->currentCadence().value();
+        fields.strokeCount = ((rower *)Rower)->currentStrokesCount().value();
+        fields.distance = ((rower *)Rower)->odometer();
+        fields.pace = QTime(0, 0, 0).secsTo(((rower *)Rower)->currentPace());
+        fields.watts = Rower->wattsMetric().value();
+        fields.calories = Rower->calories().value();
+        fields.heart = Rower->currentHeart().value();
 
-        value.append(char(Rower->currentHeart().value())); // Actual value.
-        value.append((char)0);                             // Bkool FTMS protocol HRM offset 1280 fix
+        CharacteristicEncoder::RowerData::Buffer buffer;
+        CharacteristicEncoder::RowerData::encode(fields, buffer);
+        buffer.appendTo(value);
 
         if (!serviceFIT) {
             qDebug() << QStringLiteral("serviceFIT not available");
@@ -449,6 +440,7 @@ void virtualrower::rowerProvider() {
             return;
         }
         writeCharacteristic(serviceFIT, characteristic, value);
+        QZMetrics::observeOnce(QZMetrics::NotificationToVirtualDeviceLatency, Rower->ingressNs(), lastIngressNs);
     }
     // characteristic
     //        = service->characteristic((QBluetoothUuid::CharacteristicType)0x2AD9); // Fitness Machine Control Point
@@ -463,8 +455,9 @@ void virtualrower::rowerProvider() {
         }
 
         QByteArray valueHR;
-        valueHR.append(char(0));                                   // Flags that specify the format of the value.
-        valueHR.append(char(Rower->metrics_override_heartrate())); // Actual value.
+        CharacteristicEncoder::HeartRateMeasurement::Buffer bufferHR;
+        CharacteristicEncoder::HeartRateMeasurement::encode(Rower->metrics_override_heartrate(), bufferHR);
+        bufferHR.appendTo(valueHR);
         QLowEnergyCharacteristic characteristicHR = serviceHR->characteristic(QBluetoothUuid::HeartRateMeasurement);
 
         Q_ASSERT(characteristicHR.isValid());
@@ -49,6 +49,7 @@ class virtualrower : public virtualdevice {
     uint16_t lastWheelTime = 0;
     uint32_t wheelRevs = 0;
     qint64 lastFTMSFrameReceived = 0;
+    qint64 lastIngressNs = 0; // newest stamp of the rower observed in the latency histogram
 
     bool noHeartService = false;
 
@@ -394,6 +394,7 @@ virtualtreadmill::virtualtreadmill(bluetoothdevice *t, bool noHeartService) {
         leController->startAdvertising(pars, advertisingData, advertisingData);
 #endif
         //! [Start Advertising]
+        QZMetrics::virtualDeviceAdvertising();
 
         QObject::connect(leController, &QLowEnergyController::disconnected, this, &virtualtreadmill::reconnect);
     }
@@ -472,6 +473,8 @@ void virtualtreadmill::reconnect() {
         return;
     }
 
+    QZMetrics::increment(QZMetrics::VirtualDeviceReconnects);
+
     qDebug() << "virtualtreadmill reconnect " << treadMill->connected();
     
     if (ftmsServiceEnable())
@@ -591,6 +594,8 @@ void virtualtreadmill::treadmillProvider() {
                 }
                 try {
                     serviceFTMS->writeCharacteristic(characteristic, value); // Potentially causes notification.
+                    QZMetrics::increment(QZMetrics::VirtualDeviceNotifications, characteristic.uuid().data1);
+                    QZMetrics::observeOnce(QZMetrics::NotificationToVirtualDeviceLatency, treadMill->ingressNs(), lastIngressNs);
                 } catch (...) {
                     qDebug() << QStringLiteral("virtualtreadmill error!");
                 }
@@ -614,6 +619,8 @@ void virtualtreadmill::treadmillProvider() {
             }
             try {
                 serviceFTMS->writeCharacteristic(characteristic, value); // Potentially causes notification.
+                QZMetrics::increment(QZMetrics::VirtualDeviceNotifications, characteristic.uuid().data1);
+                QZMetrics::observeOnce(QZMetrics::NotificationToVirtualDeviceLatency, treadMill->ingressNs(), lastIngressNs);
             } catch (...) {
                 qDebug() << QStringLiteral("virtualtreadmill error!");
             }
@@ -638,6 +645,8 @@ void virtualtreadmill::treadmillProvider() {
             }
             try {
                 serviceRSC->writeCharacteristic(characteristic, value); // Potentially causes notification.
+                QZMetrics::increment(QZMetrics::VirtualDeviceNotifications, characteristic.uuid().data1);
+                QZMetrics::observeOnce(QZMetrics::NotificationToVirtualDeviceLatency, treadMill->ingressNs(), lastIngressNs);
             } catch (...) {
                 qDebug() << QStringLiteral("virtualtreadmill error!");
             }
@@ -651,7 +660,7 @@ void virtualtreadmill::treadmillProvider() {
 
     if (noHeartService == false) {
         value.clear();
-        if (notif2A53->notify(value) == CN_OK) {
+        if (notif2A37->notify(value) == CN_OK) {
             if (!serviceHR) {
                 qDebug() << QStringLiteral("serviceFIT not available");
 
@@ -668,6 +677,7 @@ void virtualtreadmill::treadmillProvider() {
             }
             try {
                 serviceHR->writeCharacteristic(characteristic, value); // Potentially causes notification.
+                QZMetrics::increment(QZMetrics::VirtualDeviceNotifications, characteristic.uuid().data1);
             } catch (...) {
                 qDebug() << QStringLiteral("virtualtreadmill error!");
             }
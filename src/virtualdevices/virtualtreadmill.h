@@ -66,6 +66,7 @@ class virtualtreadmill : public virtualdevice {
     bluetoothdevice *treadMill;
 
     uint64_t lastSlopeChanged = 0;
+    qint64 lastIngressNs = 0; // newest stamp of the treadmill observed in the latency histogram
 
     CharacteristicWriteProcessor2AD9 *writeP2AD9 = 0;
     CharacteristicNotifier2AD2 *notif2AD2 = 0;
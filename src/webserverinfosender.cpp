@@ -1,4 +1,5 @@
 #include "webserverinfosender.h"
+#include "qzmetrics.h"
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -62,6 +63,7 @@ void WebServerInfoSender::innerStop() {
             innerTcpServer->close();
         httpServer->deleteLater();
         clients.clear();
+        QZMetrics::addGauge(QZMetrics::WebSocketClients, -sendToClients.size());
         sendToClients.clear();
         reply2Req.clear();
         innerTcpServer = 0;
@@ -230,6 +232,7 @@ void WebServerInfoSender::onNewConnection() {
         connect(pSocket, SIGNAL(textMessageReceived(QString)), this, SLOT(processTextMessage(QString)));
         connect(pSocket, SIGNAL(binaryMessageReceived(QByteArray)), this, SLOT(processBinaryMessage(QByteArray)));
         sendToClients << pSocket;
+        QZMetrics::addGauge(QZMetrics::WebSocketClients, 1);
     }
     connect(pSocket, SIGNAL(disconnected()), this, SLOT(socketDisconnected()));
 
@@ -241,7 +244,9 @@ void WebServerInfoSender::socketDisconnected() {
     qDebug() << QStringLiteral("socketDisconnected:") << pClient;
     if (pClient) {
         clients.removeAll(pClient);
-        if (!sendToClients.removeAll(pClient)) {
+        if (sendToClients.removeAll(pClient)) {
+            QZMetrics::addGauge(QZMetrics::WebSocketClients, -1);
+        } else {
             QMutableHashIterator<QNetworkReply *, QPair<QJsonObject, QWebSocket *>> i(reply2Req);
             while (i.hasNext()) {
                 i.next();
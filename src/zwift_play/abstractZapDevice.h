@@ -7,6 +7,7 @@
 #include <QSettings>
 #include <QTimer>
 #include <QDateTime>
+#include <QElapsedTimer>
 //#include "localKeyProvider.h"
 //#include "zapCrypto.h"
 #include "zapConstants.h"
@@ -49,9 +50,13 @@ class AbstractZapDevice: public QObject {
     int processCharacteristic(const QString& characteristicName, const QByteArray& bytes, ZWIFT_PLAY_TYPE zapType) {
         if (bytes.isEmpty()) return 0;
 
-        QSettings settings;
-        bool gears_volume_debouncing = settings.value(QZSettings::gears_volume_debouncing, QZSettings::default_gears_volume_debouncing).toBool();
-        bool zwiftplay_swap = settings.value(QZSettings::zwiftplay_swap, QZSettings::default_zwiftplay_swap).toBool();
+        // two controllers and a click send a notification for every frame: the settings are not read for each one
+        if (!settingsAge.isValid() || settingsAge.elapsed() >= 1000) {
+            QSettings settings;
+            gears_volume_debouncing = settings.value(QZSettings::gears_volume_debouncing, QZSettings::default_gears_volume_debouncing).toBool();
+            zwiftplay_swap = settings.value(QZSettings::zwiftplay_swap, QZSettings::default_zwiftplay_swap).toBool();
+            settingsAge.start();
+        }
 
         qDebug() << zapType << characteristicName << bytes.toHex() << zwiftplay_swap << gears_volume_debouncing << risingEdge << lastFrame;
 
@@ -328,6 +333,9 @@ class AbstractZapDevice: public QObject {
 
   private:
     QByteArray devicePublicKeyBytes;
+    QElapsedTimer settingsAge;
+    bool gears_volume_debouncing = QZSettings::default_gears_volume_debouncing;
+    bool zwiftplay_swap = QZSettings::default_zwiftplay_swap;
     static volatile int8_t risingEdge;
     static QTimer* autoRepeatTimer;    // Static timer for auto-repeat
     static bool lastButtonPlus;  // Static track of which button was last pressed
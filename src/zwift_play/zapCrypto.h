@@ -7,88 +7,157 @@
 #include <openssl/hmac.h>
 #include <openssl/err.h>
 #include <QByteArray>
+#include <QDebug>
 #include <cassert>
+#include <string.h>
 #include "localKeyProvider.h"
 
+/**
+ * @brief AES-256-CCM session of a Zwift Play/Click controller.
+ * The two cipher contexts are created and keyed once per session: a message only sets its nonce, the key
+ * schedule is not computed again. decrypt() and encrypt() write into a buffer kept by the caller, so a
+ * steady stream of notifications doesn't allocate once the buffer has grown to the largest message.
+ * Not part of the app build yet: OpenSSL is only linked on Windows and Android, and the controllers are driven
+ * with the unencrypted RideOn handshake, so nothing creates a session. Only the tests use it.
+ */
 class ZapCrypto {
 public:
+    static const int COUNTER_LENGTH = 4;
+
     ZapCrypto(LocalKeyProvider &localKeyProvider)
         : localKeyProvider(localKeyProvider), counter(0) {
-        // Initialization code if needed
     }
 
+    ~ZapCrypto() {
+        EVP_CIPHER_CTX_free(encryptContext);
+        EVP_CIPHER_CTX_free(decryptContext);
+    }
+
+    ZapCrypto(const ZapCrypto &) = delete;
+    ZapCrypto &operator=(const ZapCrypto &) = delete;
+
     void initialise(const QByteArray &devicePublicKeyBytes) {
         QByteArray hkdfBytes = generateHmacKeyDerivationFunctionBytes(devicePublicKeyBytes);
-        encryptionKeyBytes = hkdfBytes.mid(0, EncryptionUtils::KEY_LENGTH);
-        ivBytes = hkdfBytes.mid(32, EncryptionUtils::HKDF_LENGTH);
+        setKeys(hkdfBytes.mid(0, EncryptionUtils::KEY_LENGTH), hkdfBytes.mid(32, EncryptionUtils::HKDF_LENGTH));
+    }
+
+    /**
+     * @brief setKeys Starts a session with the key and the nonce prefix derived from the handshake.
+     * @return false if OpenSSL refused the key
+     */
+    bool setKeys(const QByteArray &key, const QByteArray &iv) {
+        encryptionKeyBytes = key;
+        ivBytes = iv;
+        counter = 0;
+        nonce = ivBytes + QByteArray(COUNTER_LENGTH, 0);
+        return keyContext(encryptContext, true) && keyContext(decryptContext, false);
     }
 
     QByteArray encrypt(const QByteArray &data) {
-        assert(!encryptionKeyBytes.isEmpty() && !ivBytes.isEmpty());
+        QByteArray output;
+        encrypt(data.constData(), data.size(), output);
+        return output;
+    }
 
-        QByteArray nonceBytes = createNonce(ivBytes, counter);
-        QByteArray encrypted = encryptDecrypt(true, nonceBytes, data);
+    /**
+     * @brief encrypt Writes the counter, the encrypted data and the MAC to output.
+     */
+    bool encrypt(const char *data, int size, QByteArray &output) {
+        assert(!encryptionKeyBytes.isEmpty() && !ivBytes.isEmpty());
 
+        output.resize(COUNTER_LENGTH + size + EncryptionUtils::MAC_LENGTH);
+        unsigned char *out = reinterpret_cast<unsigned char *>(output.data());
+        writeCounter(out, counter);
         counter++;
-        return createCounterBytes(counter - 1) + encrypted;
+        memcpy(nonce.data() + ivBytes.size(), out, COUNTER_LENGTH);
+
+        int outlen;
+        bool ok = EVP_CipherInit_ex(encryptContext, NULL, NULL, NULL,
+                                    reinterpret_cast<const unsigned char *>(nonce.constData()), 1) == 1 &&
+                  EVP_CipherUpdate(encryptContext, NULL, &outlen, NULL, size) == 1 &&
+                  EVP_CipherUpdate(encryptContext, out + COUNTER_LENGTH, &outlen,
+                                   reinterpret_cast<const unsigned char *>(data), size) == 1 &&
+                  EVP_CipherFinal_ex(encryptContext, out + COUNTER_LENGTH + outlen, &outlen) == 1 &&
+                  EVP_CIPHER_CTX_ctrl(encryptContext, EVP_CTRL_CCM_GET_TAG, EncryptionUtils::MAC_LENGTH,
+                                      out + COUNTER_LENGTH + size) == 1;
+        if (!ok) {
+            qDebug() << "ZapCrypto encrypt error" << ERR_get_error();
+            output.clear();
+        }
+        return ok;
     }
 
     QByteArray decrypt(const QByteArray &counterArray, const QByteArray &payload) {
+        QByteArray output;
+        decrypt(counterArray, payload, output);
+        return output;
+    }
+
+    /**
+     * @brief decrypt Verifies and decrypts a notification: payload is the encrypted data followed by the MAC.
+     * @return false if the MAC doesn't match, output is then empty
+     */
+    bool decrypt(const QByteArray &counterArray, const QByteArray &payload, QByteArray &output) {
         assert(!encryptionKeyBytes.isEmpty() && !ivBytes.isEmpty());
 
-        QByteArray nonceBytes = ivBytes + counterArray;
-        qDebug() << "nonceBytes" << nonceBytes.toHex(' ');
-        return encryptDecrypt(false, nonceBytes, payload);
+        int size = payload.size() - EncryptionUtils::MAC_LENGTH;
+        if (counterArray.size() != COUNTER_LENGTH || size < 0) {
+            output.clear();
+            return false;
+        }
+        memcpy(nonce.data() + ivBytes.size(), counterArray.constData(), COUNTER_LENGTH);
+        output.resize(size);
+
+        const unsigned char *in = reinterpret_cast<const unsigned char *>(payload.constData());
+        int outlen;
+        bool ok = EVP_CipherInit_ex(decryptContext, NULL, NULL, NULL,
+                                    reinterpret_cast<const unsigned char *>(nonce.constData()), 0) == 1 &&
+                  EVP_CIPHER_CTX_ctrl(decryptContext, EVP_CTRL_CCM_SET_TAG, EncryptionUtils::MAC_LENGTH,
+                                      const_cast<unsigned char *>(in + size)) == 1 &&
+                  EVP_CipherUpdate(decryptContext, NULL, &outlen, NULL, size) == 1 &&
+                  // in CCM the MAC is verified by this update, there's nothing left for a final
+                  EVP_CipherUpdate(decryptContext, reinterpret_cast<unsigned char *>(output.data()), &outlen, in,
+                                   size) == 1;
+        if (!ok) {
+            qDebug() << "ZapCrypto decrypt error" << ERR_get_error();
+            output.clear();
+        }
+        return ok;
     }
 
 private:
     LocalKeyProvider &localKeyProvider;
     QByteArray encryptionKeyBytes;
     QByteArray ivBytes;
+    QByteArray nonce;
     int counter;
-
-    QByteArray encryptDecrypt(bool encrypt, const QByteArray &nonceBytes, const QByteArray &data) {
-        int outlen;
-        QByteArray output(data.size() + (encrypt ? EncryptionUtils::MAC_LENGTH : 0), 0);
-        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
-
-        EVP_CipherInit_ex(ctx, EVP_aes_256_ccm(), NULL, NULL, NULL, encrypt);
-
-        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_IVLEN, ivBytes.size(), NULL);
-
-        if (encrypt) {
-            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_TAG, EncryptionUtils::MAC_LENGTH, NULL);
-        }
-
-        EVP_CipherInit_ex(ctx, NULL, NULL,
-                          reinterpret_cast<const unsigned char *>(encryptionKeyBytes.constData()),
-                          reinterpret_cast<const unsigned char *>(nonceBytes.constData()), encrypt);
-
-        EVP_CipherUpdate(ctx, NULL, &outlen, NULL, data.size());
-
-        int ret = EVP_CipherUpdate(ctx, reinterpret_cast<unsigned char *>(output.data()), &outlen,
-                                   reinterpret_cast<const unsigned char *>(data.constData()), data.size());
-        if (ret != 1) {
-            qDebug() << "error" << ERR_get_error();
-            //EVP_CIPHER_CTX_free(ctx);
-            //return QByteArray();
-        }
-
-        if (EVP_CipherFinal_ex(ctx, reinterpret_cast<unsigned char *>(output.data()) + outlen, &outlen) <= 0) {
-            EVP_CIPHER_CTX_free(ctx);
-            //return QByteArray();
-        }
-
-        if (encrypt) {
-            unsigned char tag[EncryptionUtils::MAC_LENGTH];
-            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_GET_TAG, EncryptionUtils::MAC_LENGTH, tag);
-            output.append(reinterpret_cast<char *>(tag), EncryptionUtils::MAC_LENGTH);
-        }
-
-        EVP_CIPHER_CTX_free(ctx);
-        return output;
+    EVP_CIPHER_CTX *encryptContext = nullptr;
+    EVP_CIPHER_CTX *decryptContext = nullptr;
+
+    bool keyContext(EVP_CIPHER_CTX *&ctx, bool encrypt) {
+        if (!ctx)
+            ctx = EVP_CIPHER_CTX_new();
+        else
+            EVP_CIPHER_CTX_reset(ctx);
+        // the nonce is the iv from the handshake followed by the message counter
+        bool ok = ctx && EVP_CipherInit_ex(ctx, EVP_aes_256_ccm(), NULL, NULL, NULL, encrypt) == 1 &&
+                  EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_IVLEN, nonce.size(), NULL) == 1 &&
+                  EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_TAG, EncryptionUtils::MAC_LENGTH, NULL) == 1 &&
+                  EVP_CipherInit_ex(ctx, NULL, NULL,
+                                    reinterpret_cast<const unsigned char *>(encryptionKeyBytes.constData()), NULL,
+                                    encrypt) == 1;
+        if (!ok)
+            qDebug() << "ZapCrypto key setup error" << ERR_get_error();
+        return ok;
     }
 
+    // big endian, as the controller sends it in front of each message
+    static void writeCounter(unsigned char *out, int messageCounter) {
+        out[0] = (messageCounter >> 24) & 0xff;
+        out[1] = (messageCounter >> 16) & 0xff;
+        out[2] = (messageCounter >> 8) & 0xff;
+        out[3] = messageCounter & 0xff;
+    }
 
     QByteArray generateHmacKeyDerivationFunctionBytes(const QByteArray& devicePublicKeyBytes) {
         qDebug() << devicePublicKeyBytes.toHex(' ');
@@ -119,20 +188,9 @@ private:
         return hkdfOutput;
     }
 
-
-
-
-    QByteArray createNonce(const QByteArray &iv, int messageCounter) {
-        return iv + createCounterBytes(messageCounter);
-    }
-
-    static QByteArray createCounterBytes(int messageCounter) {
-        QByteArray counterBytes;
-        counterBytes.setNum(messageCounter, 16);
-        return counterBytes;
-    }
-
-    QByteArray hkdf(const QByteArray& ikm, const QByteArray& salt, const QByteArray& info, int outputLength) {
+public:
+    // RFC 5869 with SHA-256
+    static QByteArray hkdf(const QByteArray& ikm, const QByteArray& salt, const QByteArray& info, int outputLength) {
         unsigned char prk[EVP_MAX_MD_SIZE];
         unsigned int prk_len;
 
@@ -68,9 +68,12 @@ void zwiftclickremote::characteristicChanged(const QLowEnergyCharacteristic &cha
 
     qDebug() << QStringLiteral(" << ") << newValue.toHex(' ') << QString(newValue) << characteristic.uuid().Name << characteristic.uuid().toString() << typeZap;
 
-    if(characteristic.uuid() == QBluetoothUuid(QStringLiteral("00000002-19CA-4651-86E5-FA29DCDD09D1"))) {
+    // parsed once, not for every notification
+    static const QBluetoothUuid asyncUuid(QStringLiteral("00000002-19CA-4651-86E5-FA29DCDD09D1"));
+    static const QBluetoothUuid syncTxUuid(QStringLiteral("00000004-19CA-4651-86E5-FA29DCDD09D1"));
+    if(characteristic.uuid() == asyncUuid) {
         playDevice->processCharacteristic("Async", newValue, typeZap);
-    } else if(characteristic.uuid() == QBluetoothUuid(QStringLiteral("00000004-19CA-4651-86E5-FA29DCDD09D1"))) {
+    } else if(characteristic.uuid() == syncTxUuid) {
         playDevice->processCharacteristic("SyncTx", newValue, typeZap);
     } else if(characteristic.uuid() == QBluetoothUuid::BatteryLevel) {
     }
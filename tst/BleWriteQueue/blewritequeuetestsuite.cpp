@@ -0,0 +1,181 @@
+#include "blewritequeuetestsuite.h"
+
+#include <QEventLoop>
+#include <QTimer>
+
+#include "devices/blewritequeue.h"
+
+namespace {
+
+void runEventLoop(int ms) {
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+// a queue writing to nothing: the tests play the signals of the service
+class FakeWriteQueue : public BleWriteQueue {
+  public:
+    FakeWriteQueue() {
+        connect(this, &BleWriteQueue::requestCompleted, this,
+                [this](const QByteArray &data, bool timedOut) { completed.append({data, timedOut}); });
+    }
+
+    using BleWriteQueue::changed;
+    using BleWriteQueue::written;
+
+    QList<QByteArray> sent;
+    QList<QPair<QByteArray, bool>> completed;
+
+  protected:
+    bool send(const Request &request) override {
+        sent.append(request.data);
+        return true;
+    }
+};
+
+BleWriteQueue::Request request(const QByteArray &data, quint32 coalesceKey = 0,
+                               BleWriteQueue::Response response = BleWriteQueue::NoResponse) {
+    BleWriteQueue::Request r;
+    r.data = data;
+    r.coalesceKey = coalesceKey;
+    r.response = response;
+    return r;
+}
+
+const QByteArray requestControl = QByteArray::fromHex("00");
+const QByteArray power100 = QByteArray::fromHex("056400");
+const QByteArray power150 = QByteArray::fromHex("059600");
+const QByteArray power200 = QByteArray::fromHex("05c800");
+const QByteArray grade = QByteArray::fromHex("110000f4012833");
+
+} // namespace
+
+BleWriteQueueTestSuite::BleWriteQueueTestSuite() {}
+
+void BleWriteQueueTestSuite::test_coalescing() {
+    FakeWriteQueue queue;
+    queue.enqueue(request(requestControl));
+    EXPECT_EQ(queue.sent, QList<QByteArray>({requestControl}));
+    EXPECT_FALSE(queue.idle());
+
+    // the device is still busy with the first write: the targets wait, only the latest power is kept
+    queue.enqueue(request(power100, 0x05));
+    queue.enqueue(request(grade, 0x11));
+    queue.enqueue(request(power150, 0x05));
+    queue.enqueue(request(power200, 0x05));
+    EXPECT_EQ(queue.depth(), 3);
+    EXPECT_EQ(queue.sent.size(), 1);
+
+    queue.written(QBluetoothUuid());
+    // the power keeps the place of the first one it replaced
+    EXPECT_EQ(queue.sent, QList<QByteArray>({requestControl, power200}));
+    queue.written(QBluetoothUuid());
+    queue.written(QBluetoothUuid());
+    EXPECT_EQ(queue.sent, QList<QByteArray>({requestControl, power200, grade}));
+    EXPECT_TRUE(queue.idle());
+    EXPECT_EQ(queue.depth(), 0);
+    ASSERT_EQ(queue.completed.size(), 3);
+    EXPECT_FALSE(queue.completed.at(2).second);
+
+    // nothing in flight: no coalescing, sent right away
+    queue.enqueue(request(power100, 0x05));
+    EXPECT_EQ(queue.sent.last(), power100);
+}
+
+void BleWriteQueueTestSuite::test_withoutResponse() {
+    FakeWriteQueue queue;
+    for (const QByteArray &data : {requestControl, power100, grade}) {
+        BleWriteQueue::Request r = request(data);
+        r.mode = QLowEnergyService::WriteWithoutResponse;
+        queue.enqueue(r);
+    }
+    // no characteristicWritten ever comes, nothing waits for it
+    EXPECT_EQ(queue.sent, QList<QByteArray>({requestControl, power100, grade}));
+    EXPECT_TRUE(queue.idle());
+    EXPECT_EQ(queue.depth(), 0);
+    ASSERT_EQ(queue.completed.size(), 3);
+    for (const auto &c : queue.completed)
+        EXPECT_FALSE(c.second);
+
+    // waiting for the response of the control point still waits
+    BleWriteQueue::Request r = request(power100, 0x05, BleWriteQueue::ControlPointResponse);
+    r.mode = QLowEnergyService::WriteWithoutResponse;
+    queue.enqueue(r);
+    EXPECT_FALSE(queue.idle());
+    queue.changed(QBluetoothUuid(), QByteArray::fromHex("800501"));
+    EXPECT_TRUE(queue.idle());
+}
+
+void BleWriteQueueTestSuite::test_timeout() {
+    FakeWriteQueue queue;
+    queue.setTimeout(50);
+    queue.enqueue(request(requestControl));
+    queue.enqueue(request(power100));
+    runEventLoop(80);
+    ASSERT_GE(queue.completed.size(), 1);
+    EXPECT_EQ(queue.completed.at(0).first, requestControl);
+    EXPECT_TRUE(queue.completed.at(0).second);
+    EXPECT_EQ(queue.sent, QList<QByteArray>({requestControl, power100}));
+
+    // the late confirmation of the timed out write is dropped, the next one waits for its own
+    queue.written(QBluetoothUuid());
+    EXPECT_EQ(queue.completed.size(), 1);
+    EXPECT_FALSE(queue.idle());
+    queue.written(QBluetoothUuid());
+    ASSERT_EQ(queue.completed.size(), 2);
+    EXPECT_FALSE(queue.completed.at(1).second);
+    EXPECT_TRUE(queue.idle());
+
+    // the same for the response of a control point write
+    queue.enqueue(request(power100, 0, BleWriteQueue::ControlPointResponse));
+    queue.written(QBluetoothUuid());
+    runEventLoop(80);
+    ASSERT_EQ(queue.completed.size(), 3);
+    EXPECT_TRUE(queue.completed.at(2).second);
+    queue.enqueue(request(power150, 0, BleWriteQueue::ControlPointResponse));
+    queue.written(QBluetoothUuid());
+    queue.changed(QBluetoothUuid(), QByteArray::fromHex("800501"));
+    EXPECT_FALSE(queue.idle());
+    queue.changed(QBluetoothUuid(), QByteArray::fromHex("800501"));
+    ASSERT_EQ(queue.completed.size(), 4);
+    EXPECT_EQ(queue.completed.at(3).first, power150);
+    EXPECT_FALSE(queue.completed.at(3).second);
+
+    // an ack coming after another timeout isn't taken for a late one
+    queue.enqueue(request(power100, 0, BleWriteQueue::ControlPointResponse));
+    runEventLoop(160);
+    queue.enqueue(request(power150, 0, BleWriteQueue::ControlPointResponse));
+    queue.changed(QBluetoothUuid(), QByteArray::fromHex("800501"));
+    EXPECT_TRUE(queue.idle());
+}
+
+void BleWriteQueueTestSuite::test_responseMatching() {
+    FakeWriteQueue queue;
+    queue.enqueue(request(power100, 0x05, BleWriteQueue::ControlPointResponse));
+    queue.enqueue(request(grade));
+
+    // the write confirmation, the data of another characteristic and the response to another opcode
+    queue.written(QBluetoothUuid());
+    queue.changed(QBluetoothUuid((quint16)0x2AD2), QByteArray::fromHex("800501"));
+    queue.changed(QBluetoothUuid(), QByteArray::fromHex("800001"));
+    queue.changed(QBluetoothUuid(), QByteArray::fromHex("05"));
+    EXPECT_FALSE(queue.idle());
+    EXPECT_EQ(queue.sent.size(), 1);
+
+    queue.changed(QBluetoothUuid(), QByteArray::fromHex("800501"));
+    EXPECT_EQ(queue.sent, QList<QByteArray>({power100, grade}));
+    ASSERT_EQ(queue.completed.size(), 1);
+    EXPECT_FALSE(queue.completed.at(0).second);
+
+    // the next one doesn't wait for a response: notifications don't complete it
+    queue.changed(QBluetoothUuid(), QByteArray::fromHex("801101"));
+    EXPECT_FALSE(queue.idle());
+    queue.written(QBluetoothUuid());
+    EXPECT_TRUE(queue.idle());
+
+    // the Zwift Play handshake: any notification
+    queue.enqueue(request(requestControl, 0, BleWriteQueue::AnyNotification));
+    queue.changed(QBluetoothUuid((quint16)0x2AD2), QByteArray::fromHex("01"));
+    EXPECT_TRUE(queue.idle());
+}
@@ -0,0 +1,49 @@
+#ifndef BLEWRITEQUEUETESTSUITE_H
+#define BLEWRITEQUEUETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class BleWriteQueueTestSuite: public testing::Test {
+
+public:
+    BleWriteQueueTestSuite();
+
+    /**
+     * @brief Test that queued setpoints with the same key are replaced in place, in FIFO order
+     */
+    void test_coalescing();
+
+    /**
+     * @brief Test that writes without response complete as soon as they are sent
+     */
+    void test_withoutResponse();
+
+    /**
+     * @brief Test that a write never confirmed completes on the timeout and lets the next one go, and that a late
+     * ack of the timed out write doesn't complete the next one
+     */
+    void test_timeout();
+
+    /**
+     * @brief Test that a control point write waits for the 0x80 response with its own opcode
+     */
+    void test_responseMatching();
+};
+
+TEST_F(BleWriteQueueTestSuite, TestCoalescing) {
+    this->test_coalescing();
+}
+
+TEST_F(BleWriteQueueTestSuite, TestWithoutResponse) {
+    this->test_withoutResponse();
+}
+
+TEST_F(BleWriteQueueTestSuite, TestTimeout) {
+    this->test_timeout();
+}
+
+TEST_F(BleWriteQueueTestSuite, TestResponseMatching) {
+    this->test_responseMatching();
+}
+
+#endif // BLEWRITEQUEUETESTSUITE_H
@@ -0,0 +1,120 @@
+#include "characteristicencodertestsuite.h"
+
+#include <QByteArray>
+
+#include "characteristics/characteristicencoder.h"
+
+// The expected payloads below are the bytes produced by the QByteArray::append based notifiers
+// the encoders replaced, so any change here is a change of the on-air protocol.
+
+template <typename Buffer> static QByteArray toByteArray(const Buffer &buffer) {
+    QByteArray out;
+    buffer.appendTo(out);
+    return out;
+}
+
+CharacteristicEncoderTestSuite::CharacteristicEncoderTestSuite() {}
+
+void CharacteristicEncoderTestSuite::test_indoorBikeData() {
+    CharacteristicEncoder::IndoorBikeData::Fields fields;
+    fields.speed = 25.37;
+    fields.cadence = 90 * 2.0;
+    fields.resistance = 12;
+    fields.watts = 215;
+    fields.heart = 142;
+
+    CharacteristicEncoder::IndoorBikeData::Buffer buffer;
+    CharacteristicEncoder::IndoorBikeData::encode(fields, buffer);
+    EXPECT_EQ(buffer.size(), CharacteristicEncoder::IndoorBikeData::size);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("6402e909b4000c00d7008e00"));
+
+    fields.watts = -5;
+    fields.resistance = 0;
+    buffer.clear();
+    CharacteristicEncoder::IndoorBikeData::encode(fields, buffer);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("6402e909b400000000008e00"));
+}
+
+void CharacteristicEncoderTestSuite::test_treadmillData() {
+    CharacteristicEncoder::TreadmillData::Fields fields;
+    fields.speed = 10.5;
+    fields.distance = 3.2;
+    fields.inclination = 2.5;
+    fields.ramp = 1.4321;
+    fields.heart = 150;
+
+    CharacteristicEncoder::TreadmillData::Buffer buffer;
+    CharacteristicEncoder::TreadmillData::encode(fields, buffer);
+    EXPECT_EQ(buffer.size(), CharacteristicEncoder::TreadmillData::size);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("0c011a04800c0019000e0096"));
+
+    fields.inclination = -1.0;
+    fields.ramp = -0.5729;
+    buffer.clear();
+    CharacteristicEncoder::TreadmillData::encode(fields, buffer);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("0c011a04800c00f6fffaff96"));
+}
+
+void CharacteristicEncoderTestSuite::test_rowerData() {
+    CharacteristicEncoder::RowerData::Fields fields;
+    fields.strokeRate = 28;
+    fields.strokeCount = 300;
+    fields.distance = 1.5;
+    fields.pace = 125;
+    fields.watts = 180;
+    fields.calories = 45;
+    fields.heart = 130;
+
+    CharacteristicEncoder::RowerData::Buffer buffer;
+    CharacteristicEncoder::RowerData::encode(fields, buffer);
+    EXPECT_EQ(buffer.size(), CharacteristicEncoder::RowerData::size);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("2c03382c01dc05007d00b4002d002d002d8200"));
+}
+
+void CharacteristicEncoderTestSuite::test_cyclingPowerMeasurement() {
+    CharacteristicEncoder::CyclingPowerMeasurement::Fields fields;
+    fields.watts = 250;
+    fields.wheelRevolutions = 1000 * 3;
+    fields.lastWheelEventTime = 1500 * 2;
+    fields.crankRevolutions = 1000;
+    fields.lastCrankEventTime = 1500;
+
+    CharacteristicEncoder::CyclingPowerMeasurement::Buffer buffer;
+    CharacteristicEncoder::CyclingPowerMeasurement::encode(fields, buffer);
+    EXPECT_EQ(buffer.size(), CharacteristicEncoder::CyclingPowerMeasurement::size);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("3000fa00b80b0000b80be803dc05"));
+}
+
+void CharacteristicEncoderTestSuite::test_cscMeasurement() {
+    CharacteristicEncoder::CscMeasurement::Fields fields;
+    fields.crankRevolutions = 1000;
+    fields.lastCrankEventTime = 1500;
+
+    CharacteristicEncoder::CscMeasurement::Buffer buffer;
+    CharacteristicEncoder::CscMeasurement::encode(fields, buffer);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("02e803dc05"));
+
+    fields.wheel = true;
+    fields.wheelRevolutions = 10;
+    fields.lastWheelEventTime = 512;
+    buffer.clear();
+    CharacteristicEncoder::CscMeasurement::encode(fields, buffer);
+    EXPECT_EQ(buffer.size(), CharacteristicEncoder::CscMeasurement::size);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("030a0000000002e803dc05"));
+}
+
+void CharacteristicEncoderTestSuite::test_rscAndHeartRateMeasurement() {
+    CharacteristicEncoder::RscMeasurement::Fields fields;
+    fields.speed = 12;
+    fields.cadence = 170;
+    fields.distance = 2.5;
+
+    CharacteristicEncoder::RscMeasurement::Buffer buffer;
+    CharacteristicEncoder::RscMeasurement::encode(fields, buffer);
+    EXPECT_EQ(buffer.size(), CharacteristicEncoder::RscMeasurement::size);
+    EXPECT_EQ(toByteArray(buffer).toHex(), QByteArray("025503aaa8610000"));
+
+    CharacteristicEncoder::HeartRateMeasurement::Buffer bufferHR;
+    CharacteristicEncoder::HeartRateMeasurement::encode(142, bufferHR);
+    EXPECT_EQ(toByteArray(bufferHR).toHex(), QByteArray("008e"));
+}
@@ -0,0 +1,66 @@
+#ifndef CHARACTERISTICENCODERTESTSUITE_H
+#define CHARACTERISTICENCODERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class CharacteristicEncoderTestSuite: public testing::Test {
+
+public:
+    CharacteristicEncoderTestSuite();
+
+    /**
+     * @brief Test the 0x2AD2 Indoor Bike Data layout, including negative power clamping
+     */
+    void test_indoorBikeData();
+
+    /**
+     * @brief Test the 0x2ACD Treadmill Data layout for positive and negative inclinations
+     */
+    void test_treadmillData();
+
+    /**
+     * @brief Test the 0x2AD1 Rower Data layout
+     */
+    void test_rowerData();
+
+    /**
+     * @brief Test the 0x2A63 Cycling Power Measurement layout
+     */
+    void test_cyclingPowerMeasurement();
+
+    /**
+     * @brief Test the 0x2A5B CSC Measurement layout with and without wheel data
+     */
+    void test_cscMeasurement();
+
+    /**
+     * @brief Test the 0x2A53 RSC Measurement and 0x2A37 Heart Rate Measurement layouts
+     */
+    void test_rscAndHeartRateMeasurement();
+};
+
+TEST_F(CharacteristicEncoderTestSuite, TestIndoorBikeData) {
+    this->test_indoorBikeData();
+}
+
+TEST_F(CharacteristicEncoderTestSuite, TestTreadmillData) {
+    this->test_treadmillData();
+}
+
+TEST_F(CharacteristicEncoderTestSuite, TestRowerData) {
+    this->test_rowerData();
+}
+
+TEST_F(CharacteristicEncoderTestSuite, TestCyclingPowerMeasurement) {
+    this->test_cyclingPowerMeasurement();
+}
+
+TEST_F(CharacteristicEncoderTestSuite, TestCscMeasurement) {
+    this->test_cscMeasurement();
+}
+
+TEST_F(CharacteristicEncoderTestSuite, TestRscAndHeartRateMeasurement) {
+    this->test_rscAndHeartRateMeasurement();
+}
+
+#endif // CHARACTERISTICENCODERTESTSUITE_H
@@ -0,0 +1,114 @@
+#include "chartseriescachetestsuite.h"
+
+#include <QVector>
+#include <math.h>
+
+#include "chartseriescache.h"
+
+namespace {
+
+// a power like series: waves, intervals and noise
+QVector<double> series(int samples) {
+    QVector<double> values;
+    quint32 seed = 4321;
+    for (int s = 0; s < samples; s++) {
+        seed = seed * 1103515245u + 12345u;
+        double noise = (int)((seed >> 16) % 41) - 20;
+        values.append(200 + 80 * sin(s / 53.0) + ((s / 240) % 2 ? 120 : 0) + noise);
+    }
+    return values;
+}
+
+ChartSeriesCache cacheOf(const QVector<double> &values) {
+    ChartSeriesCache cache;
+    for (double v : values)
+        cache.append(v);
+    return cache;
+}
+
+// the points of a range as the cache must reduce it, from a scan of the samples
+QVector<QPointF> expectedPoints(const QVector<double> &values, int from, int to, int maxPoints) {
+    QVector<QPointF> out;
+    const int parts = qMax(maxPoints / 2, 1);
+    const int length = (to - from + parts - 1) / parts;
+    for (int i = from; i < to; i += length) {
+        int minIndex = i;
+        int maxIndex = i;
+        for (int j = i + 1; j < qMin(i + length, to); j++) {
+            if ((float)values.at(j) < (float)values.at(minIndex))
+                minIndex = j;
+            if ((float)values.at(j) > (float)values.at(maxIndex))
+                maxIndex = j;
+        }
+        if (maxPoints == 1) {
+            out.append(QPointF(maxIndex, (float)values.at(maxIndex)));
+        } else if (minIndex == maxIndex) {
+            out.append(QPointF(minIndex, (float)values.at(minIndex)));
+        } else {
+            out.append(QPointF(qMin(minIndex, maxIndex), (float)values.at(qMin(minIndex, maxIndex))));
+            out.append(QPointF(qMax(minIndex, maxIndex), (float)values.at(qMax(minIndex, maxIndex))));
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+ChartSeriesCacheTestSuite::ChartSeriesCacheTestSuite() {}
+
+void ChartSeriesCacheTestSuite::test_rawRange() {
+    QVector<double> values = series(500);
+    ChartSeriesCache cache = cacheOf(values);
+
+    QVector<QPointF> points = cache.points(100, 400, 300);
+    ASSERT_EQ(points.size(), 300);
+    for (int i = 0; i < points.size(); i++) {
+        EXPECT_EQ(points.at(i).x(), 100 + i);
+        EXPECT_FLOAT_EQ(points.at(i).y(), (float)values.at(100 + i));
+    }
+
+    // the range is clipped to the session
+    EXPECT_EQ(cache.points(-50, 10000, 1000).size(), 500);
+    EXPECT_TRUE(cache.points(300, 300, 10).isEmpty());
+    EXPECT_TRUE(cache.points(0, 500, 0).isEmpty());
+}
+
+void ChartSeriesCacheTestSuite::test_levels() {
+    QVector<double> values = series(20000);
+    ChartSeriesCache cache = cacheOf(values);
+
+    // parts of a few samples, of whole buckets of every level, and not aligned on the buckets
+    const int ranges[][3] = {{0, 20000, 10},   {0, 20000, 600},  {0, 16384, 8},     {4096, 12288, 4},
+                             {7, 19993, 37},   {1000, 1400, 100}, {123, 18000, 2000}, {5000, 20000, 3}};
+    for (const auto &r : ranges) {
+        QVector<QPointF> points = cache.points(r[0], r[1], r[2]);
+        QVector<QPointF> expected = expectedPoints(values, r[0], r[1], r[2]);
+        ASSERT_EQ(points.size(), expected.size()) << r[0] << " " << r[1] << " " << r[2];
+        for (int i = 0; i < points.size(); i++) {
+            EXPECT_EQ(points.at(i).x(), expected.at(i).x()) << r[0] << " " << r[1] << " " << r[2];
+            EXPECT_FLOAT_EQ(points.at(i).y(), expected.at(i).y()) << r[0] << " " << r[1] << " " << r[2];
+        }
+    }
+}
+
+void ChartSeriesCacheTestSuite::test_maxPoints() {
+    // 8 hours: the parts are larger than the coarsest buckets (4096 samples) with few points
+    QVector<double> values = series(8 * 3600);
+    values[12345] = 2000;
+    ChartSeriesCache cache = cacheOf(values);
+
+    const int maxPoints[] = {1, 2, 3, 5, 6, 7, 10, 31, 300, 1000, 5000};
+    for (int m : maxPoints) {
+        QVector<QPointF> points = cache.points(0, values.size(), m);
+        EXPECT_GT(points.size(), 0) << m;
+        EXPECT_LE(points.size(), m) << m;
+        for (int i = 1; i < points.size(); i++)
+            EXPECT_LT(points.at(i - 1).x(), points.at(i).x()) << m;
+
+        // the peak is kept at every resolution
+        bool peak = false;
+        for (const QPointF &p : points)
+            peak |= p.x() == 12345 && p.y() == 2000;
+        EXPECT_TRUE(peak) << m;
+    }
+}
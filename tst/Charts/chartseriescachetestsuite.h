@@ -0,0 +1,40 @@
+#ifndef CHARTSERIESCACHETESTSUITE_H
+#define CHARTSERIESCACHETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class ChartSeriesCacheTestSuite: public testing::Test {
+
+public:
+    ChartSeriesCacheTestSuite();
+
+    /**
+     * @brief Test that a range not larger than maxPoints is returned sample by sample
+     */
+    void test_rawRange();
+
+    /**
+     * @brief Test that every part of a reduced range is its min and max, against a scan of the samples, for ranges
+     * read from the cached levels, their edges and the samples
+     */
+    void test_levels();
+
+    /**
+     * @brief Test that no range gets more than maxPoints points, up to the coarsest level and beyond it
+     */
+    void test_maxPoints();
+};
+
+TEST_F(ChartSeriesCacheTestSuite, TestRawRange) {
+    this->test_rawRange();
+}
+
+TEST_F(ChartSeriesCacheTestSuite, TestLevels) {
+    this->test_levels();
+}
+
+TEST_F(ChartSeriesCacheTestSuite, TestMaxPoints) {
+    this->test_maxPoints();
+}
+
+#endif // CHARTSERIESCACHETESTSUITE_H
@@ -0,0 +1,76 @@
+#include "computrainertestsuite.h"
+
+#include "devices/computrainerbike/Computrainer.h"
+
+namespace {
+
+// a stroke with left for the 12 samples of the left leg and right for the 12 of the right one
+ComputrainerTelemetry stroke(uint8_t left, uint8_t right) {
+    ComputrainerTelemetry t;
+    for (int i = 0; i < 24; i++)
+        t.spinScan[i] = i < 12 ? left : right;
+    return t;
+}
+
+} // namespace
+
+ComputrainerTestSuite::ComputrainerTestSuite() {}
+
+void ComputrainerTestSuite::test_pedalSmoothness() {
+    double smoothness = 0, rightBalance = 0;
+
+    // the same force all the way round
+    ASSERT_TRUE(stroke(10, 10).pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(smoothness, 100);
+
+    // one leg only: half of the stroke at the peak
+    ASSERT_TRUE(stroke(20, 0).pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(smoothness, 50);
+
+    ASSERT_TRUE(stroke(10, 20).pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(smoothness, 75);
+
+    // a single push
+    ComputrainerTelemetry t;
+    t.spinScan[5] = 48;
+    ASSERT_TRUE(t.pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(smoothness, 100.0 * 2 / 48);
+
+    // a realistic stroke: the downstroke of each leg peaks at 90 degrees
+    const uint8_t leg[12] = {8, 20, 34, 42, 40, 30, 18, 8, 3, 1, 1, 3};
+    double sum = 0;
+    for (int i = 0; i < 12; i++) {
+        t.spinScan[i] = leg[i];
+        t.spinScan[i + 12] = leg[i];
+        sum += 2 * leg[i];
+    }
+    ASSERT_TRUE(t.pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(smoothness, 100.0 * (sum / 24) / 42);
+    EXPECT_DOUBLE_EQ(rightBalance, 50);
+}
+
+void ComputrainerTestSuite::test_balance() {
+    double smoothness = 0, rightBalance = 0;
+
+    ASSERT_TRUE(stroke(10, 10).pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(rightBalance, 50);
+    ASSERT_TRUE(stroke(20, 0).pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(rightBalance, 0);
+    ASSERT_TRUE(stroke(0, 20).pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(rightBalance, 100);
+    ASSERT_TRUE(stroke(10, 20).pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(rightBalance, 100.0 * 240 / 360);
+
+    // the first 12 samples are the left leg
+    ComputrainerTelemetry t;
+    t.spinScan[11] = 30;
+    t.spinScan[12] = 10;
+    ASSERT_TRUE(t.pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(rightBalance, 25);
+
+    // no force: nothing to show, the previous values are left as they are
+    smoothness = rightBalance = -1;
+    EXPECT_FALSE(ComputrainerTelemetry().pedalStroke(smoothness, rightBalance));
+    EXPECT_DOUBLE_EQ(smoothness, -1);
+    EXPECT_DOUBLE_EQ(rightBalance, -1);
+}
@@ -0,0 +1,30 @@
+#ifndef COMPUTRAINERTESTSUITE_H
+#define COMPUTRAINERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class ComputrainerTestSuite: public testing::Test {
+
+public:
+    ComputrainerTestSuite();
+
+    /**
+     * @brief Test the pedal smoothness of a SpinScan pedal stroke: average over peak force
+     */
+    void test_pedalSmoothness();
+
+    /**
+     * @brief Test the left/right balance of a SpinScan pedal stroke, and that a stroke without force is ignored
+     */
+    void test_balance();
+};
+
+TEST_F(ComputrainerTestSuite, TestPedalSmoothness) {
+    this->test_pedalSmoothness();
+}
+
+TEST_F(ComputrainerTestSuite, TestBalance) {
+    this->test_balance();
+}
+
+#endif // COMPUTRAINERTESTSUITE_H
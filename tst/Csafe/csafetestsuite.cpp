@@ -0,0 +1,160 @@
+#include "csafetestsuite.h"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "devices/csafe/csafe.h"
+#include "devices/csafe/serialport.h"
+
+// Builds a standard frame around the payload: checksum, byte stuffing, start and stop flags.
+static QByteArray standardFrame(const QVector<quint8> &payload) {
+    QByteArray frame;
+    quint8 checksum = 0;
+    frame.append((char)0xF1);
+    QVector<quint8> body = payload;
+    for (quint8 b : payload)
+        checksum ^= b;
+    body.append(checksum);
+    for (quint8 b : body) {
+        if (b >= 0xF0 && b <= 0xF3) {
+            frame.append((char)0xF3);
+            frame.append((char)(b & 0x03));
+        } else {
+            frame.append((char)b);
+        }
+    }
+    frame.append((char)0xF2);
+    return frame;
+}
+
+CsafeTestSuite::CsafeTestSuite() {}
+
+void CsafeTestSuite::test_readFrame() {
+    csafe c;
+    // status, speed 12.5 (125 in 0.1 km/h units), power 180 W, heart rate 131, calories 42
+    CsafeFrame frame = c.readFrame(standardFrame({0x09, 0xA5, 0x03, 0x7D, 0x00, 0x3B, 0xB4, 0x03, 0xB4, 0x00, 0x58,
+                                                  0xB0, 0x01, 0x83, 0xA3, 0x02, 0x2A, 0x00}));
+
+    ASSERT_TRUE(frame.valid);
+    EXPECT_EQ(frame.status, 0x09);
+    ASSERT_EQ(frame.responses.size(), 4);
+
+    const CsafeResponse *speed = frame.find(csafe::CSAFE_GETSPEED_CMD);
+    ASSERT_NE(speed, nullptr);
+    EXPECT_STREQ(speed->name, "CSAFE_GETSPEED_CMD");
+    EXPECT_EQ(speed->count, 2);
+    EXPECT_EQ(speed->value(0), 125);
+    EXPECT_EQ(speed->value(1), 0x3B);
+    EXPECT_EQ(frame.find(csafe::CSAFE_GETPOWER_CMD)->value(0), 180);
+    EXPECT_EQ(frame.find(csafe::CSAFE_GETHRCUR_CMD)->value(0), 131);
+    EXPECT_EQ(frame.find(csafe::CSAFE_GETCALORIES_CMD)->value(0), 42);
+    EXPECT_EQ(frame.find(csafe::CSAFE_GETCADENCE_CMD), nullptr);
+
+    QVariantMap map = frame.toVariantMap();
+    EXPECT_EQ(map["CSAFE_GETSTATUS_CMD"].toList().value(0).toInt(), 0x09);
+    EXPECT_EQ(map["CSAFE_GETPOWER_CMD"].toList().value(0).toInt(), 180);
+
+    // the QVariantMap interface decodes the same frame
+    QByteArray raw = standardFrame({0x09, 0xB4, 0x03, 0xB4, 0x00, 0x58});
+    QVector<quint8> transmission;
+    for (char b : raw)
+        transmission.append((quint8)b);
+    EXPECT_EQ(c.read(transmission)["CSAFE_GETPOWER_CMD"].toList().value(0).toInt(), 180);
+}
+
+void CsafeTestSuite::test_readWrappedFrame() {
+    csafe c;
+    // CSAFE_SETUSERCFG1_CMD wrapping work time 0x00001234 and work distance 0x00000BB8
+    CsafeFrame frame = c.readFrame(standardFrame({0x01, 0x1A, 0x0E, 0xA0, 0x05, 0x34, 0x12, 0x00, 0x00, 0x00, 0xA3,
+                                                  0x05, 0xB8, 0x0B, 0x00, 0x00, 0x00, 0xA7, 0x03, 0x16, 0x00, 0x54}));
+
+    ASSERT_TRUE(frame.valid);
+    ASSERT_EQ(frame.responses.size(), 3);
+    EXPECT_EQ(frame.find(csafe::CSAFE_PM_GET_WORKTIME)->value(0), 0x1234);
+    EXPECT_EQ(frame.find(csafe::CSAFE_PM_GET_WORKDISTANCE)->value(0), 3000);
+    // the command after the wrapper is no longer wrapped
+    EXPECT_EQ(frame.find(csafe::CSAFE_GETCADENCE_CMD)->value(0), 22);
+}
+
+void CsafeTestSuite::test_stuffingAndChecksum() {
+    csafe c;
+    // 0xF1 in the power value has to be stuffed
+    QByteArray raw = standardFrame({0x09, 0xB4, 0x03, 0xF1, 0x00, 0x58});
+    EXPECT_TRUE(raw.contains(QByteArray::fromHex("f301")));
+    EXPECT_EQ(c.readFrame(raw).find(csafe::CSAFE_GETPOWER_CMD)->value(0), 0xF1);
+
+    raw[raw.size() - 2] = raw[raw.size() - 2] ^ 0x01;
+    EXPECT_FALSE(c.readFrame(raw).valid);
+    EXPECT_FALSE(c.readFrame(QByteArray::fromHex("f10980")).valid); // no stop flag
+}
+
+void CsafeTestSuite::test_serialRoundTrip() {
+#if defined(Q_OS_ANDROID) || defined(WIN32)
+    SUCCEED() << "pseudo terminals are not available";
+#else
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    ASSERT_NE(master, -1);
+    ASSERT_EQ(grantpt(master), 0);
+    ASSERT_EQ(unlockpt(master), 0);
+    struct termios settings;
+    tcgetattr(master, &settings);
+    cfmakeraw(&settings);
+    tcsetattr(master, TCSANOW, &settings);
+
+    Serialport port(QString::fromLatin1(ptsname(master)), 9600);
+    port.setEndChar(0xF2);
+    port.setTimeout(1200);
+    ASSERT_EQ(port.openPort(), 0);
+
+    // the fake slave answers every request with a power response, after a short delay on every other one so
+    // the reader has to wait for the data instead of finding it already there
+    const QByteArray response = standardFrame({0x09, 0xB4, 0x03, 0xB4, 0x00, 0x58});
+    const int rounds = 20;
+    std::atomic<bool> stop{false};
+    std::thread slave([&] {
+        int answered = 0;
+        char buffer[256];
+        while (!stop && answered < rounds) {
+            struct pollfd pfd = {master, POLLIN, 0};
+            if (poll(&pfd, 1, 100) <= 0)
+                continue;
+            int n = read(master, buffer, sizeof(buffer));
+            if (n > 0 && (quint8)buffer[n - 1] == 0xF2) {
+                if (answered % 2)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                EXPECT_EQ((int)write(master, response.constData(), response.size()), response.size());
+                answered++;
+            }
+        }
+    });
+
+    csafe c;
+    QByteArray request = c.write(QStringList() << "CSAFE_GETPOWER_CMD");
+    QVector<qint64> latencies;
+    uint8_t rx[120];
+    for (int i = 0; i < rounds; i++) {
+        QElapsedTimer timer;
+        timer.start();
+        ASSERT_EQ(port.rawWrite((uint8_t *)request.data(), request.size()), request.size());
+        int rc = port.rawRead(rx, sizeof(rx), true);
+        latencies.append(timer.nsecsElapsed());
+        ASSERT_EQ(rc, response.size());
+        EXPECT_EQ(c.readFrame(QByteArray((const char *)rx, rc)).find(csafe::CSAFE_GETPOWER_CMD)->value(0), 180);
+    }
+    stop = true;
+    slave.join();
+    port.closePort();
+    close(master);
+
+    std::sort(latencies.begin(), latencies.end());
+    qint64 median = latencies[latencies.size() / 2];
+    qint64 worst = latencies.last();
+    qDebug() << "CSAFE round trip over a pty: median" << median / 1000 << "us, worst" << worst / 1000 << "us";
+    // sleeping 50 ms whenever no byte was ready put every delayed answer at 50 ms or more
+    EXPECT_LT(worst, 40 * 1000000LL);
+#endif
+}
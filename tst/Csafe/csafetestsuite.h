@@ -0,0 +1,48 @@
+#ifndef CSAFETESTSUITE_H
+#define CSAFETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class CsafeTestSuite: public testing::Test {
+
+public:
+    CsafeTestSuite();
+
+    /**
+     * @brief Test decoding a standard frame into the typed responses of the response table
+     */
+    void test_readFrame();
+
+    /**
+     * @brief Test decoding the PM3 specific responses wrapped in CSAFE_SETUSERCFG1_CMD
+     */
+    void test_readWrappedFrame();
+
+    /**
+     * @brief Test byte unstuffing and the rejection of frames with a wrong checksum
+     */
+    void test_stuffingAndChecksum();
+
+    /**
+     * @brief Test the round trip latency of the serial port transport against a pseudo terminal slave
+     */
+    void test_serialRoundTrip();
+};
+
+TEST_F(CsafeTestSuite, TestReadFrame) {
+    this->test_readFrame();
+}
+
+TEST_F(CsafeTestSuite, TestReadWrappedFrame) {
+    this->test_readWrappedFrame();
+}
+
+TEST_F(CsafeTestSuite, TestStuffingAndChecksum) {
+    this->test_stuffingAndChecksum();
+}
+
+TEST_F(CsafeTestSuite, TestSerialRoundTrip) {
+    this->test_serialRoundTrip();
+}
+
+#endif // CSAFETESTSUITE_H
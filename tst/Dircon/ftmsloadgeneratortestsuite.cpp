@@ -0,0 +1,139 @@
+#include "ftmsloadgeneratortestsuite.h"
+
+#include <QDebug>
+
+#include "Tools/testsettings.h"
+#include "characteristics/characteristicnotifier2ad2.h"
+#include "characteristics/characteristicnotifier2ad9.h"
+#include "characteristics/characteristicwriteprocessor2ad9.h"
+#include "devices/dircon/dirconmanager.h"
+#include "devices/dircon/ftmsloadgenerator.h"
+#include "devices/fakebike/fakebike.h"
+#include "devices/ftmsbike/ftmsbike.h"
+#include "qzsettings.h"
+
+FtmsLoadGeneratorTestSuite::FtmsLoadGeneratorTestSuite() {}
+
+void FtmsLoadGeneratorTestSuite::test_randomCommand() {
+    quint32 seed = 7, again = 7;
+    QHash<quint8, int> bikeOpcodes;
+    for (int i = 0; i < 1000; i++) {
+        QByteArray command = FtmsLoadGenerator::randomCommand(seed, false);
+        ASSERT_EQ(command, FtmsLoadGenerator::randomCommand(again, false));
+        quint8 opcode = command.at(0);
+        bikeOpcodes[opcode]++;
+        switch (opcode) {
+        case FTMS_REQUEST_CONTROL:
+            EXPECT_EQ(command.size(), 1);
+            break;
+        case FTMS_SET_TARGET_POWER: {
+            ASSERT_EQ(command.size(), 3);
+            quint16 watts = (quint8)command.at(1) | ((quint8)command.at(2) << 8);
+            EXPECT_GE(watts, 50);
+            EXPECT_LE(watts, 450);
+            break;
+        }
+        case FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS: {
+            ASSERT_EQ(command.size(), 7);
+            qint16 grade = (qint16)((quint8)command.at(3) | ((quint8)command.at(4) << 8));
+            EXPECT_GE(grade, -1000);
+            EXPECT_LE(grade, 1500);
+            break;
+        }
+        case FTMS_SET_TARGET_RESISTANCE_LEVEL:
+            ASSERT_EQ(command.size(), 2);
+            EXPECT_GT(command.at(1), 0);
+            break;
+        default:
+            FAIL() << "unexpected opcode " << (int)opcode;
+        }
+    }
+    EXPECT_EQ(bikeOpcodes.size(), 4);
+
+    QHash<quint8, int> treadmillOpcodes;
+    for (int i = 0; i < 1000; i++) {
+        QByteArray command = FtmsLoadGenerator::randomCommand(seed, true);
+        quint8 opcode = command.at(0);
+        treadmillOpcodes[opcode]++;
+        if (opcode == FTMS_SET_TARGET_SPEED || opcode == FTMS_SET_TARGET_INCLINATION)
+            EXPECT_EQ(command.size(), 3);
+        else
+            EXPECT_EQ(opcode, FTMS_REQUEST_CONTROL);
+    }
+    EXPECT_EQ(treadmillOpcodes.size(), 3);
+}
+
+void FtmsLoadGeneratorTestSuite::test_direct() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    fakebike bike(false, true, true);
+    CharacteristicNotifier2AD9 notif2AD9(&bike);
+    CharacteristicNotifier2AD2 notif2AD2(&bike);
+    CharacteristicWriteProcessor2AD9 writeProcessor(1.0, 4, &bike, &notif2AD9);
+
+    FtmsLoadGenerator::Config config;
+    config.rate = 200;
+    FtmsLoadGenerator generator(config);
+    const int clients = 3;
+    for (int i = 0; i < clients; i++)
+        generator.addClient(new DirectLoadTransport(&writeProcessor, {&notif2AD2, &notif2AD9}, 50));
+    FtmsLoadGenerator::Report report = generator.run(1000);
+    qDebug().noquote() << report.toString();
+
+    EXPECT_EQ(report.clients, clients);
+    EXPECT_EQ(report.failedClients, 0);
+    // the timer of the generator is late more often than not on a busy machine: half of the rate is enough
+    EXPECT_GT(report.writes, (quint64)(clients * config.rate / 2));
+    EXPECT_EQ(report.responses, report.writes);
+    EXPECT_EQ(report.dropped, 0u);
+    EXPECT_EQ(report.reordered, 0u);
+    EXPECT_EQ(report.unexpected, 0u);
+    EXPECT_EQ(report.errors, 0u);
+    EXPECT_GT(report.notificationsByUuid.value(0x2AD2), 0u);
+    // the last answer of the control point is notified too
+    EXPECT_GT(report.notificationsByUuid.value(0x2AD9), 0u);
+    EXPECT_LT(report.latencyP99Ms, 200);
+}
+
+void FtmsLoadGeneratorTestSuite::test_dircon() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    // away from the port of an app running on the same machine
+    const quint16 port = 46866;
+    testSettings.qsettings.setValue(QZSettings::dircon_server_base_port, port);
+    testSettings.qsettings.setValue(QZSettings::race_mode, true);
+    testSettings.qsettings.setValue(QZSettings::wahoo_rgt_dircon, true);
+
+    fakebike bike(false, true, true);
+    DirconManager dircon(&bike);
+
+    FtmsLoadGenerator::Config config;
+    config.rate = 100;
+    config.seed = 42;
+    FtmsLoadGenerator generator(config);
+    const int clients = 4;
+    QList<DirconLoadTransport *> transports;
+    for (int i = 0; i < clients; i++) {
+        transports.append(new DirconLoadTransport(QStringLiteral("127.0.0.1"), port));
+        generator.addClient(transports.last());
+    }
+    FtmsLoadGenerator::Report report = generator.run(2000);
+    qDebug().noquote() << report.toString();
+
+    for (DirconLoadTransport *transport : transports) {
+        EXPECT_TRUE(transport->characteristics().value(0x2AD9) & DPKT_CHAR_PROP_FLAG_WRITE);
+        EXPECT_TRUE(transport->characteristics().value(0x2AD2) & DPKT_CHAR_PROP_FLAG_NOTIFY);
+    }
+    EXPECT_EQ(report.failedClients, 0);
+    EXPECT_GT(report.writes, (quint64)(clients * config.rate / 2));
+    EXPECT_EQ(report.dropped, 0u);
+    EXPECT_EQ(report.reordered, 0u);
+    EXPECT_EQ(report.unexpected, 0u);
+    EXPECT_EQ(report.errors, 0u);
+    EXPECT_EQ(report.responses, report.writes);
+    // race mode notifies every 100 ms, and with wahoo_rgt_dircon only what the clients enabled
+    EXPECT_GT(report.notificationsByUuid.value(0x2AD2), (quint64)clients * 5);
+    EXPECT_GT(report.notificationsByUuid.value(0x2A63), 0u);
+    EXPECT_LT(report.latencyP99Ms, 500);
+}
@@ -0,0 +1,40 @@
+#ifndef FTMSLOADGENERATORTESTSUITE_H
+#define FTMSLOADGENERATORTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class FtmsLoadGeneratorTestSuite: public testing::Test {
+
+public:
+    FtmsLoadGeneratorTestSuite();
+
+    /**
+     * @brief Test that the random commands are valid FTMS control point writes, and the same for the same seed
+     */
+    void test_randomCommand();
+
+    /**
+     * @brief Test several clients on the write processor of a bike, without a socket: every write answered, in order
+     */
+    void test_direct();
+
+    /**
+     * @brief Test several clients on the DirCon server of a fake bike over local TCP: discovery, notifications,
+     * answers in order and their latency
+     */
+    void test_dircon();
+};
+
+TEST_F(FtmsLoadGeneratorTestSuite, TestRandomCommand) {
+    this->test_randomCommand();
+}
+
+TEST_F(FtmsLoadGeneratorTestSuite, TestDirect) {
+    this->test_direct();
+}
+
+TEST_F(FtmsLoadGeneratorTestSuite, TestDircon) {
+    this->test_dircon();
+}
+
+#endif // FTMSLOADGENERATORTESTSUITE_H
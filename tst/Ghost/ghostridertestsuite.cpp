@@ -0,0 +1,158 @@
+#include "ghostridertestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QVector>
+#include <math.h>
+
+#include "Tools/testsettings.h"
+#include "ghostrider.h"
+#include "qfit.h"
+
+namespace {
+
+// speed in km/h of the test rides after seconds
+double rideSpeed(int seconds) { return 30 + 8 * sin(seconds / 300.0); }
+double rideWatts(int seconds) { return 200 + 50 * sin(seconds / 120.0); }
+
+// the distance at seconds by a linear scan of the records
+double linearDistanceAt(const QVector<double> &t, const QVector<double> &d, double seconds) {
+    if (seconds <= t.first())
+        return d.first();
+    for (int i = 1; i < t.size(); i++)
+        if (seconds < t.at(i))
+            return d.at(i - 1) + (d.at(i) - d.at(i - 1)) * (seconds - t.at(i - 1)) / (t.at(i) - t.at(i - 1));
+    return d.last();
+}
+
+} // namespace
+
+GhostRiderTestSuite::GhostRiderTestSuite() {}
+
+void GhostRiderTestSuite::test_lookup() {
+    GhostRider ghost;
+    EXPECT_FALSE(ghost.isLoaded());
+    EXPECT_FALSE(ghost.gap(10, 0.1, 100).valid);
+
+    QVector<double> t, d;
+    double distance = 0;
+    for (int s = 0; s <= 3600; s++) {
+        distance += rideSpeed(s) / 3600.0;
+        ghost.append(s, distance, rideWatts(s));
+        t.append(s);
+        d.append(distance);
+    }
+    // repeated and out of order records are ignored
+    ghost.append(3600, distance + 1, 0);
+    ghost.append(1000, distance + 1, 0);
+    ASSERT_EQ(ghost.size(), 3601);
+    EXPECT_NEAR(ghost.length(), distance, 1e-4);
+    EXPECT_EQ(ghost.duration(), 3600);
+
+    for (double s = -5; s < 3700; s += 7.3) {
+        EXPECT_NEAR(ghost.distanceAt(s), linearDistanceAt(t, d, s), 1e-4) << s;
+        if (s >= 0 && s <= 3600)
+            EXPECT_NEAR(ghost.secondsAt(ghost.distanceAt(s)), s, 0.01) << s;
+    }
+    EXPECT_EQ(ghost.secondsAt(distance + 0.1), -1);
+    EXPECT_EQ(ghost.secondsAt(0), 0);
+    EXPECT_EQ(ghost.wattsAt(120.5), (quint16)rideWatts(120));
+
+    // a pause of 10 minutes and a stop without moving are not in the timeline
+    GhostRider paused;
+    paused.append(0, 0, 100);
+    paused.append(1, 0.01, 100);
+    paused.append(601, 0.0101, 0);
+    paused.append(602, 0.02, 100);
+    paused.append(603, 0.02, 0);
+    paused.append(604, 0.015, 0);
+    EXPECT_EQ(paused.size(), 6);
+    EXPECT_EQ(paused.duration(), 5);
+    // the distance never goes back
+    EXPECT_NEAR(paused.distanceAt(5), 0.02, 1e-6);
+}
+
+void GhostRiderTestSuite::test_gap() {
+    GhostRider ghost;
+    // 36 km/h, 10 m a second, at 250 W
+    for (int s = 0; s <= 600; s++)
+        ghost.append(s, s * 0.01, 250);
+
+    // at 60 s: 50 m behind, the ghost was there 5 s earlier
+    GhostRider::Gap g = ghost.gap(60, 0.55, 230);
+    ASSERT_TRUE(g.valid);
+    EXPECT_NEAR(g.meters, -50, 0.01);
+    EXPECT_NEAR(g.seconds, -5, 0.01);
+    EXPECT_NEAR(g.watts, -20, 0.01);
+
+    // ahead
+    g = ghost.gap(60, 0.62, 300);
+    EXPECT_NEAR(g.meters, 20, 0.01);
+    EXPECT_NEAR(g.seconds, 2, 0.01);
+    EXPECT_NEAR(g.watts, 50, 0.01);
+
+    // past the end of the ghost the time gap is unknown, the distance gap isn't
+    g = ghost.gap(500, 6.5, 250);
+    EXPECT_TRUE(std::isnan(g.seconds));
+    EXPECT_NEAR(g.meters, 1500, 0.01);
+
+    EXPECT_EQ(GhostRider::formatGap(-5.2), QStringLiteral("-0:05"));
+    EXPECT_EQ(GhostRider::formatGap(72), QStringLiteral("+1:12"));
+    EXPECT_EQ(GhostRider::formatGap(-0.3), QStringLiteral("+0:00"));
+    EXPECT_EQ(GhostRider::formatGap(3725), QStringLiteral("+1:02:05"));
+    EXPECT_EQ(GhostRider::formatGap(NAN), QStringLiteral("N/A"));
+}
+
+void GhostRiderTestSuite::test_fitRide() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString filename = dir.filePath(QStringLiteral("5h ride.fit"));
+
+    const int seconds = 5 * 3600;
+    QList<SessionLine> session;
+    session.reserve(seconds + 1);
+    QDateTime start = QDateTime::fromSecsSinceEpoch(1700000000);
+    double distance = 0;
+    for (int s = 0; s <= seconds; s++) {
+        distance += rideSpeed(s) / 3600.0;
+        session.append(SessionLine(rideSpeed(s), 0, distance, rideWatts(s), 10, 20, 140, 0, 85, s * 0.2, 0, s, false,
+                                   0, 0, 0, 0, QGeoCoordinate(), 0, 0, 0, 0, start.addSecs(s)));
+    }
+    qfit::save(filename, session, bluetoothdevice::BIKE);
+
+    GhostRider ghost;
+    QElapsedTimer timer;
+    timer.start();
+    ASSERT_TRUE(ghost.load(filename));
+    qint64 loadMs = timer.elapsed();
+    EXPECT_EQ(ghost.size(), seconds + 1);
+    EXPECT_EQ(ghost.name(), QStringLiteral("5h ride"));
+    EXPECT_EQ(ghost.duration(), seconds);
+    // the file starts from the distance of its first record
+    EXPECT_NEAR(ghost.length(), distance - session.first().distance, 0.01);
+    EXPECT_NEAR(ghost.wattsAt(3600), (quint16)rideWatts(3600), 1);
+    EXPECT_LT(loadMs, 1000);
+
+    // a whole ride of lookups, a few times over
+    const int lookups = 1000000;
+    double sum = 0;
+    timer.start();
+    for (int i = 0; i < lookups; i++) {
+        double s = (i * 7919) % seconds + 0.5;
+        GhostRider::Gap g = ghost.gap(s, ghost.distanceAt(s) + 0.01, 220);
+        // 10 m ahead, unknown in the last seconds of the ghost
+        if (!std::isnan(g.seconds))
+            sum += g.seconds;
+    }
+    qint64 lookupNs = timer.nsecsElapsed();
+    EXPECT_GT(sum, 0);
+    qDebug() << "5 hour ride:" << ghost.size() << "records loaded in" << loadMs << "ms," << lookups << "gaps in"
+             << lookupNs / 1000000 << "ms," << lookupNs / lookups << "ns each";
+    EXPECT_LT(lookupNs / lookups, 20000);
+
+    EXPECT_FALSE(ghost.load(dir.filePath(QStringLiteral("missing.fit"))));
+    EXPECT_FALSE(ghost.isLoaded());
+}
@@ -0,0 +1,39 @@
+#ifndef GHOSTRIDERTESTSUITE_H
+#define GHOSTRIDERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class GhostRiderTestSuite: public testing::Test {
+
+public:
+    GhostRiderTestSuite();
+
+    /**
+     * @brief Test the binary search lookups against a linear scan, and the removal of the pauses
+     */
+    void test_lookup();
+
+    /**
+     * @brief Test the gaps against the ghost: ahead and behind in time, distance and power
+     */
+    void test_gap();
+
+    /**
+     * @brief Save a 5 hour ride with qfit, load it as a ghost and measure the load and the lookups
+     */
+    void test_fitRide();
+};
+
+TEST_F(GhostRiderTestSuite, TestLookup) {
+    this->test_lookup();
+}
+
+TEST_F(GhostRiderTestSuite, TestGap) {
+    this->test_gap();
+}
+
+TEST_F(GhostRiderTestSuite, TestFitRide) {
+    this->test_fitRide();
+}
+
+#endif // GHOSTRIDERTESTSUITE_H
@@ -0,0 +1,160 @@
+#include "gymmanagertestsuite.h"
+
+#include <QBluetoothAddress>
+#include <QBluetoothDeviceInfo>
+#include <QDebug>
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+#include <ctime>
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+#include "Tools/testsettings.h"
+#include "devices/bluetoothdevice.h"
+#include "gymmanager.h"
+#include "qzsettings.h"
+
+namespace {
+
+// resident memory of the process in bytes, 0 where it's not known
+qint64 residentBytes() {
+#ifdef Q_OS_LINUX
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f)
+        return 0;
+    long size = 0, resident = 0;
+    int n = fscanf(f, "%ld %ld", &size, &resident);
+    fclose(f);
+    return n == 2 ? (qint64)resident * sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;
+#endif
+}
+
+void runEventLoop(int ms) {
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+} // namespace
+
+GymManagerTestSuite::GymManagerTestSuite() {}
+
+void GymManagerTestSuite::test_parseStations() {
+    QList<GymStation::Config> stations =
+        GymManager::parseStations(QStringLiteral(" bike1 = FakeBike ; bike2=fakebike,/sdcard/ftp test.zwo;;"));
+    ASSERT_EQ(stations.size(), 2);
+    EXPECT_EQ(stations.at(0).name, QStringLiteral("bike1"));
+    EXPECT_EQ(stations.at(0).type, QStringLiteral("fakebike"));
+    EXPECT_TRUE(stations.at(0).program.isEmpty());
+    EXPECT_EQ(stations.at(1).name, QStringLiteral("bike2"));
+    EXPECT_EQ(stations.at(1).program, QStringLiteral("/sdcard/ftp test.zwo"));
+
+    // no name, no type, a name used twice or with MQTT wildcards and separators
+    stations = GymManager::parseStations(
+        QStringLiteral("=fakebike;bike1;bike1=;bike1=fakebike;bike1=fakebike;a/b=fakebike;a+=fakebike;#=fakebike"));
+    ASSERT_EQ(stations.size(), 1);
+    EXPECT_EQ(stations.at(0).name, QStringLiteral("bike1"));
+
+    EXPECT_TRUE(GymManager::parseStations(QString()).isEmpty());
+
+    // the real trainers by their address
+    stations = GymManager::parseStations(QStringLiteral(
+        "bike1=FTMS@aa:bb:cc:dd:ee:01,/sdcard/ftp.zwo;bike2=kickr@{AA:BB:CC:DD:EE:02};bike3=fakebike"));
+    ASSERT_EQ(stations.size(), 3);
+    EXPECT_EQ(stations.at(0).type, QStringLiteral("ftms"));
+    EXPECT_EQ(stations.at(0).address, QStringLiteral("AA:BB:CC:DD:EE:01"));
+    EXPECT_EQ(stations.at(0).program, QStringLiteral("/sdcard/ftp.zwo"));
+    EXPECT_EQ(stations.at(1).type, QStringLiteral("kickr"));
+    EXPECT_EQ(stations.at(1).address, QStringLiteral("AA:BB:CC:DD:EE:02"));
+    EXPECT_TRUE(stations.at(2).address.isEmpty());
+
+    // no address, an address used twice, a type no station can have
+    stations = GymManager::parseStations(QStringLiteral(
+        "bike1=ftms;bike2=ftms@AA:BB:CC:DD:EE:01;bike3=kickr@aa:bb:cc:dd:ee:01;bike4=treadmill@AA:BB:CC:DD:EE:03"));
+    ASSERT_EQ(stations.size(), 1);
+    EXPECT_EQ(stations.at(0).name, QStringLiteral("bike2"));
+}
+
+void GymManagerTestSuite::test_reservedTrainers() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QZSettings::dircon_yes, false);
+    testSettings.qsettings.setValue(QZSettings::mqtt_host, QString());
+
+    QBluetoothDeviceInfo trainer(QBluetoothAddress(QStringLiteral("AA:BB:CC:DD:EE:01")), QStringLiteral("KICKR"), 0);
+    QBluetoothDeviceInfo other(QBluetoothAddress(QStringLiteral("AA:BB:CC:DD:EE:02")), QStringLiteral("KICKR"), 0);
+    EXPECT_FALSE(GymManager::isReserved(trainer));
+    {
+        GymManager gym(GymManager::parseStations(QStringLiteral("bike1=kickr@aa:bb:cc:dd:ee:01;bike2=fakebike")), 4,
+                       1.0);
+        ASSERT_EQ(gym.stations().size(), 2);
+        // the bluetooth manager leaves it to the station
+        EXPECT_TRUE(GymManager::isReserved(trainer));
+        EXPECT_FALSE(GymManager::isReserved(other));
+
+        // the trainer waits for its discovery, the fake bike is there at once
+        GymStation *kickr = gym.stations().at(0);
+        GymStation *fake = gym.stations().at(1);
+        QMetaObject::invokeMethod(
+            kickr, [kickr]() { EXPECT_EQ(kickr->device(), nullptr); }, Qt::BlockingQueuedConnection);
+        QMetaObject::invokeMethod(
+            fake,
+            [fake]() {
+                ASSERT_NE(fake->device(), nullptr);
+                EXPECT_TRUE(fake->device()->isGymStation());
+            },
+            Qt::BlockingQueuedConnection);
+    }
+    EXPECT_FALSE(GymManager::isReserved(trainer));
+
+    EXPECT_EQ(GymManager::createDevice(QStringLiteral("treadmill")), nullptr);
+}
+
+void GymManagerTestSuite::test_stationsScaling() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    // the stations alone: no DirCon server and no MQTT broker to reach
+    testSettings.qsettings.setValue(QZSettings::dircon_yes, false);
+    testSettings.qsettings.setValue(QZSettings::mqtt_host, QString());
+
+    // shorter than the 1 s of the recorder, so that no FIT file is written when the stations stop
+    const int windowMs = 800;
+    for (int count : {1, 8, 32}) {
+        QList<GymStation::Config> configs;
+        for (int i = 0; i < count; i++)
+            configs.append({QStringLiteral("bike%1").arg(i), QStringLiteral("fakebike"), QString()});
+
+        qint64 before = residentBytes();
+        GymManager gym(configs, 4, 1.0);
+        EXPECT_EQ(gym.stations().size(), count);
+        EXPECT_LE(gym.threadCount(), count);
+        EXPECT_GE(gym.threadCount(), 1);
+
+        // start() was queued first: once these return every station has its device
+        for (GymStation *station : gym.stations())
+            QMetaObject::invokeMethod(
+                station, [station]() { EXPECT_NE(station->device(), nullptr); }, Qt::BlockingQueuedConnection);
+        for (int i = 0; i < count; i++) {
+            EXPECT_EQ(gym.stations().at(i)->device()->thread(), gym.stations().at(i)->thread());
+            for (int j = 0; j < i; j++)
+                EXPECT_NE(gym.stations().at(i)->device(), gym.stations().at(j)->device());
+        }
+
+        clock_t cpu = clock();
+        runEventLoop(windowMs);
+        double cpuPercent = 100.0 * (double)(clock() - cpu) / CLOCKS_PER_SEC / (windowMs / 1000.0);
+        qint64 added = residentBytes() - before;
+
+        qDebug() << count << "stations on" << gym.threadCount() << "threads: cpu" << cpuPercent << "% of a core,"
+                 << cpuPercent / count << "% per station, rss" << added / 1024 << "KiB," << added / 1024 / count
+                 << "KiB per station";
+        // loose bounds, it's a debug build on a shared machine: a fake bike polls every 200 ms and is small
+        EXPECT_LT(cpuPercent / count, 10.0);
+        if (added > 0)
+            EXPECT_LT(added / count, 16 * 1024 * 1024);
+    }
+}
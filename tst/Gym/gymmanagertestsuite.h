@@ -0,0 +1,41 @@
+#ifndef GYMMANAGERTESTSUITE_H
+#define GYMMANAGERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class GymManagerTestSuite: public testing::Test {
+
+public:
+    GymManagerTestSuite();
+
+    /**
+     * @brief Test the reading of the gym_stations setting, valid and invalid entries
+     */
+    void test_parseStations();
+
+    /**
+     * @brief Test that the trainers of the stations are left out of the search of the bluetooth manager, and
+     * that a station waits for its trainer
+     */
+    void test_reservedTrainers();
+
+    /**
+     * @brief Test that every station gets its own device on the thread pool, and measure the CPU time and
+     * the memory each fake bike station adds
+     */
+    void test_stationsScaling();
+};
+
+TEST_F(GymManagerTestSuite, TestParseStations) {
+    this->test_parseStations();
+}
+
+TEST_F(GymManagerTestSuite, TestReservedTrainers) {
+    this->test_reservedTrainers();
+}
+
+TEST_F(GymManagerTestSuite, TestStationsScaling) {
+    this->test_stationsScaling();
+}
+
+#endif // GYMMANAGERTESTSUITE_H
@@ -0,0 +1,276 @@
+#include "activityhistorytestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QVector>
+#include <math.h>
+
+#include "Tools/testsettings.h"
+#include "activityhistory.h"
+#include "qfit.h"
+
+namespace {
+
+double rideWatts(int seconds, int variant = 0) {
+    return 150 + 10 * variant + 100 * sin(seconds / 200.0) + (seconds >= 1000 && seconds < 1300 ? 250 : 0);
+}
+double rideSpeed(int seconds) { return seconds < 1800 ? 30 : 36; }
+int rideHeart(int seconds) { return 110 + seconds / 50 % 80; }
+
+SessionLine line(double speed, double distance, double watts, int heart, const QDateTime &time) {
+    return SessionLine(speed, 0, distance, watts, 10, 20, heart, 0, 85, 0, 0, 0, false, 0, 0, 0, 0, QGeoCoordinate(), 0,
+                       0, 0, 0, time);
+}
+
+// a ride of seconds records, with a pause of pause seconds in the middle if any
+QList<SessionLine> ride(const QDateTime &start, int seconds, int pause = 0, int variant = 0) {
+    QList<SessionLine> session;
+    double distance = 0;
+    for (int s = 0; s < seconds; s++) {
+        distance += rideSpeed(s) / 3600.0;
+        int t = s >= seconds / 2 ? s + pause : s;
+        session.append(line(rideSpeed(s), distance, (quint16)rideWatts(s, variant), rideHeart(s), start.addSecs(t)));
+    }
+    return session;
+}
+
+ActivityHistory::Activity activity(const QString &file, const QDateTime &start, quint16 power20m, double tss) {
+    ActivityHistory::Activity a;
+    a.file = file;
+    a.start = start;
+    a.seconds = 3600;
+    a.distance = 30;
+    a.tss = tss;
+    a.powerCurve.fill(power20m, ActivityHistory::curveDurations().size());
+    return a;
+}
+
+} // namespace
+
+ActivityHistoryTestSuite::ActivityHistoryTestSuite() {}
+
+void ActivityHistoryTestSuite::test_summarize() {
+    ActivityHistory::Zones zones;
+    zones.ftp = 250;
+    zones.maxHeart = 190;
+
+    // one hour with a 2 minutes pause in the middle, left out of the timeline
+    const int seconds = 3600;
+    QList<SessionLine> session = ride(QDateTime::fromSecsSinceEpoch(1700000000), seconds, 120);
+    ActivityHistory::Activity a = ActivityHistory::summarize(session, zones);
+    ASSERT_TRUE(a.start.isValid());
+    EXPECT_EQ(a.start, session.first().time);
+    EXPECT_EQ(a.seconds, (quint32)seconds);
+    EXPECT_NEAR(a.distance, session.last().distance - session.first().distance, 0.001);
+
+    QVector<double> watts, distance;
+    for (const SessionLine &s : qAsConst(session)) {
+        watts.append(s.watt);
+        distance.append(s.distance - session.first().distance);
+    }
+
+    // the curve by brute force
+    const QVector<int> &durations = ActivityHistory::curveDurations();
+    ASSERT_EQ(a.powerCurve.size(), durations.size());
+    for (int k = 0; k < durations.size(); k++) {
+        int d = durations.at(k);
+        double best = 0;
+        for (int i = 0; i + d <= seconds; i++) {
+            double sum = 0;
+            for (int j = i; j < i + d; j++)
+                sum += watts.at(j);
+            best = qMax(best, sum / d);
+        }
+        EXPECT_NEAR(a.powerCurve.at(k), best, 0.5) << d << " seconds";
+    }
+    EXPECT_EQ(a.maxWatts, a.powerCurve.first());
+    EXPECT_EQ(a.heartCurve.first(), a.maxHeart);
+
+    // NP and TSS by their definition
+    double fourth = 0;
+    for (int i = 29; i < seconds; i++) {
+        double sum = 0;
+        for (int j = i - 29; j <= i; j++)
+            sum += watts.at(j);
+        fourth += pow(sum / 30, 4);
+    }
+    double np = pow(fourth / (seconds - 29), 0.25);
+    EXPECT_NEAR(a.normalizedPower, np, 0.01);
+    EXPECT_GT(a.normalizedPower, a.avgWatts);
+    EXPECT_NEAR(a.tss, seconds * np * (np / zones.ftp) / (zones.ftp * 3600) * 100, 0.01);
+
+    // every second in a zone
+    quint32 powerSeconds = 0, heartSeconds = 0;
+    for (quint32 z : qAsConst(a.powerZones))
+        powerSeconds += z;
+    for (quint32 z : qAsConst(a.heartZones))
+        heartSeconds += z;
+    EXPECT_EQ(a.powerZones.size(), 7);
+    EXPECT_EQ(a.heartZones.size(), 5);
+    EXPECT_EQ(powerSeconds, (quint32)seconds);
+    EXPECT_EQ(heartSeconds, (quint32)seconds);
+    const double bounds[] = {56, 76, 91, 106, 121, 151};
+    QVector<quint32> powerZones(7, 0);
+    for (double w : qAsConst(watts)) {
+        int z = 0;
+        while (z < 6 && w / zones.ftp * 100 >= bounds[z])
+            z++;
+        powerZones[z]++;
+    }
+    EXPECT_EQ(a.powerZones, powerZones);
+    EXPECT_GT(a.powerZones.at(6), 0u);
+
+    // the fastest windows by brute force
+    const QVector<double> &efforts = ActivityHistory::effortDistances();
+    for (int k = 0; k < efforts.size(); k++) {
+        int best = 0;
+        for (int j = 0; j < seconds; j++)
+            for (int i = j + 1; i < seconds; i++)
+                if (distance.at(i) - distance.at(j) >= efforts.at(k) - 1e-6) {
+                    if (best == 0 || i - j < best)
+                        best = i - j;
+                    break;
+                }
+        EXPECT_NEAR(a.bestEfforts.at(k), best, 1) << efforts.at(k) << " km";
+    }
+    // 10 km at 36 km/h, 40 km not done
+    EXPECT_NEAR(a.bestEfforts.at(2), 1000, 1);
+    EXPECT_EQ(a.bestEfforts.at(4), 0);
+
+    EXPECT_FALSE(ActivityHistory::summarize(QList<SessionLine>(), zones).start.isValid());
+}
+
+void ActivityHistoryTestSuite::test_queries() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString filename = dir.filePath(QStringLiteral("history.dat"));
+
+    // a Wednesday
+    QDateTime now(QDate(2024, 6, 12), QTime(12, 0));
+    ActivityHistory history;
+    EXPECT_FALSE(history.load(filename));
+    history.setNow(now);
+    history.add(activity(QStringLiteral("a.fit"), now.addDays(-10), 250, 80));
+    history.add(activity(QStringLiteral("b.fit"), now.addDays(-100), 300, 100));
+    history.add(activity(QStringLiteral("c.fit"), now.addSecs(-3600), 240, 50));
+    history.add(activity(QStringLiteral("d.fit"), now.addDays(-2), 200, 30));
+    EXPECT_EQ(history.count(), 4);
+
+    EXPECT_EQ(history.bestPower(1200, 90), 250);
+    EXPECT_EQ(history.bestPower(1200, 0), 300);
+    EXPECT_EQ(history.bestPower(1200, 7), 240);
+    // the next longer duration of the curve
+    EXPECT_EQ(history.bestPower(1000, 90), 250);
+    EXPECT_EQ(history.bestPower(10 * 3600, 90), 0);
+
+    // this week from Monday, the activity of 10 days ago is in the week before the last one
+    QVariantList weeks = history.weeklyTss(3);
+    ASSERT_EQ(weeks.size(), 3);
+    EXPECT_EQ(weeks.at(0).toDouble(), 80);
+    EXPECT_EQ(weeks.at(1).toDouble(), 0);
+    EXPECT_EQ(weeks.at(2).toDouble(), 80);
+    EXPECT_EQ(history.tss(7), 80);
+    EXPECT_EQ(history.tss(0), 260);
+    EXPECT_EQ(history.distance(30), 90);
+
+    QVariantList recent = history.recent(2);
+    ASSERT_EQ(recent.size(), 2);
+    EXPECT_EQ(recent.at(0).toMap().value(QStringLiteral("file")).toString(), QStringLiteral("c.fit"));
+    EXPECT_EQ(recent.at(1).toMap().value(QStringLiteral("file")).toString(), QStringLiteral("d.fit"));
+
+    // the same file again replaces its activity
+    history.add(activity(QStringLiteral("a.fit"), now.addDays(-10), 260, 10));
+    EXPECT_EQ(history.count(), 4);
+    EXPECT_EQ(history.bestPower(1200, 90), 260);
+    EXPECT_EQ(history.tss(0), 190);
+
+    ASSERT_TRUE(history.save());
+    ActivityHistory loaded;
+    ASSERT_TRUE(loaded.load(filename));
+    loaded.setNow(now);
+    EXPECT_EQ(loaded.count(), 4);
+    EXPECT_EQ(loaded.bestPower(1200, 90), 260);
+    EXPECT_EQ(loaded.weeklyTss(3), history.weeklyTss(3));
+
+    // a damaged file is an empty history
+    QFile f(filename);
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly));
+    f.write("not a history");
+    f.close();
+    EXPECT_FALSE(loaded.load(filename));
+    EXPECT_EQ(loaded.count(), 0);
+}
+
+void ActivityHistoryTestSuite::test_bulkImport() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    // 10 different rides of 30 minutes, each copied 100 times
+    const int rides = 10;
+    const int copies = 100;
+    const int seconds = 1800;
+    QDateTime start = QDateTime::fromSecsSinceEpoch(1700000000);
+    QStringList files;
+    for (int r = 0; r < rides; r++) {
+        QString path = dir.filePath(QStringLiteral("ride %1.fit").arg(r));
+        qfit::save(path, ride(start.addDays(r), seconds, 0, r), bluetoothdevice::BIKE);
+        files.append(path);
+        for (int c = 1; c < copies; c++) {
+            QString copy = dir.filePath(QStringLiteral("ride %1 %2.fit").arg(r).arg(c));
+            ASSERT_TRUE(QFile::copy(path, copy));
+            files.append(copy);
+        }
+    }
+
+    // one at a time, to compare
+    QElapsedTimer timer;
+    timer.start();
+    ActivityHistory::Zones zones = ActivityHistory::Zones::fromSettings();
+    for (int r = 0; r < rides; r++)
+        EXPECT_EQ(ActivityHistory::summarize(files.at(r * copies), zones).seconds, (quint32)seconds);
+    double sequentialMs = timer.elapsed() / (double)rides;
+
+    ActivityHistory history;
+    history.load(dir.filePath(QStringLiteral("history.dat")));
+    timer.start();
+    EXPECT_EQ(history.importFiles(files), rides * copies);
+    qint64 importMs = timer.elapsed();
+    EXPECT_EQ(history.count(), rides * copies);
+    qDebug() << rides * copies << "activities imported in" << importMs << "ms on" << QThread::idealThreadCount()
+             << "threads," << sequentialMs << "ms each on one";
+    EXPECT_LT(importMs, 120000);
+
+    // nothing changed: nothing to decode
+    timer.start();
+    EXPECT_EQ(history.importFiles(files), 0);
+    EXPECT_LT(timer.elapsed(), 2000);
+
+    ActivityHistory loaded;
+    timer.start();
+    ASSERT_TRUE(loaded.load(dir.filePath(QStringLiteral("history.dat"))));
+    qint64 loadMs = timer.elapsed();
+    EXPECT_EQ(loaded.count(), rides * copies);
+    EXPECT_LT(loadMs, 1000);
+
+    // the last ride has the most power
+    loaded.setNow(start.addDays(rides));
+    ActivityHistory::Activity last = ActivityHistory::summarize(files.at((rides - 1) * copies), zones);
+    EXPECT_EQ(loaded.bestPower(1200, 90), last.powerCurve.at(ActivityHistory::curveDurations().indexOf(1200)));
+    EXPECT_EQ(loaded.bestPower(1200, 2), last.powerCurve.at(ActivityHistory::curveDurations().indexOf(1200)));
+
+    const int queries = 10000;
+    double sum = 0;
+    timer.start();
+    for (int i = 0; i < queries; i++)
+        sum += loaded.bestPower(1200, 90) + loaded.weeklyTss(4).value(0).toDouble();
+    qint64 queryNs = timer.nsecsElapsed();
+    EXPECT_GT(sum, 0);
+    qDebug() << "history of" << loaded.count() << "activities loaded in" << loadMs << "ms, best 20 minutes and weekly"
+             << "TSS in" << queryNs / queries / 1000 << "us";
+    EXPECT_LT(queryNs / queries, 1000000);
+}
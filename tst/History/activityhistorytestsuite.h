@@ -0,0 +1,39 @@
+#ifndef ACTIVITYHISTORYTESTSUITE_H
+#define ACTIVITYHISTORYTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class ActivityHistoryTestSuite: public testing::Test {
+
+public:
+    ActivityHistoryTestSuite();
+
+    /**
+     * @brief Test the summary of a session against a brute force computation: curves, NP, TSS, zones and best efforts
+     */
+    void test_summarize();
+
+    /**
+     * @brief Test the queries over the days and the weeks, and the round trip of the history file
+     */
+    void test_queries();
+
+    /**
+     * @brief Import 1000 FIT files on all the cores and measure it, then again with nothing changed
+     */
+    void test_bulkImport();
+};
+
+TEST_F(ActivityHistoryTestSuite, TestSummarize) {
+    this->test_summarize();
+}
+
+TEST_F(ActivityHistoryTestSuite, TestQueries) {
+    this->test_queries();
+}
+
+TEST_F(ActivityHistoryTestSuite, TestBulkImport) {
+    this->test_bulkImport();
+}
+
+#endif // ACTIVITYHISTORYTESTSUITE_H
@@ -0,0 +1,295 @@
+#include "ifitadbsessiontestsuite.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QMap>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QVector>
+
+#include "devices/ifitadbsession.h"
+
+namespace {
+
+// A stand in for adb: "shell" is a local shell reading its standard input, "logcat" prints a few iFit lines
+// with one of them split across two writes, then stays up like the real logcat does.
+const char fakeAdb[] = "#!/bin/sh\n"
+                       "while [ \"$1\" = \"-s\" ]; do shift 2; done\n"
+                       "case \"$1\" in\n"
+                       "connect) echo \"connected to $2\" ;;\n"
+                       "shell) exec /bin/sh ;;\n"
+                       "logcat)\n"
+                       "  printf 'I/ifit ( 12): Changed KPH 8.5\\nI/ifit ( 12): Changed Gra'\n"
+                       "  sleep 1\n"
+                       "  printf 'de 2.5\\nI/ifit ( 12): Changed Watts 180\\n'\n"
+                       "  exec sleep 30 ;;\n"
+                       "esac\n";
+
+QString writeFakeAdb(const QTemporaryDir &dir) {
+    QString path = dir.filePath(QStringLiteral("adb"));
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return QString();
+    f.write(fakeAdb);
+    f.close();
+    f.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+    return path;
+}
+
+// runs the event loop until the condition holds or the timeout expires
+template <typename Condition> bool waitFor(Condition condition, int timeoutMs) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition() && timer.elapsed() < timeoutMs) {
+        QEventLoop loop;
+        QTimer::singleShot(5, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    return condition();
+}
+
+} // namespace
+
+IfitAdbSessionTestSuite::IfitAdbSessionTestSuite() {}
+
+void IfitAdbSessionTestSuite::test_scanLine() {
+    IfitLogcatScanner::Field field;
+    double value = 0;
+
+    const char kph[] = "01-01 10:00:00.000  1234  1250 I WorkoutController: Changed KPH 12.3\r";
+    ASSERT_TRUE(IfitLogcatScanner::scanLine(kph, sizeof(kph) - 1, field, value));
+    EXPECT_EQ(field, IfitLogcatScanner::KPH);
+    EXPECT_DOUBLE_EQ(value, 12.3);
+
+    const char grade[] = "I/ifit: Changed Grade -1.5";
+    ASSERT_TRUE(IfitLogcatScanner::scanLine(grade, sizeof(grade) - 1, field, value));
+    EXPECT_EQ(field, IfitLogcatScanner::Grade);
+    EXPECT_DOUBLE_EQ(value, -1.5);
+
+    const char resistance[] = "I/ifit: Changed Resistance 14";
+    ASSERT_TRUE(IfitLogcatScanner::scanLine(resistance, sizeof(resistance) - 1, field, value));
+    EXPECT_EQ(field, IfitLogcatScanner::Resistance);
+    EXPECT_DOUBLE_EQ(value, 14);
+
+    const char heart[] = "01-01 10:00:00.000  1234  1250 I HRM  : HeartRateDataUpdate a b c d e f 142 x";
+    ASSERT_TRUE(IfitLogcatScanner::scanLine(heart, sizeof(heart) - 1, field, value));
+    EXPECT_EQ(field, IfitLogcatScanner::HeartRate);
+    EXPECT_DOUBLE_EQ(value, 142);
+
+    const char unknown[] = "I/ifit: Changed Mode 3";
+    EXPECT_FALSE(IfitLogcatScanner::scanLine(unknown, sizeof(unknown) - 1, field, value));
+    const char noValue[] = "I/ifit: Changed KPH";
+    EXPECT_FALSE(IfitLogcatScanner::scanLine(noValue, sizeof(noValue) - 1, field, value));
+    const char shortHeart[] = "HeartRateDataUpdate 1 2 3";
+    EXPECT_FALSE(IfitLogcatScanner::scanLine(shortHeart, sizeof(shortHeart) - 1, field, value));
+}
+
+void IfitAdbSessionTestSuite::test_feedSplitLines() {
+    const QByteArray stream = "--------- beginning of main\n"
+                              "I/ifit: Changed Grade 2.5\n"
+                              "I/ifit: Changed Watts 180\n"
+                              "I/ifit: Changed KPH 9.0\n";
+
+    // one byte at a time, the worst case for the lines kept across chunks
+    IfitLogcatScanner scanner;
+    for (int i = 0; i < stream.size(); i++)
+        scanner.feed(stream.constData() + i, 1);
+    EXPECT_TRUE(scanner.found(IfitLogcatScanner::Grade));
+    EXPECT_DOUBLE_EQ(scanner.value(IfitLogcatScanner::Grade), 2.5);
+    EXPECT_DOUBLE_EQ(scanner.value(IfitLogcatScanner::Watts), 180);
+    EXPECT_DOUBLE_EQ(scanner.value(IfitLogcatScanner::KPH), 9.0);
+    EXPECT_FALSE(scanner.found(IfitLogcatScanner::HeartRate));
+
+    // an unfinished line is not scanned until its end arrives
+    scanner.clearFound();
+    scanner.feed(QByteArray("I/ifit: Changed RPM 8"));
+    EXPECT_FALSE(scanner.foundAny());
+    scanner.feed(QByteArray("5\n"));
+    EXPECT_TRUE(scanner.found(IfitLogcatScanner::RPM));
+    EXPECT_DOUBLE_EQ(scanner.value(IfitLogcatScanner::RPM), 85);
+}
+
+void IfitAdbSessionTestSuite::test_feedLongLine() {
+    IfitLogcatScanner scanner;
+    const QByteArray garbage(IfitLogcatScanner::maxLineLength / 4, 'x');
+
+    // a line without end, in chunks: dropped when it goes over the bound, with its tail and its end
+    scanner.feed(QByteArray("I/ifit: Changed Watts 1"));
+    for (int i = 0; i < 8; i++)
+        scanner.feed(garbage);
+    scanner.feed(QByteArray("I/ifit: Changed Watts 200\n"));
+    EXPECT_FALSE(scanner.foundAny());
+
+    // the next line is scanned again
+    scanner.feed(QByteArray("I/ifit: Changed Watts 210\n"));
+    EXPECT_TRUE(scanner.found(IfitLogcatScanner::Watts));
+    EXPECT_DOUBLE_EQ(scanner.value(IfitLogcatScanner::Watts), 210);
+
+    // the same for a line going over the bound in the chunk that ends it, and for a whole line too long
+    scanner.clearFound();
+    scanner.feed(garbage + garbage + garbage);
+    scanner.feed(garbage + "I/ifit: Changed Watts 220\nI/ifit: Changed RPM 80\n");
+    scanner.feed(QByteArray(IfitLogcatScanner::maxLineLength, 'x') + " Changed Grade 3\n");
+    EXPECT_FALSE(scanner.found(IfitLogcatScanner::Watts));
+    EXPECT_FALSE(scanner.found(IfitLogcatScanner::Grade));
+    EXPECT_TRUE(scanner.found(IfitLogcatScanner::RPM));
+    EXPECT_DOUBLE_EQ(scanner.value(IfitLogcatScanner::RPM), 80);
+}
+
+void IfitAdbSessionTestSuite::test_shellCommands() {
+#if defined(Q_OS_ANDROID) || defined(Q_OS_WINDOWS) || defined(Q_OS_IOS)
+    SUCCEED() << "the fake adb is a shell script";
+#else
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString adb = writeFakeAdb(dir);
+    ASSERT_FALSE(adb.isEmpty());
+
+    IfitAdbSession session(QString(), nullptr, adb);
+    QVector<int> exitCodes;
+    QVector<QByteArray> outputs;
+    QObject::connect(&session, &IfitAdbSession::commandFinished,
+                     [&](int id, int exitCode, const QByteArray &output) {
+                         EXPECT_EQ(id, exitCodes.size() + 1);
+                         exitCodes.append(exitCode);
+                         outputs.append(output);
+                     });
+    double speed = 0, inclination = 0, watt = 0;
+    QObject::connect(&session, &IfitAdbSession::onSpeedInclination, [&](double s, double i) {
+        speed = s;
+        inclination = i;
+    });
+    QObject::connect(&session, &IfitAdbSession::onWatt, [&](double w) { watt = w; });
+    session.start();
+
+    // the first command waits for the shell to start
+    session.runCommand(QStringLiteral("echo ready"));
+    ASSERT_TRUE(waitFor([&]() { return exitCodes.size() == 1; }, 5000));
+    EXPECT_EQ(outputs[0], QByteArray("ready\n"));
+
+    // then every command is a line written to the same shell, no process is started for it
+    const int rounds = 50;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < rounds; i++)
+        session.runCommand(QStringLiteral("echo %1").arg(i));
+    session.runCommand(QStringLiteral("false"));
+    EXPECT_EQ(session.pendingCommands(), rounds + 1);
+    ASSERT_TRUE(waitFor([&]() { return exitCodes.size() == rounds + 2; }, 5000));
+    qint64 elapsed = timer.elapsed();
+    qDebug() << rounds << "adb shell commands in" << elapsed << "ms";
+
+    for (int i = 0; i < rounds; i++) {
+        EXPECT_EQ(exitCodes[i + 1], 0);
+        EXPECT_EQ(outputs[i + 1], QByteArray::number(i) + '\n');
+    }
+    EXPECT_EQ(exitCodes.last(), 1);
+    EXPECT_EQ(session.pendingCommands(), 0);
+    // a process per command costs several ms each even for a local script, hundreds of ms with a real adb
+    EXPECT_LT(elapsed, 1000);
+
+    // the grade line is split across two writes of the fake logcat
+    ASSERT_TRUE(waitFor([&]() { return watt > 0; }, 5000));
+    EXPECT_DOUBLE_EQ(speed, 8.5);
+    EXPECT_DOUBLE_EQ(inclination, 2.5);
+    EXPECT_DOUBLE_EQ(watt, 180);
+
+    session.stop();
+#endif
+}
+
+void IfitAdbSessionTestSuite::test_shellRestart() {
+#if defined(Q_OS_ANDROID) || defined(Q_OS_WINDOWS) || defined(Q_OS_IOS)
+    SUCCEED() << "the fake adb is a shell script";
+#else
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString adb = writeFakeAdb(dir);
+    ASSERT_FALSE(adb.isEmpty());
+
+    IfitAdbSession session(QString(), nullptr, adb);
+    session.setRestartDelay(10);
+    QVector<int> exitCodes;
+    QVector<QByteArray> outputs;
+    QObject::connect(&session, &IfitAdbSession::commandFinished,
+                     [&](int, int exitCode, const QByteArray &output) {
+                         exitCodes.append(exitCode);
+                         outputs.append(output);
+                     });
+    session.start();
+
+    session.runCommand(QStringLiteral("exit"));
+    session.runCommand(QStringLiteral("echo again"));
+    ASSERT_TRUE(waitFor([&]() { return exitCodes.size() == 2; }, 5000));
+    EXPECT_EQ(exitCodes[0], -1);
+    EXPECT_EQ(exitCodes[1], 0);
+    EXPECT_EQ(outputs[1], QByteArray("again\n"));
+
+    // a command that never ends times out and does not hold the queue
+    session.setCommandTimeout(200);
+    session.runCommand(QStringLiteral("sleep 10"));
+    session.runCommand(QStringLiteral("echo after"));
+    ASSERT_TRUE(waitFor([&]() { return exitCodes.size() == 4; }, 5000));
+    EXPECT_EQ(exitCodes[2], -1);
+    EXPECT_EQ(exitCodes[3], 0);
+    EXPECT_EQ(outputs[3], QByteArray("after\n"));
+
+    session.stop();
+#endif
+}
+
+void IfitAdbSessionTestSuite::test_coalescing() {
+#if defined(Q_OS_ANDROID) || defined(Q_OS_WINDOWS) || defined(Q_OS_IOS)
+    SUCCEED() << "the fake adb is a shell script";
+#else
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString adb = writeFakeAdb(dir);
+    ASSERT_FALSE(adb.isEmpty());
+
+    IfitAdbSession session(QString(), nullptr, adb);
+    session.setMaxQueuedCommands(3);
+    QVector<int> finished;
+    QMap<int, int> exitCodes;
+    QMap<int, QByteArray> outputs;
+    QObject::connect(&session, &IfitAdbSession::commandFinished,
+                     [&](int id, int exitCode, const QByteArray &output) {
+                         finished.append(id);
+                         exitCodes[id] = exitCode;
+                         outputs[id] = output;
+                     });
+    session.start();
+
+    // the first one is in flight at once, the others wait behind it
+    int first = session.runCommand(QStringLiteral("echo first"));
+    int speed1 = session.runCommand(QStringLiteral("echo speed 1"), QStringLiteral("speed"));
+    int incline = session.runCommand(QStringLiteral("echo incline"), QStringLiteral("incline"));
+    int speed2 = session.runCommand(QStringLiteral("echo speed 2"), QStringLiteral("speed"));
+    EXPECT_EQ(finished, QVector<int>({speed1}));
+    EXPECT_EQ(exitCodes.value(speed1), -2);
+    EXPECT_EQ(session.pendingCommands(), 3);
+
+    ASSERT_TRUE(waitFor([&]() { return finished.size() == 4; }, 5000));
+    // the newer speed took the place of the older one, before the incline
+    EXPECT_EQ(finished, QVector<int>({speed1, first, speed2, incline}));
+    EXPECT_EQ(outputs.value(speed2), QByteArray("speed 2\n"));
+    EXPECT_EQ(outputs.value(incline), QByteArray("incline\n"));
+
+    // a full queue drops its oldest command
+    finished.clear();
+    int a = session.runCommand(QStringLiteral("echo a"));
+    int b = session.runCommand(QStringLiteral("echo b"));
+    int c = session.runCommand(QStringLiteral("echo c"));
+    int d = session.runCommand(QStringLiteral("echo d"));
+    int e = session.runCommand(QStringLiteral("echo e"));
+    EXPECT_EQ(finished, QVector<int>({b}));
+    EXPECT_EQ(exitCodes.value(b), -2);
+    EXPECT_EQ(session.pendingCommands(), 4);
+    ASSERT_TRUE(waitFor([&]() { return finished.size() == 5; }, 5000));
+    EXPECT_EQ(finished, QVector<int>({b, a, c, d, e}));
+    EXPECT_EQ(outputs.value(e), QByteArray("e\n"));
+
+    session.stop();
+#endif
+}
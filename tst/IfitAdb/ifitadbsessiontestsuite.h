@@ -0,0 +1,66 @@
+#ifndef IFITADBSESSIONTESTSUITE_H
+#define IFITADBSESSIONTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class IfitAdbSessionTestSuite: public testing::Test {
+
+public:
+    IfitAdbSessionTestSuite();
+
+    /**
+     * @brief Test matching single logcat lines against the known prefixes
+     */
+    void test_scanLine();
+
+    /**
+     * @brief Test scanning a logcat stream delivered in chunks that split the lines
+     */
+    void test_feedSplitLines();
+
+    /**
+     * @brief Test that a line longer than the bound is dropped up to its end, whatever the chunks
+     */
+    void test_feedLongLine();
+
+    /**
+     * @brief Test running commands through the persistent shell of a fake adb, and the logcat values it prints
+     */
+    void test_shellCommands();
+
+    /**
+     * @brief Test that a command ending the shell fails and the next one runs on a restarted shell
+     */
+    void test_shellRestart();
+
+    /**
+     * @brief Test that a queued command is replaced by a newer one of the same kind, and that the queue is bounded
+     */
+    void test_coalescing();
+};
+
+TEST_F(IfitAdbSessionTestSuite, TestScanLine) {
+    this->test_scanLine();
+}
+
+TEST_F(IfitAdbSessionTestSuite, TestFeedSplitLines) {
+    this->test_feedSplitLines();
+}
+
+TEST_F(IfitAdbSessionTestSuite, TestFeedLongLine) {
+    this->test_feedLongLine();
+}
+
+TEST_F(IfitAdbSessionTestSuite, TestShellCommands) {
+    this->test_shellCommands();
+}
+
+TEST_F(IfitAdbSessionTestSuite, TestShellRestart) {
+    this->test_shellRestart();
+}
+
+TEST_F(IfitAdbSessionTestSuite, TestCoalescing) {
+    this->test_coalescing();
+}
+
+#endif // IFITADBSESSIONTESTSUITE_H
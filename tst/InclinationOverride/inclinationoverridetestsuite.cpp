@@ -0,0 +1,162 @@
+#include "inclinationoverridetestsuite.h"
+
+#include <QThread>
+#include <math.h>
+
+#include "Tools/testsettings.h"
+#include "devices/treadmill.h"
+#include "inclinationoverride.h"
+#include "qzsettings.h"
+
+namespace {
+
+// a treadmill going up faster than the app asks
+InclinationOverride::Parameters steepTable() {
+    InclinationOverride::Parameters parameters;
+    for (int i = 0; i < InclinationOverride::points; i++)
+        parameters.table[i] = i * InclinationOverride::step * 1.2 + 0.3;
+    return parameters;
+}
+
+// the switch of treadmill::treadmillInclinationOverride before the curve
+double switchOverride(const InclinationOverride::Parameters &parameters, double inclination) {
+    inclination = inclination * parameters.gain + parameters.offset;
+    int inc = inclination * 10;
+    if (inc >= 0 && inc <= 150 && inc % 5 == 0)
+        return parameters.table[inc / 5];
+    return inclination;
+}
+
+} // namespace
+
+InclinationOverrideTestSuite::InclinationOverrideTestSuite() {}
+
+void InclinationOverrideTestSuite::test_points() {
+    InclinationOverride::Parameters parameters = steepTable();
+    const double gains[] = {1, 1, 0.5, 2};
+    const double offsets[] = {0, 1, 0, -1};
+    for (int g = 0; g < 4; g++) {
+        parameters.gain = gains[g];
+        parameters.offset = offsets[g];
+        InclinationOverride curve(parameters);
+        for (int i = -4; i <= 40; i++) {
+            double inclination = i * 0.25;
+            double u = inclination * parameters.gain + parameters.offset;
+            // the switch only knew the points of the table, in between it left the inclination as it was
+            if (u < 0 || u > InclinationOverride::maxInclination || fmod(u, InclinationOverride::step) != 0)
+                continue;
+            EXPECT_DOUBLE_EQ(curve.apply(inclination), switchOverride(parameters, inclination))
+                << inclination << " gain " << parameters.gain << " offset " << parameters.offset;
+        }
+    }
+
+    // the default table changes nothing
+    InclinationOverride identity;
+    for (int i = -50; i <= 250; i++)
+        EXPECT_DOUBLE_EQ(identity.apply(i / 10.0), i / 10.0);
+}
+
+void InclinationOverrideTestSuite::test_interpolation() {
+    InclinationOverride curve(steepTable());
+    EXPECT_DOUBLE_EQ(curve.apply(0), 0.3);
+    EXPECT_DOUBLE_EQ(curve.apply(0.25), 0.6);
+    EXPECT_DOUBLE_EQ(curve.apply(3.1), 3.1 * 1.2 + 0.3);
+    EXPECT_DOUBLE_EQ(curve.apply(15), 18.3);
+    // outside of the table the inclination is left as it is
+    EXPECT_DOUBLE_EQ(curve.apply(-2), -2);
+    EXPECT_DOUBLE_EQ(curve.apply(16), 16);
+
+    InclinationOverride::Parameters parameters = steepTable();
+    parameters.gain = 2;
+    parameters.offset = 1;
+    curve = InclinationOverride(parameters);
+    EXPECT_DOUBLE_EQ(curve.apply(1.2), 3.4 * 1.2 + 0.3);
+    EXPECT_DOUBLE_EQ(curve.apply(7.5), 16);
+    EXPECT_DOUBLE_EQ(curve.apply(-1), -1);
+
+    curve = InclinationOverride(steepTable());
+    for (int i = 0; i < 1500; i++)
+        EXPECT_LE(curve.apply(i * 0.01), curve.apply((i + 1) * 0.01));
+}
+
+void InclinationOverrideTestSuite::test_reverse() {
+    InclinationOverride::Parameters parameters = steepTable();
+    // a flat segment and a point lower than the one before
+    parameters.table[10] = parameters.table[11] = parameters.table[12] = 6;
+    parameters.table[20] = 5;
+    const double gains[] = {1, 0.5, 2};
+    const double offsets[] = {0, 1, -1};
+    for (int g = 0; g < 3; g++) {
+        parameters.gain = gains[g];
+        parameters.offset = offsets[g];
+        InclinationOverride curve(parameters);
+        for (int i = 0; i < 2000; i++) {
+            double y = curve.apply(-5 + i * 0.0125);
+            EXPECT_NEAR(curve.apply(curve.reverse(y)), y, 1e-9) << y;
+        }
+        for (int i = 0; i <= 250; i++) {
+            double y = -5 + i * 0.1;
+            double u = curve.reverse(y) * parameters.gain + parameters.offset;
+            if (y < 0 || (y >= parameters.table[0] && y <= parameters.table[30]) || y > 18.3)
+                EXPECT_NEAR(curve.apply(curve.reverse(y)), y, 1e-9) << y;
+            else if (y < parameters.table[0])
+                EXPECT_NEAR(u, 0, 1e-9) << y;
+        }
+    }
+
+    parameters.gain = 1;
+    parameters.offset = 0;
+    InclinationOverride curve(parameters);
+    // the last point of a flat segment, as the loop over the points did
+    EXPECT_DOUBLE_EQ(curve.reverse(6), 6);
+    // the lowered point is on the flat segment going to it
+    EXPECT_DOUBLE_EQ(curve.apply(10), curve.apply(9.5));
+    // below the first point, the first point
+    EXPECT_DOUBLE_EQ(curve.reverse(0.1), 0);
+    // above the table
+    EXPECT_DOUBLE_EQ(curve.reverse(18.3), 15);
+    EXPECT_DOUBLE_EQ(curve.reverse(19), 19);
+    EXPECT_DOUBLE_EQ(curve.reverse(-1), -1);
+
+    // a table ending below 15%: what it can't reach is 15%
+    parameters = InclinationOverride::Parameters();
+    parameters.table[30] = 14.6;
+    curve = InclinationOverride(parameters);
+    EXPECT_DOUBLE_EQ(curve.reverse(14.8), 15);
+    EXPECT_DOUBLE_EQ(curve.reverse(15.5), 15.5);
+    EXPECT_NEAR(curve.reverse(14.55), 14.75, 1e-9);
+    EXPECT_DOUBLE_EQ(curve.reverse(13), 13);
+}
+
+void InclinationOverrideTestSuite::test_settings() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    InclinationOverride::Parameters defaults = InclinationOverride::parametersFromSettings();
+    EXPECT_TRUE(defaults == InclinationOverride::Parameters());
+    EXPECT_DOUBLE_EQ(defaults.table[0], QZSettings::default_treadmill_inclination_override_0);
+    EXPECT_DOUBLE_EQ(defaults.table[1], QZSettings::default_treadmill_inclination_override_05);
+    EXPECT_DOUBLE_EQ(defaults.table[30], QZSettings::default_treadmill_inclination_override_150);
+
+    testSettings.qsettings.setValue(QZSettings::treadmill_inclination_ovveride_gain, 2.0);
+    testSettings.qsettings.setValue(QZSettings::treadmill_inclination_ovveride_offset, 0.5);
+    testSettings.qsettings.setValue(QZSettings::treadmill_inclination_override_25, 2.6);
+    InclinationOverride::Parameters parameters = InclinationOverride::parametersFromSettings();
+    EXPECT_DOUBLE_EQ(parameters.gain, 2);
+    EXPECT_DOUBLE_EQ(parameters.offset, 0.5);
+    EXPECT_DOUBLE_EQ(parameters.table[5], 2.6);
+    EXPECT_TRUE(parameters != defaults);
+
+    // the cache reads the settings again after a second
+    QThread::msleep(1100);
+    EXPECT_TRUE(InclinationOverride::fromSettings().parameters() == parameters);
+    EXPECT_DOUBLE_EQ(treadmill::treadmillInclinationOverride(1), 2.6);
+    EXPECT_DOUBLE_EQ(treadmill::treadmillInclinationOverrideReverse(2.6), 1);
+    EXPECT_DOUBLE_EQ(treadmill::treadmillInclinationOverride(-1), -1.5);
+
+    testSettings.qsettings.remove(QZSettings::treadmill_inclination_ovveride_gain);
+    testSettings.qsettings.remove(QZSettings::treadmill_inclination_ovveride_offset);
+    testSettings.qsettings.remove(QZSettings::treadmill_inclination_override_25);
+    QThread::msleep(1100);
+    EXPECT_DOUBLE_EQ(treadmill::treadmillInclinationOverride(2.5), 2.5);
+}
@@ -0,0 +1,48 @@
+#ifndef INCLINATIONOVERRIDETESTSUITE_H
+#define INCLINATIONOVERRIDETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class InclinationOverrideTestSuite: public testing::Test {
+
+public:
+    InclinationOverrideTestSuite();
+
+    /**
+     * @brief Test the points of the table against the switch it replaces, with gain and offset
+     */
+    void test_points();
+
+    /**
+     * @brief Test the interpolation between the points, and the inclinations outside of the table
+     */
+    void test_interpolation();
+
+    /**
+     * @brief Test that the reverse is the exact inverse, on flat and lowered points and at the ends of the table
+     */
+    void test_reverse();
+
+    /**
+     * @brief Test the curve read from the settings, through the static functions of the treadmill
+     */
+    void test_settings();
+};
+
+TEST_F(InclinationOverrideTestSuite, TestPoints) {
+    this->test_points();
+}
+
+TEST_F(InclinationOverrideTestSuite, TestInterpolation) {
+    this->test_interpolation();
+}
+
+TEST_F(InclinationOverrideTestSuite, TestReverse) {
+    this->test_reverse();
+}
+
+TEST_F(InclinationOverrideTestSuite, TestSettings) {
+    this->test_settings();
+}
+
+#endif // INCLINATIONOVERRIDETESTSUITE_H
@@ -0,0 +1,266 @@
+#include "influxexportertestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QSet>
+#include <QSharedPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <functional>
+#include <math.h>
+
+#include "influxexporter.h"
+
+namespace {
+
+void runEventLoop(int ms) {
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+bool waitFor(const std::function<bool()> &condition, int timeoutMs) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition() && timer.elapsed() < timeoutMs)
+        runEventLoop(20);
+    return condition();
+}
+
+quint32 adler32(const QByteArray &data) {
+    quint32 a = 1, b = 0;
+    for (char c : data) {
+        a = (a + (quint8)c) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+quint32 readLE32(const QByteArray &data, int at) {
+    return (quint8)data.at(at) | ((quint8)data.at(at + 1) << 8) | ((quint8)data.at(at + 2) << 16) |
+           ((quint32)(quint8)data.at(at + 3) << 24);
+}
+
+// an HTTP/1.1 server answering 204 to every write like InfluxDB does, or dropping the connection
+class InfluxStandIn {
+  public:
+    InfluxStandIn() {
+        QObject::connect(&server, &QTcpServer::newConnection, &server, [this]() {
+            while (QTcpSocket *socket = server.nextPendingConnection()) {
+                QSharedPointer<QByteArray> buffer(new QByteArray);
+                QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                QObject::connect(socket, &QTcpSocket::readyRead, socket,
+                                 [this, socket, buffer]() { read(socket, *buffer); });
+            }
+        });
+    }
+
+    bool listen() { return server.listen(QHostAddress::LocalHost, port); }
+    void close() { server.close(); }
+
+    quint16 port = 0;
+    bool drop = false;
+    int requests = 0;
+    int duplicates = 0;
+    QSet<QByteArray> lines;
+    QTcpServer server;
+
+  private:
+    void read(QTcpSocket *socket, QByteArray &buffer) {
+        buffer.append(socket->readAll());
+        forever {
+            int end = buffer.indexOf("\r\n\r\n");
+            if (end < 0)
+                return;
+            QByteArray head = buffer.left(end).toLower();
+            int length = 0;
+            int at = head.indexOf("content-length:");
+            if (at >= 0)
+                length = head.mid(at + 15, head.indexOf("\r\n", at) - at - 15).trimmed().toInt();
+            if (buffer.size() < end + 4 + length)
+                return;
+            QByteArray body = buffer.mid(end + 4, length);
+            buffer.remove(0, end + 4 + length);
+
+            if (drop) {
+                socket->abort();
+                return;
+            }
+            requests++;
+            for (const QByteArray &line : body.split('\n')) {
+                if (line.isEmpty())
+                    continue;
+                if (lines.contains(line))
+                    duplicates++;
+                lines.insert(line);
+            }
+            socket->write("HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n");
+        }
+    }
+};
+
+QByteArray point(int i) {
+    return QByteArray("test,device=standin seq=") + QByteArray::number(i) + "i " +
+           QByteArray::number(1700000000000000000LL + i) + "\n";
+}
+
+} // namespace
+
+InfluxExporterTestSuite::InfluxExporterTestSuite() {}
+
+void InfluxExporterTestSuite::test_lineProtocol() {
+    SessionLine s(28.5, 2, 1.25, 180, 12, 30, 140, 0, 85, 45.5, 3, 600, false, 0, 0, 0, 0, QGeoCoordinate(), 0, 0,
+                  0, 0, QDateTime::fromMSecsSinceEpoch(1700000000123));
+    EXPECT_EQ(InfluxExporter::line(s, QStringLiteral("work out"), QStringLiteral("Domyos Bike,1=x"),
+                                   QStringLiteral("bike")),
+              QByteArray("work\\ out,device=Domyos\\ Bike\\,1\\=x,type=bike speed=28.5,inclination=2i,distance=1.25,"
+                         "watts=180i,resistance=12i,peloton_resistance=30i,heart=140i,cadence=85i,pace=0,"
+                         "calories=45.5,elevation_gain=3,elapsed=600i 1700000000123000000\n"));
+
+    // no empty tags, no NaN, the position and the counters only when there are
+    s.speed = NAN;
+    s.stepCount = 1200;
+    s.totalStrokes = 0;
+    s.coordinate = QGeoCoordinate(45.5, 9.25);
+    QByteArray l = InfluxExporter::line(s, QStringLiteral("workout"), QString(), QString());
+    EXPECT_TRUE(l.startsWith("workout inclination=2i,")) << l.constData();
+    EXPECT_TRUE(l.contains(",steps=1200,")) << l.constData();
+    EXPECT_TRUE(l.contains(",latitude=45.5,longitude=9.25 ")) << l.constData();
+    EXPECT_FALSE(l.contains("strokes")) << l.constData();
+}
+
+void InfluxExporterTestSuite::test_gzip() {
+    QByteArray gz = InfluxExporter::gzip("123456789");
+    ASSERT_GT(gz.size(), 18);
+    EXPECT_EQ((quint8)gz.at(0), 0x1f);
+    EXPECT_EQ((quint8)gz.at(1), 0x8b);
+    EXPECT_EQ((quint8)gz.at(2), 8);
+    // the CRC-32 check value of "123456789"
+    EXPECT_EQ(readLE32(gz, gz.size() - 8), 0xCBF43926u);
+    EXPECT_EQ(readLE32(gz, gz.size() - 4), 9u);
+
+    // the deflate stream back in the zlib format of qUncompress
+    QByteArray data;
+    for (int i = 0; i < 2000; i++)
+        data.append(point(i));
+    gz = InfluxExporter::gzip(data);
+    EXPECT_LT(gz.size(), data.size() / 4);
+    QByteArray zlib;
+    for (int i = 3; i >= 0; i--)
+        zlib.append((char)((data.size() >> (8 * i)) & 0xFF));
+    zlib.append("\x78\x9c", 2);
+    zlib.append(gz.mid(10, gz.size() - 18));
+    quint32 adler = adler32(data);
+    for (int i = 3; i >= 0; i--)
+        zlib.append((char)((adler >> (8 * i)) & 0xFF));
+    EXPECT_EQ(qUncompress(zlib), data);
+}
+
+void InfluxExporterTestSuite::test_spool() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QByteArray a = point(1) + point(2);
+    QByteArray b = point(3);
+    QByteArray c = point(4) + point(5);
+    {
+        InfluxSpool spool(dir.path(), 1000);
+        EXPECT_TRUE(spool.isEmpty());
+        EXPECT_EQ(spool.push(a), 0);
+        EXPECT_EQ(spool.push(b), 0);
+        EXPECT_EQ(spool.bytes(), a.size() + b.size());
+        EXPECT_EQ(spool.head(), a);
+    }
+
+    // a new run finds them in the same order
+    InfluxSpool spool(dir.path(), a.size() + b.size() + 10);
+    ASSERT_EQ(spool.batches(), 2);
+    EXPECT_EQ(spool.head(), a);
+    // full: the oldest batch goes
+    EXPECT_EQ(spool.push(c), 2);
+    EXPECT_EQ(spool.batches(), 2);
+    EXPECT_EQ(spool.head(), b);
+    spool.pop();
+    EXPECT_EQ(spool.head(), c);
+    spool.pop();
+    EXPECT_TRUE(spool.isEmpty());
+    EXPECT_EQ(spool.bytes(), 0);
+
+    // a batch larger than the spool is dropped alone
+    InfluxSpool tiny(dir.path(), 10);
+    EXPECT_EQ(tiny.push(a), 2);
+    EXPECT_TRUE(tiny.isEmpty());
+}
+
+void InfluxExporterTestSuite::test_noLossAcrossDisconnects() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    InfluxStandIn standIn;
+    ASSERT_TRUE(standIn.listen());
+    standIn.port = standIn.server.serverPort();
+
+    InfluxExporter::Config config;
+    config.url = QStringLiteral("http://127.0.0.1:%1/api/v2/write?org=qz&bucket=test").arg(standIn.port);
+    config.token = QStringLiteral("secret");
+    config.batchPoints = 50;
+    config.batchMs = 100;
+    config.gzip = false;
+    config.spoolPath = dir.path();
+    config.spoolBytes = 1024 * 1024;
+
+    int written = 0;
+    auto writeSome = [&written](InfluxExporter &exporter, int count) {
+        for (int i = 0; i < count; i++) {
+            exporter.write(point(written++));
+            if (written % 25 == 0)
+                runEventLoop(10);
+        }
+    };
+
+    {
+        InfluxExporter exporter(config);
+        writeSome(exporter, 200);
+        // the server closes every connection without answering
+        standIn.drop = true;
+        writeSome(exporter, 200);
+        // then it's down
+        standIn.close();
+        writeSome(exporter, 200);
+        EXPECT_FALSE(exporter.spool().isEmpty());
+        ASSERT_TRUE(standIn.listen());
+        standIn.drop = false;
+        writeSome(exporter, 200);
+
+        EXPECT_TRUE(waitFor([&]() { return standIn.lines.size() == written; }, 90000))
+            << standIn.lines.size() << " of " << written;
+        EXPECT_TRUE(waitFor([&]() { return exporter.spool().isEmpty(); }, 5000));
+    }
+    EXPECT_EQ(standIn.duplicates, 0);
+
+    // throughput with large batches
+    standIn.lines.clear();
+    standIn.requests = 0;
+    written = 0;
+    config.batchPoints = 5000;
+    InfluxExporter exporter(config);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < 50000; i++)
+        exporter.write(point(written++));
+    exporter.flush();
+    EXPECT_TRUE(waitFor([&]() { return standIn.lines.size() == written; }, 60000));
+    qint64 elapsed = qMax<qint64>(timer.elapsed(), 1);
+
+    QByteArray batch;
+    for (int i = 0; i < 5000; i++)
+        batch.append(point(i));
+    timer.start();
+    QByteArray gz = InfluxExporter::gzip(batch);
+    qint64 gzipElapsed = timer.nsecsElapsed();
+
+    qDebug() << written << "points in" << standIn.requests << "requests," << elapsed << "ms:" << written * 1000 / elapsed
+             << "points/s; gzip of 5000 points" << batch.size() / 1024 << "->" << gz.size() / 1024 << "KiB in"
+             << gzipElapsed / 1000 << "us";
+}
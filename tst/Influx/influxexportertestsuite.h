@@ -0,0 +1,49 @@
+#ifndef INFLUXEXPORTERTESTSUITE_H
+#define INFLUXEXPORTERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class InfluxExporterTestSuite: public testing::Test {
+
+public:
+    InfluxExporterTestSuite();
+
+    /**
+     * @brief Test the line protocol of a sample: tags escaping, integer and float fields, time in ns
+     */
+    void test_lineProtocol();
+
+    /**
+     * @brief Test the gzip framing around the deflate stream of qCompress
+     */
+    void test_gzip();
+
+    /**
+     * @brief Test that the spool keeps the batches in order across a restart and drops the oldest when full
+     */
+    void test_spool();
+
+    /**
+     * @brief Test with a local HTTP server stand-in that no point is lost while it drops connections or
+     * is down, and measure the throughput
+     */
+    void test_noLossAcrossDisconnects();
+};
+
+TEST_F(InfluxExporterTestSuite, TestLineProtocol) {
+    this->test_lineProtocol();
+}
+
+TEST_F(InfluxExporterTestSuite, TestGzip) {
+    this->test_gzip();
+}
+
+TEST_F(InfluxExporterTestSuite, TestSpool) {
+    this->test_spool();
+}
+
+TEST_F(InfluxExporterTestSuite, TestNoLossAcrossDisconnects) {
+    this->test_noLossAcrossDisconnects();
+}
+
+#endif // INFLUXEXPORTERTESTSUITE_H
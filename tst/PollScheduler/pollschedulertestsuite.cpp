@@ -0,0 +1,159 @@
+#include "pollschedulertestsuite.h"
+
+#include <QDebug>
+#include <QEventLoop>
+#include <QTimer>
+#include <QVector>
+
+#include "Tools/testsettings.h"
+#include "devices/bike.h"
+#include "devices/pollscheduler.h"
+
+namespace {
+
+void runEventLoop(int ms) {
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+// a bike whose speed is set by the test
+class MovingBike : public bike {
+  public:
+    void setSpeed(double speed) { Speed = speed; }
+};
+
+} // namespace
+
+PollSchedulerTestSuite::PollSchedulerTestSuite() {}
+
+void PollSchedulerTestSuite::test_coalescing() {
+    PollScheduler *scheduler = PollScheduler::instance();
+    int timersBefore = scheduler->timers();
+
+    // the mix of a trainer, a heart rate belt, a power meter, a cadence sensor and a fan, and then some
+    const int periods[] = {200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 300, 300, 300, 500, 500, 500, 500, 1000};
+    const int count = sizeof(periods) / sizeof(periods[0]);
+    const int windowMs = 2000;
+    QList<PollTimer *> timers;
+    QVector<int> fired(count, 0);
+    int qtimerWakeups = 0;
+    for (int i = 0; i < count; i++) {
+        PollTimer *timer = new PollTimer();
+        QObject::connect(timer, &PollTimer::timeout, [&fired, i]() { fired[i]++; });
+        timer->start(periods[i]);
+        timers.append(timer);
+        qtimerWakeups += windowMs / periods[i];
+    }
+    EXPECT_EQ(scheduler->timers(), timersBefore + count);
+
+    quint64 before = scheduler->wakeups();
+    runEventLoop(windowMs);
+    quint64 wakeups = scheduler->wakeups() - before;
+
+    for (int i = 0; i < count; i++)
+        EXPECT_NEAR(fired[i], windowMs / periods[i], 2) << "timer " << i << " every " << periods[i] << " ms";
+    qDebug() << count << "timers in" << windowMs << "ms:" << wakeups << "scheduler wakeups, about" << qtimerWakeups
+             << "with a QTimer each";
+    EXPECT_LT(wakeups, (quint64)qtimerWakeups / 3);
+
+    qDeleteAll(timers);
+    EXPECT_EQ(scheduler->timers(), timersBefore);
+    qDebug().noquote() << scheduler->report();
+}
+
+void PollSchedulerTestSuite::test_changesInTimeout() {
+    PollTimer a, b, c;
+    PollTimer *d = new PollTimer();
+    int firedA = 0, firedB = 0, firedC = 0, firedD = 0;
+
+    // in the first wakeup, shared by all of them, a stops b, deletes d and restarts itself slower
+    QObject::connect(&a, &PollTimer::timeout, [&]() {
+        if (++firedA == 1) {
+            b.stop();
+            delete d;
+            d = nullptr;
+            a.start(400);
+        }
+    });
+    QObject::connect(&b, &PollTimer::timeout, [&firedB]() { firedB++; });
+    QObject::connect(&c, &PollTimer::timeout, [&firedC]() { firedC++; });
+    QObject::connect(d, &PollTimer::timeout, [&firedD]() { firedD++; });
+    a.start(100);
+    b.start(100);
+    c.start(100);
+    d->start(100);
+
+    runEventLoop(1000);
+    EXPECT_EQ(firedB, 0);
+    EXPECT_EQ(firedD, 0);
+    EXPECT_NEAR(firedA, 3, 1);
+    EXPECT_NEAR(firedC, 10, 2);
+    EXPECT_FALSE(b.isActive());
+    EXPECT_TRUE(a.isActive());
+    EXPECT_EQ(a.interval(), 400);
+
+    // a stopped timer starts again with its interval
+    b.start();
+    EXPECT_EQ(b.interval(), 100);
+    runEventLoop(350);
+    EXPECT_NEAR(firedB, 3, 1);
+
+    // 30 ms is one tick of the scheduler
+    c.start(30);
+    EXPECT_EQ(c.currentInterval(), PollScheduler::tickMs);
+    EXPECT_EQ(c.interval(), 30);
+}
+
+void PollSchedulerTestSuite::test_stillBackoff() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    MovingBike device;
+    PollTimer *timer = new PollTimer(&device);
+    int fired = 0;
+    QObject::connect(timer, &PollTimer::timeout, [&fired]() { fired++; });
+    timer->start(100);
+    timer->setNotificationDriven(true, 800, 300);
+
+    // still: 100 ms for 300 ms, then 200, 400 and 800 ms
+    runEventLoop(2500);
+    EXPECT_EQ(timer->currentInterval(), 800);
+    EXPECT_EQ(timer->interval(), 100);
+    EXPECT_LT(fired, 15);
+    qDebug() << "ticks in 2.5 s while still:" << fired << "instead of 25";
+
+    // moving again: back to the period at the next tick
+    device.setSpeed(20);
+    runEventLoop(1000);
+    EXPECT_EQ(timer->currentInterval(), 100);
+
+    // a timer of a driver that polls its device never slows down
+    device.setSpeed(0);
+    PollTimer *polled = new PollTimer(&device, PollTimer::Polled);
+    polled->start(100);
+    runEventLoop(1000);
+    EXPECT_EQ(polled->currentInterval(), 100);
+}
+
+void PollSchedulerTestSuite::test_notifiedFeed() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    MovingBike device;
+    PollTimer *polled = new PollTimer(&device, PollTimer::Polled);
+    PollTimer *notified = new PollTimer(&device, PollTimer::Notified);
+    polled->start(200);
+    notified->start(200);
+
+    // the period for the first 10 s of stillness, then 400, 800 and the keep alive
+    runEventLoop(9000);
+    EXPECT_EQ(notified->currentInterval(), 200);
+    runEventLoop(3500);
+    EXPECT_EQ(notified->currentInterval(), PollTimer::notifiedKeepAliveMs);
+    EXPECT_EQ(polled->currentInterval(), 200);
+
+    device.setSpeed(10);
+    runEventLoop(1500);
+    EXPECT_EQ(notified->currentInterval(), 200);
+}
@@ -0,0 +1,49 @@
+#ifndef POLLSCHEDULERTESTSUITE_H
+#define POLLSCHEDULERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class PollSchedulerTestSuite: public testing::Test {
+
+public:
+    PollSchedulerTestSuite();
+
+    /**
+     * @brief Test that timers with the same period share the wakeups, and compare the wakeups with
+     * one QTimer per driver
+     */
+    void test_coalescing();
+
+    /**
+     * @brief Test timers stopped, restarted and deleted from the timeout of another timer
+     */
+    void test_changesInTimeout();
+
+    /**
+     * @brief Test the back-off of a notification driven timer while its device is still
+     */
+    void test_stillBackoff();
+
+    /**
+     * @brief Test that a Notified timer backs off to the keep alive while still and a Polled one doesn't
+     */
+    void test_notifiedFeed();
+};
+
+TEST_F(PollSchedulerTestSuite, TestCoalescing) {
+    this->test_coalescing();
+}
+
+TEST_F(PollSchedulerTestSuite, TestChangesInTimeout) {
+    this->test_changesInTimeout();
+}
+
+TEST_F(PollSchedulerTestSuite, TestStillBackoff) {
+    this->test_stillBackoff();
+}
+
+TEST_F(PollSchedulerTestSuite, TestNotifiedFeed) {
+    this->test_notifiedFeed();
+}
+
+#endif // POLLSCHEDULERTESTSUITE_H
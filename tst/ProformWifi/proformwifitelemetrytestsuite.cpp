@@ -0,0 +1,214 @@
+#include "proformwifitelemetrytestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QTimer>
+#include <QtWebSockets/QWebSocket>
+#include <QtWebSockets/QWebSocketServer>
+
+#include "devices/proformwifitelemetry.h"
+
+namespace {
+
+const char *const fieldNames[ProformWifiTelemetry::FieldCount] = {
+    "Master State",    "Current KPH",     "KPH",          "Maximum KPH",  "Kilometers",     "Chilometri",
+    "RPM",             "Current Watts",   "Watt attuali", "Target Watts", "Actual Incline", "Incline",
+    "Maximum Incline", "Minimum Incline", "Resistance",   "Chest Pulse",  "key"};
+
+// frames as a TDF bike, a TDF2 bike and a treadmill send them
+const char *const recordedFrames[] = {
+    "{\"type\":\"stats\",\"values\":{\"Current KPH\":\"0.0\",\"Kilometers\":\"0.000\",\"RPM\":\"0\","
+    "\"Current Watts\":\"0\",\"Actual Incline\":\"0.0\",\"Resistance\":\"1\",\"Maximum Incline\":\"20.0\"}}",
+    "{\"type\":\"stats\",\"values\":{\"Current KPH\":\"23.41\",\"Kilometers\":\"1.284\",\"RPM\":\"86\","
+    "\"Current Watts\":\"187\",\"Actual Incline\":\"-2.5\",\"Resistance\":\"12\",\"Target Watts\":\"190\"}}",
+    "{\"type\":\"stats\",\"values\":{\"Master State\":\"Running\",\"KPH\":\"31.2\",\"RPM\":\"94\","
+    "\"Current Watts\":\"265\",\"Incline\":\"4.0\",\"Resistance\":\"16\"}}",
+    "{\"type\":\"event\",\"values\":{\"key\":{\"code\":\"174\",\"name\":\"LEFT EXTERNAL GEAR UP\",\"held\":\"-1\"}}}",
+    "{\"type\":\"event\",\"values\":{\"key\":{\"code\":\"175\",\"name\":\"RIGHT EXTERNAL GEAR DOWN\",\"held\":\"250\"}}}",
+    "{\"type\":\"stats\",\"values\":{\"Chilometri\":\"2.500\",\"Watt attuali\":\"143\",\"RPM\":\"71\"}}",
+    "{\"type\":\"stats\",\"values\":{\"Current KPH\":\"10.5\",\"Kilometers\":\"3.020\",\"Actual Incline\":\"6.5\","
+    "\"Chest Pulse\":\"148\",\"Current Watts\":\"0\",\"Maximum KPH\":\"19.3\",\"Maximum Incline\":\"15.0\","
+    "\"Minimum Incline\":\"-3.0\",\"Tread Belt Time\":\"00:12:31\",\"Calories\":\"212\"}}",
+    "{\n  \"type\": \"stats\",\n  \"values\": {\n    \"Current KPH\": \"12.00\",\n    \"Incline\": \"1.5\"\n  }\n}",
+};
+
+// what the drivers read before, with a full QJsonDocument
+void expectSameAsDocument(const ProformWifiTelemetry &telemetry, const QString &frame) {
+    QJsonValue values = QJsonDocument::fromJson(frame.toUtf8()).object().value(QStringLiteral("values"));
+    for (int i = 0; i < ProformWifiTelemetry::FieldCount; i++) {
+        ProformWifiTelemetry::Field field = (ProformWifiTelemetry::Field)i;
+        QJsonValue v = values[QString::fromLatin1(fieldNames[i])];
+        EXPECT_EQ(telemetry.has(field), !v.isUndefined()) << fieldNames[i] << " in " << frame.toStdString();
+        if (!v.isUndefined() && field != ProformWifiTelemetry::Key)
+            EXPECT_EQ(telemetry.value(field), v.toString().toDouble()) << fieldNames[i] << " in "
+                                                                       << frame.toStdString();
+    }
+    QJsonObject key = values[QStringLiteral("key")].toObject();
+    EXPECT_EQ(telemetry.keyCode(), key.value(QStringLiteral("code")).toString());
+    EXPECT_EQ(telemetry.keyName(), key.value(QStringLiteral("name")).toString());
+    EXPECT_EQ(telemetry.keyHeld(), key.value(QStringLiteral("held")).toString());
+}
+
+// runs the event loop until the condition holds or the timeout expires
+template <typename Condition> bool waitFor(Condition condition, int timeoutMs) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition() && timer.elapsed() < timeoutMs) {
+        QEventLoop loop;
+        QTimer::singleShot(5, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    return condition();
+}
+
+} // namespace
+
+ProformWifiTelemetryTestSuite::ProformWifiTelemetryTestSuite() {}
+
+void ProformWifiTelemetryTestSuite::test_recordedFrames() {
+    ProformWifiTelemetry telemetry;
+    for (const char *frame : recordedFrames) {
+        EXPECT_TRUE(telemetry.parse(QString::fromUtf8(frame))) << frame;
+        expectSameAsDocument(telemetry, QString::fromUtf8(frame));
+    }
+
+    ASSERT_TRUE(telemetry.parse(QString::fromUtf8(recordedFrames[1])));
+    EXPECT_DOUBLE_EQ(telemetry.value(ProformWifiTelemetry::CurrentKph), 23.41);
+    EXPECT_DOUBLE_EQ(telemetry.value(ProformWifiTelemetry::ActualIncline), -2.5);
+    EXPECT_FALSE(telemetry.has(ProformWifiTelemetry::Kph));
+
+    ASSERT_TRUE(telemetry.parse(QString::fromUtf8(recordedFrames[3])));
+    EXPECT_TRUE(telemetry.has(ProformWifiTelemetry::Key));
+    EXPECT_EQ(telemetry.keyName(), QStringLiteral("LEFT EXTERNAL GEAR UP"));
+    EXPECT_EQ(telemetry.keyHeld(), QStringLiteral("-1"));
+    EXPECT_FALSE(telemetry.has(ProformWifiTelemetry::Rpm));
+}
+
+void ProformWifiTelemetryTestSuite::test_malformedFrames() {
+    const char *const frames[] = {
+        "",
+        "{",
+        "{}",
+        "[]",
+        "null",
+        "{\"values\":{\"RPM\":\"80\"",
+        "{\"values\":{\"RPM\":\"80\"}} x",
+        "{\"values\":{\"RPM\":\"80\",}}",
+        "{\"values\":{\"RPM\":80,\"KPH\":null,\"Incline\":true,\"Resistance\":[\"1\"],\"Current Watts\":{}}}",
+        "{\"values\":{\"RPM\":\"abc\",\"KPH\":\" 12.5 \",\"Incline\":\"1e1\",\"Resistance\":\"\"}}",
+        "{\"values\":{\"Kilometers\":\"123456789012345678\",\"Current KPH\":\"0.1234567890123456789\"}}",
+        "{\"values\":{\"\\u0052PM\":\"7\\u0035\",\"key\":{\"name\":\"LEFT \\\"EXTERNAL\\\"\\n\\u00e0\"}}}",
+        "{\"other\":{\"values\":{\"RPM\":\"80\"}},\"values\":{\"x\":[{\"RPM\":\"1\"},[],{}],\"RPM\":\"90\"}}",
+        "{\"values\":{\"key\":\"held\"}}",
+        "{\"values\":{\"RPM\":\"80\\",
+        // numbers outside the JSON grammar
+        "{\"values\":{\"RPM\":01}}",
+        "{\"values\":{\"RPM\":-}}",
+        "{\"values\":{\"RPM\":+1}}",
+        "{\"values\":{\"RPM\":.5}}",
+        "{\"values\":{\"RPM\":1e}}",
+        "{\"values\":{\"RPM\":1e+}}",
+        "{\"values\":{\"RPM\":1-2}}",
+        "{\"values\":{\"RPM\":0x10}}",
+        "{\"n\":1.2.3,\"values\":{\"RPM\":\"80\"}}",
+        "{\"n\":-0.5e+3,\"values\":{\"x\":0,\"y\":10E-2,\"z\":[-1,2e5],\"RPM\":\"80\"}}",
+        // escapes outside the JSON grammar
+        "{\"values\":{\"RPM\":\"8\\u00G0\"}}",
+        "{\"values\":{\"RPM\":\"\\u12\"}}",
+        "{\"values\":{\"key\":{\"name\":\"\\/\\b\\f\\r\\t\"}}}",
+    };
+
+    ProformWifiTelemetry telemetry;
+    for (const char *frame : frames) {
+        QString f = QString::fromUtf8(frame);
+        EXPECT_EQ(telemetry.parse(f), QJsonDocument::fromJson(f.toUtf8()).isObject()) << frame;
+        expectSameAsDocument(telemetry, f);
+    }
+
+    // stricter than QJsonDocument, which takes a fraction without digits and any character escaped
+    EXPECT_FALSE(telemetry.parse(QStringLiteral("{\"values\":{\"RPM\":1.}}")));
+    EXPECT_FALSE(telemetry.parse(QStringLiteral("{\"values\":{\"RPM\":1.e5}}")));
+    EXPECT_FALSE(telemetry.parse(QStringLiteral("{\"values\":{\"RPM\":\"8\\x0\"}}")));
+    EXPECT_FALSE(telemetry.parse(QStringLiteral("{\"values\":{\"key\":{\"name\":\"\\a\"}}}")));
+
+    // a malformed frame leaves nothing of the previous one
+    ASSERT_TRUE(telemetry.parse(QString::fromUtf8(recordedFrames[3])));
+    EXPECT_FALSE(telemetry.parse(QStringLiteral("{\"values\":{\"RPM\":\"80\"")));
+    EXPECT_FALSE(telemetry.has(ProformWifiTelemetry::Rpm));
+    EXPECT_TRUE(telemetry.keyName().isEmpty());
+}
+
+void ProformWifiTelemetryTestSuite::test_websocketReplay() {
+    const int count = sizeof(recordedFrames) / sizeof(recordedFrames[0]);
+
+    // the machine: it sends the recorded frames to whoever opens /control
+    QWebSocketServer machine(QStringLiteral("proform"), QWebSocketServer::NonSecureMode);
+    ASSERT_TRUE(machine.listen(QHostAddress::LocalHost));
+    QObject::connect(&machine, &QWebSocketServer::newConnection, [&]() {
+        QWebSocket *socket = machine.nextPendingConnection();
+        for (const char *frame : recordedFrames)
+            socket->sendTextMessage(QString::fromUtf8(frame));
+    });
+
+    // the driver side, connected as proformwifibike::connectToDevice() does
+    ProformWifiTelemetry telemetry;
+    QWebSocket websocket;
+    int received = 0;
+    double lastRpm = -1;
+    QObject::connect(&websocket, &QWebSocket::textMessageReceived, [&](const QString &message) {
+        EXPECT_TRUE(telemetry.parse(message));
+        expectSameAsDocument(telemetry, message);
+        if (telemetry.has(ProformWifiTelemetry::Rpm))
+            lastRpm = telemetry.value(ProformWifiTelemetry::Rpm);
+        received++;
+    });
+    websocket.open(QUrl(QStringLiteral("ws://127.0.0.1:%1/control").arg(machine.serverPort())));
+
+    EXPECT_TRUE(waitFor([&]() { return received == count; }, 5000));
+    EXPECT_EQ(received, count);
+    EXPECT_DOUBLE_EQ(lastRpm, 71);
+    websocket.close();
+}
+
+void ProformWifiTelemetryTestSuite::test_parserBenchmark() {
+    // the mix of the recorded frames: stats of the bikes and of the treadmill, and the key events
+    QList<QString> recorded;
+    for (const char *frame : recordedFrames)
+        recorded.append(QString::fromUtf8(frame));
+    const int frames = 20000;
+
+    QElapsedTimer timer;
+    ProformWifiTelemetry telemetry;
+    double sum = 0;
+    timer.start();
+    for (int i = 0; i < frames; i++) {
+        telemetry.parse(recorded.at(i % recorded.size()));
+        for (int f = 0; f < ProformWifiTelemetry::Key; f++)
+            if (telemetry.has((ProformWifiTelemetry::Field)f))
+                sum += telemetry.value((ProformWifiTelemetry::Field)f);
+    }
+    qint64 scanner = timer.nsecsElapsed();
+
+    double documentSum = 0;
+    timer.start();
+    for (int i = 0; i < frames; i++) {
+        const QString &frame = recorded.at(i % recorded.size());
+        QJsonValue values = QJsonDocument::fromJson(frame.toLocal8Bit()).object().value(QStringLiteral("values"));
+        for (int f = 0; f < ProformWifiTelemetry::Key; f++) {
+            QJsonValue v = values[QString::fromLatin1(fieldNames[f])];
+            if (!v.isUndefined())
+                documentSum += v.toString().toDouble();
+        }
+    }
+    qint64 document = timer.nsecsElapsed();
+    EXPECT_DOUBLE_EQ(sum, documentSum);
+
+    qDebug() << "parse per frame: scanner" << scanner / frames << "ns, QJsonDocument" << document / frames << "ns";
+    // far below the time between two frames even in a debug build
+    EXPECT_LT(scanner / frames, 100000);
+}
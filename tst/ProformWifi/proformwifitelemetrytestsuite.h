@@ -0,0 +1,48 @@
+#ifndef PROFORMWIFITELEMETRYTESTSUITE_H
+#define PROFORMWIFITELEMETRYTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class ProformWifiTelemetryTestSuite: public testing::Test {
+
+public:
+    ProformWifiTelemetryTestSuite();
+
+    /**
+     * @brief Test that recorded bike and treadmill frames give the values QJsonDocument gives
+     */
+    void test_recordedFrames();
+
+    /**
+     * @brief Test truncated, malformed and unusual frames against QJsonDocument
+     */
+    void test_malformedFrames();
+
+    /**
+     * @brief Test the frames replayed by a local websocket server standing in for the machine
+     */
+    void test_websocketReplay();
+
+    /**
+     * @brief Test the time to parse a frame against QJsonDocument
+     */
+    void test_parserBenchmark();
+};
+
+TEST_F(ProformWifiTelemetryTestSuite, TestRecordedFrames) {
+    this->test_recordedFrames();
+}
+
+TEST_F(ProformWifiTelemetryTestSuite, TestMalformedFrames) {
+    this->test_malformedFrames();
+}
+
+TEST_F(ProformWifiTelemetryTestSuite, TestWebsocketReplay) {
+    this->test_websocketReplay();
+}
+
+TEST_F(ProformWifiTelemetryTestSuite, TestParserBenchmark) {
+    this->test_parserBenchmark();
+}
+
+#endif // PROFORMWIFITELEMETRYTESTSUITE_H
@@ -0,0 +1,268 @@
+#include "sensorfusiontestsuite.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+
+#include "Tools/testsettings.h"
+#include "devices/fakebike/fakebike.h"
+#include "qzsettings.h"
+#include "sensorfusion.h"
+
+namespace {
+
+// runs the event loop until the condition holds or the timeout expires
+template <typename Condition> bool waitFor(Condition condition, int timeoutMs) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition() && timer.elapsed() < timeoutMs) {
+        QEventLoop loop;
+        QTimer::singleShot(5, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    return condition();
+}
+
+} // namespace
+
+SensorFusionTestSuite::SensorFusionTestSuite() {}
+
+void SensorFusionTestSuite::test_priorityAndFallback() {
+    for (SensorFusion::Rule rule : {SensorFusion::Priority, SensorFusion::Fallback}) {
+        SensorFusion fusion(nullptr, 0);
+        SensorFusion::MetricConfig config;
+        config.rule = rule;
+        config.priority = {SensorFusion::HeartRateBelt, SensorFusion::RunPowerSensor};
+        config.staleMs = 3000;
+        fusion.setConfig(SensorFusion::Heart, config);
+
+        // nothing yet
+        fusion.tick(0);
+        EXPECT_FALSE(fusion.hasValue(SensorFusion::Heart));
+        EXPECT_EQ(fusion.selectedSource(SensorFusion::Heart), -1);
+
+        // both sending: the belt, whatever arrived last
+        qint64 t = 0;
+        for (; t < 5000; t += 1000) {
+            fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 140, t);
+            fusion.input(SensorFusion::Heart, SensorFusion::RunPowerSensor, 150, t + 500);
+            fusion.tick(t + 600);
+            EXPECT_EQ(fusion.value(SensorFusion::Heart), 140);
+            EXPECT_EQ(fusion.selectedSource(SensorFusion::Heart), SensorFusion::HeartRateBelt);
+        }
+
+        // the belt stops: the Stryd once it's stale
+        for (; t < 10000; t += 1000) {
+            fusion.input(SensorFusion::Heart, SensorFusion::RunPowerSensor, 150, t + 500);
+            fusion.tick(t + 600);
+        }
+        EXPECT_EQ(fusion.value(SensorFusion::Heart), 150);
+        EXPECT_EQ(fusion.selectedSource(SensorFusion::Heart), SensorFusion::RunPowerSensor);
+
+        // the belt is back: priority switches back to it, fallback stays on the Stryd
+        for (; t < 12000; t += 1000) {
+            fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 141, t);
+            fusion.input(SensorFusion::Heart, SensorFusion::RunPowerSensor, 151, t + 500);
+            fusion.tick(t + 600);
+        }
+        if (rule == SensorFusion::Priority) {
+            EXPECT_EQ(fusion.value(SensorFusion::Heart), 141);
+            EXPECT_EQ(fusion.selectedSource(SensorFusion::Heart), SensorFusion::HeartRateBelt);
+        } else {
+            EXPECT_EQ(fusion.value(SensorFusion::Heart), 151);
+            EXPECT_EQ(fusion.selectedSource(SensorFusion::Heart), SensorFusion::RunPowerSensor);
+
+            // until the Stryd goes stale
+            for (; t < 16000; t += 1000) {
+                fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 142, t);
+                fusion.tick(t + 600);
+            }
+            EXPECT_EQ(fusion.value(SensorFusion::Heart), 142);
+            EXPECT_EQ(fusion.selectedSource(SensorFusion::Heart), SensorFusion::HeartRateBelt);
+        }
+    }
+}
+
+void SensorFusionTestSuite::test_averageAndWindow() {
+    SensorFusion fusion(nullptr, 0);
+    SensorFusion::MetricConfig config;
+    config.rule = SensorFusion::Average;
+    fusion.setConfig(SensorFusion::Power, config);
+
+    fusion.input(SensorFusion::Power, SensorFusion::PowerSensor, 200, 0);
+    fusion.input(SensorFusion::Power, SensorFusion::RunPowerSensor, 220, 100);
+    fusion.tick(200);
+    EXPECT_DOUBLE_EQ(fusion.value(SensorFusion::Power), 210);
+    EXPECT_EQ(fusion.selectedSource(SensorFusion::Power), -1);
+
+    // one stale: the other alone
+    fusion.input(SensorFusion::Power, SensorFusion::RunPowerSensor, 230, 3050);
+    fusion.tick(3100);
+    EXPECT_DOUBLE_EQ(fusion.value(SensorFusion::Power), 230);
+    EXPECT_EQ(fusion.selectedSource(SensorFusion::Power), SensorFusion::RunPowerSensor);
+
+    // the crank events of a CSC sensor: every value holds until the next one
+    config.rule = SensorFusion::Priority;
+    config.windowMs = 2000;
+    fusion.setConfig(SensorFusion::Cadence, config);
+    fusion.input(SensorFusion::Cadence, SensorFusion::CadenceSensor, 60, 10000);
+    fusion.tick(10500);
+    EXPECT_DOUBLE_EQ(fusion.value(SensorFusion::Cadence), 60);
+    fusion.input(SensorFusion::Cadence, SensorFusion::CadenceSensor, 90, 11000);
+    fusion.tick(12000);
+    EXPECT_DOUBLE_EQ(fusion.value(SensorFusion::Cadence), 75);
+    fusion.tick(12500);
+    EXPECT_DOUBLE_EQ(fusion.value(SensorFusion::Cadence), (60 * 500 + 90 * 1500) / 2000.0);
+    fusion.input(SensorFusion::Cadence, SensorFusion::CadenceSensor, 90, 13000);
+    fusion.tick(13000);
+    EXPECT_DOUBLE_EQ(fusion.value(SensorFusion::Cadence), 90);
+
+    // a sample at the tick alone is its own value
+    fusion.setConfig(SensorFusion::Speed, config);
+    fusion.input(SensorFusion::Speed, SensorFusion::RunPowerSensor, 12.5, 14000);
+    fusion.tick(14000);
+    EXPECT_DOUBLE_EQ(fusion.value(SensorFusion::Speed), 12.5);
+}
+
+void SensorFusionTestSuite::test_device() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    fakebike bike(false, true, true);
+    SensorFusion fusion(&bike, 0);
+    int fusedPower = 0;
+    QObject::connect(&fusion, &SensorFusion::fused, [&fusedPower](int metric, double) {
+        if (metric == SensorFusion::Power)
+            fusedPower++;
+    });
+    int stale = 0;
+    QObject::connect(&fusion, &SensorFusion::sourceStale, [&stale](int, int) { stale++; });
+
+    fusion.input(SensorFusion::Power, SensorFusion::PowerSensor, 250.4, 0);
+    fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 0, 0);
+    fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 131, 0);
+    fusion.input(SensorFusion::Cadence, SensorFusion::CadenceSensor, 88, 0);
+    fusion.tick(100);
+    EXPECT_EQ(bike.wattsMetric().value(), 250);
+    EXPECT_EQ(bike.currentHeart().value(), 131);
+    EXPECT_EQ(bike.currentCadence().value(), 88);
+    EXPECT_EQ(fusedPower, 1);
+
+    // gone: a 0 once, then the metric is left to the device
+    fusion.tick(5000);
+    EXPECT_EQ(bike.wattsMetric().value(), 0);
+    EXPECT_EQ(bike.currentHeart().value(), 0);
+    EXPECT_EQ(fusedPower, 2);
+    EXPECT_EQ(stale, 3);
+    bike.powerSensor(180);
+    fusion.tick(6000);
+    EXPECT_EQ(bike.wattsMetric().value(), 180);
+    EXPECT_EQ(fusedPower, 2);
+    EXPECT_FALSE(fusion.hasValue(SensorFusion::Power));
+}
+
+void SensorFusionTestSuite::test_health() {
+    SensorFusion fusion(nullptr, 0);
+    for (qint64 t = 0; t <= 10000; t += 250) {
+        fusion.input(SensorFusion::Cadence, SensorFusion::CadenceSensor, 80, t);
+        if (t % 1000 == 0)
+            fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 120, t);
+        fusion.tick(t);
+    }
+    QList<SensorFusion::Health> health = fusion.health(10100);
+    ASSERT_EQ(health.size(), 2);
+    EXPECT_FALSE(health.at(1).stale);
+    EXPECT_TRUE(health.at(1).selected);
+    EXPECT_EQ(health.at(1).ageMs, 100);
+
+    // the belt drops out twice
+    fusion.tick(14000);
+    fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 121, 15000);
+    fusion.tick(15000);
+    fusion.tick(19000);
+
+    health = fusion.health(19000);
+    ASSERT_EQ(health.size(), 2);
+    const SensorFusion::Health &heart = health.at(0);
+    EXPECT_EQ(heart.metric, SensorFusion::Heart);
+    EXPECT_EQ(heart.source, SensorFusion::HeartRateBelt);
+    EXPECT_EQ(heart.samples, 12u);
+    EXPECT_EQ(heart.value, 121);
+    EXPECT_EQ(heart.ageMs, 4000);
+    EXPECT_EQ(heart.dropouts, 2u);
+    EXPECT_TRUE(heart.stale);
+    EXPECT_FALSE(heart.selected);
+
+    const SensorFusion::Health &cadence = health.at(1);
+    EXPECT_EQ(cadence.metric, SensorFusion::Cadence);
+    EXPECT_EQ(cadence.samples, 41u);
+    // the history is the last 32 samples, 4 a second
+    EXPECT_DOUBLE_EQ(cadence.rate, 4);
+    EXPECT_EQ(cadence.dropouts, 1u);
+    EXPECT_FALSE(cadence.selected);
+    EXPECT_EQ(fusion.healthList().size(), 2);
+}
+
+void SensorFusionTestSuite::test_eventDriven() {
+    SensorFusion fusion(nullptr, 50);
+    SensorFusion::MetricConfig config;
+    config.staleMs = 200;
+    fusion.setConfig(SensorFusion::Heart, config);
+    int fusedHeart = 0;
+    double lastHeart = -1;
+    QObject::connect(&fusion, &SensorFusion::fused, [&](int metric, double value) {
+        if (metric == SensorFusion::Heart) {
+            fusedHeart++;
+            lastHeart = value;
+        }
+    });
+
+    // merged as it arrives
+    fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 130);
+    EXPECT_EQ(fusedHeart, 1);
+    EXPECT_EQ(lastHeart, 130);
+    fusion.input(SensorFusion::Heart, SensorFusion::HeartRateBelt, 132);
+    EXPECT_EQ(fusedHeart, 2);
+    EXPECT_EQ(fusion.value(SensorFusion::Heart), 132);
+
+    // a single source: nothing to merge until it goes stale
+    waitFor([]() { return false; }, 100);
+    EXPECT_EQ(fusedHeart, 2);
+    EXPECT_TRUE(waitFor([&]() { return !fusion.hasValue(SensorFusion::Heart); }, 1000));
+    EXPECT_EQ(fusedHeart, 3);
+    EXPECT_EQ(lastHeart, 0);
+
+    // nothing left to check
+    waitFor([]() { return false; }, 300);
+    EXPECT_EQ(fusedHeart, 3);
+}
+
+void SensorFusionTestSuite::test_settings() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    SensorFusion::MetricConfig config = SensorFusion::configFromSettings(SensorFusion::Heart);
+    EXPECT_EQ(config.rule, SensorFusion::Priority);
+    EXPECT_EQ(config.priority,
+              QList<SensorFusion::Source>({SensorFusion::HeartRateBelt, SensorFusion::Watch,
+                                           SensorFusion::RunPowerSensor}));
+    EXPECT_EQ(config.staleMs, QZSettings::default_sensor_fusion_stale_ms);
+    EXPECT_EQ(config.windowMs, 0);
+    EXPECT_EQ(SensorFusion::configFromSettings(SensorFusion::Cadence).windowMs,
+              QZSettings::default_sensor_fusion_cadence_window_ms);
+
+    testSettings.qsettings.setValue(QZSettings::sensor_fusion_power_rule, 1);
+    testSettings.qsettings.setValue(QZSettings::sensor_fusion_power_priority, QStringLiteral(" Stryd, nothing,,power,stryd"));
+    testSettings.qsettings.setValue(QZSettings::sensor_fusion_speed_rule, 7);
+    testSettings.qsettings.setValue(QZSettings::sensor_fusion_stale_ms, 1500);
+    config = SensorFusion::configFromSettings(SensorFusion::Power);
+    EXPECT_EQ(config.rule, SensorFusion::Average);
+    EXPECT_EQ(config.priority, QList<SensorFusion::Source>({SensorFusion::RunPowerSensor, SensorFusion::PowerSensor}));
+    EXPECT_EQ(config.staleMs, 1500);
+    EXPECT_EQ(SensorFusion::configFromSettings(SensorFusion::Speed).rule, SensorFusion::Priority);
+
+    testSettings.qsettings.remove(QZSettings::sensor_fusion_power_rule);
+    testSettings.qsettings.remove(QZSettings::sensor_fusion_power_priority);
+    testSettings.qsettings.remove(QZSettings::sensor_fusion_speed_rule);
+    testSettings.qsettings.remove(QZSettings::sensor_fusion_stale_ms);
+}
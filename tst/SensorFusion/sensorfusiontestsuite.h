@@ -0,0 +1,67 @@
+#ifndef SENSORFUSIONTESTSUITE_H
+#define SENSORFUSIONTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SensorFusionTestSuite: public testing::Test {
+
+public:
+    SensorFusionTestSuite();
+
+    /**
+     * @brief Test the priority and fallback rules when the first source goes stale and comes back
+     */
+    void test_priorityAndFallback();
+
+    /**
+     * @brief Test the average of the sources that aren't stale, and the time weighted window of a source
+     */
+    void test_averageAndWindow();
+
+    /**
+     * @brief Test that the merged values reach the device, and that it gets a 0 once when all the sources are gone
+     */
+    void test_device();
+
+    /**
+     * @brief Test the health of the sources: samples, rate, age and dropouts
+     */
+    void test_health();
+
+    /**
+     * @brief Test that a sample reaches the device without waiting for a tick, and that the timer only runs to
+     * find the stale sources
+     */
+    void test_eventDriven();
+
+    /**
+     * @brief Test the reading of the rules and priority lists of the settings
+     */
+    void test_settings();
+};
+
+TEST_F(SensorFusionTestSuite, TestPriorityAndFallback) {
+    this->test_priorityAndFallback();
+}
+
+TEST_F(SensorFusionTestSuite, TestAverageAndWindow) {
+    this->test_averageAndWindow();
+}
+
+TEST_F(SensorFusionTestSuite, TestDevice) {
+    this->test_device();
+}
+
+TEST_F(SensorFusionTestSuite, TestHealth) {
+    this->test_health();
+}
+
+TEST_F(SensorFusionTestSuite, TestEventDriven) {
+    this->test_eventDriven();
+}
+
+TEST_F(SensorFusionTestSuite, TestSettings) {
+    this->test_settings();
+}
+
+#endif // SENSORFUSIONTESTSUITE_H
@@ -0,0 +1,102 @@
+#include "sessionrecordertestsuite.h"
+
+#include <QDir>
+#include <QFile>
+
+#include "Tools/testsettings.h"
+#include "devices/bike.h"
+#include "qfit.h"
+#include "qzsettings.h"
+#include "sessionrecorder.h"
+
+namespace {
+
+// a bike whose values are set by the test
+class SampleBike : public bike {
+  public:
+    void set(double speed, double watt, double cadence, double resistance, double inclination) {
+        Speed = speed;
+        m_watt = watt;
+        Cadence = cadence;
+        Resistance = resistance;
+        Inclination = inclination;
+        m_pelotonResistance = resistance * 2;
+        m_pedalSmoothness = 21;
+        m_rightBalance = 52;
+    }
+};
+
+} // namespace
+
+SessionRecorderTestSuite::SessionRecorderTestSuite() {}
+
+void SessionRecorderTestSuite::test_bikeSample() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QZSettings::power_avg_5s, false);
+    testSettings.qsettings.setValue(QZSettings::bike_cadence_sensor, false);
+
+    SampleBike device;
+    device.set(31.5, 240, 88, 12, 3.5);
+    device.addCurrentDistance1s(0.5);
+
+    SessionLine s = SessionRecorder::sample(&device, true);
+    EXPECT_DOUBLE_EQ(s.speed, 31.5);
+    EXPECT_EQ(s.watt, 240);
+    EXPECT_EQ(s.cadence, 88);
+    EXPECT_EQ(s.resistance, 12);
+    EXPECT_EQ(s.peloton_resistance, 24);
+    EXPECT_EQ(s.inclination, 3);
+    EXPECT_DOUBLE_EQ(s.distance, 0.5);
+    EXPECT_DOUBLE_EQ(s.pace, 0);
+    EXPECT_DOUBLE_EQ(s.pedalSmoothness, 21);
+    EXPECT_DOUBLE_EQ(s.rightBalance, 52);
+    EXPECT_TRUE(s.lapTrigger);
+    EXPECT_FALSE(SessionRecorder::sample(&device).lapTrigger);
+
+    // the inclination of a bike with the peloton cadence sensor is not recorded
+    testSettings.qsettings.setValue(QZSettings::bike_cadence_sensor, true);
+    EXPECT_EQ(SessionRecorder::sample(&device).inclination, 0);
+
+    QString filename = SessionRecorder::fitFileName();
+    EXPECT_TRUE(filename.endsWith(QStringLiteral(".fit")));
+    EXPECT_FALSE(filename.mid(filename.lastIndexOf(QLatin1Char('/')) + 1).contains(QLatin1Char(':')));
+}
+
+void SessionRecorderTestSuite::test_fitRoundTrip() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QZSettings::power_avg_5s, false);
+
+    SampleBike device;
+    QList<SessionLine> session;
+    QDateTime start = QDateTime::currentDateTime().addSecs(-60);
+    for (int i = 0; i < 60; i++) {
+        device.set(20 + i / 10.0, 100 + i, 70 + i / 2, 5, 0);
+        device.addCurrentDistance1s(device.currentSpeed().value() / 3600.0);
+        SessionLine s = SessionRecorder::sample(&device);
+        s.time = start.addSecs(i);
+        session.append(s);
+    }
+
+    QString filename = QDir::tempPath() + QStringLiteral("/sessionrecordertest.fit");
+    QFile::remove(filename);
+    qfit::save(filename, session, bluetoothdevice::BIKE);
+    QList<SessionLine> read;
+    qfit::open(filename, &read);
+    QFile::remove(filename);
+
+    ASSERT_FALSE(read.isEmpty());
+    int matched = 0;
+    for (const SessionLine &r : read) {
+        for (const SessionLine &s : session) {
+            if (r.watt == s.watt) {
+                EXPECT_EQ(r.cadence, s.cadence);
+                EXPECT_NEAR(r.speed, s.speed, 0.1);
+                matched++;
+                break;
+            }
+        }
+    }
+    EXPECT_GE(matched, session.size() / 2);
+}
@@ -0,0 +1,30 @@
+#ifndef SESSIONRECORDERTESTSUITE_H
+#define SESSIONRECORDERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SessionRecorderTestSuite: public testing::Test {
+
+public:
+    SessionRecorderTestSuite();
+
+    /**
+     * @brief Test that a sample of a bike carries the values of the device, as homeform recorded them
+     */
+    void test_bikeSample();
+
+    /**
+     * @brief Test that the samples survive a FIT file round trip
+     */
+    void test_fitRoundTrip();
+};
+
+TEST_F(SessionRecorderTestSuite, TestBikeSample) {
+    this->test_bikeSample();
+}
+
+TEST_F(SessionRecorderTestSuite, TestFitRoundTrip) {
+    this->test_fitRoundTrip();
+}
+
+#endif // SESSIONRECORDERTESTSUITE_H
@@ -0,0 +1,129 @@
+#include "signalfiltertestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "devices/csafe/kalmanfilter.h"
+#include "signalfilter.h"
+
+SignalFilterTestSuite::SignalFilterTestSuite() {}
+
+void SignalFilterTestSuite::test_parse() {
+    SignalFilterChain chain;
+
+    EXPECT_TRUE(chain.parse(QString()));
+    EXPECT_TRUE(chain.isEmpty());
+
+    EXPECT_TRUE(chain.parse(QStringLiteral("outlier:4;median:3;kalman:1,0.01,0.75")));
+    EXPECT_EQ(chain.size(), 3);
+
+    // the parameters are optional, spaces and case are ignored
+    EXPECT_TRUE(chain.parse(QStringLiteral(" EMA ; median ;slew:50; outlier:3 ")));
+    EXPECT_EQ(chain.size(), 4);
+
+    const char *const invalid[] = {
+        "unknown:1",          // no such stage
+        "ema:0",              // alpha out of range
+        "ema:1.5",            // alpha out of range
+        "median:10",          // longer than maxMedian
+        "median:2.5",         // not a whole number of samples
+        "slew",               // the rate has no default
+        "kalman:0",           // the measure error must be positive
+        "ema:abc",            // not a number
+        "kalman:1,2,3,4",     // too many parameters
+        "ema;ema;ema;ema;ema" // more than maxStages
+    };
+    for (const char *spec : invalid) {
+        EXPECT_FALSE(chain.parse(QString::fromLatin1(spec))) << spec;
+        EXPECT_TRUE(chain.isEmpty()) << spec;
+    }
+
+    // an empty chain lets the values through
+    EXPECT_DOUBLE_EQ(chain.apply(123.4, 1), 123.4);
+}
+
+void SignalFilterTestSuite::test_stepResponse() {
+    SignalFilterChain chain;
+
+    // ema: a step from 0 to 100 decays by (1 - alpha) at every sample
+    ASSERT_TRUE(chain.parse(QStringLiteral("ema:0.5")));
+    EXPECT_DOUBLE_EQ(chain.apply(0, 1), 0);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 1), 50);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 1), 75);
+    for (int i = 0; i < 50; i++)
+        chain.apply(100, 1);
+    EXPECT_NEAR(chain.apply(100, 1), 100, 1e-6);
+
+    // median: a single spike disappears, a step shows after half the window
+    ASSERT_TRUE(chain.parse(QStringLiteral("median:3")));
+    EXPECT_DOUBLE_EQ(chain.apply(100, 1), 100);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 1), 100);
+    EXPECT_DOUBLE_EQ(chain.apply(900, 1), 100);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 1), 100);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 1), 100);
+    EXPECT_DOUBLE_EQ(chain.apply(200, 1), 100);
+    EXPECT_DOUBLE_EQ(chain.apply(200, 1), 200);
+
+    // slew: 10 units per second, whatever the rate of the samples
+    ASSERT_TRUE(chain.parse(QStringLiteral("slew:10")));
+    EXPECT_DOUBLE_EQ(chain.apply(0, 1), 0);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 1), 10);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 0.5), 15);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 2), 35);
+    EXPECT_DOUBLE_EQ(chain.apply(30, 1), 30);
+
+    // outlier: a lone spike is replaced by the running mean, a sustained step is followed
+    ASSERT_TRUE(chain.parse(QStringLiteral("outlier:4,3")));
+    const double noise[] = {100, 102, 98, 101, 99, 100, 103, 97, 100, 101};
+    for (double v : noise)
+        EXPECT_DOUBLE_EQ(chain.apply(v, 1), v);
+    double spike = chain.apply(400, 1);
+    EXPECT_NEAR(spike, 100, 3);
+    EXPECT_DOUBLE_EQ(chain.apply(100, 1), 100);
+    int rejected = 0;
+    double out = 0;
+    for (int i = 0; i < 10; i++) {
+        out = chain.apply(200, 1);
+        if (out != 200)
+            rejected++;
+    }
+    EXPECT_EQ(rejected, 3);
+    EXPECT_DOUBLE_EQ(out, 200);
+
+    // a reset starts the chain again from the next sample
+    chain.reset();
+    EXPECT_DOUBLE_EQ(chain.apply(10, 1), 10);
+}
+
+void SignalFilterTestSuite::test_kalman() {
+    SignalFilterChain chain;
+    ASSERT_TRUE(chain.parse(QStringLiteral("kalman:1,0.01,0.75")));
+
+    const double samples[] = {10, 12, 9, 30, 31, 29, 30, 32, 28, 30, 30, 30};
+    KalmanFilter reference(1, 0.01, 0.75, samples[0]);
+    for (double v : samples)
+        EXPECT_DOUBLE_EQ(chain.apply(v, 1), reference.updateEstimate(v));
+
+    // a constant input converges to itself
+    for (int i = 0; i < 50; i++)
+        chain.apply(50, 1);
+    EXPECT_NEAR(chain.apply(50, 1), 50, 1e-6);
+}
+
+void SignalFilterTestSuite::test_cpuCost() {
+    SignalFilterChain chain;
+    ASSERT_TRUE(chain.parse(QStringLiteral("outlier:4;median:9;slew:1000;kalman:1,0.01,0.75")));
+
+    const int samples = 1000000;
+    double sum = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < samples; i++)
+        sum += chain.apply(200 + (i % 17) - 8 + ((i % 101) == 0 ? 300 : 0), 0.1);
+    qint64 elapsed = timer.elapsed();
+    qDebug() << samples << "samples through 4 stages in" << elapsed << "ms";
+
+    EXPECT_NEAR(sum / samples, 200, 5);
+    // a sensor sends a few samples per second: even a debug build is orders of magnitude below that
+    EXPECT_LT(elapsed, 2000);
+}
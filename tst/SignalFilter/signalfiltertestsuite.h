@@ -0,0 +1,48 @@
+#ifndef SIGNALFILTERTESTSUITE_H
+#define SIGNALFILTERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SignalFilterTestSuite: public testing::Test {
+
+public:
+    SignalFilterTestSuite();
+
+    /**
+     * @brief Test parsing valid and invalid filter chain descriptions
+     */
+    void test_parse();
+
+    /**
+     * @brief Test the response of each stage to a step and to a single spike
+     */
+    void test_stepResponse();
+
+    /**
+     * @brief Test that the Kalman stage matches the estimates of KalmanFilter with the same parameters
+     */
+    void test_kalman();
+
+    /**
+     * @brief Test the cost of a full chain per sample
+     */
+    void test_cpuCost();
+};
+
+TEST_F(SignalFilterTestSuite, TestParse) {
+    this->test_parse();
+}
+
+TEST_F(SignalFilterTestSuite, TestStepResponse) {
+    this->test_stepResponse();
+}
+
+TEST_F(SignalFilterTestSuite, TestKalman) {
+    this->test_kalman();
+}
+
+TEST_F(SignalFilterTestSuite, TestCpuCost) {
+    this->test_cpuCost();
+}
+
+#endif // SIGNALFILTERTESTSUITE_H
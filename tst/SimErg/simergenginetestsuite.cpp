@@ -0,0 +1,277 @@
+#include "simergenginetestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QSettings>
+#include <QTimer>
+#include <math.h>
+
+#include "Tools/testsettings.h"
+#include "devices/bike.h"
+#include "qzsettings.h"
+#include "simergengine.h"
+
+namespace {
+
+const double dt = SimErgEngine::controlPeriodMs / 1000.0;
+
+// the power of a trainer follows the request with a lag of about a second
+const double trainerLagSeconds = 1.0;
+
+class SimulatedBike : public bike {
+  public:
+    void setSpeed(double speed) { Speed.setValue(speed, false); }
+    virtual double powerTarget() = 0;
+    // the power after seconds at the current request
+    void advance(double seconds) {
+        double w = m_watt.value();
+        m_watt.setValue(w + (powerTarget() - w) * seconds / (trainerLagSeconds + seconds), false);
+    }
+};
+
+// a smart trainer holding the power it's asked
+class ErgTrainer : public SimulatedBike {
+  public:
+    ErgTrainer() { ergModeSupported = true; }
+    double powerTarget() override { return requestPower; }
+};
+
+// a bike with 32 resistance levels only, pedalled at 85 rpm, with the linear power of the level that ergTable
+// learns on such bikes
+class ResistanceBike : public SimulatedBike {
+  public:
+    ResistanceBike() { Cadence.setValue(85, false); }
+    resistance_t maxResistance() override { return 32; }
+    double levelPower(resistance_t r) { return Cadence.value() * (0.1 * r + 0.4); }
+    double powerTarget() override { return levelPower(Resistance.value()); }
+    resistance_t resistanceFromPowerRequest(uint16_t power) override {
+        resistance_t best = 1;
+        for (resistance_t r = 1; r <= maxResistance(); r++)
+            if (fabs(levelPower(r) - power) < fabs(levelPower(best) - power))
+                best = r;
+        return best;
+    }
+    void changeResistance(resistance_t res) override {
+        Resistance.setValue(res, false);
+        changes++;
+    }
+    int changes = 0;
+};
+
+struct RoutePoint {
+    double seconds;
+    double grade; // percent
+    double speed; // km/h
+};
+
+// 10 minutes of a rolling Zwift route, sampled every 20 s: flat, a climb of 3 minutes, the descent and a kicker
+const RoutePoint route[] = {
+    {0, 0.5, 31},    {20, 0.3, 32},   {40, 1.0, 30},   {60, 2.5, 26},   {80, 4.0, 21},   {100, 5.5, 17.5},
+    {120, 6.5, 15.5}, {140, 7.0, 14.5}, {160, 6.0, 16},  {180, 5.0, 17.5}, {200, 6.5, 15},  {220, 4.5, 18.5},
+    {240, 2.0, 25},  {260, 0.0, 33},  {280, -2.5, 42}, {300, -4.5, 47}, {320, -5.0, 50}, {340, -3.0, 44},
+    {360, -1.0, 38}, {380, 0.0, 34},  {400, 0.5, 32},  {420, 3.0, 25},  {440, 8.5, 13},  {460, 9.5, 11.5},
+    {480, 4.0, 20},  {500, 1.0, 29},  {520, 0.0, 33},  {540, -1.5, 37}, {560, 0.2, 33},  {580, 0.5, 31},
+    {600, 0.5, 31}};
+
+RoutePoint routeAt(double seconds) {
+    const int count = sizeof(route) / sizeof(route[0]);
+    for (int i = 1; i < count; i++) {
+        if (seconds <= route[i].seconds) {
+            const RoutePoint &a = route[i - 1];
+            const RoutePoint &b = route[i];
+            double f = (seconds - a.seconds) / (b.seconds - a.seconds);
+            return {seconds, a.grade + (b.grade - a.grade) * f, a.speed + (b.speed - a.speed) * f};
+        }
+    }
+    return route[count - 1];
+}
+
+// the speed of a bike is never clean: +-0.5 km/h at the pedal stroke and the update rate of the driver
+double noisySpeed(double speed, double seconds) {
+    return speed + 0.5 * sin(seconds * 2 * M_PI * 1.4) + 0.2 * sin(seconds * 2 * M_PI * 0.33);
+}
+
+struct ReplayResult {
+    double meanTarget = 0;
+    double meanAbsError = 0;
+    int requests = 0;
+    int reversals = 0; // changes of direction of the request
+};
+
+ReplayResult replay(SimulatedBike &device, double smoothingSeconds) {
+    QSettings().setValue(QZSettings::zwift_sim_erg_smoothing, smoothingSeconds);
+    SpeedPowerModel::Parameters base = SpeedPowerModel::parametersFromSettings();
+    SimErgEngine engine(&device);
+    ReplayResult result;
+    const double crr = 0.004, cw = 0.51;
+    const double duration = route[sizeof(route) / sizeof(route[0]) - 1].seconds;
+    double last = -1, lastDirection = 0;
+    int samples = 0;
+
+    for (int k = 0; k * dt <= duration; k++) {
+        double t = k * dt;
+        RoutePoint p = routeAt(t);
+        device.setSpeed(noisySpeed(p.speed, t));
+        // the app sends the road about once a second
+        if (k % 4 == 0)
+            engine.setRoad(p.grade, crr, cw);
+        double request = engine.step(dt);
+        device.advance(dt);
+
+        if (last >= 0 && request != last) {
+            double direction = request > last ? 1 : -1;
+            if (lastDirection != 0 && direction != lastDirection)
+                result.reversals++;
+            lastDirection = direction;
+        }
+        last = request;
+
+        // after the first 10 s, the achieved power against the road at the true speed
+        if (t >= 10) {
+            double road = qMax(0.0, SimErgEngine::roadPower(base, p.speed, p.grade, crr, cw));
+            result.meanTarget += road;
+            result.meanAbsError += fabs(device.wattsMetric().value() - road);
+            samples++;
+        }
+    }
+    engine.stop();
+    result.meanTarget /= samples;
+    result.meanAbsError /= samples;
+    result.requests = engine.requests();
+    return result;
+}
+
+// runs the event loop until the condition holds or the timeout expires
+template <typename Condition> bool waitFor(Condition condition, int timeoutMs) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition() && timer.elapsed() < timeoutMs) {
+        QEventLoop loop;
+        QTimer::singleShot(5, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    return condition();
+}
+
+} // namespace
+
+SimErgEngineTestSuite::SimErgEngineTestSuite() {}
+
+void SimErgEngineTestSuite::test_roadPower() {
+    SpeedPowerModel::Parameters base;
+    base.mass = 80;
+    base.crr = 0.005;
+    base.aero = 0.2;
+    base.efficiency = 0.95;
+
+    // 30 km/h on the flat, by hand: (m g Crr v + Cw / 2 v^3) / efficiency
+    double v = 30 / 3.6;
+    EXPECT_NEAR(SimErgEngine::roadPower(base, 30, 0, 0.004, 0.51),
+                (80 * 9.8 * 0.004 * v + 0.255 * v * v * v) / 0.95, 0.01);
+    EXPECT_NEAR(SimErgEngine::roadPower(base, 30, 0, 0, 0), (80 * 9.8 * 0.005 * v + 0.2 * v * v * v) / 0.95, 0.01);
+
+    // 12 km/h at 8%: the weight is most of it
+    v = 12 / 3.6;
+    EXPECT_NEAR(SimErgEngine::roadPower(base, 12, 8, 0.004, 0.51),
+                (80 * 9.8 * 0.084 * v + 0.255 * v * v * v) / 0.95, 0.01);
+
+    // downhill the road pushes
+    EXPECT_LT(SimErgEngine::roadPower(base, 40, -6, 0.004, 0.51), 0);
+}
+
+void SimErgEngineTestSuite::test_steadyState() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    ErgTrainer device;
+    SimErgEngine engine(&device);
+    const double grade = 5, speed = 18, crr = 0.004, cw = 0.51;
+    double road = SimErgEngine::roadPower(SpeedPowerModel::fromSettings().parameters(), speed, grade, crr, cw);
+
+    device.setSpeed(speed);
+    engine.setRoad(grade, crr, cw);
+    double t = 0;
+    for (; t < 30; t += dt) {
+        device.setSpeed(noisySpeed(speed, t));
+        engine.step(dt);
+    }
+    EXPECT_NEAR(engine.requestedPower(), road, road * 0.03);
+    EXPECT_EQ(device.lastRequestedPower().value(), qRound(engine.requestedPower()));
+
+    // settled: the noise of the speed doesn't reach the bike
+    int requests = engine.requests();
+    for (; t < 90; t += dt) {
+        device.setSpeed(noisySpeed(speed, t));
+        engine.step(dt);
+    }
+    EXPECT_EQ(engine.requests(), requests);
+
+    // a target power from the app stops it
+    engine.stop();
+    EXPECT_FALSE(engine.isActive());
+}
+
+void SimErgEngineTestSuite::test_routeReplay() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    const int steps = (int)(600 / dt);
+
+    ErgTrainer trainer;
+    ReplayResult erg = replay(trainer, 2);
+    qDebug() << "ERG trainer: road" << erg.meanTarget << "W, mean error" << erg.meanAbsError << "W," << erg.requests
+             << "requests in" << steps << "steps," << erg.reversals << "reversals";
+    EXPECT_LT(erg.meanAbsError, erg.meanTarget * 0.08);
+    EXPECT_LT(erg.requests, steps / 3);
+
+    // without smoothing the noise of the speed goes to the trainer
+    ErgTrainer raw;
+    ReplayResult unsmoothed = replay(raw, 0);
+    qDebug() << "ERG trainer without smoothing:" << unsmoothed.requests << "requests," << unsmoothed.reversals
+             << "reversals";
+    EXPECT_LT(erg.reversals * 3, unsmoothed.reversals);
+
+    // the levels of a resistance bike are about 8 W apart, and changePower skips the requests within
+    // zwift_erg_filter of the power it's doing
+    ResistanceBike resistanceBike;
+    ReplayResult levels = replay(resistanceBike, 2);
+    qDebug() << "resistance bike: road" << levels.meanTarget << "W, mean error" << levels.meanAbsError << "W,"
+             << resistanceBike.changes << "resistance changes";
+    EXPECT_LT(levels.meanAbsError, levels.meanTarget * 0.15);
+    EXPECT_LT(resistanceBike.changes, steps / 4);
+}
+
+void SimErgEngineTestSuite::test_roadTimeout() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    ErgTrainer device;
+    device.setSpeed(25);
+    SimErgEngine engine(&device);
+    engine.setRoadTimeout(SimErgEngine::controlPeriodMs * 3);
+    engine.setRoad(2, 0.004, 0.51);
+    EXPECT_TRUE(engine.isActive());
+    EXPECT_EQ(engine.requests(), 1);
+
+    // the road keeps coming: the loop keeps going
+    QElapsedTimer clock;
+    clock.start();
+    while (clock.elapsed() < SimErgEngine::controlPeriodMs * 6) {
+        waitFor([]() { return false; }, SimErgEngine::controlPeriodMs);
+        engine.setRoad(2, 0.004, 0.51);
+    }
+    EXPECT_TRUE(engine.isActive());
+
+    // the road stops: so does the loop, and no power is requested after it
+    EXPECT_TRUE(waitFor([&]() { return !engine.isActive(); }, SimErgEngine::controlPeriodMs * 8));
+    int requests = engine.requests();
+    device.setSpeed(35);
+    waitFor([]() { return false; }, SimErgEngine::controlPeriodMs * 3);
+    EXPECT_EQ(engine.requests(), requests);
+
+    // a new road starts it again
+    engine.setRoad(2, 0.004, 0.51);
+    EXPECT_TRUE(engine.isActive());
+    EXPECT_EQ(engine.requests(), requests + 1);
+    engine.stop();
+}
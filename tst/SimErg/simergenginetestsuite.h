@@ -0,0 +1,50 @@
+#ifndef SIMERGENGINETESTSUITE_H
+#define SIMERGENGINETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SimErgEngineTestSuite: public testing::Test {
+
+public:
+    SimErgEngineTestSuite();
+
+    /**
+     * @brief Test the power of the road: the Crr and Cw of the app replace the ones of the settings
+     */
+    void test_roadPower();
+
+    /**
+     * @brief Test that on a constant road with a noisy speed the request settles on the power of the road
+     * and stops changing
+     */
+    void test_steadyState();
+
+    /**
+     * @brief Replay a route with an ERG trainer and a resistance only bike, and compare the power they
+     * achieve with the power of the road
+     */
+    void test_routeReplay();
+
+    /**
+     * @brief Test that the control loop stops by itself when the app sends no road anymore
+     */
+    void test_roadTimeout();
+};
+
+TEST_F(SimErgEngineTestSuite, TestRoadPower) {
+    this->test_roadPower();
+}
+
+TEST_F(SimErgEngineTestSuite, TestSteadyState) {
+    this->test_steadyState();
+}
+
+TEST_F(SimErgEngineTestSuite, TestRouteReplay) {
+    this->test_routeReplay();
+}
+
+TEST_F(SimErgEngineTestSuite, TestRoadTimeout) {
+    this->test_roadTimeout();
+}
+
+#endif // SIMERGENGINETESTSUITE_H
@@ -0,0 +1,100 @@
+#include "snapshotchanneltestsuite.h"
+
+#include <cstdint>
+#include <thread>
+
+#include "snapshotchannel.h"
+
+namespace {
+
+// big enough to be torn if the buffers were shared
+struct Sample {
+    uint64_t values[16];
+};
+
+} // namespace
+
+SnapshotChannelTestSuite::SnapshotChannelTestSuite() {}
+
+void SnapshotChannelTestSuite::test_latestValue() {
+    SnapshotChannel<int> channel;
+    EXPECT_FALSE(channel.update());
+    EXPECT_EQ(channel.front(), 0);
+
+    channel.publish(1);
+    EXPECT_TRUE(channel.update());
+    EXPECT_EQ(channel.front(), 1);
+    EXPECT_FALSE(channel.update());
+    EXPECT_EQ(channel.front(), 1);
+
+    // the values in between are dropped
+    for (int i = 2; i <= 10; i++)
+        channel.publish(i);
+    EXPECT_TRUE(channel.update());
+    EXPECT_EQ(channel.front(), 10);
+    EXPECT_FALSE(channel.update());
+
+    // and the channel goes on with all its buffers
+    for (int i = 11; i <= 20; i++) {
+        channel.publish(i);
+        EXPECT_TRUE(channel.update());
+        EXPECT_EQ(channel.front(), i);
+    }
+}
+
+void SnapshotChannelTestSuite::test_backBuffer() {
+    SnapshotChannel<int> channel;
+    channel.publish(1);
+    ASSERT_TRUE(channel.update());
+
+    channel.back() = 2;
+    EXPECT_FALSE(channel.update());
+    EXPECT_EQ(channel.front(), 1);
+    channel.publish();
+    EXPECT_EQ(channel.front(), 1);
+    EXPECT_TRUE(channel.update());
+    EXPECT_EQ(channel.front(), 2);
+
+    // the producer never gets the buffer the consumer is reading
+    for (int i = 3; i < 10; i++) {
+        channel.back() = -1;
+        EXPECT_EQ(channel.front(), i - 1);
+        channel.publish(i);
+        EXPECT_TRUE(channel.update());
+    }
+}
+
+void SnapshotChannelTestSuite::test_threads() {
+    const uint64_t count = 200000;
+    SnapshotChannel<Sample> channel;
+
+    std::thread producer([&channel, count]() {
+        for (uint64_t n = 1; n <= count; n++) {
+            Sample &sample = channel.back();
+            for (uint64_t &value : sample.values)
+                value = n;
+            channel.publish();
+        }
+    });
+
+    uint64_t last = 0;
+    int reads = 0, torn = 0, older = 0;
+    while (last < count) {
+        if (!channel.update())
+            continue;
+        const Sample &sample = channel.front();
+        for (uint64_t value : sample.values)
+            if (value != sample.values[0])
+                torn++;
+        if (sample.values[0] <= last)
+            older++;
+        last = sample.values[0];
+        reads++;
+    }
+    producer.join();
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(older, 0);
+    EXPECT_GT(reads, 0);
+    EXPECT_EQ(last, count);
+}
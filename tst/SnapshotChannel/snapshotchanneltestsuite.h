@@ -0,0 +1,39 @@
+#ifndef SNAPSHOTCHANNELTESTSUITE_H
+#define SNAPSHOTCHANNELTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SnapshotChannelTestSuite: public testing::Test {
+
+public:
+    SnapshotChannelTestSuite();
+
+    /**
+     * @brief Test that the consumer gets the last value published since its previous read, once
+     */
+    void test_latestValue();
+
+    /**
+     * @brief Test that what the producer writes in the back buffer is not seen before it's published
+     */
+    void test_backBuffer();
+
+    /**
+     * @brief Test that a consumer thread never reads a value half written by the producer thread, nor an older one
+     */
+    void test_threads();
+};
+
+TEST_F(SnapshotChannelTestSuite, TestLatestValue) {
+    this->test_latestValue();
+}
+
+TEST_F(SnapshotChannelTestSuite, TestBackBuffer) {
+    this->test_backBuffer();
+}
+
+TEST_F(SnapshotChannelTestSuite, TestThreads) {
+    this->test_threads();
+}
+
+#endif // SNAPSHOTCHANNELTESTSUITE_H
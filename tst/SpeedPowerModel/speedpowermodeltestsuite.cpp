@@ -0,0 +1,180 @@
+#include "speedpowermodeltestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <math.h>
+
+#include "speedpowermodel.h"
+
+namespace {
+
+// the Newton iteration metric::calculateMaxSpeedFromPower used, without its QSettings
+double newtonMaxSpeed(double power, double inclination, double mass, double rolling_resistance) {
+    double twt = 9.8 * mass;
+    double aero = 0.22691607640851885;
+    double hw = 0;
+    double tr = twt * ((inclination / 100.0) + rolling_resistance);
+    double tran = 0.95;
+    double p = power;
+    double vel = 20;
+    const uint8_t MAX = 10;
+    double TOL = 0.05;
+    for (int i = 1; i < MAX; i++) {
+        double tv = vel + hw;
+        double aeroEff = (tv > 0.0) ? aero : -aero;
+        double f = vel * (aeroEff * tv * tv + tr) - tran * p;
+        double fp = aeroEff * (3.0 * vel + hw) * tv + tr;
+        double vNew = vel - f / fp;
+        if (fabs(vNew - vel) < TOL) {
+            if (vNew < 0)
+                return 0;
+            else if (vNew > 19)
+                return 70;
+            return vNew * 3.6;
+        }
+        vel = vNew;
+    }
+    return -1; // failed to converge
+}
+
+// the running power of treadmill::wattsCalc, without the rounding to uint16_t
+double runningWatts(double weight, double speed, double inclination) {
+    return 75 * (210.0 / (60 / speed)) * weight / 1000.0 + 9.8 * weight * inclination / 100.0;
+}
+
+} // namespace
+
+SpeedPowerModelTestSuite::SpeedPowerModelTestSuite() {}
+
+void SpeedPowerModelTestSuite::test_maxSpeed() {
+    SpeedPowerModel model;
+    const SpeedPowerModel::Parameters &p = model.parameters();
+
+    int compared = 0;
+    for (double inclination = -5; inclination <= 15; inclination += 0.5) {
+        for (double power = 10; power <= 600; power += 10) {
+            double speed = model.maxSpeed(power, inclination);
+            ASSERT_GE(speed, 0);
+            if (speed > 0 && speed < 70) {
+                // the root satisfies the power balance
+                EXPECT_NEAR(model.powerForSpeed(speed, inclination), power, 1e-6 * power)
+                    << power << "W at " << inclination << "%";
+            }
+            double newton = newtonMaxSpeed(power, inclination, p.mass, p.crr);
+            if (newton >= 0) {
+                // within the 0.05 m/s tolerance of the iteration
+                EXPECT_NEAR(speed, newton, 0.05 * 3.6) << power << "W at " << inclination << "%";
+                compared++;
+            }
+        }
+    }
+    EXPECT_GT(compared, 1000);
+
+    // more power is always faster
+    EXPECT_LT(model.maxSpeed(100, 0), model.maxSpeed(200, 0));
+    EXPECT_LT(model.maxSpeed(200, 5), model.maxSpeed(200, 0));
+    EXPECT_DOUBLE_EQ(model.maxSpeed(0, 0), 0);
+    EXPECT_DOUBLE_EQ(model.maxSpeed(5000, -5), 70);
+
+    const int calls = 200000;
+    volatile double sink = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < calls; i++)
+        sink = sink + model.maxSpeed(50 + (i % 400), (i % 20) - 5);
+    qint64 closedForm = timer.nsecsElapsed();
+    timer.start();
+    for (int i = 0; i < calls; i++)
+        sink = sink + newtonMaxSpeed(50 + (i % 400), (i % 20) - 5, p.mass, p.crr);
+    qint64 newton = timer.nsecsElapsed();
+    qDebug() << "max speed per call: closed form" << closedForm / calls << "ns, Newton" << newton / calls << "ns";
+    // the settings are not read for each call any more: a QSettings alone costs far more than this
+    EXPECT_LT(closedForm / calls, 5000);
+}
+
+void SpeedPowerModelTestSuite::test_powerForSpeed() {
+    SpeedPowerModel::Parameters parameters;
+    parameters.mass = 85;
+    parameters.windSpeed = 10 / 3.6;
+    parameters.drafting = 0.3;
+    SpeedPowerModel windy(parameters);
+
+    for (double speed = 5; speed < 65; speed += 5) {
+        double power = windy.powerForSpeed(speed, 2);
+        EXPECT_NEAR(windy.maxSpeed(power, 2), speed, 1e-6) << speed;
+    }
+
+    // a head wind costs power, drafting saves it
+    SpeedPowerModel calm;
+    parameters.drafting = 0;
+    SpeedPowerModel headWind(parameters);
+    parameters.windSpeed = 0;
+    parameters.drafting = 0.3;
+    SpeedPowerModel drafting(parameters);
+    parameters.drafting = 0;
+    SpeedPowerModel heavy(parameters);
+    EXPECT_GT(headWind.powerForSpeed(30, 0), heavy.powerForSpeed(30, 0));
+    EXPECT_LT(drafting.powerForSpeed(30, 0), heavy.powerForSpeed(30, 0));
+    EXPECT_GT(heavy.powerForSpeed(30, 5), calm.powerForSpeed(30, 5));
+
+    // a tail wind faster than the rider
+    parameters.windSpeed = -30 / 3.6;
+    SpeedPowerModel tailWind(parameters);
+    double speed = tailWind.maxSpeed(20, 0);
+    EXPECT_GT(speed, 0);
+    EXPECT_NEAR(tailWind.powerForSpeed(speed, 0), 20, 1e-6);
+}
+
+void SpeedPowerModelTestSuite::test_nextSpeed() {
+    SpeedPowerModel model;
+    const double power = 200;
+    double maxSpeed = model.maxSpeed(power, 0);
+
+    // from standing still the speed rises every second, never past the steady state, and reaches it
+    double speed = 0;
+    double previous = 0;
+    int seconds = 0;
+    for (; seconds < 300 && speed < maxSpeed - 0.1; seconds++) {
+        speed = model.nextSpeed(power, 0, speed, 1, 0);
+        EXPECT_GT(speed, previous);
+        EXPECT_LE(speed, maxSpeed);
+        previous = speed;
+    }
+    EXPECT_LT(seconds, 300);
+    // a real rider doesn't get to 30 km/h in a couple of seconds
+    EXPECT_LT(model.nextSpeed(power, 0, 0, 2, 0), 20);
+
+    // the step doesn't change the result much
+    double coarse = 0, fine = 0;
+    for (int i = 0; i < 10; i++)
+        coarse = model.nextSpeed(power, 0, coarse, 1, 0);
+    for (int i = 0; i < 40; i++)
+        fine = model.nextSpeed(power, 0, fine, 0.25, 0);
+    EXPECT_NEAR(coarse, fine, 0.1);
+
+    // without power the rider slows down, faster uphill, and stops
+    double flat = model.nextSpeed(0, 0, 30, 5, 0);
+    double uphill = model.nextSpeed(0, 5, 30, 5, 0);
+    EXPECT_LT(flat, 30);
+    EXPECT_LT(uphill, flat);
+    EXPECT_GE(model.nextSpeed(0, 10, 5, 60, 0), 0);
+
+    // the speed limit
+    EXPECT_LE(model.nextSpeed(1000, 0, 30, 10, 25), 25);
+
+    // a zero or negative time doesn't move
+    EXPECT_DOUBLE_EQ(model.nextSpeed(power, 0, 20, 0, 0), 20);
+}
+
+void SpeedPowerModelTestSuite::test_runningFlatSpeed() {
+    for (double weight = 50; weight <= 110; weight += 20) {
+        for (double speed = 3; speed <= 18; speed += 1.5) {
+            for (double inclination = -3; inclination <= 15; inclination += 1) {
+                double ratio = runningWatts(weight, speed, inclination) * speed / runningWatts(weight, speed, 0);
+                EXPECT_NEAR(SpeedPowerModel::runningFlatSpeed(speed, inclination), ratio, 1e-9);
+            }
+        }
+    }
+    EXPECT_DOUBLE_EQ(SpeedPowerModel::runningFlatSpeed(10, 0), 10);
+    EXPECT_GE(SpeedPowerModel::runningFlatSpeed(1, -30), 0);
+}
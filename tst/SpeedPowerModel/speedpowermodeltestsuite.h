@@ -0,0 +1,49 @@
+#ifndef SPEEDPOWERMODELTESTSUITE_H
+#define SPEEDPOWERMODELTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SpeedPowerModelTestSuite: public testing::Test {
+
+public:
+    SpeedPowerModelTestSuite();
+
+    /**
+     * @brief Test the closed form max speed against the power balance and the Newton iteration it replaces,
+     * and compare the cost of a call
+     */
+    void test_maxSpeed();
+
+    /**
+     * @brief Test that the max speed and the power for a speed are the inverse of each other, with wind and drafting
+     */
+    void test_powerForSpeed();
+
+    /**
+     * @brief Test the acceleration and deceleration of the integrated speed
+     */
+    void test_nextSpeed();
+
+    /**
+     * @brief Test the treadmill flat speed against the ratio of the running power it replaces
+     */
+    void test_runningFlatSpeed();
+};
+
+TEST_F(SpeedPowerModelTestSuite, TestMaxSpeed) {
+    this->test_maxSpeed();
+}
+
+TEST_F(SpeedPowerModelTestSuite, TestPowerForSpeed) {
+    this->test_powerForSpeed();
+}
+
+TEST_F(SpeedPowerModelTestSuite, TestNextSpeed) {
+    this->test_nextSpeed();
+}
+
+TEST_F(SpeedPowerModelTestSuite, TestRunningFlatSpeed) {
+    this->test_runningFlatSpeed();
+}
+
+#endif // SPEEDPOWERMODELTESTSUITE_H
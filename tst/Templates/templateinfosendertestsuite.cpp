@@ -0,0 +1,253 @@
+#include "templateinfosendertestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJSEngine>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include "Tools/testsettings.h"
+#include "qzmetrics.h"
+#include "templateinfosender.h"
+#include "templateinfosenderbuilder.h"
+
+namespace {
+
+// the bundled templates/qz-TcpClient.qzt
+const char *const qzTcpClient =
+    "let pad = function(num, size) {\n"
+    "    num = num.toString();\n"
+    "\t while (num.length < size) num = \"0\" + num;\n"
+    "\t return num;\n"
+    "};\n"
+    "let getstring = function(workout) {\n"
+    "    return \"{\\\"measurement\\\": \\\"workout_measurement_live\\\",\\\"tags\\\": {\\\"device\\\": \\\"\" + "
+    "workout.deviceId + \"\\\", \\\"deviceName\\\": \\\"\" + workout.deviceName + \"\\\" ,\\\"deviceType\\\": \\\"\" "
+    "+ workout.deviceType + \"\\\"}, \\\"fields\\\": \" + JSON.stringify(workout) + \"}\";\n"
+    "};\n"
+    "getstring(this.workout)\n";
+
+// the bundled templates/vlc-TcpClient.qzt
+const char *const vlcTcpClient =
+    "let pad = function(num, size) {\n"
+    "    num = num.toString();\n"
+    "    while (num.length < size) num = \"0\" + num;\n"
+    "    return num;\n"
+    "};\n"
+    "let getstring = function(workout) {\n"
+    "    if (!workout[\"deviceId\"]) {\n"
+    "        return \"osd \\\"--:--:-- --- --- --- ---\\\" 20000000 bottom-left\\n\";\n"
+    "    }\n"
+    "    else {\n"
+    "        let fn = (parseInt(workout.heart)? workout.heart:(workout.deviceType == "
+    "workout.BIKE_TYPE?workout.cadence:workout.calories)).toFixed(0);\n"
+    "        return 'osd \"T:' + workout.elapsed_h + ':' + pad(workout.elapsed_m, 2) + ':'  + pad(workout.elapsed_s, "
+    "2) +' D:' + workout.distance.toFixed(2) + ' S:' + workout.speed.toFixed(1) + ' W:' + workout.watts.toFixed(0) + "
+    "' V:' + fn +\"\\\" 20000000 bottom-left\\n\";\n"
+    "    }\n"
+    "};\n"
+    "getstring(this.workout)\n";
+
+// the template of the web server
+const char *const webServer = "JSON.stringify({msg: \"workout\", content: this.workout})";
+
+// keeps what the template sends
+class RecordingSender : public TemplateInfoSender {
+  public:
+    explicit RecordingSender(const QString &id) : TemplateInfoSender(id) {}
+    using TemplateInfoSender::init;
+    bool isRunning() const override { return true; }
+    bool send(const QString &data) override {
+        sent.append(data);
+        return true;
+    }
+    QStringList sent;
+
+  protected:
+    bool init() override { return true; }
+};
+
+// a context like TemplateInfoSenderBuilder::buildContext() makes, about as large
+void buildWorkout(QJSEngine &engine, int tick) {
+    QJSValue workout = engine.newObject();
+    workout.setProperty(QStringLiteral("BIKE_TYPE"), 2);
+    workout.setProperty(QStringLiteral("deviceId"), QStringLiteral("AA:BB:CC:DD:EE:FF"));
+    workout.setProperty(QStringLiteral("deviceName"), QStringLiteral("Domyos-Bike-1234"));
+    workout.setProperty(QStringLiteral("deviceType"), 2);
+    workout.setProperty(QStringLiteral("elapsed_h"), tick / 3600);
+    workout.setProperty(QStringLiteral("elapsed_m"), (tick / 60) % 60);
+    workout.setProperty(QStringLiteral("elapsed_s"), tick % 60);
+    workout.setProperty(QStringLiteral("distance"), tick * 0.008);
+    workout.setProperty(QStringLiteral("speed"), 28.4 + (tick % 7) / 10.0);
+    workout.setProperty(QStringLiteral("watts"), 180 + tick % 40);
+    workout.setProperty(QStringLiteral("heart"), tick % 3 ? 140 + tick % 20 : 0);
+    workout.setProperty(QStringLiteral("cadence"), 85 + tick % 10);
+    workout.setProperty(QStringLiteral("calories"), tick * 0.2);
+    for (int i = 0; i < 80; i++)
+        workout.setProperty(QStringLiteral("field%1").arg(i), tick * 0.5 + i);
+    engine.globalObject().setProperty(QStringLiteral("workout"), workout);
+}
+
+} // namespace
+
+TemplateInfoSenderTestSuite::TemplateInfoSenderTestSuite() {}
+
+void TemplateInfoSenderTestSuite::test_functionBody() {
+    EXPECT_EQ(TemplateInfoSender::functionBody(QStringLiteral("JSON.stringify(this.workout)")),
+              QStringLiteral("\nreturn (\nJSON.stringify(this.workout)\n);"));
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QString::fromUtf8(qzTcpClient))
+                    .endsWith(QStringLiteral("\nreturn (\ngetstring(this.workout)\n);")));
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QString::fromUtf8(vlcTcpClient))
+                    .endsWith(QStringLiteral("\nreturn (\ngetstring(this.workout)\n);")));
+
+    // separators in strings and comments don't end a statement
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QStringLiteral("f(';}') + \"a;b\" // x; y\n + `c;`;\n"))
+                    .startsWith(QStringLiteral("\nreturn (\nf(';}')")));
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QStringLiteral("a = 1 /* ; } */ + 1"))
+                    .startsWith(QStringLiteral("\nreturn (\na = 1 /* ; } */ + 1")));
+
+    // the last statement is not an expression: the script is evaluated
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QStringLiteral("let a = 1;")).isEmpty());
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QStringLiteral("a = 1; /* the sum */ a + 1")).isEmpty());
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QStringLiteral("a = 1; if (a) { a++ }")).isEmpty());
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QStringLiteral("function f() { return 1; }")).isEmpty());
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QStringLiteral("f(")).isEmpty());
+    EXPECT_TRUE(TemplateInfoSender::functionBody(QString()).isEmpty());
+}
+
+void TemplateInfoSenderTestSuite::test_compiledMatchesEvaluate() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    // the last one counts its runs: the compiled one must not run twice at the first update
+    const char *const scripts[] = {qzTcpClient, vlcTcpClient, webServer, "1 + 1; this.workout.watts * 2",
+                                   "var x = this.workout.speed; x > 0 ? 'moving' : 'stopped';",
+                                   "this.runs = (this.runs || 0) + 1; 'run ' + this.runs"};
+    for (const char *script : scripts) {
+        QJSEngine evaluatedEngine, compiledEngine;
+        RecordingSender evaluated(QStringLiteral("evaluated"));
+        RecordingSender compiled(QStringLiteral("compiled"));
+        evaluated.init(QString::fromUtf8(script));
+        compiled.init(QString::fromUtf8(script));
+        compiled.compile(&compiledEngine);
+
+        for (int tick = 0; tick < 10; tick++) {
+            buildWorkout(evaluatedEngine, tick);
+            buildWorkout(compiledEngine, tick);
+            EXPECT_TRUE(evaluated.update(&evaluatedEngine)) << script;
+            EXPECT_TRUE(compiled.update(&compiledEngine)) << script;
+        }
+        EXPECT_EQ(compiled.sent, evaluated.sent) << script;
+        EXPECT_EQ(compiled.sent.size(), 10);
+    }
+
+    // a statement as the last one is evaluated as before
+    QJSEngine engine;
+    RecordingSender sender(QStringLiteral("statement"));
+    sender.init(QStringLiteral("var r = this.workout.watts; if (r > 0) { r = 'power ' + r; }"));
+    sender.compile(&engine);
+    buildWorkout(engine, 1);
+    EXPECT_TRUE(sender.update(&engine));
+    ASSERT_EQ(sender.sent.size(), 1);
+    EXPECT_EQ(sender.sent.first(), QStringLiteral("power 181"));
+}
+
+void TemplateInfoSenderTestSuite::test_intervalAndBackoff() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QStringLiteral("template_slow") + QZSettings::template_interval_suffix, 300);
+
+    QJSEngine engine;
+    buildWorkout(engine, 1);
+
+    RecordingSender slow(QStringLiteral("slow"));
+    slow.init(QString::fromUtf8(webServer));
+    slow.compile(&engine);
+    EXPECT_EQ(slow.interval(), 300);
+    EXPECT_TRUE(slow.due());
+    EXPECT_TRUE(slow.update(&engine));
+    EXPECT_FALSE(slow.due());
+    QThread::msleep(320);
+    EXPECT_TRUE(slow.due());
+
+    RecordingSender broken(QStringLiteral("broken"));
+    broken.init(QStringLiteral("this.workout.missing.value"));
+    broken.compile(&engine);
+    EXPECT_EQ(broken.interval(), 1000);
+    EXPECT_FALSE(broken.update(&engine));
+    EXPECT_TRUE(broken.sent.isEmpty());
+    // the first error waits twice the interval
+    EXPECT_FALSE(broken.due());
+    QThread::msleep(1100);
+    EXPECT_FALSE(broken.due());
+
+    testSettings.qsettings.remove(QStringLiteral("template_slow") + QZSettings::template_interval_suffix);
+}
+
+void TemplateInfoSenderTestSuite::test_tickBenchmark() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    const char *const scripts[] = {qzTcpClient, vlcTcpClient, webServer, qzTcpClient, vlcTcpClient};
+    const int ticks = 200;
+    qint64 elapsed[2] = {0, 0};
+    for (int compiled = 0; compiled < 2; compiled++) {
+        QJSEngine engine;
+        QList<RecordingSender *> senders;
+        for (const char *script : scripts) {
+            RecordingSender *sender = new RecordingSender(QStringLiteral("t%1").arg(senders.size()));
+            sender->init(QString::fromUtf8(script));
+            if (compiled)
+                sender->compile(&engine);
+            senders.append(sender);
+        }
+
+        QElapsedTimer timer;
+        for (int tick = 0; tick < ticks; tick++) {
+            buildWorkout(engine, tick);
+            timer.start();
+            for (RecordingSender *sender : senders)
+                sender->update(&engine);
+            elapsed[compiled] += timer.nsecsElapsed();
+        }
+        for (RecordingSender *sender : senders)
+            EXPECT_EQ(sender->sent.size(), ticks);
+        qDeleteAll(senders);
+    }
+
+    qDebug() << "JS per tick with 5 templates: evaluated" << elapsed[0] / ticks / 1000 << "us, compiled"
+             << elapsed[1] / ticks / 1000 << "us";
+    // compiling can only remove the parsing: loose bound for a shared machine
+    EXPECT_LT(elapsed[1], elapsed[0] * 2);
+}
+
+void TemplateInfoSenderTestSuite::test_reloadGauge() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QStringLiteral("template_gaugetest_qz_type"), QStringLiteral("TcpClient"));
+    testSettings.qsettings.setValue(QStringLiteral("template_gaugetest_qz_enabled"), true);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QFile file(dir.filePath(QStringLiteral("qz-TcpClient.qzt")));
+    ASSERT_TRUE(file.open(QFile::WriteOnly | QFile::Text));
+    file.write(qzTcpClient);
+    file.close();
+
+    TemplateInfoSenderBuilder *builder =
+        TemplateInfoSenderBuilder::getInstance(QStringLiteral("gaugetest"), QStringList({dir.path()}));
+    EXPECT_EQ(builder->templateIdList(), QStringList({QStringLiteral("gaugetest_qz")}));
+    EXPECT_EQ(QZMetrics::gaugeValue(QZMetrics::TemplateSenders), 1);
+
+    // reloading the same template doesn't count it twice, disabling it removes it
+    builder->reinit();
+    EXPECT_EQ(QZMetrics::gaugeValue(QZMetrics::TemplateSenders), 1);
+    testSettings.qsettings.setValue(QStringLiteral("template_gaugetest_qz_enabled"), false);
+    builder->reinit();
+    EXPECT_EQ(QZMetrics::gaugeValue(QZMetrics::TemplateSenders), 0);
+
+    delete builder;
+    testSettings.qsettings.remove(QStringLiteral("template_gaugetest_qz_type"));
+    testSettings.qsettings.remove(QStringLiteral("template_gaugetest_qz_enabled"));
+}
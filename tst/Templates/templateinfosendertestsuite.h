@@ -0,0 +1,57 @@
+#ifndef TEMPLATEINFOSENDERTESTSUITE_H
+#define TEMPLATEINFOSENDERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class TemplateInfoSenderTestSuite: public testing::Test {
+
+public:
+    TemplateInfoSenderTestSuite();
+
+    /**
+     * @brief Test the function bodies made of scripts, and the scripts left to evaluate
+     */
+    void test_functionBody();
+
+    /**
+     * @brief Test that the compiled templates send what the evaluated scripts sent
+     */
+    void test_compiledMatchesEvaluate();
+
+    /**
+     * @brief Test the interval of a template and the back-off after script errors
+     */
+    void test_intervalAndBackoff();
+
+    /**
+     * @brief Compare the cost of a tick with 5 templates, evaluated and compiled
+     */
+    void test_tickBenchmark();
+
+    /**
+     * @brief Test that the senders gauge follows a reload of the templates
+     */
+    void test_reloadGauge();
+};
+
+TEST_F(TemplateInfoSenderTestSuite, TestFunctionBody) {
+    this->test_functionBody();
+}
+
+TEST_F(TemplateInfoSenderTestSuite, TestCompiledMatchesEvaluate) {
+    this->test_compiledMatchesEvaluate();
+}
+
+TEST_F(TemplateInfoSenderTestSuite, TestIntervalAndBackoff) {
+    this->test_intervalAndBackoff();
+}
+
+TEST_F(TemplateInfoSenderTestSuite, TestTickBenchmark) {
+    this->test_tickBenchmark();
+}
+
+TEST_F(TemplateInfoSenderTestSuite, TestReloadGauge) {
+    this->test_reloadGauge();
+}
+
+#endif // TEMPLATEINFOSENDERTESTSUITE_H
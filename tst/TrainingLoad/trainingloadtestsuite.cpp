@@ -0,0 +1,201 @@
+#include "trainingloadtestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QVector>
+#include <math.h>
+
+#include "trainingload.h"
+
+namespace {
+
+// intervals of 5 minutes on a wave, with some noise
+QVector<double> ridePower(int seconds) {
+    QVector<double> watts;
+    quint32 seed = 12345;
+    for (int s = 0; s < seconds; s++) {
+        seed = seed * 1103515245u + 12345u;
+        double noise = (int)((seed >> 16) % 61) - 30;
+        watts.append(qMax(0.0, 180 + 120 * sin(s / 97.0) + ((s / 300) % 2 ? 150 : 0) + noise));
+    }
+    return watts;
+}
+
+// NP of the first n seconds, from scratch
+double offlineNormalizedPower(const QVector<double> &watts, int n) {
+    if (n < TrainingLoad::window) {
+        double sum = 0;
+        for (int i = 0; i < n; i++)
+            sum += watts.at(i);
+        return n ? sum / n : 0;
+    }
+    double fourth = 0;
+    for (int i = TrainingLoad::window - 1; i < n; i++) {
+        double sum = 0;
+        for (int j = i - TrainingLoad::window + 1; j <= i; j++)
+            sum += watts.at(j);
+        fourth += pow(sum / TrainingLoad::window, 4);
+    }
+    return pow(fourth / (n - TrainingLoad::window + 1), 0.25);
+}
+
+} // namespace
+
+TrainingLoadTestSuite::TrainingLoadTestSuite() {}
+
+void TrainingLoadTestSuite::test_normalizedPower() {
+    TrainingLoad::Parameters parameters;
+    parameters.ftp = 250;
+    TrainingLoad load(parameters);
+    EXPECT_EQ(load.normalizedPower(), 0);
+    EXPECT_EQ(load.tss(), 0);
+
+    const int seconds = 2 * 3600;
+    QVector<double> watts = ridePower(seconds);
+    for (int s = 0; s < seconds; s++) {
+        load.addSample(watts.at(s), 0);
+        int n = s + 1;
+        if (n == 10 || n == 29 || n == 30 || n == 31 || n % 600 == 0) {
+            double np = offlineNormalizedPower(watts, n);
+            double intensity = np / parameters.ftp;
+            EXPECT_EQ(load.seconds(), n);
+            EXPECT_NEAR(load.normalizedPower(), np, 1e-6) << n << " seconds";
+            EXPECT_NEAR(load.intensityFactor(), intensity, 1e-8) << n << " seconds";
+            EXPECT_NEAR(load.tss(), n * np * intensity / (parameters.ftp * 3600) * 100, 1e-6) << n << " seconds";
+        }
+    }
+    EXPECT_GT(load.normalizedPower(), load.averagePower());
+
+    // an hour at FTP is 100 TSS
+    TrainingLoad ftpHour(parameters);
+    for (int s = 0; s < 3600; s++)
+        ftpHour.addSample(parameters.ftp, 0);
+    EXPECT_NEAR(ftpHour.normalizedPower(), parameters.ftp, 1e-9);
+    EXPECT_NEAR(ftpHour.intensityFactor(), 1, 1e-9);
+    EXPECT_NEAR(ftpHour.tss(), 100, 1e-6);
+
+    // a reset starts over
+    load.reset(parameters);
+    EXPECT_EQ(load.seconds(), 0);
+    EXPECT_EQ(load.normalizedPower(), 0);
+}
+
+void TrainingLoadTestSuite::test_wPrimeBalance() {
+    TrainingLoad::Parameters parameters;
+    parameters.ftp = 260;
+    parameters.criticalPower = 250;
+    parameters.wPrime = 20000;
+    TrainingLoad load(parameters);
+    EXPECT_EQ(load.wPrimeBalance(), parameters.wPrime);
+
+    // below CP with W' full: nothing to recover
+    for (int s = 0; s < 60; s++)
+        load.addSample(150, 0);
+    EXPECT_EQ(load.wPrimeBalance(), parameters.wPrime);
+
+    // 50 W above CP for 200 s spends 10 kJ
+    for (int s = 0; s < 200; s++)
+        load.addSample(300, 0);
+    EXPECT_NEAR(load.wPrimeBalance(), 10000, 1e-6);
+    EXPECT_NEAR(load.wPrimeBalanceMin(), 10000, 1e-6);
+
+    // 100 W below CP: the missing W' shrinks by (1 - 100 / W') every second
+    for (int s = 1; s <= 300; s++) {
+        load.addSample(150, 0);
+        double expected = parameters.wPrime - 10000 * pow(1 - 100 / parameters.wPrime, s);
+        ASSERT_NEAR(load.wPrimeBalance(), expected, 1e-6) << s << " seconds of recovery";
+    }
+    EXPECT_NEAR(load.wPrimeBalanceMin(), 10000, 1e-6);
+    EXPECT_GT(load.wPrimeBalance(), 12000);
+
+    // spent beyond W': negative, as the model says
+    for (int s = 0; s < 100; s++)
+        load.addSample(500, 0);
+    EXPECT_LT(load.wPrimeBalance(), 0);
+    EXPECT_EQ(load.wPrimeBalanceMin(), load.wPrimeBalance());
+
+    // CP 0 is the FTP
+    parameters.criticalPower = 0;
+    load.reset(parameters);
+    load.addSample(parameters.ftp + 100, 0);
+    EXPECT_NEAR(load.wPrimeBalance(), parameters.wPrime - 100, 1e-9);
+}
+
+void TrainingLoadTestSuite::test_zones() {
+    TrainingLoad::Parameters parameters;
+    parameters.ftp = 250;
+    parameters.maxHeart = 190;
+    TrainingLoad load(parameters);
+
+    const int seconds = 3600;
+    QVector<double> watts = ridePower(seconds);
+    QVector<quint32> powerZones(TrainingLoad::powerZoneCount, 0);
+    QVector<quint32> heartZones(TrainingLoad::heartZoneCount, 0);
+    const double powerBounds[] = {56, 76, 91, 106, 121, 151};
+    int zone = -1;
+    quint32 inZone = 0;
+    for (int s = 0; s < seconds; s++) {
+        // no heart rate for the first 10 minutes
+        double heart = s < 600 ? 0 : 100 + s % 90;
+        load.addSample(watts.at(s), heart);
+
+        int z = 0;
+        while (z < TrainingLoad::powerZoneCount - 1 && watts.at(s) / parameters.ftp * 100 >= powerBounds[z])
+            z++;
+        powerZones[z]++;
+        inZone = z == zone ? inZone + 1 : 1;
+        zone = z;
+        ASSERT_EQ(load.currentPowerZone(), zone);
+        ASSERT_EQ(load.currentPowerZoneSeconds(), inZone);
+        if (heart > 0) {
+            int h = 0;
+            while (h < TrainingLoad::heartZoneCount - 1 && heart / parameters.maxHeart * 100 >= parameters.heartZones[h])
+                h++;
+            heartZones[h]++;
+        }
+    }
+
+    quint32 powerTotal = 0, heartTotal = 0;
+    for (int i = 0; i < TrainingLoad::powerZoneCount; i++) {
+        EXPECT_EQ(load.powerZoneSeconds(i), powerZones.at(i)) << "power zone " << i + 1;
+        powerTotal += load.powerZoneSeconds(i);
+    }
+    for (int i = 0; i < TrainingLoad::heartZoneCount; i++) {
+        EXPECT_EQ(load.heartZoneSeconds(i), heartZones.at(i)) << "heart rate zone " << i + 1;
+        heartTotal += load.heartZoneSeconds(i);
+    }
+    EXPECT_EQ(powerTotal, (quint32)seconds);
+    EXPECT_EQ(heartTotal, (quint32)seconds - 600);
+    EXPECT_GT(load.powerZoneSeconds(6), 0u);
+}
+
+void TrainingLoadTestSuite::test_constantTime() {
+    TrainingLoad::Parameters parameters;
+    parameters.ftp = 250;
+    TrainingLoad load(parameters);
+    QVector<double> watts = ridePower(3600);
+
+    // the first hour and the tenth cost the same
+    QElapsedTimer timer;
+    qint64 firstHourNs = 0, lastHourNs = 0;
+    for (int h = 0; h < 10; h++) {
+        timer.start();
+        for (int s = 0; s < 3600; s++)
+            load.addSample(watts.at(s), 140);
+        qint64 ns = timer.nsecsElapsed();
+        if (h == 0)
+            firstHourNs = ns;
+        lastHourNs = ns;
+    }
+    EXPECT_EQ(load.seconds(), 36000);
+    EXPECT_GT(load.normalizedPower(), 0);
+    qDebug() << "first hour" << firstHourNs / 3600 << "ns a sample, tenth hour" << lastHourNs / 3600 << "ns";
+    EXPECT_LT(lastHourNs / 3600, 5000);
+    EXPECT_LT(lastHourNs, firstHourNs * 5 + 1000000);
+
+    // the running sum of the window doesn't drift over a long ride of fractional watts
+    TrainingLoad fractional(parameters);
+    for (int s = 0; s < 360000; s++)
+        fractional.addSample(200.1 + (s % 7) * 0.01, 0);
+    EXPECT_NEAR(fractional.normalizedPower(), 200.13, 0.01);
+}
@@ -0,0 +1,48 @@
+#ifndef TRAININGLOADTESTSUITE_H
+#define TRAININGLOADTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class TrainingLoadTestSuite: public testing::Test {
+
+public:
+    TrainingLoadTestSuite();
+
+    /**
+     * @brief Test NP, IF and TSS during a ride against an offline computation over the whole ride so far
+     */
+    void test_normalizedPower();
+
+    /**
+     * @brief Test W' balance against the closed form of the model for constant efforts above and below CP
+     */
+    void test_wPrimeBalance();
+
+    /**
+     * @brief Test the time in the power and heart rate zones against an offline count
+     */
+    void test_zones();
+
+    /**
+     * @brief Measure the cost of a sample: it must not grow with the length of the ride
+     */
+    void test_constantTime();
+};
+
+TEST_F(TrainingLoadTestSuite, TestNormalizedPower) {
+    this->test_normalizedPower();
+}
+
+TEST_F(TrainingLoadTestSuite, TestWPrimeBalance) {
+    this->test_wPrimeBalance();
+}
+
+TEST_F(TrainingLoadTestSuite, TestZones) {
+    this->test_zones();
+}
+
+TEST_F(TrainingLoadTestSuite, TestConstantTime) {
+    this->test_constantTime();
+}
+
+#endif // TRAININGLOADTESTSUITE_H
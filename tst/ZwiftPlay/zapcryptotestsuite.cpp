@@ -0,0 +1,156 @@
+#include "zapcryptotestsuite.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#ifdef QZ_TEST_ZAPCRYPTO
+#include "zwift_play/zapCrypto.h"
+
+namespace {
+
+// AES-256-CCM, 4 byte MAC, nonce = iv + big endian counter, computed with an implementation independent of OpenSSL
+const char keyHex[] = "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f";
+const char ivHex[] = "a1b2c3d4";
+
+struct Vector {
+    const char *counter;
+    const char *plain;
+    const char *cipherAndMac;
+};
+
+const Vector vectors[] = {
+    {"00000000", "072a0808011000", "c0889ad32c90535a23a786"},
+    {"00000001", "37000100", "e7850b68f668feef"},
+    {"01020304", "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f2021222324252627",
+     "0ba32a044b795fa98d1361f2d659948d80be753a57292a8f11447cd7eddd949e79172937a4a38903beabf3ca"},
+};
+
+// what ZapCrypto::encryptDecrypt did for each message before: a new context, keyed again
+bool decryptWithNewContext(const QByteArray &key, const QByteArray &nonce, const QByteArray &payload,
+                           QByteArray &output) {
+    int size = payload.size() - EncryptionUtils::MAC_LENGTH;
+    output.resize(size);
+    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+    int outlen;
+    bool ok = EVP_CipherInit_ex(ctx, EVP_aes_256_ccm(), NULL, NULL, NULL, 0) == 1 &&
+              EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_IVLEN, nonce.size(), NULL) == 1 &&
+              EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_TAG, EncryptionUtils::MAC_LENGTH,
+                                  (void *)(payload.constData() + size)) == 1 &&
+              EVP_CipherInit_ex(ctx, NULL, NULL, (const unsigned char *)key.constData(),
+                                (const unsigned char *)nonce.constData(), 0) == 1 &&
+              EVP_CipherUpdate(ctx, NULL, &outlen, NULL, size) == 1 &&
+              EVP_CipherUpdate(ctx, (unsigned char *)output.data(), &outlen,
+                               (const unsigned char *)payload.constData(), size) == 1;
+    EVP_CIPHER_CTX_free(ctx);
+    return ok;
+}
+
+} // namespace
+#endif
+
+ZapCryptoTestSuite::ZapCryptoTestSuite() {}
+
+void ZapCryptoTestSuite::test_hkdf() {
+#ifndef QZ_TEST_ZAPCRYPTO
+    SUCCEED() << "OpenSSL is linked to the tests only on Linux where pkg-config finds libcrypto";
+#else
+    QByteArray ikm(22, 0x0b);
+    QByteArray salt = QByteArray::fromHex("000102030405060708090a0b0c");
+    QByteArray info = QByteArray::fromHex("f0f1f2f3f4f5f6f7f8f9");
+    EXPECT_EQ(ZapCrypto::hkdf(ikm, salt, info, 42).toHex(),
+              QByteArray("3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865"));
+#endif
+}
+
+void ZapCryptoTestSuite::test_knownAnswer() {
+#ifndef QZ_TEST_ZAPCRYPTO
+    SUCCEED() << "OpenSSL is linked to the tests only on Linux where pkg-config finds libcrypto";
+#else
+    LocalKeyProvider keys;
+    ZapCrypto crypto(keys);
+    ASSERT_TRUE(crypto.setKeys(QByteArray::fromHex(keyHex), QByteArray::fromHex(ivHex)));
+
+    // the session numbers its messages from 0
+    for (int i = 0; i < 2; i++) {
+        QByteArray expected = QByteArray::fromHex(vectors[i].counter) + QByteArray::fromHex(vectors[i].cipherAndMac);
+        EXPECT_EQ(crypto.encrypt(QByteArray::fromHex(vectors[i].plain)).toHex(), expected.toHex()) << i;
+    }
+
+    QByteArray output;
+    for (const Vector &v : vectors) {
+        ASSERT_TRUE(crypto.decrypt(QByteArray::fromHex(v.counter), QByteArray::fromHex(v.cipherAndMac), output))
+            << v.counter;
+        EXPECT_EQ(output.toHex(), QByteArray(v.plain)) << v.counter;
+    }
+#endif
+}
+
+void ZapCryptoTestSuite::test_tampered() {
+#ifndef QZ_TEST_ZAPCRYPTO
+    SUCCEED() << "OpenSSL is linked to the tests only on Linux where pkg-config finds libcrypto";
+#else
+    LocalKeyProvider keys;
+    ZapCrypto crypto(keys);
+    ASSERT_TRUE(crypto.setKeys(QByteArray::fromHex(keyHex), QByteArray::fromHex(ivHex)));
+
+    QByteArray output;
+    QByteArray payload = QByteArray::fromHex(vectors[0].cipherAndMac);
+    payload[2] = payload[2] ^ 0x01;
+    EXPECT_FALSE(crypto.decrypt(QByteArray::fromHex(vectors[0].counter), payload, output));
+    EXPECT_TRUE(output.isEmpty());
+
+    // the wrong counter is a wrong nonce
+    EXPECT_FALSE(crypto.decrypt(QByteArray::fromHex(vectors[1].counter), QByteArray::fromHex(vectors[0].cipherAndMac),
+                                output));
+    // shorter than the MAC, or a counter of the wrong size
+    EXPECT_FALSE(crypto.decrypt(QByteArray::fromHex(vectors[0].counter), QByteArray(3, 0), output));
+    EXPECT_FALSE(crypto.decrypt(QByteArray(2, 0), QByteArray::fromHex(vectors[0].cipherAndMac), output));
+
+    ASSERT_TRUE(crypto.decrypt(QByteArray::fromHex(vectors[1].counter), QByteArray::fromHex(vectors[1].cipherAndMac),
+                               output));
+    EXPECT_EQ(output.toHex(), QByteArray(vectors[1].plain));
+#endif
+}
+
+void ZapCryptoTestSuite::test_throughput() {
+#ifndef QZ_TEST_ZAPCRYPTO
+    SUCCEED() << "OpenSSL is linked to the tests only on Linux where pkg-config finds libcrypto";
+#else
+    LocalKeyProvider keys;
+    ZapCrypto crypto(keys);
+    QByteArray key = QByteArray::fromHex(keyHex);
+    QByteArray iv = QByteArray::fromHex(ivHex);
+    ASSERT_TRUE(crypto.setKeys(key, iv));
+
+    // a button notification of a Zwift Play is about 20 bytes
+    const QByteArray notification = QByteArray::fromHex("072a080801100018002000280030013800400048");
+    const int messages = 20000;
+    QByteArray counters[16];
+    QByteArray payloads[16];
+    QByteArray sealed;
+    for (int i = 0; i < 16; i++) {
+        ASSERT_TRUE(crypto.encrypt(notification.constData(), notification.size(), sealed));
+        counters[i] = sealed.left(ZapCrypto::COUNTER_LENGTH);
+        payloads[i] = sealed.mid(ZapCrypto::COUNTER_LENGTH);
+    }
+
+    QByteArray output;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < messages; i++)
+        ASSERT_TRUE(crypto.decrypt(counters[i % 16], payloads[i % 16], output));
+    qint64 session = timer.nsecsElapsed();
+    EXPECT_EQ(output, notification);
+
+    timer.start();
+    for (int i = 0; i < messages; i++)
+        ASSERT_TRUE(decryptWithNewContext(key, iv + counters[i % 16], payloads[i % 16], output));
+    qint64 perMessage = timer.nsecsElapsed();
+    EXPECT_EQ(output, notification);
+
+    qDebug() << "decrypt per notification: session" << session / messages << "ns, new context"
+             << perMessage / messages << "ns";
+    // far below the few ms between two notifications even in a debug build
+    EXPECT_LT(session / messages, 100000);
+#endif
+}
@@ -0,0 +1,48 @@
+#ifndef ZAPCRYPTOTESTSUITE_H
+#define ZAPCRYPTOTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class ZapCryptoTestSuite: public testing::Test {
+
+public:
+    ZapCryptoTestSuite();
+
+    /**
+     * @brief Test the key derivation against the first test case of RFC 5869
+     */
+    void test_hkdf();
+
+    /**
+     * @brief Test encrypting and decrypting against AES-256-CCM known answers with the controller's framing
+     */
+    void test_knownAnswer();
+
+    /**
+     * @brief Test that a tampered message is rejected and the session still decrypts the next one
+     */
+    void test_tampered();
+
+    /**
+     * @brief Test the throughput of the persistent session against a cipher context set up for each message
+     */
+    void test_throughput();
+};
+
+TEST_F(ZapCryptoTestSuite, TestHkdf) {
+    this->test_hkdf();
+}
+
+TEST_F(ZapCryptoTestSuite, TestKnownAnswer) {
+    this->test_knownAnswer();
+}
+
+TEST_F(ZapCryptoTestSuite, TestTampered) {
+    this->test_tampered();
+}
+
+TEST_F(ZapCryptoTestSuite, TestThroughput) {
+    this->test_throughput();
+}
+
+#endif // ZAPCRYPTOTESTSUITE_H
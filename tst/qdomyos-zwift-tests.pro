@@ -11,6 +11,11 @@ CONFIG += thread
 CONFIG += androidextras
 
 SOURCES += \
+        BleWriteQueue/blewritequeuetestsuite.cpp \
+        Characteristics/characteristicencodertestsuite.cpp \
+        Charts/chartseriescachetestsuite.cpp \
+        Computrainer/computrainertestsuite.cpp \
+        Csafe/csafetestsuite.cpp \
         Devices/bluetoothdevicetestdata.cpp \
         Devices/bluetoothdevicetestdatabuilder.cpp \
         Devices/bluetoothdevicetestsuite.cpp \
@@ -19,10 +24,28 @@ SOURCES += \
         Devices/deviceindex.cpp \
         Devices/devicenamepatterngroup.cpp \
         Devices/devicetestdataindex.cpp \
+        Dircon/ftmsloadgeneratortestsuite.cpp \
         Erg/ergtabletestsuite.cpp \
+        Ghost/ghostridertestsuite.cpp \
+        Gym/gymmanagertestsuite.cpp \
+        History/activityhistorytestsuite.cpp \
+        IfitAdb/ifitadbsessiontestsuite.cpp \
+        InclinationOverride/inclinationoverridetestsuite.cpp \
+        Influx/influxexportertestsuite.cpp \
+        PollScheduler/pollschedulertestsuite.cpp \
+        ProformWifi/proformwifitelemetrytestsuite.cpp \
+        SensorFusion/sensorfusiontestsuite.cpp \
+        SessionRecorder/sessionrecordertestsuite.cpp \
+        SignalFilter/signalfiltertestsuite.cpp \
+        SimErg/simergenginetestsuite.cpp \
+        SnapshotChannel/snapshotchanneltestsuite.cpp \
+        SpeedPowerModel/speedpowermodeltestsuite.cpp \
+        Templates/templateinfosendertestsuite.cpp \
         ToolTests/testsettingstestsuite.cpp \
         Tools/testsettings.cpp \
         Tools/typeidgenerator.cpp \
+        TrainingLoad/trainingloadtestsuite.cpp \
+        ZwiftPlay/zapcryptotestsuite.cpp \
         main.cpp
 
 # Avoid the "File too big" error building in Windows. This has happened when a template class is used with Google Test / typed tests
@@ -36,6 +59,13 @@ else:unix: LIBS += -L$$OUT_PWD/../src/ -lqdomyos-zwift
 INCLUDEPATH += $$PWD/../src $$PWD/../src/devices
 DEPENDPATH += $$PWD/../src $$PWD/../src/devices
 
+# ZapCrypto is header only and not built in the library: its tests link OpenSSL where pkg-config finds it
+linux:!android:packagesExist(libcrypto) {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += libcrypto
+    DEFINES += QZ_TEST_ZAPCRYPTO
+}
+
 win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../src/release/libqdomyos-zwift.a
 else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../src/debug/libqdomyos-zwift.a
 else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../src/release/qdomyos-zwift.lib
@@ -43,6 +73,11 @@ else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/
 else:unix: PRE_TARGETDEPS += $$OUT_PWD/../src/libqdomyos-zwift.a
 
 HEADERS += \
+    BleWriteQueue/blewritequeuetestsuite.h \
+    Characteristics/characteristicencodertestsuite.h \
+    Charts/chartseriescachetestsuite.h \
+    Computrainer/computrainertestsuite.h \
+    Csafe/csafetestsuite.h \
     Devices/bluetoothdevicetestdata.h \
     Devices/bluetoothdevicetestdatabuilder.h \
     Devices/bluetoothdevicetestsuite.h \
@@ -51,8 +86,26 @@ HEADERS += \
     Devices/deviceindex.h \
     Devices/devicenamepatterngroup.h \
     Devices/devicetestdataindex.h \
+    Dircon/ftmsloadgeneratortestsuite.h \
     Erg/ergtabletestsuite.h \
+    Ghost/ghostridertestsuite.h \
+    Gym/gymmanagertestsuite.h \
+    History/activityhistorytestsuite.h \
+    IfitAdb/ifitadbsessiontestsuite.h \
+    InclinationOverride/inclinationoverridetestsuite.h \
+    Influx/influxexportertestsuite.h \
+    PollScheduler/pollschedulertestsuite.h \
+    ProformWifi/proformwifitelemetrytestsuite.h \
+    SensorFusion/sensorfusiontestsuite.h \
+    SessionRecorder/sessionrecordertestsuite.h \
+    SignalFilter/signalfiltertestsuite.h \
+    SimErg/simergenginetestsuite.h \
+    SnapshotChannel/snapshotchanneltestsuite.h \
+    SpeedPowerModel/speedpowermodeltestsuite.h \
+    Templates/templateinfosendertestsuite.h \
     ToolTests/testsettingstestsuite.h \
     Tools/devicetypeid.h \
     Tools/testsettings.h \
-    Tools/typeidgenerator.h
+    Tools/typeidgenerator.h \
+    TrainingLoad/trainingloadtestsuite.h \
+    ZwiftPlay/zapcryptotestsuite.h